@@ -0,0 +1,374 @@
+/**
+ * @file
+ * @brief Microbenchmarks for the bactext name and enumeration conversions
+ *
+ * Times the conversions between the BACnet enumerations and their names
+ * used by the text and JSON front ends - bactext_property_name(),
+ * bactext_property_index(), and the same for object types and engineering
+ * units - against the search of the INDTEXT_DATA list that the indtext
+ * module did before its lookup tables.
+ *
+ * @date October 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#include "bacnet/bacdef.h"
+#include "bacnet/bactext.h"
+#include "bacnet/indtext.h"
+#include "bacnet/version.h"
+#include "bacnet/basic/sys/filename.h"
+
+/* the lists behind the bactext functions, for the list search */
+extern INDTEXT_DATA bacnet_object_type_names[];
+extern INDTEXT_DATA bacnet_property_names[];
+extern INDTEXT_DATA bacnet_engineering_unit_names[];
+
+/* maximum number of names in a corpus */
+#define CORPUS_SIZE 1024
+
+struct corpus {
+    const char *name;
+    INDTEXT_DATA *data_list;
+    unsigned count;
+    unsigned index[CORPUS_SIZE];
+    /* the names in upper case, as a case insensitive lookup may get them */
+    char *text[CORPUS_SIZE];
+};
+
+struct benchmark {
+    const char *name;
+    /* one pass over the corpus; returns the lookups made */
+    unsigned long (*pass)(struct corpus *corpus);
+    struct corpus *corpus;
+};
+
+static struct corpus Object_Types = { "object-type",
+    bacnet_object_type_names, 0, { 0 }, { 0 } };
+static struct corpus Properties = { "property", bacnet_property_names, 0,
+    { 0 }, { 0 } };
+static struct corpus Units = { "units", bacnet_engineering_unit_names, 0,
+    { 0 }, { 0 } };
+/* keeps the compiler from discarding the results */
+static volatile unsigned long Sink;
+/* minimum run time of each benchmark */
+static unsigned long Duration_Milliseconds = 500;
+
+/**
+ * @brief Read a monotonic clock
+ * @return nanoseconds since an arbitrary epoch
+ */
+static uint64_t clock_nanoseconds(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER count;
+
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&count);
+    return (uint64_t)((double)count.QuadPart * 1.0e9 /
+        (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Fill a corpus with the indexes and names of its list
+ * @param corpus [in,out] corpus to fill
+ */
+static void corpus_init(struct corpus *corpus)
+{
+    INDTEXT_DATA *data_list = corpus->data_list;
+    size_t len, i;
+
+    corpus->count = 0;
+    while (data_list->pString && (corpus->count < CORPUS_SIZE)) {
+        corpus->index[corpus->count] = data_list->index;
+        len = strlen(data_list->pString);
+        corpus->text[corpus->count] = malloc(len + 1);
+        if (!corpus->text[corpus->count]) {
+            break;
+        }
+        for (i = 0; i <= len; i++) {
+            corpus->text[corpus->count][i] =
+                (char)toupper((unsigned char)data_list->pString[i]);
+        }
+        corpus->count++;
+        data_list++;
+    }
+}
+
+/**
+ * @brief The search of the list for a name, ignoring case
+ * @param data_list [in] list of index and text pairs
+ * @param search_name [in] name to find
+ * @param found_index [out] index of the name
+ * @return true if found
+ */
+static bool list_by_istring(
+    INDTEXT_DATA *data_list, const char *search_name, unsigned *found_index)
+{
+    while (data_list->pString) {
+        if (stricmp(data_list->pString, search_name) == 0) {
+            *found_index = data_list->index;
+            return true;
+        }
+        data_list++;
+    }
+
+    return false;
+}
+
+/**
+ * @brief The search of the list for an index
+ * @param data_list [in] list of index and text pairs
+ * @param index [in] index to find
+ * @return name of the index, or NULL if not found
+ */
+static const char *list_by_index(INDTEXT_DATA *data_list, unsigned index)
+{
+    while (data_list->pString) {
+        if (data_list->index == index) {
+            return data_list->pString;
+        }
+        data_list++;
+    }
+
+    return NULL;
+}
+
+static unsigned long bench_name_list(struct corpus *corpus)
+{
+    unsigned i;
+
+    for (i = 0; i < corpus->count; i++) {
+        Sink += (unsigned long)(uintptr_t)list_by_index(
+            corpus->data_list, corpus->index[i]);
+    }
+
+    return corpus->count;
+}
+
+static unsigned long bench_name_indtext(struct corpus *corpus)
+{
+    unsigned i;
+
+    for (i = 0; i < corpus->count; i++) {
+        Sink += (unsigned long)(uintptr_t)indtext_by_index_default_cached(
+            corpus->data_list, corpus->index[i], NULL);
+    }
+
+    return corpus->count;
+}
+
+static unsigned long bench_index_list(struct corpus *corpus)
+{
+    unsigned i, index = 0;
+
+    for (i = 0; i < corpus->count; i++) {
+        if (list_by_istring(corpus->data_list, corpus->text[i], &index)) {
+            Sink += index;
+        }
+    }
+
+    return corpus->count;
+}
+
+static unsigned long bench_index_indtext(struct corpus *corpus)
+{
+    unsigned i, index = 0;
+
+    for (i = 0; i < corpus->count; i++) {
+        if (indtext_by_istring_cached(
+                corpus->data_list, corpus->text[i], &index)) {
+            Sink += index;
+        }
+    }
+
+    return corpus->count;
+}
+
+static unsigned long bench_property_name(struct corpus *corpus)
+{
+    unsigned i;
+
+    for (i = 0; i < corpus->count; i++) {
+        Sink += (unsigned long)(uintptr_t)bactext_property_name(
+            corpus->index[i]);
+    }
+
+    return corpus->count;
+}
+
+static unsigned long bench_property_index(struct corpus *corpus)
+{
+    unsigned i, index = 0;
+
+    for (i = 0; i < corpus->count; i++) {
+        if (bactext_property_index(corpus->text[i], &index)) {
+            Sink += index;
+        }
+    }
+
+    return corpus->count;
+}
+
+static struct benchmark Benchmarks[] = {
+    { "object-type name list", bench_name_list, &Object_Types },
+    { "object-type name indtext", bench_name_indtext, &Object_Types },
+    { "object-type index list", bench_index_list, &Object_Types },
+    { "object-type index indtext", bench_index_indtext, &Object_Types },
+    { "property name list", bench_name_list, &Properties },
+    { "property name indtext", bench_name_indtext, &Properties },
+    { "property index list", bench_index_list, &Properties },
+    { "property index indtext", bench_index_indtext, &Properties },
+    { "property name bactext", bench_property_name, &Properties },
+    { "property index bactext", bench_property_index, &Properties },
+    { "units name list", bench_name_list, &Units },
+    { "units name indtext", bench_name_indtext, &Units },
+    { "units index list", bench_index_list, &Units },
+    { "units index indtext", bench_index_indtext, &Units },
+};
+
+/**
+ * @brief Run one benchmark for at least the minimum duration
+ * @param bench [in] benchmark to run
+ */
+static void benchmark_run(struct benchmark *bench)
+{
+    uint64_t start, elapsed = 0;
+    uint64_t duration = (uint64_t)Duration_Milliseconds * 1000000ULL;
+    unsigned long ops = 0;
+    unsigned long batch = 1;
+    unsigned long i;
+    double seconds;
+
+    /* warm up the caches, and build the lookup tables */
+    (void)bench->pass(bench->corpus);
+    start = clock_nanoseconds();
+    while (elapsed < duration) {
+        for (i = 0; i < batch; i++) {
+            ops += bench->pass(bench->corpus);
+        }
+        elapsed = clock_nanoseconds() - start;
+        if (batch < 1024) {
+            batch *= 2;
+        }
+    }
+    seconds = (double)elapsed / 1.0e9;
+    printf("%-28s %12lu %10.1f %12.0f\n", bench->name, ops,
+        (double)elapsed / (double)ops, (double)ops / seconds);
+}
+
+static void print_usage(const char *filename)
+{
+    printf("Usage: %s [--duration milliseconds][benchmark-name ...]\n",
+        filename);
+    printf("       [--list][--version][--help]\n");
+}
+
+static void print_help(const char *filename)
+{
+    printf("Measure the conversions between BACnet enumerations and their\n"
+           "names, using the indtext lookup tables and the list search.\n");
+    printf("\n");
+    printf("--duration milliseconds:\n"
+           "Minimum run time of each benchmark. Default is 500.\n");
+    printf("\n");
+    printf("benchmark-name:\n"
+           "Run only the benchmarks whose name contains this text.\n");
+    printf("\n");
+    printf("For each benchmark, ops is the number of conversions,\n"
+           "ns/op the average time per conversion, and ops/s the\n"
+           "conversions per second. A name benchmark converts every\n"
+           "enumeration of the list to its name, and an index benchmark\n"
+           "converts every name, in upper case, to its enumeration.\n");
+    printf("\n");
+    printf("Example:\n"
+           "%s --duration 2000 property\n",
+        filename);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter[16];
+    unsigned filter_count = 0;
+    unsigned i, f;
+    int argi = 0;
+    bool list = false;
+    bool selected = false;
+    const char *filename = NULL;
+
+    filename = filename_remove_path(argv[0]);
+    for (argi = 1; argi < argc; argi++) {
+        if (strcmp(argv[argi], "--help") == 0) {
+            print_usage(filename);
+            print_help(filename);
+            return 0;
+        }
+        if (strcmp(argv[argi], "--version") == 0) {
+            printf("%s %s\n", filename, BACNET_VERSION_TEXT);
+            printf("Copyright (C) 2026 by the BACnet Stack contributors.\n"
+                   "This is free software; see the source for copying "
+                   "conditions.\n"
+                   "There is NO warranty; not even for MERCHANTABILITY or\n"
+                   "FITNESS FOR A PARTICULAR PURPOSE.\n");
+            return 0;
+        }
+        if (strcmp(argv[argi], "--list") == 0) {
+            list = true;
+        } else if (strcmp(argv[argi], "--duration") == 0) {
+            if (++argi < argc) {
+                Duration_Milliseconds = strtoul(argv[argi], NULL, 0);
+            }
+        } else if (filter_count < (sizeof(filter) / sizeof(filter[0]))) {
+            filter[filter_count] = argv[argi];
+            filter_count++;
+        }
+    }
+    if (list) {
+        for (i = 0; i < sizeof(Benchmarks) / sizeof(Benchmarks[0]); i++) {
+            printf("%s\n", Benchmarks[i].name);
+        }
+        return 0;
+    }
+    corpus_init(&Object_Types);
+    corpus_init(&Properties);
+    corpus_init(&Units);
+    printf("corpus: %s=%u %s=%u %s=%u names, lookup tables=%u\n",
+        Object_Types.name, Object_Types.count, Properties.name,
+        Properties.count, Units.name, Units.count,
+        (unsigned)INDTEXT_CACHE_SIZE);
+    printf("%-28s %12s %10s %12s\n", "benchmark", "ops", "ns/op", "ops/s");
+    for (i = 0; i < sizeof(Benchmarks) / sizeof(Benchmarks[0]); i++) {
+        selected = (filter_count == 0);
+        for (f = 0; f < filter_count; f++) {
+            if (strstr(Benchmarks[i].name, filter[f])) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            benchmark_run(&Benchmarks[i]);
+        }
+    }
+    indtext_cache_cleanup();
+
+    return 0;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file
+ * @brief Benchmark of the BACnet/IPv6 datalink send and receive paths
+ *
+ * Opens the BACnet/IPv6 datalink on an interface that has an IPv6
+ * address - normally the loopback - and a set of plain UDP sockets on
+ * the same address acting as peers.  The fan-out benchmark sends the
+ * same MPDU to every peer, as a BBMD does when it forwards a broadcast,
+ * once with a bip6_send_mpdu() call per peer and once with
+ * bip6_send_mpdu_list().  The receive benchmark has a peer send bursts
+ * of Original-Unicast-NPDU messages to the datalink, and takes them
+ * with bip6_receive() one system call per datagram and then in batches.
+ * Messages per second are reported for each.
+ *
+ * @date October 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/npdu.h"
+#include "bacnet/version.h"
+#include "bacnet/basic/object/device.h"
+#include "bacnet/basic/sys/filename.h"
+#include "bacnet/datalink/bip6.h"
+#include "bacnet/datalink/bvlc6.h"
+
+/* largest number of peers in the fan-out benchmark */
+#define PEERS_MAX 256
+/* largest burst of datagrams in the receive benchmark */
+#define BURST_MAX 256
+
+static int Peer_Socket[PEERS_MAX];
+static BACNET_IP6_ADDRESS Peer_Address[PEERS_MAX];
+static unsigned Peer_Count = 64;
+static unsigned Burst = 64;
+static unsigned Batch = 32;
+static uint16_t Port = 0xBAC0U;
+static char *Interface = "lo";
+/* minimum run time of each benchmark */
+static unsigned long Duration_Milliseconds = 500;
+
+/**
+ * @brief Read a monotonic clock
+ * @return nanoseconds since an arbitrary epoch
+ */
+static uint64_t clock_nanoseconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Open the peer sockets on the address of the datalink
+ * @return true if all of the peers were opened
+ */
+static bool peers_open(void)
+{
+    BACNET_IP6_ADDRESS addr = { 0 };
+    struct sockaddr_in6 sin = { 0 };
+    socklen_t sin_len = sizeof(sin);
+    int sockopt = 1 << 20;
+    unsigned i;
+
+    bip6_get_addr(&addr);
+    for (i = 0; i < Peer_Count; i++) {
+        Peer_Socket[i] = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+        if (Peer_Socket[i] < 0) {
+            perror("peer socket");
+            return false;
+        }
+        setsockopt(Peer_Socket[i], SOL_SOCKET, SO_RCVBUF, &sockopt,
+            sizeof(sockopt));
+        memset(&sin, 0, sizeof(sin));
+        sin.sin6_family = AF_INET6;
+        memcpy(&sin.sin6_addr, addr.address, IP6_ADDRESS_MAX);
+        sin.sin6_port = 0;
+        if (bind(Peer_Socket[i], (struct sockaddr *)&sin, sizeof(sin)) < 0) {
+            perror("peer bind");
+            return false;
+        }
+        sin_len = sizeof(sin);
+        getsockname(Peer_Socket[i], (struct sockaddr *)&sin, &sin_len);
+        Peer_Address[i] = addr;
+        Peer_Address[i].port = ntohs(sin.sin6_port);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Close the peer sockets
+ */
+static void peers_close(void)
+{
+    unsigned i;
+
+    for (i = 0; i < Peer_Count; i++) {
+        if (Peer_Socket[i] >= 0) {
+            close(Peer_Socket[i]);
+        }
+    }
+}
+
+/**
+ * @brief Take the datagrams waiting at each peer
+ * @return number of datagrams taken
+ */
+static unsigned long peers_drain(void)
+{
+    uint8_t buffer[BIP6_MPDU_MAX];
+    unsigned long count = 0;
+    unsigned i;
+
+    for (i = 0; i < Peer_Count; i++) {
+        while (recv(Peer_Socket[i], buffer, sizeof(buffer), MSG_DONTWAIT) >
+            0) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Send an MPDU to every peer, as a BBMD forwards a broadcast
+ * @param list - true to use bip6_send_mpdu_list()
+ * @param mtu - the MPDU
+ * @param mtu_len - number of bytes in the MPDU
+ */
+static void benchmark_fanout(bool list, uint8_t *mtu, uint16_t mtu_len)
+{
+    uint64_t start, elapsed = 0;
+    unsigned long sent = 0;
+    unsigned long received = 0;
+    unsigned i;
+
+    while (elapsed < (Duration_Milliseconds * 1000000ULL)) {
+        start = clock_nanoseconds();
+        if (list) {
+            sent += bip6_send_mpdu_list(Peer_Address, Peer_Count, mtu, mtu_len);
+        } else {
+            for (i = 0; i < Peer_Count; i++) {
+                if (bip6_send_mpdu(&Peer_Address[i], mtu, mtu_len) > 0) {
+                    sent++;
+                }
+            }
+        }
+        elapsed += clock_nanoseconds() - start;
+        received += peers_drain();
+    }
+    printf("fan-out %-12s %4u peers %12.0f msg/s %9.1f ns/msg "
+           "(%lu sent, %lu received)\n",
+        list ? "sendmmsg" : "sendto", Peer_Count,
+        (double)sent * 1.0e9 / (double)elapsed,
+        (double)elapsed / (double)(sent ? sent : 1), sent, received);
+}
+
+/**
+ * @brief Have the first peer send bursts of Original-Unicast-NPDU to
+ *  the datalink, and take them with bip6_receive()
+ * @param batch - number of datagrams taken by each system call
+ * @param mtu - the MPDU
+ * @param mtu_len - number of bytes in the MPDU
+ */
+static void benchmark_receive(unsigned batch, uint8_t *mtu, uint16_t mtu_len)
+{
+    BACNET_ADDRESS src = { 0 };
+    BACNET_IP6_ADDRESS addr = { 0 };
+    struct sockaddr_in6 sin = { 0 };
+    uint8_t npdu[MAX_NPDU + MAX_APDU];
+    uint64_t start, elapsed = 0;
+    unsigned long received = 0;
+    unsigned long lost = 0;
+    unsigned long sent = 0;
+    unsigned count, i;
+
+    bip6_get_addr(&addr);
+    sin.sin6_family = AF_INET6;
+    memcpy(&sin.sin6_addr, addr.address, IP6_ADDRESS_MAX);
+    sin.sin6_port = htons(bip6_get_port());
+    bip6_set_receive_batch(batch);
+    while (elapsed < (Duration_Milliseconds * 1000000ULL)) {
+        count = 0;
+        for (i = 0; i < Burst; i++) {
+            if (sendto(Peer_Socket[0], mtu, mtu_len, 0,
+                    (struct sockaddr *)&sin, sizeof(sin)) > 0) {
+                count++;
+            }
+        }
+        sent += count;
+        start = clock_nanoseconds();
+        while (count > 0) {
+            if (bip6_receive(&src, npdu, sizeof(npdu), 10) > 0) {
+                received++;
+                count--;
+            } else {
+                /* a timeout: the socket dropped the rest of the burst */
+                lost += count;
+                break;
+            }
+        }
+        elapsed += clock_nanoseconds() - start;
+    }
+    printf("receive batch %-6u %4u burst %12.0f msg/s %9.1f ns/msg "
+           "(%lu sent, %lu lost)\n",
+        batch, Burst, (double)received * 1.0e9 / (double)elapsed,
+        (double)elapsed / (double)(received ? received : 1), sent, lost);
+}
+
+static void print_usage(const char *filename)
+{
+    printf("Usage: %s [--interface name][--port N][--peers N]\n", filename);
+    printf("       [--burst N][--batch N][--duration ms]\n");
+    printf("       [--version][--help]\n");
+}
+
+static void print_help(const char *filename)
+{
+    printf("Measure the messages per second of the BACnet/IPv6 datalink\n"
+           "when it sends one MPDU to many peers, as a BBMD does, and\n"
+           "when it receives bursts of datagrams.\n");
+    printf("\n");
+    printf("--interface name:\n"
+           "Interface with the IPv6 address to use. Default lo.\n");
+    printf("--port N:\n"
+           "UDP port of the datalink. Default 47808.\n");
+    printf("--peers N:\n"
+           "Number of peers in the fan-out, 1..%u. Default 64.\n",
+        PEERS_MAX);
+    printf("--burst N:\n"
+           "Number of datagrams in each receive burst, 1..%u. Default 64.\n",
+        BURST_MAX);
+    printf("--batch N:\n"
+           "Datagrams taken by each receive system call in the batched\n"
+           "receive benchmark. Default 32.\n");
+    printf("--duration ms:\n"
+           "Minimum run time of each benchmark. Default 500.\n");
+    printf("\n");
+    printf("Example:\n"
+           "%s --peers 200 --burst 128 --port 47900\n",
+        filename);
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t mtu[BIP6_MPDU_MAX];
+    uint8_t npdu[64];
+    int mtu_len = 0;
+    int argi = 0;
+    unsigned i;
+    const char *filename = NULL;
+
+    filename = filename_remove_path(argv[0]);
+    for (argi = 1; argi < argc; argi++) {
+        if (strcmp(argv[argi], "--help") == 0) {
+            print_usage(filename);
+            print_help(filename);
+            return 0;
+        }
+        if (strcmp(argv[argi], "--version") == 0) {
+            printf("%s %s\n", filename, BACNET_VERSION_TEXT);
+            printf("Copyright (C) 2026 by the BACnet Stack contributors.\n"
+                   "This is free software; see the source for copying "
+                   "conditions.\n"
+                   "There is NO warranty; not even for MERCHANTABILITY or\n"
+                   "FITNESS FOR A PARTICULAR PURPOSE.\n");
+            return 0;
+        }
+        if ((argi + 1) >= argc) {
+            print_usage(filename);
+            return 1;
+        }
+        if (strcmp(argv[argi], "--interface") == 0) {
+            Interface = argv[++argi];
+        } else if (strcmp(argv[argi], "--port") == 0) {
+            Port = (uint16_t)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--peers") == 0) {
+            Peer_Count = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--burst") == 0) {
+            Burst = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--batch") == 0) {
+            Batch = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--duration") == 0) {
+            Duration_Milliseconds = strtoul(argv[++argi], NULL, 0);
+        } else {
+            print_usage(filename);
+            return 1;
+        }
+    }
+    if ((Peer_Count == 0) || (Peer_Count > PEERS_MAX) || (Burst == 0) ||
+        (Burst > BURST_MAX) || (Batch == 0) || (Port == 0)) {
+        print_usage(filename);
+        return 1;
+    }
+    for (i = 0; i < PEERS_MAX; i++) {
+        Peer_Socket[i] = -1;
+    }
+    Device_Init(NULL);
+    bip6_set_port(Port);
+    if (!bip6_init(Interface)) {
+        fprintf(stderr, "unable to open BACnet/IPv6 on %s\n", Interface);
+        return 1;
+    }
+    if (!peers_open()) {
+        peers_close();
+        bip6_cleanup();
+        return 1;
+    }
+    /* a small NPDU, such as a forwarded Who-Is */
+    memset(npdu, 0, sizeof(npdu));
+    npdu[0] = BACNET_PROTOCOL_VERSION;
+    mtu_len = bvlc6_encode_original_unicast(mtu, sizeof(mtu), 0x123456,
+        Device_Object_Instance_Number(), npdu, 24);
+    benchmark_fanout(false, mtu, (uint16_t)mtu_len);
+    benchmark_fanout(true, mtu, (uint16_t)mtu_len);
+    benchmark_receive(1, mtu, (uint16_t)mtu_len);
+    benchmark_receive(Batch, mtu, (uint16_t)mtu_len);
+    peers_close();
+    bip6_cleanup();
+
+    return 0;
+}
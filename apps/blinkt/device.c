@@ -102,7 +102,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Lighting_Output_Create, Lighting_Output_Delete, Lighting_Output_Timer },
+        Lighting_Output_Create, Lighting_Output_Delete,
+        NULL /* Timer - see Lighting_Output_Transition_Timer() */ },
     { OBJECT_CHANNEL, Channel_Init, Channel_Count, Channel_Index_To_Instance,
         Channel_Valid_Instance, Channel_Object_Name, Channel_Read_Property,
         Channel_Write_Property, Channel_Property_Lists,
@@ -2038,4 +2039,7 @@ void Device_Timer(uint16_t milliseconds)
         }
         pObject++;
     }
+#if (BACNET_PROTOCOL_REVISION >= 14)
+    Lighting_Output_Transition_Timer(milliseconds);
+#endif
 }
@@ -0,0 +1,773 @@
+/**
+ * @file
+ * @brief Microbenchmarks for the BACnet encode and decode primitives
+ *
+ * Builds realistic corpora in memory - ReadPropertyMultiple-ACK,
+ * COV notifications, ReadRange trend log responses, and Object_List
+ * arrays - using the encoders of the stack, and then times the
+ * primitives that dominate the decode path of a head-end:
+ * bacnet_tag_decode(), bacnet_unsigned_decode(),
+ * bacapp_decode_application_data(), bacapp_encode_application_data(),
+ * bacapp_decode_known_property(), and the service decoders built on them.
+ *
+ * @date October 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#include "bacnet/bacdef.h"
+#include "bacnet/bacdcode.h"
+#include "bacnet/bacapp.h"
+#include "bacnet/bacstr.h"
+#include "bacnet/datetime.h"
+#include "bacnet/cov.h"
+#include "bacnet/rpm.h"
+#include "bacnet/readrange.h"
+#include "bacnet/version.h"
+#include "bacnet/basic/sys/filename.h"
+
+/* size of the corpus buffers - larger than MAX_APDU on purpose,
+   since segmented responses are the common case at a head-end */
+#define CORPUS_SIZE 8192
+/* number of analog inputs in the RPM-ACK corpus */
+#define RPM_OBJECTS 20
+/* number of elements in the Object_List corpus */
+#define OBJECT_LIST_SIZE 1000
+/* number of log records in the ReadRange corpus */
+#define TREND_RECORDS 50
+/* number of values in the unsigned corpus */
+#define UNSIGNED_VALUES 256
+
+struct corpus {
+    const char *name;
+    uint8_t buffer[CORPUS_SIZE];
+    int length;
+};
+
+struct benchmark {
+    const char *name;
+    /* one pass over the corpus; adds the primitive calls made */
+    unsigned long (*pass)(void);
+    /* bytes handled by one pass */
+    int *bytes;
+};
+
+static struct corpus RPM_Ack = { "rpm-ack", { 0 }, 0 };
+static struct corpus COV_Notification = { "cov", { 0 }, 0 };
+static struct corpus Read_Range_Ack = { "readrange", { 0 }, 0 };
+static struct corpus Object_List = { "object-list", { 0 }, 0 };
+static struct corpus Unsigned_List = { "unsigned", { 0 }, 0 };
+/* offset and length of each value in the unsigned corpus */
+static int Unsigned_Offset[UNSIGNED_VALUES];
+static uint32_t Unsigned_Length[UNSIGNED_VALUES];
+/* values decoded from the Object_List corpus, for the encoder */
+static BACNET_APPLICATION_DATA_VALUE Object_List_Value[OBJECT_LIST_SIZE];
+/* values decoded from the RPM-ACK corpus, for the encoder */
+static BACNET_APPLICATION_DATA_VALUE RPM_Value[RPM_OBJECTS * 8];
+static unsigned RPM_Value_Count;
+static int RPM_Value_Length;
+/* keeps the compiler from discarding the decoded results */
+static volatile unsigned long Sink;
+/* minimum run time of each benchmark */
+static unsigned long Duration_Milliseconds = 500;
+
+/**
+ * @brief Read a monotonic clock
+ * @return nanoseconds since an arbitrary epoch
+ */
+static uint64_t clock_nanoseconds(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER count;
+
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&count);
+    return (uint64_t)((double)count.QuadPart * 1.0e9 /
+        (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Build a ReadPropertyMultiple-ACK for a screen of analog inputs
+ */
+static void corpus_rpm_ack_init(void)
+{
+    uint8_t *apdu = RPM_Ack.buffer;
+    uint8_t value_apdu[MAX_APDU];
+    BACNET_RPM_DATA rpmdata = { 0 };
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_PROPERTY_ID property[] = { PROP_OBJECT_NAME, PROP_PRESENT_VALUE,
+        PROP_STATUS_FLAGS, PROP_UNITS, PROP_RELIABILITY, PROP_OUT_OF_SERVICE,
+        PROP_DESCRIPTION };
+    char text[64];
+    unsigned i, p;
+    int len = 0;
+    int value_len = 0;
+
+    for (i = 0; i < RPM_OBJECTS; i++) {
+        rpmdata.object_type = OBJECT_ANALOG_INPUT;
+        rpmdata.object_instance = i + 1;
+        len += rpm_ack_encode_apdu_object_begin(&apdu[len], &rpmdata);
+        for (p = 0; p < sizeof(property) / sizeof(property[0]); p++) {
+            len += rpm_ack_encode_apdu_object_property(
+                &apdu[len], property[p], BACNET_ARRAY_ALL);
+            memset(&value, 0, sizeof(value));
+            switch (property[p]) {
+                case PROP_OBJECT_NAME:
+                    snprintf(text, sizeof(text), "AHU-%02u Zone Temp", i + 1);
+                    value.tag = BACNET_APPLICATION_TAG_CHARACTER_STRING;
+                    characterstring_init_ansi(
+                        &value.type.Character_String, text);
+                    break;
+                case PROP_PRESENT_VALUE:
+                    value.tag = BACNET_APPLICATION_TAG_REAL;
+                    value.type.Real = 20.0f + (float)i / 8.0f;
+                    break;
+                case PROP_STATUS_FLAGS:
+                    value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
+                    bitstring_init(&value.type.Bit_String);
+                    bitstring_set_bit(&value.type.Bit_String,
+                        STATUS_FLAG_IN_ALARM, false);
+                    bitstring_set_bit(
+                        &value.type.Bit_String, STATUS_FLAG_FAULT, false);
+                    bitstring_set_bit(&value.type.Bit_String,
+                        STATUS_FLAG_OVERRIDDEN, false);
+                    bitstring_set_bit(&value.type.Bit_String,
+                        STATUS_FLAG_OUT_OF_SERVICE, false);
+                    break;
+                case PROP_UNITS:
+                    value.tag = BACNET_APPLICATION_TAG_ENUMERATED;
+                    value.type.Enumerated = UNITS_DEGREES_CELSIUS;
+                    break;
+                case PROP_RELIABILITY:
+                    value.tag = BACNET_APPLICATION_TAG_ENUMERATED;
+                    value.type.Enumerated = RELIABILITY_NO_FAULT_DETECTED;
+                    break;
+                case PROP_OUT_OF_SERVICE:
+                    value.tag = BACNET_APPLICATION_TAG_BOOLEAN;
+                    value.type.Boolean = false;
+                    break;
+                default:
+                    snprintf(text, sizeof(text),
+                        "Supply air temperature, floor %u", i / 4 + 1);
+                    value.tag = BACNET_APPLICATION_TAG_CHARACTER_STRING;
+                    characterstring_init_ansi(
+                        &value.type.Character_String, text);
+                    break;
+            }
+            if (RPM_Value_Count < (sizeof(RPM_Value) / sizeof(RPM_Value[0]))) {
+                RPM_Value[RPM_Value_Count] = value;
+                RPM_Value_Count++;
+            }
+            value_len = bacapp_encode_application_data(value_apdu, &value);
+            RPM_Value_Length += value_len;
+            len += rpm_ack_encode_apdu_object_property_value(
+                &apdu[len], value_apdu, (unsigned)value_len);
+        }
+        len += rpm_ack_encode_apdu_object_end(&apdu[len]);
+    }
+    RPM_Ack.length = len;
+}
+
+/**
+ * @brief Build a COV notification for an analog input
+ */
+static void corpus_cov_init(void)
+{
+    BACNET_COV_DATA data = { 0 };
+    BACNET_PROPERTY_VALUE value_list[2];
+
+    data.subscriberProcessIdentifier = 1;
+    data.initiatingDeviceIdentifier = 260001;
+    data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    data.monitoredObjectIdentifier.instance = 5;
+    data.timeRemaining = 3600;
+    cov_data_value_list_link(&data, value_list, 2);
+    cov_value_list_encode_real(value_list, 21.5f, false, false, false, false);
+    COV_Notification.length =
+        cov_notify_encode_apdu(COV_Notification.buffer, &data);
+}
+
+/**
+ * @brief Build a ReadRange-ACK with REAL log records from a trend log
+ */
+static void corpus_read_range_init(void)
+{
+    uint8_t item_data[MAX_APDU];
+    BACNET_READ_RANGE_DATA rrdata = { 0 };
+    BACNET_DATE_TIME timestamp = { 0 };
+    BACNET_BIT_STRING status_flags = { 0 };
+    unsigned i;
+    int len = 0;
+
+    bitstring_init(&status_flags);
+    bitstring_set_bit(&status_flags, STATUS_FLAG_IN_ALARM, false);
+    bitstring_set_bit(&status_flags, STATUS_FLAG_FAULT, false);
+    bitstring_set_bit(&status_flags, STATUS_FLAG_OVERRIDDEN, false);
+    bitstring_set_bit(&status_flags, STATUS_FLAG_OUT_OF_SERVICE, false);
+    for (i = 0; i < TREND_RECORDS; i++) {
+        datetime_set_values(
+            &timestamp, 2026, 10, 19, (uint8_t)(i / 4), (uint8_t)((i % 4) * 15),
+            0, 0);
+        /* BACnetLogRecord */
+        len += encode_opening_tag(&item_data[len], 0);
+        len += encode_application_date(&item_data[len], &timestamp.date);
+        len += encode_application_time(&item_data[len], &timestamp.time);
+        len += encode_closing_tag(&item_data[len], 0);
+        len += encode_opening_tag(&item_data[len], 1);
+        len += encode_context_real(&item_data[len], 2, 20.0f + (float)i / 10.0f);
+        len += encode_closing_tag(&item_data[len], 1);
+        len += encode_context_bitstring(&item_data[len], 2, &status_flags);
+    }
+    rrdata.object_type = OBJECT_TRENDLOG;
+    rrdata.object_instance = 1;
+    rrdata.object_property = PROP_LOG_BUFFER;
+    rrdata.array_index = BACNET_ARRAY_ALL;
+    bitstring_init(&rrdata.ResultFlags);
+    bitstring_set_bit(&rrdata.ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
+    bitstring_set_bit(&rrdata.ResultFlags, RESULT_FLAG_LAST_ITEM, false);
+    bitstring_set_bit(&rrdata.ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
+    rrdata.ItemCount = TREND_RECORDS;
+    rrdata.FirstSequence = 1;
+    rrdata.RequestType = RR_BY_SEQUENCE;
+    rrdata.application_data = item_data;
+    rrdata.application_data_len = len;
+    len = rr_ack_encode_apdu(Read_Range_Ack.buffer, 1, &rrdata);
+    /* keep only the service ACK, without the APDU header */
+    Read_Range_Ack.length = len - 3;
+    memmove(Read_Range_Ack.buffer, &Read_Range_Ack.buffer[3],
+        (size_t)Read_Range_Ack.length);
+}
+
+/**
+ * @brief Build the Object_List of a large controller
+ */
+static void corpus_object_list_init(void)
+{
+    BACNET_OBJECT_TYPE object_type[] = { OBJECT_ANALOG_INPUT,
+        OBJECT_ANALOG_OUTPUT, OBJECT_ANALOG_VALUE, OBJECT_BINARY_INPUT,
+        OBJECT_BINARY_OUTPUT, OBJECT_BINARY_VALUE, OBJECT_MULTI_STATE_VALUE,
+        OBJECT_TRENDLOG };
+    unsigned i;
+    int len = 0;
+
+    len += encode_application_object_id(
+        &Object_List.buffer[len], OBJECT_DEVICE, 260001);
+    for (i = 1; i < OBJECT_LIST_SIZE; i++) {
+        len += encode_application_object_id(&Object_List.buffer[len],
+            object_type[i % (sizeof(object_type) / sizeof(object_type[0]))],
+            i);
+    }
+    Object_List.length = len;
+}
+
+/**
+ * @brief Build application encoded unsigned values of every width
+ */
+static void corpus_unsigned_init(void)
+{
+    BACNET_TAG tag = { 0 };
+    BACNET_UNSIGNED_INTEGER value = 0;
+    unsigned i;
+    int len = 0;
+    int tag_len = 0;
+
+    for (i = 0; i < UNSIGNED_VALUES; i++) {
+        /* 1, 2, 3 and 4 octet values, like counts, indexes and instances */
+        switch (i % 4) {
+            case 0:
+                value = i & 0xFF;
+                break;
+            case 1:
+                value = 0x100UL + i;
+                break;
+            case 2:
+                value = 0x10000UL + i;
+                break;
+            default:
+                value = 0x1000000UL + i;
+                break;
+        }
+        tag_len = encode_application_unsigned(&Unsigned_List.buffer[len], value);
+        tag_len = bacnet_tag_decode(
+            &Unsigned_List.buffer[len], (uint32_t)tag_len, &tag);
+        Unsigned_Offset[i] = len + tag_len;
+        Unsigned_Length[i] = tag.len_value_type;
+        len = Unsigned_Offset[i] + (int)tag.len_value_type;
+    }
+    Unsigned_List.length = len;
+}
+
+/**
+ * @brief Decode every tag of a corpus, skipping over the values
+ * @param corpus [in] corpus to walk
+ * @return number of tags decoded
+ */
+static unsigned long tag_walk(struct corpus *corpus)
+{
+    BACNET_TAG tag = { 0 };
+    unsigned long count = 0;
+    int len = 0;
+    int tag_len = 0;
+
+    while (len < corpus->length) {
+        tag_len = bacnet_tag_decode(&corpus->buffer[len],
+            (uint32_t)(corpus->length - len), &tag);
+        if (tag_len <= 0) {
+            break;
+        }
+        len += tag_len;
+        if (!tag.opening && !tag.closing) {
+            if (tag.application &&
+                (tag.number == BACNET_APPLICATION_TAG_BOOLEAN)) {
+                /* the value is in the tag */
+            } else {
+                len += (int)tag.len_value_type;
+            }
+        }
+        count++;
+    }
+    Sink += tag.len_value_type;
+
+    return count;
+}
+
+static unsigned long bench_tag_rpm_ack(void)
+{
+    return tag_walk(&RPM_Ack);
+}
+
+static unsigned long bench_tag_cursor_rpm_ack(void)
+{
+    BACNET_TAG_CURSOR cursor = { 0 };
+    unsigned long count = 0;
+
+    bacnet_tag_cursor_init(&cursor, RPM_Ack.buffer, (uint32_t)RPM_Ack.length);
+    while (bacnet_tag_cursor_next(&cursor)) {
+        count++;
+    }
+    Sink += cursor.offset;
+
+    return count;
+}
+
+static unsigned long bench_tag_cov(void)
+{
+    return tag_walk(&COV_Notification);
+}
+
+static unsigned long bench_tag_read_range(void)
+{
+    return tag_walk(&Read_Range_Ack);
+}
+
+static unsigned long bench_tag_object_list(void)
+{
+    return tag_walk(&Object_List);
+}
+
+static unsigned long bench_unsigned_decode(void)
+{
+    BACNET_UNSIGNED_INTEGER value = 0;
+    BACNET_UNSIGNED_INTEGER sum = 0;
+    unsigned i;
+
+    for (i = 0; i < UNSIGNED_VALUES; i++) {
+        (void)bacnet_unsigned_decode(
+            &Unsigned_List.buffer[Unsigned_Offset[i]],
+            (uint32_t)(Unsigned_List.length - Unsigned_Offset[i]),
+            Unsigned_Length[i], &value);
+        sum += value;
+    }
+    Sink += (unsigned long)sum;
+
+    return UNSIGNED_VALUES;
+}
+
+static unsigned long bench_application_decode_object_list(void)
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    unsigned long count = 0;
+    int len = 0;
+    int value_len = 0;
+
+    while (len < Object_List.length) {
+        value_len = bacapp_decode_application_data(&Object_List.buffer[len],
+            (unsigned)(Object_List.length - len), &value);
+        if (value_len <= 0) {
+            break;
+        }
+        len += value_len;
+        count++;
+    }
+    Sink += value.type.Object_Id.instance;
+
+    return count;
+}
+
+static unsigned long bench_packed_decode_object_list(void)
+{
+    static BACNET_OBJECT_ID object_list[OBJECT_LIST_SIZE];
+    uint32_t count = 0;
+
+    (void)bacapp_decode_array_packed(Object_List.buffer,
+        (uint32_t)Object_List.length, BACNET_APPLICATION_TAG_OBJECT_ID,
+        object_list, NULL, OBJECT_LIST_SIZE, &count);
+    if (count) {
+        Sink += object_list[count - 1].instance;
+    }
+
+    return count;
+}
+
+static unsigned long bench_known_property_object_list(void)
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    unsigned long count = 0;
+    int len = 0;
+    int value_len = 0;
+
+    while (len < Object_List.length) {
+        value_len = bacapp_decode_known_property(&Object_List.buffer[len],
+            Object_List.length - len, &value, OBJECT_DEVICE,
+            PROP_OBJECT_LIST);
+        if (value_len <= 0) {
+            break;
+        }
+        len += value_len;
+        count++;
+    }
+    Sink += value.type.Object_Id.instance;
+
+    return count;
+}
+
+static unsigned long bench_application_encode_object_list(void)
+{
+    uint8_t apdu[CORPUS_SIZE];
+    unsigned i;
+    int len = 0;
+
+    for (i = 0; i < OBJECT_LIST_SIZE; i++) {
+        len += bacapp_encode_application_data(&apdu[len], &Object_List_Value[i]);
+    }
+    Sink += apdu[len - 1];
+
+    return OBJECT_LIST_SIZE;
+}
+
+static unsigned long bench_application_encode_rpm_values(void)
+{
+    uint8_t apdu[CORPUS_SIZE];
+    unsigned i;
+    int len = 0;
+
+    for (i = 0; i < RPM_Value_Count; i++) {
+        len += bacapp_encode_application_data(&apdu[len], &RPM_Value[i]);
+    }
+    Sink += apdu[len - 1];
+
+    return RPM_Value_Count;
+}
+
+/**
+ * @brief Decode the RPM-ACK corpus the way the RPM-ACK handler does,
+ *  without building the linked list of results
+ * @return number of property values decoded
+ */
+static unsigned long bench_rpm_ack_decode(void)
+{
+    uint8_t *apdu = RPM_Ack.buffer;
+    int apdu_len = RPM_Ack.length;
+    BACNET_OBJECT_TYPE object_type = OBJECT_NONE;
+    uint32_t object_instance = 0;
+    BACNET_PROPERTY_ID property = PROP_ALL;
+    BACNET_ARRAY_INDEX array_index = BACNET_ARRAY_ALL;
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    unsigned long count = 0;
+    int len = 0;
+
+    while (apdu_len > 0) {
+        len = rpm_ack_decode_object_id(
+            apdu, (unsigned)apdu_len, &object_type, &object_instance);
+        if (len <= 0) {
+            break;
+        }
+        apdu += len;
+        apdu_len -= len;
+        while (apdu_len > 0) {
+            len = rpm_ack_decode_object_property(
+                apdu, (unsigned)apdu_len, &property, &array_index);
+            if (len <= 0) {
+                break;
+            }
+            apdu += len;
+            apdu_len -= len;
+            if (!bacnet_is_opening_tag_number(apdu, apdu_len, 4, &len)) {
+                break;
+            }
+            apdu += len;
+            apdu_len -= len;
+            while (apdu_len > 0) {
+                if (bacnet_is_closing_tag_number(apdu, apdu_len, 4, &len)) {
+                    apdu += len;
+                    apdu_len -= len;
+                    break;
+                }
+                len = bacapp_decode_known_property(
+                    apdu, apdu_len, &value, object_type, property);
+                if (len <= 0) {
+                    return count;
+                }
+                apdu += len;
+                apdu_len -= len;
+                count++;
+            }
+        }
+        len = rpm_ack_decode_object_end(apdu, (unsigned)apdu_len);
+        apdu += len;
+        apdu_len -= len;
+    }
+    Sink += object_instance;
+
+    return count;
+}
+
+static unsigned long bench_cov_decode(void)
+{
+    BACNET_COV_DATA data = { 0 };
+    BACNET_PROPERTY_VALUE value_list[4];
+
+    cov_data_value_list_link(&data, value_list, 4);
+    (void)cov_notify_decode_service_request(
+        COV_Notification.buffer, (unsigned)COV_Notification.length, &data);
+    Sink += data.monitoredObjectIdentifier.instance;
+
+    return 1;
+}
+
+/**
+ * @brief Decode the RPM-ACK corpus into compact values
+ * @return number of property values decoded
+ */
+static unsigned long bench_rpm_ack_decode_compact(void)
+{
+    static BACNET_RPM_COMPACT_RESULT results[RPM_OBJECTS * 8];
+    unsigned count = 0;
+
+    (void)rpm_ack_decode_compact(RPM_Ack.buffer, (unsigned)RPM_Ack.length,
+        results, sizeof(results) / sizeof(results[0]), &count);
+    Sink += results[0].object_instance;
+
+    return count;
+}
+
+static unsigned long bench_cov_decode_compact(void)
+{
+    BACNET_COV_COMPACT_DATA data = { 0 };
+    BACNET_PROPERTY_COMPACT_VALUE value_list[4] = { { 0 } };
+    unsigned i;
+
+    for (i = 0; i < 3; i++) {
+        value_list[i].next = &value_list[i + 1];
+    }
+    data.listOfValues = value_list;
+    (void)cov_notify_decode_compact_service_request(
+        COV_Notification.buffer, (unsigned)COV_Notification.length, &data);
+    Sink += data.monitoredObjectIdentifier.instance;
+
+    return 1;
+}
+
+static unsigned long bench_read_range_decode(void)
+{
+    BACNET_READ_RANGE_DATA rrdata = { 0 };
+
+    (void)rr_ack_decode_service_request(
+        Read_Range_Ack.buffer, Read_Range_Ack.length, &rrdata);
+    Sink += rrdata.ItemCount;
+
+    return 1;
+}
+
+static struct benchmark Benchmarks[] = {
+    { "tag-decode rpm-ack", bench_tag_rpm_ack, &RPM_Ack.length },
+    { "tag-cursor rpm-ack", bench_tag_cursor_rpm_ack, &RPM_Ack.length },
+    { "tag-decode cov", bench_tag_cov, &COV_Notification.length },
+    { "tag-decode readrange", bench_tag_read_range, &Read_Range_Ack.length },
+    { "tag-decode object-list", bench_tag_object_list, &Object_List.length },
+    { "unsigned-decode", bench_unsigned_decode, &Unsigned_List.length },
+    { "app-decode object-list", bench_application_decode_object_list,
+        &Object_List.length },
+    { "packed-decode object-list", bench_packed_decode_object_list,
+        &Object_List.length },
+    { "known-property object-list", bench_known_property_object_list,
+        &Object_List.length },
+    { "app-encode object-list", bench_application_encode_object_list,
+        &Object_List.length },
+    { "app-encode rpm-values", bench_application_encode_rpm_values,
+        &RPM_Value_Length },
+    { "rpm-ack-decode", bench_rpm_ack_decode, &RPM_Ack.length },
+    { "rpm-ack-decode compact", bench_rpm_ack_decode_compact,
+        &RPM_Ack.length },
+    { "cov-notify-decode", bench_cov_decode, &COV_Notification.length },
+    { "cov-notify-decode compact", bench_cov_decode_compact,
+        &COV_Notification.length },
+    { "readrange-ack-decode", bench_read_range_decode,
+        &Read_Range_Ack.length },
+};
+
+/**
+ * @brief Run one benchmark for at least the minimum duration
+ * @param bench [in] benchmark to run
+ */
+static void benchmark_run(struct benchmark *bench)
+{
+    uint64_t start, elapsed = 0;
+    uint64_t duration = (uint64_t)Duration_Milliseconds * 1000000ULL;
+    unsigned long passes = 0;
+    unsigned long ops = 0;
+    unsigned long batch = 1;
+    unsigned long i;
+    double bytes;
+    double seconds;
+
+    /* warm up the caches and the branch predictors */
+    (void)bench->pass();
+    start = clock_nanoseconds();
+    while (elapsed < duration) {
+        for (i = 0; i < batch; i++) {
+            ops += bench->pass();
+        }
+        passes += batch;
+        elapsed = clock_nanoseconds() - start;
+        if (batch < 1024) {
+            batch *= 2;
+        }
+    }
+    seconds = (double)elapsed / 1.0e9;
+    bytes = (double)*bench->bytes * (double)passes;
+    printf("%-28s %10lu %10.1f %12.1f\n", bench->name, ops,
+        (double)elapsed / (double)ops, bytes / seconds / 1.0e6);
+}
+
+static void print_usage(const char *filename)
+{
+    printf("Usage: %s [--duration milliseconds][benchmark-name ...]\n",
+        filename);
+    printf("       [--list][--version][--help]\n");
+}
+
+static void print_help(const char *filename)
+{
+    printf("Measure the throughput of the BACnet encode and decode\n"
+           "primitives over in-memory corpora of RPM-ACK, COV notification,\n"
+           "ReadRange trend log, and Object_List encodings.\n");
+    printf("\n");
+    printf("--duration milliseconds:\n"
+           "Minimum run time of each benchmark. Default is 500.\n");
+    printf("\n");
+    printf("benchmark-name:\n"
+           "Run only the benchmarks whose name contains this text.\n");
+    printf("\n");
+    printf("For each benchmark, ops is the number of primitive calls,\n"
+           "ns/op the average time per call, and MB/s the corpus bytes\n"
+           "handled per second.\n");
+    printf("\n");
+    printf("Example:\n"
+           "%s --duration 2000 object-list\n",
+        filename);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter[16];
+    unsigned filter_count = 0;
+    unsigned i, f;
+    int argi = 0;
+    bool list = false;
+    bool selected = false;
+    const char *filename = NULL;
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    int len = 0;
+
+    filename = filename_remove_path(argv[0]);
+    for (argi = 1; argi < argc; argi++) {
+        if (strcmp(argv[argi], "--help") == 0) {
+            print_usage(filename);
+            print_help(filename);
+            return 0;
+        }
+        if (strcmp(argv[argi], "--version") == 0) {
+            printf("%s %s\n", filename, BACNET_VERSION_TEXT);
+            printf("Copyright (C) 2026 by the BACnet Stack contributors.\n"
+                   "This is free software; see the source for copying "
+                   "conditions.\n"
+                   "There is NO warranty; not even for MERCHANTABILITY or\n"
+                   "FITNESS FOR A PARTICULAR PURPOSE.\n");
+            return 0;
+        }
+        if (strcmp(argv[argi], "--list") == 0) {
+            list = true;
+        } else if (strcmp(argv[argi], "--duration") == 0) {
+            if (++argi < argc) {
+                Duration_Milliseconds = strtoul(argv[argi], NULL, 0);
+            }
+        } else if (filter_count < (sizeof(filter) / sizeof(filter[0]))) {
+            filter[filter_count] = argv[argi];
+            filter_count++;
+        }
+    }
+    if (list) {
+        for (i = 0; i < sizeof(Benchmarks) / sizeof(Benchmarks[0]); i++) {
+            printf("%s\n", Benchmarks[i].name);
+        }
+        return 0;
+    }
+    corpus_rpm_ack_init();
+    corpus_cov_init();
+    corpus_read_range_init();
+    corpus_object_list_init();
+    corpus_unsigned_init();
+    for (i = 0; i < OBJECT_LIST_SIZE; i++) {
+        len += bacapp_decode_application_data(&Object_List.buffer[len],
+            (unsigned)(Object_List.length - len), &value);
+        Object_List_Value[i] = value;
+    }
+    printf("corpus: %s=%d %s=%d %s=%d %s=%d %s=%d bytes\n", RPM_Ack.name,
+        RPM_Ack.length, COV_Notification.name, COV_Notification.length,
+        Read_Range_Ack.name, Read_Range_Ack.length, Object_List.name,
+        Object_List.length, Unsigned_List.name, Unsigned_List.length);
+    printf("%-28s %10s %10s %12s\n", "benchmark", "ops", "ns/op", "MB/s");
+    for (i = 0; i < sizeof(Benchmarks) / sizeof(Benchmarks[0]); i++) {
+        selected = (filter_count == 0);
+        for (f = 0; f < filter_count; f++) {
+            if (strstr(Benchmarks[i].name, filter[f])) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            benchmark_run(&Benchmarks[i]);
+        }
+    }
+
+    return 0;
+}
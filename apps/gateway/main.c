@@ -52,6 +52,7 @@
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/basic/object/lc.h"
 #include "bacnet/basic/sys/debug.h"
+#include "bacnet/basic/sys/mstimer.h"
 #include "bacnet/version.h"
 /* include the device object */
 #include "bacnet/basic/object/device.h"
@@ -79,11 +80,38 @@ int DNET_list[2] = {
     VIRTUAL_DNET, -1 /* Need -1 terminator */
 };
 
+/* number of Devices in this demo, including the gateway Device */
+#ifndef GATEWAY_DEMO_DEVICES
+#define GATEWAY_DEMO_DEVICES 32
+#endif
+#if (GATEWAY_DEMO_DEVICES > MAX_NUM_DEVICES)
+#error GATEWAY_DEMO_DEVICES exceeds MAX_NUM_DEVICES
+#endif
+
 /* current version of the BACnet stack */
 static const char *BACnet_Version = BACNET_VERSION_TEXT;
 
 /* routed devices - I-Am on startup */
 static unsigned Routed_Device_Index;
+/* timer for the scheduled I-Am responses */
+static struct mstimer Who_Is_Timer;
+
+/** Get a number from an environment variable
+ * @param name [in] name of the environment variable
+ * @param value [in] value when the variable is not set
+ * @return the number
+ */
+static unsigned long environment_number(const char *name, unsigned long value)
+{
+    const char *pEnv;
+
+    pEnv = getenv(name);
+    if (pEnv) {
+        value = strtoul(pEnv, NULL, 0);
+    }
+
+    return value;
+}
 
 /** Initialize the Device Objects and each of the child Object instances.
  * @param first_object_instance Set the first (gateway) Device to this
@@ -101,7 +129,7 @@ static void Devices_Init(uint32_t first_object_instance)
     Routed_Device_Set_Description(DEV_DESCR_GATEWAY, strlen(DEV_DESCR_GATEWAY));
 
     /* Now initialize the remote Device objects. */
-    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+    for (i = 1; i < GATEWAY_DEMO_DEVICES; i++) {
         snprintf(nameText, MAX_DEV_NAME_LEN, "%s %d", DEV_NAME_BASE, i + 1);
         snprintf(descText, MAX_DEV_DESC_LEN, "%s %d", DEV_DESCR_REMOTE, i);
         characterstring_init_ansi(&name_string, nameText);
@@ -123,6 +151,7 @@ static void Initialize_Device_Addresses(void)
     int i = 0; /* First entry is Gateway Device */
     uint32_t virtual_mac = 0;
     BACNET_ADDRESS virtual_address = { 0 };
+    BACNET_ADDRESS device_address = { 0 };
     DEVICE_OBJECT_DATA *pDev = NULL;
     /* Setup info for the main gateway device first */
     pDev = Get_Routed_Device_Object(i);
@@ -140,26 +169,29 @@ static void Initialize_Device_Addresses(void)
     ethernet_get_my_address(&virtual_address);
 #elif defined(BACDL_BIP6)
     bip6_get_my_address(&virtual_address);
+#elif defined(BACDL_ALL)
+    datalink_get_my_address(&virtual_address);
 #else
 #error "No support for this Data Link Layer type "
 #endif
-    bacnet_address_copy(&pDev->bacDevAddr, &virtual_address);
+    Routed_Device_Address_Set(i, &virtual_address);
     /* broadcast an I-Am on startup */
     Send_I_Am(&Handler_Transmit_Buffer[0]);
 
-    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+    for (i = 1; i < GATEWAY_DEMO_DEVICES; i++) {
         pDev = Get_Routed_Device_Object(i);
         if (pDev == NULL) {
             continue;
         }
         /* start with the router address */
-        bacnet_address_copy(&pDev->bacDevAddr, &virtual_address);
+        bacnet_address_copy(&device_address, &virtual_address);
         /* add the network number to each gateway device */
-        pDev->bacDevAddr.net = VIRTUAL_DNET;
+        device_address.net = VIRTUAL_DNET;
         /* use a virtual MAC for each gateway device */
         virtual_mac = pDev->bacObj.Object_Instance_Number;
-        encode_unsigned24(&pDev->bacDevAddr.adr[0], virtual_mac);
-        pDev->bacDevAddr.len = 3;
+        encode_unsigned24(&device_address.adr[0], virtual_mac);
+        device_address.len = 3;
+        Routed_Device_Address_Set(i, &device_address);
     }
 }
 
@@ -176,9 +208,21 @@ static void Init_Service_Handlers(uint32_t first_object_instance)
      * get back through switches to different subnets.
      * Don't need the routed versions, since the npdu handler calls
      * each device in turn.
+     * With a BACNET_WHO_IS_WINDOW in milliseconds, the broadcast
+     * variety merges the Who-Is received within the window, and the
+     * I-Am are sent in batches from handler_who_is_timer().
      */
-    apdu_set_unconfirmed_handler(
-        SERVICE_UNCONFIRMED_WHO_IS, handler_who_is_unicast);
+    handler_who_is_schedule_set(
+        (uint16_t)environment_number("BACNET_WHO_IS_WINDOW", 0),
+        (uint16_t)environment_number("BACNET_WHO_IS_INTERVAL", 50),
+        (unsigned)environment_number("BACNET_WHO_IS_BATCH", 4));
+    if (environment_number("BACNET_WHO_IS_WINDOW", 0)) {
+        apdu_set_unconfirmed_handler(
+            SERVICE_UNCONFIRMED_WHO_IS, handler_who_is);
+    } else {
+        apdu_set_unconfirmed_handler(
+            SERVICE_UNCONFIRMED_WHO_IS, handler_who_is_unicast);
+    }
     apdu_set_unconfirmed_handler(SERVICE_UNCONFIRMED_WHO_HAS, handler_who_has);
     /* set the handler for all the services we don't implement */
     /* It is required to send the proper reject message... */
@@ -220,7 +264,7 @@ static void Init_Service_Handlers(uint32_t first_object_instance)
  *      datalink_receive, npdu_handler,
  *      dcc_timer_seconds, datalink_maintenance_timer,
  *      Load_Control_State_Machine_Handler, handler_cov_task,
- *      tsm_timer_milliseconds
+ *      tsm_timer_milliseconds, handler_who_is_timer
  *
  * @param argc [in] Arg count.
  * @param argv [in] Takes one argument: the Device Instance #.
@@ -236,6 +280,9 @@ int main(int argc, char *argv[])
     uint32_t elapsed_seconds = 0;
     uint32_t elapsed_milliseconds = 0;
     uint32_t first_object_instance = FIRST_DEVICE_NUMBER;
+#if defined(BACDL_ALL)
+    unsigned i;
+#endif
 #ifdef BACNET_TEST_VMAC
     /* Router data */
     BACNET_DEVICE_PROFILE *device;
@@ -258,7 +305,7 @@ int main(int argc, char *argv[])
            "BACnet Device ID: %u\n"
            "Max APDU: %d\n"
            "Max Devices: %d\n",
-        BACnet_Version, first_object_instance, MAX_APDU, MAX_NUM_DEVICES);
+        BACnet_Version, first_object_instance, MAX_APDU, GATEWAY_DEMO_DEVICES);
     Init_Service_Handlers(first_object_instance);
     dlenv_init();
     atexit(datalink_cleanup);
@@ -272,7 +319,15 @@ int main(int argc, char *argv[])
 #endif
     /* configure the timeout values */
     last_seconds = time(NULL);
+    mstimer_init();
+    mstimer_set(&Who_Is_Timer, 10);
 
+#if defined(BACDL_ALL)
+    for (i = 0; i < datalink_port_count(); i++) {
+        printf("Datalink Port %u Network Number %u\n", i,
+            (unsigned)datalink_port_network(i));
+    }
+#endif
     /* broadcast an I-am-router-to-network on startup */
     printf("Remote Network DNET Number %d \n", DNET_list[0]);
     Send_I_Am_Router_To_Network(DNET_list);
@@ -283,7 +338,9 @@ int main(int argc, char *argv[])
         current_seconds = time(NULL);
 
         /* returns 0 bytes on timeout */
-        pdu_len = datalink_receive(&src, &Rx_Buf[0], MAX_MPDU, timeout);
+        pdu_len = datalink_receive(&src, &Rx_Buf[0], MAX_MPDU,
+            handler_who_is_pending() ? mstimer_interval(&Who_Is_Timer)
+                                     : timeout);
 
         /* process */
         if (pdu_len) {
@@ -301,12 +358,24 @@ int main(int argc, char *argv[])
             tsm_timer_milliseconds(elapsed_milliseconds);
         }
         handler_cov_task();
+        if (!handler_who_is_pending()) {
+            /* the window starts with the first Who-Is */
+            mstimer_restart(&Who_Is_Timer);
+        } else if (mstimer_expired(&Who_Is_Timer)) {
+            elapsed_milliseconds = mstimer_elapsed(&Who_Is_Timer);
+            mstimer_restart(&Who_Is_Timer);
+            if (elapsed_milliseconds > UINT16_MAX) {
+                elapsed_milliseconds = UINT16_MAX;
+            }
+            handler_who_is_timer((uint16_t)elapsed_milliseconds);
+        }
         /* output */
-        if (Routed_Device_Index < MAX_NUM_DEVICES) {
+        if (Routed_Device_Index < GATEWAY_DEMO_DEVICES) {
             Routed_Device_Index++;
-            Get_Routed_Device_Object(Routed_Device_Index);
-            /* broadcast an I-Am for each routed Device now */
-            Send_I_Am(&Handler_Transmit_Buffer[0]);
+            if (Get_Routed_Device_Object(Routed_Device_Index)) {
+                /* broadcast an I-Am for each routed Device now */
+                Send_I_Am(&Handler_Transmit_Buffer[0]);
+            }
         }
     }
     /* Dummy return */
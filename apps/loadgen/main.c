@@ -0,0 +1,708 @@
+/**
+ * @file
+ * @brief Load generator for a BACnet server over the loopback datalink
+ *
+ * Runs the server - the Device object with thousands of Analog Output
+ * objects and the usual service handlers - and a client in the same
+ * process, connected by the in-process loopback datalink.  The client
+ * keeps a window of requests outstanding, drawn from a configurable mix
+ * of ReadProperty, ReadPropertyMultiple, WriteProperty, SubscribeCOV and
+ * Who-Is, and reports requests per second and p50/p99 latency for each
+ * service.  Latency is from request encoding to the reply being taken
+ * from the loopback, so it covers the complete server path without
+ * any network or operating system in the way.
+ *
+ * @date October 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#include "bacnet/bacdef.h"
+#include "bacnet/bacdcode.h"
+#include "bacnet/apdu.h"
+#include "bacnet/npdu.h"
+#include "bacnet/cov.h"
+#include "bacnet/rp.h"
+#include "bacnet/rpm.h"
+#include "bacnet/wp.h"
+#include "bacnet/whois.h"
+#include "bacnet/version.h"
+#include "bacnet/basic/services.h"
+#include "bacnet/basic/object/device.h"
+#include "bacnet/basic/object/ao.h"
+#include "bacnet/basic/object/av.h"
+#include "bacnet/basic/sys/filename.h"
+#include "bacnet/datalink/datalink.h"
+
+#if !defined(BACDL_LOOPBACK)
+#error "loadgen requires the loopback datalink: define BACDL_LOOPBACK"
+#endif
+
+/* services in the request mix */
+enum loadgen_service {
+    LOADGEN_RP,
+    LOADGEN_RPM,
+    LOADGEN_WP,
+    LOADGEN_COV,
+    LOADGEN_WHOIS,
+    LOADGEN_SERVICE_MAX
+};
+
+struct loadgen_stats {
+    const char *name;
+    /* share of the request mix */
+    unsigned weight;
+    unsigned long requests;
+    unsigned long errors;
+    unsigned long count;
+    /* latency of each completed request, nanoseconds */
+    uint32_t *latency;
+};
+
+/* a request waiting for its reply */
+struct loadgen_request {
+    bool active;
+    enum loadgen_service service;
+    uint64_t start;
+};
+
+static struct loadgen_stats Stats[LOADGEN_SERVICE_MAX] = {
+    { "rp", 40, 0, 0, 0, NULL },
+    { "rpm", 20, 0, 0, 0, NULL },
+    { "wp", 20, 0, 0, 0, NULL },
+    { "subscribe-cov", 10, 0, 0, 0, NULL },
+    { "who-is", 10, 0, 0, 0, NULL },
+};
+
+/* confirmed requests by invoke ID */
+static struct loadgen_request Requests[256];
+/* Who-Is requests, answered in order by I-Am */
+static uint64_t Who_Is_Start[LOOPBACK_QUEUE_SIZE];
+static unsigned Who_Is_Head;
+static unsigned Who_Is_Tail;
+static unsigned Outstanding;
+static uint8_t Next_Invoke_ID;
+/* settings */
+static unsigned long Object_Count = 1000;
+static unsigned long Request_Count = 100000;
+static unsigned Window = 1;
+static unsigned RPM_Objects = 5;
+static unsigned long Seed = 1;
+/* results that are not per service */
+static unsigned long COV_Notifications;
+static unsigned long Replies_Unexpected;
+static unsigned long Requests_Lost;
+/* the address of the client on the loopback */
+static BACNET_ADDRESS Client_Address;
+/* buffers */
+static uint8_t Server_Rx_Buf[MAX_MPDU];
+static uint8_t Client_Tx_Buf[MAX_MPDU];
+static uint8_t Client_Rx_Buf[MAX_MPDU];
+
+/**
+ * @brief Read a monotonic clock
+ * @return nanoseconds since an arbitrary epoch
+ */
+static uint64_t clock_nanoseconds(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER count;
+
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&count);
+    return (uint64_t)((double)count.QuadPart * 1.0e9 /
+        (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void Init_Service_Handlers(void)
+{
+    Device_Init(NULL);
+    apdu_set_unconfirmed_handler(SERVICE_UNCONFIRMED_WHO_IS, handler_who_is);
+    apdu_set_unrecognized_service_handler_handler(handler_unrecognized_service);
+    apdu_set_confirmed_handler(
+        SERVICE_CONFIRMED_READ_PROPERTY, handler_read_property);
+    apdu_set_confirmed_handler(
+        SERVICE_CONFIRMED_READ_PROP_MULTIPLE, handler_read_property_multiple);
+    apdu_set_confirmed_handler(
+        SERVICE_CONFIRMED_WRITE_PROPERTY, handler_write_property);
+    apdu_set_confirmed_handler(
+        SERVICE_CONFIRMED_SUBSCRIBE_COV, handler_cov_subscribe);
+}
+
+/**
+ * @brief Pick the next service from the weighted mix
+ * @return service to send
+ */
+static enum loadgen_service loadgen_service_next(void)
+{
+    unsigned total = 0;
+    unsigned pick;
+    unsigned i;
+
+    for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+        total += Stats[i].weight;
+    }
+    pick = (unsigned)rand() % total;
+    for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+        if (pick < Stats[i].weight) {
+            break;
+        }
+        pick -= Stats[i].weight;
+    }
+
+    return (enum loadgen_service)i;
+}
+
+/**
+ * @brief Random Analog Output in the server
+ * @return object instance
+ */
+static uint32_t loadgen_object_instance(void)
+{
+    return 1 + (uint32_t)((unsigned long)rand() % Object_Count);
+}
+
+/**
+ * @brief Encode a request APDU for one of the services
+ * @param apdu - buffer for the APDU
+ * @param service - service to encode
+ * @param invoke_id - invoke ID for confirmed services
+ * @return number of bytes encoded
+ */
+static int loadgen_apdu_encode(
+    uint8_t *apdu, enum loadgen_service service, uint8_t invoke_id)
+{
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    BACNET_WRITE_PROPERTY_DATA wpdata = { 0 };
+    BACNET_SUBSCRIBE_COV_DATA covdata = { 0 };
+    BACNET_READ_ACCESS_DATA rpm_object[16];
+    BACNET_PROPERTY_REFERENCE rpm_property[16][4];
+    BACNET_PROPERTY_ID rpm_property_id[4] = { PROP_PRESENT_VALUE,
+        PROP_STATUS_FLAGS, PROP_OBJECT_NAME, PROP_UNITS };
+    unsigned i, p;
+    int len = 0;
+
+    switch (service) {
+        case LOADGEN_RP:
+            rpdata.object_type = OBJECT_ANALOG_OUTPUT;
+            rpdata.object_instance = loadgen_object_instance();
+            rpdata.object_property = PROP_PRESENT_VALUE;
+            rpdata.array_index = BACNET_ARRAY_ALL;
+            len = rp_encode_apdu(apdu, invoke_id, &rpdata);
+            break;
+        case LOADGEN_RPM:
+            memset(rpm_object, 0, sizeof(rpm_object));
+            memset(rpm_property, 0, sizeof(rpm_property));
+            for (i = 0; i < RPM_Objects; i++) {
+                rpm_object[i].object_type = OBJECT_ANALOG_OUTPUT;
+                rpm_object[i].object_instance = loadgen_object_instance();
+                rpm_object[i].listOfProperties = &rpm_property[i][0];
+                for (p = 0; p < 4; p++) {
+                    rpm_property[i][p].propertyIdentifier = rpm_property_id[p];
+                    rpm_property[i][p].propertyArrayIndex = BACNET_ARRAY_ALL;
+                    if (p < 3) {
+                        rpm_property[i][p].next = &rpm_property[i][p + 1];
+                    }
+                }
+                if ((i + 1) < RPM_Objects) {
+                    rpm_object[i].next = &rpm_object[i + 1];
+                }
+            }
+            len = rpm_encode_apdu(apdu, MAX_APDU, invoke_id, &rpm_object[0]);
+            break;
+        case LOADGEN_WP:
+            wpdata.object_type = OBJECT_ANALOG_OUTPUT;
+            wpdata.object_instance = loadgen_object_instance();
+            wpdata.object_property = PROP_PRESENT_VALUE;
+            wpdata.array_index = BACNET_ARRAY_ALL;
+            wpdata.priority = 8;
+            wpdata.application_data_len = encode_application_real(
+                wpdata.application_data, (float)(rand() % 1000) / 10.0f);
+            len = wp_encode_apdu(apdu, invoke_id, &wpdata);
+            break;
+        case LOADGEN_COV:
+            covdata.monitoredObjectIdentifier.type = OBJECT_ANALOG_VALUE;
+            covdata.monitoredObjectIdentifier.instance =
+                (uint32_t)((unsigned)rand() % Analog_Value_Count());
+            /* one subscription per object, renewed by each request */
+            covdata.subscriberProcessIdentifier =
+                1 + covdata.monitoredObjectIdentifier.instance;
+            covdata.issueConfirmedNotifications = false;
+            covdata.lifetime = 300;
+            len = cov_subscribe_encode_apdu(apdu, MAX_APDU, invoke_id, &covdata);
+            break;
+        case LOADGEN_WHOIS:
+        default:
+            len = whois_encode_apdu(apdu, -1, -1);
+            break;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Send one request from the client to the server
+ * @param service - service to send
+ * @return true if the request was sent
+ */
+static bool loadgen_request_send(enum loadgen_service service)
+{
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    uint8_t invoke_id = 0;
+    uint64_t start;
+    int len = 0;
+    int apdu_len = 0;
+
+    if (service == LOADGEN_WHOIS) {
+        datalink_get_broadcast_address(&dest);
+        npdu_encode_npdu_data(&npdu_data, false, MESSAGE_PRIORITY_NORMAL);
+    } else {
+        /* next free invoke ID */
+        while (Requests[Next_Invoke_ID].active) {
+            Next_Invoke_ID++;
+        }
+        invoke_id = Next_Invoke_ID;
+        Next_Invoke_ID++;
+        datalink_get_my_address(&dest);
+        npdu_encode_npdu_data(&npdu_data, true, MESSAGE_PRIORITY_NORMAL);
+    }
+    len = npdu_encode_pdu(Client_Tx_Buf, &dest, &Client_Address, &npdu_data);
+    apdu_len = loadgen_apdu_encode(&Client_Tx_Buf[len], service, invoke_id);
+    if (apdu_len <= 0) {
+        return false;
+    }
+    len += apdu_len;
+    start = clock_nanoseconds();
+    if (!loopback_peer_send(&Client_Address, Client_Tx_Buf, (uint16_t)len)) {
+        return false;
+    }
+    if (service == LOADGEN_WHOIS) {
+        Who_Is_Start[Who_Is_Head % LOOPBACK_QUEUE_SIZE] = start;
+        Who_Is_Head++;
+    } else {
+        Requests[invoke_id].active = true;
+        Requests[invoke_id].service = service;
+        Requests[invoke_id].start = start;
+    }
+    Stats[service].requests++;
+    Outstanding++;
+
+    return true;
+}
+
+/**
+ * @brief Record the completion of a request
+ * @param service - service of the request
+ * @param start - time the request was sent
+ * @param error - true if the reply was an Error, Reject or Abort
+ */
+static void loadgen_request_complete(
+    enum loadgen_service service, uint64_t start, bool error)
+{
+    uint64_t latency = clock_nanoseconds() - start;
+
+    if (latency > UINT32_MAX) {
+        latency = UINT32_MAX;
+    }
+    if (Stats[service].count < Request_Count) {
+        Stats[service].latency[Stats[service].count] = (uint32_t)latency;
+        Stats[service].count++;
+    }
+    if (error) {
+        Stats[service].errors++;
+    }
+    if (Outstanding) {
+        Outstanding--;
+    }
+}
+
+/**
+ * @brief Handle one packet sent by the server to the client
+ * @param pdu - NPDU and APDU from the server
+ * @param pdu_len - number of bytes in the packet
+ */
+static void loadgen_reply_handler(uint8_t *pdu, uint16_t pdu_len)
+{
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_ADDRESS src = { 0 };
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    struct loadgen_request *request;
+    uint8_t *apdu;
+    uint8_t pdu_type;
+    int len;
+
+    len = bacnet_npdu_decode(pdu, pdu_len, &dest, &src, &npdu_data);
+    if ((len <= 0) || (len >= pdu_len) || npdu_data.network_layer_message) {
+        Replies_Unexpected++;
+        return;
+    }
+    apdu = &pdu[len];
+    pdu_type = apdu[0] & 0xF0;
+    if (pdu_type == PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST) {
+        if ((pdu_len - len) < 2) {
+            Replies_Unexpected++;
+        } else if (apdu[1] == SERVICE_UNCONFIRMED_I_AM) {
+            if (Who_Is_Tail != Who_Is_Head) {
+                loadgen_request_complete(LOADGEN_WHOIS,
+                    Who_Is_Start[Who_Is_Tail % LOOPBACK_QUEUE_SIZE], false);
+                Who_Is_Tail++;
+            } else {
+                Replies_Unexpected++;
+            }
+        } else if (apdu[1] == SERVICE_UNCONFIRMED_COV_NOTIFICATION) {
+            COV_Notifications++;
+        } else {
+            Replies_Unexpected++;
+        }
+        return;
+    }
+    if ((pdu_len - len) < 2) {
+        Replies_Unexpected++;
+        return;
+    }
+    request = &Requests[apdu[1]];
+    if (!request->active) {
+        Replies_Unexpected++;
+        return;
+    }
+    request->active = false;
+    switch (pdu_type) {
+        case PDU_TYPE_SIMPLE_ACK:
+        case PDU_TYPE_COMPLEX_ACK:
+            loadgen_request_complete(request->service, request->start, false);
+            break;
+        default:
+            loadgen_request_complete(request->service, request->start, true);
+            break;
+    }
+}
+
+/**
+ * @brief Give up on the requests that the server did not answer
+ */
+static void loadgen_requests_lost(void)
+{
+    unsigned i;
+
+    for (i = 0; i < 256; i++) {
+        if (Requests[i].active) {
+            Requests[i].active = false;
+            Requests_Lost++;
+        }
+    }
+    while (Who_Is_Tail != Who_Is_Head) {
+        Who_Is_Tail++;
+        Requests_Lost++;
+    }
+    Outstanding = 0;
+}
+
+static int latency_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Latency percentile of a sorted list
+ * @param latency - sorted latencies, nanoseconds
+ * @param count - number of latencies
+ * @param percent - percentile, 0..100
+ * @return latency in microseconds
+ */
+static double latency_percentile(
+    const uint32_t *latency, unsigned long count, unsigned percent)
+{
+    unsigned long index;
+
+    if (count == 0) {
+        return 0.0;
+    }
+    index = (count * percent) / 100;
+    if (index >= count) {
+        index = count - 1;
+    }
+
+    return (double)latency[index] / 1000.0;
+}
+
+static void loadgen_report(uint64_t elapsed)
+{
+    double seconds = (double)elapsed / 1.0e9;
+    unsigned long total_requests = 0;
+    unsigned long total_errors = 0;
+    unsigned long total_count = 0;
+    uint32_t *all;
+    unsigned i;
+
+    printf("%-14s %10s %8s %12s %10s %10s\n", "service", "requests",
+        "errors", "req/s", "p50 us", "p99 us");
+    all = calloc(Request_Count, sizeof(uint32_t));
+    for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+        if (Stats[i].requests == 0) {
+            continue;
+        }
+        if (all) {
+            memcpy(&all[total_count], Stats[i].latency,
+                Stats[i].count * sizeof(uint32_t));
+        }
+        total_requests += Stats[i].requests;
+        total_errors += Stats[i].errors;
+        total_count += Stats[i].count;
+        qsort(Stats[i].latency, Stats[i].count, sizeof(uint32_t),
+            latency_compare);
+        printf("%-14s %10lu %8lu %12.0f %10.2f %10.2f\n", Stats[i].name,
+            Stats[i].requests, Stats[i].errors,
+            (double)Stats[i].count / seconds,
+            latency_percentile(Stats[i].latency, Stats[i].count, 50),
+            latency_percentile(Stats[i].latency, Stats[i].count, 99));
+    }
+    if (all) {
+        qsort(all, total_count, sizeof(uint32_t), latency_compare);
+        printf("%-14s %10lu %8lu %12.0f %10.2f %10.2f\n", "total",
+            total_requests, total_errors, (double)total_count / seconds,
+            latency_percentile(all, total_count, 50),
+            latency_percentile(all, total_count, 99));
+        free(all);
+    }
+    printf("cov-notifications=%lu unexpected=%lu lost=%lu dropped=%lu\n",
+        COV_Notifications, Replies_Unexpected, Requests_Lost,
+        loopback_dropped());
+}
+
+/**
+ * @brief Parse the request mix, such as rp:40,rpm:20,wp:20,cov:10,whois:10
+ * @param text - request mix
+ * @return true if the mix is valid
+ */
+static bool loadgen_mix_parse(char *text)
+{
+    static const char *keyword[LOADGEN_SERVICE_MAX] = { "rp", "rpm", "wp",
+        "cov", "whois" };
+    unsigned weight[LOADGEN_SERVICE_MAX] = { 0 };
+    unsigned total = 0;
+    char *token;
+    char *value;
+    unsigned i;
+
+    for (token = strtok(text, ","); token; token = strtok(NULL, ",")) {
+        value = strchr(token, ':');
+        if (!value) {
+            return false;
+        }
+        *value = 0;
+        value++;
+        for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+            if (strcmp(token, keyword[i]) == 0) {
+                weight[i] = (unsigned)strtoul(value, NULL, 0);
+                break;
+            }
+        }
+        if (i == LOADGEN_SERVICE_MAX) {
+            return false;
+        }
+    }
+    for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+        total += weight[i];
+    }
+    if (total == 0) {
+        return false;
+    }
+    for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+        Stats[i].weight = weight[i];
+    }
+
+    return true;
+}
+
+static void print_usage(const char *filename)
+{
+    printf("Usage: %s [--objects N][--requests N][--window N]\n", filename);
+    printf("       [--mix rp:N,rpm:N,wp:N,cov:N,whois:N][--rpm-objects N]\n");
+    printf("       [--seed N][--version][--help]\n");
+}
+
+static void print_help(const char *filename)
+{
+    printf("Run a BACnet server and a client in one process, connected\n"
+           "by the loopback datalink, and measure the requests per second\n"
+           "and latency of the server.  The service handlers may print\n"
+           "debug messages to stderr; redirect stderr to measure only\n"
+           "the stack.\n");
+    printf("\n");
+    printf("--objects N:\n"
+           "Number of Analog Output objects in the server. Default 1000.\n");
+    printf("--requests N:\n"
+           "Number of requests to send. Default 100000.\n");
+    printf("--window N:\n"
+           "Number of requests outstanding at once, 1..%u. Default 1.\n",
+        LOOPBACK_QUEUE_SIZE);
+    printf("--mix rp:N,rpm:N,wp:N,cov:N,whois:N:\n"
+           "Relative weight of ReadProperty, ReadPropertyMultiple,\n"
+           "WriteProperty, SubscribeCOV and Who-Is in the requests.\n"
+           "Default rp:40,rpm:20,wp:20,cov:10,whois:10.\n");
+    printf("--rpm-objects N:\n"
+           "Objects in each ReadPropertyMultiple request, with four\n"
+           "properties each, 1..16. Default 5.\n");
+    printf("--seed N:\n"
+           "Seed of the random choice of services and objects.\n");
+    printf("\n");
+    printf("Example:\n"
+           "%s --objects 5000 --window 8 --mix rp:1,rpm:1 2>/dev/null\n",
+        filename);
+}
+
+int main(int argc, char *argv[])
+{
+    BACNET_ADDRESS src = { 0 };
+    uint16_t pdu_len = 0;
+    uint16_t reply_len = 0;
+    unsigned long sent = 0;
+    unsigned long completed = 0;
+    unsigned long i;
+    uint64_t start, elapsed;
+    uint64_t timer_start;
+    bool replied = false;
+    int argi = 0;
+    const char *filename = NULL;
+
+    filename = filename_remove_path(argv[0]);
+    for (argi = 1; argi < argc; argi++) {
+        if (strcmp(argv[argi], "--help") == 0) {
+            print_usage(filename);
+            print_help(filename);
+            return 0;
+        }
+        if (strcmp(argv[argi], "--version") == 0) {
+            printf("%s %s\n", filename, BACNET_VERSION_TEXT);
+            printf("Copyright (C) 2026 by the BACnet Stack contributors.\n"
+                   "This is free software; see the source for copying "
+                   "conditions.\n"
+                   "There is NO warranty; not even for MERCHANTABILITY or\n"
+                   "FITNESS FOR A PARTICULAR PURPOSE.\n");
+            return 0;
+        }
+        if ((argi + 1) >= argc) {
+            print_usage(filename);
+            return 1;
+        }
+        if (strcmp(argv[argi], "--objects") == 0) {
+            Object_Count = strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--requests") == 0) {
+            Request_Count = strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--window") == 0) {
+            Window = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--rpm-objects") == 0) {
+            RPM_Objects = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--seed") == 0) {
+            Seed = strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--mix") == 0) {
+            if (!loadgen_mix_parse(argv[++argi])) {
+                fprintf(stderr, "invalid request mix\n");
+                return 1;
+            }
+        } else {
+            print_usage(filename);
+            return 1;
+        }
+    }
+    if ((Object_Count == 0) || (Object_Count > BACNET_MAX_INSTANCE) ||
+        (Request_Count == 0) || (Window == 0) ||
+        (Window > LOOPBACK_QUEUE_SIZE) || (RPM_Objects == 0) ||
+        (RPM_Objects > 16)) {
+        print_usage(filename);
+        return 1;
+    }
+    for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+        Stats[i].latency = calloc(Request_Count, sizeof(uint32_t));
+        if (!Stats[i].latency) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+    srand((unsigned)Seed);
+    /* the server */
+    Device_Set_Object_Instance_Number(260001);
+    Init_Service_Handlers();
+    for (i = 1; i <= Object_Count; i++) {
+        if (Analog_Output_Create((uint32_t)i) != (uint32_t)i) {
+            fprintf(stderr, "unable to create Analog Output %lu\n", i);
+            return 1;
+        }
+    }
+    if (!datalink_init(NULL)) {
+        return 1;
+    }
+    /* the client is the other end of the loopback */
+    Client_Address.mac_len = 1;
+    Client_Address.mac[0] = LOOPBACK_MAC_DEFAULT + 1;
+    printf("loadgen: %lu objects, %lu requests, window %u\n", Object_Count,
+        Request_Count, Window);
+    start = clock_nanoseconds();
+    timer_start = start;
+    while (completed < Request_Count) {
+        /* client: keep the window full */
+        while ((Outstanding < Window) && (sent < Request_Count)) {
+            if (!loadgen_request_send(loadgen_service_next())) {
+                break;
+            }
+            sent++;
+        }
+        /* server: one pass of the server task loop */
+        pdu_len = datalink_receive(&src, Server_Rx_Buf, MAX_MPDU, 0);
+        if (pdu_len) {
+            npdu_handler(&src, Server_Rx_Buf, pdu_len);
+        }
+        handler_cov_task();
+        if ((clock_nanoseconds() - timer_start) >= 1000000000ULL) {
+            timer_start += 1000000000ULL;
+            handler_cov_timer_seconds(1);
+        }
+        /* client: take the replies */
+        replied = false;
+        for (;;) {
+            reply_len = loopback_peer_receive(
+                NULL, Client_Rx_Buf, sizeof(Client_Rx_Buf));
+            if (reply_len == 0) {
+                break;
+            }
+            loadgen_reply_handler(Client_Rx_Buf, reply_len);
+            replied = true;
+        }
+        if (!pdu_len && !replied && Outstanding &&
+            (loopback_receive_pending() == 0)) {
+            /* the server is idle, so nothing more will be answered */
+            loadgen_requests_lost();
+        }
+        completed = sent - Outstanding;
+    }
+    elapsed = clock_nanoseconds() - start;
+    loadgen_report(elapsed);
+    for (i = 0; i < LOADGEN_SERVICE_MAX; i++) {
+        free(Stats[i].latency);
+    }
+
+    return 0;
+}
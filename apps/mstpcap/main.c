@@ -52,11 +52,37 @@
 /* OS specific includes */
 #include "bacport.h"
 #include "rs485.h"
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
 
 #ifdef _WIN32
 #define strncasecmp(x, y, z) _strnicmp(x, y, z)
 #endif
 
+/* memory-mapped capture file ring, and more than one port per process,
+   where the OS supports them */
+#if !defined(_WIN32)
+#define MSTPCAP_RING 1
+#endif
+#if defined(__linux__)
+#ifndef MSTPCAP_PORTS_MAX
+#define MSTPCAP_PORTS_MAX 8
+#endif
+#endif
+#ifndef MSTPCAP_PORTS_MAX
+#define MSTPCAP_PORTS_MAX 1
+#endif
+/* at or above this baud rate, the octets of each read of the serial port
+   go through the receive state machine as a block; below it, each octet
+   is captured as it arrives, so that noise between frames is recorded
+   octet by octet */
+#if defined(__linux__)
+#ifndef MSTPCAP_BLOCK_BAUD
+#define MSTPCAP_BLOCK_BAUD 76800
+#endif
+#endif
+
 /* define our Data Link Type for libPCAP */
 #define DLT_BACNET_MS_TP 165
 /* local min/max macros */
@@ -67,19 +93,16 @@
 
 #define MSTP_HEADER_MAX (2 + 1 + 1 + 1 + 2 + 1)
 
-/* local port data - shared with RS-485 */
-static volatile struct mstp_port_struct_t MSTP_Port;
-/* track the receive state to know when there is a broken packet */
-static MSTP_RECEIVE_STATE MSTP_Receive_State = MSTP_RECEIVE_STATE_IDLE;
-/* buffers needed by mstp port struct */
-static uint8_t RxBuffer[DLMSTP_MPDU_MAX];
-static uint8_t TxBuffer[DLMSTP_MPDU_MAX];
 /* method to tell main loop to exit from CTRL-C or other signals */
 static volatile bool Exit_Requested;
 /* flag to indicate Wireshark is running the show - no stdout or stderr */
 static bool Wireshark_Capture;
-/* placed to track silence on the wire */
-static struct mstimer Silence_Timer;
+
+/* latency histogram bins, in milliseconds: the last bin counts the
+   latencies of the last limit and more */
+#define MSTPCAP_HISTOGRAM_BINS 10
+static const uint32_t Histogram_Limit[MSTPCAP_HISTOGRAM_BINS - 1] = { 1, 2,
+    5, 10, 20, 50, 100, 200, 500 };
 
 /* statistics derived from monitoring the network for each node */
 struct mstp_statistics {
@@ -129,11 +152,56 @@ struct mstp_statistics {
     uint32_t ooo_token_count;
     /* if we see an I-Am message from this node, store the Device ID */
     uint32_t device_id;
+    /* how long the node takes to use a token passed to it */
+    uint32_t token_usage_histogram[MSTPCAP_HISTOGRAM_BINS];
+    /* how long the node takes to reply to Poll For Master */
+    uint32_t pfm_reply_histogram[MSTPCAP_HISTOGRAM_BINS];
 };
 
 #define MAX_MSTP_DEVICES 256
-static struct mstp_statistics MSTP_Statistics[MAX_MSTP_DEVICES];
-static uint32_t Invalid_Frame_Count;
+
+/* a serial port being captured */
+struct mstpcap_port {
+    /* local port data - shared with RS-485 */
+    volatile struct mstp_port_struct_t mstp_port;
+    /* track the receive state to know when there is a broken packet */
+    MSTP_RECEIVE_STATE receive_state;
+    /* buffers needed by mstp port struct */
+    uint8_t rx_buffer[DLMSTP_MPDU_MAX];
+    uint8_t tx_buffer[DLMSTP_MPDU_MAX];
+    /* placed to track silence on the wire */
+    struct mstimer silence_timer;
+    /* serial port name */
+    char *name;
+    uint32_t packet_count;
+    uint32_t invalid_frame_count;
+    /* statistics derived from monitoring the network for each node */
+    struct mstp_statistics statistics[MAX_MSTP_DEVICES];
+    /* the previous frame, for the inferred statistics */
+    struct timeval old_tv;
+    uint8_t old_frame;
+    uint8_t old_src;
+    uint8_t old_dst;
+    uint8_t old_token_dst;
+#if MSTPCAP_PORTS_MAX > 1
+    pthread_t thread;
+#endif
+};
+/* the first port uses the RS-485 module settings, the others have
+   their own port data from RS485_Port_Initialize() */
+static struct mstpcap_port MSTPCAP_Ports[MSTPCAP_PORTS_MAX];
+static unsigned MSTPCAP_Port_Count = 1;
+static uint32_t MSTPCAP_Baud = 38400;
+#if MSTPCAP_PORTS_MAX > 1
+/* ports write the capture and statistics one at a time */
+static pthread_mutex_t Capture_Mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+/* write pcapng rather than libpcap: for more than one port, or a ring */
+static bool Capture_Pcapng;
+/* live statistics export */
+static char *Statistics_Filename;
+static unsigned long Statistics_Interval = 10;
+static struct mstimer Statistics_Timer;
 
 static uint32_t timeval_diff_ms(struct timeval *old, struct timeval *now)
 {
@@ -146,7 +214,36 @@ static uint32_t timeval_diff_ms(struct timeval *old, struct timeval *now)
     return ms;
 }
 
-static void mstp_monitor_i_am(uint8_t mac, uint8_t *pdu, uint16_t pdu_len)
+static void capture_lock(void)
+{
+#if MSTPCAP_PORTS_MAX > 1
+    pthread_mutex_lock(&Capture_Mutex);
+#endif
+}
+
+static void capture_unlock(void)
+{
+#if MSTPCAP_PORTS_MAX > 1
+    pthread_mutex_unlock(&Capture_Mutex);
+#endif
+}
+
+static void histogram_add(uint32_t *histogram, uint32_t ms)
+{
+    unsigned i;
+
+    for (i = 0; i < (MSTPCAP_HISTOGRAM_BINS - 1); i++) {
+        if (ms < Histogram_Limit[i]) {
+            break;
+        }
+    }
+    histogram[i]++;
+}
+
+static void mstp_monitor_i_am(struct mstp_statistics *statistics,
+    uint8_t mac,
+    uint8_t *pdu,
+    uint16_t pdu_len)
 {
     BACNET_ADDRESS src = { 0 };
     BACNET_ADDRESS dest = { 0 };
@@ -176,7 +273,7 @@ static void mstp_monitor_i_am(uint8_t mac, uint8_t *pdu, uint16_t pdu_len)
                     len = iam_decode_service_request(
                         service_request, &device_id, NULL, NULL, NULL);
                     if (len != -1) {
-                        MSTP_Statistics[mac].device_id = device_id;
+                        statistics[mac].device_id = device_id;
                     }
                 }
             }
@@ -184,14 +281,13 @@ static void mstp_monitor_i_am(uint8_t mac, uint8_t *pdu, uint16_t pdu_len)
     }
 }
 
-static void packet_statistics(
-    struct timeval *tv, volatile struct mstp_port_struct_t *mstp_port)
+static void packet_statistics(struct timeval *tv, struct mstpcap_port *port)
 {
-    static struct timeval old_tv = { 0 };
-    static uint8_t old_frame = 255;
-    static uint8_t old_src = 255;
-    static uint8_t old_dst = 255;
-    static uint8_t old_token_dst = 255;
+    volatile struct mstp_port_struct_t *mstp_port = &port->mstp_port;
+    struct mstp_statistics *MSTP_Statistics = port->statistics;
+    uint8_t old_frame = port->old_frame;
+    uint8_t old_src = port->old_src;
+    uint8_t old_dst = port->old_dst;
     uint8_t frame, src, dst;
     uint32_t delta;
     uint32_t npoll;
@@ -199,6 +295,12 @@ static void packet_statistics(
     dst = mstp_port->DestinationAddress;
     src = mstp_port->SourceAddress;
     frame = mstp_port->FrameType;
+    if ((old_frame == FRAME_TYPE_TOKEN) && (old_dst == src) &&
+        (old_src != src)) {
+        /* token usage time */
+        histogram_add(MSTP_Statistics[src].token_usage_histogram,
+            timeval_diff_ms(&port->old_tv, tv));
+    }
     switch (frame) {
         case FRAME_TYPE_TOKEN:
             MSTP_Statistics[src].token_count++;
@@ -211,13 +313,13 @@ static void packet_statistics(
                     /* repeated token */
                     MSTP_Statistics[dst].token_retries++;
                     /* Tusage_timeout */
-                    delta = timeval_diff_ms(&old_tv, tv);
+                    delta = timeval_diff_ms(&port->old_tv, tv);
                     if (delta > MSTP_Statistics[src].tusage_timeout) {
                         MSTP_Statistics[src].tusage_timeout = delta;
                     }
                 } else if (old_dst == src) {
                     /* token to token response time */
-                    delta = timeval_diff_ms(&old_tv, tv);
+                    delta = timeval_diff_ms(&port->old_tv, tv);
                     if (delta > MSTP_Statistics[src].token_reply) {
                         MSTP_Statistics[src].token_reply = delta;
                     }
@@ -225,16 +327,16 @@ static void packet_statistics(
             } else if ((old_frame == FRAME_TYPE_POLL_FOR_MASTER) &&
                 (old_src == src)) {
                 /* Tusage_timeout */
-                delta = timeval_diff_ms(&old_tv, tv);
+                delta = timeval_diff_ms(&port->old_tv, tv);
                 if (delta > MSTP_Statistics[src].tusage_timeout) {
                     MSTP_Statistics[src].tusage_timeout = delta;
                 }
             }
-            if (old_token_dst != src) {
+            if (port->old_token_dst != src) {
                 /* out-of-order Token sender */
                 MSTP_Statistics[src].ooo_token_count++;
             }
-            old_token_dst = dst;
+            port->old_token_dst = dst;
             break;
         case FRAME_TYPE_POLL_FOR_MASTER:
             if (MSTP_Statistics[src].last_pfm_tokens) {
@@ -252,7 +354,7 @@ static void packet_statistics(
             }
             if ((old_frame == FRAME_TYPE_POLL_FOR_MASTER) && (old_src == src)) {
                 /* Tusage_timeout - sole master */
-                delta = timeval_diff_ms(&old_tv, tv);
+                delta = timeval_diff_ms(&port->old_tv, tv);
                 if (delta > MSTP_Statistics[src].tusage_timeout) {
                     MSTP_Statistics[src].tusage_timeout = delta;
                 }
@@ -261,10 +363,11 @@ static void packet_statistics(
         case FRAME_TYPE_REPLY_TO_POLL_FOR_MASTER:
             MSTP_Statistics[src].rpfm_count++;
             if (old_frame == FRAME_TYPE_POLL_FOR_MASTER) {
-                delta = timeval_diff_ms(&old_tv, tv);
+                delta = timeval_diff_ms(&port->old_tv, tv);
                 if (delta > MSTP_Statistics[src].pfm_reply) {
                     MSTP_Statistics[src].pfm_reply = delta;
                 }
+                histogram_add(MSTP_Statistics[src].pfm_reply_histogram, delta);
             }
             break;
         case FRAME_TYPE_TEST_REQUEST:
@@ -281,7 +384,7 @@ static void packet_statistics(
             if ((old_frame == FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY) &&
                 (old_dst == src)) {
                 /* DER response time */
-                delta = timeval_diff_ms(&old_tv, tv);
+                delta = timeval_diff_ms(&port->old_tv, tv);
                 if (delta > MSTP_Statistics[src].der_reply) {
                     MSTP_Statistics[src].der_reply = delta;
                 }
@@ -290,8 +393,8 @@ static void packet_statistics(
                 (mstp_port->ReceivedValidFrameNotForUs)) {
                 if ((mstp_port->DataLength <= mstp_port->InputBufferSize) &&
                     (mstp_port->DataLength > 0)) {
-                    mstp_monitor_i_am(
-                        src, &mstp_port->InputBuffer[0], mstp_port->DataLength);
+                    mstp_monitor_i_am(MSTP_Statistics, src,
+                        &mstp_port->InputBuffer[0], mstp_port->DataLength);
                 }
             }
             break;
@@ -300,7 +403,7 @@ static void packet_statistics(
             if ((old_frame == FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY) &&
                 (old_dst == src)) {
                 /* Postponed response time */
-                delta = timeval_diff_ms(&old_tv, tv);
+                delta = timeval_diff_ms(&port->old_tv, tv);
                 if (delta > MSTP_Statistics[src].reply_postponed) {
                     MSTP_Statistics[src].reply_postponed = delta;
                 }
@@ -311,20 +414,24 @@ static void packet_statistics(
     }
 
     /* update the old variables */
-    old_dst = dst;
-    old_src = src;
-    old_frame = frame;
-    old_tv.tv_sec = tv->tv_sec;
-    old_tv.tv_usec = tv->tv_usec;
+    port->old_dst = dst;
+    port->old_src = src;
+    port->old_frame = frame;
+    port->old_tv.tv_sec = tv->tv_sec;
+    port->old_tv.tv_usec = tv->tv_usec;
 }
 
-static void packet_statistics_print(void)
+static void packet_statistics_print(struct mstpcap_port *port)
 {
+    struct mstp_statistics *MSTP_Statistics = port->statistics;
     unsigned i; /* loop counter */
     unsigned node_count = 0;
     long unsigned int self_or_ooo_count;
 
     fprintf(stdout, "\n");
+    if (MSTPCAP_Port_Count > 1) {
+        fprintf(stdout, "==== %s ====\n", port->name);
+    }
     fprintf(stdout, "==== MS/TP Frame Counts ====\n");
     fprintf(stdout, "%-8s%-8s%-8s%-8s%-8s%-8s%-8s%-8s%-8s%-7s", "MAC", "Device",
         "Tokens", "PFM", "RPFM", "DER", "Postpd", "DNER", "TestReq", "TestRsp");
@@ -385,31 +492,118 @@ static void packet_statistics_print(void)
     }
     fprintf(stdout, "Node Count: %u\n", node_count);
     fprintf(stdout, "Invalid Frame Count: %lu\n",
-        (long unsigned int)Invalid_Frame_Count);
+        (long unsigned int)port->invalid_frame_count);
     fflush(stdout);
 }
 
-static void packet_statistics_clear(void)
+static void packet_statistics_clear(struct mstpcap_port *port)
 {
     unsigned i = 0;
 
-    memset(&MSTP_Statistics[0], 0, sizeof(MSTP_Statistics));
+    memset(&port->statistics[0], 0, sizeof(port->statistics));
     for (i = 0; i < MAX_MSTP_DEVICES; i++) {
-        MSTP_Statistics[i].device_id = 0xFFFFFFFF;
+        port->statistics[i].device_id = 0xFFFFFFFF;
+    }
+    port->invalid_frame_count = 0;
+    port->old_frame = 255;
+    port->old_src = 255;
+    port->old_dst = 255;
+    port->old_token_dst = 255;
+}
+
+static void histogram_export(FILE *file, const char *name, uint32_t *histogram)
+{
+    unsigned i;
+
+    fprintf(file, ",\"%s\":[", name);
+    for (i = 0; i < MSTPCAP_HISTOGRAM_BINS; i++) {
+        fprintf(file, "%s%lu", i ? "," : "", (unsigned long)histogram[i]);
+    }
+    fprintf(file, "]");
+}
+
+/* write the statistics of every port as JSON to a temporary file, then
+   rename it, so a reader never sees a partly written file */
+static void statistics_export(void)
+{
+    char filename[256];
+    FILE *file;
+    struct mstpcap_port *port;
+    struct mstp_statistics *node;
+    unsigned p, i, count;
+
+    if (!Statistics_Filename) {
+        return;
+    }
+    snprintf(filename, sizeof(filename), "%s.tmp", Statistics_Filename);
+    file = fopen(filename, "w");
+    if (!file) {
+        return;
+    }
+    fprintf(file, "{\"time\":%lu,\"histogram_ms\":[",
+        (unsigned long)time(NULL));
+    for (i = 0; i < (MSTPCAP_HISTOGRAM_BINS - 1); i++) {
+        fprintf(file, "%s%lu", i ? "," : "", (unsigned long)Histogram_Limit[i]);
+    }
+    fprintf(file, "],\n\"ports\":[");
+    for (p = 0; p < MSTPCAP_Port_Count; p++) {
+        port = &MSTPCAP_Ports[p];
+        fprintf(file,
+            "%s\n{\"interface\":\"%s\",\"packets\":%lu,"
+            "\"invalid_frames\":%lu,\"nodes\":[",
+            p ? "," : "", port->name, (unsigned long)port->packet_count,
+            (unsigned long)port->invalid_frame_count);
+        count = 0;
+        for (i = 0; i < MAX_MSTP_DEVICES; i++) {
+            node = &port->statistics[i];
+            if (!node->token_count && !node->der_reply && !node->pfm_count &&
+                !node->dner_count) {
+                continue;
+            }
+            fprintf(file, "%s\n{\"mac\":%u", count ? "," : "", i);
+            if (node->device_id <= 4194303) {
+                fprintf(file, ",\"device\":%lu", (unsigned long)node->device_id);
+            }
+            fprintf(file,
+                ",\"tokens\":%lu,\"pfm\":%lu,\"rpfm\":%lu,\"der\":%lu,"
+                "\"dner\":%lu,\"postponed\":%lu,\"token_retries\":%lu,"
+                "\"max_master\":%u,\"npoll\":%lu,\"treply_max\":%lu,"
+                "\"tusage_max\":%lu,\"trpfm_max\":%lu",
+                (unsigned long)node->token_count, (unsigned long)node->pfm_count,
+                (unsigned long)node->rpfm_count, (unsigned long)node->der_count,
+                (unsigned long)node->dner_count,
+                (unsigned long)node->reply_postponed_count,
+                (unsigned long)node->token_retries, (unsigned)node->max_master,
+                (unsigned long)node->npoll, (unsigned long)node->token_reply,
+                (unsigned long)node->tusage_timeout,
+                (unsigned long)node->pfm_reply);
+            histogram_export(
+                file, "token_usage_ms", node->token_usage_histogram);
+            histogram_export(file, "pfm_reply_ms", node->pfm_reply_histogram);
+            fprintf(file, "}");
+            count++;
+        }
+        fprintf(file, "]}");
+    }
+    fprintf(file, "]}\n");
+    fclose(file);
+    if (rename(filename, Statistics_Filename) != 0) {
+        remove(filename);
     }
-    Invalid_Frame_Count = 0;
 }
 
 static uint32_t Timer_Silence(void *pArg)
 {
-    (void)pArg;
-    return mstimer_elapsed(&Silence_Timer);
+    struct mstpcap_port *port = (struct mstpcap_port *)pArg;
+
+    return mstimer_elapsed(&port->silence_timer);
 }
 
 static void Timer_Silence_Reset(void *pArg)
 {
-    (void)pArg;
-    mstimer_set(&Silence_Timer, 0);
+    struct mstpcap_port *port = (struct mstpcap_port *)pArg;
+
+    mstimer_set(&port->silence_timer, 0);
 }
 
 /* functions used by the MS/TP state machine to put or get data */
@@ -456,6 +650,130 @@ uint16_t MSTP_Get_Reply(
 
 static char Capture_Filename[64] = "mstp_20090123091200.cap";
 static FILE *File_Handle = NULL; /* stream pointer */
+#if defined(MSTPCAP_RING)
+/* Ring of capture files: each file is preallocated to Ring_Size and
+   memory-mapped, so a packet is a memcpy rather than a write() call.
+   A file is closed and truncated to the used length when the next packet
+   would not fit, or after Ring_Duration seconds, and only the newest
+   Ring_Files files are kept. */
+static bool Ring_Enabled;
+static unsigned Ring_Files; /* 0 keeps every file */
+static size_t Ring_Size = 16UL * 1024UL * 1024UL;
+static unsigned long Ring_Duration; /* seconds, 0 rotates by size only */
+static char (*Ring_Filenames)[64];
+static unsigned Ring_Sequence;
+static int Ring_FD = -1;
+static uint8_t *Ring_Map;
+static size_t Ring_Used;
+static time_t Ring_Opened;
+static size_t pcapng_section_header(uint8_t *buffer, size_t buffer_size);
+
+static void ring_close(void)
+{
+    if (Ring_Map) {
+        munmap(Ring_Map, Ring_Size);
+        Ring_Map = NULL;
+    }
+    if (Ring_FD != -1) {
+        if (ftruncate(Ring_FD, Ring_Used) != 0) {
+            perror("mstpcap: ring file truncate");
+        }
+        close(Ring_FD);
+        Ring_FD = -1;
+    }
+    Ring_Used = 0;
+}
+
+static bool ring_open(void)
+{
+    BACNET_DATE bdate;
+    BACNET_TIME btime;
+    char filename[64];
+    void *map;
+    unsigned slot = 0;
+
+    datetime_local(&bdate, &btime, NULL, NULL);
+    snprintf(filename, sizeof(filename),
+        "mstp_%05u_%04d%02d%02d%02d%02d%02d.pcapng",
+        (unsigned)(Ring_Sequence % 100000), (int)bdate.year, (int)bdate.month,
+        (int)bdate.day, (int)btime.hour, (int)btime.min, (int)btime.sec);
+    if (Ring_Files) {
+        /* the slot holds the oldest file of the ring */
+        slot = Ring_Sequence % Ring_Files;
+        if (Ring_Filenames[slot][0]) {
+            remove(Ring_Filenames[slot]);
+        }
+        snprintf(Ring_Filenames[slot], sizeof(Ring_Filenames[slot]), "%s",
+            filename);
+    }
+    Ring_Sequence++;
+    Ring_FD = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (Ring_FD == -1) {
+        fprintf(stderr, "mstpcap: failed to open %s: %s\n", filename,
+            strerror(errno));
+        return false;
+    }
+#if defined(__linux__)
+    /* reserve the blocks now, so the mapping can't fault with SIGBUS
+       on a full disk; not every file system supports it */
+    if ((posix_fallocate(Ring_FD, 0, Ring_Size) != 0) &&
+        (ftruncate(Ring_FD, Ring_Size) != 0)) {
+#else
+    if (ftruncate(Ring_FD, Ring_Size) != 0) {
+#endif
+        fprintf(stderr, "mstpcap: failed to size %s: %s\n", filename,
+            strerror(errno));
+        close(Ring_FD);
+        Ring_FD = -1;
+        return false;
+    }
+    map = mmap(NULL, Ring_Size, PROT_READ | PROT_WRITE, MAP_SHARED, Ring_FD, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "mstpcap: failed to map %s: %s\n", filename,
+            strerror(errno));
+        close(Ring_FD);
+        Ring_FD = -1;
+        return false;
+    }
+    Ring_Map = map;
+    Ring_Used = pcapng_section_header(Ring_Map, Ring_Size);
+    Ring_Opened = time(NULL);
+    if (!Wireshark_Capture) {
+        fprintf(stdout, "\nmstpcap: saving capture to %s\n", filename);
+    }
+
+    return true;
+}
+
+static void ring_write(const void *ptr, size_t len)
+{
+    bool rotate = false;
+
+    if (!Ring_Enabled) {
+        return;
+    }
+    if (Ring_Map) {
+        if ((Ring_Used + len) > Ring_Size) {
+            rotate = true;
+        } else if (Ring_Duration &&
+            ((unsigned long)(time(NULL) - Ring_Opened) >= Ring_Duration)) {
+            rotate = true;
+        }
+        if (rotate) {
+            ring_close();
+        }
+    }
+    if (!Ring_Map) {
+        if (!ring_open()) {
+            return;
+        }
+    }
+    if ((Ring_Used + len) <= Ring_Size) {
+        memcpy(&Ring_Map[Ring_Used], ptr, len);
+        Ring_Used += len;
+    }
+}
+#endif
 #if defined(_WIN32)
 static HANDLE Pipe_Handle = INVALID_HANDLE_VALUE; /* pipe handle */
 static void named_pipe_create(char *pipe_name)
@@ -550,6 +868,7 @@ static size_t data_write(const void *ptr, size_t size, size_t nitems)
     if (File_Handle) {
         written = fwrite(ptr, size, nitems, File_Handle);
     }
+    ring_write(ptr, size * nitems);
 
     return written;
 }
@@ -585,9 +904,9 @@ static void filename_create_new(void)
     }
     File_Handle = NULL;
     datetime_local(&bdate, &btime, NULL, NULL);
-    snprintf(filename, filename_size, "mstp_%04d%02d%02d%02d%02d%02d.cap",
+    snprintf(filename, filename_size, "mstp_%04d%02d%02d%02d%02d%02d.%s",
         (int)bdate.year, (int)bdate.month, (int)bdate.day, (int)btime.hour,
-        (int)btime.min, (int)btime.sec);
+        (int)btime.min, (int)btime.sec, Capture_Pcapng ? "pcapng" : "cap");
     File_Handle = fopen(filename, "wb");
     if (File_Handle) {
         fprintf(stdout, "mstpcap: saving capture to %s\n", filename);
@@ -597,6 +916,71 @@ static void filename_create_new(void)
     }
 }
 
+static size_t pcapng_put_u16(uint8_t *buffer, uint16_t value)
+{
+    memcpy(buffer, &value, sizeof(value));
+
+    return sizeof(value);
+}
+
+static size_t pcapng_put_u32(uint8_t *buffer, uint32_t value)
+{
+    memcpy(buffer, &value, sizeof(value));
+
+    return sizeof(value);
+}
+
+/* pcapng Section Header Block, then one Interface Description Block for
+   each port, in host byte order; returns the length, or 0 if too small */
+static size_t pcapng_section_header(uint8_t *buffer, size_t buffer_size)
+{
+    size_t len = 0, block = 0, name_len = 0;
+    unsigned i;
+
+    if (buffer_size < 28) {
+        return 0;
+    }
+    len += pcapng_put_u32(&buffer[len], 0x0A0D0D0A);
+    len += pcapng_put_u32(&buffer[len], 28);
+    len += pcapng_put_u32(&buffer[len], 0x1A2B3C4D);
+    len += pcapng_put_u16(&buffer[len], 1);
+    len += pcapng_put_u16(&buffer[len], 0);
+    /* section length is not specified */
+    len += pcapng_put_u32(&buffer[len], 0xFFFFFFFF);
+    len += pcapng_put_u32(&buffer[len], 0xFFFFFFFF);
+    len += pcapng_put_u32(&buffer[len], 28);
+    for (i = 0; i < MSTPCAP_Port_Count; i++) {
+        name_len = 0;
+        if (MSTPCAP_Ports[i].name) {
+            name_len = strlen(MSTPCAP_Ports[i].name);
+        }
+        /* header, if_name option padded to 32 bits, end of options */
+        block = 16 + 4 + ((name_len + 3) & ~3U) + 4 + 4;
+        if ((len + block) > buffer_size) {
+            return 0;
+        }
+        len += pcapng_put_u32(&buffer[len], 1);
+        len += pcapng_put_u32(&buffer[len], block);
+        len += pcapng_put_u16(&buffer[len], DLT_BACNET_MS_TP);
+        len += pcapng_put_u16(&buffer[len], 0);
+        len += pcapng_put_u32(&buffer[len], 65535);
+        len += pcapng_put_u16(&buffer[len], 2);
+        len += pcapng_put_u16(&buffer[len], name_len);
+        if (name_len) {
+            memcpy(&buffer[len], MSTPCAP_Ports[i].name, name_len);
+        }
+        while (name_len & 3) {
+            buffer[len + name_len] = 0;
+            name_len++;
+        }
+        len += name_len;
+        len += pcapng_put_u32(&buffer[len], 0);
+        len += pcapng_put_u32(&buffer[len], block);
+    }
+
+    return len;
+}
+
 /* write packet to file in libpcap format */
 static void write_global_header(void)
 {
@@ -607,42 +991,46 @@ static void write_global_header(void)
     uint32_t sigfigs = 0; /* accuracy of timestamps */
     uint32_t snaplen = 65535; /* max length of captured packets, in octets */
     uint32_t network = DLT_BACNET_MS_TP; /* data link type - BACNET_MS_TP */
+    uint8_t buffer[28 + MSTPCAP_PORTS_MAX * 128];
+    size_t len;
 
-    /* create a new file. */
-    (void)data_write_header(
-        &magic_number, sizeof(magic_number), 1);
-    (void)data_write_header(
-        &version_major, sizeof(version_major), 1);
-    (void)data_write_header(
-        &version_minor, sizeof(version_minor), 1);
-    (void)data_write_header(&thiszone, sizeof(thiszone), 1);
-    (void)data_write_header(&sigfigs, sizeof(sigfigs), 1);
-    (void)data_write_header(&snaplen, sizeof(snaplen), 1);
-    (void)data_write_header(&network, sizeof(network), 1);
-    fflush(File_Handle);
+    if (Capture_Pcapng) {
+        len = pcapng_section_header(buffer, sizeof(buffer));
+        (void)data_write_header(buffer, len, 1);
+    } else {
+        /* create a new file. */
+        (void)data_write_header(&magic_number, sizeof(magic_number), 1);
+        (void)data_write_header(&version_major, sizeof(version_major), 1);
+        (void)data_write_header(&version_minor, sizeof(version_minor), 1);
+        (void)data_write_header(&thiszone, sizeof(thiszone), 1);
+        (void)data_write_header(&sigfigs, sizeof(sigfigs), 1);
+        (void)data_write_header(&snaplen, sizeof(snaplen), 1);
+        (void)data_write_header(&network, sizeof(network), 1);
+    }
+    if (File_Handle) {
+        fflush(File_Handle);
+    }
 }
 
-static void write_received_packet(
-    volatile struct mstp_port_struct_t *mstp_port, size_t header_len)
+/* the packet is built as one record, and written at once, so that each
+   record lands in one file of the ring */
+static void write_received_packet(struct mstpcap_port *port, size_t header_len)
 {
-    uint32_t ts_sec = 0; /* timestamp seconds */
-    uint32_t ts_usec = 0; /* timestamp microseconds */
+    volatile struct mstp_port_struct_t *mstp_port = &port->mstp_port;
+    static uint8_t record[32 + MSTP_HEADER_MAX + DLMSTP_MPDU_MAX + 8];
+    uint64_t timestamp = 0;
     uint32_t incl_len = 0; /* number of octets of packet saved in file */
-    uint32_t orig_len = 0; /* actual length of packet */
     uint32_t data_crc_len = 2;
     uint8_t header[MSTP_HEADER_MAX] = { 0 }; /* MS/TP header */
     struct timeval tv;
     size_t max_data = 0;
+    size_t len = 0, block_len = 0;
 
     gettimeofday(&tv, NULL);
-    ts_sec = tv.tv_sec;
-    ts_usec = tv.tv_usec;
     if ((mstp_port->ReceivedValidFrame) ||
         (mstp_port->ReceivedValidFrameNotForUs)) {
-        packet_statistics(&tv, mstp_port);
+        packet_statistics(&tv, port);
     }
-    (void)data_write(&ts_sec, sizeof(ts_sec), 1);
-    (void)data_write(&ts_usec, sizeof(ts_usec), 1);
     if (mstp_port->ReceivedInvalidFrame) {
         if (mstp_port->Index) {
             max_data = min(mstp_port->InputBufferSize, mstp_port->Index);
@@ -652,23 +1040,21 @@ static void write_received_packet(
                     so only 1 for checksum */
                 data_crc_len = 1;
             }
-            incl_len = orig_len = header_len + max_data + data_crc_len;
+            incl_len = header_len + max_data + data_crc_len;
         } else {
             /* header only */
-            incl_len = orig_len = header_len;
+            incl_len = header_len;
         }
     } else {
         if (mstp_port->DataLength) {
             max_data =
                 min(mstp_port->InputBufferSize, mstp_port->DataLength);
-            incl_len = orig_len = header_len + max_data + data_crc_len;
+            incl_len = header_len + max_data + data_crc_len;
         } else {
             /* header only - or at least some bytes of the header */
-            incl_len = orig_len = header_len;
+            incl_len = header_len;
         }
     }
-    (void)data_write(&incl_len, sizeof(incl_len), 1);
-    (void)data_write(&orig_len, sizeof(orig_len), 1);
     if (header_len == 1) {
         header[0] = mstp_port->DataRegister;
     } else if (header_len == 2) {
@@ -684,12 +1070,40 @@ static void write_received_packet(
         header[6] = LO_BYTE(mstp_port->DataLength);
         header[7] = mstp_port->HeaderCRCActual;
     }
-    (void)data_write(header, header_len, 1);
+    if (Capture_Pcapng) {
+        /* Enhanced Packet Block, with a microsecond timestamp */
+        block_len = 28 + ((incl_len + 3) & ~3U) + 4;
+        timestamp = ((uint64_t)tv.tv_sec * 1000000ULL) + tv.tv_usec;
+        len += pcapng_put_u32(&record[len], 6);
+        len += pcapng_put_u32(&record[len], block_len);
+        len += pcapng_put_u32(&record[len], port - &MSTPCAP_Ports[0]);
+        len += pcapng_put_u32(&record[len], (uint32_t)(timestamp >> 32));
+        len += pcapng_put_u32(&record[len], (uint32_t)timestamp);
+        len += pcapng_put_u32(&record[len], incl_len);
+        len += pcapng_put_u32(&record[len], incl_len);
+    } else {
+        len += pcapng_put_u32(&record[len], tv.tv_sec);
+        len += pcapng_put_u32(&record[len], tv.tv_usec);
+        len += pcapng_put_u32(&record[len], incl_len);
+        len += pcapng_put_u32(&record[len], incl_len);
+    }
+    memcpy(&record[len], header, header_len);
+    len += header_len;
     if (max_data) {
-        (void)data_write(mstp_port->InputBuffer, max_data, 1);
-        (void)data_write((char *)&mstp_port->DataCRCActualMSB, 1, 1);
-        (void)data_write((char *)&mstp_port->DataCRCActualLSB, 1, 1);
+        memcpy(&record[len], mstp_port->InputBuffer, max_data);
+        len += max_data;
+        record[len++] = mstp_port->DataCRCActualMSB;
+        if (data_crc_len > 1) {
+            record[len++] = mstp_port->DataCRCActualLSB;
+        }
     }
+    if (Capture_Pcapng) {
+        while (len < (block_len - 4)) {
+            record[len++] = 0;
+        }
+        len += pcapng_put_u32(&record[len], block_len);
+    }
+    (void)data_write(record, len, 1);
 }
 
 /* read header from file in libpcap format */
@@ -765,8 +1179,9 @@ static bool test_global_header(const char *filename)
     return true;
 }
 
-static bool read_received_packet(volatile struct mstp_port_struct_t *mstp_port)
+static bool read_received_packet(struct mstpcap_port *port)
 {
+    volatile struct mstp_port_struct_t *mstp_port = &port->mstp_port;
     uint32_t ts_sec = 0; /* timestamp seconds */
     uint32_t ts_usec = 0; /* timestamp microseconds */
     uint32_t incl_len = 0; /* number of octets of packet saved in file */
@@ -874,10 +1289,10 @@ static bool read_received_packet(volatile struct mstp_port_struct_t *mstp_port)
             mstp_port->DataLength = 0;
         }
         if (mstp_port->ReceivedInvalidFrame) {
-            Invalid_Frame_Count++;
+            port->invalid_frame_count++;
         } else if ((mstp_port->ReceivedValidFrame) ||
             (mstp_port->ReceivedValidFrameNotForUs)) {
-            packet_statistics(&tv, mstp_port);
+            packet_statistics(&tv, port);
         }
     } else {
         return false;
@@ -888,14 +1303,30 @@ static bool read_received_packet(volatile struct mstp_port_struct_t *mstp_port)
 
 static void cleanup(void)
 {
+    unsigned i;
+
+    capture_lock();
     if (!Wireshark_Capture) {
-        packet_statistics_print();
+        for (i = 0; i < MSTPCAP_Port_Count; i++) {
+            packet_statistics_print(&MSTPCAP_Ports[i]);
+        }
     }
+    statistics_export();
     if (File_Handle) {
         fflush(File_Handle); /* stream pointer */
         fclose(File_Handle); /* stream pointer */
     }
     File_Handle = NULL;
+#if defined(MSTPCAP_RING)
+    ring_close();
+#endif
+#if !defined(_WIN32)
+    if (FD_Pipe != -1) {
+        close(FD_Pipe);
+        FD_Pipe = -1;
+    }
+#endif
+    capture_unlock();
 }
 
 #if defined(_WIN32)
@@ -922,11 +1353,13 @@ static BOOL WINAPI CtrlCHandler(DWORD dwCtrlType)
 static void sig_int(int signo)
 {
     (void)signo;
-    if (FD_Pipe != -1) {
-        close(FD_Pipe);
+    if (Exit_Requested) {
+        /* the main loop did not stop the first time */
+        exit(0);
     }
+    /* signal to main loop to exit, so the capture threads are joined
+       and the ring file is truncated before exit */
     Exit_Requested = true;
-    exit(0);
 }
 
 static void signal_init(void)
@@ -944,6 +1377,10 @@ static void print_usage(char *filename)
     printf(" [--extcap-interface port]\n");
     printf(" [--extcap-interfaces][--extcap-dlts][--extcap-config]\n");
     printf(" [--capture][--baud baud][--fifo pipe]\n");
+#if defined(MSTPCAP_RING)
+    printf(" [--ring-files count][--ring-size MB][--ring-duration seconds]\n");
+#endif
+    printf(" [--stats-file filename][--stats-interval seconds]\n");
     printf(" [--version][--help]\n");
 }
 
@@ -964,6 +1401,9 @@ static void print_help(char *filename)
            "    Supported values: COM1, COM2, etc.\n"
 #else
            "    Supported values: /dev/ttyS0, /dev/ttyUSB0, etc.\n"
+#endif
+#if (MSTPCAP_PORTS_MAX > 1)
+           "    Repeat to capture more than one port into one pcapng file.\n"
 #endif
            "[--baud baud] - MS/TP port baud rate.\n"
            "    Supported values: 9600, 19200, 38400, 57600, 76800, 115200.\n"
@@ -974,7 +1414,19 @@ static void print_help(char *filename)
 #else
            "    Supported values: any file name\n"
 #endif
-           "    Use that name as the interface name in Wireshark.\n");
+           "    Use that name as the interface name in Wireshark.\n"
+#if defined(MSTPCAP_RING)
+           "[--ring-files count] - capture to a ring of memory-mapped\n"
+           "    pcapng files, and keep only the newest count files.\n"
+           "    0 keeps every file.\n"
+           "[--ring-size MB] - size of each ring file. Defaults to 16.\n"
+           "[--ring-duration seconds] - also start the next ring file\n"
+           "    after this many seconds.\n"
+#endif
+           "[--stats-file filename] - periodically write the statistics\n"
+           "    of each node, including token and poll latency histograms,\n"
+           "    as JSON to this file.\n"
+           "[--stats-interval seconds] - Defaults to 10.\n");
     printf("\n");
     printf("%s [--extcap-interfaces][--extcap-dlts][--extcap-config]\n"
            "[--capture][--baud baud][--fifo pipe]\n"
@@ -1001,29 +1453,147 @@ static void mstp_structure_init(volatile struct mstp_port_struct_t *mstp_port)
     }
 }
 
+static void mstpcap_port_init(struct mstpcap_port *port)
+{
+    volatile struct mstp_port_struct_t *mstp_port = &port->mstp_port;
+
+    mstp_port->InputBuffer = &port->rx_buffer[0];
+    mstp_port->InputBufferSize = sizeof(port->rx_buffer);
+    mstp_port->OutputBuffer = &port->tx_buffer[0];
+    mstp_port->OutputBufferSize = sizeof(port->tx_buffer);
+    mstp_port->This_Station = 127;
+    mstp_port->Nmax_info_frames = 1;
+    mstp_port->Nmax_master = 127;
+    mstp_port->SilenceTimer = Timer_Silence;
+    mstp_port->SilenceTimerReset = Timer_Silence_Reset;
+    MSTP_Init(mstp_port);
+    port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+    packet_statistics_clear(port);
+}
+
+/* add a serial interface: the first one replaces the default port,
+   the others are captured alongside it where supported */
+static bool mstpcap_interface_add(char *name)
+{
+    static bool port_named;
+
+    if (!port_named || (MSTPCAP_PORTS_MAX == 1)) {
+        RS485_Set_Interface(name);
+        MSTPCAP_Ports[0].name = name;
+        port_named = true;
+    } else if (MSTPCAP_Port_Count < MSTPCAP_PORTS_MAX) {
+        MSTPCAP_Ports[MSTPCAP_Port_Count].name = name;
+        MSTPCAP_Port_Count++;
+    } else {
+        fprintf(stderr, "mstpcap: %s: no more than %u ports.\n", name,
+            (unsigned)MSTPCAP_PORTS_MAX);
+        return false;
+    }
+
+    return true;
+}
+
+/* receive octets from one port and write any frame to the capture */
+/**
+ * @brief Run the received octets of a port through the receive state
+ *  machine, a block at a time on the faster ports
+ * @param port - port being captured
+ */
+static void mstpcap_port_read(struct mstpcap_port *port)
+{
+    volatile struct mstp_port_struct_t *mstp_port = &port->mstp_port;
+
+#if defined(MSTPCAP_BLOCK_BAUD)
+    if (MSTPCAP_Baud >= MSTPCAP_BLOCK_BAUD) {
+        RS485_Receive_Frame_Block(mstp_port);
+        return;
+    }
+#endif
+    RS485_Check_UART_Data(mstp_port);
+    MSTP_Receive_Frame_FSM(mstp_port);
+}
+
+static void mstpcap_port_receive(struct mstpcap_port *port)
+{
+    volatile struct mstp_port_struct_t *mstp_port = &port->mstp_port;
+    uint32_t header_len = 0;
+
+    mstpcap_port_read(port);
+    capture_lock();
+    /* process the data portion of the frame */
+    if (mstp_port->ReceivedValidFrame) {
+        write_received_packet(port, MSTP_HEADER_MAX);
+        mstp_structure_init(mstp_port);
+        port->packet_count++;
+    } else if (mstp_port->ReceivedValidFrameNotForUs) {
+        write_received_packet(port, MSTP_HEADER_MAX);
+        mstp_structure_init(mstp_port);
+        port->packet_count++;
+    } else if (mstp_port->ReceivedInvalidFrame) {
+        if (port->receive_state == MSTP_RECEIVE_STATE_HEADER) {
+            mstp_port->Index = 0;
+        }
+        write_received_packet(port, MSTP_HEADER_MAX);
+        mstp_structure_init(mstp_port);
+        port->invalid_frame_count++;
+        port->packet_count++;
+    } else if (mstp_port->receive_state == MSTP_RECEIVE_STATE_IDLE) {
+        if (port->receive_state == MSTP_RECEIVE_STATE_IDLE) {
+            if ((mstp_port->EventCount == 1) &&
+                (mstp_port->DataRegister == 0xFF)) {
+                /* 0xFF padding at end of message is allowed */
+                mstp_structure_init(mstp_port);
+            } else if (mstp_port->EventCount > 1) {
+                write_received_packet(port, 1);
+                mstp_structure_init(mstp_port);
+                port->invalid_frame_count++;
+            }
+        } else {
+            /* invalid byte or timeout */
+            if (port->receive_state == MSTP_RECEIVE_STATE_PREAMBLE) {
+                if (mstp_port->EventCount) {
+                    header_len = 1;
+                } else {
+                    header_len = 2;
+                }
+            } else {
+                header_len = 3 + mstp_port->Index;
+            }
+            write_received_packet(port, header_len);
+            mstp_structure_init(mstp_port);
+            port->invalid_frame_count++;
+        }
+    }
+    capture_unlock();
+    /* track the packetizer state */
+    port->receive_state = mstp_port->receive_state;
+}
+
+#if (MSTPCAP_PORTS_MAX > 1)
+static void *mstpcap_port_thread(void *pArg)
+{
+    struct mstpcap_port *port = (struct mstpcap_port *)pArg;
+
+    while (!Exit_Requested) {
+        mstpcap_port_receive(port);
+    }
+
+    return NULL;
+}
+#endif
+
 /* simple test to packetize the data and print it */
 int main(int argc, char *argv[])
 {
-    volatile struct mstp_port_struct_t *mstp_port;
+    struct mstpcap_port *port = &MSTPCAP_Ports[0];
     long my_baud = 38400;
     uint32_t packet_count = 0;
-    uint32_t header_len = 0;
+    uint32_t invalid_frame_count = 0;
     int argi = 0;
+    unsigned i = 0;
     char *filename = NULL;
 
-    MSTP_Port.InputBuffer = &RxBuffer[0];
-    MSTP_Port.InputBufferSize = sizeof(RxBuffer);
-    MSTP_Port.OutputBuffer = &TxBuffer[0];
-    MSTP_Port.OutputBufferSize = sizeof(TxBuffer);
-    MSTP_Port.This_Station = 127;
-    MSTP_Port.Nmax_info_frames = 1;
-    MSTP_Port.Nmax_master = 127;
-    MSTP_Port.SilenceTimer = Timer_Silence;
-    MSTP_Port.SilenceTimerReset = Timer_Silence_Reset;
-    /* mimic our pointer in the state machine */
-    mstp_port = &MSTP_Port;
-    MSTP_Init(mstp_port);
-    packet_statistics_clear();
+    mstpcap_port_init(port);
     /* decode any command line parameters */
     filename = filename_remove_path(argv[0]);
     for (argi = 1; argi < argc; argi++) {
@@ -1048,14 +1618,15 @@ int main(int argc, char *argv[])
                 return 1;
             }
             printf("Scanning %s\n", argv[argi]);
+            port->name = argv[argi];
             /* perform statistics on the file */
             if (test_global_header(argv[argi])) {
-                while (read_received_packet(mstp_port)) {
+                while (read_received_packet(port)) {
                     packet_count++;
                     fprintf(stderr, "\r%u packets", (unsigned)packet_count);
                 }
                 if (packet_count) {
-                    packet_statistics_print();
+                    packet_statistics_print(port);
                 }
                 Exit_Requested = true;
             } else {
@@ -1105,12 +1676,16 @@ int main(int argc, char *argv[])
                        "the selection must be displayed.\n");
                 return 0;
             }
-            RS485_Set_Interface(argv[argi]);
+            if (!mstpcap_interface_add(argv[argi])) {
+                return 1;
+            }
+            continue;
         }
 #if defined(_WIN32)
         if (strncasecmp(argv[argi], "com", 3) == 0) {
             /* legacy command line options */
             RS485_Set_Interface(argv[argi]);
+            port->name = argv[argi];
             if ((argi + 1) < argc) {
                 argi++;
                 my_baud = strtol(argv[argi], NULL, 0);
@@ -1120,8 +1695,12 @@ int main(int argc, char *argv[])
 #else
         if (strncasecmp(argv[argi], "/dev/", 5) == 0) {
             /* legacy command line options */
-            RS485_Set_Interface(argv[argi]);
-            if ((argi + 1) < argc) {
+            if (!mstpcap_interface_add(argv[argi])) {
+                return 1;
+            }
+            if (((argi + 1) < argc) &&
+                (strncasecmp(argv[argi + 1], "/dev/", 5) != 0) &&
+                (strncmp(argv[argi + 1], "--", 2) != 0)) {
                 argi++;
                 my_baud = strtol(argv[argi], NULL, 0);
                 RS485_Set_Baud_Rate(my_baud);
@@ -1145,6 +1724,57 @@ int main(int argc, char *argv[])
             }
             named_pipe_create(argv[argi]);
         }
+#if defined(MSTPCAP_RING)
+        if (strcmp(argv[argi], "--ring-files") == 0) {
+            argi++;
+            if (argi >= argc) {
+                printf("A number of files must be provided.\n");
+                return 0;
+            }
+            Ring_Files = strtoul(argv[argi], NULL, 0);
+            Ring_Enabled = true;
+        }
+        if (strcmp(argv[argi], "--ring-size") == 0) {
+            argi++;
+            if (argi >= argc) {
+                printf("A file size in megabytes must be provided.\n");
+                return 0;
+            }
+            Ring_Size = strtoul(argv[argi], NULL, 0) * 1024UL * 1024UL;
+            if (Ring_Size == 0) {
+                Ring_Size = 1024UL * 1024UL;
+            }
+            Ring_Enabled = true;
+        }
+        if (strcmp(argv[argi], "--ring-duration") == 0) {
+            argi++;
+            if (argi >= argc) {
+                printf("A duration in seconds must be provided.\n");
+                return 0;
+            }
+            Ring_Duration = strtoul(argv[argi], NULL, 0);
+            Ring_Enabled = true;
+        }
+#endif
+        if (strcmp(argv[argi], "--stats-file") == 0) {
+            argi++;
+            if (argi >= argc) {
+                printf("A statistics file name must be provided.\n");
+                return 0;
+            }
+            Statistics_Filename = argv[argi];
+        }
+        if (strcmp(argv[argi], "--stats-interval") == 0) {
+            argi++;
+            if (argi >= argc) {
+                printf("A statistics interval in seconds must be provided.\n");
+                return 0;
+            }
+            Statistics_Interval = strtoul(argv[argi], NULL, 0);
+            if (Statistics_Interval == 0) {
+                Statistics_Interval = 1;
+            }
+        }
     }
     if (Exit_Requested) {
         return 0;
@@ -1153,12 +1783,40 @@ int main(int argc, char *argv[])
         RS485_Print_Ports();
         return 0;
     }
+    MSTPCAP_Baud = my_baud;
+    if (!port->name) {
+        port->name = (char *)RS485_Interface();
+    }
+#if defined(MSTPCAP_RING)
+    if (Ring_Enabled && Ring_Files) {
+        Ring_Filenames = calloc(Ring_Files, sizeof(Ring_Filenames[0]));
+        if (!Ring_Filenames) {
+            return 1;
+        }
+    }
+    Capture_Pcapng = Ring_Enabled || (MSTPCAP_Port_Count > 1);
+#else
+    Capture_Pcapng = (MSTPCAP_Port_Count > 1);
+#endif
+    for (i = 1; i < MSTPCAP_Port_Count; i++) {
+        mstpcap_port_init(&MSTPCAP_Ports[i]);
+        if (!RS485_Port_Initialize(&MSTPCAP_Ports[i].mstp_port,
+                MSTPCAP_Ports[i].name, MSTPCAP_Baud)) {
+            fprintf(stderr, "mstpcap: unable to open %s at %lu bps.\n",
+                MSTPCAP_Ports[i].name, (unsigned long)MSTPCAP_Baud);
+            return 1;
+        }
+    }
     atexit(cleanup);
     RS485_Initialize();
     mstimer_init();
     if (!Wireshark_Capture) {
         fprintf(stdout, "mstpcap: Using %s for capture at %ld bps.\n",
             RS485_Interface(), (long)RS485_Get_Baud_Rate());
+        for (i = 1; i < MSTPCAP_Port_Count; i++) {
+            fprintf(stdout, "mstpcap: Using %s for capture at %lu bps.\n",
+                MSTPCAP_Ports[i].name, (unsigned long)MSTPCAP_Baud);
+        }
     }
 #if defined(_WIN32)
     SetConsoleMode(GetStdHandle(STD_INPUT_HANDLE), ENABLE_PROCESSED_INPUT);
@@ -1166,76 +1824,71 @@ int main(int argc, char *argv[])
 #else
     signal_init();
 #endif
+#if defined(MSTPCAP_RING)
+    if (!Ring_Enabled) {
+        filename_create_new();
+    }
+#else
     filename_create_new();
+#endif
     write_global_header();
+    mstimer_set(&Statistics_Timer, Statistics_Interval * 1000UL);
+#if (MSTPCAP_PORTS_MAX > 1)
+    for (i = 1; i < MSTPCAP_Port_Count; i++) {
+        if (pthread_create(&MSTPCAP_Ports[i].thread, NULL,
+                mstpcap_port_thread, &MSTPCAP_Ports[i]) != 0) {
+            fprintf(stderr, "mstpcap: unable to start %s.\n",
+                MSTPCAP_Ports[i].name);
+            Exit_Requested = true;
+            MSTPCAP_Port_Count = i;
+            break;
+        }
+    }
+#endif
     /* run forever */
-    for (;;) {
-        RS485_Check_UART_Data(mstp_port);
-        MSTP_Receive_Frame_FSM(mstp_port);
-        /* process the data portion of the frame */
-        if (mstp_port->ReceivedValidFrame) {
-            write_received_packet(mstp_port, MSTP_HEADER_MAX);
-            mstp_structure_init(mstp_port);
-            packet_count++;
-        } else if (mstp_port->ReceivedValidFrameNotForUs) {
-            write_received_packet(mstp_port, MSTP_HEADER_MAX);
-            mstp_structure_init(mstp_port);
-            packet_count++;
-        } else if (mstp_port->ReceivedInvalidFrame) {
-            if (MSTP_Receive_State == MSTP_RECEIVE_STATE_HEADER) {
-                mstp_port->Index = 0;
-            }
-            write_received_packet(mstp_port, MSTP_HEADER_MAX);
-            mstp_structure_init(mstp_port);
-            Invalid_Frame_Count++;
-            packet_count++;
-        } else if (mstp_port->receive_state == MSTP_RECEIVE_STATE_IDLE) {
-            if (MSTP_Receive_State == MSTP_RECEIVE_STATE_IDLE) {
-                if ((mstp_port->EventCount == 1) &&
-                    (mstp_port->DataRegister == 0xFF)) {
-                    /* 0xFF padding at end of message is allowed */
-                    mstp_structure_init(mstp_port);
-                } else if (mstp_port->EventCount > 1) {
-                    write_received_packet(mstp_port, 1);
-                    mstp_structure_init(mstp_port);
-                    Invalid_Frame_Count++;
-                }
-            } else {
-                /* invalid byte or timeout */
-                if (MSTP_Receive_State == MSTP_RECEIVE_STATE_PREAMBLE) {
-                    if (mstp_port->EventCount) {
-                        header_len = 1;
-                    } else {
-                        header_len = 2;
-                    }
-                } else {
-                    header_len = 3 + mstp_port->Index;
-                }
-                write_received_packet(mstp_port, header_len);
-                mstp_structure_init(mstp_port);
-                Invalid_Frame_Count++;
-            }
+    while (!Exit_Requested) {
+        mstpcap_port_receive(port);
+        if (Statistics_Filename && mstimer_expired(&Statistics_Timer)) {
+            mstimer_reset(&Statistics_Timer);
+            capture_lock();
+            statistics_export();
+            capture_unlock();
         }
         if (!Wireshark_Capture) {
-            if (!(packet_count % 100)) {
+            capture_lock();
+            packet_count = 0;
+            invalid_frame_count = 0;
+            for (i = 0; i < MSTPCAP_Port_Count; i++) {
+                packet_count += MSTPCAP_Ports[i].packet_count;
+                invalid_frame_count += MSTPCAP_Ports[i].invalid_frame_count;
+            }
+            if (packet_count && !(packet_count % 100)) {
                 fprintf(stdout, "\r%u packets, %u invalid frames",
-                    (unsigned)packet_count, (unsigned)Invalid_Frame_Count);
+                    (unsigned)packet_count, (unsigned)invalid_frame_count);
                 fflush(stdout);
             }
+#if defined(MSTPCAP_RING)
+            if ((packet_count >= 65535) && !Ring_Enabled) {
+#else
             if (packet_count >= 65535) {
-                packet_statistics_print();
-                packet_statistics_clear();
+#endif
+                for (i = 0; i < MSTPCAP_Port_Count; i++) {
+                    packet_statistics_print(&MSTPCAP_Ports[i]);
+                    packet_statistics_clear(&MSTPCAP_Ports[i]);
+                    MSTPCAP_Ports[i].packet_count = 0;
+                }
                 filename_create_new();
                 write_global_header();
-                packet_count = 0;
             }
+            capture_unlock();
         }
-        if (Exit_Requested) {
-            break;
-        }
-        /* track the packetizer state */
-        MSTP_Receive_State = mstp_port->receive_state;
     }
+#if (MSTPCAP_PORTS_MAX > 1)
+    for (i = 1; i < MSTPCAP_Port_Count; i++) {
+        pthread_join(MSTPCAP_Ports[i].thread, NULL);
+        RS485_Port_Cleanup(&MSTPCAP_Ports[i].mstp_port);
+    }
+#endif
     /* tell signal interrupts we are done */
     Exit_Requested = false;
 
@@ -0,0 +1,956 @@
+/**
+ * @file
+ * @brief Virtual RS-485 bus simulator for MS/TP token passing
+ *
+ * Runs MS/TP master and slave nodes in one process on a simulated
+ * multi-drop bus.  Time is simulated in steps of one octet time at the
+ * configured baud rate, so a minute of bus traffic runs in a fraction
+ * of a second, and runs with the same seed give the same results.
+ * Each node runs the receive frame, master node and slave node state
+ * machines of mstp.c, as a port would, and the bus adds the turnaround
+ * time, bit errors and collisions.  For each Max_Info_Frames value,
+ * the simulator reports the token rotation time, the share of the bus
+ * spent on Poll For Master, the data throughput and latency, and the
+ * frame error rate seen by a monitor on the bus.
+ *
+ * @date October 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/version.h"
+#include "bacnet/basic/sys/filename.h"
+#include "bacnet/datalink/mstp.h"
+#include "bacnet/datalink/mstpdef.h"
+
+/* data octets in a frame that is not an extended frame */
+#define MSTPSIM_DATA_MAX 501
+/* version, control, kind, and the time the message was queued */
+#define MSTPSIM_DATA_MIN 11
+#define MSTPSIM_MPDU_MAX (8 + MSTPSIM_DATA_MAX + 2)
+/* masters and slaves on the bus */
+#define MSTPSIM_NODES_MAX 254
+/* MAC address of the first slave node */
+#define MSTPSIM_SLAVE_MAC 128
+/* messages waiting for the token in each master */
+#define MSTPSIM_QUEUE_SIZE 16
+/* latency histogram, one bucket per millisecond */
+#define MSTPSIM_LATENCY_MAX 10000
+/* bit times in each octet, with the start and stop bits */
+#define MSTPSIM_OCTET_BITS 10
+
+/* kind of message in the data of a frame */
+enum mstpsim_kind { MSTPSIM_REQUEST, MSTPSIM_REPLY };
+
+/* a message waiting for the token */
+struct mstpsim_message {
+    uint8_t destination;
+    bool expecting_reply;
+    /* bit time when queued */
+    uint64_t queued;
+};
+
+struct mstpsim_node {
+    struct mstp_port_struct_t port;
+    bool master;
+    uint8_t input_buffer[MSTPSIM_DATA_MAX];
+    uint8_t output_buffer[MSTPSIM_MPDU_MAX];
+    /* bit time when the silence timer was reset */
+    uint64_t silence_start;
+    /* frame on the bus, or waiting for the turnaround time */
+    uint8_t tx_buffer[MSTPSIM_MPDU_MAX];
+    uint16_t tx_length;
+    uint16_t tx_index;
+    uint64_t tx_start;
+    /* octets of the frame that another driver collides with */
+    uint16_t tx_collision_start;
+    uint16_t tx_collision_end;
+    /* messages waiting for the token */
+    struct mstpsim_message queue[MSTPSIM_QUEUE_SIZE];
+    unsigned queue_head;
+    unsigned queue_count;
+    uint64_t next_request;
+    /* reply to the last Data Expecting Reply frame */
+    bool reply_pending;
+    uint8_t reply_destination;
+    uint64_t reply_ready;
+    uint64_t reply_queued;
+    /* a slave passed the received data frame up */
+    bool frame_taken;
+};
+
+/* what the monitor and the nodes saw while measuring */
+struct mstpsim_stats {
+    uint64_t bits;
+    uint64_t busy_bits;
+    unsigned long tokens;
+    unsigned long pfm;
+    unsigned long reply_pfm;
+    unsigned long data_frames;
+    unsigned long reply_postponed;
+    unsigned long other_frames;
+    unsigned long invalid_frames;
+    /* token rotation, in bit times */
+    uint64_t rotation_sum;
+    uint64_t rotation_max;
+    unsigned long rotation_count;
+    /* Poll For Master frames and the silence after them, in bit times */
+    uint64_t pfm_bits;
+    /* messages delivered by MSTP_Put_Receive() */
+    unsigned long delivered;
+    uint64_t delivered_octets;
+    unsigned long completed;
+    uint64_t latency_sum;
+    uint32_t latency[MSTPSIM_LATENCY_MAX + 1];
+    unsigned long dropped;
+    unsigned long lost_tokens;
+    unsigned long collision_octets;
+    unsigned long noise_octets;
+};
+
+static struct mstpsim_node Nodes[MSTPSIM_NODES_MAX];
+static unsigned Node_Count;
+/* a node that receives every octet on the bus */
+static struct mstpsim_node Monitor;
+static struct mstpsim_stats Stats;
+/* simulated time, in bit times since the start of the run */
+static uint64_t Bit_Time;
+static uint64_t Warmup_Bits;
+static bool Measure;
+/* bit time at the end of the last Poll For Master frame */
+static uint64_t PFM_End;
+/* bit time of the last token frame from each MAC address */
+static uint64_t Token_Time[256];
+/* configuration */
+static unsigned Masters = 32;
+static unsigned Slaves = 0;
+static unsigned Max_Master = DEFAULT_MAX_MASTER;
+static unsigned Poll_Interval_Max = 0;
+static unsigned long Baud = 38400;
+static double Rate = 1.0;
+static unsigned Reply_Percent = 50;
+static unsigned Reply_Delay = 5;
+static unsigned Latency = 0;
+static unsigned Data_Size = 50;
+static double Bit_Error_Rate = 0.0;
+static double Collision_Rate = 0.0;
+static unsigned Duration = 60;
+static unsigned Warmup = 10;
+static unsigned long Seed = 1;
+static uint32_t Random_State = 1;
+
+/**
+ * @brief Pseudo random number, the same on every platform for a seed
+ * @return random number
+ */
+static uint32_t mstpsim_random(void)
+{
+    uint32_t x = Random_State;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    Random_State = x;
+
+    return x;
+}
+
+/**
+ * @brief Pseudo random number from 0.0 up to 1.0
+ * @return random number
+ */
+static double mstpsim_random_unit(void)
+{
+    return (double)(mstpsim_random() >> 8) / 16777216.0;
+}
+
+/**
+ * @brief Convert milliseconds to bit times at the baud rate
+ * @param milliseconds - time to convert
+ * @return bit times
+ */
+static uint64_t mstpsim_bits(uint64_t milliseconds)
+{
+    return (milliseconds * Baud) / 1000;
+}
+
+/**
+ * @brief Convert bit times at the baud rate to milliseconds
+ * @param bits - bit times to convert
+ * @return milliseconds
+ */
+static double mstpsim_milliseconds(uint64_t bits)
+{
+    return ((double)bits * 1000.0) / (double)Baud;
+}
+
+static uint32_t mstpsim_silence_timer(void *pArg)
+{
+    struct mstp_port_struct_t *mstp_port = pArg;
+    struct mstpsim_node *node = mstp_port->UserData;
+
+    return (uint32_t)(((Bit_Time - node->silence_start) * 1000) / Baud);
+}
+
+static void mstpsim_silence_timer_reset(void *pArg)
+{
+    struct mstp_port_struct_t *mstp_port = pArg;
+    struct mstpsim_node *node = mstp_port->UserData;
+
+    node->silence_start = Bit_Time;
+}
+
+/**
+ * @brief Build a data frame in the output buffer of a node.  The data
+ *  holds the time the message was queued, to measure the latency.
+ * @param node - node sending the frame
+ * @param frame_type - BACnet Data Expecting or Not Expecting Reply
+ * @param destination - MAC address of the destination
+ * @param kind - request or reply
+ * @param queued - bit time when the request was queued
+ * @return number of octets in the frame
+ */
+static uint16_t mstpsim_frame_create(struct mstpsim_node *node,
+    uint8_t frame_type,
+    uint8_t destination,
+    enum mstpsim_kind kind,
+    uint64_t queued)
+{
+    uint8_t data[MSTPSIM_DATA_MAX] = { 0 };
+    unsigned i;
+
+    data[0] = BACNET_PROTOCOL_VERSION;
+    if (frame_type == FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY) {
+        /* NPDU control: data expecting reply */
+        data[1] = 0x04;
+    }
+    data[2] = (uint8_t)kind;
+    for (i = 0; i < 8; i++) {
+        data[3 + i] = (uint8_t)(queued >> (56 - (8 * i)));
+    }
+
+    return MSTP_Create_Frame(node->port.OutputBuffer,
+        node->port.OutputBufferSize, frame_type, destination,
+        node->port.This_Station, data, (uint16_t)Data_Size);
+}
+
+/**
+ * @brief Take a received data frame, and queue the reply if the
+ *  frame expects one
+ * @param mstp_port - port that received the frame
+ * @return number of octets of data
+ */
+uint16_t MSTP_Put_Receive(volatile struct mstp_port_struct_t *mstp_port)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+    uint64_t queued = 0;
+    uint64_t latency;
+    unsigned i;
+
+    if (mstp_port->DataLength < MSTPSIM_DATA_MIN) {
+        return 0;
+    }
+    for (i = 0; i < 8; i++) {
+        queued = (queued << 8) | mstp_port->InputBuffer[3 + i];
+    }
+    if (mstp_port->FrameType == FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY) {
+        node->reply_pending = true;
+        node->reply_destination = mstp_port->SourceAddress;
+        node->reply_ready = Bit_Time + mstpsim_bits(Reply_Delay);
+        node->reply_queued = queued;
+    }
+    if (Measure) {
+        Stats.delivered++;
+        Stats.delivered_octets += mstp_port->DataLength;
+    }
+    if ((mstp_port->FrameType == FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY) &&
+        (queued >= Warmup_Bits)) {
+        /* a reply, or a request that does not expect one */
+        latency = (uint64_t)mstpsim_milliseconds(Bit_Time - queued);
+        if (latency > MSTPSIM_LATENCY_MAX) {
+            latency = MSTPSIM_LATENCY_MAX;
+        }
+        Stats.completed++;
+        Stats.latency_sum += Bit_Time - queued;
+        Stats.latency[latency]++;
+    }
+
+    return mstp_port->DataLength;
+}
+
+/**
+ * @brief Get the next frame to send when the node has the token:
+ *  a postponed reply, or the next queued request.
+ * @param mstp_port - port with the token
+ * @param timeout - not used
+ * @return number of octets in the frame, or zero if none
+ */
+uint16_t MSTP_Get_Send(
+    volatile struct mstp_port_struct_t *mstp_port, unsigned timeout)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+    struct mstpsim_message *message;
+    uint8_t frame_type;
+
+    (void)timeout;
+    if (node->reply_pending && (Bit_Time >= node->reply_ready)) {
+        node->reply_pending = false;
+        return mstpsim_frame_create(node,
+            FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY,
+            node->reply_destination, MSTPSIM_REPLY, node->reply_queued);
+    }
+    if (node->queue_count == 0) {
+        return 0;
+    }
+    message = &node->queue[node->queue_head];
+    node->queue_head = (node->queue_head + 1) % MSTPSIM_QUEUE_SIZE;
+    node->queue_count--;
+    if (message->expecting_reply) {
+        frame_type = FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY;
+    } else {
+        frame_type = FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY;
+    }
+
+    return mstpsim_frame_create(node, frame_type, message->destination,
+        MSTPSIM_REQUEST, message->queued);
+}
+
+/**
+ * @brief Get the reply to the Data Expecting Reply frame just received,
+ *  if the reply delay has passed
+ * @param mstp_port - port that received the request
+ * @param timeout - not used
+ * @return number of octets in the frame, or zero if none
+ */
+uint16_t MSTP_Get_Reply(
+    volatile struct mstp_port_struct_t *mstp_port, unsigned timeout)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+
+    (void)timeout;
+    if (!node->reply_pending || (Bit_Time < node->reply_ready) ||
+        (node->reply_destination != mstp_port->SourceAddress)) {
+        return 0;
+    }
+    node->reply_pending = false;
+
+    return mstpsim_frame_create(node,
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, node->reply_destination,
+        MSTPSIM_REPLY, node->reply_queued);
+}
+
+/**
+ * @brief Put a frame on the bus after the turnaround time and the
+ *  latency of the node.  The node state machine waits until the last
+ *  octet is sent, as it would for a blocking serial port write.
+ * @param mstp_port - port sending the frame
+ * @param buffer - frame to send
+ * @param nbytes - number of octets in the frame
+ */
+void MSTP_Send_Frame(volatile struct mstp_port_struct_t *mstp_port,
+    uint8_t *buffer,
+    uint16_t nbytes)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+    uint64_t start;
+
+    if ((nbytes == 0) || (nbytes > sizeof(node->tx_buffer))) {
+        return;
+    }
+    memcpy(node->tx_buffer, buffer, nbytes);
+    node->tx_length = nbytes;
+    node->tx_index = 0;
+    start = node->silence_start + Tturnaround;
+    if (start < Bit_Time) {
+        start = Bit_Time;
+    }
+    if (Latency) {
+        start += mstpsim_random() % (mstpsim_bits(Latency) + 1);
+    }
+    node->tx_start = start;
+    node->tx_collision_start = 0;
+    node->tx_collision_end = 0;
+    if ((Collision_Rate > 0.0) && (mstpsim_random_unit() < Collision_Rate)) {
+        node->tx_collision_start = mstpsim_random() % nbytes;
+        node->tx_collision_end =
+            node->tx_collision_start + 1 + (mstpsim_random() % 4);
+    }
+}
+
+/**
+ * @brief Count a frame seen by the monitor
+ * @param mstp_port - port of the monitor
+ */
+static void mstpsim_monitor_frame(struct mstp_port_struct_t *mstp_port)
+{
+    uint8_t source = mstp_port->SourceAddress;
+
+    if (mstp_port->ReceivedInvalidFrame) {
+        if (Measure) {
+            Stats.invalid_frames++;
+        }
+        return;
+    }
+    switch (mstp_port->FrameType) {
+        case FRAME_TYPE_TOKEN:
+            if (Measure) {
+                Stats.tokens++;
+                if (Token_Time[source]) {
+                    uint64_t rotation = Bit_Time - Token_Time[source];
+                    Stats.rotation_sum += rotation;
+                    Stats.rotation_count++;
+                    if (rotation > Stats.rotation_max) {
+                        Stats.rotation_max = rotation;
+                    }
+                }
+            }
+            Token_Time[source] = Bit_Time;
+            break;
+        case FRAME_TYPE_POLL_FOR_MASTER:
+            if (Measure) {
+                Stats.pfm++;
+                Stats.pfm_bits += 8 * MSTPSIM_OCTET_BITS;
+            }
+            PFM_End = Bit_Time;
+            break;
+        case FRAME_TYPE_REPLY_TO_POLL_FOR_MASTER:
+            if (Measure) {
+                Stats.reply_pfm++;
+            }
+            break;
+        case FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY:
+        case FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY:
+            if (Measure) {
+                Stats.data_frames++;
+            }
+            break;
+        case FRAME_TYPE_REPLY_POSTPONED:
+            if (Measure) {
+                Stats.reply_postponed++;
+            }
+            break;
+        default:
+            if (Measure) {
+                Stats.other_frames++;
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Give an octet, or a framing error, to the receive state machine
+ * @param node - node that receives the octet
+ * @param octet - octet on the bus
+ * @param error - true if the octet has a framing error or collided
+ */
+static void mstpsim_node_receive(
+    struct mstpsim_node *node, uint8_t octet, bool error)
+{
+    if (error) {
+        node->port.ReceiveError = true;
+    } else {
+        node->port.DataRegister = octet;
+        node->port.DataAvailable = true;
+    }
+    MSTP_Receive_Frame_FSM(&node->port);
+}
+
+/**
+ * @brief Move one octet time on the bus: each node that is transmitting
+ *  sends an octet, and every other node receives what is on the bus.
+ */
+static void mstpsim_bus_octet(void)
+{
+    struct mstpsim_node *node;
+    unsigned drivers = 0;
+    uint8_t octet = 0;
+    bool error = false;
+    unsigned bit;
+    unsigned i;
+
+    for (i = 0; i < Node_Count; i++) {
+        node = &Nodes[i];
+        if (node->tx_length && (Bit_Time >= node->tx_start)) {
+            drivers++;
+            octet = node->tx_buffer[node->tx_index];
+            if ((node->tx_index >= node->tx_collision_start) &&
+                (node->tx_index < node->tx_collision_end)) {
+                /* another driver is on the bus */
+                drivers++;
+            }
+        }
+    }
+    if (drivers == 0) {
+        return;
+    }
+    if (drivers > 1) {
+        error = true;
+        if (Measure) {
+            Stats.collision_octets++;
+        }
+    } else if ((Bit_Error_Rate > 0.0) &&
+        (mstpsim_random_unit() < (Bit_Error_Rate * MSTPSIM_OCTET_BITS))) {
+        bit = mstpsim_random() % MSTPSIM_OCTET_BITS;
+        if (bit < 8) {
+            octet ^= (uint8_t)(1 << bit);
+        } else {
+            /* start or stop bit */
+            error = true;
+        }
+        if (Measure) {
+            Stats.noise_octets++;
+        }
+    }
+    if (Measure) {
+        Stats.busy_bits += MSTPSIM_OCTET_BITS;
+        if (PFM_End) {
+            /* silence after a Poll For Master */
+            Stats.pfm_bits += Bit_Time - MSTPSIM_OCTET_BITS - PFM_End;
+        }
+    }
+    PFM_End = 0;
+    for (i = 0; i < Node_Count; i++) {
+        node = &Nodes[i];
+        if (node->tx_length && (Bit_Time >= node->tx_start)) {
+            /* the transmitter does not hear the bus */
+            node->tx_index++;
+            node->silence_start = Bit_Time;
+            if (node->tx_index >= node->tx_length) {
+                node->tx_length = 0;
+            }
+        } else {
+            mstpsim_node_receive(node, octet, error);
+        }
+    }
+    mstpsim_node_receive(&Monitor, octet, error);
+    if (Monitor.port.ReceivedValidFrame ||
+        Monitor.port.ReceivedValidFrameNotForUs ||
+        Monitor.port.ReceivedInvalidFrame) {
+        mstpsim_monitor_frame(&Monitor.port);
+        Monitor.port.ReceivedValidFrame = false;
+        Monitor.port.ReceivedValidFrameNotForUs = false;
+        Monitor.port.ReceivedInvalidFrame = false;
+    }
+}
+
+/**
+ * @brief Queue requests from a master at the configured rate, to a
+ *  random other node
+ * @param index - index of the master in the nodes
+ */
+static void mstpsim_traffic(unsigned index)
+{
+    struct mstpsim_node *node = &Nodes[index];
+    struct mstpsim_message *message;
+    unsigned destination;
+    double interval;
+
+    if (Bit_Time < node->next_request) {
+        return;
+    }
+    /* exponential, so the requests arrive as a Poisson process */
+    interval = -log(1.0 - mstpsim_random_unit()) * ((double)Baud / Rate);
+    node->next_request += (uint64_t)interval + 1;
+    if (node->queue_count >= MSTPSIM_QUEUE_SIZE) {
+        if (Measure) {
+            Stats.dropped++;
+        }
+        return;
+    }
+    destination = mstpsim_random() % (Node_Count - 1);
+    if (destination >= index) {
+        destination++;
+    }
+    message = &node->queue[(node->queue_head + node->queue_count) %
+        MSTPSIM_QUEUE_SIZE];
+    message->destination = Nodes[destination].port.This_Station;
+    message->expecting_reply = (mstpsim_random() % 100) < Reply_Percent;
+    message->queued = Bit_Time;
+    node->queue_count++;
+}
+
+/**
+ * @brief Run the node state machines for one octet time
+ */
+static void mstpsim_nodes_task(void)
+{
+    struct mstpsim_node *node;
+    MSTP_MASTER_STATE master_state;
+    unsigned i;
+
+    for (i = 0; i < Node_Count; i++) {
+        node = &Nodes[i];
+        if (node->master && (Rate > 0.0)) {
+            mstpsim_traffic(i);
+        }
+        if (node->tx_length) {
+            /* waiting for the frame to be sent */
+            continue;
+        }
+        /* frame abort timeouts */
+        MSTP_Receive_Frame_FSM(&node->port);
+        if (node->master) {
+            master_state = node->port.master_state;
+            while (MSTP_Master_Node_FSM(&node->port)) {
+                if (node->tx_length) {
+                    break;
+                }
+            }
+            if (Measure && (master_state != node->port.master_state) &&
+                (node->port.master_state == MSTP_MASTER_STATE_NO_TOKEN)) {
+                Stats.lost_tokens++;
+            }
+        } else {
+            /* the slave node state machine keeps the frame to compare
+               with the reply, so pass it up once, as a slave port does */
+            if (node->port.ReceivedValidFrame && !node->frame_taken &&
+                ((node->port.FrameType ==
+                     FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY) ||
+                    (node->port.FrameType ==
+                        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY))) {
+                (void)MSTP_Put_Receive(&node->port);
+                node->frame_taken = true;
+            }
+            MSTP_Slave_Node_FSM(&node->port);
+            if (!node->port.ReceivedValidFrame) {
+                node->frame_taken = false;
+            }
+        }
+        node->port.ReceivedValidFrameNotForUs = false;
+    }
+}
+
+/**
+ * @brief Initialize a node and its port
+ * @param node - node to initialize
+ * @param mac - MAC address of the node
+ * @param master - true for a master node
+ * @param max_info_frames - Max_Info_Frames of the node
+ */
+static void mstpsim_node_init(struct mstpsim_node *node,
+    uint8_t mac,
+    bool master,
+    uint8_t max_info_frames)
+{
+    memset(node, 0, sizeof(*node));
+    node->master = master;
+    node->port.InputBuffer = node->input_buffer;
+    node->port.InputBufferSize = sizeof(node->input_buffer);
+    node->port.OutputBuffer = node->output_buffer;
+    node->port.OutputBufferSize = sizeof(node->output_buffer);
+    node->port.SilenceTimer = mstpsim_silence_timer;
+    node->port.SilenceTimerReset = mstpsim_silence_timer_reset;
+    node->port.UserData = node;
+    node->port.This_Station = mac;
+    node->port.Nmax_info_frames = max_info_frames;
+    node->port.Nmax_master = (uint8_t)Max_Master;
+    node->port.Npoll_max = Poll_Interval_Max;
+    MSTP_Init(&node->port);
+    if (master) {
+        node->next_request =
+            (uint64_t)(((double)Baud / Rate) * mstpsim_random_unit());
+    }
+}
+
+/**
+ * @brief Simulate the bus with one Max_Info_Frames value for all masters
+ * @param max_info_frames - Max_Info_Frames of the masters
+ */
+static void mstpsim_run(uint8_t max_info_frames)
+{
+    uint64_t end;
+    unsigned i;
+
+    Random_State = (uint32_t)Seed ? (uint32_t)Seed : 1;
+    Bit_Time = 0;
+    PFM_End = 0;
+    Measure = false;
+    memset(&Stats, 0, sizeof(Stats));
+    memset(Token_Time, 0, sizeof(Token_Time));
+    Node_Count = Masters + Slaves;
+    for (i = 0; i < Masters; i++) {
+        mstpsim_node_init(&Nodes[i], (uint8_t)i, true, max_info_frames);
+    }
+    for (i = 0; i < Slaves; i++) {
+        mstpsim_node_init(&Nodes[Masters + i],
+            (uint8_t)(MSTPSIM_SLAVE_MAC + i), false, max_info_frames);
+    }
+    mstpsim_node_init(&Monitor, MSTP_BROADCAST_ADDRESS, false, 1);
+    Warmup_Bits = mstpsim_bits((uint64_t)Warmup * 1000);
+    end = Warmup_Bits + mstpsim_bits((uint64_t)Duration * 1000);
+    while (Bit_Time < end) {
+        Bit_Time += MSTPSIM_OCTET_BITS;
+        if (!Measure && (Bit_Time >= Warmup_Bits)) {
+            Measure = true;
+        }
+        if (Measure) {
+            Stats.bits += MSTPSIM_OCTET_BITS;
+        }
+        mstpsim_bus_octet();
+        mstpsim_nodes_task();
+    }
+}
+
+/**
+ * @brief Latency below which the given percent of the messages completed
+ * @param percent - 0..100
+ * @return latency in milliseconds
+ */
+static unsigned mstpsim_latency_percentile(unsigned percent)
+{
+    unsigned long target;
+    unsigned long count = 0;
+    unsigned i;
+
+    if (Stats.completed == 0) {
+        return 0;
+    }
+    target = (Stats.completed * percent + 99) / 100;
+    for (i = 0; i <= MSTPSIM_LATENCY_MAX; i++) {
+        count += Stats.latency[i];
+        if (count >= target) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+static void mstpsim_report_header(void)
+{
+    printf("%8s %8s %8s %6s %6s %8s %9s %7s %7s %7s %7s %8s\n", "max-info",
+        "rot-ms", "rot-max", "pfm%", "busy%", "frames/s", "octets/s",
+        "lat-ms", "p50-ms", "p99-ms", "error%", "no-token");
+}
+
+static void mstpsim_report(uint8_t max_info_frames)
+{
+    double seconds = (double)Stats.bits / (double)Baud;
+    unsigned long frames;
+    double rotation = 0.0;
+    double latency = 0.0;
+    double error_rate = 0.0;
+
+    frames = Stats.tokens + Stats.pfm + Stats.reply_pfm + Stats.data_frames +
+        Stats.reply_postponed + Stats.other_frames;
+    if (Stats.rotation_count) {
+        rotation = mstpsim_milliseconds(Stats.rotation_sum) /
+            (double)Stats.rotation_count;
+    }
+    if (Stats.completed) {
+        latency = mstpsim_milliseconds(Stats.latency_sum) /
+            (double)Stats.completed;
+    }
+    if (frames + Stats.invalid_frames) {
+        error_rate = (100.0 * (double)Stats.invalid_frames) /
+            (double)(frames + Stats.invalid_frames);
+    }
+    printf("%8u %8.1f %8.1f %6.2f %6.2f %8.1f %9.0f %7.1f %7u %7u %7.3f "
+           "%6lu\n",
+        (unsigned)max_info_frames, rotation,
+        mstpsim_milliseconds(Stats.rotation_max),
+        (100.0 * (double)Stats.pfm_bits) / (double)Stats.bits,
+        (100.0 * (double)Stats.busy_bits) / (double)Stats.bits,
+        (double)Stats.delivered / seconds,
+        (double)Stats.delivered_octets / seconds, latency,
+        mstpsim_latency_percentile(50), mstpsim_latency_percentile(99),
+        error_rate, Stats.lost_tokens);
+}
+
+static void mstpsim_report_detail(void)
+{
+    printf("         tokens=%lu pfm=%lu reply-pfm=%lu data=%lu "
+           "postponed=%lu invalid=%lu\n",
+        Stats.tokens, Stats.pfm, Stats.reply_pfm, Stats.data_frames,
+        Stats.reply_postponed, Stats.invalid_frames);
+    printf("         completed=%lu dropped=%lu collision-octets=%lu "
+           "noise-octets=%lu\n",
+        Stats.completed, Stats.dropped, Stats.collision_octets,
+        Stats.noise_octets);
+}
+
+static void print_usage(const char *filename)
+{
+    printf("Usage: %s [--masters N][--slaves N][--max-master N]\n", filename);
+    printf("       [--max-info-frames N[,N...]][--poll-interval-max N]\n");
+    printf("       [--baud N][--rate N]\n");
+    printf("       [--reply N][--reply-delay N][--latency N][--size N]\n");
+    printf("       [--ber N][--collisions N][--duration N][--warmup N]\n");
+    printf("       [--seed N][--verbose][--version][--help]\n");
+}
+
+static void print_help(const char *filename)
+{
+    printf("Simulate MS/TP master and slave nodes on a virtual RS-485 bus\n"
+           "and report, for each Max_Info_Frames value, the token rotation\n"
+           "time, the percent of the bus used by Poll For Master frames\n"
+           "and the silence after them, the bus utilization, the data\n"
+           "frames and octets delivered per second, the latency from a\n"
+           "request being queued to its reply or delivery, the percent of\n"
+           "invalid frames, and how many times a master found the token lost\n"
+           "and entered the NO_TOKEN state.\n");
+    printf("\n");
+    printf("--masters N:\n"
+           "Number of master nodes, at MAC addresses 0..N-1. Default 32.\n");
+    printf("--slaves N:\n"
+           "Number of slave nodes, at MAC addresses %u and up. Default 0.\n",
+        MSTPSIM_SLAVE_MAC);
+    printf("--max-master N:\n"
+           "Max_Master of every master node, 1..127. Default 127.\n");
+    printf("--max-info-frames N[,N...]:\n"
+           "Max_Info_Frames of every master node, 1..255. One run is made\n"
+           "for each value. Default 1.\n");
+    printf("--poll-interval-max N:\n"
+           "Largest number of tokens between maintenance Poll For Master\n"
+           "frames while no new master is found. The interval doubles\n"
+           "from 50 up to N. Default 0, a poll every 50 tokens.\n");
+    printf("--baud N:\n"
+           "Baud rate of the bus. Default 38400.\n");
+    printf("--rate N:\n"
+           "Mean requests queued per second by each master, as a Poisson\n"
+           "process. Default 1.\n");
+    printf("--reply N:\n"
+           "Percent of the requests that expect a reply. Default 50.\n");
+    printf("--reply-delay N:\n"
+           "Milliseconds a node takes to prepare a reply. Default 5.\n");
+    printf("--latency N:\n"
+           "Largest random delay in milliseconds before a node starts\n"
+           "to transmit, after the turnaround time. Default 0.\n");
+    printf("--size N:\n"
+           "Data octets in each data frame, %u..%u. Default 50.\n",
+        MSTPSIM_DATA_MIN, MSTPSIM_DATA_MAX);
+    printf("--ber N:\n"
+           "Bit error rate of the bus, such as 1e-5. Default 0.\n");
+    printf("--collisions N:\n"
+           "Probability that another driver collides with a frame,\n"
+           "such as 0.001. Default 0.\n");
+    printf("--duration N:\n"
+           "Seconds of bus time to measure. Default 60.\n");
+    printf("--warmup N:\n"
+           "Seconds of bus time before measuring, while the masters\n"
+           "find each other. Default 10.\n");
+    printf("--seed N:\n"
+           "Seed of the traffic, latency, noise and collisions.\n");
+    printf("--verbose:\n"
+           "Print the frame counts of each run.\n");
+    printf("\n");
+    printf("Example:\n"
+           "%s --masters 64 --max-master 63 --max-info-frames 1,2,4,8\n",
+        filename);
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t max_info_frames[16] = { DEFAULT_MAX_INFO_FRAMES };
+    unsigned max_info_frames_count = 1;
+    unsigned long value;
+    bool verbose = false;
+    char *text;
+    char *token;
+    int argi = 0;
+    unsigned i;
+    const char *filename = NULL;
+
+    filename = filename_remove_path(argv[0]);
+    for (argi = 1; argi < argc; argi++) {
+        if (strcmp(argv[argi], "--help") == 0) {
+            print_usage(filename);
+            print_help(filename);
+            return 0;
+        }
+        if (strcmp(argv[argi], "--version") == 0) {
+            printf("%s %s\n", filename, BACNET_VERSION_TEXT);
+            printf("Copyright (C) 2026 by the BACnet Stack contributors.\n"
+                   "This is free software; see the source for copying "
+                   "conditions.\n"
+                   "There is NO warranty; not even for MERCHANTABILITY or\n"
+                   "FITNESS FOR A PARTICULAR PURPOSE.\n");
+            return 0;
+        }
+        if (strcmp(argv[argi], "--verbose") == 0) {
+            verbose = true;
+            continue;
+        }
+        if ((argi + 1) >= argc) {
+            print_usage(filename);
+            return 1;
+        }
+        if (strcmp(argv[argi], "--masters") == 0) {
+            Masters = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--slaves") == 0) {
+            Slaves = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--max-master") == 0) {
+            Max_Master = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--poll-interval-max") == 0) {
+            Poll_Interval_Max = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--max-info-frames") == 0) {
+            max_info_frames_count = 0;
+            text = argv[++argi];
+            for (token = strtok(text, ","); token; token = strtok(NULL, ",")) {
+                value = strtoul(token, NULL, 0);
+                if ((value < 1) || (value > 255) ||
+                    (max_info_frames_count >= sizeof(max_info_frames))) {
+                    print_usage(filename);
+                    return 1;
+                }
+                max_info_frames[max_info_frames_count++] = (uint8_t)value;
+            }
+        } else if (strcmp(argv[argi], "--baud") == 0) {
+            Baud = strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--rate") == 0) {
+            Rate = strtod(argv[++argi], NULL);
+        } else if (strcmp(argv[argi], "--reply") == 0) {
+            Reply_Percent = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--reply-delay") == 0) {
+            Reply_Delay = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--latency") == 0) {
+            Latency = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--size") == 0) {
+            Data_Size = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--ber") == 0) {
+            Bit_Error_Rate = strtod(argv[++argi], NULL);
+        } else if (strcmp(argv[argi], "--collisions") == 0) {
+            Collision_Rate = strtod(argv[++argi], NULL);
+        } else if (strcmp(argv[argi], "--duration") == 0) {
+            Duration = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--warmup") == 0) {
+            Warmup = (unsigned)strtoul(argv[++argi], NULL, 0);
+        } else if (strcmp(argv[argi], "--seed") == 0) {
+            Seed = strtoul(argv[++argi], NULL, 0);
+        } else {
+            print_usage(filename);
+            return 1;
+        }
+    }
+    if ((Masters < 1) || (Max_Master < 1) || (Max_Master > 127) ||
+        (Masters > (Max_Master + 1)) ||
+        (Slaves > (MSTPSIM_NODES_MAX - MSTPSIM_SLAVE_MAC)) ||
+        ((Masters + Slaves) < 2) || (max_info_frames_count == 0) ||
+        (Baud < 1200) || (Rate < 0.0) || (Reply_Percent > 100) ||
+        (Data_Size < MSTPSIM_DATA_MIN) || (Data_Size > MSTPSIM_DATA_MAX) ||
+        (Bit_Error_Rate < 0.0) || (Collision_Rate < 0.0) ||
+        (Duration == 0)) {
+        print_usage(filename);
+        return 1;
+    }
+    printf("mstpsim: %u masters, %u slaves, Max_Master %u, %lu baud, "
+           "%.2f requests/s per master, %u octets, %u%% expecting reply\n",
+        Masters, Slaves, Max_Master, Baud, Rate, Data_Size, Reply_Percent);
+    mstpsim_report_header();
+    for (i = 0; i < max_info_frames_count; i++) {
+        mstpsim_run(max_info_frames[i]);
+        mstpsim_report(max_info_frames[i]);
+        if (verbose) {
+            mstpsim_report_detail();
+        }
+    }
+
+    return 0;
+}
@@ -52,14 +52,13 @@
 #include "bacnet/version.h"
 /* some demo stuff needed */
 #include "bacnet/rpm.h"
+#include "bacnet/rpm_json.h"
 #include "bacnet/basic/sys/filename.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/datalink/dlenv.h"
 
-#include "cJSON.h"
-
 /* buffer used for receive */
 static uint8_t Rx_Buf[MAX_MPDU] = { 0 };
 
@@ -110,151 +109,22 @@ static void MyRejectHandler(
     }
 }
 
-static cJSON *bacapp_json_value(BACNET_OBJECT_PROPERTY_VALUE *object_value)
+/**
+ * @brief Write a piece of the JSON text to a stream
+ * @param context [in] the stream
+ * @param text [in] text to write
+ * @param text_len [in] number of bytes of text
+ * @return true if the text was written
+ */
+static bool json_stream_write(void *context, const char *text, size_t text_len)
 {
-    BACNET_APPLICATION_DATA_VALUE *value = NULL;
-    char str_val[1024];
-    cJSON *json_val;
-
-    if (object_value && object_value->value) {
-        value = object_value->value;
-        switch (value->tag) {
-#if defined(BACAPP_NULL)
-            case BACNET_APPLICATION_TAG_NULL:
-                json_val = cJSON_CreateNull();
-                break;
-#endif
-#if defined(BACAPP_BOOLEAN)
-            case BACNET_APPLICATION_TAG_BOOLEAN:
-                json_val = (value->type.Boolean)
-                    ? cJSON_CreateTrue()
-                    : cJSON_CreateFalse();
-                break;
-#endif
-#if defined(BACAPP_UNSIGNED)
-            case BACNET_APPLICATION_TAG_UNSIGNED_INT:
-                json_val = cJSON_CreateNumber(
-                    (unsigned long) value->type.Unsigned_Int);
-                break;
-#endif
-#if defined(BACAPP_SIGNED)
-            case BACNET_APPLICATION_TAG_SIGNED_INT:
-                json_val = cJSON_CreateNumber((long) value->type.Signed_Int);
-                break;
-#endif
-#if defined(BACAPP_REAL)
-            case BACNET_APPLICATION_TAG_REAL:
-                json_val = cJSON_CreateNumber((double) value->type.Real);
-                break;
-#endif
-#if defined(BACAPP_DOUBLE)
-            case BACNET_APPLICATION_TAG_DOUBLE:
-                json_val = cJSON_CreateNumber(value->type.Double);
-                break;
-#endif
-            default:
-                // Else we create a string object
-                bacapp_snprintf_value(str_val, sizeof(str_val), object_value);
-                json_val = cJSON_CreateString(str_val);
-        }
-    }
-
-    return json_val;
-}
-
-static void my_rpm_ack_items_to_json(
-    BACNET_READ_ACCESS_DATA *rpm_data, cJSON *json)
-{
-    BACNET_OBJECT_PROPERTY_VALUE object_value; /* for bacapp printing */
-    BACNET_PROPERTY_REFERENCE *listOfProperties = NULL;
-    BACNET_APPLICATION_DATA_VALUE *value = NULL;
-    char json_name[1024];
-    bool array_value = false;
-    cJSON *json_val;
-    cJSON *json_val_array;
-
-    if (rpm_data) {
-        listOfProperties = rpm_data->listOfProperties;
-        while (listOfProperties) {
-            value = listOfProperties->value;
-            if (value) {
-                const char *bacnet_type_name = 
-                    bactext_object_type_name(rpm_data->object_type);
-                unsigned long object_instance =
-                    (unsigned long)rpm_data->object_instance;
-                unsigned int property =
-                    listOfProperties->propertyIdentifier;
-                
-                if (property < 512) {
-                    const char *property_name = bactext_property_name(property);
-                    snprintf(json_name, sizeof(json_name), "%s_%lu_%s",
-                             bacnet_type_name, object_instance, property_name);
-                } else {
-                    snprintf(json_name, sizeof(json_name), "%s_%lu_%u",
-                             bacnet_type_name, object_instance, property);
-                }
-
-                BACNET_ARRAY_INDEX propertyArrayIndex =
-                    listOfProperties->propertyArrayIndex;
-                if (propertyArrayIndex != BACNET_ARRAY_ALL) {
-                    char array_index[32];
-                    snprintf(array_index, sizeof(array_index), "[%d]",
-                             propertyArrayIndex);
-
-                    if ((sizeof(json_name) - strlen(json_name)) > strlen(array_index)) {
-                        strcat(json_name, array_index);
-                    }
-                }
-
-                if (value->next) {
-                    json_val_array = cJSON_CreateArray();
-                    array_value = true;
-                } else {
-                    array_value = false;
-                }
-
-                object_value.object_type = rpm_data->object_type;
-                object_value.object_instance = rpm_data->object_instance;
-
-                while (value) {
-                    object_value.object_property =
-                        listOfProperties->propertyIdentifier;
-                    object_value.array_index =
-                        listOfProperties->propertyArrayIndex;
-                    object_value.value = value;
-
-                    json_val = bacapp_json_value(&object_value);
-
-                    if (array_value) {
-                        cJSON_AddItemToArray(json_val_array, json_val);
-                    }
-
-                    value = value->next;
-                }
-
-                if (array_value) {
-                    cJSON_AddItemToObject(json, json_name, json_val_array);
-                } else {
-                    cJSON_AddItemToObject(json, json_name, json_val);
-                }
-            } else {
-                /* AccessError */
-                fprintf(stderr, "BACnet Error: %s: %s\n",
-                    bactext_error_class_name(
-                        (int)listOfProperties->error.error_class),
-                    bactext_error_code_name(
-                        (int)listOfProperties->error.error_code));
-            }
-
-            listOfProperties = listOfProperties->next;
-        }
-    }
+    return fwrite(text, 1, text_len, (FILE *)context) == text_len;
 }
 
 /** Handler for a ReadPropertyMultiple ACK.
  * @ingroup DSRPM
- * For each read property, print out the ACK'd data,
- * and free the request data items from linked property list.
+ * For each read property, print out the ACK'd data as JSON,
+ * streamed directly from the service data.
  *
  * @param service_request [in] The contents of the service request.
  * @param service_len [in] The length of the service_request.
@@ -267,72 +137,18 @@ static void My_Read_Property_Multiple_Ack_Handler(uint8_t *service_request,
     BACNET_ADDRESS *src,
     BACNET_CONFIRMED_SERVICE_ACK_DATA *service_data)
 {
+    BACNET_RPM_JSON_WRITER writer;
     int len = 0;
-    BACNET_READ_ACCESS_DATA *rpm_data;
-    BACNET_READ_ACCESS_DATA *old_rpm_data;
-    BACNET_PROPERTY_REFERENCE *rpm_property;
-    BACNET_PROPERTY_REFERENCE *old_rpm_property;
-    BACNET_APPLICATION_DATA_VALUE *value;
-    BACNET_APPLICATION_DATA_VALUE *old_value;
 
     if (address_match(&Target_Address, src) &&
         (service_data->invoke_id == Request_Invoke_ID)) {
-        rpm_data = calloc(1, sizeof(BACNET_READ_ACCESS_DATA));
-        if (rpm_data) {
-            len = rpm_ack_decode_service_request(
-                service_request, service_len, rpm_data);
-        }
-        
-        if (len > 0) {
-            cJSON *json = cJSON_CreateObject();
-
-            while (rpm_data) {
-                my_rpm_ack_items_to_json(rpm_data, json);
-                rpm_property = rpm_data->listOfProperties;
-                while (rpm_property) {
-                    value = rpm_property->value;
-                    while (value) {
-                        old_value = value;
-                        value = value->next;
-                        free(old_value);
-                    }
-                    old_rpm_property = rpm_property;
-                    rpm_property = rpm_property->next;
-                    free(old_rpm_property);
-                }
-                old_rpm_data = rpm_data;
-                rpm_data = rpm_data->next;
-                free(old_rpm_data);
-            }
-
-            // print json
-            char *json_string = cJSON_Print(json);
-            if (json_string == NULL) {
-                fprintf(stderr, "Failed to print JSON.\n");
-            } else {
-                fprintf(stdout, "%s", json_string);
-                free(json_string);
-            }
-            cJSON_Delete(json);
-        } else {
-            fprintf(stderr, "RPM Ack Malformed! Freeing memory...\n");
-            while (rpm_data) {
-                rpm_property = rpm_data->listOfProperties;
-                while (rpm_property) {
-                    value = rpm_property->value;
-                    while (value) {
-                        old_value = value;
-                        value = value->next;
-                        free(old_value);
-                    }
-                    old_rpm_property = rpm_property;
-                    rpm_property = rpm_property->next;
-                    free(old_rpm_property);
-                }
-                old_rpm_data = rpm_data;
-                rpm_data = rpm_data->next;
-                free(old_rpm_data);
-            }
+        rpm_ack_json_init(&writer, json_stream_write, stdout);
+        rpm_ack_json_begin(&writer);
+        len = rpm_ack_json_encode(&writer, service_request, service_len);
+        rpm_ack_json_end(&writer);
+        if (len <= 0) {
+            fprintf(stderr, "RPM Ack Malformed!\n");
+            Error_Detected = true;
         }
     }
 }
@@ -351,6 +351,20 @@ bool read_config(char *filepath)
                 } else {
                     current->params.mstp_params.max_frames = 1;
                 }
+                result = config_setting_lookup_int(
+                    port, "max_frames_limit", (int *)&param);
+                if (result) {
+                    current->params.mstp_params.max_frames_limit = param;
+                } else {
+                    current->params.mstp_params.max_frames_limit = 0;
+                }
+                result = config_setting_lookup_int(
+                    port, "poll_interval_max", (int *)&param);
+                if (result) {
+                    current->params.mstp_params.poll_interval_max = param;
+                } else {
+                    current->params.mstp_params.poll_interval_max = 0;
+                }
                 result = config_setting_lookup_int(port, "baud", (int *)&param);
                 if (result) {
                     current->params.mstp_params.baudrate = param;
@@ -546,6 +560,8 @@ bool parse_cmd(int argc, char *argv[])
                     current->route_info.mac_len = 1;
                     current->params.mstp_params.max_master = 127;
                     current->params.mstp_params.max_frames = 1;
+                    current->params.mstp_params.max_frames_limit = 0;
+                    current->params.mstp_params.poll_interval_max = 0;
                     current->params.mstp_params.baudrate = 9600;
                     current->params.mstp_params.parity = PARITY_NONE;
                     current->params.mstp_params.databits = 8;
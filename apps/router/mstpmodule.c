@@ -92,6 +92,10 @@ void *dl_mstp_thread(void *pArgs)
     dlmstp_set_mac_address(&mstp_port, port->route_info.mac[0]);
     dlmstp_set_max_info_frames(&mstp_port, port->params.mstp_params.max_frames);
     dlmstp_set_max_master(&mstp_port, port->params.mstp_params.max_master);
+    dlmstp_set_max_info_frames_limit(
+        &mstp_port, port->params.mstp_params.max_frames_limit);
+    dlmstp_set_poll_interval_max(
+        &mstp_port, port->params.mstp_params.poll_interval_max);
     if (!dlmstp_init(&mstp_port, port->iface)) {
         printf("MSTP %s init failed. Stop.\n", port->iface);
     }
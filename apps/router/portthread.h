@@ -82,6 +82,8 @@ typedef union _port_params {
         uint8_t stopbits;
         uint8_t max_master;
         uint8_t max_frames;
+        uint8_t max_frames_limit;
+        uint16_t poll_interval_max;
     } mstp_params;
 } PORT_PARAMS;
 
@@ -22,6 +22,7 @@
 #include "bacnet/basic/sys/mstimer.h"
 #include "bacnet/basic/client/bac-task.h"
 #include "bacnet/basic/client/bac-data.h"
+#include "bacnet/basic/client/bac-cov.h"
 #include "bacnet/basic/object/device.h"
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/datalink/dlenv.h"
@@ -37,6 +38,7 @@ static void print_usage(const char *filename)
     PRINTF("Usage: %s [device-instance]\n", filename);
     PRINTF("       [object-type] [object-instance]\n");
     PRINTF("       [--device][--print-seconds]\n");
+    PRINTF("       [--cov][--lifetime seconds]\n");
     PRINTF("       [--version][--help]\n");
 }
 
@@ -75,6 +77,59 @@ static void print_help(const char *filename)
            "%s 123 binary-input 1\n"
            "%s 123 3 1\n",
         filename, filename, filename, filename);
+    PRINTF("\n");
+    PRINTF("--cov:\n"
+           "Subscribe to COV of the Present-Value instead of reading it.\n"
+           "The value is read when the device refuses the subscription.\n");
+    PRINTF("--lifetime:\n"
+           "Lifetime of the COV subscription, in seconds.\n");
+}
+
+/**
+ * @brief Print the latest value of a COV client subscription
+ * @param handle - handle of the subscription
+ */
+static void print_cov_client_value(int handle)
+{
+    BACNET_COV_CLIENT_VALUE value = { 0 };
+    const char *mode = "subscribing";
+
+    if (!bacnet_cov_client_value(handle, &value)) {
+        return;
+    }
+    switch (bacnet_cov_client_mode(handle)) {
+        case BACNET_COV_CLIENT_MODE_COV:
+            mode = "cov";
+            break;
+        case BACNET_COV_CLIENT_MODE_POLL:
+            mode = "poll";
+            break;
+        default:
+            break;
+    }
+    switch (value.tag) {
+        case BACNET_APPLICATION_TAG_REAL:
+            PRINTF("%f", value.type.Real);
+            break;
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            PRINTF("%s", value.type.Boolean ? "true" : "false");
+            break;
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            PRINTF("%lu", (unsigned long)value.type.Unsigned_Int);
+            break;
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            PRINTF("%ld", (long)value.type.Signed_Int);
+            break;
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            PRINTF("%lu", (unsigned long)value.type.Enumerated);
+            break;
+        default:
+            PRINTF("null");
+            break;
+    }
+    PRINTF(" (%s status-flags=0x%02X age=%lus)\n", mode,
+        (unsigned)value.status_flags,
+        (unsigned long)(bacnet_cov_client_seconds() - value.seconds));
 }
 
 /**
@@ -94,6 +149,9 @@ int main(int argc, char *argv[])
     bool bool_value = false;
     unsigned object_type = 0;
     uint32_t unsigned_value = 0;
+    bool cov_client = false;
+    int cov_handle = BACNET_STATUS_ERROR;
+    unsigned long lifetime = 0;
     /* data from the command line */
     unsigned long print_seconds = 10;
     uint32_t target_device_object_instance = BACNET_MAX_INSTANCE;
@@ -125,6 +183,12 @@ int main(int argc, char *argv[])
                     return 1;
                 }
             }
+        } else if (strcmp(argv[argi], "--cov") == 0) {
+            cov_client = true;
+        } else if (strcmp(argv[argi], "--lifetime") == 0) {
+            if (++argi < argc) {
+                lifetime = strtol(argv[argi], NULL, 0);
+            }
         } else if (strcmp(argv[argi], "--print-seconds") == 0) {
             if (++argi < argc) {
                 print_seconds = strtol(argv[argi], NULL, 0);
@@ -170,16 +234,38 @@ int main(int argc, char *argv[])
     atexit(datalink_cleanup);
     bacnet_task_init();
     bacnet_data_poll_seconds_set(print_seconds);
-    if (!bacnet_data_object_add(target_device_object_instance,
-            target_object_type, target_object_instance)) {
+    if (cov_client) {
+        bacnet_cov_client_init();
+        bacnet_cov_client_poll_seconds_set(print_seconds);
+        if (lifetime) {
+            bacnet_cov_client_lifetime_set(lifetime);
+        }
+        cov_handle = bacnet_cov_client_add(target_device_object_instance,
+            target_object_type, target_object_instance, PROP_PRESENT_VALUE);
+        if (cov_handle < 0) {
+            return 1;
+        }
+    } else if (!bacnet_data_object_add(target_device_object_instance,
+                   target_object_type, target_object_instance)) {
         return 1;
     }
     mstimer_set(&print_value_timer, print_seconds * 1000);
     /* loop forever */
     for (;;) {
         bacnet_task();
+        if (cov_client) {
+            bacnet_cov_client_task();
+        }
         if (mstimer_expired(&print_value_timer)) {
             mstimer_reset(&print_value_timer);
+            if (cov_client) {
+                PRINTF("Device %u %s-%u=",
+                    (unsigned)target_device_object_instance,
+                    bactext_object_type_name(target_object_type),
+                    (unsigned)target_object_instance);
+                print_cov_client_value(cov_handle);
+                continue;
+            }
             switch (target_object_type) {
                 case OBJECT_ANALOG_INPUT:
                 case OBJECT_ANALOG_OUTPUT:
@@ -144,6 +144,11 @@ static void Init_Service_Handlers(void)
         SERVICE_UNCONFIRMED_TIME_SYNCHRONIZATION, handler_timesync);
     apdu_set_confirmed_handler(
         SERVICE_CONFIRMED_SUBSCRIBE_COV, handler_cov_subscribe);
+    apdu_set_confirmed_handler(SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY,
+        handler_cov_subscribe_property);
+    apdu_set_confirmed_handler(
+        SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY_MULTIPLE,
+        handler_cov_subscribe_property_multiple);
     apdu_set_unconfirmed_handler(
         SERVICE_UNCONFIRMED_COV_NOTIFICATION, handler_ucov_notification);
     /* handle communication so we can shutup when asked */
@@ -206,7 +211,7 @@ static void print_help(const char *filename)
  *      datalink_receive, npdu_handler,
  *      dcc_timer_seconds, datalink_maintenance_timer,
  *      Load_Control_State_Machine_Handler, handler_cov_task,
- *      tsm_timer_milliseconds
+ *      tsm_timer_milliseconds, handler_who_is_timer
  *
  * @param argc [in] Arg count.
  * @param argv [in] Takes one argument: the Device Instance #.
@@ -332,6 +337,7 @@ int main(int argc, char *argv[])
             mstimer_reset(&BACnet_TSM_Timer);
             elapsed_milliseconds = mstimer_interval(&BACnet_TSM_Timer);
             tsm_timer_milliseconds(elapsed_milliseconds);
+            handler_who_is_timer(elapsed_milliseconds);
         }
         if (mstimer_expired(&BACnet_Address_Timer)) {
             mstimer_reset(&BACnet_Address_Timer);
@@ -345,6 +351,7 @@ int main(int argc, char *argv[])
             mstimer_reset(&BACnet_Notification_Timer);
             Notification_Class_find_recipient();
         }
+        Notification_Class_Event_Queue_Task();
 #endif
         /* output */
         if (mstimer_expired(&BACnet_Object_Timer)) {
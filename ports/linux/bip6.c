@@ -32,6 +32,10 @@
  -------------------------------------------
 ####COPYRIGHTEND####*/
 
+#ifndef _GNU_SOURCE
+/* for recvmmsg() and sendmmsg() */
+#define _GNU_SOURCE
+#endif
 #include <ifaddrs.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -95,6 +99,19 @@ static int BIP6_Socket_Scope_Id = 0;
 static BACNET_IP6_ADDRESS BIP6_Addr;
 static BACNET_IP6_ADDRESS BIP6_Broadcast_Addr;
 
+/* number of datagrams received or sent with one system call */
+#ifndef BIP6_BATCH_MAX
+#define BIP6_BATCH_MAX 32
+#endif
+/* datagrams received by one recvmmsg(), returned one at a time */
+static uint8_t BIP6_Receive_Buffer[BIP6_BATCH_MAX][BIP6_MPDU_MAX];
+static struct sockaddr_in6 BIP6_Receive_Addr[BIP6_BATCH_MAX];
+static struct iovec BIP6_Receive_Iov[BIP6_BATCH_MAX];
+static struct mmsghdr BIP6_Receive_Msg[BIP6_BATCH_MAX];
+static unsigned BIP6_Receive_Count;
+static unsigned BIP6_Receive_Index;
+static unsigned BIP6_Receive_Batch = BIP6_BATCH_MAX;
+
 /**
  * Set the interface name. On Linux, ifname is the /dev/ name of the interface.
  *
@@ -233,6 +250,33 @@ bool bip6_get_broadcast_addr(BACNET_IP6_ADDRESS *addr)
     return bvlc6_address_copy(addr, &BIP6_Broadcast_Addr);
 }
 
+/**
+ * Convert a BACnet/IPv6 address into a socket address
+ *
+ * @param sin - [out] socket address
+ * @param addr - BACnet/IPv6 address
+ */
+static void bip6_sockaddr_from_address(
+    struct sockaddr_in6 *sin, BACNET_IP6_ADDRESS *addr)
+{
+    uint16_t addr16[8];
+
+    memset(sin, 0, sizeof(struct sockaddr_in6));
+    sin->sin6_family = AF_INET6;
+    bvlc6_address_get(addr, &addr16[0], &addr16[1], &addr16[2], &addr16[3],
+        &addr16[4], &addr16[5], &addr16[6], &addr16[7]);
+    sin->sin6_addr.s6_addr16[0] = htons(addr16[0]);
+    sin->sin6_addr.s6_addr16[1] = htons(addr16[1]);
+    sin->sin6_addr.s6_addr16[2] = htons(addr16[2]);
+    sin->sin6_addr.s6_addr16[3] = htons(addr16[3]);
+    sin->sin6_addr.s6_addr16[4] = htons(addr16[4]);
+    sin->sin6_addr.s6_addr16[5] = htons(addr16[5]);
+    sin->sin6_addr.s6_addr16[6] = htons(addr16[6]);
+    sin->sin6_addr.s6_addr16[7] = htons(addr16[7]);
+    sin->sin6_port = htons(addr->port);
+    sin->sin6_scope_id = BIP6_Socket_Scope_Id;
+}
+
 /**
  * The send function for BACnet/IPv6 driver layer
  *
@@ -246,33 +290,79 @@ bool bip6_get_broadcast_addr(BACNET_IP6_ADDRESS *addr)
  */
 int bip6_send_mpdu(BACNET_IP6_ADDRESS *dest, uint8_t *mtu, uint16_t mtu_len)
 {
-    struct sockaddr_in6 bvlc_dest = { 0 };
-    uint16_t addr16[8];
+    struct sockaddr_in6 bvlc_dest;
 
     /* assumes that the driver has already been initialized */
     if (BIP6_Socket < 0) {
         return 0;
     }
     /* load destination IP address */
-    bvlc_dest.sin6_family = AF_INET6;
-    bvlc6_address_get(dest, &addr16[0], &addr16[1], &addr16[2], &addr16[3],
-        &addr16[4], &addr16[5], &addr16[6], &addr16[7]);
-    bvlc_dest.sin6_addr.s6_addr16[0] = htons(addr16[0]);
-    bvlc_dest.sin6_addr.s6_addr16[1] = htons(addr16[1]);
-    bvlc_dest.sin6_addr.s6_addr16[2] = htons(addr16[2]);
-    bvlc_dest.sin6_addr.s6_addr16[3] = htons(addr16[3]);
-    bvlc_dest.sin6_addr.s6_addr16[4] = htons(addr16[4]);
-    bvlc_dest.sin6_addr.s6_addr16[5] = htons(addr16[5]);
-    bvlc_dest.sin6_addr.s6_addr16[6] = htons(addr16[6]);
-    bvlc_dest.sin6_addr.s6_addr16[7] = htons(addr16[7]);
-    bvlc_dest.sin6_port = htons(dest->port);
-    bvlc_dest.sin6_scope_id = BIP6_Socket_Scope_Id;
+    bip6_sockaddr_from_address(&bvlc_dest, dest);
     debug_print_ipv6("Sending MPDU->", &bvlc_dest.sin6_addr);
     /* Send the packet */
     return sendto(BIP6_Socket, (char *)mtu, mtu_len, 0,
         (struct sockaddr *)&bvlc_dest, sizeof(bvlc_dest));
 }
 
+/**
+ * The send function for the same MPDU to a list of destinations,
+ * such as the peers of a BBMD.  Up to BIP6_BATCH_MAX datagrams are
+ * sent with each sendmmsg() call.
+ *
+ * @param addr_list - array of destination addresses
+ * @param addr_count - number of destination addresses
+ * @param mtu - the bytes of data to send
+ * @param mtu_len - the number of bytes of data to send
+ *
+ * @return number of destinations the MPDU was sent to
+ */
+int bip6_send_mpdu_list(BACNET_IP6_ADDRESS *addr_list,
+    unsigned addr_count,
+    uint8_t *mtu,
+    uint16_t mtu_len)
+{
+    struct sockaddr_in6 bvlc_dest[BIP6_BATCH_MAX];
+    struct mmsghdr msg[BIP6_BATCH_MAX];
+    struct iovec iov;
+    unsigned count = 0;
+    unsigned i = 0;
+    unsigned k = 0;
+    int sent = 0;
+    int rv = 0;
+
+    /* assumes that the driver has already been initialized */
+    if ((BIP6_Socket < 0) || !addr_list || !mtu) {
+        return 0;
+    }
+    iov.iov_base = mtu;
+    iov.iov_len = mtu_len;
+    while (i < addr_count) {
+        count = addr_count - i;
+        if (count > BIP6_BATCH_MAX) {
+            count = BIP6_BATCH_MAX;
+        }
+        memset(msg, 0, sizeof(msg[0]) * count);
+        for (k = 0; k < count; k++) {
+            bip6_sockaddr_from_address(&bvlc_dest[k], &addr_list[i + k]);
+            msg[k].msg_hdr.msg_name = &bvlc_dest[k];
+            msg[k].msg_hdr.msg_namelen = sizeof(bvlc_dest[k]);
+            msg[k].msg_hdr.msg_iov = &iov;
+            msg[k].msg_hdr.msg_iovlen = 1;
+        }
+        rv = sendmmsg(BIP6_Socket, msg, count, 0);
+        if (rv > 0) {
+            sent += rv;
+            i += rv;
+        } else {
+            /* skip the destination that failed */
+            PRINTF("BIP6: sendmmsg failed at %u\n", i);
+            i++;
+        }
+    }
+
+    return sent;
+}
+
 /**
  * The common send function for BACnet/IPv6 application layer
  *
@@ -294,33 +384,47 @@ int bip6_send_pdu(BACNET_ADDRESS *dest,
 }
 
 /**
- * BACnet/IP Datalink Receive handler.
+ * Set the number of datagrams taken from the socket by each system call
+ * when bip6_receive() finds the queue empty.
  *
- * @param src - returns the source address
- * @param npdu - returns the NPDU buffer
- * @param max_npdu -maximum size of the NPDU buffer
- * @param timeout - number of milliseconds to wait for a packet
+ * @param count - 1 to use recvfrom(), up to BIP6_BATCH_MAX to use
+ *  recvmmsg()
+ */
+void bip6_set_receive_batch(unsigned count)
+{
+    if (count < 1) {
+        count = 1;
+    } else if (count > BIP6_BATCH_MAX) {
+        count = BIP6_BATCH_MAX;
+    }
+    BIP6_Receive_Batch = count;
+}
+
+/**
+ * @brief Return the active BACnet/IPv6 socket.
+ * @return The active BACnet/IPv6 socket, or -1 if uninitialized.
+ */
+int bip6_get_socket(void)
+{
+    return BIP6_Socket;
+}
+
+/**
+ * Receive a batch of datagrams that are waiting on the socket
  *
- * @return Number of bytes received, or 0 if none or timeout.
+ * @param timeout - number of milliseconds to wait for a datagram
+ *
+ * @return number of datagrams received
  */
-uint16_t bip6_receive(
-    BACNET_ADDRESS *src, uint8_t *npdu, uint16_t max_npdu, unsigned timeout)
+static unsigned bip6_receive_batch(unsigned timeout)
 {
-    uint16_t npdu_len = 0; /* return value */
     fd_set read_fds;
     int max = 0;
     struct timeval select_timeout;
-    struct sockaddr_in6 sin = { 0 };
-    BACNET_IP6_ADDRESS addr = { { 0 } };
-    socklen_t sin_len = sizeof(sin);
-    int received_bytes = 0;
-    int offset = 0;
-    uint16_t i = 0;
+    socklen_t sin_len = sizeof(struct sockaddr_in6);
+    int received = 0;
+    unsigned i = 0;
 
-    /* Make sure the socket is open */
-    if (BIP6_Socket < 0) {
-        return 0;
-    }
     /* we could just use a non-blocking socket, but that consumes all
        the CPU time.  We can use a timeout; it is only supported as
        a select. */
@@ -336,40 +440,95 @@ uint16_t bip6_receive(
     FD_SET(BIP6_Socket, &read_fds);
     max = BIP6_Socket;
     /* see if there is a packet for us */
-    if (select(max + 1, &read_fds, NULL, NULL, &select_timeout) > 0) {
-        received_bytes = recvfrom(BIP6_Socket, (char *)&npdu[0], max_npdu, 0,
-            (struct sockaddr *)&sin, &sin_len);
+    if (select(max + 1, &read_fds, NULL, NULL, &select_timeout) <= 0) {
+        return 0;
+    }
+    if (BIP6_Receive_Batch > 1) {
+        for (i = 0; i < BIP6_Receive_Batch; i++) {
+            BIP6_Receive_Iov[i].iov_base = BIP6_Receive_Buffer[i];
+            BIP6_Receive_Iov[i].iov_len = sizeof(BIP6_Receive_Buffer[i]);
+            memset(&BIP6_Receive_Msg[i], 0, sizeof(BIP6_Receive_Msg[i]));
+            BIP6_Receive_Msg[i].msg_hdr.msg_name = &BIP6_Receive_Addr[i];
+            BIP6_Receive_Msg[i].msg_hdr.msg_namelen = sin_len;
+            BIP6_Receive_Msg[i].msg_hdr.msg_iov = &BIP6_Receive_Iov[i];
+            BIP6_Receive_Msg[i].msg_hdr.msg_iovlen = 1;
+        }
+        received = recvmmsg(BIP6_Socket, BIP6_Receive_Msg,
+            BIP6_Receive_Batch, MSG_DONTWAIT, NULL);
     } else {
+        received = recvfrom(BIP6_Socket, (char *)BIP6_Receive_Buffer[0],
+            sizeof(BIP6_Receive_Buffer[0]), 0,
+            (struct sockaddr *)&BIP6_Receive_Addr[0], &sin_len);
+        if (received > 0) {
+            BIP6_Receive_Msg[0].msg_len = received;
+            received = 1;
+        }
+    }
+    if (received < 0) {
         return 0;
     }
-    /* See if there is a problem */
-    if (received_bytes < 0) {
+
+    return (unsigned)received;
+}
+
+/**
+ * BACnet/IP Datalink Receive handler.
+ *
+ * @param src - returns the source address
+ * @param npdu - returns the NPDU buffer
+ * @param max_npdu -maximum size of the NPDU buffer
+ * @param timeout - number of milliseconds to wait for a packet
+ *
+ * @return Number of bytes received, or 0 if none or timeout.
+ */
+uint16_t bip6_receive(
+    BACNET_ADDRESS *src, uint8_t *npdu, uint16_t max_npdu, unsigned timeout)
+{
+    uint16_t npdu_len = 0; /* return value */
+    struct sockaddr_in6 *sin = NULL;
+    BACNET_IP6_ADDRESS addr = { 0 };
+    uint8_t *mtu = NULL;
+    int received_bytes = 0;
+    int offset = 0;
+
+    /* Make sure the socket is open */
+    if (BIP6_Socket < 0) {
         return 0;
     }
+    /* datagrams of the last batch are returned before the next batch */
+    if (BIP6_Receive_Index >= BIP6_Receive_Count) {
+        BIP6_Receive_Index = 0;
+        BIP6_Receive_Count = bip6_receive_batch(timeout);
+        if (BIP6_Receive_Count == 0) {
+            return 0;
+        }
+    }
+    mtu = BIP6_Receive_Buffer[BIP6_Receive_Index];
+    sin = &BIP6_Receive_Addr[BIP6_Receive_Index];
+    received_bytes = BIP6_Receive_Msg[BIP6_Receive_Index].msg_len;
+    BIP6_Receive_Index++;
     /* no problem, just no bytes */
     if (received_bytes == 0) {
         return 0;
     }
     /* the signature of a BACnet/IPv6 packet */
-    if (npdu[0] != BVLL_TYPE_BACNET_IP6) {
+    if (mtu[0] != BVLL_TYPE_BACNET_IP6) {
         return 0;
     }
     /* pass the packet into the BBMD handler */
-    debug_print_ipv6("Received MPDU->", &sin.sin6_addr);
-    bvlc6_address_set(&addr, ntohs(sin.sin6_addr.s6_addr16[0]),
-        ntohs(sin.sin6_addr.s6_addr16[1]), ntohs(sin.sin6_addr.s6_addr16[2]),
-        ntohs(sin.sin6_addr.s6_addr16[3]), ntohs(sin.sin6_addr.s6_addr16[4]),
-        ntohs(sin.sin6_addr.s6_addr16[5]), ntohs(sin.sin6_addr.s6_addr16[6]),
-        ntohs(sin.sin6_addr.s6_addr16[7]));
-    addr.port = ntohs(sin.sin6_port);
-    offset = bvlc6_handler(&addr, src, npdu, received_bytes);
+    debug_print_ipv6("Received MPDU->", &sin->sin6_addr);
+    bvlc6_address_set(&addr, ntohs(sin->sin6_addr.s6_addr16[0]),
+        ntohs(sin->sin6_addr.s6_addr16[1]), ntohs(sin->sin6_addr.s6_addr16[2]),
+        ntohs(sin->sin6_addr.s6_addr16[3]), ntohs(sin->sin6_addr.s6_addr16[4]),
+        ntohs(sin->sin6_addr.s6_addr16[5]), ntohs(sin->sin6_addr.s6_addr16[6]),
+        ntohs(sin->sin6_addr.s6_addr16[7]));
+    addr.port = ntohs(sin->sin6_port);
+    offset = bvlc6_handler(&addr, src, mtu, received_bytes);
     if (offset > 0) {
         npdu_len = received_bytes - offset;
         if (npdu_len <= max_npdu) {
-            /* shift the buffer to return a valid NPDU */
-            for (i = 0; i < npdu_len; i++) {
-                npdu[i] = npdu[offset + i];
-            }
+            /* return a valid NPDU */
+            memcpy(npdu, &mtu[offset], npdu_len);
         } else {
             npdu_len = 0;
         }
@@ -388,6 +547,8 @@ void bip6_cleanup(void)
         close(BIP6_Socket);
     }
     BIP6_Socket = -1;
+    BIP6_Receive_Count = 0;
+    BIP6_Receive_Index = 0;
 
     return;
 }
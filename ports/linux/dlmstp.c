@@ -281,8 +281,7 @@ static void *dlmstp_master_fsm_task(void *pArg)
     while (thread_alive) {
         if (MSTP_Port.ReceivedValidFrame == false &&
             MSTP_Port.ReceivedInvalidFrame == false) {
-            RS485_Check_UART_Data(&MSTP_Port);
-            MSTP_Receive_Frame_FSM(&MSTP_Port);
+            RS485_Receive_Frame_Block(&MSTP_Port);
         }
         if (MSTP_Port.ReceivedValidFrame || MSTP_Port.ReceivedInvalidFrame) {
             run_master = true;
@@ -225,17 +225,13 @@ void *dlmstp_receive_fsm_task(void *pArg)
         /* only do receive state machine while we don't have a frame */
         if ((mstp_port->ReceivedValidFrame == false) &&
             (mstp_port->ReceivedInvalidFrame == false)) {
-            do {
-                RS485_Check_UART_Data(mstp_port);
-                MSTP_Receive_Frame_FSM(
-                    (volatile struct mstp_port_struct_t *)pArg);
-                received_frame = mstp_port->ReceivedValidFrame ||
-                    mstp_port->ReceivedInvalidFrame;
-                if (received_frame) {
-                    pthread_cond_signal(&poSharedData->Received_Frame_Flag);
-                    break;
-                }
-            } while (mstp_port->DataAvailable);
+            RS485_Receive_Frame_Block(
+                (volatile struct mstp_port_struct_t *)pArg);
+            received_frame = mstp_port->ReceivedValidFrame ||
+                mstp_port->ReceivedInvalidFrame;
+            if (received_frame) {
+                pthread_cond_signal(&poSharedData->Received_Frame_Flag);
+            }
         }
     }
 
@@ -261,8 +257,7 @@ void *dlmstp_master_fsm_task(void *pArg)
     for (;;) {
         if (mstp_port->ReceivedValidFrame == false &&
             mstp_port->ReceivedInvalidFrame == false) {
-            RS485_Check_UART_Data(mstp_port);
-            MSTP_Receive_Frame_FSM(mstp_port);
+            RS485_Receive_Frame_Block(mstp_port);
         }
         if (mstp_port->ReceivedValidFrame || mstp_port->ReceivedInvalidFrame) {
             run_master = true;
@@ -350,6 +345,71 @@ uint16_t MSTP_Put_Receive(volatile struct mstp_port_struct_t *mstp_port)
     return pdu_len;
 }
 
+/**
+ * @brief Count the token hold that ends when this node passes the token
+ * @param poSharedData - port specific data
+ */
+static void dlmstp_token_pass(SHARED_MSTP_DATA *poSharedData)
+{
+    DLMSTP_TOKEN_STATISTICS *stats = &poSharedData->Token_Statistics;
+    struct timeval now, diff;
+    uint32_t hold_time;
+
+    if (!poSharedData->Token_Held) {
+        return;
+    }
+    poSharedData->Token_Held = false;
+    gettimeofday(&now, NULL);
+    timersub(&now, &poSharedData->Token_Start, &diff);
+    hold_time = (uint32_t)((diff.tv_sec * 1000000L) + diff.tv_usec);
+    stats->token_count++;
+    stats->hold_time_total += hold_time;
+    if (hold_time > stats->hold_time_max) {
+        stats->hold_time_max = hold_time;
+    }
+    stats->frames_total += poSharedData->Token_Frames;
+    if (poSharedData->Token_Frames > stats->frames_max) {
+        stats->frames_max = poSharedData->Token_Frames;
+    }
+}
+
+/**
+ * @brief Start a token hold, and choose the number of frames that may
+ *  be sent with this token from the length of the PDU queue
+ * @param mstp_port - port specific data
+ * @param poSharedData - port specific data
+ */
+static void dlmstp_token_use(
+    volatile struct mstp_port_struct_t *mstp_port,
+    SHARED_MSTP_DATA *poSharedData)
+{
+    DLMSTP_TOKEN_STATISTICS *stats = &poSharedData->Token_Statistics;
+    unsigned queue_length;
+    unsigned frames;
+
+    /* a sole master uses the token again without passing it */
+    dlmstp_token_pass(poSharedData);
+    poSharedData->Token_Held = true;
+    gettimeofday(&poSharedData->Token_Start, NULL);
+    poSharedData->Token_Frames = 0;
+    queue_length = Ringbuf_Count(&poSharedData->PDU_Queue);
+    stats->queue_length_total += queue_length;
+    if (queue_length > stats->queue_length_max) {
+        stats->queue_length_max = (uint16_t)queue_length;
+    }
+    if (poSharedData->Max_Info_Frames_Limit >
+        poSharedData->Max_Info_Frames) {
+        frames = poSharedData->Max_Info_Frames;
+        if (queue_length > frames) {
+            frames = queue_length;
+        }
+        if (frames > poSharedData->Max_Info_Frames_Limit) {
+            frames = poSharedData->Max_Info_Frames_Limit;
+        }
+        mstp_port->Nmax_info_frames = (uint8_t)frames;
+    }
+}
+
 /* for the MS/TP state machine to use for getting data to send */
 /* Return: amount of PDU data */
 uint16_t MSTP_Get_Send(
@@ -365,6 +425,10 @@ uint16_t MSTP_Get_Send(
     }
 
     (void)timeout;
+    if (mstp_port->FrameCount == 0) {
+        /* this node just received the token */
+        dlmstp_token_use(mstp_port, poSharedData);
+    }
     if (Ringbuf_Empty(&poSharedData->PDU_Queue)) {
         return 0;
     }
@@ -380,6 +444,7 @@ uint16_t MSTP_Get_Send(
             mstp_port->OutputBufferSize, frame_type, pkt->destination_mac,
             mstp_port->This_Station, (uint8_t *)&pkt->buffer[0], pkt->length);
     (void)Ringbuf_Pop(&poSharedData->PDU_Queue, NULL);
+    poSharedData->Token_Frames++;
 
     return pdu_len;
 }
@@ -395,6 +460,15 @@ void MSTP_Send_Frame(
     uint8_t * buffer,
     uint16_t nbytes)
 {
+    SHARED_MSTP_DATA *poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+
+    if (poSharedData && (nbytes > 2)) {
+        if (buffer[2] == FRAME_TYPE_TOKEN) {
+            dlmstp_token_pass(poSharedData);
+        } else if (buffer[2] == FRAME_TYPE_POLL_FOR_MASTER) {
+            poSharedData->Token_Statistics.poll_for_master_count++;
+        }
+    }
     RS485_Send_Frame(mstp_port, buffer, nbytes);
 }
 
@@ -661,20 +735,17 @@ uint8_t dlmstp_mac_address(void *poPort)
 /* node, its value shall be 1. */
 void dlmstp_set_max_info_frames(void *poPort, uint8_t max_info_frames)
 {
-    /*	SHARED_MSTP_DATA * poSharedData; */
+    SHARED_MSTP_DATA *poSharedData;
     struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
     if (!mstp_port) {
         return;
     }
-    /*
-            poSharedData = (SHARED_MSTP_DATA *) mstp_port->UserData;
-            if(!poSharedData)
-            {
-                    return;
-            }
-    */
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
     if (max_info_frames >= 1) {
         mstp_port->Nmax_info_frames = max_info_frames;
+        if (poSharedData) {
+            poSharedData->Max_Info_Frames = max_info_frames;
+        }
         /* FIXME: implement your data storage */
         /* I2C_Write_Byte(
            EEPROM_DEVICE_ADDRESS,
@@ -687,21 +758,145 @@ void dlmstp_set_max_info_frames(void *poPort, uint8_t max_info_frames)
 
 uint8_t dlmstp_max_info_frames(void *poPort)
 {
-    /*	SHARED_MSTP_DATA * poSharedData; */
+    SHARED_MSTP_DATA *poSharedData;
     struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
     if (!mstp_port) {
         return 0;
     }
-    /*
-            poSharedData = (SHARED_MSTP_DATA *) mstp_port->UserData;
-            if(!poSharedData)
-            {
-                    return 0;
-            }
-    */
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (poSharedData && poSharedData->Max_Info_Frames) {
+        /* the adaptive mode may have raised Nmax_info_frames */
+        return poSharedData->Max_Info_Frames;
+    }
+
     return mstp_port->Nmax_info_frames;
 }
 
+/**
+ * @brief Set the largest number of frames a router or gateway node may
+ *  send for each token. When the limit is greater than Max_Info_Frames,
+ *  the node may send one frame for each PDU queued when it receives the
+ *  token, from Max_Info_Frames up to the limit, so that the traffic it
+ *  aggregates for the trunk is not starved, while the limit keeps the
+ *  token rotation fair to the other nodes.
+ * @param poPort - port specific data
+ * @param limit - largest number of frames for each token, or zero to
+ *  always use Max_Info_Frames
+ */
+void dlmstp_set_max_info_frames_limit(void *poPort, uint8_t limit)
+{
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return;
+    }
+    if (poSharedData->Max_Info_Frames == 0) {
+        poSharedData->Max_Info_Frames = mstp_port->Nmax_info_frames;
+    }
+    poSharedData->Max_Info_Frames_Limit = limit;
+    if (limit <= poSharedData->Max_Info_Frames) {
+        mstp_port->Nmax_info_frames = poSharedData->Max_Info_Frames;
+    }
+}
+
+/**
+ * @brief Get the largest number of frames a node may send for each token
+ * @param poPort - port specific data
+ * @return limit, or zero if the adaptive mode is not used
+ */
+uint8_t dlmstp_max_info_frames_limit(void *poPort)
+{
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return 0;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return 0;
+    }
+
+    return poSharedData->Max_Info_Frames_Limit;
+}
+
+/**
+ * @brief Set the largest number of tokens between maintenance Poll For
+ *  Master frames. While the polls find no new master, the interval
+ *  doubles from Npoll (50) up to this value, and it returns to Npoll
+ *  when the successor of this node changes.
+ * @param poPort - port specific data
+ * @param tokens - largest number of tokens between polls, or zero to
+ *  poll every Npoll tokens
+ */
+void dlmstp_set_poll_interval_max(void *poPort, unsigned tokens)
+{
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return;
+    }
+    mstp_port->Npoll_max = tokens;
+}
+
+/**
+ * @brief Get the largest number of tokens between maintenance Poll For
+ *  Master frames
+ * @param poPort - port specific data
+ * @return number of tokens, or zero if the standard Npoll is used
+ */
+unsigned dlmstp_poll_interval_max(void *poPort)
+{
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return 0;
+    }
+
+    return mstp_port->Npoll_max;
+}
+
+/**
+ * @brief Get the statistics of the token use of this node
+ * @param poPort - port specific data
+ * @param statistics - copy of the statistics
+ */
+void dlmstp_token_statistics(
+    void *poPort, DLMSTP_TOKEN_STATISTICS *statistics)
+{
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port || !statistics) {
+        return;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return;
+    }
+    memcpy(statistics, &poSharedData->Token_Statistics,
+        sizeof(DLMSTP_TOKEN_STATISTICS));
+}
+
+/**
+ * @brief Clear the statistics of the token use of this node
+ * @param poPort - port specific data
+ */
+void dlmstp_token_statistics_clear(void *poPort)
+{
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return;
+    }
+    memset(&poSharedData->Token_Statistics, 0,
+        sizeof(DLMSTP_TOKEN_STATISTICS));
+}
+
 /* This parameter represents the value of the Max_Master property of the */
 /* node's Device object. The value of Max_Master specifies the highest */
 /* allowable address for master nodes. The value of Max_Master shall be */
@@ -930,6 +1125,8 @@ bool dlmstp_init(void *poPort, char *ifname)
     /* ringbuffer */
     FIFO_Init(&poSharedData->Rx_FIFO, poSharedData->Rx_Buffer,
         sizeof(poSharedData->Rx_Buffer));
+    poSharedData->Rx_Block_Index = 0;
+    poSharedData->Rx_Block_Length = 0;
     printf("=success!\n");
     mstp_port->InputBuffer = &poSharedData->RxBuffer[0];
     mstp_port->InputBufferSize = sizeof(poSharedData->RxBuffer);
@@ -36,6 +36,7 @@
 #include "bacnet/bacdef.h"
 #include "bacnet/npdu.h"
 #include <termios.h>
+#include <linux/serial.h>
 #include "bacnet/basic/sys/fifo.h"
 #include "bacnet/basic/sys/ringbuf.h"
 /* defines specific to MS/TP */
@@ -48,6 +49,11 @@
 #define MSTP_PDU_PACKET_COUNT 8
 #endif
 
+/* largest read from the UART for the block receive */
+#ifndef RS485_RX_BLOCK_SIZE
+#define RS485_RX_BLOCK_SIZE 2048
+#endif
+
 typedef struct dlmstp_packet {
     bool ready; /* true if ready to be sent or received */
     BACNET_ADDRESS address;     /* source address */
@@ -64,6 +70,23 @@ struct mstp_pdu_packet {
     uint8_t buffer[DLMSTP_MPDU_MAX];
 };
 
+/* statistics of the token use of this node */
+typedef struct dlmstp_token_statistics {
+    /* number of times this node received the token and passed it on */
+    uint32_t token_count;
+    /* microseconds from receiving the token to passing it on */
+    uint64_t hold_time_total;
+    uint32_t hold_time_max;
+    /* data frames sent while holding the token */
+    uint32_t frames_total;
+    uint16_t frames_max;
+    /* length of the PDU queue when the token was received */
+    uint32_t queue_length_total;
+    uint16_t queue_length_max;
+    /* Poll For Master frames sent */
+    uint32_t poll_for_master_count;
+} DLMSTP_TOKEN_STATISTICS;
+
 typedef struct shared_mstp_data {
     /* Number of MS/TP Packets Rx/Tx */
     uint16_t MSTP_Packets;
@@ -110,18 +133,38 @@ typedef struct shared_mstp_data {
     char *RS485_Port_Name;
     /* serial I/O settings */
     struct termios RS485_oldtio;
+    /* for setting custom divisor */
+    struct serial_struct RS485_oldserial;
+    /* indicator of special baud rate */
+    bool RS485_SpecBaud;
     /* some terminal I/O have RS-485 specific functionality */
     tcflag_t RS485MOD;
     /* Ring buffer for incoming bytes, in order to speed up the receiving. */
     FIFO_BUFFER Rx_FIFO;
     /* buffer size needs to be a power of 2 */
     uint8_t Rx_Buffer[4096];
+    /* octets read for the block receive that are not yet processed */
+    uint8_t Rx_Block[RS485_RX_BLOCK_SIZE];
+    uint16_t Rx_Block_Index;
+    uint16_t Rx_Block_Length;
     struct timeval start;
 
     RING_BUFFER PDU_Queue;
 
     struct mstp_pdu_packet PDU_Buffer[MSTP_PDU_PACKET_COUNT];
 
+    /* Max_Info_Frames property of the node */
+    uint8_t Max_Info_Frames;
+    /* When greater than Max_Info_Frames, the node may send up to one
+       frame for each PDU queued when it receives the token, up to this
+       many frames, before it must pass the token */
+    uint8_t Max_Info_Frames_Limit;
+    /* token use */
+    DLMSTP_TOKEN_STATISTICS Token_Statistics;
+    bool Token_Held;
+    struct timeval Token_Start;
+    uint16_t Token_Frames;
+
 } SHARED_MSTP_DATA;
 
 #ifdef __cplusplus
@@ -171,6 +214,37 @@ extern "C" {
     uint8_t dlmstp_max_info_frames(
         void *poShared);
 
+    /* Adaptive Max_Info_Frames for a router or gateway node: when the */
+    /* limit is greater than Max_Info_Frames, the number of frames the */
+    /* node may send for each token is the number of PDUs queued when it */
+    /* receives the token, from Max_Info_Frames up to the limit. */
+    BACNET_STACK_EXPORT
+    void dlmstp_set_max_info_frames_limit(
+        void *poShared,
+        uint8_t limit);
+    BACNET_STACK_EXPORT
+    uint8_t dlmstp_max_info_frames_limit(
+        void *poShared);
+
+    /* Poll For Master back-off: the largest number of tokens between */
+    /* maintenance Poll For Master frames while no new master is found. */
+    /* Zero keeps the standard Npoll. */
+    BACNET_STACK_EXPORT
+    void dlmstp_set_poll_interval_max(
+        void *poShared,
+        unsigned tokens);
+    BACNET_STACK_EXPORT
+    unsigned dlmstp_poll_interval_max(
+        void *poShared);
+
+    BACNET_STACK_EXPORT
+    void dlmstp_token_statistics(
+        void *poShared,
+        DLMSTP_TOKEN_STATISTICS * statistics);
+    BACNET_STACK_EXPORT
+    void dlmstp_token_statistics_clear(
+        void *poShared);
+
     /* This parameter represents the value of the Max_Master property of the */
     /* node's Device object. The value of Max_Master specifies the highest */
     /* allowable address for master nodes. The value of Max_Master shall be */
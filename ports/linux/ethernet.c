@@ -36,12 +36,45 @@
 #include <stdbool.h> /* for the standard bool type. */
 
 #include "bacport.h"
+#include <poll.h>
+#include <sys/mman.h>
+#include <linux/filter.h>
+#include <linux/if_packet.h>
 #include "bacnet/bacdef.h"
 #include "bacnet/datalink/ethernet.h"
 #include "bacnet/bacint.h"
 
 /** @file linux/ethernet.c  Provides Linux-specific functions for
- * BACnet/Ethernet. */
+ * BACnet/Ethernet.
+ *
+ * When the kernel supports it, frames are received and sent through
+ * PACKET_MMAP TPACKET_V3 rings shared with the kernel. A BPF filter on
+ * the socket passes only BACnet LLC frames addressed to this node or to
+ * broadcast, so unrelated traffic is dropped in the kernel. The kernel
+ * fills a whole ring block before waking the receiver, and
+ * ethernet_receive() then returns the frames of that block one per
+ * call without a system call. Set BACNET_ETHERNET_RING=0 in the
+ * environment to use the older one frame per read() socket. */
+
+#if defined(TPACKET3_HDRLEN)
+#define ETHERNET_RING 1
+#endif
+
+#ifndef ETHERNET_RX_RING_BLOCK_SIZE
+#define ETHERNET_RX_RING_BLOCK_SIZE (1 << 16)
+#endif
+#ifndef ETHERNET_RX_RING_BLOCK_COUNT
+#define ETHERNET_RX_RING_BLOCK_COUNT 16
+#endif
+/* milliseconds before the kernel hands over a block that is not full */
+#ifndef ETHERNET_RX_RING_BLOCK_TIMEOUT
+#define ETHERNET_RX_RING_BLOCK_TIMEOUT 2
+#endif
+#ifndef ETHERNET_TX_RING_FRAME_COUNT
+#define ETHERNET_TX_RING_FRAME_COUNT 32
+#endif
+/* a ring frame holds the packet header and one Ethernet frame */
+#define ETHERNET_RING_FRAME_SIZE 2048
 
 /* commonly used comparison address for ethernet */
 uint8_t Ethernet_Broadcast[MAX_MAC_LEN] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
@@ -55,6 +88,19 @@ uint8_t Ethernet_MAC_Address[MAX_MAC_LEN] = { 0 };
 static int eth802_sockfd = -1; /* 802.2 file handle */
 static struct sockaddr eth_addr = { 0 }; /* used for binding 802.2 */
 
+#if ETHERNET_RING
+/* memory shared with the kernel: the RX ring, then the TX ring */
+static uint8_t *Ring_Map = NULL;
+static size_t Ring_Map_Size = 0;
+static uint8_t *Ring_TX_Map = NULL;
+/* the RX block being read, and the next frame in it */
+static unsigned Ring_RX_Block = 0;
+static struct tpacket3_hdr *Ring_RX_Packet = NULL;
+static uint32_t Ring_RX_Packets = 0;
+/* the next TX frame to fill */
+static unsigned Ring_TX_Frame = 0;
+#endif
+
 bool ethernet_valid(void)
 {
     return (eth802_sockfd >= 0);
@@ -62,6 +108,14 @@ bool ethernet_valid(void)
 
 void ethernet_cleanup(void)
 {
+#if ETHERNET_RING
+    if (Ring_Map) {
+        munmap(Ring_Map, Ring_Map_Size);
+        Ring_Map = NULL;
+        Ring_TX_Map = NULL;
+        Ring_RX_Packets = 0;
+    }
+#endif
     if (ethernet_valid())
         close(eth802_sockfd);
     eth802_sockfd = -1;
@@ -69,6 +123,201 @@ void ethernet_cleanup(void)
     return;
 }
 
+/**
+ * @brief Attach a BPF filter to the socket so the kernel passes only
+ *  802.2 frames for the BACnet LLC SAP, addressed to this node or to
+ *  broadcast.
+ * @param sock_fd - socket to filter
+ * @return true if the filter was attached
+ */
+static bool ethernet_filter_attach(int sock_fd)
+{
+    struct sock_filter code[] = {
+        /* 802.3 length field, not an EtherType */
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),
+        BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, 1500, 12, 0),
+        /* DSAP and SSAP for BACnet */
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 14),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x8282, 0, 10),
+        /* LLC Control */
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 16),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x03, 0, 8),
+        /* destination is this node: the MAC address is set below */
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 2),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 4),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 3, 4),
+        /* or broadcast */
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0xFFFFFFFF, 0, 3),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 4),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0xFFFF, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0x40000),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+    struct sock_fprog program;
+
+    /* the first four, and the last two, octets of the MAC address */
+    code[7].k = ((uint32_t)Ethernet_MAC_Address[0] << 24) |
+        ((uint32_t)Ethernet_MAC_Address[1] << 16) |
+        ((uint32_t)Ethernet_MAC_Address[2] << 8) |
+        (uint32_t)Ethernet_MAC_Address[3];
+    code[9].k = ((uint32_t)Ethernet_MAC_Address[4] << 8) |
+        (uint32_t)Ethernet_MAC_Address[5];
+    program.len = sizeof(code) / sizeof(code[0]);
+    program.filter = code;
+    if (setsockopt(sock_fd, SOL_SOCKET, SO_ATTACH_FILTER, &program,
+            sizeof(program)) != 0) {
+        fprintf(stderr, "ethernet: Unable to attach BPF filter: %s\n",
+            strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+#if ETHERNET_RING
+/**
+ * @brief Open a packet socket with TPACKET_V3 RX and TX rings
+ * @param interface_name - name of the network interface
+ * @return socket, or -1 if the rings are not available
+ */
+static int ethernet_ring_bind(const char *interface_name)
+{
+    int sock_fd;
+    int version = TPACKET_V3;
+    struct tpacket_req3 rx_req = { 0 };
+    struct tpacket_req3 tx_req = { 0 };
+    struct sockaddr_ll sll = { 0 };
+    size_t rx_size, tx_size;
+    void *map;
+
+    sock_fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_802_2));
+    if (sock_fd < 0) {
+        return -1;
+    }
+    if (setsockopt(sock_fd, SOL_PACKET, PACKET_VERSION, &version,
+            sizeof(version)) != 0) {
+        close(sock_fd);
+        return -1;
+    }
+    ethernet_filter_attach(sock_fd);
+    rx_req.tp_block_size = ETHERNET_RX_RING_BLOCK_SIZE;
+    rx_req.tp_block_nr = ETHERNET_RX_RING_BLOCK_COUNT;
+    rx_req.tp_frame_size = ETHERNET_RING_FRAME_SIZE;
+    rx_req.tp_frame_nr = (ETHERNET_RX_RING_BLOCK_SIZE /
+                             ETHERNET_RING_FRAME_SIZE) *
+        ETHERNET_RX_RING_BLOCK_COUNT;
+    rx_req.tp_retire_blk_tov = ETHERNET_RX_RING_BLOCK_TIMEOUT;
+    /* the TX ring is one block of fixed size frames */
+    tx_req.tp_block_size =
+        ETHERNET_RING_FRAME_SIZE * ETHERNET_TX_RING_FRAME_COUNT;
+    tx_req.tp_block_nr = 1;
+    tx_req.tp_frame_size = ETHERNET_RING_FRAME_SIZE;
+    tx_req.tp_frame_nr = ETHERNET_TX_RING_FRAME_COUNT;
+    if ((setsockopt(sock_fd, SOL_PACKET, PACKET_RX_RING, &rx_req,
+             sizeof(rx_req)) != 0) ||
+        (setsockopt(sock_fd, SOL_PACKET, PACKET_TX_RING, &tx_req,
+             sizeof(tx_req)) != 0)) {
+        fprintf(stderr, "ethernet: Unable to set up packet rings: %s\n",
+            strerror(errno));
+        close(sock_fd);
+        return -1;
+    }
+    rx_size = (size_t)rx_req.tp_block_size * rx_req.tp_block_nr;
+    tx_size = (size_t)tx_req.tp_block_size * tx_req.tp_block_nr;
+    map = mmap(NULL, rx_size + tx_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+        sock_fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "ethernet: Unable to map packet rings: %s\n",
+            strerror(errno));
+        close(sock_fd);
+        return -1;
+    }
+    sll.sll_family = AF_PACKET;
+    sll.sll_protocol = htons(ETH_P_802_2);
+    sll.sll_ifindex = (int)if_nametoindex(interface_name);
+    if ((sll.sll_ifindex == 0) ||
+        (bind(sock_fd, (struct sockaddr *)&sll, sizeof(sll)) != 0)) {
+        fprintf(stderr, "ethernet: Unable to bind packet socket: %s\n",
+            strerror(errno));
+        munmap(map, rx_size + tx_size);
+        close(sock_fd);
+        return -1;
+    }
+    Ring_Map = map;
+    Ring_Map_Size = rx_size + tx_size;
+    Ring_TX_Map = Ring_Map + rx_size;
+    Ring_RX_Block = 0;
+    Ring_RX_Packet = NULL;
+    Ring_RX_Packets = 0;
+    Ring_TX_Frame = 0;
+    fprintf(stderr, "ethernet: using packet rings on \"%s\"\n",
+        interface_name);
+
+    return sock_fd;
+}
+
+/**
+ * @brief Get the next free frame of the TX ring, waiting a little for
+ *  the kernel to send older frames if the ring is full
+ * @return frame header, or NULL if the ring is full
+ */
+static struct tpacket3_hdr *ethernet_ring_tx_frame(void)
+{
+    struct tpacket3_hdr *hdr;
+    struct pollfd pfd;
+
+    hdr = (struct tpacket3_hdr *)(Ring_TX_Map +
+        ((size_t)Ring_TX_Frame * ETHERNET_RING_FRAME_SIZE));
+    if (hdr->tp_status == TP_STATUS_WRONG_FORMAT) {
+        hdr->tp_status = TP_STATUS_AVAILABLE;
+    }
+    if (hdr->tp_status != TP_STATUS_AVAILABLE) {
+        pfd.fd = eth802_sockfd;
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
+        (void)poll(&pfd, 1, 10);
+        __sync_synchronize();
+        if (hdr->tp_status != TP_STATUS_AVAILABLE) {
+            return NULL;
+        }
+    }
+
+    return hdr;
+}
+
+/**
+ * @brief Get the frame data of a TX ring frame
+ */
+static uint8_t *ethernet_ring_tx_data(struct tpacket3_hdr *hdr)
+{
+    return (uint8_t *)hdr + TPACKET3_HDRLEN - sizeof(struct sockaddr_ll);
+}
+
+/**
+ * @brief Hand a filled TX ring frame to the kernel and have it sent
+ * @param hdr - frame header
+ * @param mtu_len - number of octets in the frame
+ * @return number of octets sent, or -1 on error
+ */
+static int ethernet_ring_tx_send(struct tpacket3_hdr *hdr, unsigned mtu_len)
+{
+    hdr->tp_len = mtu_len;
+    hdr->tp_next_offset = 0;
+    __sync_synchronize();
+    hdr->tp_status = TP_STATUS_SEND_REQUEST;
+    Ring_TX_Frame = (Ring_TX_Frame + 1) % ETHERNET_TX_RING_FRAME_COUNT;
+    if ((send(eth802_sockfd, NULL, 0, MSG_DONTWAIT) < 0) &&
+        (errno != EAGAIN)) {
+        fprintf(
+            stderr, "ethernet: Error sending packet: %s\n", strerror(errno));
+        return -1;
+    }
+
+    return (int)mtu_len;
+}
+#endif
+
 #if 0
 /*----------------------------------------------------------------------
  Portable function to set a socket into nonblocking mode.
@@ -190,12 +439,26 @@ static int get_local_hwaddr(const char *ifname, unsigned char *mac)
 
 bool ethernet_init(char *interface_name)
 {
-    if (interface_name) {
-        get_local_hwaddr(interface_name, Ethernet_MAC_Address);
-        eth802_sockfd = ethernet_bind(&eth_addr, interface_name);
-    } else {
-        get_local_hwaddr("eth0", Ethernet_MAC_Address);
-        eth802_sockfd = ethernet_bind(&eth_addr, "eth0");
+#if ETHERNET_RING
+    char *ring = getenv("BACNET_ETHERNET_RING");
+#endif
+
+    if (!interface_name) {
+        interface_name = "eth0";
+    }
+    get_local_hwaddr(interface_name, Ethernet_MAC_Address);
+#if ETHERNET_RING
+    if (!ring || (strcmp(ring, "0") != 0)) {
+        eth802_sockfd = ethernet_ring_bind(interface_name);
+        if (eth802_sockfd >= 0) {
+            atexit(ethernet_cleanup);
+            return true;
+        }
+    }
+#endif
+    eth802_sockfd = ethernet_bind(&eth_addr, interface_name);
+    if (eth802_sockfd >= 0) {
+        ethernet_filter_attach(eth802_sockfd);
     }
 
     return ethernet_valid();
@@ -204,9 +467,24 @@ bool ethernet_init(char *interface_name)
 int ethernet_send(uint8_t *mtu, int mtu_len)
 {
     int bytes = 0;
+#if ETHERNET_RING
+    struct tpacket3_hdr *hdr;
 
+    if (Ring_Map) {
+        if ((mtu_len <= 0) || (mtu_len > ETHERNET_MPDU_MAX)) {
+            return -4;
+        }
+        hdr = ethernet_ring_tx_frame();
+        if (!hdr) {
+            fprintf(stderr, "ethernet: transmit ring is full!\n");
+            return -5;
+        }
+        memcpy(ethernet_ring_tx_data(hdr), mtu, mtu_len);
+        return ethernet_ring_tx_send(hdr, mtu_len);
+    }
+#endif
     /* Send the packet */
-    bytes = sendto(eth802_sockfd, &mtu, mtu_len, 0,
+    bytes = sendto(eth802_sockfd, mtu, mtu_len, 0,
         (struct sockaddr *)&eth_addr, sizeof(struct sockaddr));
     /* did it get sent? */
     if (bytes < 0)
@@ -226,8 +504,12 @@ int ethernet_send_pdu(BACNET_ADDRESS *dest, /* destination address */
     int i = 0; /* counter */
     int bytes = 0;
     BACNET_ADDRESS src = { 0 }; /* source address for npdu */
-    uint8_t mtu[ETHERNET_MPDU_MAX] = { 0 }; /* our buffer */
+    uint8_t buffer[ETHERNET_MPDU_MAX] = { 0 }; /* our buffer */
+    uint8_t *mtu = buffer;
     int mtu_len = 0;
+#if ETHERNET_RING
+    struct tpacket3_hdr *hdr = NULL;
+#endif
 
     (void)npdu_data;
     /* load the BACnet address for NPDU data */
@@ -241,6 +523,21 @@ int ethernet_send_pdu(BACNET_ADDRESS *dest, /* destination address */
         fprintf(stderr, "ethernet: 802.2 socket is invalid!\n");
         return -1;
     }
+    if ((17 + pdu_len) > ETHERNET_MPDU_MAX) {
+        fprintf(stderr, "ethernet: PDU is too big to send!\n");
+        return -4;
+    }
+#if ETHERNET_RING
+    if (Ring_Map) {
+        /* build the frame in the transmit ring */
+        hdr = ethernet_ring_tx_frame();
+        if (!hdr) {
+            fprintf(stderr, "ethernet: transmit ring is full!\n");
+            return -5;
+        }
+        mtu = ethernet_ring_tx_data(hdr);
+    }
+#endif
     /* load destination ethernet MAC address */
     if (dest->mac_len == 6) {
         for (i = 0; i < 6; i++) {
@@ -265,17 +562,18 @@ int ethernet_send_pdu(BACNET_ADDRESS *dest, /* destination address */
     mtu[15] = 0x82; /* SSAP for BACnet */
     mtu[16] = 0x03; /* Control byte in header */
     mtu_len = 17;
-    if ((mtu_len + pdu_len) > ETHERNET_MPDU_MAX) {
-        fprintf(stderr, "ethernet: PDU is too big to send!\n");
-        return -4;
-    }
     memcpy(&mtu[mtu_len], pdu, pdu_len);
     mtu_len += pdu_len;
     /* packet length - only the logical portion, not the address */
     encode_unsigned16(&mtu[12], 3 + pdu_len);
 
+#if ETHERNET_RING
+    if (hdr) {
+        return ethernet_ring_tx_send(hdr, mtu_len);
+    }
+#endif
     /* Send the packet */
-    bytes = sendto(eth802_sockfd, &mtu, mtu_len, 0,
+    bytes = sendto(eth802_sockfd, mtu, mtu_len, 0,
         (struct sockaddr *)&eth_addr, sizeof(struct sockaddr));
     /* did it get sent? */
     if (bytes < 0)
@@ -285,6 +583,119 @@ int ethernet_send_pdu(BACNET_ADDRESS *dest, /* destination address */
     return bytes;
 }
 
+/**
+ * @brief Check an 802.2 frame and copy its PDU
+ * @param src - source address of the frame
+ * @param buf - the frame
+ * @param buf_len - number of octets in the frame
+ * @param pdu - PDU data
+ * @param max_pdu - amount of space available in the PDU
+ * @return the number of octets in the PDU, or zero if the frame is not
+ *  a BACnet frame for this node
+ */
+static uint16_t ethernet_frame_decode(BACNET_ADDRESS *src,
+    uint8_t *buf,
+    unsigned buf_len,
+    uint8_t *pdu,
+    uint16_t max_pdu)
+{
+    uint16_t pdu_len = 0;
+
+    if (buf_len < 17) {
+        return 0;
+    }
+    /* the signature of an 802.2 BACnet packet */
+    if ((buf[14] != 0x82) && (buf[15] != 0x82)) {
+        /*fprintf(stderr,"ethernet: Non-BACnet packet\n"); */
+        return 0;
+    }
+    /* check destination address for when */
+    /* the Ethernet card is in promiscious mode */
+    if ((memcmp(&buf[0], Ethernet_MAC_Address, 6) != 0) &&
+        (memcmp(&buf[0], Ethernet_Broadcast, 6) != 0)) {
+        /*fprintf(stderr, "ethernet: This packet isn't for us\n"); */
+        return 0;
+    }
+    /* copy the source address */
+    src->mac_len = 6;
+    memmove(src->mac, &buf[6], 6);
+
+    (void)decode_unsigned16(&buf[12], &pdu_len);
+    if ((pdu_len < 3) || (pdu_len > (buf_len - 14))) {
+        return 0;
+    }
+    pdu_len -= 3 /* DSAP, SSAP, LLC Control */;
+    /* copy the buffer into the PDU */
+    if (pdu_len < max_pdu)
+        memmove(&pdu[0], &buf[17], pdu_len);
+    /* ignore packets that are too large */
+    else
+        pdu_len = 0;
+
+    return pdu_len;
+}
+
+#if ETHERNET_RING
+/**
+ * @brief Receive the next BACnet frame from the RX ring. The frames of
+ *  a block are returned one per call, and the block is given back to
+ *  the kernel after its last frame.
+ * @return the number of octets in the PDU, or zero if none arrived
+ */
+static uint16_t ethernet_ring_receive(BACNET_ADDRESS *src,
+    uint8_t *pdu,
+    uint16_t max_pdu,
+    unsigned timeout)
+{
+    struct tpacket_block_desc *block;
+    struct tpacket3_hdr *packet;
+    struct pollfd pfd;
+    bool waited = false;
+    uint16_t pdu_len = 0;
+
+    while (pdu_len == 0) {
+        block = (struct tpacket_block_desc *)(Ring_Map +
+            ((size_t)Ring_RX_Block * ETHERNET_RX_RING_BLOCK_SIZE));
+        if (Ring_RX_Packets == 0) {
+            if ((block->hdr.bh1.block_status & TP_STATUS_USER) == 0) {
+                if (waited) {
+                    break;
+                }
+                pfd.fd = eth802_sockfd;
+                pfd.events = POLLIN | POLLERR;
+                pfd.revents = 0;
+                if (poll(&pfd, 1, (int)timeout) <= 0) {
+                    break;
+                }
+                waited = true;
+                continue;
+            }
+            __sync_synchronize();
+            Ring_RX_Packets = block->hdr.bh1.num_pkts;
+            Ring_RX_Packet = (struct tpacket3_hdr *)((uint8_t *)block +
+                block->hdr.bh1.offset_to_first_pkt);
+        }
+        if (Ring_RX_Packets > 0) {
+            packet = Ring_RX_Packet;
+            pdu_len = ethernet_frame_decode(src,
+                (uint8_t *)packet + packet->tp_mac, packet->tp_snaplen, pdu,
+                max_pdu);
+            Ring_RX_Packets--;
+            Ring_RX_Packet = (struct tpacket3_hdr *)((uint8_t *)packet +
+                packet->tp_next_offset);
+        }
+        if (Ring_RX_Packets == 0) {
+            /* give the block back to the kernel */
+            __sync_synchronize();
+            block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+            Ring_RX_Block = (Ring_RX_Block + 1) % ETHERNET_RX_RING_BLOCK_COUNT;
+        }
+    }
+
+    return pdu_len;
+}
+#endif
+
 /* receives an 802.2 framed packet */
 /* returns the number of octets in the PDU, or zero on failure */
 uint16_t ethernet_receive(BACNET_ADDRESS *src, /* source address */
@@ -302,6 +713,11 @@ uint16_t ethernet_receive(BACNET_ADDRESS *src, /* source address */
     /* Make sure the socket is open */
     if (eth802_sockfd <= 0)
         return 0;
+#if ETHERNET_RING
+    if (Ring_Map) {
+        return ethernet_ring_receive(src, pdu, max_pdu, timeout);
+    }
+#endif
 
     /* we could just use a non-blocking socket, but that consumes all
        the CPU time.  We can use a timeout; it is only supported as
@@ -337,31 +753,8 @@ uint16_t ethernet_receive(BACNET_ADDRESS *src, /* source address */
     if (received_bytes == 0)
         return 0;
 
-    /* the signature of an 802.2 BACnet packet */
-    if ((buf[14] != 0x82) && (buf[15] != 0x82)) {
-        /*fprintf(stderr,"ethernet: Non-BACnet packet\n"); */
-        return 0;
-    }
-    /* copy the source address */
-    src->mac_len = 6;
-    memmove(src->mac, &buf[6], 6);
-
-    /* check destination address for when */
-    /* the Ethernet card is in promiscious mode */
-    if ((memcmp(&buf[0], Ethernet_MAC_Address, 6) != 0) &&
-        (memcmp(&buf[0], Ethernet_Broadcast, 6) != 0)) {
-        /*fprintf(stderr, "ethernet: This packet isn't for us\n"); */
-        return 0;
-    }
-
-    (void)decode_unsigned16(&buf[12], &pdu_len);
-    pdu_len -= 3 /* DSAP, SSAP, LLC Control */;
-    /* copy the buffer into the PDU */
-    if (pdu_len < max_pdu)
-        memmove(&pdu[0], &buf[17], pdu_len);
-    /* ignore packets that are too large */
-    else
-        pdu_len = 0;
+    pdu_len = ethernet_frame_decode(
+        src, buf, (unsigned)received_bytes, pdu, max_pdu);
 
     return pdu_len;
 }
@@ -373,6 +766,10 @@ void ethernet_set_my_address(BACNET_ADDRESS *my_address)
     for (i = 0; i < 6; i++) {
         Ethernet_MAC_Address[i] = my_address->mac[i];
     }
+    if (ethernet_valid()) {
+        /* the filter passes frames for this MAC address */
+        ethernet_filter_attach(eth802_sockfd);
+    }
 
     return;
 }
@@ -102,6 +102,10 @@ static bool RS485_SpecBaud = false;
 static FIFO_BUFFER Rx_FIFO;
 /* buffer size needs to be a power of 2 */
 static uint8_t Rx_Buffer[4096];
+/* octets read for the block receive that are not yet processed */
+static uint8_t Rx_Block[RS485_RX_BLOCK_SIZE];
+static uint16_t Rx_Block_Index;
+static uint16_t Rx_Block_Length;
 
 #define _POSIX_SOURCE 1 /* POSIX compliant source */
 
@@ -271,7 +275,11 @@ uint32_t RS485_Get_Port_Baud_Rate(volatile struct mstp_port_struct_t *mstp_port)
             baud = 19200;
             break;
         case B38400:
-            baud = 38400;
+            if (!poSharedData->RS485_SpecBaud) {
+                baud = 38400;
+            } else {
+                baud = 76800;
+            }
             break;
         case B57600:
             baud = 57600;
@@ -533,6 +541,216 @@ void RS485_Check_UART_Data(volatile struct mstp_port_struct_t *mstp_port)
     }
 }
 
+/**
+ * @brief Read the octets waiting in the UART, or wait up to 5ms for some,
+ *  and run them through the receive state machine as a block.  Octets
+ *  after the end of a frame are kept for the next call.  Use this in place
+ *  of RS485_Check_UART_Data() and MSTP_Receive_Frame_FSM().
+ * @param mstp_port - port specific data
+ */
+void RS485_Receive_Frame_Block(volatile struct mstp_port_struct_t *mstp_port)
+{
+    fd_set input;
+    struct timeval waiter;
+    int handle = RS485_Handle;
+    FIFO_BUFFER *fifo = &Rx_FIFO;
+    uint8_t *block = Rx_Block;
+    uint16_t *block_index = &Rx_Block_Index;
+    uint16_t *block_length = &Rx_Block_Length;
+    int n;
+
+    SHARED_MSTP_DATA *poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (poSharedData) {
+        handle = poSharedData->RS485_Handle;
+        fifo = &poSharedData->Rx_FIFO;
+        block = poSharedData->Rx_Block;
+        block_index = &poSharedData->Rx_Block_Index;
+        block_length = &poSharedData->Rx_Block_Length;
+    }
+    if (*block_index >= *block_length) {
+        *block_index = 0;
+        /* octets queued by RS485_Check_UART_Data() come first */
+        *block_length = FIFO_Pull(fifo, block, RS485_RX_BLOCK_SIZE);
+        if (*block_length == 0) {
+            waiter.tv_sec = 0;
+            waiter.tv_usec = 5000;
+            FD_ZERO(&input);
+            FD_SET(handle, &input);
+            n = select(handle + 1, &input, NULL, NULL, &waiter);
+            if ((n > 0) && FD_ISSET(handle, &input)) {
+                n = read(handle, block, RS485_RX_BLOCK_SIZE);
+                if (n > 0) {
+                    *block_length = (uint16_t)n;
+                }
+            }
+        }
+    }
+    if (*block_index < *block_length) {
+        *block_index += MSTP_Receive_Frame_Block(
+            mstp_port, &block[*block_index], *block_length - *block_index);
+    } else {
+        /* nothing received - let the state machine check the silence */
+        MSTP_Receive_Frame_FSM(mstp_port);
+    }
+}
+
+/**
+ * @brief Set the custom divisor of a serial port for 76800 baud, which
+ *  Linux uses when the port is set to B38400
+ * @param handle - handle of the serial port
+ * @param oldserial - [out] serial settings before the divisor was set
+ * @return true if the divisor was set
+ */
+static bool RS485_Custom_Divisor_Set(
+    int handle, struct serial_struct *oldserial)
+{
+    struct serial_struct newserial;
+    float baud_error = 0.0;
+
+    /* we read the old serial setup */
+    ioctl(handle, TIOCGSERIAL, oldserial);
+    /* we need a copy of existing settings */
+    memcpy(&newserial, oldserial, sizeof(struct serial_struct));
+    newserial.flags |= ASYNC_SPD_CUST;
+    newserial.custom_divisor = round(((float)newserial.baud_base) / 76800);
+    /* we must check that we calculated some sane value;
+       small baud bases yield bad custom divisor values */
+    if (newserial.custom_divisor == 0) {
+        baud_error = 1.0;
+    } else {
+        baud_error = fabs(1 -
+            ((float)newserial.baud_base) / ((float)newserial.custom_divisor) /
+                76800);
+    }
+    if (baud_error > 0.02) {
+        /* bad divisor */
+        fprintf(stderr, "RS485 bad custom divisor %d, base baud %d\n",
+            newserial.custom_divisor, newserial.baud_base);
+        return false;
+    }
+    /* if all goes well, set new divisor */
+    ioctl(handle, TIOCSSERIAL, &newserial);
+
+    return true;
+}
+
+/**
+ * @brief Open and configure another serial port, so that one process can
+ *  use several ports, for example to capture from them.  The port data
+ *  is allocated and kept in UserData, which must be NULL, and then
+ *  RS485_Check_UART_Data() and RS485_Receive_Frame_Block() use this
+ *  serial port.  RS485_Port_Cleanup() closes it and frees the data.
+ * @param mstp_port - port specific data
+ * @param ifname - serial port name, such as /dev/ttyUSB1
+ * @param baud - baud rate: 9600, 19200, 38400, 57600, 76800, 115200
+ *  or 230400
+ * @return true if the port was opened
+ */
+bool RS485_Port_Initialize(
+    volatile struct mstp_port_struct_t *mstp_port, char *ifname, uint32_t baud)
+{
+    struct termios newtio;
+    SHARED_MSTP_DATA *poSharedData;
+
+    if (!mstp_port || mstp_port->UserData || !ifname) {
+        return false;
+    }
+    poSharedData = calloc(1, sizeof(SHARED_MSTP_DATA));
+    if (!poSharedData) {
+        return false;
+    }
+    poSharedData->RS485_Port_Name = ifname;
+    switch (baud) {
+        case 9600:
+            poSharedData->RS485_Baud = B9600;
+            break;
+        case 19200:
+            poSharedData->RS485_Baud = B19200;
+            break;
+        case 38400:
+            poSharedData->RS485_Baud = B38400;
+            break;
+        case 57600:
+            poSharedData->RS485_Baud = B57600;
+            break;
+        case 76800:
+            poSharedData->RS485_Baud = B38400;
+            poSharedData->RS485_SpecBaud = true;
+            break;
+        case 115200:
+            poSharedData->RS485_Baud = B115200;
+            break;
+        case 230400:
+            poSharedData->RS485_Baud = B230400;
+            break;
+        default:
+            free(poSharedData);
+            return false;
+    }
+    poSharedData->RS485_Handle =
+        open(poSharedData->RS485_Port_Name, O_RDWR | O_NOCTTY);
+    if (poSharedData->RS485_Handle < 0) {
+        perror(poSharedData->RS485_Port_Name);
+        free(poSharedData);
+        return false;
+    }
+    /* efficient blocking for the read */
+    fcntl(poSharedData->RS485_Handle, F_SETFL, 0);
+    /* save current serial port settings */
+    tcgetattr(poSharedData->RS485_Handle, &poSharedData->RS485_oldtio);
+    /* clear struct for new port settings */
+    bzero(&newtio, sizeof(newtio));
+    newtio.c_cflag = poSharedData->RS485_Baud | CS8 | CLOCAL | CREAD | RS485MOD;
+    /* Raw input */
+    newtio.c_iflag = 0;
+    /* Raw output */
+    newtio.c_oflag = 0;
+    /* no processing */
+    newtio.c_lflag = 0;
+    /* activate the settings for the port after flushing I/O */
+    tcsetattr(poSharedData->RS485_Handle, TCSAFLUSH, &newtio);
+    if (poSharedData->RS485_SpecBaud &&
+        !RS485_Custom_Divisor_Set(
+            poSharedData->RS485_Handle, &poSharedData->RS485_oldserial)) {
+        tcsetattr(
+            poSharedData->RS485_Handle, TCSANOW, &poSharedData->RS485_oldtio);
+        close(poSharedData->RS485_Handle);
+        free(poSharedData);
+        return false;
+    }
+    tcflush(poSharedData->RS485_Handle, TCIOFLUSH);
+    /* ringbuffer */
+    FIFO_Init(&poSharedData->Rx_FIFO, poSharedData->Rx_Buffer,
+        sizeof(poSharedData->Rx_Buffer));
+    poSharedData->Rx_Block_Index = 0;
+    poSharedData->Rx_Block_Length = 0;
+    mstp_port->UserData = poSharedData;
+
+    return true;
+}
+
+/**
+ * @brief Restore the settings of, and close, a serial port opened with
+ *  RS485_Port_Initialize(), and free its port data
+ * @param mstp_port - port specific data
+ */
+void RS485_Port_Cleanup(volatile struct mstp_port_struct_t *mstp_port)
+{
+    SHARED_MSTP_DATA *poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+
+    if (poSharedData) {
+        tcsetattr(
+            poSharedData->RS485_Handle, TCSANOW, &poSharedData->RS485_oldtio);
+        if (poSharedData->RS485_SpecBaud) {
+            ioctl(poSharedData->RS485_Handle, TIOCSSERIAL,
+                &poSharedData->RS485_oldserial);
+        }
+        close(poSharedData->RS485_Handle);
+        free(poSharedData);
+        mstp_port->UserData = NULL;
+    }
+}
+
 void RS485_Cleanup(void)
 {
     /* restore the old port settings */
@@ -544,8 +762,6 @@ void RS485_Cleanup(void)
 void RS485_Initialize(void)
 {
     struct termios newtio;
-    struct serial_struct newserial;
-    float baud_error = 0.0;
 
 #if PRINT_ENABLED
     fprintf(stdout, "RS485 Interface: %s\n", RS485_Port_Name);
@@ -570,8 +786,6 @@ void RS485_Initialize(void)
     tcgetattr(RS485_Handle, &RS485_oldtio);
     /* we read the old serial setup */
     ioctl(RS485_Handle, TIOCGSERIAL, &RS485_oldserial);
-    /* we need a copy of existing settings */
-    memcpy(&newserial, &RS485_oldserial, sizeof(struct serial_struct));
     /* clear struct for new port settings */
     bzero(&newtio, sizeof(newtio));
     /*
@@ -591,23 +805,9 @@ void RS485_Initialize(void)
     newtio.c_lflag = 0;
     /* activate the settings for the port after flushing I/O */
     tcsetattr(RS485_Handle, TCSAFLUSH, &newtio);
-    if (RS485_SpecBaud) {
-        /* 76800, custom divisor must be set */
-        newserial.flags |= ASYNC_SPD_CUST;
-        newserial.custom_divisor = round(((float)newserial.baud_base) / 76800);
-        /* we must check that we calculated some sane value;
-           small baud bases yield bad custom divisor values */
-        baud_error = fabs(1 -
-            ((float)newserial.baud_base) / ((float)newserial.custom_divisor) /
-                76800);
-        if ((newserial.custom_divisor == 0) || (baud_error > 0.02)) {
-            /* bad divisor */
-            fprintf(stderr, "RS485 bad custom divisor %d, base baud %d\n",
-                newserial.custom_divisor, newserial.baud_base);
-            exit(EXIT_FAILURE);
-        }
-        /* if all goes well, set new divisor */
-        ioctl(RS485_Handle, TIOCSSERIAL, &newserial);
+    if (RS485_SpecBaud &&
+        !RS485_Custom_Divisor_Set(RS485_Handle, &RS485_oldserial)) {
+        exit(EXIT_FAILURE);
     }
 #if PRINT_ENABLED
     fprintf(stdout, "RS485 Baud Rate %u\n", RS485_Get_Baud_Rate());
@@ -620,6 +820,8 @@ void RS485_Initialize(void)
     tcflush(RS485_Handle, TCIOFLUSH);
     /* ringbuffer */
     FIFO_Init(&Rx_FIFO, Rx_Buffer, sizeof(Rx_Buffer));
+    Rx_Block_Index = 0;
+    Rx_Block_Length = 0;
 }
 
 /* Print in a format for Wireshark ExtCap */
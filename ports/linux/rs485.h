@@ -65,6 +65,9 @@ extern "C" {
     void RS485_Check_UART_Data(
         volatile struct mstp_port_struct_t *mstp_port); /* port specific data */
     BACNET_STACK_EXPORT
+    void RS485_Receive_Frame_Block(
+        volatile struct mstp_port_struct_t *mstp_port); /* port specific data */
+    BACNET_STACK_EXPORT
     uint32_t RS485_Get_Port_Baud_Rate(
         volatile struct mstp_port_struct_t *mstp_port);
     BACNET_STACK_EXPORT
@@ -74,6 +77,15 @@ extern "C" {
     bool RS485_Set_Baud_Rate(
         uint32_t baud);
 
+    BACNET_STACK_EXPORT
+    bool RS485_Port_Initialize(
+        volatile struct mstp_port_struct_t *mstp_port,
+        char *ifname,
+        uint32_t baud);
+    BACNET_STACK_EXPORT
+    void RS485_Port_Cleanup(
+        volatile struct mstp_port_struct_t *mstp_port);
+
     BACNET_STACK_EXPORT
     void RS485_Cleanup(
         void);
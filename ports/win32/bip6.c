@@ -398,6 +398,58 @@ int bip6_send_mpdu(BACNET_IP6_ADDRESS *dest, uint8_t *mtu, uint16_t mtu_len)
         (struct sockaddr *)&bvlc_dest, sizeof(bvlc_dest));
 }
 
+/**
+ * The send function for the same MPDU to a list of destinations,
+ * such as the peers of a BBMD
+ *
+ * @param addr_list - array of destination addresses
+ * @param addr_count - number of destination addresses
+ * @param mtu - the bytes of data to send
+ * @param mtu_len - the number of bytes of data to send
+ *
+ * @return number of destinations the MPDU was sent to
+ */
+int bip6_send_mpdu_list(BACNET_IP6_ADDRESS *addr_list,
+    unsigned addr_count,
+    uint8_t *mtu,
+    uint16_t mtu_len)
+{
+    unsigned i = 0;
+    int sent = 0;
+
+    if (addr_list) {
+        for (i = 0; i < addr_count; i++) {
+            if (bip6_send_mpdu(&addr_list[i], mtu, mtu_len) > 0) {
+                sent++;
+            }
+        }
+    }
+
+    return sent;
+}
+
+/**
+ * Set the number of datagrams taken from the socket by each system call.
+ * This port receives one datagram for each call of bip6_receive().
+ *
+ * @param count - number of datagrams, which is not used
+ */
+void bip6_set_receive_batch(unsigned count)
+{
+    (void)count;
+}
+
+/**
+ * @brief Return the active BACnet/IPv6 socket.
+ * @return The active BACnet/IPv6 socket, or INVALID_SOCKET if uninitialized.
+ * @note Strictly, the return type should be SOCKET, however in practice
+ *  Windows never returns values large enough that truncation is an issue.
+ */
+int bip6_get_socket(void)
+{
+    return (int)BIP6_Socket;
+}
+
 /**
  * The common send function for BACnet/IPv6 application layer
  *
@@ -485,6 +485,200 @@ bool bacapp_decode_application_data_safe(uint8_t *new_apdu,
     return ret;
 }
 
+/**
+ * @brief Decode a BACnetARRAY or BACnetLIST of application tagged
+ *  primitive values of one type, such as Object_List or Priority_Array,
+ *  directly into a packed C array instead of a list of
+ *  BACNET_APPLICATION_DATA_VALUE.  The type of the array elements
+ *  depends on the expected application tag:
+ *
+ *      BACNET_APPLICATION_TAG_BOOLEAN      bool
+ *      BACNET_APPLICATION_TAG_UNSIGNED_INT BACNET_UNSIGNED_INTEGER
+ *      BACNET_APPLICATION_TAG_SIGNED_INT   int32_t
+ *      BACNET_APPLICATION_TAG_REAL         float
+ *      BACNET_APPLICATION_TAG_DOUBLE       double, if BACNET_USE_DOUBLE
+ *      BACNET_APPLICATION_TAG_ENUMERATED   uint32_t
+ *      BACNET_APPLICATION_TAG_OBJECT_ID    BACNET_OBJECT_ID
+ *
+ *  Runs of Object Identifier and REAL values, which always have the same
+ *  initial tag octet and length, are decoded without decoding each tag.
+ *
+ *  Decoding stops at the end of the buffer, at a closing tag, or when
+ *  the array is full.  A NULL element, as in a Priority_Array, is decoded
+ *  as zero and marked true in the null_array, or is an error when the
+ *  null_array is NULL.
+ *
+ * @param apdu - buffer of data to be decoded
+ * @param apdu_size - number of bytes in the buffer
+ * @param tag - expected application tag of the elements
+ * @param array - packed array of elements, or NULL for the length only
+ * @param null_array - optional array of NULL element flags, or NULL
+ * @param array_size - number of elements in the arrays
+ * @param count - number of elements decoded
+ *
+ * @return the number of apdu bytes decoded, or #BACNET_STATUS_ERROR if an
+ *  element is malformed or has another tag
+ */
+int bacapp_decode_array_packed(uint8_t *apdu,
+    uint32_t apdu_size,
+    uint8_t tag,
+    void *array,
+    bool *null_array,
+    uint32_t array_size,
+    uint32_t *count)
+{
+    uint32_t apdu_len = 0;
+    uint32_t index = 0;
+    uint32_t value32 = 0;
+    uint8_t fixed_tag = 0;
+    int len = 0;
+    BACNET_TAG element_tag = { 0 };
+    BACNET_OBJECT_ID *object_id = (BACNET_OBJECT_ID *)array;
+
+    if (tag == BACNET_APPLICATION_TAG_OBJECT_ID) {
+        fixed_tag = (BACNET_APPLICATION_TAG_OBJECT_ID << 4) | 4;
+    } else if (tag == BACNET_APPLICATION_TAG_REAL) {
+        fixed_tag = (BACNET_APPLICATION_TAG_REAL << 4) | 4;
+    }
+    while ((index < array_size) && (apdu_len < apdu_size)) {
+        if (fixed_tag && (apdu[apdu_len] == fixed_tag) &&
+            ((apdu_size - apdu_len) >= 5)) {
+            /* run of fixed size elements with the same tag octet */
+            while ((index < array_size) && ((apdu_size - apdu_len) >= 5) &&
+                (apdu[apdu_len] == fixed_tag)) {
+                if (array && (tag == BACNET_APPLICATION_TAG_OBJECT_ID)) {
+                    value32 = ((uint32_t)apdu[apdu_len + 1] << 24) |
+                        ((uint32_t)apdu[apdu_len + 2] << 16) |
+                        ((uint32_t)apdu[apdu_len + 3] << 8) |
+                        (uint32_t)apdu[apdu_len + 4];
+                    object_id[index].type =
+                        (BACNET_OBJECT_TYPE)BACNET_TYPE(value32);
+                    object_id[index].instance = BACNET_INSTANCE(value32);
+                } else if (array) {
+                    (void)bacnet_real_decode(&apdu[apdu_len + 1], 4, 4,
+                        &((float *)array)[index]);
+                }
+                if (null_array) {
+                    null_array[index] = false;
+                }
+                apdu_len += 5;
+                index++;
+            }
+            continue;
+        }
+        len = bacnet_tag_decode(&apdu[apdu_len], apdu_size - apdu_len,
+            &element_tag);
+        if (len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        if (element_tag.closing) {
+            break;
+        }
+        if (!element_tag.application) {
+            return BACNET_STATUS_ERROR;
+        }
+        apdu_len += len;
+        if (element_tag.number == BACNET_APPLICATION_TAG_NULL) {
+            if (!null_array) {
+                return BACNET_STATUS_ERROR;
+            }
+            null_array[index] = true;
+            len = 0;
+            if (array) {
+                switch (tag) {
+                    case BACNET_APPLICATION_TAG_BOOLEAN:
+                        ((bool *)array)[index] = false;
+                        break;
+                    case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+                        ((BACNET_UNSIGNED_INTEGER *)array)[index] = 0;
+                        break;
+                    case BACNET_APPLICATION_TAG_SIGNED_INT:
+                        ((int32_t *)array)[index] = 0;
+                        break;
+                    case BACNET_APPLICATION_TAG_REAL:
+                        ((float *)array)[index] = 0.0f;
+                        break;
+#if BACNET_USE_DOUBLE
+                    case BACNET_APPLICATION_TAG_DOUBLE:
+                        ((double *)array)[index] = 0.0;
+                        break;
+#endif
+                    case BACNET_APPLICATION_TAG_ENUMERATED:
+                        ((uint32_t *)array)[index] = 0;
+                        break;
+                    case BACNET_APPLICATION_TAG_OBJECT_ID:
+                        object_id[index].type = OBJECT_NONE;
+                        object_id[index].instance = BACNET_MAX_INSTANCE;
+                        break;
+                    default:
+                        return BACNET_STATUS_ERROR;
+                }
+            }
+        } else if (element_tag.number != tag) {
+            return BACNET_STATUS_ERROR;
+        } else {
+            if (null_array) {
+                null_array[index] = false;
+            }
+            switch (tag) {
+                case BACNET_APPLICATION_TAG_BOOLEAN:
+                    if (array) {
+                        ((bool *)array)[index] =
+                            decode_boolean(element_tag.len_value_type);
+                    }
+                    len = 0;
+                    break;
+                case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+                    len = bacnet_unsigned_decode(&apdu[apdu_len],
+                        apdu_size - apdu_len, element_tag.len_value_type,
+                        array ? &((BACNET_UNSIGNED_INTEGER *)array)[index]
+                              : NULL);
+                    break;
+                case BACNET_APPLICATION_TAG_SIGNED_INT:
+                    len = bacnet_signed_decode(&apdu[apdu_len],
+                        apdu_size - apdu_len, element_tag.len_value_type,
+                        array ? &((int32_t *)array)[index] : NULL);
+                    break;
+                case BACNET_APPLICATION_TAG_REAL:
+                    len = bacnet_real_decode(&apdu[apdu_len],
+                        apdu_size - apdu_len, element_tag.len_value_type,
+                        array ? &((float *)array)[index] : NULL);
+                    break;
+#if BACNET_USE_DOUBLE
+                case BACNET_APPLICATION_TAG_DOUBLE:
+                    len = bacnet_double_decode(&apdu[apdu_len],
+                        apdu_size - apdu_len, element_tag.len_value_type,
+                        array ? &((double *)array)[index] : NULL);
+                    break;
+#endif
+                case BACNET_APPLICATION_TAG_ENUMERATED:
+                    len = bacnet_enumerated_decode(&apdu[apdu_len],
+                        apdu_size - apdu_len, element_tag.len_value_type,
+                        array ? &((uint32_t *)array)[index] : NULL);
+                    break;
+                case BACNET_APPLICATION_TAG_OBJECT_ID:
+                    len = bacnet_object_id_decode(&apdu[apdu_len],
+                        apdu_size - apdu_len, element_tag.len_value_type,
+                        array ? &object_id[index].type : NULL,
+                        array ? &object_id[index].instance : NULL);
+                    break;
+                default:
+                    return BACNET_STATUS_ERROR;
+            }
+            if (len <= 0) {
+                return BACNET_STATUS_ERROR;
+            }
+        }
+        apdu_len += (uint32_t)len;
+        index++;
+    }
+    if (count) {
+        *count = index;
+    }
+
+    return (int)apdu_len;
+}
+
 /**
  * @brief Decode the data to determine the data length
  *  @param apdu  Pointer to the received data.
@@ -2997,6 +3191,81 @@ int bacapp_property_value_encode(uint8_t *apdu, BACNET_PROPERTY_VALUE *value)
     return apdu_len;
 }
 
+/**
+ * @brief Decode the property-identifier and property-array-index
+ *  of a BACnetPropertyValue
+ * @param apdu - buffer of data to be decoded
+ * @param apdu_size - number of bytes in the buffer
+ * @param property - decoded property identifier
+ * @param array_index - decoded array index, or BACNET_ARRAY_ALL
+ * @return number of bytes decoded, or #BACNET_STATUS_ERROR
+ */
+static int bacapp_property_value_reference_decode(uint8_t *apdu,
+    uint32_t apdu_size,
+    BACNET_PROPERTY_ID *property,
+    BACNET_ARRAY_INDEX *array_index)
+{
+    int len = 0;
+    int apdu_len = 0;
+    uint32_t enumerated_value = 0;
+    BACNET_UNSIGNED_INTEGER unsigned_value = 0;
+
+    /* property-identifier [0] BACnetPropertyIdentifier */
+    len = bacnet_enumerated_context_decode(
+        &apdu[apdu_len], apdu_size - apdu_len, 0, &enumerated_value);
+    if (len > 0) {
+        *property = (BACNET_PROPERTY_ID)enumerated_value;
+        apdu_len += len;
+    } else {
+        return BACNET_STATUS_ERROR;
+    }
+    /* property-array-index [1] Unsigned OPTIONAL */
+    if (bacnet_is_context_tag_number(
+            &apdu[apdu_len], apdu_size - apdu_len, 1, NULL)) {
+        len = bacnet_unsigned_context_decode(
+            &apdu[apdu_len], apdu_size - apdu_len, 1, &unsigned_value);
+        if ((len > 0) && (unsigned_value <= UINT32_MAX)) {
+            apdu_len += len;
+            *array_index = unsigned_value;
+        } else {
+            return BACNET_STATUS_ERROR;
+        }
+    } else {
+        *array_index = BACNET_ARRAY_ALL;
+    }
+
+    return apdu_len;
+}
+
+/**
+ * @brief Decode the optional priority of a BACnetPropertyValue
+ * @param apdu - buffer of data to be decoded
+ * @param apdu_size - number of bytes in the buffer
+ * @param priority - decoded priority, or BACNET_NO_PRIORITY
+ * @return number of bytes decoded, or #BACNET_STATUS_ERROR
+ */
+static int bacapp_property_value_priority_decode(
+    uint8_t *apdu, uint32_t apdu_size, uint8_t *priority)
+{
+    int len = 0;
+    BACNET_UNSIGNED_INTEGER unsigned_value = 0;
+
+    /* priority [3] Unsigned (1..16) OPTIONAL */
+    if (bacnet_is_context_tag_number(apdu, apdu_size, 3, NULL)) {
+        len = bacnet_unsigned_context_decode(
+            apdu, apdu_size, 3, &unsigned_value);
+        if ((len > 0) && (unsigned_value <= UINT8_MAX)) {
+            *priority = (uint8_t)unsigned_value;
+        } else {
+            return BACNET_STATUS_ERROR;
+        }
+    } else {
+        *priority = BACNET_NO_PRIORITY;
+    }
+
+    return len;
+}
+
 /**
  * @brief Decode one BACnetPropertyValue value
  *
@@ -3023,44 +3292,20 @@ int bacapp_property_value_decode(
     int len = 0;
     int apdu_len = 0;
     int tag_len = 0;
-    uint32_t enumerated_value = 0;
-    BACNET_UNSIGNED_INTEGER unsigned_value = 0;
     BACNET_PROPERTY_ID property_identifier = PROP_ALL;
+    BACNET_ARRAY_INDEX array_index = BACNET_ARRAY_ALL;
+    uint8_t priority = BACNET_NO_PRIORITY;
     BACNET_APPLICATION_DATA_VALUE *app_data = NULL;
 
-    /* property-identifier [0] BACnetPropertyIdentifier */
-    len = bacnet_enumerated_context_decode(
-        &apdu[apdu_len], apdu_size - apdu_len, 0, &enumerated_value);
-    if (len > 0) {
-        property_identifier = enumerated_value;
-        if (value) {
-            value->propertyIdentifier = property_identifier;
-        }
-        apdu_len += len;
-    } else {
+    len = bacapp_property_value_reference_decode(
+        apdu, apdu_size, &property_identifier, &array_index);
+    if (len < 0) {
         return BACNET_STATUS_ERROR;
     }
-    /* property-array-index [1] Unsigned OPTIONAL */
-    if (bacnet_is_context_tag_number(
-            &apdu[apdu_len], apdu_size - apdu_len, 1, NULL)) {
-        len = bacnet_unsigned_context_decode(
-            &apdu[apdu_len], apdu_size - apdu_len, 1, &unsigned_value);
-        if (len > 0) {
-            if (unsigned_value > UINT32_MAX) {
-                return BACNET_STATUS_ERROR;
-            } else {
-                apdu_len += len;
-                if (value) {
-                    value->propertyArrayIndex = unsigned_value;
-                }
-            }
-        } else {
-            return BACNET_STATUS_ERROR;
-        }
-    } else {
-        if (value) {
-            value->propertyArrayIndex = BACNET_ARRAY_ALL;
-        }
+    apdu_len += len;
+    if (value) {
+        value->propertyIdentifier = property_identifier;
+        value->propertyArrayIndex = array_index;
     }
     /* property-value [2] ABSTRACT-SYNTAX.&Type */
     if (bacnet_is_opening_tag_number(
@@ -3102,32 +3347,492 @@ int bacapp_property_value_decode(
     } else {
         return BACNET_STATUS_ERROR;
     }
-    /* priority [3] Unsigned (1..16) OPTIONAL */
-    if (bacnet_is_context_tag_number(
-            &apdu[apdu_len], apdu_size - apdu_len, 3, NULL)) {
-        len = bacnet_unsigned_context_decode(
-            &apdu[apdu_len], apdu_size - apdu_len, 3, &unsigned_value);
-        if (len > 0) {
-            if (unsigned_value > UINT8_MAX) {
-                return BACNET_STATUS_ERROR;
-            } else {
-                apdu_len += len;
-                if (value) {
-                    value->priority = unsigned_value;
-                }
-            }
-        } else {
+    len = bacapp_property_value_priority_decode(
+        &apdu[apdu_len], apdu_size - apdu_len, &priority);
+    if (len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    apdu_len += len;
+    if (value) {
+        value->priority = priority;
+    }
+
+    return apdu_len;
+}
+
+/**
+ * @brief Get the length of a single application tagged value that is
+ *  followed by a closing tag, without walking nested data
+ * @param apdu - buffer holding the value after the opening tag
+ * @param apdu_size - number of bytes in the buffer
+ * @param tag_number - number of the closing tag
+ * @return length of the value, or #BACNET_STATUS_ERROR if the data is
+ *  not a single application tagged value
+ */
+static int bacapp_compact_value_data_len(
+    uint8_t *apdu, uint32_t apdu_size, uint8_t tag_number)
+{
+    BACNET_TAG tag = { 0 };
+    int len;
+
+    len = bacnet_tag_decode(apdu, apdu_size, &tag);
+    if ((len <= 0) || !tag.application) {
+        return BACNET_STATUS_ERROR;
+    }
+    if (tag.number != BACNET_APPLICATION_TAG_BOOLEAN) {
+        if (tag.len_value_type > (apdu_size - len)) {
             return BACNET_STATUS_ERROR;
         }
+        len += tag.len_value_type;
+    }
+    if (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_size - len, tag_number, NULL)) {
+        return BACNET_STATUS_ERROR;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Decode a BACnetPropertyValue into a compact value.  The value
+ *  holds primitive data inline, and points into the buffer otherwise.
+ * @param apdu - buffer of data to be decoded
+ * @param apdu_size - number of bytes in the buffer
+ * @param value - decoded value, or NULL for the length only
+ * @return number of bytes decoded, or #BACNET_STATUS_ERROR
+ */
+int bacapp_property_compact_value_decode(
+    uint8_t *apdu, uint32_t apdu_size, BACNET_PROPERTY_COMPACT_VALUE *value)
+{
+    int len = 0;
+    int apdu_len = 0;
+    int tag_len = 0;
+    BACNET_PROPERTY_ID property_identifier = PROP_ALL;
+    BACNET_ARRAY_INDEX array_index = BACNET_ARRAY_ALL;
+    uint8_t priority = BACNET_NO_PRIORITY;
+
+    if (!apdu) {
+        return BACNET_STATUS_ERROR;
+    }
+    len = bacapp_property_value_reference_decode(
+        apdu, apdu_size, &property_identifier, &array_index);
+    if (len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    apdu_len += len;
+    /* property-value [2] ABSTRACT-SYNTAX.&Type */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[apdu_len], apdu_size - apdu_len, 2, &tag_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len = bacapp_compact_value_data_len(&apdu[apdu_len + tag_len],
+        apdu_size - apdu_len - tag_len, 2);
+    if (len < 0) {
+        /* returns the length between the tags */
+        len = bacapp_data_len(
+            &apdu[apdu_len], apdu_size - apdu_len, property_identifier);
+        if (len < 0) {
+            return BACNET_STATUS_ERROR;
+        }
+    }
+    apdu_len += tag_len;
+    if (value) {
+        if (bacapp_compact_value_decode(
+                &apdu[apdu_len], (uint32_t)len, &value->value) < 0) {
+            return BACNET_STATUS_ERROR;
+        }
+    }
+    apdu_len += len;
+    if (bacnet_is_closing_tag_number(
+            &apdu[apdu_len], apdu_size - apdu_len, 2, &len)) {
+        apdu_len += len;
     } else {
-        if (value) {
-            value->priority = BACNET_NO_PRIORITY;
+        return BACNET_STATUS_ERROR;
+    }
+    len = bacapp_property_value_priority_decode(
+        &apdu[apdu_len], apdu_size - apdu_len, &priority);
+    if (len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    apdu_len += len;
+    if (value) {
+        value->propertyIdentifier = property_identifier;
+        value->propertyArrayIndex = array_index;
+        value->priority = priority;
+    }
+
+    return apdu_len;
+}
+
+/**
+ * @brief Decode the data of a value into a compact value.  A single
+ *  primitive value is held inline.  A string, a constructed value or a
+ *  list of values is held as its encoding, which points into the buffer.
+ * @param apdu - buffer holding only the data of the value, such as the
+ *  data between the opening and closing tags of a property value
+ * @param apdu_size - number of bytes of data
+ * @param value - decoded value
+ * @return number of bytes decoded, or #BACNET_STATUS_ERROR
+ */
+int bacapp_compact_value_decode(
+    uint8_t *apdu, uint32_t apdu_size, BACNET_COMPACT_VALUE *value)
+{
+    BACNET_TAG tag = { 0 };
+    int tag_len = 0;
+    int len = BACNET_STATUS_ERROR;
+
+    if (!value || (!apdu && apdu_size)) {
+        return BACNET_STATUS_ERROR;
+    }
+    memset(value, 0, sizeof(*value));
+    if (apdu_size) {
+        tag_len = bacnet_tag_decode(apdu, apdu_size, &tag);
+        if (tag_len <= 0) {
+            return BACNET_STATUS_ERROR;
         }
     }
+    if (tag_len && tag.application) {
+        switch (tag.number) {
+            case BACNET_APPLICATION_TAG_NULL:
+                len = 0;
+                break;
+            case BACNET_APPLICATION_TAG_BOOLEAN:
+                value->type.Boolean = decode_boolean(tag.len_value_type);
+                len = 0;
+                break;
+            case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+                len = bacnet_unsigned_decode(&apdu[tag_len],
+                    apdu_size - tag_len, tag.len_value_type,
+                    &value->type.Unsigned_Int);
+                break;
+            case BACNET_APPLICATION_TAG_SIGNED_INT:
+                len = bacnet_signed_decode(&apdu[tag_len],
+                    apdu_size - tag_len, tag.len_value_type,
+                    &value->type.Signed_Int);
+                break;
+            case BACNET_APPLICATION_TAG_REAL:
+                len = bacnet_real_decode(&apdu[tag_len], apdu_size - tag_len,
+                    tag.len_value_type, &value->type.Real);
+                break;
+#if BACNET_USE_DOUBLE
+            case BACNET_APPLICATION_TAG_DOUBLE:
+                len = bacnet_double_decode(&apdu[tag_len],
+                    apdu_size - tag_len, tag.len_value_type,
+                    &value->type.Double);
+                break;
+#endif
+            case BACNET_APPLICATION_TAG_ENUMERATED:
+                len = bacnet_enumerated_decode(&apdu[tag_len],
+                    apdu_size - tag_len, tag.len_value_type,
+                    &value->type.Enumerated);
+                break;
+            case BACNET_APPLICATION_TAG_DATE:
+                len = bacnet_date_decode(&apdu[tag_len], apdu_size - tag_len,
+                    tag.len_value_type, &value->type.Date);
+                break;
+            case BACNET_APPLICATION_TAG_TIME:
+                len = bacnet_time_decode(&apdu[tag_len], apdu_size - tag_len,
+                    tag.len_value_type, &value->type.Time);
+                break;
+            case BACNET_APPLICATION_TAG_OBJECT_ID:
+                len = bacnet_object_id_decode(&apdu[tag_len],
+                    apdu_size - tag_len, tag.len_value_type,
+                    &value->type.Object_Id.type,
+                    &value->type.Object_Id.instance);
+                break;
+            default:
+                /* strings are held as their encoding */
+                len = BACNET_STATUS_ERROR;
+                break;
+        }
+        if ((len == 0) && (tag.number != BACNET_APPLICATION_TAG_NULL) &&
+            (tag.number != BACNET_APPLICATION_TAG_BOOLEAN)) {
+            /* malformed primitive */
+            return BACNET_STATUS_ERROR;
+        }
+        if ((len >= 0) && ((uint32_t)(tag_len + len) == apdu_size)) {
+            value->tag = tag.number;
+            return (int)apdu_size;
+        }
+    }
+    /* a single application tagged string keeps its tag */
+    if (tag_len && tag.application &&
+        (tag.len_value_type == (apdu_size - tag_len))) {
+        value->tag = tag.number;
+    } else {
+        memset(&value->type, 0, sizeof(value->type));
+        value->tag = MAX_BACNET_APPLICATION_TAG;
+    }
+    value->encoded = true;
+    value->type.Encoding.data = apdu;
+    value->type.Encoding.length = apdu_size;
+
+    return (int)apdu_size;
+}
+
+/**
+ * @brief Encode a compact value as the data of a value
+ * @param apdu - buffer for the encoding, or NULL for the length only
+ * @param value - compact value to encode
+ * @return number of bytes encoded, or #BACNET_STATUS_ERROR
+ */
+int bacapp_compact_value_encode(uint8_t *apdu, BACNET_COMPACT_VALUE *value)
+{
+    int apdu_len = BACNET_STATUS_ERROR;
+
+    if (!value) {
+        return BACNET_STATUS_ERROR;
+    }
+    if (value->encoded) {
+        if (apdu && value->type.Encoding.length) {
+            memcpy(apdu, value->type.Encoding.data,
+                value->type.Encoding.length);
+        }
+        return (int)value->type.Encoding.length;
+    }
+    switch (value->tag) {
+        case BACNET_APPLICATION_TAG_NULL:
+            apdu_len = encode_application_null(apdu);
+            break;
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            apdu_len = encode_application_boolean(apdu, value->type.Boolean);
+            break;
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            apdu_len =
+                encode_application_unsigned(apdu, value->type.Unsigned_Int);
+            break;
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            apdu_len = encode_application_signed(apdu, value->type.Signed_Int);
+            break;
+        case BACNET_APPLICATION_TAG_REAL:
+            apdu_len = encode_application_real(apdu, value->type.Real);
+            break;
+#if BACNET_USE_DOUBLE
+        case BACNET_APPLICATION_TAG_DOUBLE:
+            apdu_len = encode_application_double(apdu, value->type.Double);
+            break;
+#endif
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            apdu_len =
+                encode_application_enumerated(apdu, value->type.Enumerated);
+            break;
+        case BACNET_APPLICATION_TAG_DATE:
+            apdu_len = encode_application_date(apdu, &value->type.Date);
+            break;
+        case BACNET_APPLICATION_TAG_TIME:
+            apdu_len = encode_application_time(apdu, &value->type.Time);
+            break;
+        case BACNET_APPLICATION_TAG_OBJECT_ID:
+            apdu_len = encode_application_object_id(apdu,
+                value->type.Object_Id.type, value->type.Object_Id.instance);
+            break;
+        default:
+            break;
+    }
 
     return apdu_len;
 }
 
+/**
+ * @brief Convert a compact value to application data values.  A value
+ *  held as its encoding is decoded as a known property, and a list of
+ *  values needs a linked list of application data values to hold it.
+ * @param compact - compact value to convert
+ * @param object_type - object type of the property
+ * @param property - property identifier of the value
+ * @param value - application data value, or a linked list of them
+ * @return true if the whole value was converted
+ */
+bool bacapp_compact_value_to_value(BACNET_COMPACT_VALUE *compact,
+    BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID property,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    BACNET_APPLICATION_DATA_VALUE *app_data = value;
+    uint8_t *apdu;
+    uint32_t apdu_size;
+    uint32_t apdu_len = 0;
+    int len;
+
+    if (!compact || !value) {
+        return false;
+    }
+    value->context_specific = false;
+    value->context_tag = 0;
+    if (!compact->encoded) {
+        value->tag = compact->tag;
+        switch (compact->tag) {
+            case BACNET_APPLICATION_TAG_NULL:
+                break;
+#if defined(BACAPP_BOOLEAN)
+            case BACNET_APPLICATION_TAG_BOOLEAN:
+                value->type.Boolean = compact->type.Boolean;
+                break;
+#endif
+#if defined(BACAPP_UNSIGNED)
+            case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+                value->type.Unsigned_Int = compact->type.Unsigned_Int;
+                break;
+#endif
+#if defined(BACAPP_SIGNED)
+            case BACNET_APPLICATION_TAG_SIGNED_INT:
+                value->type.Signed_Int = compact->type.Signed_Int;
+                break;
+#endif
+#if defined(BACAPP_REAL)
+            case BACNET_APPLICATION_TAG_REAL:
+                value->type.Real = compact->type.Real;
+                break;
+#endif
+#if defined(BACAPP_DOUBLE)
+            case BACNET_APPLICATION_TAG_DOUBLE:
+                value->type.Double = compact->type.Double;
+                break;
+#endif
+#if defined(BACAPP_ENUMERATED)
+            case BACNET_APPLICATION_TAG_ENUMERATED:
+                value->type.Enumerated = compact->type.Enumerated;
+                break;
+#endif
+#if defined(BACAPP_DATE)
+            case BACNET_APPLICATION_TAG_DATE:
+                value->type.Date = compact->type.Date;
+                break;
+#endif
+#if defined(BACAPP_TIME)
+            case BACNET_APPLICATION_TAG_TIME:
+                value->type.Time = compact->type.Time;
+                break;
+#endif
+#if defined(BACAPP_OBJECT_ID)
+            case BACNET_APPLICATION_TAG_OBJECT_ID:
+                value->type.Object_Id = compact->type.Object_Id;
+                break;
+#endif
+            default:
+                return false;
+        }
+        return true;
+    }
+    apdu = compact->type.Encoding.data;
+    apdu_size = compact->type.Encoding.length;
+    if (apdu_size == 0) {
+        /* an empty list is decoded as NULL */
+        value->tag = BACNET_APPLICATION_TAG_NULL;
+        return true;
+    }
+    while (app_data && (apdu_len < apdu_size)) {
+        len = bacapp_decode_known_property(&apdu[apdu_len],
+            (int)(apdu_size - apdu_len), app_data, object_type, property);
+        if (len <= 0) {
+            return false;
+        }
+        apdu_len += (uint32_t)len;
+        app_data = app_data->next;
+    }
+
+    return (apdu_len == apdu_size);
+}
+
+/**
+ * @brief Convert an application data value to a compact value.  Strings
+ *  and constructed values are encoded into the buffer, which must
+ *  outlive the compact value.
+ * @param compact - compact value
+ * @param value - application data value to convert
+ * @param buffer - buffer for the encoding of the value
+ * @param buffer_size - number of bytes in the buffer
+ * @return number of bytes of the buffer used, or #BACNET_STATUS_ERROR
+ */
+int bacapp_compact_value_from_value(BACNET_COMPACT_VALUE *compact,
+    BACNET_APPLICATION_DATA_VALUE *value,
+    uint8_t *buffer,
+    uint32_t buffer_size)
+{
+    int len;
+
+    if (!compact || !value) {
+        return BACNET_STATUS_ERROR;
+    }
+    memset(compact, 0, sizeof(*compact));
+    if (!value->context_specific) {
+        compact->tag = value->tag;
+        switch (value->tag) {
+            case BACNET_APPLICATION_TAG_NULL:
+                return 0;
+#if defined(BACAPP_BOOLEAN)
+            case BACNET_APPLICATION_TAG_BOOLEAN:
+                compact->type.Boolean = value->type.Boolean;
+                return 0;
+#endif
+#if defined(BACAPP_UNSIGNED)
+            case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+                compact->type.Unsigned_Int = value->type.Unsigned_Int;
+                return 0;
+#endif
+#if defined(BACAPP_SIGNED)
+            case BACNET_APPLICATION_TAG_SIGNED_INT:
+                compact->type.Signed_Int = value->type.Signed_Int;
+                return 0;
+#endif
+#if defined(BACAPP_REAL)
+            case BACNET_APPLICATION_TAG_REAL:
+                compact->type.Real = value->type.Real;
+                return 0;
+#endif
+#if defined(BACAPP_DOUBLE)
+            case BACNET_APPLICATION_TAG_DOUBLE:
+                compact->type.Double = value->type.Double;
+                return 0;
+#endif
+#if defined(BACAPP_ENUMERATED)
+            case BACNET_APPLICATION_TAG_ENUMERATED:
+                compact->type.Enumerated = value->type.Enumerated;
+                return 0;
+#endif
+#if defined(BACAPP_DATE)
+            case BACNET_APPLICATION_TAG_DATE:
+                compact->type.Date = value->type.Date;
+                return 0;
+#endif
+#if defined(BACAPP_TIME)
+            case BACNET_APPLICATION_TAG_TIME:
+                compact->type.Time = value->type.Time;
+                return 0;
+#endif
+#if defined(BACAPP_OBJECT_ID)
+            case BACNET_APPLICATION_TAG_OBJECT_ID:
+                compact->type.Object_Id = value->type.Object_Id;
+                return 0;
+#endif
+            default:
+                break;
+        }
+    }
+    /* everything else is held as its encoding */
+    if (value->context_specific) {
+        len = bacapp_encode_context_data_value(NULL, value->context_tag, value);
+    } else {
+        len = bacapp_encode_application_data(NULL, value);
+    }
+    if ((len <= 0) || ((uint32_t)len > buffer_size) || !buffer) {
+        return BACNET_STATUS_ERROR;
+    }
+    if (value->context_specific) {
+        len = bacapp_encode_context_data_value(buffer, value->context_tag, value);
+        compact->context_specific = true;
+        compact->context_tag = value->context_tag;
+        compact->tag = MAX_BACNET_APPLICATION_TAG;
+    } else {
+        len = bacapp_encode_application_data(buffer, value);
+    }
+    compact->encoded = true;
+    compact->type.Encoding.data = buffer;
+    compact->type.Encoding.length = (uint32_t)len;
+
+    return len;
+}
+
 /* generic - can be used by other unit tests
    returns true if matching or same, false if different */
 bool bacapp_same_value(BACNET_APPLICATION_DATA_VALUE *value,
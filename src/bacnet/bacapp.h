@@ -103,6 +103,35 @@ typedef struct BACnet_Application_Data_Value {
     struct BACnet_Application_Data_Value *next;
 } BACNET_APPLICATION_DATA_VALUE;
 
+/* A compact application value for high volume decoding, a few words in
+   size.  Primitive values are held inline.  Strings and constructed
+   values are held as their encoding, which points into the buffer they
+   were decoded from, so the buffer must outlive the value. */
+typedef struct BACnet_Compact_Value {
+    bool context_specific;      /* true if context specific data */
+    uint8_t context_tag;        /* only used for context specific data */
+    /* application tag data type, or MAX_BACNET_APPLICATION_TAG
+       for a constructed value or a list of values */
+    uint8_t tag;
+    /* true if the value is held as its encoding */
+    bool encoded;
+    union {
+        bool Boolean;
+        BACNET_UNSIGNED_INTEGER Unsigned_Int;
+        int32_t Signed_Int;
+        float Real;
+        double Double;
+        uint32_t Enumerated;
+        BACNET_DATE Date;
+        BACNET_TIME Time;
+        BACNET_OBJECT_ID Object_Id;
+        struct {
+            uint8_t *data;
+            uint32_t length;
+        } Encoding;
+    } type;
+} BACNET_COMPACT_VALUE;
+
 struct BACnet_Access_Error;
 typedef struct BACnet_Access_Error {
     BACNET_ERROR_CLASS error_class;
@@ -132,6 +161,16 @@ typedef struct BACnet_Property_Value {
     struct BACnet_Property_Value *next;
 } BACNET_PROPERTY_VALUE;
 
+struct BACnet_Property_Compact_Value;
+typedef struct BACnet_Property_Compact_Value {
+    BACNET_PROPERTY_ID propertyIdentifier;
+    BACNET_ARRAY_INDEX propertyArrayIndex;
+    BACNET_COMPACT_VALUE value;
+    uint8_t priority;
+    /* simple linked list */
+    struct BACnet_Property_Compact_Value *next;
+} BACNET_PROPERTY_COMPACT_VALUE;
+
 /* used for printing values */
 struct BACnet_Object_Property_Value;
 typedef struct BACnet_Object_Property_Value {
@@ -170,6 +209,34 @@ extern "C" {
         uint32_t apdu_size,
         BACNET_PROPERTY_VALUE *value);
 
+    BACNET_STACK_EXPORT
+    int bacapp_property_compact_value_decode(
+        uint8_t *apdu,
+        uint32_t apdu_size,
+        BACNET_PROPERTY_COMPACT_VALUE *value);
+
+    BACNET_STACK_EXPORT
+    int bacapp_compact_value_decode(
+        uint8_t *apdu,
+        uint32_t apdu_size,
+        BACNET_COMPACT_VALUE *value);
+    BACNET_STACK_EXPORT
+    int bacapp_compact_value_encode(
+        uint8_t *apdu,
+        BACNET_COMPACT_VALUE *value);
+    BACNET_STACK_EXPORT
+    bool bacapp_compact_value_to_value(
+        BACNET_COMPACT_VALUE *compact,
+        BACNET_OBJECT_TYPE object_type,
+        BACNET_PROPERTY_ID property,
+        BACNET_APPLICATION_DATA_VALUE *value);
+    BACNET_STACK_EXPORT
+    int bacapp_compact_value_from_value(
+        BACNET_COMPACT_VALUE *compact,
+        BACNET_APPLICATION_DATA_VALUE *value,
+        uint8_t *buffer,
+        uint32_t buffer_size);
+
     BACNET_STACK_EXPORT
     int bacapp_encode_data(
         uint8_t * apdu,
@@ -193,6 +260,16 @@ extern "C" {
         uint32_t new_apdu_len,
         BACNET_APPLICATION_DATA_VALUE * value);
 
+    BACNET_STACK_EXPORT
+    int bacapp_decode_array_packed(
+        uint8_t *apdu,
+        uint32_t apdu_size,
+        uint8_t tag,
+        void *array,
+        bool *null_array,
+        uint32_t array_size,
+        uint32_t *count);
+
     BACNET_STACK_EXPORT
     int bacapp_encode_application_data(
         uint8_t * apdu,
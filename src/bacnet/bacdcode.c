@@ -490,73 +490,84 @@ int bacnet_tag_number_decode(
  */
 int bacnet_tag_decode(uint8_t *apdu, uint32_t apdu_size, BACNET_TAG *tag)
 {
-    int len = 0;
-    uint8_t tag_number = 0;
-    bool application_tag = false;
-    bool context_tag = false;
-    bool opening_tag = false;
-    bool closing_tag = false;
+    uint8_t octet;
+    uint8_t tag_number;
     uint32_t len_value_type = 0;
+    uint32_t len = 1;
 
-    len = bacnet_tag_number_decode(&apdu[0], apdu_size, &tag_number);
-    if (len > 0) {
-        if (IS_EXTENDED_VALUE(apdu[0])) {
-            if (apdu_size > len) {
-                apdu_size -= len;
-                if ((apdu[len] == 255) && (apdu_size >= 5)) {
-                    /* tagged as uint32_t */
-                    uint32_t value32;
-                    len++;
-                    len += decode_unsigned32(&apdu[len], &value32);
-                    len_value_type = value32;
-                } else if ((apdu[len] == 254) && (apdu_size >= 3)) {
-                    /* tagged as uint16_t */
-                    uint16_t value16;
-                    len++;
-                    len += decode_unsigned16(&apdu[len], &value16);
-                    len_value_type = value16;
-                } else if ((apdu[len] < 254) && (apdu_size >= 1)) {
-                    /* no tag - must be uint8_t */
-                    len_value_type = apdu[len];
-                    len++;
-                } else {
-                    /* packet is malformed */
-                    len = 0;
+    if (!apdu || (apdu_size < 1)) {
+        return 0;
+    }
+    /* the initial octet is read once and holds everything except
+       an extended tag number and an extended length */
+    octet = apdu[0];
+    tag_number = (uint8_t)(octet >> 4);
+    if (IS_EXTENDED_TAG_NUMBER(octet)) {
+        if (apdu_size < 2) {
+            /* malformed */
+            return 0;
+        }
+        tag_number = apdu[1];
+        len = 2;
+    }
+    switch (octet & 0x07) {
+        case 5:
+            /* extended length */
+            if (apdu_size <= len) {
+                /* malformed */
+                return 0;
+            }
+            if (apdu[len] == 255) {
+                /* tagged as uint32_t */
+                if ((apdu_size - len) < 5) {
+                    return 0;
+                }
+                len_value_type = ((uint32_t)apdu[len + 1] << 24) |
+                    ((uint32_t)apdu[len + 2] << 16) |
+                    ((uint32_t)apdu[len + 3] << 8) | (uint32_t)apdu[len + 4];
+                len += 5;
+            } else if (apdu[len] == 254) {
+                /* tagged as uint16_t */
+                if ((apdu_size - len) < 3) {
+                    return 0;
                 }
+                len_value_type =
+                    ((uint32_t)apdu[len + 1] << 8) | (uint32_t)apdu[len + 2];
+                len += 3;
             } else {
-                /* packet is malformed */
-                len = 0;
+                /* no tag - must be uint8_t */
+                len_value_type = apdu[len];
+                len++;
             }
-        } else if (IS_OPENING_TAG(apdu[0])) {
-            /* reserved value */
-        } else if (IS_CLOSING_TAG(apdu[0])) {
-            /* reserved value */
-        } else {
+            break;
+        case 6:
+        case 7:
+            /* opening and closing tags; reserved for application tags */
+            break;
+        default:
             /* small value */
-            len_value_type = apdu[0] & 0x07;
-        }
-        if (IS_CONTEXT_SPECIFIC(apdu[0])) {
-            if (IS_OPENING_TAG(apdu[0])) {
-                opening_tag = true;
-            } else if (IS_CLOSING_TAG(apdu[0])) {
-                closing_tag = true;
+            len_value_type = octet & 0x07;
+            break;
+    }
+    if (tag) {
+        tag->number = tag_number;
+        tag->application = !IS_CONTEXT_SPECIFIC(octet);
+        tag->context = false;
+        tag->opening = false;
+        tag->closing = false;
+        if (IS_CONTEXT_SPECIFIC(octet)) {
+            if (IS_OPENING_TAG(octet)) {
+                tag->opening = true;
+            } else if (IS_CLOSING_TAG(octet)) {
+                tag->closing = true;
             } else {
-                context_tag = true;
+                tag->context = true;
             }
-        } else {
-            application_tag = true;
-        }
-        if ((len > 0) && tag) {
-            tag->number = tag_number;
-            tag->application = application_tag;
-            tag->context = context_tag;
-            tag->opening = opening_tag;
-            tag->closing = closing_tag;
-            tag->len_value_type = len_value_type;
         }
+        tag->len_value_type = len_value_type;
     }
 
-    return len;
+    return (int)len;
 }
 
 /**
@@ -800,11 +811,18 @@ bool bacnet_is_context_tag_number(
 {
     bool match = false;
     int len;
-    BACNET_TAG tag = { 0 };
+    uint8_t my_tag_number = 0;
 
-    len = bacnet_tag_decode(apdu, apdu_size, &tag);
-    if (len > 0) {
-        if (tag.context && (tag.number == tag_number)) {
+    /* most probes fail, so check the class and the tag number
+       before decoding any extended length */
+    if (!apdu || (apdu_size < 1) || !IS_CONTEXT_SPECIFIC(apdu[0]) ||
+        IS_OPENING_TAG(apdu[0]) || IS_CLOSING_TAG(apdu[0])) {
+        return false;
+    }
+    len = bacnet_tag_number_decode(apdu, apdu_size, &my_tag_number);
+    if ((len > 0) && (my_tag_number == tag_number)) {
+        len = bacnet_tag_decode(apdu, apdu_size, NULL);
+        if (len > 0) {
             if (tag_length) {
                 *tag_length = len;
             }
@@ -856,11 +874,13 @@ bool bacnet_is_opening_tag_number(
 {
     bool match = false;
     int len;
-    BACNET_TAG tag = { 0 };
+    uint8_t my_tag_number = 0;
 
-    len = bacnet_tag_decode(apdu, apdu_size, &tag);
-    if (len > 0) {
-        if (tag.opening && (tag.number == tag_number)) {
+    /* opening tags have no length octets, so the tag number is all
+       that is left to decode */
+    if (apdu && (apdu_size > 0) && ((apdu[0] & 0x0F) == 0x0E)) {
+        len = bacnet_tag_number_decode(apdu, apdu_size, &my_tag_number);
+        if ((len > 0) && (my_tag_number == tag_number)) {
             match = true;
             if (tag_length) {
                 *tag_length = len;
@@ -910,11 +930,13 @@ bool bacnet_is_closing_tag_number(
 {
     bool match = false;
     int len;
-    BACNET_TAG tag = { 0 };
+    uint8_t my_tag_number = 0;
 
-    len = bacnet_tag_decode(apdu, apdu_size, &tag);
-    if (len > 0) {
-        if (tag.closing && (tag.number == tag_number)) {
+    /* closing tags have no length octets, so the tag number is all
+       that is left to decode */
+    if (apdu && (apdu_size > 0) && ((apdu[0] & 0x0F) == 0x0F)) {
+        len = bacnet_tag_number_decode(apdu, apdu_size, &my_tag_number);
+        if ((len > 0) && (my_tag_number == tag_number)) {
             match = true;
             if (tag_length) {
                 *tag_length = len;
@@ -925,6 +947,241 @@ bool bacnet_is_closing_tag_number(
     return match;
 }
 
+/**
+ * @brief Start a tag cursor at the beginning of a buffer
+ * @param cursor - cursor to initialize
+ * @param apdu - buffer of tagged data
+ * @param apdu_size - number of bytes in the buffer
+ */
+void bacnet_tag_cursor_init(
+    BACNET_TAG_CURSOR *cursor, uint8_t *apdu, uint32_t apdu_size)
+{
+    if (cursor) {
+        cursor->apdu = apdu;
+        cursor->apdu_size = apdu ? apdu_size : 0;
+        cursor->offset = 0;
+        cursor->tag_len = 0;
+    }
+}
+
+/**
+ * @brief Get the tag at the cursor, decoding it the first time only
+ * @param cursor - tag cursor
+ * @return the tag, or NULL at the end of the buffer or if malformed
+ */
+const BACNET_TAG *bacnet_tag_cursor_peek(BACNET_TAG_CURSOR *cursor)
+{
+    if (!cursor) {
+        return NULL;
+    }
+    if (cursor->tag_len == 0) {
+        if (cursor->offset >= cursor->apdu_size) {
+            return NULL;
+        }
+        cursor->tag_len = bacnet_tag_decode(&cursor->apdu[cursor->offset],
+            cursor->apdu_size - cursor->offset, &cursor->tag);
+        if (cursor->tag_len <= 0) {
+            cursor->tag_len = BACNET_STATUS_ERROR;
+        }
+    }
+    if (cursor->tag_len < 0) {
+        return NULL;
+    }
+
+    return &cursor->tag;
+}
+
+/**
+ * @brief Test the tag at the cursor for an opening tag
+ * @param cursor - tag cursor
+ * @param tag_number - opening tag number expected
+ * @return true if the tag at the cursor is the opening tag
+ */
+bool bacnet_tag_cursor_is_opening(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number)
+{
+    const BACNET_TAG *tag = bacnet_tag_cursor_peek(cursor);
+
+    return tag && tag->opening && (tag->number == tag_number);
+}
+
+/**
+ * @brief Test the tag at the cursor for a closing tag
+ * @param cursor - tag cursor
+ * @param tag_number - closing tag number expected
+ * @return true if the tag at the cursor is the closing tag
+ */
+bool bacnet_tag_cursor_is_closing(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number)
+{
+    const BACNET_TAG *tag = bacnet_tag_cursor_peek(cursor);
+
+    return tag && tag->closing && (tag->number == tag_number);
+}
+
+/**
+ * @brief Test the tag at the cursor for a context tag with a value
+ * @param cursor - tag cursor
+ * @param tag_number - context tag number expected
+ * @return true if the tag at the cursor is the context tag
+ */
+bool bacnet_tag_cursor_is_context(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number)
+{
+    const BACNET_TAG *tag = bacnet_tag_cursor_peek(cursor);
+
+    return tag && tag->context && (tag->number == tag_number);
+}
+
+/**
+ * @brief Move the cursor past the tag and any value it holds.
+ *  Opening and closing tags are skipped alone, not with the
+ *  data they enclose.
+ * @param cursor - tag cursor
+ * @return true if the cursor moved, false at the end or if malformed
+ */
+bool bacnet_tag_cursor_next(BACNET_TAG_CURSOR *cursor)
+{
+    const BACNET_TAG *tag = bacnet_tag_cursor_peek(cursor);
+    uint32_t len;
+
+    if (!tag) {
+        return false;
+    }
+    len = (uint32_t)cursor->tag_len;
+    if (tag->opening || tag->closing ||
+        (tag->application &&
+            (tag->number == BACNET_APPLICATION_TAG_BOOLEAN))) {
+        /* no value octets */
+    } else if (tag->len_value_type <=
+        (cursor->apdu_size - cursor->offset - len)) {
+        len += tag->len_value_type;
+    } else {
+        cursor->tag_len = BACNET_STATUS_ERROR;
+        return false;
+    }
+    cursor->offset += len;
+    cursor->tag_len = 0;
+
+    return true;
+}
+
+/**
+ * @brief Get the value of the tag at the cursor, and the space left
+ * @param cursor - tag cursor
+ * @param apdu_size - number of bytes left after the tag
+ * @return the value octets, or NULL if the tag has no value
+ */
+static uint8_t *bacnet_tag_cursor_value(
+    BACNET_TAG_CURSOR *cursor, uint32_t *apdu_size)
+{
+    const BACNET_TAG *tag = bacnet_tag_cursor_peek(cursor);
+    uint32_t offset;
+
+    if (!tag || tag->opening || tag->closing) {
+        return NULL;
+    }
+    offset = cursor->offset + (uint32_t)cursor->tag_len;
+    *apdu_size = cursor->apdu_size - offset;
+
+    return &cursor->apdu[offset];
+}
+
+/**
+ * @brief Decode the tag at the cursor as an unsigned value, and move
+ *  the cursor past it.  The caller checks the tag number first.
+ * @param cursor - tag cursor
+ * @param value - the unsigned value decoded
+ * @return number of bytes decoded, or #BACNET_STATUS_ERROR (-1)
+ *  if the tag is not a value or is malformed
+ */
+int bacnet_tag_cursor_unsigned_decode(
+    BACNET_TAG_CURSOR *cursor, BACNET_UNSIGNED_INTEGER *value)
+{
+    uint8_t *apdu;
+    uint32_t apdu_size = 0;
+    int len;
+
+    apdu = bacnet_tag_cursor_value(cursor, &apdu_size);
+    if (!apdu) {
+        return BACNET_STATUS_ERROR;
+    }
+    len = bacnet_unsigned_decode(
+        apdu, apdu_size, cursor->tag.len_value_type, value);
+    if (len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += cursor->tag_len;
+    cursor->offset += (uint32_t)len;
+    cursor->tag_len = 0;
+
+    return len;
+}
+
+/**
+ * @brief Decode the tag at the cursor as an enumerated value, and move
+ *  the cursor past it.  The caller checks the tag number first.
+ * @param cursor - tag cursor
+ * @param value - the enumerated value decoded
+ * @return number of bytes decoded, or #BACNET_STATUS_ERROR (-1)
+ *  if the tag is not a value or is malformed
+ */
+int bacnet_tag_cursor_enumerated_decode(
+    BACNET_TAG_CURSOR *cursor, uint32_t *value)
+{
+    uint8_t *apdu;
+    uint32_t apdu_size = 0;
+    int len;
+
+    apdu = bacnet_tag_cursor_value(cursor, &apdu_size);
+    if (!apdu) {
+        return BACNET_STATUS_ERROR;
+    }
+    len = bacnet_enumerated_decode(
+        apdu, apdu_size, cursor->tag.len_value_type, value);
+    if (len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += cursor->tag_len;
+    cursor->offset += (uint32_t)len;
+    cursor->tag_len = 0;
+
+    return len;
+}
+
+/**
+ * @brief Decode the tag at the cursor as an object identifier, and move
+ *  the cursor past it.  The caller checks the tag number first.
+ * @param cursor - tag cursor
+ * @param object_type - the object type decoded
+ * @param object_instance - the object instance decoded
+ * @return number of bytes decoded, or #BACNET_STATUS_ERROR (-1)
+ *  if the tag is not a value or is malformed
+ */
+int bacnet_tag_cursor_object_id_decode(BACNET_TAG_CURSOR *cursor,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance)
+{
+    uint8_t *apdu;
+    uint32_t apdu_size = 0;
+    int len;
+
+    apdu = bacnet_tag_cursor_value(cursor, &apdu_size);
+    if (!apdu) {
+        return BACNET_STATUS_ERROR;
+    }
+    len = bacnet_object_id_decode(apdu, apdu_size,
+        cursor->tag.len_value_type, object_type, object_instance);
+    if (len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += cursor->tag_len;
+    cursor->offset += (uint32_t)len;
+    cursor->tag_len = 0;
+
+    return len;
+}
+
 /**
  * @brief Encode an boolean value.
  * From clause 20.2.3 Encoding of a Boolean Value
@@ -2342,77 +2599,15 @@ int bacnet_unsigned_decode(uint8_t *apdu,
     BACNET_UNSIGNED_INTEGER *value)
 {
     int len = 0;
-    uint16_t unsigned16_value = 0;
-    uint32_t unsigned32_value = 0;
-#ifdef UINT64_MAX
-    uint64_t unsigned64_value = 0;
-#endif
 
-    if (len_value <= apdu_size) {
-        switch (len_value) {
-            case 1:
-                if (value) {
-                    *value = apdu[0];
-                }
-                len = 1;
-                break;
-            case 2:
-                if (value) {
-                    decode_unsigned16(&apdu[0], &unsigned16_value);
-                    *value = unsigned16_value;
-                }
-                len = 2;
-                break;
-            case 3:
-                if (value) {
-                    decode_unsigned24(&apdu[0], &unsigned32_value);
-                    *value = unsigned32_value;
-                }
-                len = 3;
-                break;
-            case 4:
-                if (value) {
-                    decode_unsigned32(&apdu[0], &unsigned32_value);
-                    *value = unsigned32_value;
-                }
-                len = 4;
-                break;
-#ifdef UINT64_MAX
-            case 5:
-                if (value) {
-                    decode_unsigned40(&apdu[0], &unsigned64_value);
-                    *value = unsigned64_value;
-                }
-                len = 5;
-                break;
-            case 6:
-                if (value) {
-                    decode_unsigned48(&apdu[0], &unsigned64_value);
-                    *value = unsigned64_value;
-                }
-                len = 6;
-                break;
-            case 7:
-                if (value) {
-                    decode_unsigned56(&apdu[0], &unsigned64_value);
-                    *value = unsigned64_value;
-                }
-                len = 7;
-                break;
-            case 8:
-                if (value) {
-                    decode_unsigned64(&apdu[0], &unsigned64_value);
-                    *value = unsigned64_value;
-                }
-                len = 8;
-                break;
-#endif
-            default:
-                if (value) {
-                    *value = 0;
-                }
-                break;
+    if ((len_value >= 1) && (len_value <= sizeof(BACNET_UNSIGNED_INTEGER)) &&
+        (len_value <= apdu_size)) {
+        if (value) {
+            *value = decode_unsigned_octets(apdu, len_value);
         }
+        len = (int)len_value;
+    } else if (value) {
+        *value = 0;
     }
 
     return len;
@@ -2513,13 +2708,8 @@ int bacnet_unsigned_application_decode(
 int decode_unsigned(
     uint8_t *apdu, uint32_t len_value, BACNET_UNSIGNED_INTEGER *value)
 {
-#ifdef UINT64_MAX
-    const uint32_t apdu_size = 8;
-#else
-    const uint32_t apdu_size = 4;
-#endif
-
-    return bacnet_unsigned_decode(apdu, apdu_size, len_value, value);
+    /* the buffer size is unknown, so assume it holds only the value */
+    return bacnet_unsigned_decode(apdu, len_value, len_value, value);
 }
 
 /**
@@ -2889,27 +3079,21 @@ int bacnet_signed_decode(
     uint8_t *apdu, uint32_t apdu_size, uint32_t len_value, int32_t *value)
 {
     int len = 0;
+    uint32_t unsigned_value;
+    uint32_t sign_bit;
 
-    if (apdu && (len_value <= apdu_size)) {
-        switch (len_value) {
-            case 1:
-                len = decode_signed8(&apdu[0], value);
-                break;
-            case 2:
-                len = decode_signed16(&apdu[0], value);
-                break;
-            case 3:
-                len = decode_signed24(&apdu[0], value);
-                break;
-            case 4:
-                len = decode_signed32(&apdu[0], value);
-                break;
-            default:
-                if (value) {
-                    *value = 0;
-                }
-                break;
+    if (apdu && (len_value >= 1) && (len_value <= 4) &&
+        (len_value <= apdu_size)) {
+        if (value) {
+            unsigned_value =
+                (uint32_t)decode_unsigned_octets(apdu, len_value);
+            /* sign extend from the width of the value */
+            sign_bit = 1UL << ((len_value * 8) - 1);
+            *value = (int32_t)((unsigned_value ^ sign_bit) - sign_bit);
         }
+        len = (int)len_value;
+    } else if (value) {
+        *value = 0;
     }
 
     return len;
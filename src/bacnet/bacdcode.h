@@ -61,6 +61,23 @@ typedef struct BACnetTag {
 /* max size of a BACnet tag */
 #define BACNET_TAG_SIZE 7
 
+/**
+ * A cursor over a buffer of tagged data.  The tag at the offset is
+ * decoded once, on the first peek, and kept until the cursor moves,
+ * so a decoder may test it for several tag numbers without parsing
+ * it again.
+ */
+typedef struct BACnetTagCursor {
+    uint8_t *apdu;
+    uint32_t apdu_size;
+    /* offset of the next tag in the buffer */
+    uint32_t offset;
+    /* the tag at the offset, valid when tag_len is greater than zero */
+    BACNET_TAG tag;
+    /* zero if not decoded yet, or BACNET_STATUS_ERROR if malformed */
+    int tag_len;
+} BACNET_TAG_CURSOR;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -97,6 +114,33 @@ BACNET_STACK_EXPORT
 bool bacnet_is_closing_tag_number(
     uint8_t *apdu, uint32_t apdu_size, uint8_t tag_number, int *tag_length);
 
+BACNET_STACK_EXPORT
+void bacnet_tag_cursor_init(
+    BACNET_TAG_CURSOR *cursor, uint8_t *apdu, uint32_t apdu_size);
+BACNET_STACK_EXPORT
+const BACNET_TAG *bacnet_tag_cursor_peek(BACNET_TAG_CURSOR *cursor);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_is_opening(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_is_closing(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_is_context(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_next(BACNET_TAG_CURSOR *cursor);
+BACNET_STACK_EXPORT
+int bacnet_tag_cursor_unsigned_decode(
+    BACNET_TAG_CURSOR *cursor, BACNET_UNSIGNED_INTEGER *value);
+BACNET_STACK_EXPORT
+int bacnet_tag_cursor_enumerated_decode(
+    BACNET_TAG_CURSOR *cursor, uint32_t *value);
+BACNET_STACK_EXPORT
+int bacnet_tag_cursor_object_id_decode(BACNET_TAG_CURSOR *cursor,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance);
+
 BACNET_STACK_DEPRECATED("Use bacnet_tag_decode() instead")
 BACNET_STACK_EXPORT
 int bacnet_tag_number_and_value_decode(
@@ -36,6 +36,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "bacnet/config.h"
 #include "bacnet/bacint.h"
 
@@ -294,6 +295,63 @@ int decode_unsigned64(uint8_t *buffer, uint64_t *value)
     return 8;
 }
 #endif
+
+/* host byte order, for the single load of decode_unsigned_octets() */
+#if !defined(BACNET_BIG_ENDIAN) && defined(__BYTE_ORDER__)
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BACNET_BIG_ENDIAN 1
+#else
+#define BACNET_BIG_ENDIAN 0
+#endif
+#endif
+
+/**
+ * @brief Decode a big-endian unsigned integer of 1 to 8 octets.
+ *  The octets of the value are copied right-aligned into a zeroed
+ *  64-bit word, so every width takes the same single load and no octet
+ *  past the value is read.
+ * @param buffer - buffer holding the value, at least len_value bytes
+ * @param len_value - number of octets in the value, from 1 to the size
+ *  of BACNET_UNSIGNED_INTEGER
+ * @return the value
+ */
+BACNET_UNSIGNED_INTEGER decode_unsigned_octets(
+    const uint8_t *buffer, uint32_t len_value)
+{
+#if defined(UINT64_MAX) && defined(BACNET_BIG_ENDIAN)
+    uint8_t octets[8] = { 0 };
+    uint64_t value64;
+
+    memcpy(&octets[8 - len_value], buffer, len_value);
+    memcpy(&value64, octets, 8);
+#if !BACNET_BIG_ENDIAN
+#if defined(__GNUC__)
+    value64 = __builtin_bswap64(value64);
+#else
+    value64 = ((value64 & 0x00000000000000FFULL) << 56) |
+        ((value64 & 0x000000000000FF00ULL) << 40) |
+        ((value64 & 0x0000000000FF0000ULL) << 24) |
+        ((value64 & 0x00000000FF000000ULL) << 8) |
+        ((value64 & 0x000000FF00000000ULL) >> 8) |
+        ((value64 & 0x0000FF0000000000ULL) >> 24) |
+        ((value64 & 0x00FF000000000000ULL) >> 40) |
+        ((value64 & 0xFF00000000000000ULL) >> 56);
+#endif
+#endif
+
+    return (BACNET_UNSIGNED_INTEGER)value64;
+#else
+    BACNET_UNSIGNED_INTEGER value = 0;
+    uint32_t i;
+
+    for (i = 0; i < len_value; i++) {
+        value = (value << 8) | buffer[i];
+    }
+
+    return value;
+#endif
+}
+
 /**
  * @brief       Determine the number of bytes in the value
  *              length of unsigned is variable, as per 20.2.4
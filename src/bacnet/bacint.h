@@ -101,6 +101,11 @@ extern "C" {
         uint64_t * value);
 #endif
 
+    BACNET_STACK_EXPORT
+    BACNET_UNSIGNED_INTEGER decode_unsigned_octets(
+        const uint8_t * buffer,
+        uint32_t len_value);
+
     BACNET_STACK_EXPORT
     int bacnet_unsigned_length(
         BACNET_UNSIGNED_INTEGER value);
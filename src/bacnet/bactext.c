@@ -51,7 +51,7 @@ static bool bactext_strtol_index(
     char *endptr;
     long value;
 
-    if (indtext_by_istring(istring, search_name, found_index) == true) {
+    if (indtext_by_istring_cached(istring, search_name, found_index) == true) {
         return true;
     } else {
         value = strtol(search_name, &endptr, 0);
@@ -105,7 +105,7 @@ INDTEXT_DATA bacnet_confirmed_service_names[] = {
 
 const char *bactext_confirmed_service_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_confirmed_service_names, index, ASHRAE_Reserved_String);
 }
 
@@ -125,7 +125,7 @@ INDTEXT_DATA bacnet_unconfirmed_service_names[] = { { SERVICE_UNCONFIRMED_I_AM,
 
 const char *bactext_unconfirmed_service_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_unconfirmed_service_names, index, ASHRAE_Reserved_String);
 }
 
@@ -170,14 +170,14 @@ INDTEXT_DATA bacnet_application_tag_names[] = { { BACNET_APPLICATION_TAG_NULL,
 
 const char *bactext_application_tag_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_application_tag_names, index, ASHRAE_Reserved_String);
 }
 
 bool bactext_application_tag_index(
     const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_application_tag_names, search_name, found_index);
 }
 
@@ -245,14 +245,14 @@ INDTEXT_DATA bacnet_object_type_names[] = { { OBJECT_ANALOG_INPUT,
 
 const char *bactext_object_type_name(unsigned index)
 {
-    return indtext_by_index_split_default(bacnet_object_type_names, index,
-        OBJECT_PROPRIETARY_MIN, ASHRAE_Reserved_String,
+    return indtext_by_index_split_default_cached(bacnet_object_type_names,
+        index, OBJECT_PROPRIETARY_MIN, ASHRAE_Reserved_String,
         Vendor_Proprietary_String);
 }
 
 bool bactext_object_type_index(const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_object_type_names, search_name, found_index);
 }
 
@@ -767,7 +767,7 @@ const char *bactext_property_name(unsigned index)
     if (bactext_property_name_proprietary(index)) {
         return Vendor_Proprietary_String;
     } else {
-        return indtext_by_index_default(
+        return indtext_by_index_default_cached(
             bacnet_property_names, index, ASHRAE_Reserved_String);
     }
 }
@@ -775,18 +775,19 @@ const char *bactext_property_name(unsigned index)
 const char *bactext_property_name_default(
     unsigned index, const char *default_string)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_property_names, index, default_string);
 }
 
 unsigned bactext_property_id(const char *name)
 {
-    return indtext_by_istring_default(bacnet_property_names, name, 0);
+    return indtext_by_istring_default_cached(bacnet_property_names, name, 0);
 }
 
 bool bactext_property_index(const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(bacnet_property_names, search_name, found_index);
+    return indtext_by_istring_cached(
+        bacnet_property_names, search_name, found_index);
 }
 
 bool bactext_property_strtol(const char *search_name, unsigned *found_index)
@@ -1049,7 +1050,7 @@ const char *bactext_engineering_unit_name(unsigned index)
     if (bactext_engineering_unit_name_proprietary(index)) {
         return Vendor_Proprietary_String;
     } else if (index <= UNITS_RESERVED_RANGE_MAX2) {
-        return indtext_by_index_default(
+        return indtext_by_index_default_cached(
             bacnet_engineering_unit_names, index, ASHRAE_Reserved_String);
     }
 
@@ -1059,7 +1060,7 @@ const char *bactext_engineering_unit_name(unsigned index)
 bool bactext_engineering_unit_index(
     const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_engineering_unit_names, search_name, found_index);
 }
 
@@ -1079,8 +1080,8 @@ INDTEXT_DATA bacnet_reject_reason_names[] = { { REJECT_REASON_OTHER, "Other" },
 
 const char *bactext_reject_reason_name(unsigned index)
 {
-    return indtext_by_index_split_default(bacnet_reject_reason_names, index,
-        REJECT_REASON_PROPRIETARY_FIRST, ASHRAE_Reserved_String,
+    return indtext_by_index_split_default_cached(bacnet_reject_reason_names,
+        index, REJECT_REASON_PROPRIETARY_FIRST, ASHRAE_Reserved_String,
         Vendor_Proprietary_String);
 }
 
@@ -1102,8 +1103,8 @@ INDTEXT_DATA bacnet_abort_reason_names[] = { { ABORT_REASON_OTHER, "Other" },
 
 const char *bactext_abort_reason_name(unsigned index)
 {
-    return indtext_by_index_split_default(bacnet_abort_reason_names, index,
-        ABORT_REASON_PROPRIETARY_FIRST, ASHRAE_Reserved_String,
+    return indtext_by_index_split_default_cached(bacnet_abort_reason_names,
+        index, ABORT_REASON_PROPRIETARY_FIRST, ASHRAE_Reserved_String,
         Vendor_Proprietary_String);
 }
 
@@ -1116,8 +1117,8 @@ INDTEXT_DATA bacnet_error_class_names[] = { { ERROR_CLASS_DEVICE, "device" },
 
 const char *bactext_error_class_name(unsigned index)
 {
-    return indtext_by_index_split_default(bacnet_error_class_names, index,
-        ERROR_CLASS_PROPRIETARY_FIRST, ASHRAE_Reserved_String,
+    return indtext_by_index_split_default_cached(bacnet_error_class_names,
+        index, ERROR_CLASS_PROPRIETARY_FIRST, ASHRAE_Reserved_String,
         Vendor_Proprietary_String);
 }
 
@@ -1367,7 +1368,7 @@ INDTEXT_DATA bacnet_error_code_names[] = { { ERROR_CODE_OTHER, "other" },
 
 const char *bactext_error_code_name(unsigned index)
 {
-    return indtext_by_index_split_default(bacnet_error_code_names, index,
+    return indtext_by_index_split_default_cached(bacnet_error_code_names, index,
         ERROR_CODE_PROPRIETARY_FIRST, ASHRAE_Reserved_String,
         Vendor_Proprietary_String);
 }
@@ -1380,7 +1381,7 @@ INDTEXT_DATA bacnet_month_names[] = { { 1, "January" }, { 2, "February" },
 
 const char *bactext_month_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_month_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1392,7 +1393,7 @@ INDTEXT_DATA bacnet_week_of_month_names[] = { { 1, "days numbered 1-7" },
 
 const char *bactext_week_of_month_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_week_of_month_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1403,7 +1404,7 @@ INDTEXT_DATA bacnet_day_of_week_names[] = { { 1, "Monday" }, { 2, "Tuesday" },
 
 const char *bactext_day_of_week_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_day_of_week_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1419,13 +1420,13 @@ INDTEXT_DATA bacnet_days_of_week_names[] = { { BACNET_DAYS_OF_WEEK_MONDAY,
 
 const char *bactext_days_of_week_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_days_of_week_names, index, ASHRAE_Reserved_String);
 }
 
 bool bactext_days_of_week_index(const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_days_of_week_names, search_name, found_index);
 }
 
@@ -1435,13 +1436,13 @@ INDTEXT_DATA bacnet_notify_type_names[] = { { NOTIFY_ALARM, "alarm" },
 
 const char *bactext_notify_type_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_notify_type_names, index, ASHRAE_Reserved_String);
 }
 
 bool bactext_notify_type_index(const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_notify_type_names, search_name, found_index);
 }
 
@@ -1452,14 +1453,14 @@ INDTEXT_DATA bacnet_event_transition_names[] = { { TRANSITION_TO_OFFNORMAL,
 
 const char *bactext_event_transition_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_event_transition_names, index, ASHRAE_Reserved_String);
 }
 
 bool bactext_event_transition_index(
     const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_event_transition_names, search_name, found_index);
 }
 
@@ -1470,13 +1471,13 @@ INDTEXT_DATA bacnet_event_state_names[] = { { EVENT_STATE_NORMAL, "normal" },
 
 const char *bactext_event_state_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_event_state_names, index, ASHRAE_Reserved_String);
 }
 
 bool bactext_event_state_index(const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_event_state_names, search_name, found_index);
 }
 
@@ -1509,14 +1510,14 @@ INDTEXT_DATA bacnet_event_type_names[] = { { EVENT_CHANGE_OF_BITSTRING,
 
 const char *bactext_event_type_name(unsigned index)
 {
-    return indtext_by_index_split_default(bacnet_event_type_names, index,
+    return indtext_by_index_split_default_cached(bacnet_event_type_names, index,
         EVENT_PROPRIETARY_MIN, ASHRAE_Reserved_String,
         Vendor_Proprietary_String);
 }
 
 bool bactext_event_type_index(const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_event_type_names, search_name, found_index);
 }
 
@@ -1526,14 +1527,14 @@ INDTEXT_DATA bacnet_binary_present_value_names[] = {
 
 const char *bactext_binary_present_value_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_binary_present_value_names, index, ASHRAE_Reserved_String);
 }
 
 bool bactext_binary_present_value_index(
     const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_binary_present_value_names, search_name, found_index);
 }
 
@@ -1542,7 +1543,7 @@ INDTEXT_DATA bacnet_binary_polarity_names[] = { { POLARITY_NORMAL, "normal" },
 
 const char *bactext_binary_polarity_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_binary_polarity_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1578,7 +1579,7 @@ INDTEXT_DATA bacnet_reliability_names[] = { { RELIABILITY_NO_FAULT_DETECTED,
 
 const char *bactext_reliability_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_reliability_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1592,7 +1593,7 @@ INDTEXT_DATA bacnet_device_status_names[] = { { STATUS_OPERATIONAL,
 
 const char *bactext_device_status_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_device_status_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1604,13 +1605,13 @@ INDTEXT_DATA bacnet_segmentation_names[] = { { SEGMENTATION_BOTH,
 
 const char *bactext_segmentation_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_segmentation_names, index, ASHRAE_Reserved_String);
 }
 
 bool bactext_segmentation_index(const char *search_name, unsigned *found_index)
 {
-    return indtext_by_istring(
+    return indtext_by_istring_cached(
         bacnet_segmentation_names, search_name, found_index);
 }
 
@@ -1626,7 +1627,7 @@ INDTEXT_DATA bacnet_node_type_names[] = { { BACNET_NODE_UNKNOWN, "unknown" },
 
 const char *bactext_node_type_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_node_type_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1650,7 +1651,7 @@ INDTEXT_DATA network_layer_msg_names[] = {
 const char *bactext_network_layer_msg_name(unsigned index)
 {
     if (index <= 0x7F) {
-        return indtext_by_index_default(
+        return indtext_by_index_default_cached(
             network_layer_msg_names, index, ASHRAE_Reserved_String);
     } else if (index < NETWORK_MESSAGE_INVALID) {
         return Vendor_Proprietary_String;
@@ -1686,7 +1687,7 @@ INDTEXT_DATA life_safety_state_names[] = { { LIFE_SAFETY_STATE_QUIET, "quiet" },
 const char *bactext_life_safety_state_name(unsigned index)
 {
     if (index < MAX_LIFE_SAFETY_STATE) {
-        return indtext_by_index_default(
+        return indtext_by_index_default_cached(
             life_safety_state_names, index, ASHRAE_Reserved_String);
     } else {
         return "Invalid BACnetLifeSafetyState";
@@ -1703,7 +1704,7 @@ INDTEXT_DATA lighting_in_progress[] = { { BACNET_LIGHTING_IDLE, "idle" },
 const char *bactext_lighting_in_progress(unsigned index)
 {
     if (index < MAX_BACNET_LIGHTING_IN_PROGRESS) {
-        return indtext_by_index_default(
+        return indtext_by_index_default_cached(
             lighting_in_progress, index, ASHRAE_Reserved_String);
     } else {
         return "Invalid BACnetLightingInProgress";
@@ -1718,7 +1719,7 @@ INDTEXT_DATA lighting_transition[] = {
 const char *bactext_lighting_transition(unsigned index)
 {
     if (index < BACNET_LIGHTING_TRANSITION_PROPRIETARY_FIRST) {
-        return indtext_by_index_default(
+        return indtext_by_index_default_cached(
             lighting_transition, index, ASHRAE_Reserved_String);
     } else if (index <= BACNET_LIGHTING_TRANSITION_PROPRIETARY_LAST) {
         return Vendor_Proprietary_String;
@@ -1741,7 +1742,7 @@ INDTEXT_DATA bacnet_lighting_operation_names[] = {
 const char *bactext_lighting_operation_name(unsigned index)
 {
     if (index < BACNET_LIGHTS_PROPRIETARY_FIRST) {
-        return indtext_by_index_default(
+        return indtext_by_index_default_cached(
             bacnet_lighting_operation_names, index, ASHRAE_Reserved_String);
     } else if (index <= BACNET_LIGHTS_PROPRIETARY_LAST) {
         return Vendor_Proprietary_String;
@@ -1761,7 +1762,7 @@ INDTEXT_DATA bacnet_color_operation_names[] = { { BACNET_COLOR_OPERATION_NONE,
 
 const char *bactext_color_operation_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_color_operation_names, index, ASHRAE_Reserved_String);
 }
 
@@ -1772,6 +1773,6 @@ INDTEXT_DATA bacnet_device_communications_names[] = {
 
 const char *bactext_device_communications_name(unsigned index)
 {
-    return indtext_by_index_default(
+    return indtext_by_index_default_cached(
         bacnet_device_communications_names, index, ASHRAE_Reserved_String);
 }
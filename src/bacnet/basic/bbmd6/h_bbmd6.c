@@ -93,6 +93,14 @@ static BACNET_IP6_BROADCAST_DISTRIBUTION_TABLE_ENTRY
 #define MAX_FD6_ENTRIES 128
 #endif
 static BACNET_IP6_FOREIGN_DEVICE_TABLE_ENTRY FD_Table[MAX_FD6_ENTRIES];
+/* addresses of the valid BDT and FDT entries, other than our own,
+   so that a forward is sent to all of them with one call */
+static BACNET_IP6_ADDRESS BBMD_Peer_List[MAX_BBMD6_ENTRIES];
+static unsigned BBMD_Peer_Count;
+static BACNET_IP6_ADDRESS FD_Peer_List[MAX_FD6_ENTRIES];
+static unsigned FD_Peer_Count;
+/* set when the BDT or FDT changed */
+static bool Peer_List_Stale = true;
 #endif
 
 /**
@@ -112,7 +120,10 @@ void bvlc6_maintenance_timer(uint16_t seconds)
 {
 #if defined(BACDL_BIP6) && BBMD6_ENABLED
     unsigned i = 0;
+#endif
 
+    VMAC_Timer(seconds);
+#if defined(BACDL_BIP6) && BBMD6_ENABLED
     for (i = 0; i < MAX_FD6_ENTRIES; i++) {
         if (FD_Table[i].valid) {
             if (FD_Table[i].ttl_seconds_remaining) {
@@ -123,12 +134,11 @@ void bvlc6_maintenance_timer(uint16_t seconds)
                 }
                 if (FD_Table[i].ttl_seconds_remaining == 0) {
                     FD_Table[i].valid = false;
+                    Peer_List_Stale = true;
                 }
             }
         }
     }
-#else
-    (void)seconds;    
 #endif
 }
 
@@ -215,11 +225,14 @@ static void bbmd6_add_vmac(uint32_t device_id, BACNET_IP6_ADDRESS *addr)
                     (unsigned long)list_device_id);
             }
         }
-        if (!found) {
+        if (found) {
+            /* restart the lifetime of the entry */
+            VMAC_Update(device_id, &new_vmac);
+        } else {
             vmac = VMAC_Find_By_Key(device_id);
             if (vmac) {
                 /* device ID already exists. Update MAC. */
-                memmove(vmac, &new_vmac, sizeof(struct vmac_data));
+                VMAC_Update(device_id, &new_vmac);
                 PRINTF("BVLC6: VMAC for %u [", 
                     (unsigned int)device_id);
                 for (i = 0; i < new_vmac.mac_len; i++) {
@@ -373,97 +386,65 @@ int bvlc6_send_pdu(BACNET_ADDRESS *dest,
 
 #if defined(BACDL_BIP6) && BBMD6_ENABLED
 /**
- * The send function for Broacast Distribution Table
- *
- * @param addr - Points to a #BACNET_IP6_ADDRESS structure containing the
- *  source IPv6 address.
- * @param vmac_src - Source-Virtual-Address
- * @param npdu - the bytes of NPDU+APDU data to send
- * @param npdu_len - the number of bytes of NPDU+APDU data to send
+ * Rebuild the lists of BDT and FDT peer addresses if the tables changed
  */
-static void bbmd6_send_pdu_bdt(uint8_t *mtu, unsigned int mtu_len)
+static void bbmd6_peer_list_update(void)
 {
     BACNET_IP6_ADDRESS my_addr = { 0 };
     unsigned i = 0; /* loop counter */
 
-    if (mtu) {
-        bip6_get_addr(&my_addr);
-        for (i = 0; i < MAX_BBMD_ENTRIES; i++) {
-            if (BBMD_Table[i].valid) {
-                if (bvlc6_address_different(
-                        &my_addr, &BBMD_Table[i].bip6_address)) {
-                    bip6_send_mpdu(&BBMD_Table[i].bip6_address, mtu, mtu_len);
-                }
-            }
+    if (!Peer_List_Stale) {
+        return;
+    }
+    bip6_get_addr(&my_addr);
+    BBMD_Peer_Count = 0;
+    for (i = 0; i < MAX_BBMD6_ENTRIES; i++) {
+        if (BBMD_Table[i].valid &&
+            bvlc6_address_different(&my_addr, &BBMD_Table[i].bip6_address)) {
+            bvlc6_address_copy(&BBMD_Peer_List[BBMD_Peer_Count],
+                &BBMD_Table[i].bip6_address);
+            BBMD_Peer_Count++;
         }
     }
+    FD_Peer_Count = 0;
+    for (i = 0; i < MAX_FD6_ENTRIES; i++) {
+        if (FD_Table[i].valid &&
+            bvlc6_address_different(&my_addr, &FD_Table[i].bip6_address)) {
+            bvlc6_address_copy(
+                &FD_Peer_List[FD_Peer_Count], &FD_Table[i].bip6_address);
+            FD_Peer_Count++;
+        }
+    }
+    Peer_List_Stale = false;
 }
 
 /**
  * The send function for Broacast Distribution Table
  *
- * @param addr - Points to a #BACNET_IP6_ADDRESS structure containing the
- *  source IPv6 address.
- * @param vmac_src - Source-Virtual-Address
- * @param npdu - the bytes of NPDU+APDU data to send
- * @param npdu_len - the number of bytes of NPDU+APDU data to send
+ * @param mtu - the bytes of BVLC6 message to send
+ * @param mtu_len - the number of bytes of BVLC6 message to send
  */
-static void bbmd6_send_pdu_fdt(uint8_t *mtu, unsigned int mtu_len)
+static void bbmd6_send_pdu_bdt(uint8_t *mtu, unsigned int mtu_len)
 {
-    BACNET_IP6_ADDRESS my_addr = { 0 };
-    unsigned i = 0; /* loop counter */
-
     if (mtu) {
-        bip6_get_addr(&my_addr);
-        for (i = 0; i < MAX_FD_ENTRIES; i++) {
-            if (FD_Table[i].valid) {
-                if (bvlc6_address_different(
-                        &my_addr, &FD_Table[i].bip6_address)) {
-                    bip6_send_mpdu(&FD_Table[i].bip6_address, mtu, mtu_len);
-                }
-            }
-        }
+        bbmd6_peer_list_update();
+        bip6_send_mpdu_list(BBMD_Peer_List, BBMD_Peer_Count, mtu, mtu_len);
     }
 }
 
 /**
- * The Forward NPDU send function for Broacast Distribution Table
+ * The send function for Foreign Device Table
  *
- * @param addr - Points to a #BACNET_IP6_ADDRESS structure containing the
- *  source IPv6 address.
- * @param vmac_src - Source-Virtual-Address
- * @param npdu - the bytes of NPDU+APDU data to send
- * @param npdu_len - the number of bytes of NPDU+APDU data to send
+ * @param mtu - the bytes of BVLC6 message to send
+ * @param mtu_len - the number of bytes of BVLC6 message to send
  */
-static void bbmd6_send_forward_npdu(BACNET_IP6_ADDRESS *address,
-    uint32_t vmac_src,
-    uint8_t *npdu,
-    unsigned int npdu_len)
+static void bbmd6_send_pdu_fdt(uint8_t *mtu, unsigned int mtu_len)
 {
-    uint8_t mtu[BIP6_MPDU_MAX] = { 0 };
-    uint16_t mtu_len = 0;
-    unsigned i = 0; /* loop counter */
-
-    for (i = 0; i < MAX_BBMD_ENTRIES; i++) {
-        if (BBMD_Table[i].valid) {
-            if (bbmd6_address_match_self(&BBMD_Table[i].bip6_address)) {
-                /* don't forward to our selves */
-            } else {
-                bip6_send_mpdu(&BBMD_Table[i].bip6_address, mtu, mtu_len);
-            }
-        }
-    }
-    for (i = 0; i < MAX_FD_ENTRIES; i++) {
-        if (FD_Table[i].valid) {
-            if (bbmd6_address_match_self(&FD_Table[i].bip6_address)) {
-                /* don't forward to our selves */
-            } else {
-                bip6_send_mpdu(&FD_Table[i].bip6_address, mtu, mtu_len);
-            }
-        }
+    if (mtu) {
+        bbmd6_peer_list_update();
+        bip6_send_mpdu_list(FD_Peer_List, FD_Peer_Count, mtu, mtu_len);
     }
 }
-
 #endif
 
 /**
@@ -871,6 +852,7 @@ int bvlc6_bbmd_enabled_handler(BACNET_IP6_ADDRESS *addr,
     bool send_result = false;
     uint16_t offset = 0;
     BACNET_IP6_ADDRESS fwd_address = { { 0 } };
+    BACNET_IP6_ADDRESS bvlc_dest = { 0 };
 
     header_len =
         bvlc6_decode_header(mtu, mtu_len, &message_type, &message_length);
@@ -1148,5 +1130,6 @@ void bvlc6_init(void)
 #if defined(BACDL_BIP6) && BBMD6_ENABLED
     memset(&BBMD_Table, 0, sizeof(BBMD_Table));
     memset(&FD_Table, 0, sizeof(FD_Table));
+    Peer_List_Stale = true;
 #endif
 }
@@ -36,9 +36,9 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "bacnet/config.h"
 #include "bacnet/bacdef.h"
-#include "bacnet/basic/sys/keylist.h"
 /* me! */
 #include "bacnet/basic/bbmd6/vmac.h"
 
@@ -54,10 +54,6 @@ static bool VMAC_Debug = false;
     }
 #else
 #define PRINTF(...)
-
-#if !defined UNUSED
-#define UNUSED(x) ((void)(x))
-#endif
 #endif // PRINT_ENABLED
 
 /**
@@ -74,15 +70,215 @@ void VMAC_Debug_Enable(void)
 /* This module is used to handle the virtual MAC address binding that */
 /* occurs in BACnet for ZigBee or IPv6. */
 
-/* Key List for storing the object data sorted by instance number  */
-static OS_Keylist VMAC_List;
+/* The entries come from a pool of blocks, and are indexed by two hash
+   tables: one on the Device ID and one on the MAC, so that the lookup
+   of a received packet does not scan the whole list.  The first block
+   is static, and the pool grows by a block when it is full, so that
+   the entries do not move. */
+#define VMAC_NONE 0xFFFF
+#if (VMAC_BLOCKS_MAX < 1) || ((VMAC_BLOCKS_MAX * MAX_VMAC_ENTRIES) > VMAC_NONE)
+#error "the VMAC pool must hold fewer than 65535 entries"
+#endif
+
+struct vmac_entry {
+    struct vmac_data vmac;
+    uint32_t device_id;
+    /* seconds until the entry is removed, or 0 to never age */
+    uint32_t ttl_seconds_remaining;
+    /* hash chain of the Device ID, or the free list */
+    uint16_t next_key;
+    /* hash chain of the MAC */
+    uint16_t next_data;
+    bool valid;
+};
+static struct vmac_entry VMAC_Pool[MAX_VMAC_ENTRIES];
+static struct vmac_entry *VMAC_Block[VMAC_BLOCKS_MAX] = { VMAC_Pool };
+static unsigned int VMAC_Blocks = 1;
+static bool VMAC_Initialized;
+static uint16_t VMAC_Key_Hash[VMAC_HASH_SIZE];
+static uint16_t VMAC_Data_Hash[VMAC_HASH_SIZE];
+static uint16_t VMAC_Free_List = VMAC_NONE;
+static unsigned int VMAC_Entries;
+/* lifetime given to the added or updated entries */
+static uint32_t VMAC_Lifetime_Seconds;
+
+/**
+ * Gets an entry of the pool
+ *
+ * @param index - index of the entry in the pool
+ *
+ * @return pointer to the entry
+ */
+static struct vmac_entry *VMAC_Entry(unsigned int index)
+{
+    return &VMAC_Block[index / MAX_VMAC_ENTRIES][index % MAX_VMAC_ENTRIES];
+}
+
+/**
+ * Links the entries of a block into the free list
+ *
+ * @param block - index of the block
+ */
+static void VMAC_Block_Free(unsigned int block)
+{
+    unsigned int i = 0;
+    unsigned int index = 0;
+
+    for (i = MAX_VMAC_ENTRIES; i > 0; i--) {
+        index = (block * MAX_VMAC_ENTRIES) + i - 1;
+        VMAC_Entry(index)->valid = false;
+        VMAC_Entry(index)->next_key = VMAC_Free_List;
+        VMAC_Free_List = (uint16_t)index;
+    }
+}
+
+/**
+ * Adds a block to the pool when all the entries are used
+ *
+ * @return true if a free entry is available
+ */
+static bool VMAC_Pool_Grow(void)
+{
+    struct vmac_entry *block;
+
+    if (VMAC_Free_List != VMAC_NONE) {
+        return true;
+    }
+    if (VMAC_Blocks >= VMAC_BLOCKS_MAX) {
+        return false;
+    }
+    block = calloc(MAX_VMAC_ENTRIES, sizeof(struct vmac_entry));
+    if (!block) {
+        return false;
+    }
+    VMAC_Block[VMAC_Blocks] = block;
+    VMAC_Block_Free(VMAC_Blocks);
+    VMAC_Blocks++;
+    PRINTF("VMAC pool of %u entries.\n",
+        (unsigned int)(VMAC_Blocks * MAX_VMAC_ENTRIES));
+
+    return true;
+}
+
+/**
+ * Initializes the VMAC list data if VMAC_Init() was not called
+ */
+static void VMAC_Init_Check(void)
+{
+    if (!VMAC_Initialized) {
+        VMAC_Init();
+    }
+}
+
+/**
+ * Hashes a Device ID
+ *
+ * @param device_id - BACnet device object instance number
+ *
+ * @return index of the hash bucket
+ */
+static unsigned int VMAC_Key_Index(uint32_t device_id)
+{
+    uint32_t hash = device_id * 2654435761UL;
+
+    hash ^= hash >> 16;
+
+    return hash & (VMAC_HASH_SIZE - 1);
+}
+
+/**
+ * Hashes a VMAC address
+ *
+ * @param vmac - VMAC address
+ *
+ * @return index of the hash bucket
+ */
+static unsigned int VMAC_Data_Index(struct vmac_data *vmac)
+{
+    uint32_t hash = 2166136261UL;
+    unsigned int i = 0;
+
+    /* FNV-1a */
+    for (i = 0; (i < vmac->mac_len) && (i < VMAC_MAC_MAX); i++) {
+        hash ^= vmac->mac[i];
+        hash *= 16777619UL;
+    }
+    hash ^= hash >> 16;
+
+    return hash & (VMAC_HASH_SIZE - 1);
+}
+
+/**
+ * Finds the pool index of a Device ID
+ *
+ * @param device_id - BACnet device object instance number
+ *
+ * @return index of the entry, or VMAC_NONE
+ */
+static uint16_t VMAC_Key_Find(uint32_t device_id)
+{
+    uint16_t index;
+
+    index = VMAC_Key_Hash[VMAC_Key_Index(device_id)];
+    while (index != VMAC_NONE) {
+        if (VMAC_Entry(index)->device_id == device_id) {
+            break;
+        }
+        index = VMAC_Entry(index)->next_key;
+    }
+
+    return index;
+}
+
+/**
+ * Links an entry into the MAC hash table
+ */
+static void VMAC_Data_Link(uint16_t index)
+{
+    unsigned int hash = VMAC_Data_Index(&VMAC_Entry(index)->vmac);
+
+    VMAC_Entry(index)->next_data = VMAC_Data_Hash[hash];
+    VMAC_Data_Hash[hash] = index;
+}
+
+/**
+ * Unlinks an entry from the MAC hash table
+ */
+static void VMAC_Data_Unlink(uint16_t index)
+{
+    uint16_t *link;
+
+    link = &VMAC_Data_Hash[VMAC_Data_Index(&VMAC_Entry(index)->vmac)];
+    while (*link != VMAC_NONE) {
+        if (*link == index) {
+            *link = VMAC_Entry(index)->next_data;
+            break;
+        }
+        link = &VMAC_Entry(*link)->next_data;
+    }
+}
+
+/**
+ * Copies a VMAC address into an entry
+ */
+static void VMAC_Copy(struct vmac_data *dest, struct vmac_data *src)
+{
+    size_t mac_len = src->mac_len;
+
+    if (mac_len > sizeof(dest->mac)) {
+        mac_len = sizeof(dest->mac);
+    }
+    memset(dest, 0, sizeof(struct vmac_data));
+    memcpy(dest->mac, src->mac, mac_len);
+    dest->mac_len = (uint8_t)mac_len;
+}
 
 /**
  * Returns the number of VMAC in the list
  */
 unsigned int VMAC_Count(void)
 {
-    return (unsigned int)Keylist_Count(VMAC_List);
+    return VMAC_Entries;
 }
 
 /**
@@ -96,53 +292,100 @@ unsigned int VMAC_Count(void)
 bool VMAC_Add(uint32_t device_id, struct vmac_data *src)
 {
     bool status = false;
-    struct vmac_data *pVMAC = NULL;
-    int index = 0;
-    size_t i = 0;
-
-    pVMAC = Keylist_Data(VMAC_List, device_id);
-    if (!pVMAC) {
-        pVMAC = calloc(1, sizeof(struct vmac_data));
-        if (pVMAC) {
-            /* copy the MAC into the data store */
-            for (i = 0; i < sizeof(pVMAC->mac); i++) {
-                if (i < src->mac_len) {
-                    pVMAC->mac[i] = src->mac[i];
-                } else {
-                    break;
-                }
-            }
-            pVMAC->mac_len = src->mac_len;
-            index = Keylist_Data_Add(VMAC_List, device_id, pVMAC);
-            if (index >= 0) {
-                status = true;
-                PRINTF("VMAC %u added.\n", (unsigned int)device_id);
-            }
-        }
+    struct vmac_entry *entry;
+    unsigned int hash = 0;
+    uint16_t index = 0;
+
+    VMAC_Init_Check();
+    if (!src || (VMAC_Key_Find(device_id) != VMAC_NONE)) {
+        return false;
+    }
+    if (!VMAC_Pool_Grow()) {
+        PRINTF("VMAC %u not added: the list is full.\n",
+            (unsigned int)device_id);
+        return false;
+    }
+    index = VMAC_Free_List;
+    if (index != VMAC_NONE) {
+        entry = VMAC_Entry(index);
+        VMAC_Free_List = entry->next_key;
+        VMAC_Copy(&entry->vmac, src);
+        entry->device_id = device_id;
+        entry->ttl_seconds_remaining = VMAC_Lifetime_Seconds;
+        entry->valid = true;
+        hash = VMAC_Key_Index(device_id);
+        entry->next_key = VMAC_Key_Hash[hash];
+        VMAC_Key_Hash[hash] = index;
+        VMAC_Data_Link(index);
+        VMAC_Entries++;
+        status = true;
+        PRINTF("VMAC %u added.\n", (unsigned int)device_id);
     }
 
     return status;
 }
 
+/**
+ * Replaces the VMAC of a Device ID in the list, and restarts the
+ * lifetime of the entry.
+ *
+ * @param device_id - BACnet device object instance number
+ * @param src - BACnet/IPv6 address
+ *
+ * @return true if the device ID was found and updated
+ */
+bool VMAC_Update(uint32_t device_id, struct vmac_data *src)
+{
+    struct vmac_entry *entry;
+    uint16_t index;
+
+    VMAC_Init_Check();
+    index = VMAC_Key_Find(device_id);
+    if (!src || (index == VMAC_NONE)) {
+        return false;
+    }
+    entry = VMAC_Entry(index);
+    if (VMAC_Different(&entry->vmac, src)) {
+        VMAC_Data_Unlink(index);
+        VMAC_Copy(&entry->vmac, src);
+        VMAC_Data_Link(index);
+    }
+    entry->ttl_seconds_remaining = VMAC_Lifetime_Seconds;
+
+    return true;
+}
+
 /**
  * Finds a VMAC in the list by seeking the Device ID, and deletes it.
  *
  * @param device_id - BACnet device object instance number
  *
- * @return pointer to the VMAC data from the list - be sure to free() it!
+ * @return true if the device ID was found and deleted
  */
 bool VMAC_Delete(uint32_t device_id)
 {
-    bool status = false;
-    struct vmac_data *pVMAC;
+    uint16_t *link;
+    uint16_t index;
 
-    pVMAC = Keylist_Data_Delete(VMAC_List, device_id);
-    if (pVMAC) {
-        free(pVMAC);
-        status = true;
+    VMAC_Init_Check();
+    link = &VMAC_Key_Hash[VMAC_Key_Index(device_id)];
+    while (*link != VMAC_NONE) {
+        index = *link;
+        if (VMAC_Entry(index)->device_id == device_id) {
+            *link = VMAC_Entry(index)->next_key;
+            VMAC_Data_Unlink(index);
+            VMAC_Entry(index)->valid = false;
+            VMAC_Entry(index)->next_key = VMAC_Free_List;
+            VMAC_Free_List = index;
+            if (VMAC_Entries) {
+                VMAC_Entries--;
+            }
+            return true;
+        }
+        link = &VMAC_Entry(index)->next_key;
     }
 
-    return status;
+    return false;
 }
 
 /**
@@ -150,11 +393,20 @@ bool VMAC_Delete(uint32_t device_id)
  *
  * @param device_id - BACnet device object instance number
  *
- * @return pointer to the VMAC data from the list
+ * @return pointer to the VMAC data from the list.  Use VMAC_Update()
+ *  to change the VMAC, since the list is indexed by it.
  */
 struct vmac_data *VMAC_Find_By_Key(uint32_t device_id)
 {
-    return Keylist_Data(VMAC_List, device_id);
+    uint16_t index;
+
+    VMAC_Init_Check();
+    index = VMAC_Key_Find(device_id);
+    if (index == VMAC_NONE) {
+        return NULL;
+    }
+
+    return &VMAC_Entry(index)->vmac;
 }
 
 /** Compare the VMAC address
@@ -230,60 +482,81 @@ bool VMAC_Match(struct vmac_data *vmac1, struct vmac_data *vmac2)
  */
 bool VMAC_Find_By_Data(struct vmac_data *vmac, uint32_t *device_id)
 {
-    bool status = false;
-    struct vmac_data *list_vmac;
-    int count = 0;
-    int index = 0;
-
-    count = Keylist_Count(VMAC_List);
-    while (count) {
-        index = count - 1;
-        list_vmac = Keylist_Data_Index(VMAC_List, index);
-        if (list_vmac) {
-            if (VMAC_Match(vmac, list_vmac)) {
-                if (device_id) {
-                    *device_id = Keylist_Key(VMAC_List, index);
-                }
-                status = true;
-                break;
+    uint16_t index;
+
+    if (!vmac || !vmac->mac_len) {
+        return false;
+    }
+    VMAC_Init_Check();
+    index = VMAC_Data_Hash[VMAC_Data_Index(vmac)];
+    while (index != VMAC_NONE) {
+        if (VMAC_Match(vmac, &VMAC_Entry(index)->vmac)) {
+            if (device_id) {
+                *device_id = VMAC_Entry(index)->device_id;
             }
+            return true;
         }
-        count--;
+        index = VMAC_Entry(index)->next_data;
     }
 
-    return status;
+    return false;
+}
+
+/**
+ * Sets the lifetime of the VMAC added or updated from now on
+ *
+ * @param seconds - lifetime in seconds, or 0 to never age the entries
+ */
+void VMAC_Lifetime_Set(uint32_t seconds)
+{
+    VMAC_Lifetime_Seconds = seconds;
+}
+
+/**
+ * Ages the VMAC in the list, and removes the expired ones.
+ * Call it about once a second.
+ *
+ * @param seconds - number of elapsed seconds since the last call
+ */
+void VMAC_Timer(uint16_t seconds)
+{
+    struct vmac_entry *entry;
+    unsigned int i = 0;
+
+    for (i = 0; i < (VMAC_Blocks * MAX_VMAC_ENTRIES); i++) {
+        entry = VMAC_Entry(i);
+        if (entry->valid && entry->ttl_seconds_remaining) {
+            if (entry->ttl_seconds_remaining > seconds) {
+                entry->ttl_seconds_remaining -= seconds;
+            } else {
+                PRINTF("VMAC %lu expired.\n", (unsigned long)entry->device_id);
+                VMAC_Delete(entry->device_id);
+            }
+        }
+    }
 }
 
 /**
- * Cleans up the memory used by the VMAC list data
+ * Cleans up the VMAC list data
  */
 void VMAC_Cleanup(void)
 {
-    struct vmac_data *pVMAC;
-    uint32_t device_id;
-    const int index = 0;
-    unsigned i = 0;
-
-    if (VMAC_List) {
-        do {
-            device_id = Keylist_Key(VMAC_List, index);
-#if !PRINT_ENABLED
-            UNUSED(device_id);
-#endif
-            pVMAC = Keylist_Data_Delete_By_Index(VMAC_List, index);
-            if (pVMAC) {
-                PRINTF("VMAC List: %lu [", (unsigned long)device_id);
-                /* print the MAC */
-                for (i = 0; i < pVMAC->mac_len; i++) {
-                    PRINTF("%02X", pVMAC->mac[i]);
-                }
-                PRINTF("]\n");
-                free(pVMAC);
+    struct vmac_entry *entry;
+    unsigned int i = 0;
+    unsigned int j = 0;
+
+    for (i = 0; i < (VMAC_Blocks * MAX_VMAC_ENTRIES); i++) {
+        entry = VMAC_Entry(i);
+        if (entry->valid) {
+            PRINTF("VMAC List: %lu [", (unsigned long)entry->device_id);
+            /* print the MAC */
+            for (j = 0; j < entry->vmac.mac_len; j++) {
+                PRINTF("%02X", entry->vmac.mac[j]);
             }
-        } while (pVMAC);
-        Keylist_Delete(VMAC_List);
-        VMAC_List = NULL;
+            PRINTF("]\n");
+        }
     }
+    VMAC_Init();
 }
 
 /**
@@ -291,9 +564,21 @@ void VMAC_Cleanup(void)
  */
 void VMAC_Init(void)
 {
-    VMAC_List = Keylist_Create();
-    if (VMAC_List) {
-        atexit(VMAC_Cleanup);
-        PRINTF("VMAC List initialized.\n");
+    unsigned int i = 0;
+
+    for (i = 0; i < VMAC_HASH_SIZE; i++) {
+        VMAC_Key_Hash[i] = VMAC_NONE;
+        VMAC_Data_Hash[i] = VMAC_NONE;
+    }
+    /* keep the static block, and release the others */
+    for (i = 1; i < VMAC_Blocks; i++) {
+        free(VMAC_Block[i]);
+        VMAC_Block[i] = NULL;
     }
+    VMAC_Blocks = 1;
+    VMAC_Free_List = VMAC_NONE;
+    VMAC_Block_Free(0);
+    VMAC_Entries = 0;
+    VMAC_Initialized = true;
+    PRINTF("VMAC List initialized.\n");
 }
@@ -12,6 +12,18 @@
 
 /* define the max MAC as big as IPv6 + port number */
 #define VMAC_MAC_MAX 18
+/* number of VMAC entries in each block of the pool */
+#ifndef MAX_VMAC_ENTRIES
+#define MAX_VMAC_ENTRIES 1024
+#endif
+/* number of blocks the pool may grow to, 1 to keep only the static one */
+#ifndef VMAC_BLOCKS_MAX
+#define VMAC_BLOCKS_MAX (0xFFFF / MAX_VMAC_ENTRIES)
+#endif
+/* number of hash buckets of each index - must be a power of two */
+#ifndef VMAC_HASH_SIZE
+#define VMAC_HASH_SIZE 256
+#endif
 /**
 * VMAC data structure
 *
@@ -36,6 +48,8 @@ extern "C" {
     BACNET_STACK_EXPORT
     bool VMAC_Add(uint32_t device_id, struct vmac_data *pVMAC);
     BACNET_STACK_EXPORT
+    bool VMAC_Update(uint32_t device_id, struct vmac_data *pVMAC);
+    BACNET_STACK_EXPORT
     bool VMAC_Delete(uint32_t device_id);
     BACNET_STACK_EXPORT
     bool VMAC_Different(
@@ -46,6 +60,10 @@ extern "C" {
         struct vmac_data *vmac1,
         struct vmac_data *vmac2);
     BACNET_STACK_EXPORT
+    void VMAC_Lifetime_Set(uint32_t seconds);
+    BACNET_STACK_EXPORT
+    void VMAC_Timer(uint16_t seconds);
+    BACNET_STACK_EXPORT
     void VMAC_Cleanup(void);
     BACNET_STACK_EXPORT
     void VMAC_Init(void);
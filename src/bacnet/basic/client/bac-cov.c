@@ -0,0 +1,1033 @@
+/**
+ * @file
+ * @date 2026
+ * @brief Subscribe to COV of properties in other BACnet devices,
+ *  renew the subscriptions before their lifetime expires, fall back
+ *  to polling when a device refuses the subscription, and cache the
+ *  latest values.
+ *
+ * The subscriptions are kept in a table indexed by a hash of the
+ * device, object and property, and chained by a hash of the device and
+ * object, so that the values and the status flags of COV notifications
+ * are matched without a linear search.  The task services a few
+ * subscriptions per call and renewals are spread with a random jitter,
+ * so that thousands of subscriptions do not renew at the same time.
+ *
+ * The latest value of each subscription is guarded with a sequence
+ * counter: the BACnet task is the only writer, and readers in other
+ * threads retry the copy if the counter changed while they read it.
+ * This needs a memory fence from GCC, C11 or MSVC; with other compilers
+ * the values are read from the thread of the task.
+ * A handle holds a generation count, so that a handle of a removed
+ * subscription does not refer to the subscription that reuses its entry.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/bacenum.h"
+#include "bacnet/bacapp.h"
+#include "bacnet/cov.h"
+#include "bacnet/basic/binding/address.h"
+#include "bacnet/basic/services.h"
+#include "bacnet/basic/tsm/tsm.h"
+#include "bacnet/basic/sys/mstimer.h"
+/* us */
+#include "bacnet/basic/client/bac-rw.h"
+#include "bacnet/basic/client/bac-cov.h"
+
+/* number of subscriptions */
+#ifndef BACNET_COV_CLIENT_MAX
+#define BACNET_COV_CLIENT_MAX 1024
+#endif
+/* number of hash buckets - must be a power of two */
+#ifndef BACNET_COV_CLIENT_HASH_SIZE
+#define BACNET_COV_CLIENT_HASH_SIZE 256
+#endif
+/* number of subscriptions serviced per task call */
+#ifndef BACNET_COV_CLIENT_TASK_COUNT
+#define BACNET_COV_CLIENT_TASK_COUNT 16
+#endif
+/* number of subscribe requests waiting for a response */
+#ifndef BACNET_COV_CLIENT_PENDING_MAX
+#define BACNET_COV_CLIENT_PENDING_MAX 4
+#endif
+/* number of timeouts before the subscription falls back to polling */
+#ifndef BACNET_COV_CLIENT_TIMEOUT_MAX
+#define BACNET_COV_CLIENT_TIMEOUT_MAX 3
+#endif
+
+#if defined(__GNUC__)
+#define COV_CLIENT_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && \
+    !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define COV_CLIENT_BARRIER() atomic_thread_fence(memory_order_seq_cst)
+#elif defined(_MSC_VER)
+#include <windows.h>
+#define COV_CLIENT_BARRIER() MemoryBarrier()
+#else
+/* no fence: call bacnet_cov_client_value() from the task thread */
+#define COV_CLIENT_BARRIER()
+#endif
+
+#define COV_CLIENT_NONE 0xFFFF
+/* handles hold the entry index and the generation of the entry */
+#define COV_CLIENT_GENERATION_MASK 0x7FFF
+#define COV_CLIENT_HANDLE(index, generation) \
+    ((int)(((uint32_t)(generation) << 16) | (uint32_t)(index)))
+
+typedef enum {
+    COV_CLIENT_STATE_FREE,
+    COV_CLIENT_STATE_SUBSCRIBE,
+    COV_CLIENT_STATE_WAITING,
+    COV_CLIENT_STATE_SUBSCRIBED,
+    COV_CLIENT_STATE_POLL,
+    COV_CLIENT_STATE_CANCEL
+} COV_CLIENT_STATE;
+
+typedef struct bacnet_cov_client_entry {
+    uint32_t Device_ID;
+    uint32_t Object_Instance;
+    uint16_t Object_Type;
+    uint32_t Object_Property;
+    /* subscriber process identifier of the subscription */
+    uint32_t Process_ID;
+    uint8_t State;
+    uint8_t Invoke_ID;
+    bool Acked;
+    uint8_t Failures;
+    /* seconds when the next action is due */
+    uint32_t Due;
+    /* seconds when COV is tried again while polling */
+    uint32_t Retry;
+    /* hash bucket chain, or free list */
+    uint16_t Next;
+    /* chain of the subscriptions of the same object */
+    uint16_t Object_Next;
+    /* incremented when the entry is freed, to invalidate its handles */
+    volatile uint16_t Generation;
+    /* odd while the value is written */
+    volatile uint32_t Sequence;
+    BACNET_COV_CLIENT_VALUE Value;
+} BACNET_COV_CLIENT_ENTRY;
+
+static BACNET_COV_CLIENT_ENTRY Entry_Table[BACNET_COV_CLIENT_MAX];
+static uint16_t Hash_Table[BACNET_COV_CLIENT_HASH_SIZE];
+static uint16_t Object_Hash_Table[BACNET_COV_CLIENT_HASH_SIZE];
+static uint16_t Free_List;
+static unsigned Entry_Count;
+static uint16_t Pending_List[BACNET_COV_CLIENT_PENDING_MAX];
+static unsigned Task_Index;
+/* monotonic seconds, driven by the task */
+static uint32_t Seconds;
+static struct mstimer Seconds_Timer;
+/* rate limit of the Who-Is for unbound devices */
+static uint32_t WhoIs_Device_ID = BACNET_MAX_INSTANCE + 1;
+static uint32_t WhoIs_Seconds;
+/* jitter generator state */
+static uint32_t Jitter_State = 2463534242UL;
+/* configuration */
+static uint32_t Lifetime_Seconds = 300;
+static uint32_t Poll_Seconds = 60;
+static uint32_t Retry_Seconds = 3600;
+static bool Confirmed_Notifications;
+static uint32_t Process_ID = 1;
+/* each notification handler links its own callback node */
+static BACNET_COV_NOTIFICATION Confirmed_Notification_Callback;
+static BACNET_COV_NOTIFICATION Unconfirmed_Notification_Callback;
+/* the bac-rw value callback stays free for the application */
+static BACNET_READ_WRITE_VALUE_NOTIFICATION Value_Notification;
+
+/**
+ * @brief Compute the hash bucket of a subscription
+ */
+static unsigned cov_client_hash(uint32_t device_id,
+    uint16_t object_type,
+    uint32_t object_instance,
+    uint32_t object_property)
+{
+    uint32_t hash;
+
+    hash = device_id * 2654435761UL;
+    hash ^= (((uint32_t)object_type << 22) ^ object_instance) * 2246822519UL;
+    hash ^= object_property * 3266489917UL;
+    hash ^= hash >> 15;
+
+    return hash & (BACNET_COV_CLIENT_HASH_SIZE - 1);
+}
+
+/**
+ * @brief Compute the hash bucket of the subscriptions of an object
+ */
+static unsigned cov_client_object_hash(
+    uint32_t device_id, uint16_t object_type, uint32_t object_instance)
+{
+    uint32_t hash;
+
+    hash = device_id * 2654435761UL;
+    hash ^= (((uint32_t)object_type << 22) ^ object_instance) * 2246822519UL;
+    hash ^= hash >> 15;
+
+    return hash & (BACNET_COV_CLIENT_HASH_SIZE - 1);
+}
+
+/**
+ * @brief Get a pseudo random jitter for the renewal schedule
+ * @param range - largest jitter, in seconds
+ * @return jitter from 0 to range
+ */
+static uint32_t cov_client_jitter(uint32_t range)
+{
+    /* xorshift32 */
+    Jitter_State ^= Jitter_State << 13;
+    Jitter_State ^= Jitter_State >> 17;
+    Jitter_State ^= Jitter_State << 5;
+
+    return Jitter_State % (range + 1);
+}
+
+/**
+ * @brief Determine if a time in seconds has been reached
+ */
+static bool cov_client_due(uint32_t due)
+{
+    return (int32_t)(Seconds - due) >= 0;
+}
+
+/**
+ * @brief Find the index of a subscription
+ * @param cancel - true to find a subscription that is being cancelled,
+ *  false to find an active subscription
+ * @return index of the subscription, or COV_CLIENT_NONE
+ */
+static uint16_t cov_client_index_find(uint32_t device_id,
+    uint16_t object_type,
+    uint32_t object_instance,
+    uint32_t object_property,
+    bool cancel)
+{
+    BACNET_COV_CLIENT_ENTRY *entry;
+    uint16_t index;
+
+    index = Hash_Table[cov_client_hash(
+        device_id, object_type, object_instance, object_property)];
+    while (index != COV_CLIENT_NONE) {
+        entry = &Entry_Table[index];
+        if ((entry->Device_ID == device_id) &&
+            (entry->Object_Type == object_type) &&
+            (entry->Object_Instance == object_instance) &&
+            (entry->Object_Property == object_property) &&
+            ((entry->State == COV_CLIENT_STATE_CANCEL) == cancel)) {
+            return index;
+        }
+        index = entry->Next;
+    }
+
+    return COV_CLIENT_NONE;
+}
+
+/**
+ * @brief Get the entry of a handle
+ * @return entry of the handle, or NULL if the handle is not valid
+ */
+static BACNET_COV_CLIENT_ENTRY *cov_client_handle_entry(int handle)
+{
+    BACNET_COV_CLIENT_ENTRY *entry;
+    uint32_t index;
+
+    if (handle < 0) {
+        return NULL;
+    }
+    index = (uint32_t)handle & 0xFFFF;
+    if (index >= BACNET_COV_CLIENT_MAX) {
+        return NULL;
+    }
+    entry = &Entry_Table[index];
+    if ((entry->State == COV_CLIENT_STATE_FREE) ||
+        (entry->Generation != ((uint32_t)handle >> 16))) {
+        return NULL;
+    }
+
+    return entry;
+}
+
+/**
+ * @brief Begin a write of the cached value of a subscription
+ */
+static void cov_client_value_write_begin(BACNET_COV_CLIENT_ENTRY *entry)
+{
+    entry->Sequence++;
+    COV_CLIENT_BARRIER();
+}
+
+/**
+ * @brief End a write of the cached value of a subscription
+ */
+static void cov_client_value_write_end(BACNET_COV_CLIENT_ENTRY *entry)
+{
+    COV_CLIENT_BARRIER();
+    entry->Sequence++;
+}
+
+/**
+ * @brief Unlink a subscription from its hash bucket, and free it
+ */
+static void cov_client_entry_free(uint16_t index)
+{
+    BACNET_COV_CLIENT_ENTRY *entry = &Entry_Table[index];
+    uint16_t *link;
+
+    link = &Hash_Table[cov_client_hash(entry->Device_ID, entry->Object_Type,
+        entry->Object_Instance, entry->Object_Property)];
+    while (*link != COV_CLIENT_NONE) {
+        if (*link == index) {
+            *link = entry->Next;
+            break;
+        }
+        link = &Entry_Table[*link].Next;
+    }
+    link = &Object_Hash_Table[cov_client_object_hash(
+        entry->Device_ID, entry->Object_Type, entry->Object_Instance)];
+    while (*link != COV_CLIENT_NONE) {
+        if (*link == index) {
+            *link = entry->Object_Next;
+            break;
+        }
+        link = &Entry_Table[*link].Object_Next;
+    }
+    /* invalidate the handles of the entry */
+    cov_client_value_write_begin(entry);
+    entry->Generation = (entry->Generation + 1) & COV_CLIENT_GENERATION_MASK;
+    cov_client_value_write_end(entry);
+    entry->State = COV_CLIENT_STATE_FREE;
+    entry->Next = Free_List;
+    Free_List = index;
+    if (Entry_Count) {
+        Entry_Count--;
+    }
+}
+
+/**
+ * @brief Store a value into the cached value of a subscription
+ * @param entry - subscription
+ * @param value - value to store
+ * @param cov - true if the value came from a COV notification
+ */
+static void cov_client_value_store(BACNET_COV_CLIENT_ENTRY *entry,
+    BACNET_APPLICATION_DATA_VALUE *value,
+    bool cov)
+{
+    BACNET_COV_CLIENT_VALUE *cache = &entry->Value;
+
+    cov_client_value_write_begin(entry);
+    cache->tag = value->tag;
+    switch (value->tag) {
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            cache->type.Boolean = value->type.Boolean;
+            break;
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            cache->type.Unsigned_Int = value->type.Unsigned_Int;
+            break;
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            cache->type.Signed_Int = value->type.Signed_Int;
+            break;
+        case BACNET_APPLICATION_TAG_REAL:
+            cache->type.Real = value->type.Real;
+            break;
+#if defined(BACAPP_DOUBLE)
+        case BACNET_APPLICATION_TAG_DOUBLE:
+            cache->type.Double = value->type.Double;
+            break;
+#endif
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            cache->type.Enumerated = value->type.Enumerated;
+            break;
+        default:
+            /* only the data types of primitive values are cached */
+            cache->tag = BACNET_APPLICATION_TAG_NULL;
+            break;
+    }
+    cache->cov = cov;
+    cache->seconds = Seconds;
+    cov_client_value_write_end(entry);
+}
+
+/**
+ * @brief Store the status flags into the cached value of a subscription
+ */
+static void cov_client_status_flags_store(
+    BACNET_COV_CLIENT_ENTRY *entry, BACNET_BIT_STRING *bit_string)
+{
+    uint8_t status_flags = 0;
+    uint8_t bit;
+
+    for (bit = 0; bit < 4; bit++) {
+        if (bitstring_bit(bit_string, bit)) {
+            status_flags |= (1 << bit);
+        }
+    }
+    cov_client_value_write_begin(entry);
+    entry->Value.status_flags = status_flags;
+    cov_client_value_write_end(entry);
+}
+
+/**
+ * @brief Remove a subscription from the pending list
+ */
+static void cov_client_pending_remove(uint16_t index)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_COV_CLIENT_PENDING_MAX; i++) {
+        if (Pending_List[i] == index) {
+            Pending_List[i] = COV_CLIENT_NONE;
+        }
+    }
+}
+
+/**
+ * @brief Add a subscription to the pending list
+ * @return true if added
+ */
+static bool cov_client_pending_add(uint16_t index)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_COV_CLIENT_PENDING_MAX; i++) {
+        if (Pending_List[i] == COV_CLIENT_NONE) {
+            Pending_List[i] = index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Determine if another subscribe request can be sent
+ */
+static bool cov_client_pending_full(void)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_COV_CLIENT_PENDING_MAX; i++) {
+        if (Pending_List[i] == COV_CLIENT_NONE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Send a SubscribeCOV or SubscribeCOVProperty request
+ * @param entry - subscription
+ * @param cancel - true to cancel the subscription
+ * @return invoke ID of the request, or 0 if not sent
+ */
+static uint8_t cov_client_subscribe_send(
+    BACNET_COV_CLIENT_ENTRY *entry, bool cancel)
+{
+    BACNET_SUBSCRIBE_COV_DATA cov_data = { 0 };
+
+    cov_data.subscriberProcessIdentifier = entry->Process_ID;
+    cov_data.monitoredObjectIdentifier.type = entry->Object_Type;
+    cov_data.monitoredObjectIdentifier.instance = entry->Object_Instance;
+    cov_data.cancellationRequest = cancel;
+    cov_data.issueConfirmedNotifications = Confirmed_Notifications;
+    cov_data.lifetime = Lifetime_Seconds;
+    if (entry->Object_Property != PROP_PRESENT_VALUE) {
+        cov_data.covSubscribeToProperty = true;
+        cov_data.monitoredProperty.propertyIdentifier =
+            (BACNET_PROPERTY_ID)entry->Object_Property;
+        cov_data.monitoredProperty.propertyArrayIndex = BACNET_ARRAY_ALL;
+    }
+
+    return Send_COV_Subscribe(entry->Device_ID, &cov_data);
+}
+
+/**
+ * @brief Switch a subscription to polling of the property
+ */
+static void cov_client_poll_start(BACNET_COV_CLIENT_ENTRY *entry)
+{
+    entry->State = COV_CLIENT_STATE_POLL;
+    entry->Failures = 0;
+    entry->Due = Seconds;
+    entry->Retry = Seconds + Retry_Seconds + cov_client_jitter(Poll_Seconds);
+}
+
+/**
+ * @brief Schedule the renewal of an acknowledged subscription
+ *
+ * The subscription is renewed after three quarters of its lifetime,
+ * less a jitter of up to an eighth of the lifetime.
+ */
+static void cov_client_renew_schedule(BACNET_COV_CLIENT_ENTRY *entry)
+{
+    uint32_t renew;
+
+    renew = Lifetime_Seconds - (Lifetime_Seconds / 4);
+    renew -= cov_client_jitter(Lifetime_Seconds / 8);
+    if (renew == 0) {
+        renew = 1;
+    }
+    entry->State = COV_CLIENT_STATE_SUBSCRIBED;
+    entry->Failures = 0;
+    entry->Due = Seconds + renew;
+}
+
+/**
+ * @brief Bind to the device of a subscription, and send the request
+ * @param index - index of the subscription
+ */
+static void cov_client_subscribe(uint16_t index)
+{
+    BACNET_COV_CLIENT_ENTRY *entry = &Entry_Table[index];
+    BACNET_ADDRESS dest = { 0 };
+    unsigned max_apdu = 0;
+    uint8_t invoke_id;
+
+    if (cov_client_index_find(entry->Device_ID, entry->Object_Type,
+            entry->Object_Instance, entry->Object_Property, true) !=
+        COV_CLIENT_NONE) {
+        /* wait until the cancellation of the previous one is answered */
+        return;
+    }
+    if (!address_bind_request(entry->Device_ID, &max_apdu, &dest)) {
+        if ((WhoIs_Device_ID != entry->Device_ID) ||
+            cov_client_due(WhoIs_Seconds)) {
+            WhoIs_Device_ID = entry->Device_ID;
+            WhoIs_Seconds = Seconds + 5;
+            Send_WhoIs(entry->Device_ID, entry->Device_ID);
+        }
+        return;
+    }
+    if (cov_client_pending_full()) {
+        return;
+    }
+    invoke_id = cov_client_subscribe_send(entry, false);
+    if (invoke_id) {
+        entry->Invoke_ID = invoke_id;
+        entry->Acked = false;
+        entry->State = COV_CLIENT_STATE_WAITING;
+        cov_client_pending_add(index);
+    }
+}
+
+/**
+ * @brief Handle the result of a subscribe request
+ * @param index - index of the subscription
+ */
+static void cov_client_waiting(uint16_t index)
+{
+    BACNET_COV_CLIENT_ENTRY *entry = &Entry_Table[index];
+    uint32_t backoff;
+
+    if (tsm_invoke_id_free(entry->Invoke_ID)) {
+        cov_client_pending_remove(index);
+        if (entry->Acked) {
+            cov_client_renew_schedule(entry);
+        } else {
+            /* Error, Reject or Abort: the device refused */
+            cov_client_poll_start(entry);
+        }
+    } else if (tsm_invoke_id_failed(entry->Invoke_ID)) {
+        tsm_free_invoke_id(entry->Invoke_ID);
+        cov_client_pending_remove(index);
+        entry->Failures++;
+        if (entry->Failures >= BACNET_COV_CLIENT_TIMEOUT_MAX) {
+            cov_client_poll_start(entry);
+        } else {
+            /* exponential back-off */
+            backoff = 1UL << entry->Failures;
+            entry->State = COV_CLIENT_STATE_SUBSCRIBE;
+            entry->Due = Seconds + backoff + cov_client_jitter(backoff);
+        }
+    }
+}
+
+/**
+ * @brief Service one subscription
+ * @param index - index of the subscription
+ */
+static void cov_client_process(uint16_t index)
+{
+    BACNET_COV_CLIENT_ENTRY *entry = &Entry_Table[index];
+
+    switch (entry->State) {
+        case COV_CLIENT_STATE_SUBSCRIBE:
+            if (cov_client_due(entry->Due)) {
+                cov_client_subscribe(index);
+            }
+            break;
+        case COV_CLIENT_STATE_WAITING:
+            cov_client_waiting(index);
+            break;
+        case COV_CLIENT_STATE_SUBSCRIBED:
+            if (cov_client_due(entry->Due)) {
+                entry->State = COV_CLIENT_STATE_SUBSCRIBE;
+                cov_client_subscribe(index);
+            }
+            break;
+        case COV_CLIENT_STATE_POLL:
+            if (cov_client_due(entry->Retry)) {
+                entry->State = COV_CLIENT_STATE_SUBSCRIBE;
+                cov_client_subscribe(index);
+            } else if (cov_client_due(entry->Due) &&
+                !bacnet_read_write_busy()) {
+                if (bacnet_read_property_queue(entry->Device_ID,
+                        (BACNET_OBJECT_TYPE)entry->Object_Type,
+                        entry->Object_Instance,
+                        (BACNET_PROPERTY_ID)entry->Object_Property,
+                        BACNET_ARRAY_ALL)) {
+                    entry->Due = Seconds + Poll_Seconds;
+                }
+            }
+            break;
+        case COV_CLIENT_STATE_CANCEL:
+            if (tsm_invoke_id_free(entry->Invoke_ID)) {
+                cov_client_pending_remove(index);
+                cov_client_entry_free(index);
+            } else if (tsm_invoke_id_failed(entry->Invoke_ID)) {
+                tsm_free_invoke_id(entry->Invoke_ID);
+                cov_client_pending_remove(index);
+                cov_client_entry_free(index);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Handle a SimpleACK of a SubscribeCOV or SubscribeCOVProperty
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param invoke_id [in] the invokeID of the acknowledged message
+ */
+static void cov_client_simple_ack_handler(
+    BACNET_ADDRESS *src, uint8_t invoke_id)
+{
+    BACNET_COV_CLIENT_ENTRY *entry;
+    unsigned i;
+
+    (void)src;
+    for (i = 0; i < BACNET_COV_CLIENT_PENDING_MAX; i++) {
+        if (Pending_List[i] != COV_CLIENT_NONE) {
+            entry = &Entry_Table[Pending_List[i]];
+            if (entry->Invoke_ID == invoke_id) {
+                entry->Acked = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Store the values of a COV notification
+ * @param cov_data [in] the decoded COV notification
+ */
+static void cov_client_notification(BACNET_COV_DATA *cov_data)
+{
+    BACNET_PROPERTY_VALUE *property_value;
+    BACNET_COV_CLIENT_ENTRY *entry;
+    uint16_t index;
+    uint32_t device_id = cov_data->initiatingDeviceIdentifier;
+    uint32_t process_id = cov_data->subscriberProcessIdentifier;
+    uint16_t type = cov_data->monitoredObjectIdentifier.type;
+    uint32_t instance = cov_data->monitoredObjectIdentifier.instance;
+
+    property_value = cov_data->listOfValues;
+    while (property_value) {
+        index = cov_client_index_find(device_id, type, instance,
+            property_value->propertyIdentifier, false);
+        if ((index != COV_CLIENT_NONE) &&
+            (Entry_Table[index].Process_ID == process_id)) {
+            cov_client_value_store(
+                &Entry_Table[index], &property_value->value, true);
+        }
+        property_value = property_value->next;
+    }
+    /* the status flags describe every property of the object */
+    property_value = cov_data->listOfValues;
+    while (property_value) {
+        if ((property_value->propertyIdentifier == PROP_STATUS_FLAGS) &&
+            (property_value->value.tag == BACNET_APPLICATION_TAG_BIT_STRING)) {
+            break;
+        }
+        property_value = property_value->next;
+    }
+    if (property_value) {
+        index = Object_Hash_Table[cov_client_object_hash(
+            device_id, type, instance)];
+        while (index != COV_CLIENT_NONE) {
+            entry = &Entry_Table[index];
+            if ((entry->State != COV_CLIENT_STATE_CANCEL) &&
+                (entry->Device_ID == device_id) &&
+                (entry->Object_Type == type) &&
+                (entry->Object_Instance == instance) &&
+                (entry->Process_ID == process_id)) {
+                cov_client_status_flags_store(
+                    entry, &property_value->value.type.Bit_String);
+            }
+            index = entry->Object_Next;
+        }
+    }
+}
+
+/**
+ * @brief Save the value of a polled property
+ *
+ * This is a bac-rw value notification, which is linked by
+ * bacnet_cov_client_init().
+ *
+ * @param device_instance [in] device instance number where data originated
+ * @param rp_data [in] Pointer to the BACNET_READ_PROPERTY_DATA structure
+ * @param value [in] pointer to the decoded value, or NULL on error
+ */
+void bacnet_cov_client_value_save(uint32_t device_instance,
+    BACNET_READ_PROPERTY_DATA *rp_data,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    uint16_t index;
+
+    if (!rp_data || !value) {
+        return;
+    }
+    index = cov_client_index_find(device_instance, rp_data->object_type,
+        rp_data->object_instance, rp_data->object_property, false);
+    if (index != COV_CLIENT_NONE) {
+        cov_client_value_store(&Entry_Table[index], value, false);
+    }
+}
+
+/**
+ * @brief Add a subscription to a property of an object in a device
+ * @param device_id - device instance number
+ * @param object_type - type of the monitored object
+ * @param object_instance - instance of the monitored object
+ * @param object_property - monitored property.  Present_Value uses
+ *  SubscribeCOV, other properties use SubscribeCOVProperty.
+ * @return handle of the subscription, or BACNET_STATUS_ERROR
+ *  if the table is full
+ */
+int bacnet_cov_client_add(uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property)
+{
+    BACNET_COV_CLIENT_ENTRY *entry;
+    unsigned hash;
+    uint16_t index;
+
+    /* a subscription that is being cancelled is not reused */
+    index = cov_client_index_find(
+        device_id, object_type, object_instance, object_property, false);
+    if (index != COV_CLIENT_NONE) {
+        return COV_CLIENT_HANDLE(index, Entry_Table[index].Generation);
+    }
+    if (Free_List == COV_CLIENT_NONE) {
+        return BACNET_STATUS_ERROR;
+    }
+    index = Free_List;
+    entry = &Entry_Table[index];
+    Free_List = entry->Next;
+    entry->Device_ID = device_id;
+    entry->Object_Type = object_type;
+    entry->Object_Instance = object_instance;
+    entry->Object_Property = object_property;
+    entry->Process_ID = Process_ID;
+    entry->State = COV_CLIENT_STATE_SUBSCRIBE;
+    entry->Invoke_ID = 0;
+    entry->Acked = false;
+    entry->Failures = 0;
+    /* spread the initial requests */
+    entry->Due = Seconds + cov_client_jitter(Entry_Count / 32);
+    entry->Retry = 0;
+    cov_client_value_write_begin(entry);
+    memset(&entry->Value, 0, sizeof(entry->Value));
+    entry->Value.tag = BACNET_APPLICATION_TAG_NULL;
+    cov_client_value_write_end(entry);
+    hash = cov_client_hash(
+        device_id, object_type, object_instance, object_property);
+    entry->Next = Hash_Table[hash];
+    Hash_Table[hash] = index;
+    hash = cov_client_object_hash(device_id, object_type, object_instance);
+    entry->Object_Next = Object_Hash_Table[hash];
+    Object_Hash_Table[hash] = index;
+    Entry_Count++;
+
+    return COV_CLIENT_HANDLE(index, entry->Generation);
+}
+
+/**
+ * @brief Find the handle of a subscription
+ * @return handle of the subscription, or BACNET_STATUS_ERROR
+ */
+int bacnet_cov_client_find(uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property)
+{
+    uint16_t index;
+
+    index = cov_client_index_find(
+        device_id, object_type, object_instance, object_property, false);
+    if (index == COV_CLIENT_NONE) {
+        return BACNET_STATUS_ERROR;
+    }
+
+    return COV_CLIENT_HANDLE(index, Entry_Table[index].Generation);
+}
+
+/**
+ * @brief Remove a subscription, and cancel it in the device
+ * @param handle - handle of the subscription
+ * @return true if the subscription was removed
+ */
+bool bacnet_cov_client_remove(int handle)
+{
+    BACNET_COV_CLIENT_ENTRY *entry;
+    uint16_t index;
+    uint8_t invoke_id = 0;
+
+    entry = cov_client_handle_entry(handle);
+    if (!entry) {
+        return false;
+    }
+    index = (uint16_t)(handle & 0xFFFF);
+    switch (entry->State) {
+        case COV_CLIENT_STATE_CANCEL:
+            return false;
+        case COV_CLIENT_STATE_WAITING:
+            /* the answer to the subscription is no longer needed */
+            tsm_free_invoke_id(entry->Invoke_ID);
+            cov_client_pending_remove(index);
+            invoke_id = cov_client_subscribe_send(entry, true);
+            break;
+        case COV_CLIENT_STATE_SUBSCRIBED:
+            invoke_id = cov_client_subscribe_send(entry, true);
+            break;
+        default:
+            break;
+    }
+    if (invoke_id) {
+        /* keep the entry until the cancellation is answered */
+        entry->Invoke_ID = invoke_id;
+        entry->State = COV_CLIENT_STATE_CANCEL;
+    } else {
+        cov_client_entry_free(index);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Copy the latest value of a subscription
+ *
+ * This function may be called from a thread other than the one
+ * running bacnet_cov_client_task().
+ *
+ * @param handle - handle of the subscription
+ * @param value - [out] latest value
+ * @return true if the handle is valid
+ */
+bool bacnet_cov_client_value(int handle, BACNET_COV_CLIENT_VALUE *value)
+{
+    BACNET_COV_CLIENT_ENTRY *entry;
+    uint32_t sequence;
+    uint32_t index;
+    uint16_t generation;
+
+    if ((handle < 0) || !value) {
+        return false;
+    }
+    index = (uint32_t)handle & 0xFFFF;
+    if (index >= BACNET_COV_CLIENT_MAX) {
+        return false;
+    }
+    entry = &Entry_Table[index];
+    do {
+        sequence = entry->Sequence;
+        COV_CLIENT_BARRIER();
+        generation = entry->Generation;
+        memcpy(value, (const void *)&entry->Value, sizeof(*value));
+        COV_CLIENT_BARRIER();
+    } while ((sequence & 1) || (sequence != entry->Sequence));
+
+    return (generation == ((uint32_t)handle >> 16)) &&
+        (entry->State != COV_CLIENT_STATE_FREE);
+}
+
+/**
+ * @brief Get how the value of a subscription is kept up to date
+ * @param handle - handle of the subscription
+ * @return mode of the subscription
+ */
+BACNET_COV_CLIENT_MODE bacnet_cov_client_mode(int handle)
+{
+    BACNET_COV_CLIENT_ENTRY *entry;
+
+    entry = cov_client_handle_entry(handle);
+    if (!entry) {
+        return BACNET_COV_CLIENT_MODE_NONE;
+    }
+    switch (entry->State) {
+        case COV_CLIENT_STATE_SUBSCRIBE:
+        case COV_CLIENT_STATE_WAITING:
+            return BACNET_COV_CLIENT_MODE_SUBSCRIBING;
+        case COV_CLIENT_STATE_SUBSCRIBED:
+            return BACNET_COV_CLIENT_MODE_COV;
+        case COV_CLIENT_STATE_POLL:
+            return BACNET_COV_CLIENT_MODE_POLL;
+        default:
+            break;
+    }
+
+    return BACNET_COV_CLIENT_MODE_NONE;
+}
+
+/**
+ * @brief Get the number of subscriptions
+ * @return number of subscriptions
+ */
+unsigned bacnet_cov_client_count(void)
+{
+    return Entry_Count;
+}
+
+/**
+ * @brief Get the seconds counter used to time stamp the values
+ * @return number of seconds since bacnet_cov_client_init()
+ */
+uint32_t bacnet_cov_client_seconds(void)
+{
+    return Seconds;
+}
+
+/**
+ * @brief Set the lifetime of the subscriptions
+ * @param seconds - lifetime, in seconds.  Renewals are sent after
+ *  about three quarters of the lifetime.
+ */
+void bacnet_cov_client_lifetime_set(uint32_t seconds)
+{
+    if (seconds >= 8) {
+        Lifetime_Seconds = seconds;
+    }
+}
+
+/**
+ * @brief Set the poll interval of subscriptions refused by the device
+ * @param seconds - number of seconds between reads
+ */
+void bacnet_cov_client_poll_seconds_set(uint32_t seconds)
+{
+    if (seconds) {
+        Poll_Seconds = seconds;
+    }
+}
+
+/**
+ * @brief Set how long a refused subscription is polled before
+ *  COV is tried again
+ * @param seconds - number of seconds
+ */
+void bacnet_cov_client_retry_seconds_set(uint32_t seconds)
+{
+    if (seconds) {
+        Retry_Seconds = seconds;
+    }
+}
+
+/**
+ * @brief Set whether the devices send confirmed COV notifications
+ * @param confirmed - true for confirmed notifications
+ */
+void bacnet_cov_client_confirmed_set(bool confirmed)
+{
+    Confirmed_Notifications = confirmed;
+}
+
+/**
+ * @brief Set the subscriber process identifier of the subscriptions
+ * @param process_id - subscriber process identifier
+ */
+void bacnet_cov_client_process_id_set(uint32_t process_id)
+{
+    Process_ID = process_id;
+}
+
+/**
+ * @brief Handles the COV client repetitive task
+ *
+ * bacnet_read_write_task() must also be called, for instance by
+ * bacnet_task(), to poll the properties refused by the devices.
+ */
+void bacnet_cov_client_task(void)
+{
+    unsigned i;
+
+    while (mstimer_expired(&Seconds_Timer)) {
+        mstimer_reset(&Seconds_Timer);
+        Seconds++;
+    }
+    for (i = 0; i < BACNET_COV_CLIENT_PENDING_MAX; i++) {
+        if (Pending_List[i] != COV_CLIENT_NONE) {
+            cov_client_process(Pending_List[i]);
+        }
+    }
+    for (i = 0; i < BACNET_COV_CLIENT_TASK_COUNT; i++) {
+        if (Entry_Table[Task_Index].State != COV_CLIENT_STATE_WAITING) {
+            cov_client_process(Task_Index);
+        }
+        Task_Index++;
+        if (Task_Index >= BACNET_COV_CLIENT_MAX) {
+            Task_Index = 0;
+        }
+    }
+}
+
+/**
+ * @brief Initializes the COV client module
+ */
+void bacnet_cov_client_init(void)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_COV_CLIENT_HASH_SIZE; i++) {
+        Hash_Table[i] = COV_CLIENT_NONE;
+        Object_Hash_Table[i] = COV_CLIENT_NONE;
+    }
+    for (i = 0; i < BACNET_COV_CLIENT_MAX; i++) {
+        Entry_Table[i].State = COV_CLIENT_STATE_FREE;
+        Entry_Table[i].Next = i + 1;
+        Entry_Table[i].Object_Next = COV_CLIENT_NONE;
+    }
+    Entry_Table[BACNET_COV_CLIENT_MAX - 1].Next = COV_CLIENT_NONE;
+    Free_List = 0;
+    Entry_Count = 0;
+    for (i = 0; i < BACNET_COV_CLIENT_PENDING_MAX; i++) {
+        Pending_List[i] = COV_CLIENT_NONE;
+    }
+    Task_Index = 0;
+    Seconds = 0;
+    mstimer_set(&Seconds_Timer, 1000);
+    apdu_set_confirmed_simple_ack_handler(
+        SERVICE_CONFIRMED_SUBSCRIBE_COV, cov_client_simple_ack_handler);
+    apdu_set_confirmed_simple_ack_handler(
+        SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY,
+        cov_client_simple_ack_handler);
+    apdu_set_confirmed_handler(
+        SERVICE_CONFIRMED_COV_NOTIFICATION, handler_ccov_notification);
+    apdu_set_unconfirmed_handler(
+        SERVICE_UNCONFIRMED_COV_NOTIFICATION, handler_ucov_notification);
+    Confirmed_Notification_Callback.callback = cov_client_notification;
+    handler_ccov_notification_add(&Confirmed_Notification_Callback);
+    Unconfirmed_Notification_Callback.callback = cov_client_notification;
+    handler_ucov_notification_add(&Unconfirmed_Notification_Callback);
+    Value_Notification.callback = bacnet_cov_client_value_save;
+    bacnet_read_write_value_notification_add(&Value_Notification);
+}
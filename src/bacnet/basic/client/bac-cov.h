@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @date 2026
+ * @brief Subscribe to COV of properties in other BACnet devices,
+ *  and cache their latest values
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef BAC_COV_H
+#define BAC_COV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/bacenum.h"
+#include "bacnet/bacapp.h"
+#include "bacnet/rp.h"
+#include "bacnet/bacnet_stack_exports.h"
+
+/* how the value of a property is kept up to date */
+typedef enum {
+    BACNET_COV_CLIENT_MODE_NONE,
+    /* binding to the device, or waiting for the subscription result */
+    BACNET_COV_CLIENT_MODE_SUBSCRIBING,
+    /* the device notifies the changes */
+    BACNET_COV_CLIENT_MODE_COV,
+    /* the device refused the subscription, so the property is read */
+    BACNET_COV_CLIENT_MODE_POLL
+} BACNET_COV_CLIENT_MODE;
+
+/* latest value of a property */
+typedef struct bacnet_cov_client_value_t {
+    /* application tag of the value, or NULL when no value was received */
+    uint8_t tag;
+    union {
+        bool Boolean;
+        float Real;
+        double Double;
+        BACNET_UNSIGNED_INTEGER Unsigned_Int;
+        int32_t Signed_Int;
+        uint32_t Enumerated;
+    } type;
+    /* BACnetStatusFlags, bit 0 = in-alarm .. bit 3 = out-of-service */
+    uint8_t status_flags;
+    /* true if the value came from a COV notification, false if read */
+    bool cov;
+    /* bacnet_cov_client_seconds() when the value was received */
+    uint32_t seconds;
+} BACNET_COV_CLIENT_VALUE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void bacnet_cov_client_init(void);
+BACNET_STACK_EXPORT
+void bacnet_cov_client_task(void);
+BACNET_STACK_EXPORT
+int bacnet_cov_client_add(uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+int bacnet_cov_client_find(uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+bool bacnet_cov_client_remove(int handle);
+BACNET_STACK_EXPORT
+bool bacnet_cov_client_value(int handle, BACNET_COV_CLIENT_VALUE *value);
+BACNET_STACK_EXPORT
+BACNET_COV_CLIENT_MODE bacnet_cov_client_mode(int handle);
+BACNET_STACK_EXPORT
+unsigned bacnet_cov_client_count(void);
+BACNET_STACK_EXPORT
+uint32_t bacnet_cov_client_seconds(void);
+BACNET_STACK_EXPORT
+void bacnet_cov_client_lifetime_set(uint32_t seconds);
+BACNET_STACK_EXPORT
+void bacnet_cov_client_poll_seconds_set(uint32_t seconds);
+BACNET_STACK_EXPORT
+void bacnet_cov_client_retry_seconds_set(uint32_t seconds);
+BACNET_STACK_EXPORT
+void bacnet_cov_client_confirmed_set(bool confirmed);
+BACNET_STACK_EXPORT
+void bacnet_cov_client_process_id_set(uint32_t process_id);
+BACNET_STACK_EXPORT
+void bacnet_cov_client_value_save(uint32_t device_instance,
+    BACNET_READ_PROPERTY_DATA *rp_data,
+    BACNET_APPLICATION_DATA_VALUE *value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -32,6 +32,8 @@ static struct mstimer Cache_Timer;
 static struct mstimer Read_Write_Timer;
 /* where the data from the read is stored */
 static bacnet_read_write_value_callback_t bacnet_read_write_value_callback;
+/* head of the list of additional value callbacks */
+static BACNET_READ_WRITE_VALUE_NOTIFICATION Value_Notification_Head;
 
 /* states for client task */
 typedef enum {
@@ -191,6 +193,28 @@ static void MyWritePropertySimpleAckHandler(
     }
 }
 
+/**
+ * @brief Pass a value, or an error when value is NULL, to the value
+ *  callback and to every linked value notification
+ */
+static void bacnet_read_write_value_notify(uint32_t device_instance,
+    BACNET_READ_PROPERTY_DATA *rp_data,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    BACNET_READ_WRITE_VALUE_NOTIFICATION *head;
+
+    if (bacnet_read_write_value_callback) {
+        bacnet_read_write_value_callback(device_instance, rp_data, value);
+    }
+    head = Value_Notification_Head.next;
+    while (head) {
+        if (head->callback) {
+            head->callback(device_instance, rp_data, value);
+        }
+        head = head->next;
+    }
+}
+
 /** Handler for a ReadProperty ACK.
  *  Saves the data from a matching read-property request
  *
@@ -234,10 +258,8 @@ static void My_Read_Property_Ack_Handler(uint8_t *service_request,
                     /* handle the data */
                     rp_data.error_class = ERROR_CLASS_SERVICES;
                     rp_data.error_code = ERROR_CODE_SUCCESS;
-                    if (bacnet_read_write_value_callback) {
-                        bacnet_read_write_value_callback(
-                            device_id, &rp_data, value);
-                    }
+                    bacnet_read_write_value_notify(
+                        device_id, &rp_data, value);
                     /* see if there is any more data */
                     if (len < application_data_len) {
                         application_data += len;
@@ -274,10 +296,7 @@ static void bacnet_rpm_process(
             }
             value = listOfProperties->value;
             while (value) {
-                if (bacnet_read_write_value_callback) {
-                    bacnet_read_write_value_callback(
-                        device_id, &rp_data, value);
-                }
+                bacnet_read_write_value_notify(device_id, &rp_data, value);
                 value = value->next;
                 if (listOfProperties->propertyArrayIndex == BACNET_ARRAY_ALL) {
                     rp_data.array_index++;
@@ -546,6 +565,32 @@ void bacnet_read_write_value_callback_set(
     bacnet_read_write_value_callback = callback;
 }
 
+/**
+ * @brief Adds a callback for when a read-property returns data, which
+ *  is called in addition to the one set with
+ *  bacnet_read_write_value_callback_set()
+ *
+ * @param notification - callback node, which must stay valid
+ */
+void bacnet_read_write_value_notification_add(
+    BACNET_READ_WRITE_VALUE_NOTIFICATION *notification)
+{
+    BACNET_READ_WRITE_VALUE_NOTIFICATION *head;
+
+    head = &Value_Notification_Head;
+    do {
+        if (head->next == notification) {
+            /* already here! */
+            break;
+        } else if (!head->next) {
+            /* first available free node */
+            head->next = notification;
+            break;
+        }
+        head = head->next;
+    } while (head);
+}
+
 /**
  * @brief Handles the ReadProperty repetitive task
  */
@@ -560,16 +605,14 @@ void bacnet_read_write_task(void)
         status = bacnet_read_write_process(target);
         if (status) {
             if (Error_Detected) {
-                if (bacnet_read_write_value_callback) {
-                    rp_data.error_class = Error_Class;
-                    rp_data.error_code = Error_Code;
-                    rp_data.object_type = target->object_type;
-                    rp_data.object_instance = target->object_instance;
-                    rp_data.object_property = target->object_property;
-                    rp_data.array_index = target->array_index;
-                    bacnet_read_write_value_callback(
-                        target->device_id, &rp_data, NULL);
-                }
+                rp_data.error_class = Error_Class;
+                rp_data.error_code = Error_Code;
+                rp_data.object_type = target->object_type;
+                rp_data.object_instance = target->object_instance;
+                rp_data.object_property = target->object_property;
+                rp_data.array_index = target->array_index;
+                bacnet_read_write_value_notify(
+                    target->device_id, &rp_data, NULL);
             }
             Ringbuf_Pop(&Target_Data_Queue, NULL);
         }
@@ -28,6 +28,13 @@ typedef void (*bacnet_read_write_value_callback_t)(uint32_t device_instance,
     BACNET_READ_PROPERTY_DATA *rp_data,
     BACNET_APPLICATION_DATA_VALUE *value);
 
+/* additional callbacks, linked by modules that share the read task */
+struct bacnet_read_write_value_notification;
+typedef struct bacnet_read_write_value_notification {
+    struct bacnet_read_write_value_notification *next;
+    bacnet_read_write_value_callback_t callback;
+} BACNET_READ_WRITE_VALUE_NOTIFICATION;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -97,6 +104,9 @@ BACNET_STACK_EXPORT
 void bacnet_read_write_value_callback_set(
     bacnet_read_write_value_callback_t callback);
 BACNET_STACK_EXPORT
+void bacnet_read_write_value_notification_add(
+    BACNET_READ_WRITE_VALUE_NOTIFICATION *notification);
+BACNET_STACK_EXPORT
 void bacnet_read_write_vendor_id_filter_set(uint16_t vendor_id);
 
 #ifdef __cplusplus
@@ -35,6 +35,7 @@
 #include "bacnet/npdu.h"
 #include "bacnet/apdu.h"
 #include "bacnet/bactext.h"
+#include "bacnet/whois.h"
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/sys/debug.h"
 #include "bacnet/basic/services.h"
@@ -176,6 +177,46 @@ static void network_control_handler(BACNET_ADDRESS *src,
     }
 }
 
+/** Check if the APDU is a Who-Is, and get its Device instance range.
+ *
+ * @param apdu [in] The apdu portion of the request.
+ * @param apdu_len [in] The total (remaining) length of the apdu.
+ * @param low_limit [out] The lowest Device instance in the range.
+ * @param high_limit [out] The highest Device instance in the range.
+ * @return True if the APDU is a valid Who-Is request.
+ */
+static bool routed_who_is_range(uint8_t *apdu,
+    uint16_t apdu_len,
+    uint32_t *low_limit,
+    uint32_t *high_limit)
+{
+    int len = 0;
+    int32_t low = 0;
+    int32_t high = 0;
+
+    if ((apdu_len < 2) ||
+        ((apdu[0] & 0xF0) != PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST) ||
+        (apdu[1] != SERVICE_UNCONFIRMED_WHO_IS)) {
+        return false;
+    }
+    len = whois_decode_service_request(&apdu[2], apdu_len - 2, &low, &high);
+    if (len == BACNET_STATUS_ERROR) {
+        return false;
+    }
+    if (len == 0) {
+        /* no limits */
+        low = 0;
+        high = BACNET_MAX_INSTANCE;
+    }
+    if ((low < 0) || (high < low)) {
+        return false;
+    }
+    *low_limit = (uint32_t)low;
+    *high_limit = (uint32_t)high;
+
+    return true;
+}
+
 /** An APDU pre-handler that makes sure that the subsequent APDU handler call
  * operates on the right Device Object(s), as addressed by the destination
  * (routing) information.
@@ -200,6 +241,10 @@ static void routed_apdu_handler(BACNET_ADDRESS *src,
 {
     int cursor = 0; /* Starting hint */
     bool bGotOne = false;
+    uint32_t low_limit = 0;
+    uint32_t high_limit = 0;
+    uint32_t gateway_instance = 0;
+    DEVICE_OBJECT_DATA *pDev = NULL;
 
     if (!Routed_Device_Is_Valid_Network(dest->net, DNET_list)) {
         /* We don't know how to reach this one.
@@ -230,11 +275,31 @@ static void routed_apdu_handler(BACNET_ADDRESS *src,
         return;
     }
 
-    while (Routed_Device_GetNext(dest, DNET_list, &cursor)) {
-        apdu_handler(src, apdu, apdu_len);
-        bGotOne = true;
-        if (cursor < 0) { /* If no more matches, */
-            break; /* We don't need to keep looking */
+    if ((dest->net != 0) && (dest->len == 0) &&
+        routed_who_is_range(apdu, apdu_len, &low_limit, &high_limit)) {
+        /* Only the Devices within the range can answer a Who-Is,
+           so visit them in instance order instead of every Device.
+           The gateway Device is not on the virtual network. */
+        pDev = Get_Routed_Device_Object(0);
+        if (pDev) {
+            gateway_instance = pDev->bacObj.Object_Instance_Number;
+        }
+        while (Routed_Device_GetNext_Instance(
+            low_limit, high_limit, &cursor)) {
+            if ((dest->net != BACNET_BROADCAST_NETWORK) &&
+                (Routed_Device_Object_Instance_Number() == gateway_instance)) {
+                continue;
+            }
+            apdu_handler(src, apdu, apdu_len);
+            bGotOne = true;
+        }
+    } else {
+        while (Routed_Device_GetNext(dest, DNET_list, &cursor)) {
+            apdu_handler(src, apdu, apdu_len);
+            bGotOne = true;
+            if (cursor < 0) { /* If no more matches, */
+                break; /* We don't need to keep looking */
+            }
         }
     }
     if (!bGotOne) {
@@ -116,6 +116,9 @@ void Analog_Input_Init(void)
         /* Set handler for GetAlarmSummary Service */
         handler_get_alarm_summary_set(
             OBJECT_ANALOG_INPUT, Analog_Input_Alarm_Summary);
+        /* Set the active event index for the alarm and event services */
+        handler_get_event_information_index_set(
+            OBJECT_ANALOG_INPUT, Analog_Input_Instance_To_Index);
 #endif
     }
 }
@@ -790,6 +793,25 @@ bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
     return status;
 }
 
+#if defined(INTRINSIC_REPORTING)
+/**
+ * @brief Update the active event index of the alarm and event services
+ *  when the Event_State or Acked_Transitions of an object has changed.
+ * @param index - object index of the event object
+ */
+static void Analog_Input_Event_Index_Update(unsigned index)
+{
+    bool active;
+
+    active = (AI_Descr[index].Event_State != EVENT_STATE_NORMAL) ||
+        !AI_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].bIsAcked ||
+        !AI_Descr[index].Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked ||
+        !AI_Descr[index].Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked;
+    handler_get_event_information_active_set(
+        OBJECT_ANALOG_INPUT, Analog_Input_Index_To_Instance(index), active);
+}
+#endif
+
 void Analog_Input_Intrinsic_Reporting(uint32_t object_instance)
 {
 #if defined(INTRINSIC_REPORTING)
@@ -811,7 +833,9 @@ void Analog_Input_Intrinsic_Reporting(uint32_t object_instance)
     }
     /* check limits */
     if (!CurrentAI->Limit_Enable) {
-        return; /* limits are not configured */
+        /* limits are not configured, or were disabled while in alarm */
+        Analog_Input_Event_Index_Update(object_index);
+        return;
     }
 
     if (CurrentAI->Ack_notify_data.bSendAckNotify) {
@@ -925,7 +949,10 @@ void Analog_Input_Intrinsic_Reporting(uint32_t object_instance)
                 break;
 
             default:
-                return; /* shouldn't happen */
+                /* shouldn't happen, but keep the event index in step
+                   with an Event_State set elsewhere */
+                Analog_Input_Event_Index_Update(object_index);
+                return;
         } /* switch (FromState) */
 
         ToState = CurrentAI->Event_State;
@@ -1118,6 +1145,7 @@ void Analog_Input_Intrinsic_Reporting(uint32_t object_instance)
                     break;
             }
         }
+        Analog_Input_Event_Index_Update(object_index);
     }
 #endif /* defined(INTRINSIC_REPORTING) */
 }
@@ -1298,6 +1326,7 @@ int Analog_Input_Alarm_Ack(
     }
     CurrentAI->Ack_notify_data.bSendAckNotify = true;
     CurrentAI->Ack_notify_data.EventState = alarmack_data->eventStateAcked;
+    Analog_Input_Event_Index_Update(object_index);
 
     return 1;
 }
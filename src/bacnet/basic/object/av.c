@@ -123,6 +123,9 @@ void Analog_Value_Init(void)
         /* Set handler for GetAlarmSummary Service */
         handler_get_alarm_summary_set(
             OBJECT_ANALOG_VALUE, Analog_Value_Alarm_Summary);
+        /* Set the active event index for the alarm and event services */
+        handler_get_event_information_index_set(
+            OBJECT_ANALOG_VALUE, Analog_Value_Instance_To_Index);
 #endif
     }
 }
@@ -918,6 +921,25 @@ bool Analog_Value_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
     return status;
 }
 
+#if defined(INTRINSIC_REPORTING)
+/**
+ * @brief Update the active event index of the alarm and event services
+ *  when the Event_State or Acked_Transitions of an object has changed.
+ * @param index - object index of the event object
+ */
+static void Analog_Value_Event_Index_Update(unsigned index)
+{
+    bool active;
+
+    active = (AV_Descr[index].Event_State != EVENT_STATE_NORMAL) ||
+        !AV_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].bIsAcked ||
+        !AV_Descr[index].Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked ||
+        !AV_Descr[index].Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked;
+    handler_get_event_information_active_set(
+        OBJECT_ANALOG_VALUE, Analog_Value_Index_To_Instance(index), active);
+}
+#endif
+
 void Analog_Value_Intrinsic_Reporting(uint32_t object_instance)
 {
 #if defined(INTRINSIC_REPORTING)
@@ -938,8 +960,11 @@ void Analog_Value_Intrinsic_Reporting(uint32_t object_instance)
         return;
 
     /* check limits */
-    if (!CurrentAV->Limit_Enable)
-        return; /* limits are not configured */
+    if (!CurrentAV->Limit_Enable) {
+        /* limits are not configured, or were disabled while in alarm */
+        Analog_Value_Event_Index_Update(object_index);
+        return;
+    }
 
     if (CurrentAV->Ack_notify_data.bSendAckNotify) {
         /* clean bSendAckNotify flag */
@@ -1058,7 +1083,10 @@ void Analog_Value_Intrinsic_Reporting(uint32_t object_instance)
                 break;
 
             default:
-                return; /* shouldn't happen */
+                /* shouldn't happen, but keep the event index in step
+                   with an Event_State set elsewhere */
+                Analog_Value_Event_Index_Update(object_index);
+                return;
         } /* switch (FromState) */
 
         ToState = CurrentAV->Event_State;
@@ -1225,6 +1253,7 @@ void Analog_Value_Intrinsic_Reporting(uint32_t object_instance)
                     break;
             }
         }
+        Analog_Value_Event_Index_Update(object_index);
     }
 #endif /* defined(INTRINSIC_REPORTING) */
 }
@@ -1410,6 +1439,7 @@ int Analog_Value_Alarm_Ack(
     /* Need to send AckNotification. */
     CurrentAV->Ack_notify_data.bSendAckNotify = true;
     CurrentAV->Ack_notify_data.EventState = alarmack_data->eventStateAcked;
+    Analog_Value_Event_Index_Update(object_index);
 
     /* Return OK */
     return 1;
@@ -55,16 +55,35 @@
 #define CONTROL_GROUPS_MAX 8
 #endif
 
+/* initial size of the List_Of_Object_Property_References array */
 #ifndef CHANNEL_MEMBERS_MAX
 #define CHANNEL_MEMBERS_MAX 8
 #endif
 
+/* a member compiled for writing: where to write, the datatype the
+   channel value is coerced to, and the WriteProperty function */
+struct channel_member {
+    BACNET_OBJECT_TYPE object_type;
+    uint32_t object_instance;
+    BACNET_PROPERTY_ID object_property;
+    BACNET_ARRAY_INDEX array_index;
+    /* MAX_BACNET_APPLICATION_TAG if the value can't be coerced */
+    BACNET_APPLICATION_TAG tag;
+    write_property_function write_property;
+};
+
 struct object_data {
     bool Out_Of_Service : 1;
+    /* the compiled member list needs to be rebuilt */
+    bool Member_List_Stale : 1;
     BACNET_CHANNEL_VALUE Present_Value;
     unsigned Last_Priority;
     BACNET_WRITE_STATUS Write_Status;
-    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE Members[CHANNEL_MEMBERS_MAX];
+    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *Members;
+    unsigned Member_Count;
+    /* valid members sorted by tag, with room for Member_Count */
+    struct channel_member *Member_List;
+    unsigned Member_List_Count;
     uint16_t Number;
     uint32_t Control_Groups[CONTROL_GROUPS_MAX];
     const char *Object_Name;
@@ -75,6 +94,7 @@ struct object_data {
 static OS_Keylist Object_List;
 
 static write_property_function Write_Property_Internal_Callback;
+static channel_write_property_lookup_function Write_Property_Lookup_Callback;
 
 /* These arrays are used by the ReadPropertyMultiple handler
    property-list property (as of protocol-revision 14) */
@@ -330,8 +350,101 @@ static bool Channel_Reference_List_Member_Valid(
  */
 unsigned Channel_Reference_List_Member_Count(uint32_t object_instance)
 {
-    (void)object_instance;
-    return CHANNEL_MEMBERS_MAX;
+    unsigned count = 0;
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        count = pObject->Member_Count;
+    }
+
+    return count;
+}
+
+/**
+ * Initialize a member element to the empty reference
+ *
+ * @param pMember - member element
+ */
+static void Channel_Reference_List_Member_Init(
+    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *pMember)
+{
+    pMember->objectIdentifier.type = OBJECT_LIGHTING_OUTPUT;
+    pMember->objectIdentifier.instance = BACNET_MAX_INSTANCE;
+    pMember->propertyIdentifier = PROP_PRESENT_VALUE;
+    pMember->arrayIndex = BACNET_ARRAY_ALL;
+    pMember->deviceIdentifier.type = OBJECT_DEVICE;
+    pMember->deviceIdentifier.instance = BACNET_MAX_INSTANCE;
+}
+
+/**
+ * Resize the member array of an object.  New elements are empty, and
+ * the members beyond a smaller size are removed.
+ *
+ * @param pObject - object instance data
+ * @param count - number of elements in the member array
+ *
+ * @return true if the member array was resized
+ */
+static bool Channel_Reference_List_Member_Resize(
+    struct object_data *pObject, unsigned count)
+{
+    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *pMembers = NULL;
+    struct channel_member *pMember_List = NULL;
+    unsigned m = 0;
+
+    if (count == pObject->Member_Count) {
+        return true;
+    }
+    if (count > 0) {
+        pMembers =
+            calloc(count, sizeof(BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE));
+        pMember_List = calloc(count, sizeof(struct channel_member));
+        if (!pMembers || !pMember_List) {
+            free(pMembers);
+            free(pMember_List);
+            return false;
+        }
+        for (m = 0; m < count; m++) {
+            if (m < pObject->Member_Count) {
+                pMembers[m] = pObject->Members[m];
+            } else {
+                Channel_Reference_List_Member_Init(&pMembers[m]);
+            }
+        }
+    }
+    free(pObject->Members);
+    free(pObject->Member_List);
+    pObject->Members = pMembers;
+    pObject->Member_List = pMember_List;
+    pObject->Member_Count = count;
+    pObject->Member_List_Count = 0;
+    pObject->Member_List_Stale = true;
+
+    return true;
+}
+
+/**
+ * For a given object instance-number, sets the number of elements in
+ * the List_Of_Object_Property_References array
+ *
+ * @param object_instance - object-instance number of the object
+ * @param count - number of elements
+ *
+ * @return true if the number of elements was set
+ */
+bool Channel_Reference_List_Member_Count_Set(
+    uint32_t object_instance, unsigned count)
+{
+    bool status = false;
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        status = Channel_Reference_List_Member_Resize(pObject, count);
+    }
+
+    return status;
 }
 
 /**
@@ -351,7 +464,7 @@ BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *Channel_Reference_List_Member_Element(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject && (array_index > 0)) {
         array_index--;
-        if (array_index < CHANNEL_MEMBERS_MAX) {
+        if (array_index < pObject->Member_Count) {
             pMember = &pObject->Members[array_index];
         }
     }
@@ -378,10 +491,11 @@ bool Channel_Reference_List_Member_Element_Set(uint32_t object_instance,
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject && (array_index > 0)) {
         array_index--;
-        if (array_index < CHANNEL_MEMBERS_MAX) {
+        if (array_index < pObject->Member_Count) {
             pMember = &pObject->Members[array_index];
             memcpy(pMember, pMemberSrc,
                 sizeof(BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE));
+            pObject->Member_List_Stale = true;
             status = true;
         }
     }
@@ -396,7 +510,7 @@ bool Channel_Reference_List_Member_Element_Set(uint32_t object_instance,
  * @param pMemberSrc - pointer to a object property reference element
  *
  * @return array_index - 1-based array index value for added element, or
- * zero if not added
+ * zero if not added.  The array grows when there is no empty element.
  */
 unsigned Channel_Reference_List_Member_Element_Add(uint32_t object_instance,
     BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *pMemberSrc)
@@ -408,16 +522,25 @@ unsigned Channel_Reference_List_Member_Element_Add(uint32_t object_instance,
 
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
-        for (m = 0; m < CHANNEL_MEMBERS_MAX; m++) {
+        for (m = 0; m < pObject->Member_Count; m++) {
             pMember = &pObject->Members[m];
             if (!Channel_Reference_List_Member_Valid(pMember)) {
                 /* first empty slot */
                 array_index = 1 + m;
-                memcpy(pMember, pMemberSrc,
-                    sizeof(BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE));
                 break;
             }
         }
+        if ((array_index == 0) &&
+            Channel_Reference_List_Member_Resize(pObject,
+                pObject->Member_Count ? pObject->Member_Count * 2
+                                      : CHANNEL_MEMBERS_MAX)) {
+            array_index = 1 + m;
+        }
+        if (array_index) {
+            memcpy(&pObject->Members[array_index - 1], pMemberSrc,
+                sizeof(BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE));
+            pObject->Member_List_Stale = true;
+        }
     }
 
     return array_index;
@@ -1096,6 +1219,72 @@ int Channel_Coerce_Data_Encode(uint8_t *apdu,
     return len;
 }
 
+/**
+ * For a given member property, determines the datatype that the
+ * channel value is coerced to
+ *
+ * @param object_type - object type of the member
+ * @param object_property - property of the member
+ * @param array_index - array index of the member property
+ *
+ * @return application tag of the member property, or
+ *  MAX_BACNET_APPLICATION_TAG if the property can't be written
+ */
+static BACNET_APPLICATION_TAG Channel_Member_Tag(BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_ARRAY_INDEX array_index)
+{
+    BACNET_APPLICATION_TAG tag = MAX_BACNET_APPLICATION_TAG;
+
+    if (object_type == OBJECT_COLOR_TEMPERATURE) {
+        return BACNET_APPLICATION_TAG_UNSIGNED_INT;
+    }
+    if (array_index != BACNET_ARRAY_ALL) {
+        return MAX_BACNET_APPLICATION_TAG;
+    }
+    switch (object_type) {
+        case OBJECT_ANALOG_INPUT:
+        case OBJECT_ANALOG_OUTPUT:
+        case OBJECT_ANALOG_VALUE:
+            if (object_property == PROP_PRESENT_VALUE) {
+                tag = BACNET_APPLICATION_TAG_REAL;
+            }
+            break;
+        case OBJECT_BINARY_INPUT:
+        case OBJECT_BINARY_OUTPUT:
+        case OBJECT_BINARY_VALUE:
+            if (object_property == PROP_PRESENT_VALUE) {
+                tag = BACNET_APPLICATION_TAG_ENUMERATED;
+            }
+            break;
+        case OBJECT_MULTI_STATE_INPUT:
+        case OBJECT_MULTI_STATE_OUTPUT:
+        case OBJECT_MULTI_STATE_VALUE:
+            if (object_property == PROP_PRESENT_VALUE) {
+                tag = BACNET_APPLICATION_TAG_UNSIGNED_INT;
+            }
+            break;
+        case OBJECT_LIGHTING_OUTPUT:
+            if (object_property == PROP_PRESENT_VALUE) {
+                tag = BACNET_APPLICATION_TAG_REAL;
+            } else if (object_property == PROP_LIGHTING_COMMAND) {
+                tag = BACNET_APPLICATION_TAG_LIGHTING_COMMAND;
+            }
+            break;
+        case OBJECT_COLOR:
+            if (object_property == PROP_PRESENT_VALUE) {
+                tag = BACNET_APPLICATION_TAG_XY_COLOR;
+            } else if (object_property == PROP_COLOR_COMMAND) {
+                tag = BACNET_APPLICATION_TAG_COLOR_COMMAND;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return tag;
+}
+
 /**
  * For a given object instance-number, sets the present-value at a given
  * priority 1..16.
@@ -1109,88 +1298,14 @@ bool Channel_Write_Member_Value(
 {
     bool status = false;
     int apdu_len = 0;
+    BACNET_APPLICATION_TAG tag;
 
     if (wp_data && value) {
-        if (((wp_data->object_type == OBJECT_ANALOG_INPUT) ||
-                (wp_data->object_type == OBJECT_ANALOG_OUTPUT) ||
-                (wp_data->object_type == OBJECT_ANALOG_VALUE)) &&
-            (wp_data->object_property == PROP_PRESENT_VALUE) &&
-            (wp_data->array_index == BACNET_ARRAY_ALL)) {
-            apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                wp_data->application_data_len, value,
-                BACNET_APPLICATION_TAG_REAL);
-            if (apdu_len != BACNET_STATUS_ERROR) {
-                wp_data->application_data_len = apdu_len;
-                status = true;
-            }
-        } else if (((wp_data->object_type == OBJECT_BINARY_INPUT) ||
-                       (wp_data->object_type == OBJECT_BINARY_OUTPUT) ||
-                       (wp_data->object_type == OBJECT_BINARY_VALUE)) &&
-            (wp_data->object_property == PROP_PRESENT_VALUE) &&
-            (wp_data->array_index == BACNET_ARRAY_ALL)) {
+        tag = Channel_Member_Tag(wp_data->object_type,
+            wp_data->object_property, wp_data->array_index);
+        if (tag != MAX_BACNET_APPLICATION_TAG) {
             apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                wp_data->application_data_len, value,
-                BACNET_APPLICATION_TAG_ENUMERATED);
-            if (apdu_len != BACNET_STATUS_ERROR) {
-                wp_data->application_data_len = apdu_len;
-                status = true;
-            }
-        } else if (((wp_data->object_type == OBJECT_MULTI_STATE_INPUT) ||
-                       (wp_data->object_type == OBJECT_MULTI_STATE_OUTPUT) ||
-                       (wp_data->object_type == OBJECT_MULTI_STATE_VALUE)) &&
-            (wp_data->object_property == PROP_PRESENT_VALUE) &&
-            (wp_data->array_index == BACNET_ARRAY_ALL)) {
-            apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                wp_data->application_data_len, value,
-                BACNET_APPLICATION_TAG_UNSIGNED_INT);
-            if (apdu_len != BACNET_STATUS_ERROR) {
-                wp_data->application_data_len = apdu_len;
-                status = true;
-            }
-        } else if (wp_data->object_type == OBJECT_LIGHTING_OUTPUT) {
-            if ((wp_data->object_property == PROP_PRESENT_VALUE) &&
-                (wp_data->array_index == BACNET_ARRAY_ALL)) {
-                apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                    wp_data->application_data_len, value,
-                    BACNET_APPLICATION_TAG_REAL);
-                if (apdu_len != BACNET_STATUS_ERROR) {
-                    wp_data->application_data_len = apdu_len;
-                    status = true;
-                }
-            } else if ((wp_data->object_property == PROP_LIGHTING_COMMAND) &&
-                (wp_data->array_index == BACNET_ARRAY_ALL)) {
-                apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                    wp_data->application_data_len, value,
-                    BACNET_APPLICATION_TAG_LIGHTING_COMMAND);
-                if (apdu_len != BACNET_STATUS_ERROR) {
-                    wp_data->application_data_len = apdu_len;
-                    status = true;
-                }
-            }
-        } else if (wp_data->object_type == OBJECT_COLOR) {
-            if ((wp_data->object_property == PROP_PRESENT_VALUE) &&
-                (wp_data->array_index == BACNET_ARRAY_ALL)) {
-                apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                    wp_data->application_data_len, value,
-                    BACNET_APPLICATION_TAG_XY_COLOR);
-                if (apdu_len != BACNET_STATUS_ERROR) {
-                    wp_data->application_data_len = apdu_len;
-                    status = true;
-                }
-            } else if ((wp_data->object_property == PROP_COLOR_COMMAND) &&
-                (wp_data->array_index == BACNET_ARRAY_ALL)) {
-                apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                    wp_data->application_data_len, value,
-                    BACNET_APPLICATION_TAG_COLOR_COMMAND);
-                if (apdu_len != BACNET_STATUS_ERROR) {
-                    wp_data->application_data_len = apdu_len;
-                    status = true;
-                }
-            }
-        } else if (wp_data->object_type == OBJECT_COLOR_TEMPERATURE) {
-            apdu_len = Channel_Coerce_Data_Encode(wp_data->application_data,
-                wp_data->application_data_len, value,
-                BACNET_APPLICATION_TAG_UNSIGNED_INT);
+                wp_data->application_data_len, value, tag);
             if (apdu_len != BACNET_STATUS_ERROR) {
                 wp_data->application_data_len = apdu_len;
                 status = true;
@@ -1201,6 +1316,63 @@ bool Channel_Write_Member_Value(
     return status;
 }
 
+/**
+ * Compile the member list of an object: the valid members of the
+ * local device, with the datatype of each and the WriteProperty function
+ * of its object type, sorted by datatype so that the channel value is
+ * coerced once for each datatype. Members without a WriteProperty
+ * function, such as objects that do not exist, are written with the
+ * internal callback.
+ *
+ * @param pObject - object instance data
+ */
+static void Channel_Member_List_Compile(struct object_data *pObject)
+{
+    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *pMember = NULL;
+    struct channel_member member;
+    unsigned count = 0;
+    unsigned m = 0;
+    unsigned i = 0;
+
+    for (m = 0; m < pObject->Member_Count; m++) {
+        pMember = &pObject->Members[m];
+        /* NOTE: our implementation is for internal objects only */
+        /* NOTE: we could check to match our Device ID, but then
+           we would need to update all channels when our device ID
+           changed.  Instead, we'll just screen when members are
+           set. */
+        if ((pMember->deviceIdentifier.type != OBJECT_DEVICE) ||
+            (pMember->deviceIdentifier.instance == BACNET_MAX_INSTANCE) ||
+            (pMember->objectIdentifier.instance == BACNET_MAX_INSTANCE)) {
+            continue;
+        }
+        member.object_type = pMember->objectIdentifier.type;
+        member.object_instance = pMember->objectIdentifier.instance;
+        member.object_property = pMember->propertyIdentifier;
+        member.array_index = pMember->arrayIndex;
+        member.tag = Channel_Member_Tag(
+            member.object_type, member.object_property, member.array_index);
+        member.write_property = NULL;
+        /* the internal callback handles the special properties */
+        if (Write_Property_Lookup_Callback &&
+            (member.object_property != PROP_OBJECT_NAME) &&
+            (member.object_property != PROP_PROPERTY_LIST)) {
+            member.write_property = Write_Property_Lookup_Callback(
+                member.object_type, member.object_instance);
+        }
+        /* insertion sort by tag, keeping the order of the members */
+        i = count;
+        while ((i > 0) && (pObject->Member_List[i - 1].tag > member.tag)) {
+            pObject->Member_List[i] = pObject->Member_List[i - 1];
+            i--;
+        }
+        pObject->Member_List[i] = member;
+        count++;
+    }
+    pObject->Member_List_Count = count;
+    pObject->Member_List_Stale = false;
+}
+
 /**
  * For a given object instance-number, sets the present-value at a given
  * priority 1..16.
@@ -1216,37 +1388,51 @@ static bool Channel_Write_Members(struct object_data *pObject,
     uint8_t priority)
 {
     BACNET_WRITE_PROPERTY_DATA wp_data = { 0 };
+    BACNET_APPLICATION_TAG tag = MAX_BACNET_APPLICATION_TAG;
+    write_property_function write_property = NULL;
+    struct channel_member *pMember = NULL;
     bool status = false;
+    int apdu_len = BACNET_STATUS_ERROR;
     unsigned m = 0;
-    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *pMember = NULL;
 
     if (pObject && value) {
+        if (pObject->Member_List_Stale) {
+            Channel_Member_List_Compile(pObject);
+        }
         pObject->Write_Status = BACNET_WRITE_STATUS_IN_PROGRESS;
-        for (m = 0; m < CHANNEL_MEMBERS_MAX; m++) {
-            pMember = &pObject->Members[m];
-            /* NOTE: our implementation is for internal objects only */
-            /* NOTE: we could check to match our Device ID, but then
-               we would need to update all channels when our device ID
-               changed.  Instead, we'll just screen when members are
-               set. */
-            if ((pMember->deviceIdentifier.type == OBJECT_DEVICE) &&
-                (pMember->deviceIdentifier.instance != BACNET_MAX_INSTANCE) &&
-                (pMember->objectIdentifier.instance != BACNET_MAX_INSTANCE)) {
-                wp_data.object_type = pMember->objectIdentifier.type;
-                wp_data.object_instance = pMember->objectIdentifier.instance;
-                wp_data.object_property = pMember->propertyIdentifier;
-                wp_data.array_index = pMember->arrayIndex;
-                wp_data.priority = priority;
-                wp_data.application_data_len = sizeof(wp_data.application_data);
-                status = Channel_Write_Member_Value(&wp_data, value);
-                if (status) {
-                    if (Write_Property_Internal_Callback) {
-                        status = Write_Property_Internal_Callback(&wp_data);
-                    }
-                } else {
-                    pObject->Write_Status = BACNET_WRITE_STATUS_FAILED;
+        for (m = 0; m < pObject->Member_List_Count; m++) {
+            pMember = &pObject->Member_List[m];
+            if ((m == 0) || (pMember->tag != tag)) {
+                /* the members are sorted by tag: coerce once per tag */
+                tag = pMember->tag;
+                apdu_len = BACNET_STATUS_ERROR;
+                if (tag != MAX_BACNET_APPLICATION_TAG) {
+                    apdu_len = Channel_Coerce_Data_Encode(
+                        wp_data.application_data,
+                        sizeof(wp_data.application_data), value, tag);
                 }
             }
+            if (apdu_len == BACNET_STATUS_ERROR) {
+                pObject->Write_Status = BACNET_WRITE_STATUS_FAILED;
+                status = false;
+                continue;
+            }
+            wp_data.object_type = pMember->object_type;
+            wp_data.object_instance = pMember->object_instance;
+            wp_data.object_property = pMember->object_property;
+            wp_data.array_index = pMember->array_index;
+            wp_data.priority = priority;
+            wp_data.application_data_len = apdu_len;
+            wp_data.error_class = ERROR_CLASS_PROPERTY;
+            wp_data.error_code = ERROR_CODE_SUCCESS;
+            write_property = pMember->write_property;
+            if (!write_property) {
+                write_property = Write_Property_Internal_Callback;
+            }
+            status = true;
+            if (write_property) {
+                status = write_property(&wp_data);
+            }
         }
         if (pObject->Write_Status == BACNET_WRITE_STATUS_IN_PROGRESS) {
             pObject->Write_Status = BACNET_WRITE_STATUS_SUCCESSFUL;
@@ -1654,12 +1840,51 @@ bool Channel_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
 }
 
 /**
- * @brief Sets a callback used when present-value is written from BACnet
+ * @brief Sets a callback used when present-value is written from BACnet.
+ *  Any lookup callback is cleared, so that every member is written
+ *  with this callback until a matching lookup callback is set.
  * @param cb - callback used to provide indications
  */
 void Channel_Write_Property_Internal_Callback_Set(write_property_function cb)
 {
     Write_Property_Internal_Callback = cb;
+    Write_Property_Lookup_Callback = NULL;
+    Channel_Member_List_Refresh();
+}
+
+/**
+ * @brief Sets a callback that finds the WriteProperty function of an
+ *  existing object, so that the members are written without the dispatch
+ *  of the internal callback. Set it after the internal callback, and only
+ *  when the function it returns does the work of the internal callback
+ *  for that object. Members without a function are written with the
+ *  internal callback.
+ * @param cb - callback returning the WriteProperty function, or NULL
+ */
+void Channel_Write_Property_Lookup_Callback_Set(
+    channel_write_property_lookup_function cb)
+{
+    Write_Property_Lookup_Callback = cb;
+    Channel_Member_List_Refresh();
+}
+
+/**
+ * @brief Rebuilds the compiled member lists before the next write, for
+ *  example after objects are created or deleted
+ */
+void Channel_Member_List_Refresh(void)
+{
+    struct object_data *pObject;
+    int index = 0;
+    int count = 0;
+
+    count = Keylist_Count(Object_List);
+    for (index = 0; index < count; index++) {
+        pObject = Keylist_Data_Index(Object_List, index);
+        if (pObject) {
+            pObject->Member_List_Stale = true;
+        }
+    }
 }
 
 /**
@@ -1671,7 +1896,7 @@ uint32_t Channel_Create(uint32_t object_instance)
 {
     struct object_data *pObject = NULL;
     int index = 0;
-    unsigned m, g;
+    unsigned g;
 
     if (object_instance > BACNET_MAX_INSTANCE) {
         return BACNET_MAX_INSTANCE;
@@ -1693,16 +1918,14 @@ uint32_t Channel_Create(uint32_t object_instance)
             pObject->Out_Of_Service = false;
             pObject->Last_Priority = BACNET_NO_PRIORITY;
             pObject->Write_Status = BACNET_WRITE_STATUS_IDLE;
-            for (m = 0; m < CHANNEL_MEMBERS_MAX; m++) {
-                pObject->Members[m].objectIdentifier.type =
-                    OBJECT_LIGHTING_OUTPUT;
-                pObject->Members[m].objectIdentifier.instance =
-                    BACNET_MAX_INSTANCE;
-                pObject->Members[m].propertyIdentifier = PROP_PRESENT_VALUE;
-                pObject->Members[m].arrayIndex = BACNET_ARRAY_ALL;
-                pObject->Members[m].deviceIdentifier.type = OBJECT_DEVICE;
-                pObject->Members[m].deviceIdentifier.instance =
-                    BACNET_MAX_INSTANCE;
+            pObject->Members = NULL;
+            pObject->Member_Count = 0;
+            pObject->Member_List = NULL;
+            pObject->Member_List_Count = 0;
+            if (!Channel_Reference_List_Member_Resize(
+                    pObject, CHANNEL_MEMBERS_MAX)) {
+                free(pObject);
+                return BACNET_MAX_INSTANCE;
             }
             pObject->Number = 0;
             for (g = 0; g < CONTROL_GROUPS_MAX; g++) {
@@ -1711,6 +1934,7 @@ uint32_t Channel_Create(uint32_t object_instance)
             /* add to list */
             index = Keylist_Data_Add(Object_List, object_instance, pObject);
             if (index < 0) {
+                Channel_Reference_List_Member_Resize(pObject, 0);
                 free(pObject);
                 return BACNET_MAX_INSTANCE;
             }
@@ -1734,6 +1958,7 @@ bool Channel_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Channel_Reference_List_Member_Resize(pObject, 0);
         free(pObject);
         status = true;
     }
@@ -1752,6 +1977,7 @@ void Channel_Cleanup(void)
         do {
             pObject = Keylist_Data_Pop(Object_List);
             if (pObject) {
+                Channel_Reference_List_Member_Resize(pObject, 0);
                 free(pObject);
             }
         } while (pObject);
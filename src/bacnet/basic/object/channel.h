@@ -123,6 +123,10 @@ typedef struct BACnet_Channel_Value_t {
     struct BACnet_Channel_Value_t *next;
 } BACNET_CHANNEL_VALUE;
 
+/* returns the WriteProperty function of an existing object, or NULL */
+typedef write_property_function (*channel_write_property_lookup_function)(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -173,6 +177,9 @@ bool Channel_Number_Set(uint32_t object_instance, uint16_t value);
 BACNET_STACK_EXPORT
 unsigned Channel_Reference_List_Member_Count(uint32_t object_instance);
 BACNET_STACK_EXPORT
+bool Channel_Reference_List_Member_Count_Set(
+    uint32_t object_instance, unsigned count);
+BACNET_STACK_EXPORT
 BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *Channel_Reference_List_Member_Element(
     uint32_t object_instance, unsigned element);
 BACNET_STACK_EXPORT
@@ -206,6 +213,11 @@ bool Channel_Write_Member_Value(
 BACNET_STACK_EXPORT
 void Channel_Write_Property_Internal_Callback_Set(
     write_property_function cb);
+BACNET_STACK_EXPORT
+void Channel_Write_Property_Lookup_Callback_Set(
+    channel_write_property_lookup_function cb);
+BACNET_STACK_EXPORT
+void Channel_Member_List_Refresh(void);
 
 BACNET_STACK_EXPORT
 uint32_t Channel_Create(uint32_t object_instance);
@@ -90,6 +90,24 @@ extern bool Routed_Device_Write_Property_Local(
 /* may be overridden by outside table */
 static object_functions_t *Object_Table;
 
+/* number of object types in the object table with cached property lists */
+#ifndef DEVICE_OBJECT_TYPES_MAX
+#define DEVICE_OBJECT_TYPES_MAX 64
+#endif
+/* object table entry and property lists of an object type, built once in
+   Device_Init() so that ReadProperty, ReadPropertyMultiple ALL, REQUIRED
+   and OPTIONAL, and Property_List do not search the table or count the
+   lists for every object.  The property lists are not cached for the
+   object types whose lists depend on the state of the object. */
+struct object_type_cache {
+    struct object_functions *pObject;
+    struct special_property_list_t Property_List;
+    bool Property_List_Cached;
+};
+static struct object_type_cache Object_Type_Cache[DEVICE_OBJECT_TYPES_MAX];
+/* Object_Type_Cache index + 1 of each standard object type, 0 if none */
+static uint8_t Object_Type_Cache_Index[OBJECT_PROPRIETARY_MIN];
+
 static object_functions_t My_Object_Table[] = {
     { OBJECT_DEVICE, NULL /* Init - don't init Device or it will recourse! */,
         Device_Count, Device_Index_To_Instance,
@@ -255,10 +273,12 @@ static object_functions_t My_Object_Table[] = {
         Lighting_Output_Index_To_Instance, Lighting_Output_Valid_Instance,
         Lighting_Output_Object_Name, Lighting_Output_Read_Property,
         Lighting_Output_Write_Property, Lighting_Output_Property_Lists,
-        NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
-        NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
+        NULL /* ReadRangeInfo */, NULL /* Iterator */,
+        Lighting_Output_Encode_Value_List, Lighting_Output_Change_Of_Value,
+        Lighting_Output_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Lighting_Output_Create, Lighting_Output_Delete, Lighting_Output_Timer },
+        Lighting_Output_Create, Lighting_Output_Delete,
+        NULL /* Timer - see Lighting_Output_Transition_Timer() */ },
     { OBJECT_CHANNEL, Channel_Init, Channel_Count, Channel_Index_To_Instance,
         Channel_Valid_Instance, Channel_Object_Name, Channel_Read_Property,
         Channel_Write_Property, Channel_Property_Lists,
@@ -351,6 +371,11 @@ static struct object_functions *Device_Objects_Find_Functions(
 {
     struct object_functions *pObject = NULL;
 
+    if ((Object_Type < OBJECT_PROPRIETARY_MIN) &&
+        Object_Type_Cache_Index[Object_Type]) {
+        return Object_Type_Cache[Object_Type_Cache_Index[Object_Type] - 1]
+            .pObject;
+    }
     pObject = Object_Table;
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
         /* handle each object type */
@@ -382,6 +407,30 @@ rr_info_function Device_Objects_RR_Info(BACNET_OBJECT_TYPE object_type)
     return (pObject != NULL ? pObject->Object_RR_Info : NULL);
 }
 
+/** Try to find the WriteProperty function for the requested object.
+ * @ingroup ObjIntf
+ *
+ * @param object_type [in] The type of BACnet Object the handler wants to
+ * access.
+ * @param object_instance [in] The instance number of the Object.
+ * @return Pointer to the Object_Write_Property function of this type of
+ *         Object, or NULL if the type of Object isn't supported or isn't
+ *         writable, or the Object doesn't exist.
+ */
+write_property_function Device_Objects_Write_Property(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    struct object_functions *pObject = NULL;
+
+    pObject = Device_Objects_Find_Functions(object_type);
+    if ((pObject == NULL) || (pObject->Object_Valid_Instance == NULL) ||
+        !pObject->Object_Valid_Instance(object_instance)) {
+        return NULL;
+    }
+
+    return pObject->Object_Write_Property;
+}
+
 /** For a given object type, returns the special property list.
  * This function is used for ReadPropertyMultiple calls which want
  * just Required, just Optional, or All properties.
@@ -400,6 +449,15 @@ void Device_Objects_Property_List(BACNET_OBJECT_TYPE object_type,
     struct object_functions *pObject = NULL;
 
     (void)object_instance;
+    if ((object_type < OBJECT_PROPRIETARY_MIN) &&
+        Object_Type_Cache_Index[object_type] &&
+        Object_Type_Cache[Object_Type_Cache_Index[object_type] - 1]
+            .Property_List_Cached) {
+        *pPropertyList =
+            Object_Type_Cache[Object_Type_Cache_Index[object_type] - 1]
+                .Property_List;
+        return;
+    }
     pPropertyList->Required.pList = NULL;
     pPropertyList->Optional.pList = NULL;
     pPropertyList->Proprietary.pList = NULL;
@@ -1455,8 +1513,7 @@ static int Read_Property_Common(
     } else if (rpdata->object_property == PROP_PROPERTY_LIST) {
         Device_Objects_Property_List(
             rpdata->object_type, rpdata->object_instance, &property_list);
-        apdu_len = property_list_encode(rpdata, property_list.Required.pList,
-            property_list.Optional.pList, property_list.Proprietary.pList);
+        apdu_len = property_list_special_encode(rpdata, &property_list);
 #endif
     } else if (pObject->Object_Read_Property) {
         apdu_len = pObject->Object_Read_Property(rpdata);
@@ -2070,6 +2127,9 @@ bool Device_Create_Object(BACNET_CREATE_OBJECT_DATA *data)
                     /* required by ACK */
                     data->object_instance = object_instance;
                     Device_Inc_Database_Revision();
+#if (BACNET_PROTOCOL_REVISION >= 14)
+                    Channel_Member_List_Refresh();
+#endif
                     status = true;
                 }
             }
@@ -2108,6 +2168,9 @@ bool Device_Delete_Object(BACNET_DELETE_OBJECT_DATA *data)
             status = pObject->Object_Delete(data->object_instance);
             if (status) {
                 Device_Inc_Database_Revision();
+#if (BACNET_PROTOCOL_REVISION >= 14)
+                Channel_Member_List_Refresh();
+#endif
             } else {
                 /* The object exists but cannot be deleted. */
                 data->error_class = ERROR_CLASS_OBJECT;
@@ -2175,6 +2238,54 @@ bool Device_Value_List_Supported(BACNET_OBJECT_TYPE object_type)
     return (status);
 }
 
+/**
+ * @brief Determine if the property lists of an object type can be cached
+ * @param object_type [in] object type
+ * @return false if the property lists depend on the state of the object,
+ *  such as the optional properties of a Network Port of its Network_Type
+ */
+static bool Device_Object_Type_Property_List_Static(
+    BACNET_OBJECT_TYPE object_type)
+{
+    switch (object_type) {
+        case OBJECT_NETWORK_PORT:
+            return false;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Build the cache of the object table entry and property lists
+ *  of each object type in the object table
+ */
+static void Device_Object_Type_Cache_Init(void)
+{
+    struct object_functions *pObject = NULL;
+    struct object_type_cache *pCache = NULL;
+    unsigned index = 0;
+
+    memset(Object_Type_Cache_Index, 0, sizeof(Object_Type_Cache_Index));
+    pObject = Object_Table;
+    while ((pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) &&
+        (index < DEVICE_OBJECT_TYPES_MAX)) {
+        if ((pObject->Object_Type < OBJECT_PROPRIETARY_MIN) &&
+            !Object_Type_Cache_Index[pObject->Object_Type]) {
+            pCache = &Object_Type_Cache[index];
+            pCache->pObject = pObject;
+            Device_Objects_Property_List(
+                pObject->Object_Type, 0, &pCache->Property_List);
+            pCache->Property_List_Cached =
+                Device_Object_Type_Property_List_Static(pObject->Object_Type);
+            index++;
+            Object_Type_Cache_Index[pObject->Object_Type] = (uint8_t)index;
+        }
+        pObject++;
+    }
+}
+
 /** Initialize the Device Object.
  Initialize the group of object helper functions for any supported Object.
  Initialize each of the Device Object child Object instances.
@@ -2200,6 +2311,7 @@ void Device_Init(object_functions_t *object_table)
         }
         pObject++;
     }
+    Device_Object_Type_Cache_Init();
     /* create some dynamically created objects as examples */
     pObject = Object_Table;
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
@@ -2210,6 +2322,7 @@ void Device_Init(object_functions_t *object_table)
     }
 #if (BACNET_PROTOCOL_REVISION >= 14)
     Channel_Write_Property_Internal_Callback_Set(Device_Write_Property);
+    Channel_Write_Property_Lookup_Callback_Set(Device_Objects_Write_Property);
 #endif
 }
 
@@ -2277,6 +2390,9 @@ void Device_Timer(uint16_t milliseconds)
         }
         pObject++;
     }
+#if (BACNET_PROTOCOL_REVISION >= 14)
+    Lighting_Output_Transition_Timer(milliseconds);
+#endif
 }
 
 #ifdef BAC_ROUTING
@@ -261,6 +261,10 @@ extern "C" {
     BACNET_STACK_EXPORT
     rr_info_function Device_Objects_RR_Info(
         BACNET_OBJECT_TYPE object_type);
+    BACNET_STACK_EXPORT
+    write_property_function Device_Objects_Write_Property(
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance);
 
     BACNET_STACK_EXPORT
     void Device_getCurrentDateTime(
@@ -506,6 +510,10 @@ extern "C" {
     BACNET_STACK_EXPORT
     BACNET_ADDRESS *Get_Routed_Device_Address(
         int idx);
+    BACNET_STACK_EXPORT
+    bool Routed_Device_Address_Set(
+        int idx,
+        BACNET_ADDRESS * address);
 
     BACNET_STACK_EXPORT
     void routed_get_my_address(
@@ -522,6 +530,11 @@ extern "C" {
         int *DNET_list,
         int *cursor);
     BACNET_STACK_EXPORT
+    bool Routed_Device_GetNext_Instance(
+        uint32_t low_limit,
+        uint32_t high_limit,
+        int *cursor);
+    BACNET_STACK_EXPORT
     bool Routed_Device_Is_Valid_Network(
         uint16_t dest_net,
         int *DNET_list);
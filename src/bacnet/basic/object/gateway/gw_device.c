@@ -28,6 +28,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h> /* for calloc */
 #include <string.h> /* for memmove */
 #include "bacnet/bacdef.h"
 #include "bacnet/bacdcode.h"
@@ -44,6 +45,7 @@
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/basic/binding/address.h"
 #include "bacnet/reject.h"
+#include "bacnet/basic/sys/keylist.h"
 /* include the objects */
 #include "bacnet/basic/object/ai.h"
 #include "bacnet/basic/object/ao.h"
@@ -84,10 +86,31 @@ bool Routed_Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data);
  * and extending the regular Device Object functionality.
  ****************************************************************************/
 
-/** Model the gateway as the main Device, with (two) remote
- * Devices that are reached via its routing capabilities.
+/** Model the gateway as the main Device, with remote Devices that are
+ * reached via its routing capabilities.  Each Device is allocated when
+ * it is added, so MAX_NUM_DEVICES only limits how many can be added.
+ * The Devices are found by table index (the order they were added),
+ * by Device instance (ordered, for Who-Is ranges), and by virtual MAC.
  */
-DEVICE_OBJECT_DATA Devices[MAX_NUM_DEVICES];
+struct routed_device {
+    DEVICE_OBJECT_DATA device;
+    /* index in the Devices table */
+    uint16_t index;
+    /* virtual MAC address as it is stored in the address index */
+    KEY address_key;
+    uint8_t address_len;
+    uint8_t address[MAX_MAC_LEN];
+};
+/* Devices keyed by table index */
+static OS_Keylist Devices;
+/* Devices keyed by Device instance */
+static OS_Keylist Device_Instance_List;
+/* Devices keyed by a hash of their virtual MAC address */
+static OS_Keylist Device_Address_List;
+/* the last Device handed out, whose address the caller may change */
+static struct routed_device *Device_Address_Handed_Out;
+/* returned for the current Device before any Device is added */
+static DEVICE_OBJECT_DATA Device_Empty;
 /** Keep track of the number of managed devices, including the gateway */
 uint16_t Num_Managed_Devices = 0;
 /** Which Device entry are we currently managing.
@@ -101,42 +124,209 @@ uint16_t iCurrent_Device_Idx = 0;
  * found in device.c
  */
 
+/**
+ * @brief Get the Device data at a table index
+ * @param idx - index into the Devices table
+ * @return the Device data, or NULL if not added
+ */
+static struct routed_device *Routed_Device_Data(int idx)
+{
+    if ((idx < 0) || (idx >= Num_Managed_Devices)) {
+        return NULL;
+    }
+
+    return Keylist_Data_Index(Devices, idx);
+}
+
+/**
+ * @brief Get the currently active Device data
+ * @return the Device data, which is never NULL
+ */
+static DEVICE_OBJECT_DATA *Routed_Device_Current(void)
+{
+    struct routed_device *pNode = Routed_Device_Data(iCurrent_Device_Idx);
+
+    if (pNode) {
+        return &pNode->device;
+    }
+
+    return &Device_Empty;
+}
+
+/**
+ * @brief Hash a virtual MAC address into an address index key
+ * @param len - number of bytes in the address
+ * @param adr - address bytes
+ * @return key for the address index
+ */
+static KEY Routed_Device_Address_Key(uint8_t len, uint8_t *adr)
+{
+    /* FNV-1a */
+    KEY key = 2166136261UL;
+    uint8_t i;
+
+    key ^= len;
+    key *= 16777619UL;
+    for (i = 0; i < len; i++) {
+        key ^= adr[i];
+        key *= 16777619UL;
+    }
+
+    return key;
+}
+
+/**
+ * @brief Move a Device in the address index if its address changed
+ * @param pNode - Device data
+ */
+static void Routed_Device_Address_Index_Update(struct routed_device *pNode)
+{
+    BACNET_ADDRESS *addr = &pNode->device.bacDevAddr;
+    uint8_t len = addr->len;
+    int index;
+
+    if (len > MAX_MAC_LEN) {
+        len = MAX_MAC_LEN;
+    }
+    if ((len == pNode->address_len) &&
+        (memcmp(pNode->address, addr->adr, len) == 0)) {
+        return;
+    }
+    if (pNode->address_len > 0) {
+        /* duplicate keys are adjacent, so find this node among them */
+        index = Keylist_Index(Device_Address_List, pNode->address_key);
+        while ((index > 0) &&
+            (Keylist_Key(Device_Address_List, index - 1) ==
+                pNode->address_key)) {
+            index--;
+        }
+        while ((index >= 0) && (index < Keylist_Count(Device_Address_List)) &&
+            (Keylist_Key(Device_Address_List, index) == pNode->address_key)) {
+            if (Keylist_Data_Index(Device_Address_List, index) == pNode) {
+                (void)Keylist_Data_Delete_By_Index(Device_Address_List, index);
+                break;
+            }
+            index++;
+        }
+    }
+    pNode->address_len = len;
+    memcpy(pNode->address, addr->adr, len);
+    if (len > 0) {
+        pNode->address_key = Routed_Device_Address_Key(len, addr->adr);
+        (void)Keylist_Data_Add(Device_Address_List, pNode->address_key, pNode);
+    }
+}
+
+/**
+ * @brief Re-index the address of the last Device handed out by
+ *  Get_Routed_Device_Object() or Get_Routed_Device_Address(), if the
+ *  caller has changed it through the pointer
+ */
+static void Routed_Device_Address_Index_Refresh(void)
+{
+    if (Device_Address_Handed_Out) {
+        Routed_Device_Address_Index_Update(Device_Address_Handed_Out);
+    }
+}
+
+/**
+ * @brief Find a Device by its virtual MAC address
+ * @param dlen - number of bytes in the address
+ * @param dadr - address bytes
+ * @return index into the Devices table, or -1 if not found
+ */
+static int Routed_Device_Address_Index(uint8_t dlen, uint8_t *dadr)
+{
+    struct routed_device *pNode;
+    KEY key;
+    int index;
+
+    if ((dlen == 0) || (dlen > MAX_MAC_LEN) || (dadr == NULL)) {
+        return -1;
+    }
+    Routed_Device_Address_Index_Refresh();
+    key = Routed_Device_Address_Key(dlen, dadr);
+    index = Keylist_Index(Device_Address_List, key);
+    if (index < 0) {
+        return -1;
+    }
+    while ((index > 0) &&
+        (Keylist_Key(Device_Address_List, index - 1) == key)) {
+        index--;
+    }
+    while ((index < Keylist_Count(Device_Address_List)) &&
+        (Keylist_Key(Device_Address_List, index) == key)) {
+        pNode = Keylist_Data_Index(Device_Address_List, index);
+        if (pNode && (pNode->address_len == dlen) &&
+            (memcmp(pNode->address, dadr, dlen) == 0)) {
+            return pNode->index;
+        }
+        index++;
+    }
+
+    return -1;
+}
+
 /** Add a Device to our table of Devices[].
  * The first entry must be the gateway device.
  * @param Object_Instance [in] Set the new Device to this instance number.
  * @param sObject_Name [in] Use this Object Name for the Device.
  * @param sDescription [in] Set this Description for the Device.
  * @return The index of this instance in the Devices[] array, or UINT16_MAX if
- *         there isn't enough room to add this Device.
+ *         there isn't enough room to add this Device, or the instance
+ *         is already used by another Device.
  */
 uint16_t Add_Routed_Device(uint32_t Object_Instance,
     BACNET_CHARACTER_STRING *sObject_Name,
     const char *sDescription)
 {
     int i = Num_Managed_Devices;
-    if (i < MAX_NUM_DEVICES) {
-        DEVICE_OBJECT_DATA *pDev = &Devices[i];
-        Num_Managed_Devices++;
-        iCurrent_Device_Idx = i;
-        pDev->bacObj.mObject_Type = OBJECT_DEVICE;
-        pDev->bacObj.Object_Instance_Number = Object_Instance;
-        if (sObject_Name != NULL) {
-            Routed_Device_Set_Object_Name(sObject_Name->encoding,
-                sObject_Name->value, sObject_Name->length);
-        } else {
-            Routed_Device_Set_Object_Name(
-                CHARACTER_UTF8, "No Name", strlen("No Name"));
-        }
-        if (sDescription != NULL) {
-            Routed_Device_Set_Description(sDescription, strlen(sDescription));
-        } else {
-            Routed_Device_Set_Description("No Descr", strlen("No Descr"));
-        }
-        pDev->Database_Revision = 0; /* Reset/Initialize now */
-        return i;
-    } else {
+    struct routed_device *pNode;
+    DEVICE_OBJECT_DATA *pDev;
+
+    if (!Devices) {
+        Devices = Keylist_Create();
+        Device_Instance_List = Keylist_Create();
+        Device_Address_List = Keylist_Create();
+    }
+    if ((i >= MAX_NUM_DEVICES) || (i >= UINT16_MAX) ||
+        Keylist_Data(Device_Instance_List, Object_Instance)) {
+        return UINT16_MAX;
+    }
+    pNode = calloc(1, sizeof(struct routed_device));
+    if (!pNode) {
+        return UINT16_MAX;
+    }
+    pNode->index = i;
+    if (Keylist_Data_Add(Devices, i, pNode) < 0) {
+        free(pNode);
         return UINT16_MAX;
     }
+    if (Keylist_Data_Add(Device_Instance_List, Object_Instance, pNode) < 0) {
+        (void)Keylist_Data_Delete(Devices, i);
+        free(pNode);
+        return UINT16_MAX;
+    }
+    pDev = &pNode->device;
+    Num_Managed_Devices++;
+    iCurrent_Device_Idx = i;
+    pDev->bacObj.mObject_Type = OBJECT_DEVICE;
+    pDev->bacObj.Object_Instance_Number = Object_Instance;
+    if (sObject_Name != NULL) {
+        Routed_Device_Set_Object_Name(
+            sObject_Name->encoding, sObject_Name->value, sObject_Name->length);
+    } else {
+        Routed_Device_Set_Object_Name(
+            CHARACTER_UTF8, "No Name", strlen("No Name"));
+    }
+    if (sDescription != NULL) {
+        Routed_Device_Set_Description(sDescription, strlen(sDescription));
+    } else {
+        Routed_Device_Set_Description("No Descr", strlen("No Descr"));
+    }
+    pDev->Database_Revision = 0; /* Reset/Initialize now */
+
+    return i;
 }
 
 /** Return the Device Object descriptive data for the indicated entry.
@@ -150,14 +340,27 @@ uint16_t Add_Routed_Device(uint32_t Object_Instance,
  */
 DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx)
 {
+    struct routed_device *pNode;
+
     if (idx == -1) {
-        return &Devices[iCurrent_Device_Idx];
-    } else if ((idx >= 0) && (idx < MAX_NUM_DEVICES)) {
-        iCurrent_Device_Idx = idx;
-        return &Devices[idx];
+        pNode = Routed_Device_Data(iCurrent_Device_Idx);
     } else {
+        pNode = Routed_Device_Data(idx);
+        if (pNode) {
+            iCurrent_Device_Idx = idx;
+        }
+    }
+    if (!pNode) {
         return NULL;
     }
+    if (pNode != Device_Address_Handed_Out) {
+        /* the caller may change the address, so index any change
+           made through the previous pointer before handing out this one */
+        Routed_Device_Address_Index_Refresh();
+        Device_Address_Handed_Out = pNode;
+    }
+
+    return &pNode->device;
 }
 
 /** Return the BACnet address for the indicated entry.
@@ -171,14 +374,31 @@ DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx)
  */
 BACNET_ADDRESS *Get_Routed_Device_Address(int idx)
 {
-    if (idx == -1) {
-        return &Devices[iCurrent_Device_Idx].bacDevAddr;
-    } else if ((idx >= 0) && (idx < MAX_NUM_DEVICES)) {
-        iCurrent_Device_Idx = idx;
-        return &Devices[idx].bacDevAddr;
-    } else {
+    DEVICE_OBJECT_DATA *pDev = Get_Routed_Device_Object(idx);
+
+    if (!pDev) {
         return NULL;
     }
+
+    return &pDev->bacDevAddr;
+}
+
+/** Set the BACnet address for the indicated entry, and index its MAC.
+ * @param idx [in] Index into Devices[] array being requested.
+ * @param address [in] BACnet address of the Device
+ * @return True if the address was set, else False if the idx is invalid.
+ */
+bool Routed_Device_Address_Set(int idx, BACNET_ADDRESS *address)
+{
+    struct routed_device *pNode = Routed_Device_Data(idx);
+
+    if (!pNode || !address) {
+        return false;
+    }
+    bacnet_address_copy(&pNode->device.bacDevAddr, address);
+    Routed_Device_Address_Index_Update(pNode);
+
+    return true;
 }
 
 /** Get the currently active BACnet address.
@@ -191,7 +411,7 @@ BACNET_ADDRESS *Get_Routed_Device_Address(int idx)
 void routed_get_my_address(BACNET_ADDRESS *my_address)
 {
     if (my_address) {
-        memcpy(my_address, &Devices[iCurrent_Device_Idx].bacDevAddr,
+        memcpy(my_address, &Routed_Device_Current()->bacDevAddr,
             sizeof(BACNET_ADDRESS));
     }
 }
@@ -216,11 +436,13 @@ void routed_get_my_address(BACNET_ADDRESS *my_address)
 bool Routed_Device_Address_Lookup(int idx, uint8_t dlen, uint8_t *dadr)
 {
     bool result = false;
+    struct routed_device *pNode;
     DEVICE_OBJECT_DATA *pDev;
     int i;
 
-    if ((idx >= 0) && (idx < MAX_NUM_DEVICES)) {
-        pDev = &Devices[idx];
+    pNode = Routed_Device_Data(idx);
+    if (pNode) {
+        pDev = &pNode->device;
         if (dlen == 0) {
             /* Automatic match */
             iCurrent_Device_Idx = idx;
@@ -275,7 +497,7 @@ bool Routed_Device_GetNext(BACNET_ADDRESS *dest, int *DNET_list, int *cursor)
     /* First, see if the index is out of range.
      * Eg, last call to GetNext may have been the last successful one.
      */
-    if ((idx < 0) || (idx >= MAX_NUM_DEVICES)) {
+    if ((idx < 0) || (idx >= Num_Managed_Devices)) {
         idx = -1;
 
         /* Next, see if it's a BACnet broadcast.
@@ -305,18 +527,25 @@ bool Routed_Device_GetNext(BACNET_ADDRESS *dest, int *DNET_list, int *cursor)
         if (idx == 0) { /* Step over this case (starting point) */
             idx = 1;
         }
-        while (idx < MAX_NUM_DEVICES) {
-            bSuccess =
-                Routed_Device_Address_Lookup(idx++, dest->len, dest->adr);
-            if (bSuccess) {
-                break; /* We don't need to keep looking */
+        if (dest->len == 0) {
+            if (idx < Num_Managed_Devices) {
+                bSuccess = Routed_Device_Address_Lookup(idx++, 0, NULL);
+            }
+        } else {
+            /* a virtual MAC is unique, so there is only one match */
+            idx = Routed_Device_Address_Index(dest->len, dest->adr);
+            if (idx > 0) {
+                bSuccess = Routed_Device_Address_Lookup(
+                    idx, dest->len, dest->adr);
             }
+            idx = -1;
         }
     }
 
     if (!bSuccess) {
         *cursor = -1;
-    } else if (idx == MAX_NUM_DEVICES) { /* No more to GetNext */
+    } else if ((idx < 0) || (idx >= Num_Managed_Devices)) {
+        /* No more to GetNext */
         *cursor = -1;
     } else {
         *cursor = idx;
@@ -324,6 +553,47 @@ bool Routed_Device_GetNext(BACNET_ADDRESS *dest, int *DNET_list, int *cursor)
     return bSuccess;
 }
 
+/** Find the next Gateway or Routed Device, in Device instance order,
+ * whose Device instance is within a range, starting at the "cursor".
+ * Has the desirable side-effect of setting internal iCurrent_Device_Idx
+ * if a match is found, for use in the subsequent I-Am.
+ *
+ * @param low_limit [in] lowest Device instance in the range
+ * @param high_limit [in] highest Device instance in the range
+ * @param cursor [in,out] Set it to 0 on entry to start with the lowest
+ *         Device instance in the range.  On return, it is updated to
+ *         provide the cursor value to use with a subsequent call, or it
+ *         equals -1 if there are no further matches.
+ *
+ * @return True if a Device instance was found in the range.
+ */
+bool Routed_Device_GetNext_Instance(
+    uint32_t low_limit, uint32_t high_limit, int *cursor)
+{
+    struct routed_device *pNode;
+    int index;
+
+    if (*cursor < 0) {
+        return false;
+    }
+    if (*cursor == 0) {
+        index = Keylist_Index_Nearest(Device_Instance_List, low_limit);
+    } else {
+        index = *cursor - 1;
+    }
+    if ((index < 0) || (index >= Keylist_Count(Device_Instance_List)) ||
+        (Keylist_Key(Device_Instance_List, index) > high_limit)) {
+        *cursor = -1;
+        return false;
+    }
+    pNode = Keylist_Data_Index(Device_Instance_List, index);
+    iCurrent_Device_Idx = pNode->index;
+    /* the cursor is offset by one, since zero is the starting point */
+    *cursor = index + 2;
+
+    return true;
+}
+
 /** Check if the destination network is reachable - is it our virtual network,
  *  or local or else broadcast.
  *
@@ -362,25 +632,24 @@ bool Routed_Device_Is_Valid_Network(uint16_t dest_net, int *DNET_list)
 uint32_t Routed_Device_Index_To_Instance(unsigned index)
 {
     index = index;
-    return Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number;
+    return Routed_Device_Current()->bacObj.Object_Instance_Number;
 }
 
 /**
  * For a given object instance-number, determines a 1..N-1 index
- * of Device objects where N is MAX_NUM_DEVICES
+ * of Device objects where N is the number of managed Devices
  *
  * @param  object_instance - object-instance number of the object
  * @return  index for the given instance-number, or 0 if not valid.
  */
 static uint32_t Routed_Device_Instance_To_Index(uint32_t Instance_Number)
 {
-    int i;
+    struct routed_device *pNode;
 
-    for (i = 0; i < MAX_NUM_DEVICES; i++) {
-        if (Devices[i].bacObj.Object_Instance_Number == Instance_Number) {
-            /* Found Instance, so return the Device Index Number */
-            return i;
-        }
+    pNode = Keylist_Data(Device_Instance_List, Instance_Number);
+    if (pNode) {
+        /* Found Instance, so return the Device Index Number */
+        return pNode->index;
     }
 
     /* We did not find instance... so simply return an Index of 0
@@ -400,7 +669,7 @@ bool Routed_Device_Valid_Object_Instance_Number(uint32_t object_id)
     DEVICE_OBJECT_DATA *pDev = NULL;
 
     iCurrent_Device_Idx = Routed_Device_Instance_To_Index(object_id);
-    pDev = &Devices[iCurrent_Device_Idx];
+    pDev = Routed_Device_Current();
     if (pDev->bacObj.Object_Instance_Number == object_id) {
         valid = true;
     }
@@ -411,7 +680,7 @@ bool Routed_Device_Valid_Object_Instance_Number(uint32_t object_id)
 bool Routed_Device_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
     if (object_instance == pDev->bacObj.Object_Instance_Number) {
         return characterstring_init_ansi(object_name, pDev->bacObj.Object_Name);
     }
@@ -430,7 +699,7 @@ int Routed_Device_Read_Property_Local(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_len = 0; /* return value */
     BACNET_CHARACTER_STRING char_string;
     uint8_t *apdu = NULL;
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
 
     if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
         (rpdata->application_data_len == 0)) {
@@ -531,19 +800,32 @@ bool Routed_Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data)
  */
 uint32_t Routed_Device_Object_Instance_Number(void)
 {
-    return Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number;
+    return Routed_Device_Current()->bacObj.Object_Instance_Number;
 }
 
 bool Routed_Device_Set_Object_Instance_Number(uint32_t object_id)
 {
     bool status = true; /* return value */
+    struct routed_device *pNode = Routed_Device_Data(iCurrent_Device_Idx);
+    struct routed_device *pOther;
+    uint32_t old_id;
 
-    if (object_id <= BACNET_MAX_INSTANCE) {
+    if (!pNode || (object_id > BACNET_MAX_INSTANCE)) {
+        return false;
+    }
+    old_id = pNode->device.bacObj.Object_Instance_Number;
+    pOther = Keylist_Data(Device_Instance_List, object_id);
+    if (pOther && (pOther != pNode)) {
+        /* the instance is used by another Device */
+        status = false;
+    } else if (!pOther) {
+        if (Keylist_Data_Add(Device_Instance_List, object_id, pNode) < 0) {
+            return false;
+        }
+        (void)Keylist_Data_Delete(Device_Instance_List, old_id);
         /* Make the change and update the database revision */
-        Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number = object_id;
+        pNode->device.bacObj.Object_Instance_Number = object_id;
         Routed_Device_Inc_Database_Revision();
-    } else {
-        status = false;
     }
 
     return status;
@@ -559,7 +841,7 @@ bool Routed_Device_Set_Object_Name(
     uint8_t encoding, const char *value, size_t length)
 {
     bool status = false; /*return value */
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
 
     if ((encoding == CHARACTER_UTF8) && (length < MAX_DEV_NAME_LEN)) {
         /* Make the change and update the database revision */
@@ -575,7 +857,7 @@ bool Routed_Device_Set_Object_Name(
 bool Routed_Device_Set_Description(const char *name, size_t length)
 {
     bool status = false; /*return value */
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
 
     if (length < MAX_DEV_DESC_LEN) {
         memmove(pDev->Description, name, length);
@@ -593,7 +875,7 @@ bool Routed_Device_Set_Description(const char *name, size_t length)
  */
 void Routed_Device_Inc_Database_Revision(void)
 {
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
     pDev->Database_Revision++;
 }
 
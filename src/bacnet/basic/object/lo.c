@@ -38,12 +38,12 @@
 #include "bacnet/bacenum.h"
 #include "bacnet/bacapp.h"
 #include "bacnet/config.h" /* the custom stuff */
+#include "bacnet/cov.h"
 #include "bacnet/rp.h"
 #include "bacnet/wp.h"
 #include "bacnet/lighting.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/sys/keylist.h"
-#include "bacnet/basic/sys/linear.h"
 #include "bacnet/proplist.h"
 /* me! */
 #include "bacnet/basic/object/lo.h"
@@ -52,7 +52,23 @@
 #define MAX_LIGHTING_OUTPUTS 8
 #endif
 
+/* milliseconds in each slot of the transition timer wheel */
+#ifndef LIGHTING_OUTPUT_TICK_MS
+#define LIGHTING_OUTPUT_TICK_MS 10
+#endif
+/* number of slots in the transition timer wheel - a power of two */
+#ifndef LIGHTING_OUTPUT_WHEEL_SLOTS
+#define LIGHTING_OUTPUT_WHEEL_SLOTS 64
+#endif
+/* fixed point levels of the transition engine, in 1/1000 percent */
+#define LIGHTING_LEVEL_SCALE 1000L
+/* smallest change of the tracking value worth an update, fixed point */
+#ifndef LIGHTING_OUTPUT_RESOLUTION
+#define LIGHTING_OUTPUT_RESOLUTION 100L
+#endif
+
 struct object_data {
+    uint32_t Instance;
     float Present_Value;
     float Tracking_Value;
     float Physical_Value;
@@ -76,17 +92,45 @@ struct object_data {
     BACNET_OBJECT_ID Override_Color_Reference;
     const char *Object_Name;
     const char *Description;
+    float Prior_Value;
+    float COV_Increment;
+    /* transition engine: levels in 1/LIGHTING_LEVEL_SCALE percent */
+    int32_t Transition_Start;
+    int32_t Transition_Target;
+    /* ramp rate, fixed point per second */
+    int32_t Transition_Rate;
+    /* milliseconds elapsed, and of the fade */
+    uint32_t Transition_Time;
+    uint32_t Transition_Duration;
+    /* wheel ticks of the last and the next update */
+    uint32_t Transition_Last;
+    uint32_t Transition_Due;
+    struct object_data *Transition_Next;
     /* bits */
     bool Out_Of_Service : 1;
     bool Blink_Warn_Enable : 1;
     bool Egress_Active : 1;
     bool Color_Override : 1;
+    bool Changed : 1;
+    /* a fade, ramp, step or egress delay is in progress */
+    bool Transition_Active : 1;
+    /* in the transition timer wheel */
+    bool Transition_Queued : 1;
 };
 /* Key List for storing the object data sorted by instance number  */
 static OS_Keylist Object_List;
 /* callback for present value writes */
 static lighting_output_write_present_value_callback
     Lighting_Output_Write_Present_Value_Callback;
+/* objects with a transition in progress, in the slot of their next update */
+static struct object_data *Transition_Wheel[LIGHTING_OUTPUT_WHEEL_SLOTS];
+static uint32_t Transition_Tick;
+static uint32_t Transition_Milliseconds;
+static unsigned Transition_Count;
+
+static void Lighting_Output_Transition_Start(struct object_data *pObject);
+static void Lighting_Output_Transition_Default(
+    struct object_data *pObject, float value);
 
 /* These arrays are used by the ReadPropertyMultiple handler and
    property-list property (as of protocol-revision 14) */
@@ -289,6 +333,28 @@ static float Priority_Array_Value(
     return real_value;
 }
 
+/**
+ * For a given object, checks the present-value for COV
+ *
+ * @param  pObject - specific object with valid data
+ */
+static void Lighting_Output_Present_Value_COV_Detect(
+    struct object_data *pObject)
+{
+    float value, cov_delta;
+
+    value = Priority_Array_Next_Value(pObject, 0);
+    if (isgreater(pObject->Prior_Value, value)) {
+        cov_delta = pObject->Prior_Value - value;
+    } else {
+        cov_delta = value - pObject->Prior_Value;
+    }
+    if (isgreaterequal(cov_delta, pObject->COV_Increment)) {
+        pObject->Changed = true;
+        pObject->Prior_Value = value;
+    }
+}
+
 /**
  * @brief Encode a BACnetARRAY property element
  * @param object_instance [in] BACnet network port object instance number
@@ -485,7 +551,8 @@ static bool Lighting_Output_Present_Value_Write(uint32_t object_instance,
                 if ((priority <= current_priority) &&
                     (Priority_Array_Active(pObject, priority - 1)) &&
                     (isgreater(
-                        Priority_Array_Value(pObject, priority - 1), 0.0))) {
+                        Priority_Array_Value(pObject, priority - 1), 0.0)) &&
+                    pObject->Blink_Warn_Enable) {
                     /* The blink-warn notification shall not occur
                        if any of the following conditions occur:
                        (a) The specified priority is not the highest
@@ -493,6 +560,9 @@ static bool Lighting_Output_Present_Value_Write(uint32_t object_instance,
                        (b) The value at the specified priority is 0.0%, or
                        (c) Blink_Warn_Enable is FALSE. */
                     pObject->Lighting_Command.operation = BACNET_LIGHTS_WARN;
+                    pObject->Lighting_Command.use_priority = true;
+                    pObject->Lighting_Command.priority = priority;
+                    Lighting_Output_Transition_Start(pObject);
                 }
                 status = true;
             } else if (!islessgreater(value, -2.0)) {
@@ -503,8 +573,9 @@ static bool Lighting_Output_Present_Value_Write(uint32_t object_instance,
                     (Priority_Array_Active(pObject, priority - 1)) &&
                     (isgreater(
                         Priority_Array_Value(pObject, priority - 1), 0.0)) &&
-                    (isgreater(Priority_Array_Next_Value(pObject, priority - 1),
-                        0.0))) {
+                    (!isgreater(
+                        Priority_Array_Next_Value(pObject, priority), 0.0)) &&
+                    pObject->Blink_Warn_Enable) {
                     /* The blink-warn notification shall not occur,
                        and the value at the specified priority shall be
                        relinquished immediately if any of the following
@@ -519,6 +590,9 @@ static bool Lighting_Output_Present_Value_Write(uint32_t object_instance,
                        (d) Blink_Warn_Enable is FALSE. */
                     pObject->Lighting_Command.operation =
                         BACNET_LIGHTS_WARN_RELINQUISH;
+                    pObject->Lighting_Command.use_priority = true;
+                    pObject->Lighting_Command.priority = priority;
+                    Lighting_Output_Transition_Start(pObject);
                 } else {
                     Present_Value_Relinquish(pObject, priority);
                 }
@@ -531,8 +605,7 @@ static bool Lighting_Output_Present_Value_Write(uint32_t object_instance,
                     (Priority_Array_Active(pObject, priority - 1)) &&
                     (isgreater(
                         Priority_Array_Value(pObject, priority - 1), 0.0)) &&
-                    (isgreater(Priority_Array_Next_Value(pObject, priority - 1),
-                        0.0))) {
+                    pObject->Blink_Warn_Enable) {
                     /* The blink-warn notification shall not occur and
                        the value 0.0% written at the specified
                        priority immediately if any of the following
@@ -543,6 +616,9 @@ static bool Lighting_Output_Present_Value_Write(uint32_t object_instance,
                        (c) Blink_Warn_Enable is FALSE. */
                     pObject->Lighting_Command.operation =
                         BACNET_LIGHTS_WARN_OFF;
+                    pObject->Lighting_Command.use_priority = true;
+                    pObject->Lighting_Command.priority = priority;
+                    Lighting_Output_Transition_Start(pObject);
                 } else {
                     Present_Value_Set(pObject, 0.0, priority);
                 }
@@ -553,24 +629,7 @@ static bool Lighting_Output_Present_Value_Write(uint32_t object_instance,
                 current_priority = Present_Value_Priority(pObject);
                 if (priority <= current_priority) {
                     /* we have priority - configure the Lighting Command */
-                    if (pObject->Transition ==
-                        BACNET_LIGHTING_TRANSITION_FADE) {
-                        pObject->Lighting_Command.fade_time =
-                            pObject->Default_Fade_Time;
-                        pObject->Lighting_Command.operation =
-                            BACNET_LIGHTS_FADE_TO;
-                    } else if (pObject->Transition ==
-                        BACNET_LIGHTING_TRANSITION_RAMP) {
-                        pObject->Lighting_Command.ramp_rate =
-                            pObject->Default_Ramp_Rate;
-                        pObject->Lighting_Command.operation =
-                            BACNET_LIGHTS_RAMP_TO;
-                    } else {
-                        pObject->Lighting_Command.fade_time = 0;
-                        pObject->Lighting_Command.operation =
-                            BACNET_LIGHTS_FADE_TO;
-                    }
-                    pObject->Lighting_Command.target_level = value;
+                    Lighting_Output_Transition_Default(pObject, value);
                 }
                 status = true;
             } else {
@@ -656,20 +715,7 @@ static bool Lighting_Output_Present_Value_Relinquish_Write(
                         Lighting_Output_Present_Value_Priority(object_instance);
                 }
                 /* we have priority - configure the Lighting Command */
-                if (pObject->Transition == BACNET_LIGHTING_TRANSITION_FADE) {
-                    pObject->Lighting_Command.fade_time =
-                        pObject->Default_Fade_Time;
-                    pObject->Lighting_Command.operation = BACNET_LIGHTS_FADE_TO;
-                } else if (pObject->Transition ==
-                    BACNET_LIGHTING_TRANSITION_RAMP) {
-                    pObject->Lighting_Command.ramp_rate =
-                        pObject->Default_Ramp_Rate;
-                    pObject->Lighting_Command.operation = BACNET_LIGHTS_RAMP_TO;
-                } else {
-                    pObject->Lighting_Command.fade_time = 0;
-                    pObject->Lighting_Command.operation = BACNET_LIGHTS_FADE_TO;
-                }
-                pObject->Lighting_Command.target_level = value;
+                Lighting_Output_Transition_Default(pObject, value);
             }
             status = true;
         } else {
@@ -802,7 +848,10 @@ bool Lighting_Output_Lighting_Command_Set(
     if (pObject) {
         /* FIXME: check lighting command member values */
         status = lighting_command_copy(&pObject->Lighting_Command, value);
-        /* FIXME: set all the other values, and get the light levels moving */
+        /* FIXME: set all the other values */
+        if (status) {
+            Lighting_Output_Transition_Start(pObject);
+        }
     }
 
     return status;
@@ -1416,6 +1465,96 @@ bool Lighting_Output_Relinquish_Default_Set(
     return status;
 }
 
+/**
+ * @brief Get the COV change flag status
+ * @param object_instance - object-instance number of the object
+ * @return the COV change flag status
+ */
+bool Lighting_Output_Change_Of_Value(uint32_t object_instance)
+{
+    bool changed = false;
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        changed = pObject->Changed;
+    }
+
+    return changed;
+}
+
+/**
+ * @brief Clear the COV change flag
+ * @param object_instance - object-instance number of the object
+ */
+void Lighting_Output_Change_Of_Value_Clear(uint32_t object_instance)
+{
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        pObject->Changed = false;
+    }
+}
+
+/**
+ * @brief Encode the Value List for Present-Value and Status-Flags
+ * @param object_instance - object-instance number of the object
+ * @param  value_list - #BACNET_PROPERTY_VALUE with at least 2 entries
+ * @return true if values were encoded
+ */
+bool Lighting_Output_Encode_Value_List(
+    uint32_t object_instance, BACNET_PROPERTY_VALUE *value_list)
+{
+    bool status = false;
+    struct object_data *pObject;
+    const bool in_alarm = false;
+    const bool fault = false;
+    const bool overridden = false;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        status = cov_value_list_encode_real(value_list, pObject->Prior_Value,
+            in_alarm, fault, overridden, pObject->Out_Of_Service);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Get the COV increment
+ * @param object_instance - object-instance number of the object
+ * @return the COV increment
+ */
+float Lighting_Output_COV_Increment(uint32_t object_instance)
+{
+    float value = 0.0;
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        value = pObject->COV_Increment;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Set the COV increment
+ * @param object_instance - object-instance number of the object
+ * @param value - COV Increment value to set
+ */
+void Lighting_Output_COV_Increment_Set(uint32_t object_instance, float value)
+{
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        pObject->COV_Increment = value;
+        Lighting_Output_Present_Value_COV_Detect(pObject);
+    }
+}
+
 /**
  * For a given object instance-number, gets the property value
  *
@@ -1989,131 +2128,6 @@ bool Lighting_Output_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
     return status;
 }
 
-/**
- * Handles the timing for a single Lighting Output object Fade
- *
- * @param pLight - Lighting Output object
- * @param pCommand - BACNET_LIGHTING_COMMAND of the Lighting Output object
- * @param milliseconds - number of milliseconds elapsed since previously
- * called.  Works best when called about every 10 milliseconds.
- */
-static void Lighting_Output_Fade_Handler(
-    uint32_t object_instance, uint16_t milliseconds)
-{
-    struct object_data *pObject;
-    float old_value;
-
-    pObject = Keylist_Data(Object_List, object_instance);
-    if (!pObject) {
-        return;
-    }
-    old_value = pObject->Tracking_Value;
-    if (milliseconds >= pObject->Lighting_Command.fade_time) {
-        /* stop fading */
-        pObject->Tracking_Value = pObject->Lighting_Command.target_level;
-        pObject->In_Progress = BACNET_LIGHTING_IDLE;
-        pObject->Lighting_Command.operation = BACNET_LIGHTS_STOP;
-        pObject->Lighting_Command.fade_time = 0;
-    } else {
-        if (!islessgreater(pObject->Tracking_Value,
-                pObject->Lighting_Command.target_level)) {
-            /* stop fading */
-            pObject->Tracking_Value = pObject->Lighting_Command.target_level;
-            pObject->In_Progress = BACNET_LIGHTING_IDLE;
-            pObject->Lighting_Command.operation = BACNET_LIGHTS_STOP;
-            pObject->Lighting_Command.fade_time = 0;
-        } else {
-            /* fading */
-            pObject->Tracking_Value = linear_interpolate(0, milliseconds,
-                pObject->Lighting_Command.fade_time, old_value,
-                pObject->Lighting_Command.target_level);
-            pObject->Lighting_Command.fade_time -= milliseconds;
-            pObject->In_Progress = BACNET_LIGHTING_FADE_ACTIVE;
-        }
-    }
-    if (Lighting_Output_Write_Present_Value_Callback) {
-        Lighting_Output_Write_Present_Value_Callback(
-            object_instance, old_value, pObject->Tracking_Value);
-    }
-}
-
-/**
- * Updates the object tracking value while ramping
- *
- * Commands Present_Value to ramp from the current Tracking_Value to the
- * target-level specified in the command. The ramp operation
- * changes the output from its current value to target-level,
- * at a particular percent per second defined by ramp-rate.
- * While the ramp operation is executing, In_Progress shall be set
- * to RAMP_ACTIVE, and Tracking_Value shall be updated to reflect the current
- * progress of the ramp. <target-level> shall be clamped to
- * Min_Actual_Value and Max_Actual_Value.
- *
- * @param  object_instance - object-instance number of the object
- * @param milliseconds - number of milliseconds elapsed
- */
-static void Lighting_Output_Ramp_Handler(
-    uint32_t object_instance, uint16_t milliseconds)
-{
-    float old_value, target_value, min_value, max_value, step_value, steps;
-    struct object_data *pObject;
-
-    pObject = Keylist_Data(Object_List, object_instance);
-    if (!pObject) {
-        return;
-    }
-    old_value = pObject->Tracking_Value;
-    min_value = pObject->Min_Actual_Value;
-    max_value = pObject->Max_Actual_Value;
-    target_value = pObject->Lighting_Command.target_level;
-    /* clamp target within min/max, if needed */
-    if (isgreater(target_value, max_value)) {
-        target_value = max_value;
-    }
-    if (isless(target_value, min_value)) {
-        target_value = min_value;
-    }
-    /* determine the number of steps */
-    if (milliseconds <= 1000) {
-        /* percent per second */
-        steps = linear_interpolate(
-            0, milliseconds, 1000, 0, pObject->Lighting_Command.ramp_rate);
-    } else {
-        steps = (milliseconds * pObject->Lighting_Command.ramp_rate) / 1000;
-    }
-    if (!islessgreater(pObject->Tracking_Value, target_value)) {
-        /* stop ramping */
-        pObject->Tracking_Value = target_value;
-        pObject->In_Progress = BACNET_LIGHTING_IDLE;
-        pObject->Lighting_Command.operation = BACNET_LIGHTS_STOP;
-    } else {
-        if (isless(old_value, target_value)) {
-            step_value = old_value + steps;
-        } else if (isgreater(old_value, target_value)) {
-            if (isgreater(steps, old_value)) {
-                step_value = old_value - steps;
-            } else {
-                step_value = target_value;
-            }
-        } else {
-            step_value = target_value;
-        }
-        /* clamp target within min/max, if needed */
-        if (isgreater(step_value, max_value)) {
-            step_value = max_value;
-        }
-        if (isless(step_value, min_value)) {
-            step_value = min_value;
-        }
-        pObject->Tracking_Value = step_value;
-        pObject->In_Progress = BACNET_LIGHTING_RAMP_ACTIVE;
-    }
-    if (Lighting_Output_Write_Present_Value_Callback) {
-        Lighting_Output_Write_Present_Value_Callback(
-            object_instance, old_value, pObject->Tracking_Value);
-    }
-}
-
 /**
  * Updates the object tracking value while stepping
  *
@@ -2286,8 +2300,422 @@ static void Lighting_Output_Step_Off_Handler(uint32_t object_instance)
     }
 }
 
+/**
+ * @brief Convert a level in percent to the fixed point transition level
+ * @param value - level in percent
+ * @return level in 1/LIGHTING_LEVEL_SCALE percent
+ */
+static int32_t Lighting_Level_Fixed(float value)
+{
+    if (isless(value, 0.0f)) {
+        return (int32_t)(value * LIGHTING_LEVEL_SCALE - 0.5f);
+    }
+
+    return (int32_t)(value * LIGHTING_LEVEL_SCALE + 0.5f);
+}
+
+/**
+ * @brief Convert a fixed point transition level to a level in percent
+ * @param level - level in 1/LIGHTING_LEVEL_SCALE percent
+ * @return level in percent
+ */
+static float Lighting_Level_Float(int32_t level)
+{
+    return (float)level / (float)LIGHTING_LEVEL_SCALE;
+}
+
+/**
+ * @brief Add an object to the slot of the transition wheel for its due tick
+ * @param pObject - object with a transition in progress
+ * @param due - wheel tick of the next update
+ */
+static void Transition_Wheel_Insert(struct object_data *pObject, uint32_t due)
+{
+    unsigned slot = due & (LIGHTING_OUTPUT_WHEEL_SLOTS - 1);
+
+    pObject->Transition_Due = due;
+    pObject->Transition_Next = Transition_Wheel[slot];
+    pObject->Transition_Queued = true;
+    Transition_Wheel[slot] = pObject;
+    Transition_Count++;
+}
+
+/**
+ * @brief Remove an object from the transition wheel, if it is there
+ * @param pObject - object which may have a transition in progress
+ */
+static void Transition_Wheel_Remove(struct object_data *pObject)
+{
+    struct object_data **ppObject;
+    unsigned slot;
+
+    if (!pObject->Transition_Queued) {
+        return;
+    }
+    slot = pObject->Transition_Due & (LIGHTING_OUTPUT_WHEEL_SLOTS - 1);
+    ppObject = &Transition_Wheel[slot];
+    while (*ppObject) {
+        if (*ppObject == pObject) {
+            *ppObject = pObject->Transition_Next;
+            break;
+        }
+        ppObject = &(*ppObject)->Transition_Next;
+    }
+    pObject->Transition_Next = NULL;
+    pObject->Transition_Queued = false;
+    if (Transition_Count) {
+        Transition_Count--;
+    }
+}
+
+/**
+ * @brief Get the priority of the lighting command of the object
+ * @param pObject - object with a lighting command
+ * @return priority 1..16
+ */
+static unsigned Lighting_Command_Priority(struct object_data *pObject)
+{
+    if (pObject->Lighting_Command.use_priority) {
+        return pObject->Lighting_Command.priority;
+    }
+
+    return pObject->Lighting_Command_Default_Priority;
+}
+
+/**
+ * @brief Start the default transition of the object to a new level
+ * @param pObject - object with a new present-value
+ * @param value - level in percent
+ */
+static void Lighting_Output_Transition_Default(
+    struct object_data *pObject, float value)
+{
+    if (pObject->Transition == BACNET_LIGHTING_TRANSITION_FADE) {
+        pObject->Lighting_Command.fade_time = pObject->Default_Fade_Time;
+        pObject->Lighting_Command.operation = BACNET_LIGHTS_FADE_TO;
+    } else if (pObject->Transition == BACNET_LIGHTING_TRANSITION_RAMP) {
+        pObject->Lighting_Command.ramp_rate = pObject->Default_Ramp_Rate;
+        pObject->Lighting_Command.operation = BACNET_LIGHTS_RAMP_TO;
+    } else {
+        pObject->Lighting_Command.fade_time = 0;
+        pObject->Lighting_Command.operation = BACNET_LIGHTS_FADE_TO;
+    }
+    pObject->Lighting_Command.target_level = value;
+    Lighting_Output_Transition_Start(pObject);
+}
+
+/**
+ * @brief Start the transition for the lighting command of the object.
+ *  Fades and ramps are computed in fixed point from the Tracking_Value
+ *  at the start, so the steps do not accumulate rounding errors.
+ *  Every command is applied at the next tick of the transition wheel.
+ *
+ *  The blink of a WARN is a local matter of the physical output, so a
+ *  WARN leaves the level as it is.  WARN_OFF and WARN_RELINQUISH wait
+ *  Egress_Time seconds, or no time when Blink_Warn_Enable is FALSE,
+ *  with Egress_Active set, before they write 0.0% or relinquish at the
+ *  priority of the command.
+ * @param pObject - object with a new lighting command
+ */
+static void Lighting_Output_Transition_Start(struct object_data *pObject)
+{
+    float target_value;
+
+    Transition_Wheel_Remove(pObject);
+    pObject->Egress_Active = false;
+    Lighting_Output_Present_Value_COV_Detect(pObject);
+    pObject->Transition_Start = Lighting_Level_Fixed(pObject->Tracking_Value);
+    pObject->Transition_Time = 0;
+    switch (pObject->Lighting_Command.operation) {
+        case BACNET_LIGHTS_FADE_TO:
+            pObject->Transition_Target =
+                Lighting_Level_Fixed(pObject->Lighting_Command.target_level);
+            pObject->Transition_Duration = pObject->Lighting_Command.fade_time;
+            pObject->In_Progress = BACNET_LIGHTING_FADE_ACTIVE;
+            break;
+        case BACNET_LIGHTS_RAMP_TO:
+            target_value = pObject->Lighting_Command.target_level;
+            /* clamp target within min/max, if needed */
+            if (isgreater(target_value, pObject->Max_Actual_Value)) {
+                target_value = pObject->Max_Actual_Value;
+            }
+            if (isless(target_value, pObject->Min_Actual_Value)) {
+                target_value = pObject->Min_Actual_Value;
+            }
+            pObject->Transition_Target = Lighting_Level_Fixed(target_value);
+            pObject->Transition_Rate =
+                Lighting_Level_Fixed(pObject->Lighting_Command.ramp_rate);
+            pObject->In_Progress = BACNET_LIGHTING_RAMP_ACTIVE;
+            break;
+        case BACNET_LIGHTS_STEP_UP:
+        case BACNET_LIGHTS_STEP_DOWN:
+        case BACNET_LIGHTS_STEP_ON:
+        case BACNET_LIGHTS_STEP_OFF:
+            pObject->In_Progress = BACNET_LIGHTING_OTHER;
+            break;
+        case BACNET_LIGHTS_WARN_OFF:
+        case BACNET_LIGHTS_WARN_RELINQUISH:
+            if (pObject->Blink_Warn_Enable) {
+                pObject->Transition_Duration = pObject->Egress_Time * 1000UL;
+            } else {
+                pObject->Transition_Duration = 0;
+            }
+            pObject->Egress_Active = true;
+            pObject->In_Progress = BACNET_LIGHTING_OTHER;
+            break;
+        case BACNET_LIGHTS_WARN:
+        case BACNET_LIGHTS_NONE:
+        case BACNET_LIGHTS_STOP:
+        default:
+            pObject->Transition_Active = false;
+            pObject->In_Progress = BACNET_LIGHTING_IDLE;
+            return;
+    }
+    pObject->Transition_Last = Transition_Tick;
+    pObject->Transition_Active = true;
+    Transition_Wheel_Insert(pObject, Transition_Tick + 1);
+}
+
+/**
+ * @brief Stop the fade or ramp at the target level
+ * @param pObject - object with a transition in progress
+ */
+static void Lighting_Output_Transition_Stop(struct object_data *pObject)
+{
+    pObject->Tracking_Value = Lighting_Level_Float(pObject->Transition_Target);
+    pObject->Transition_Active = false;
+    pObject->In_Progress = BACNET_LIGHTING_IDLE;
+    pObject->Lighting_Command.operation = BACNET_LIGHTS_STOP;
+    pObject->Lighting_Command.fade_time = 0;
+}
+
+/**
+ * @brief Finish the egress delay of a WARN_OFF or WARN_RELINQUISH, and
+ *  start the default transition to the new present-value
+ * @param pObject - object with an egress delay in progress
+ */
+static void Lighting_Output_Egress_Stop(struct object_data *pObject)
+{
+    unsigned priority;
+
+    priority = Lighting_Command_Priority(pObject);
+    pObject->Transition_Active = false;
+    pObject->Egress_Active = false;
+    pObject->In_Progress = BACNET_LIGHTING_IDLE;
+    if (pObject->Lighting_Command.operation == BACNET_LIGHTS_WARN_OFF) {
+        Present_Value_Set(pObject, 0.0, priority);
+    } else {
+        Present_Value_Relinquish(pObject, priority);
+    }
+    Lighting_Output_Transition_Default(
+        pObject, Priority_Array_Next_Value(pObject, 0));
+}
+
+/**
+ * @brief Updates the object tracking value per ramp or fade or step
+ *
+ * A fade changes the output from the Tracking_Value at the start to
+ * target-level over fade-time.  A ramp changes the output at a particular
+ * percent per second defined by ramp-rate, with target-level clamped
+ * to Min_Actual_Value and Max_Actual_Value.  While the fade or ramp is
+ * executing, In_Progress is FADE_ACTIVE or RAMP_ACTIVE.  A transition
+ * that ends clears Transition_Active before the callbacks, so a callback
+ * may start a new transition.
+ *
+ * @param pObject - object with valid data
+ * @param milliseconds - number of milliseconds elapsed since the last update
+ * @return true if a transition is still in progress
+ */
+static bool Lighting_Output_Transition_Step(
+    struct object_data *pObject, uint32_t milliseconds)
+{
+    bool active = false;
+    float old_value;
+    int32_t level, delta;
+
+    old_value = pObject->Tracking_Value;
+    switch (pObject->Lighting_Command.operation) {
+        case BACNET_LIGHTS_FADE_TO:
+            pObject->Transition_Time += milliseconds;
+            if (pObject->Transition_Time >= pObject->Transition_Duration) {
+                Lighting_Output_Transition_Stop(pObject);
+            } else {
+                delta = pObject->Transition_Target - pObject->Transition_Start;
+                level = pObject->Transition_Start +
+                    (int32_t)(((int64_t)delta * pObject->Transition_Time) /
+                        pObject->Transition_Duration);
+                pObject->Tracking_Value = Lighting_Level_Float(level);
+                pObject->Lighting_Command.fade_time =
+                    pObject->Transition_Duration - pObject->Transition_Time;
+            }
+            break;
+        case BACNET_LIGHTS_RAMP_TO:
+            pObject->Transition_Time += milliseconds;
+            delta = (int32_t)(((int64_t)pObject->Transition_Rate *
+                                  pObject->Transition_Time) /
+                1000);
+            if (pObject->Transition_Target > pObject->Transition_Start) {
+                level = pObject->Transition_Start + delta;
+                active = level < pObject->Transition_Target;
+            } else {
+                level = pObject->Transition_Start - delta;
+                active = level > pObject->Transition_Target;
+            }
+            if (active) {
+                pObject->Tracking_Value = Lighting_Level_Float(level);
+            } else {
+                Lighting_Output_Transition_Stop(pObject);
+            }
+            break;
+        case BACNET_LIGHTS_STEP_UP:
+        case BACNET_LIGHTS_STEP_DOWN:
+        case BACNET_LIGHTS_STEP_ON:
+        case BACNET_LIGHTS_STEP_OFF:
+            /* a step is inhibited when the light is off */
+            pObject->Transition_Active = false;
+            pObject->In_Progress = BACNET_LIGHTING_IDLE;
+            switch (pObject->Lighting_Command.operation) {
+                case BACNET_LIGHTS_STEP_UP:
+                    Lighting_Output_Step_Up_Handler(pObject->Instance);
+                    break;
+                case BACNET_LIGHTS_STEP_DOWN:
+                    Lighting_Output_Step_Down_Handler(pObject->Instance);
+                    break;
+                case BACNET_LIGHTS_STEP_ON:
+                    Lighting_Output_Step_On_Handler(pObject->Instance);
+                    break;
+                default:
+                    Lighting_Output_Step_Off_Handler(pObject->Instance);
+                    break;
+            }
+            return pObject->Transition_Active;
+        case BACNET_LIGHTS_WARN_OFF:
+        case BACNET_LIGHTS_WARN_RELINQUISH:
+            pObject->Transition_Time += milliseconds;
+            if (pObject->Transition_Time >= pObject->Transition_Duration) {
+                Lighting_Output_Egress_Stop(pObject);
+            }
+            return pObject->Transition_Active;
+        default:
+            pObject->Transition_Active = false;
+            pObject->In_Progress = BACNET_LIGHTING_IDLE;
+            return false;
+    }
+    if (Lighting_Output_Write_Present_Value_Callback) {
+        Lighting_Output_Write_Present_Value_Callback(
+            pObject->Instance, old_value, pObject->Tracking_Value);
+    }
+
+    return pObject->Transition_Active;
+}
+
+/**
+ * @brief Get the number of wheel ticks until the tracking value of a fade
+ *  or ramp changes by LIGHTING_OUTPUT_RESOLUTION, or the transition ends
+ * @param pObject - object with a transition in progress
+ * @return number of wheel ticks, at least one
+ */
+static uint32_t Lighting_Output_Transition_Interval(struct object_data *pObject)
+{
+    uint32_t milliseconds = LIGHTING_OUTPUT_TICK_MS;
+    uint32_t remaining = 0;
+    uint32_t delta, ticks;
+
+    if (pObject->Lighting_Command.operation == BACNET_LIGHTS_FADE_TO) {
+        remaining = pObject->Transition_Duration - pObject->Transition_Time;
+        if (pObject->Transition_Target > pObject->Transition_Start) {
+            delta = pObject->Transition_Target - pObject->Transition_Start;
+        } else {
+            delta = pObject->Transition_Start - pObject->Transition_Target;
+        }
+        if (delta > LIGHTING_OUTPUT_RESOLUTION) {
+            milliseconds = (uint32_t)(((uint64_t)pObject->Transition_Duration *
+                                          LIGHTING_OUTPUT_RESOLUTION) /
+                delta);
+        } else {
+            milliseconds = remaining;
+        }
+    } else if (pObject->Lighting_Command.operation == BACNET_LIGHTS_RAMP_TO) {
+        if (pObject->Transition_Rate > 0) {
+            milliseconds =
+                (LIGHTING_OUTPUT_RESOLUTION * 1000L) / pObject->Transition_Rate;
+        }
+    } else if (pObject->Egress_Active) {
+        remaining = pObject->Transition_Duration - pObject->Transition_Time;
+        milliseconds = remaining;
+    }
+    if (remaining && (milliseconds > remaining)) {
+        milliseconds = remaining;
+    }
+    ticks =
+        (milliseconds + LIGHTING_OUTPUT_TICK_MS - 1) / LIGHTING_OUTPUT_TICK_MS;
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    return ticks;
+}
+
+/**
+ * @brief Updates the tracking value of the Lighting Output objects with
+ *  a transition in progress.  Objects wait in the slot of the transition
+ *  wheel for the tick of their next update, so each call only visits the
+ *  objects that are due, and idle objects are never visited.
+ * @param milliseconds - number of milliseconds elapsed since previously
+ * called.  Suggest that this is called every LIGHTING_OUTPUT_TICK_MS.
+ */
+void Lighting_Output_Transition_Timer(uint16_t milliseconds)
+{
+    struct object_data *pObject, *pList;
+    uint32_t elapsed;
+    unsigned slot;
+
+    Transition_Milliseconds += milliseconds;
+    while (Transition_Milliseconds >= LIGHTING_OUTPUT_TICK_MS) {
+        Transition_Milliseconds -= LIGHTING_OUTPUT_TICK_MS;
+        Transition_Tick++;
+        slot = Transition_Tick & (LIGHTING_OUTPUT_WHEEL_SLOTS - 1);
+        pList = Transition_Wheel[slot];
+        Transition_Wheel[slot] = NULL;
+        while (pList) {
+            pObject = pList;
+            pList = pObject->Transition_Next;
+            pObject->Transition_Next = NULL;
+            pObject->Transition_Queued = false;
+            Transition_Count--;
+            if ((int32_t)(pObject->Transition_Due - Transition_Tick) > 0) {
+                /* due on a later lap of the wheel */
+                Transition_Wheel_Insert(pObject, pObject->Transition_Due);
+                continue;
+            }
+            elapsed = (Transition_Tick - pObject->Transition_Last) *
+                LIGHTING_OUTPUT_TICK_MS;
+            pObject->Transition_Last = Transition_Tick;
+            Lighting_Output_Transition_Step(pObject, elapsed);
+            /* a callback may have started a new transition already */
+            if (pObject->Transition_Active && !pObject->Transition_Queued) {
+                Transition_Wheel_Insert(pObject,
+                    Transition_Tick +
+                        Lighting_Output_Transition_Interval(pObject));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the number of Lighting Output objects with a transition
+ *  in progress
+ * @return number of objects in the transition wheel
+ */
+unsigned Lighting_Output_Transition_Active_Count(void)
+{
+    return Transition_Count;
+}
+
 /**
  * @brief Updates the lighting object tracking value per ramp or fade or step
+ *  for a single object, for callers that do not use
+ *  Lighting_Output_Transition_Timer()
  * @param  object_instance - object-instance number of the object
  * @param milliseconds - number of milliseconds elapsed since previously
  * called.  Suggest that this is called every 10 milliseconds.
@@ -2298,39 +2726,8 @@ void Lighting_Output_Timer(uint32_t object_instance, uint16_t milliseconds)
 
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
-        switch (pObject->Lighting_Command.operation) {
-            case BACNET_LIGHTS_NONE:
-                pObject->In_Progress = BACNET_LIGHTING_IDLE;
-                break;
-            case BACNET_LIGHTS_FADE_TO:
-                Lighting_Output_Fade_Handler(object_instance, milliseconds);
-                break;
-            case BACNET_LIGHTS_RAMP_TO:
-                Lighting_Output_Ramp_Handler(object_instance, milliseconds);
-                break;
-            case BACNET_LIGHTS_STEP_UP:
-                Lighting_Output_Step_Up_Handler(object_instance);
-                break;
-            case BACNET_LIGHTS_STEP_DOWN:
-                Lighting_Output_Step_Down_Handler(object_instance);
-                break;
-            case BACNET_LIGHTS_STEP_ON:
-                Lighting_Output_Step_On_Handler(object_instance);
-                break;
-            case BACNET_LIGHTS_STEP_OFF:
-                Lighting_Output_Step_Off_Handler(object_instance);
-                break;
-            case BACNET_LIGHTS_WARN:
-                break;
-            case BACNET_LIGHTS_WARN_OFF:
-                break;
-            case BACNET_LIGHTS_WARN_RELINQUISH:
-                break;
-            case BACNET_LIGHTS_STOP:
-                pObject->In_Progress = BACNET_LIGHTING_IDLE;
-                break;
-            default:
-                break;
+        if (!Lighting_Output_Transition_Step(pObject, milliseconds)) {
+            Transition_Wheel_Remove(pObject);
         }
     }
 }
@@ -2372,6 +2769,7 @@ uint32_t Lighting_Output_Create(uint32_t object_instance)
         if (!pObject) {
             return BACNET_MAX_INSTANCE;
         }
+        pObject->Instance = object_instance;
         pObject->Object_Name = NULL;
         pObject->Description = NULL;
         pObject->Present_Value = 0.0;
@@ -2408,6 +2806,12 @@ uint32_t Lighting_Output_Create(uint32_t object_instance)
         pObject->Color_Reference.instance = BACNET_MAX_INSTANCE;
         pObject->Override_Color_Reference.type = OBJECT_COLOR;
         pObject->Override_Color_Reference.instance = BACNET_MAX_INSTANCE;
+        pObject->COV_Increment = 1.0;
+        pObject->Prior_Value = 0.0;
+        pObject->Changed = false;
+        pObject->Transition_Active = false;
+        pObject->Transition_Queued = false;
+        pObject->Transition_Next = NULL;
         /* add to list */
         index = Keylist_Data_Add(Object_List, object_instance, pObject);
         if (index < 0) {
@@ -2431,6 +2835,7 @@ bool Lighting_Output_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Transition_Wheel_Remove(pObject);
         free(pObject);
         status = true;
     }
@@ -2455,6 +2860,8 @@ void Lighting_Output_Cleanup(void)
         Keylist_Delete(Object_List);
         Object_List = NULL;
     }
+    memset(Transition_Wheel, 0, sizeof(Transition_Wheel));
+    Transition_Count = 0;
 }
 
 /**
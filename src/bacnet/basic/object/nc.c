@@ -42,10 +42,12 @@
 #include "bacnet/basic/services.h"
 #include "bacnet/config.h"
 #include "bacnet/datetime.h"
+#include "bacnet/dcc.h"
 #include "bacnet/basic/object/device.h"
 #include "bacnet/event.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/sys/debug.h"
+#include "bacnet/basic/sys/ringbuf.h"
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/wp.h"
 #include "bacnet/basic/object/nc.h"
@@ -60,7 +62,21 @@
 #if defined(INTRINSIC_REPORTING)
 static NOTIFICATION_CLASS_INFO NC_Info[MAX_NOTIFICATION_CLASSES];
 /* buffer for sending event messages */
-static uint8_t Event_Buffer[MAX_APDU];
+static uint8_t Event_Buffer[MAX_PDU];
+/* event notification body, encoded once for all of the recipients */
+static uint8_t Event_Body[MAX_APDU];
+
+/* confirmed event notification waiting for a free transaction */
+typedef struct nc_event_queue_entry {
+    BACNET_ADDRESS dest;
+    uint16_t max_apdu;
+    uint32_t process_id;
+    uint16_t body_len;
+    uint8_t body[NC_EVENT_BODY_MAX];
+} NC_EVENT_QUEUE_ENTRY;
+static NC_EVENT_QUEUE_ENTRY Event_Queue_Data[NC_EVENT_QUEUE_SIZE];
+static RING_BUFFER Event_Queue;
+static unsigned Event_Queue_Dropped;
 
 /* These three arrays are used by the ReadPropertyMultiple handler */
 static const int Notification_Properties_Required[] = { PROP_OBJECT_IDENTIFIER,
@@ -104,6 +120,9 @@ void Notification_Class_Init(void)
             bacnet_destination_default_init(destination);
         }
     }
+    Ringbuf_Init(&Event_Queue, (volatile uint8_t *)&Event_Queue_Data[0],
+        sizeof(NC_EVENT_QUEUE_ENTRY), NC_EVENT_QUEUE_SIZE);
+    Event_Queue_Dropped = 0;
 
     return;
 }
@@ -487,11 +506,10 @@ void Notification_Class_Get_Priorities(
         pPriorityArray[i] = CurrentNotify->Priority[i];
 }
 
-static bool IsRecipientActive(
-    BACNET_DESTINATION *pBacDest, uint8_t EventToState)
+static bool IsRecipientActive(BACNET_DESTINATION *pBacDest,
+    uint8_t EventToState,
+    BACNET_DATE_TIME *DateTime)
 {
-    BACNET_DATE_TIME DateTime;
-
     /* valid Transitions */
     switch (EventToState) {
         case EVENT_STATE_OFFNORMAL:
@@ -519,19 +537,16 @@ static bool IsRecipientActive(
             return false; /* shouldn't happen */
     }
 
-    /* get actual date and time */
-    datetime_local(&DateTime.date, &DateTime.time, NULL, NULL);
-
     /* valid Days */
-    if (!(bitstring_bit(&pBacDest->ValidDays, (DateTime.date.wday - 1)))) {
+    if (!(bitstring_bit(&pBacDest->ValidDays, (DateTime->date.wday - 1)))) {
         return false;
     }
     /* valid FromTime */
-    if (datetime_compare_time(&DateTime.time, &pBacDest->FromTime) < 0)
+    if (datetime_compare_time(&DateTime->time, &pBacDest->FromTime) < 0)
         return false;
 
     /* valid ToTime */
-    if (datetime_compare_time(&pBacDest->ToTime, &DateTime.time) < 0)
+    if (datetime_compare_time(&pBacDest->ToTime, &DateTime->time) < 0)
         return false;
 
     return true;
@@ -544,8 +559,10 @@ void Notification_Class_common_reporting_function(
 
     NOTIFICATION_CLASS_INFO *CurrentNotify;
     BACNET_DESTINATION *pBacDest;
+    BACNET_DATE_TIME DateTime;
     uint32_t notify_index;
     uint8_t index;
+    int event_body_len;
 
     notify_index =
         Notification_Class_Instance_To_Index(event_data->notificationClass);
@@ -594,6 +611,11 @@ void Notification_Class_common_reporting_function(
             break;
     }
 
+    /* encode the event once - only the process identifier, invoke ID,
+       and addressing differ between the recipients */
+    event_body_len = event_notify_encode_service_body(Event_Body, event_data);
+    /* get actual date and time once for all of the recipients */
+    datetime_local(&DateTime.date, &DateTime.time, NULL, NULL);
     /* send notifications for active recipients */
     PRINTF("Notification Class[%u]: send notifications\n",
         event_data->notificationClass);
@@ -603,10 +625,10 @@ void Notification_Class_common_reporting_function(
         if (bacnet_recipient_device_wildcard(&pBacDest->Recipient)) {
             continue;
         }
-        if (IsRecipientActive(pBacDest, event_data->toState)) {
+        if (IsRecipientActive(pBacDest, event_data->toState, &DateTime)) {
             BACNET_ADDRESS dest;
             uint32_t device_id;
-            unsigned max_apdu;
+            unsigned max_apdu = MAX_APDU;
 
             /* Process Identifier */
             event_data->processIdentifier = pBacDest->ProcessIdentifier;
@@ -617,27 +639,137 @@ void Notification_Class_common_reporting_function(
                 device_id = pBacDest->Recipient.type.device.instance;
                 PRINTF("Notification Class[%u]: send notification to %u\n",
                     event_data->notificationClass, (unsigned)device_id);
-                if (pBacDest->ConfirmedNotify == true)
-                    Send_CEvent_Notify(device_id, event_data);
-                else if (address_get_by_device(device_id, &max_apdu, &dest))
-                    Send_UEvent_Notify(Event_Buffer, event_data, &dest);
+                if (!address_get_by_device(device_id, &max_apdu, &dest)) {
+                    continue;
+                }
             } else if (pBacDest->Recipient.tag ==
                 BACNET_RECIPIENT_TAG_ADDRESS) {
                 PRINTF("Notification Class[%u]: send notification to ADDR\n",
                     event_data->notificationClass);
                 /* send notification to the address indicated */
-                if (pBacDest->ConfirmedNotify == true) {
-                    if (address_get_device_id(&dest, &device_id))
-                        Send_CEvent_Notify(device_id, event_data);
-                } else {
-                    dest = pBacDest->Recipient.type.address;
-                    Send_UEvent_Notify(Event_Buffer, event_data, &dest);
-                }
+                dest = pBacDest->Recipient.type.address;
+            } else {
+                continue;
             }
+            if (pBacDest->ConfirmedNotify == true) {
+                Notification_Class_Event_Queue_Send(&dest, max_apdu,
+                    pBacDest->ProcessIdentifier, Event_Body, event_body_len);
+            } else {
+                Send_UEvent_Notify_Body(Event_Buffer,
+                    pBacDest->ProcessIdentifier, Event_Body, event_body_len,
+                    &dest);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Send the confirmed event notifications that are waiting in the
+ *  queue for as long as there are free transactions.  A notification
+ *  that could not be sent stays first in the queue, and is sent again on
+ *  the next call.  While communication is disabled by DCC the queued
+ *  notifications are dropped.  This should be called periodically, and
+ *  it is also called before an event is added.
+ */
+void Notification_Class_Event_Queue_Task(void)
+{
+    NC_EVENT_QUEUE_ENTRY *entry;
+    uint8_t invoke_id;
+
+    if (!dcc_communication_enabled()) {
+        while (Ringbuf_Pop(&Event_Queue, NULL)) {
+            /* not deferred until communication is enabled again */
         }
+        return;
+    }
+    while (!Ringbuf_Empty(&Event_Queue) && tsm_transaction_available()) {
+        entry = (NC_EVENT_QUEUE_ENTRY *)Ringbuf_Peek(&Event_Queue);
+        invoke_id = Send_CEvent_Notify_Body(Event_Buffer,
+            sizeof(Event_Buffer), entry->process_id, entry->body,
+            entry->body_len, &entry->dest, entry->max_apdu);
+        if (invoke_id == 0) {
+            break;
+        }
+        (void)Ringbuf_Pop(&Event_Queue, NULL);
     }
 }
 
+/**
+ * @brief Send a confirmed event notification now if a transaction is
+ *  available, or queue it until one is available.  When the queue is full
+ *  the notification is dropped and counted.  A notification is also
+ *  dropped while communication is disabled by DCC, or when it does not
+ *  fit in the maximum APDU of the recipient.
+ * @param dest - address of the recipient
+ * @param max_apdu - maximum APDU accepted by the recipient
+ * @param process_id - process identifier of the recipient
+ * @param body - event body from event_notify_encode_service_body()
+ * @param body_len - number of bytes in the event body
+ * @return true if the notification was sent or queued
+ */
+bool Notification_Class_Event_Queue_Send(BACNET_ADDRESS *dest,
+    unsigned max_apdu,
+    uint32_t process_id,
+    uint8_t *body,
+    unsigned body_len)
+{
+    NC_EVENT_QUEUE_ENTRY *entry;
+    int apdu_len;
+
+    if (!dcc_communication_enabled()) {
+        return false;
+    }
+    /* the invoke ID does not change the length */
+    apdu_len =
+        cevent_notify_encode_apdu_body(NULL, 0, process_id, body, body_len);
+    if ((apdu_len <= 0) || ((unsigned)apdu_len > max_apdu)) {
+        PRINTF("Notification Class: event exceeds the recipient APDU!\n");
+        return false;
+    }
+    /* keep the notifications in order */
+    Notification_Class_Event_Queue_Task();
+    if (Ringbuf_Empty(&Event_Queue) && tsm_transaction_available()) {
+        if (Send_CEvent_Notify_Body(Event_Buffer, sizeof(Event_Buffer),
+                process_id, body, body_len, dest, max_apdu)) {
+            return true;
+        }
+        /* not sent: queue it, and send it again from the task */
+    }
+    entry = (NC_EVENT_QUEUE_ENTRY *)Ringbuf_Data_Peek(&Event_Queue);
+    if (!entry || (body_len > sizeof(entry->body))) {
+        Event_Queue_Dropped++;
+        PRINTF("Notification Class: event queue full!\n");
+        return false;
+    }
+    bacnet_address_copy(&entry->dest, dest);
+    entry->max_apdu = (uint16_t)max_apdu;
+    entry->process_id = process_id;
+    entry->body_len = (uint16_t)body_len;
+    memcpy(entry->body, body, body_len);
+
+    return Ringbuf_Data_Put(&Event_Queue, (volatile uint8_t *)entry);
+}
+
+/**
+ * @brief Get the number of confirmed event notifications waiting for
+ *  a free transaction
+ * @return number of queued notifications
+ */
+unsigned Notification_Class_Event_Queue_Count(void)
+{
+    return Ringbuf_Count(&Event_Queue);
+}
+
+/**
+ * @brief Get the number of confirmed event notifications that were
+ *  dropped because the queue was full
+ * @return number of dropped notifications
+ */
+unsigned Notification_Class_Event_Queue_Dropped(void)
+{
+    return Event_Queue_Dropped;
+}
+
 /* This function tries to find the addresses of the defined devices. */
 /* It should be called periodically (example once per minute). */
 void Notification_Class_find_recipient(void)
@@ -41,6 +41,19 @@ extern "C" {
 /* max "length" of recipient_list */
 #define NC_MAX_RECIPIENTS 10
 
+/* number of confirmed event notifications that can wait for a free
+   transaction state machine slot - must be a power of two.  Each slot
+   holds an event body of NC_EVENT_BODY_MAX bytes, so lower both of them
+   on small devices. */
+#ifndef NC_EVENT_QUEUE_SIZE
+#define NC_EVENT_QUEUE_SIZE 64
+#endif
+
+/* largest event notification body that can wait in the queue */
+#ifndef NC_EVENT_BODY_MAX
+#define NC_EVENT_BODY_MAX MAX_APDU
+#endif
+
 #if defined(INTRINSIC_REPORTING)
 
 /* Structure containing configuration for a Notification Class */
@@ -105,6 +118,19 @@ void Notification_Class_common_reporting_function(
 
 BACNET_STACK_EXPORT
 void Notification_Class_find_recipient(void);
+
+BACNET_STACK_EXPORT
+bool Notification_Class_Event_Queue_Send(BACNET_ADDRESS *dest,
+    unsigned max_apdu,
+    uint32_t process_id,
+    uint8_t *body,
+    unsigned body_len);
+BACNET_STACK_EXPORT
+void Notification_Class_Event_Queue_Task(void);
+BACNET_STACK_EXPORT
+unsigned Notification_Class_Event_Queue_Count(void);
+BACNET_STACK_EXPORT
+unsigned Notification_Class_Event_Queue_Dropped(void);
 #endif /* defined(INTRINSIC_REPORTING) */
 
 #ifdef __cplusplus
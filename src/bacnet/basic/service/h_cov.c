@@ -38,6 +38,7 @@
 #include "bacnet/reject.h"
 #include "bacnet/cov.h"
 #include "bacnet/dcc.h"
+#include "bacnet/rp.h"
 #if PRINT_ENABLED
 #include "bacnet/bactext.h"
 #endif
@@ -58,12 +59,19 @@ typedef struct BACnet_COV_Address {
     BACNET_ADDRESS dest;
 } BACNET_COV_ADDRESS;
 
-/* note: This COV service only monitors the properties
-   of an object that have been specified in the standard.  */
+/* note: SubscribeCOV monitors the properties of an object that have
+   been specified in the standard.  SubscribeCOVProperty and
+   SubscribeCOVPropertyMultiple monitor one property, which is notified
+   with its whole value as encoded by ReadProperty. */
 typedef struct BACnet_COV_Subscription_Flags {
     bool valid : 1;
     bool issueConfirmedNotifications : 1; /* optional */
     bool send_requested : 1;
+    bool covSubscribeToProperty : 1;
+    bool covIncrementPresent : 1; /* optional */
+    bool multiple : 1; /* notified with COV-Notification-Multiple */
+    bool timestamped : 1;
+    bool sending : 1; /* encoded in the COV-Notification-Multiple */
 } BACNET_COV_SUBSCRIPTION_FLAGS;
 
 typedef struct BACnet_COV_Subscription {
@@ -73,6 +81,16 @@ typedef struct BACnet_COV_Subscription {
     uint32_t subscriberProcessIdentifier;
     uint32_t lifetime; /* optional */
     BACNET_OBJECT_ID monitoredObjectIdentifier;
+    BACNET_PROPERTY_ID monitoredProperty;
+    BACNET_ARRAY_INDEX monitoredArrayIndex;
+    float covIncrement; /* optional */
+    float covValue; /* REAL value last notified, with covIncrement */
+    uint32_t covChecksum; /* encoded value last notified, otherwise */
+    /* changes are collected for up to maxNotificationDelay seconds
+       into one COV-Notification-Multiple for the subscriber */
+    uint32_t maxNotificationDelay;
+    uint32_t delayRemaining;
+    BACNET_TIME timeOfChange;
 } BACNET_COV_SUBSCRIPTION;
 
 #ifndef MAX_COV_SUBCRIPTIONS
@@ -83,6 +101,8 @@ static BACNET_COV_SUBSCRIPTION COV_Subscriptions[MAX_COV_SUBCRIPTIONS];
 #define MAX_COV_ADDRESSES 16
 #endif
 static BACNET_COV_ADDRESS COV_Addresses[MAX_COV_ADDRESSES];
+/* buffer for the monitored property values read from the objects */
+static uint8_t COV_Property_Buffer[MAX_APDU];
 
 /**
  * Gets the address from the list of COV addresses
@@ -263,10 +283,24 @@ static int cov_encode_subscription(
         cov_subscription->monitoredObjectIdentifier.type,
         cov_subscription->monitoredObjectIdentifier.instance);
     apdu_len += len;
-    /* propertyIdentifier [1] */
-    /* FIXME: we are monitoring 2 properties! How to encode? */
-    len = encode_context_enumerated(&apdu[apdu_len], 1, PROP_PRESENT_VALUE);
-    apdu_len += len;
+    if (cov_subscription->flag.covSubscribeToProperty) {
+        /* propertyIdentifier [1] */
+        len = encode_context_enumerated(
+            &apdu[apdu_len], 1, cov_subscription->monitoredProperty);
+        apdu_len += len;
+        if (cov_subscription->monitoredArrayIndex != BACNET_ARRAY_ALL) {
+            /* propertyArrayIndex [2] */
+            len = encode_context_unsigned(
+                &apdu[apdu_len], 2, cov_subscription->monitoredArrayIndex);
+            apdu_len += len;
+        }
+    } else {
+        /* propertyIdentifier [1] */
+        /* FIXME: we are monitoring 2 properties! How to encode? */
+        len = encode_context_enumerated(
+            &apdu[apdu_len], 1, PROP_PRESENT_VALUE);
+        apdu_len += len;
+    }
     /* MonitoredPropertyReference [1] - closing */
     len = encode_closing_tag(&apdu[apdu_len], 1);
     apdu_len += len;
@@ -278,6 +312,12 @@ static int cov_encode_subscription(
     len =
         encode_context_unsigned(&apdu[apdu_len], 3, cov_subscription->lifetime);
     apdu_len += len;
+    if (cov_subscription->flag.covIncrementPresent) {
+        /* COVIncrement [4] REAL OPTIONAL */
+        len = encode_context_real(
+            &apdu[apdu_len], 4, cov_subscription->covIncrement);
+        apdu_len += len;
+    }
 
     return apdu_len;
 }
@@ -335,14 +375,251 @@ void handler_cov_init(void)
         COV_Subscriptions[index].invokeID = 0;
         COV_Subscriptions[index].lifetime = 0;
         COV_Subscriptions[index].flag.send_requested = false;
+        COV_Subscriptions[index].flag.covSubscribeToProperty = false;
+        COV_Subscriptions[index].flag.covIncrementPresent = false;
+        COV_Subscriptions[index].flag.multiple = false;
+        COV_Subscriptions[index].flag.timestamped = false;
+        COV_Subscriptions[index].flag.sending = false;
+        COV_Subscriptions[index].monitoredProperty = PROP_PRESENT_VALUE;
+        COV_Subscriptions[index].monitoredArrayIndex = BACNET_ARRAY_ALL;
+        COV_Subscriptions[index].maxNotificationDelay = 0;
+        COV_Subscriptions[index].delayRemaining = 0;
     }
     for (index = 0; index < MAX_COV_ADDRESSES; index++) {
         COV_Addresses[index].valid = false;
     }
 }
 
+/**
+ * Reads the encoded value of a property into the COV property buffer
+ *
+ * @param  object_id - object of the property
+ * @param  property - property to read
+ * @param  array_index - array index of the property, or BACNET_ARRAY_ALL
+ * @param  rpdata - read property data, with the error when not read
+ *
+ * @return number of bytes read, or BACNET_STATUS_ERROR
+ */
+static int cov_property_read(BACNET_OBJECT_ID *object_id,
+    BACNET_PROPERTY_ID property,
+    BACNET_ARRAY_INDEX array_index,
+    BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    rpdata->object_type = object_id->type;
+    rpdata->object_instance = object_id->instance;
+    rpdata->object_property = property;
+    rpdata->array_index = array_index;
+    rpdata->application_data = &COV_Property_Buffer[0];
+    rpdata->application_data_len = sizeof(COV_Property_Buffer);
+
+    return Device_Read_Property(rpdata);
+}
+
+/**
+ * Determines if the monitored property changes are flagged by the object,
+ * i.e. Present_Value and Status_Flags without a COV increment of the
+ * subscription, or the whole object for SubscribeCOV.
+ *
+ * @param  cov_subscription - subscription to check
+ *
+ * @return true if Device_COV() flags the changes
+ */
+static bool cov_subscription_object_cov(
+    BACNET_COV_SUBSCRIPTION *cov_subscription)
+{
+    if (!cov_subscription->flag.covSubscribeToProperty) {
+        return true;
+    }
+    if (cov_subscription->flag.covIncrementPresent) {
+        return false;
+    }
+    if ((cov_subscription->monitoredProperty != PROP_PRESENT_VALUE) &&
+        (cov_subscription->monitoredProperty != PROP_STATUS_FLAGS)) {
+        return false;
+    }
+
+    return Device_Value_List_Supported(
+        cov_subscription->monitoredObjectIdentifier.type);
+}
+
+/**
+ * FNV-1a checksum of an encoded property value
+ */
+static uint32_t cov_property_checksum(uint8_t *apdu, int apdu_len)
+{
+    uint32_t checksum = 2166136261UL;
+    int i;
+
+    for (i = 0; i < apdu_len; i++) {
+        checksum ^= apdu[i];
+        checksum *= 16777619UL;
+    }
+
+    return checksum;
+}
+
+/**
+ * Checks the monitored property of a subscription for a change since
+ * the last notification, and makes the current value the value to
+ * compare the next changes with.
+ *
+ * @param  cov_subscription - subscription to check
+ *
+ * @return true if the property value changed
+ */
+static bool cov_property_changed(BACNET_COV_SUBSCRIPTION *cov_subscription)
+{
+    BACNET_READ_PROPERTY_DATA rpdata;
+    bool changed = false;
+    float value = 0.0f;
+    float delta = 0.0f;
+    uint32_t checksum = 0;
+    int len = 0;
+
+    if (cov_subscription_object_cov(cov_subscription)) {
+        return Device_COV(
+            (BACNET_OBJECT_TYPE)cov_subscription->monitoredObjectIdentifier
+                .type,
+            cov_subscription->monitoredObjectIdentifier.instance);
+    }
+    len = cov_property_read(&cov_subscription->monitoredObjectIdentifier,
+        cov_subscription->monitoredProperty,
+        cov_subscription->monitoredArrayIndex, &rpdata);
+    if (len <= 0) {
+        return false;
+    }
+    if (cov_subscription->flag.covIncrementPresent &&
+        (bacnet_real_application_decode(&COV_Property_Buffer[0], len,
+             &value) > 0)) {
+        delta = value - cov_subscription->covValue;
+        if (delta < 0.0f) {
+            delta = -delta;
+        }
+        if (delta >= cov_subscription->covIncrement) {
+            cov_subscription->covValue = value;
+            changed = true;
+        }
+    } else {
+        checksum = cov_property_checksum(&COV_Property_Buffer[0], len);
+        if (checksum != cov_subscription->covChecksum) {
+            cov_subscription->covChecksum = checksum;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/**
+ * Flags the subscription for a notification
+ *
+ * @param  cov_subscription - subscription that changed
+ */
+static void cov_subscription_send_request(
+    BACNET_COV_SUBSCRIPTION *cov_subscription)
+{
+    BACNET_DATE_TIME bdatetime;
+
+    if (cov_subscription->flag.multiple &&
+        !cov_subscription->flag.send_requested) {
+        /* start the window in which the changes are collected */
+        cov_subscription->delayRemaining =
+            cov_subscription->maxNotificationDelay;
+    }
+    if (cov_subscription->flag.timestamped) {
+        Device_getCurrentDateTime(&bdatetime);
+        datetime_copy_time(&cov_subscription->timeOfChange, &bdatetime.time);
+    }
+    cov_subscription->flag.send_requested = true;
+}
+
+/**
+ * Compares a subscription with a subscribe request, excluding the address
+ *
+ * @param  cov_subscription - subscription to compare
+ * @param  cov_data - subscribe request
+ * @param  multiple - true for SubscribeCOVPropertyMultiple
+ *
+ * @return true if the request is for the subscription
+ */
+static bool cov_subscription_match(BACNET_COV_SUBSCRIPTION *cov_subscription,
+    BACNET_SUBSCRIBE_COV_DATA *cov_data,
+    bool multiple)
+{
+    if ((cov_subscription->monitoredObjectIdentifier.type !=
+            cov_data->monitoredObjectIdentifier.type) ||
+        (cov_subscription->monitoredObjectIdentifier.instance !=
+            cov_data->monitoredObjectIdentifier.instance) ||
+        (cov_subscription->subscriberProcessIdentifier !=
+            cov_data->subscriberProcessIdentifier)) {
+        return false;
+    }
+    if (cov_subscription->flag.covSubscribeToProperty !=
+        cov_data->covSubscribeToProperty) {
+        return false;
+    }
+    if (cov_data->covSubscribeToProperty) {
+        if ((cov_subscription->flag.multiple != multiple) ||
+            (cov_subscription->monitoredProperty !=
+                cov_data->monitoredProperty.propertyIdentifier) ||
+            (cov_subscription->monitoredArrayIndex !=
+                cov_data->monitoredProperty.propertyArrayIndex)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Copies the parameters of a subscribe request into a subscription,
+ * and flags the initial notification
+ */
+static void cov_subscription_set(BACNET_COV_SUBSCRIPTION *cov_subscription,
+    BACNET_SUBSCRIBE_COV_DATA *cov_data,
+    bool multiple,
+    uint32_t max_notification_delay)
+{
+    cov_subscription->flag.issueConfirmedNotifications =
+        cov_data->issueConfirmedNotifications;
+    cov_subscription->lifetime = cov_data->lifetime;
+    cov_subscription->flag.covSubscribeToProperty =
+        cov_data->covSubscribeToProperty;
+    cov_subscription->flag.multiple = false;
+    cov_subscription->flag.covIncrementPresent = false;
+    cov_subscription->flag.timestamped = false;
+    cov_subscription->monitoredProperty = PROP_PRESENT_VALUE;
+    cov_subscription->monitoredArrayIndex = BACNET_ARRAY_ALL;
+    if (cov_data->covSubscribeToProperty) {
+        cov_subscription->flag.multiple = multiple;
+        cov_subscription->flag.covIncrementPresent =
+            cov_data->covIncrementPresent;
+        cov_subscription->covIncrement = cov_data->covIncrement;
+        cov_subscription->monitoredProperty =
+            cov_data->monitoredProperty.propertyIdentifier;
+        cov_subscription->monitoredArrayIndex =
+            cov_data->monitoredProperty.propertyArrayIndex;
+        if (multiple) {
+            cov_subscription->flag.timestamped = cov_data->timestamped;
+        }
+        /* the values to compare the next changes with */
+        cov_subscription->covValue = 0.0f;
+        cov_subscription->covChecksum = 0;
+        if (!cov_subscription_object_cov(cov_subscription)) {
+            (void)cov_property_changed(cov_subscription);
+        }
+    }
+    cov_subscription->maxNotificationDelay = max_notification_delay;
+    /* the initial notification is sent without delay */
+    cov_subscription->flag.send_requested = false;
+    cov_subscription_send_request(cov_subscription);
+    cov_subscription->delayRemaining = 0;
+}
+
 static bool cov_list_subscribe(BACNET_ADDRESS *src,
     BACNET_SUBSCRIBE_COV_DATA *cov_data,
+    bool multiple,
+    uint32_t max_notification_delay,
     BACNET_ERROR_CLASS *error_class,
     BACNET_ERROR_CODE *error_code)
 {
@@ -366,12 +643,8 @@ static bool cov_list_subscribe(BACNET_ADDRESS *src,
                 /* skip address matching - we don't have an address */
                 address_match = true;
             }
-            if ((COV_Subscriptions[index].monitoredObjectIdentifier.type ==
-                    cov_data->monitoredObjectIdentifier.type) &&
-                (COV_Subscriptions[index].monitoredObjectIdentifier.instance ==
-                    cov_data->monitoredObjectIdentifier.instance) &&
-                (COV_Subscriptions[index].subscriberProcessIdentifier ==
-                    cov_data->subscriberProcessIdentifier) &&
+            if (cov_subscription_match(
+                    &COV_Subscriptions[index], cov_data, multiple) &&
                 address_match) {
                 existing_entry = true;
                 if (cov_data->cancellationRequest) {
@@ -381,10 +654,8 @@ static bool cov_list_subscribe(BACNET_ADDRESS *src,
                     cov_address_remove_unused();
                 } else {
                     COV_Subscriptions[index].dest_index = cov_address_add(src);
-                    COV_Subscriptions[index].flag.issueConfirmedNotifications =
-                        cov_data->issueConfirmedNotifications;
-                    COV_Subscriptions[index].lifetime = cov_data->lifetime;
-                    COV_Subscriptions[index].flag.send_requested = true;
+                    cov_subscription_set(&COV_Subscriptions[index], cov_data,
+                        multiple, max_notification_delay);
                 }
                 if (COV_Subscriptions[index].invokeID) {
                     tsm_free_invoke_id(COV_Subscriptions[index].invokeID);
@@ -410,11 +681,9 @@ static bool cov_list_subscribe(BACNET_ADDRESS *src,
             cov_data->monitoredObjectIdentifier.instance;
         COV_Subscriptions[index].subscriberProcessIdentifier =
             cov_data->subscriberProcessIdentifier;
-        COV_Subscriptions[index].flag.issueConfirmedNotifications =
-            cov_data->issueConfirmedNotifications;
         COV_Subscriptions[index].invokeID = 0;
-        COV_Subscriptions[index].lifetime = cov_data->lifetime;
-        COV_Subscriptions[index].flag.send_requested = true;
+        cov_subscription_set(&COV_Subscriptions[index], cov_data, multiple,
+            max_notification_delay);
     } else if (!existing_entry) {
         if (first_invalid_index < 0) {
             /* Out of resources */
@@ -511,6 +780,304 @@ COV_FAILED:
     return status;
 }
 
+/**
+ * Sends a COV notification for a SubscribeCOVProperty subscription: the
+ * whole value of the monitored property, as encoded by ReadProperty,
+ * followed by the Status_Flags of the object when the object has them.
+ *
+ * @param  cov_subscription - subscription to notify
+ *
+ * @return true if the notification was sent
+ */
+static bool cov_property_send_request(BACNET_COV_SUBSCRIPTION *cov_subscription)
+{
+    BACNET_READ_PROPERTY_DATA rpdata;
+    BACNET_COV_DATA cov_data;
+    BACNET_NPDU_DATA npdu_data;
+    BACNET_ADDRESS my_address;
+    BACNET_ADDRESS *dest = NULL;
+    bool confirmed = false;
+    bool status = false;
+    uint8_t invoke_id = 0;
+    int pdu_len = 0;
+    int max_pdu_len = 0;
+    int len = 0;
+    int value_len = 0;
+    int bytes_sent = 0;
+
+    if (!dcc_communication_enabled()) {
+        return false;
+    }
+    dest = cov_address_get(cov_subscription->dest_index);
+    if (!dest) {
+        return false;
+    }
+    value_len = cov_property_read(&cov_subscription->monitoredObjectIdentifier,
+        cov_subscription->monitoredProperty,
+        cov_subscription->monitoredArrayIndex, &rpdata);
+    if (value_len <= 0) {
+        return false;
+    }
+    confirmed = cov_subscription->flag.issueConfirmedNotifications;
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, confirmed, MESSAGE_PRIORITY_NORMAL);
+    pdu_len = npdu_encode_pdu(
+        &Handler_Transmit_Buffer[0], dest, &my_address, &npdu_data);
+    max_pdu_len = pdu_len + MAX_APDU;
+    if (max_pdu_len > (int)sizeof(Handler_Transmit_Buffer)) {
+        max_pdu_len = (int)sizeof(Handler_Transmit_Buffer);
+    }
+    /* room for closing the list of values */
+    max_pdu_len -= cov_notify_encode_apdu_end(NULL);
+    cov_data.subscriberProcessIdentifier =
+        cov_subscription->subscriberProcessIdentifier;
+    cov_data.initiatingDeviceIdentifier = Device_Object_Instance_Number();
+    cov_data.monitoredObjectIdentifier =
+        cov_subscription->monitoredObjectIdentifier;
+    cov_data.timeRemaining = cov_subscription->lifetime;
+    cov_data.listOfValues = NULL;
+    len = cov_notify_encode_apdu_init(NULL, confirmed, 0, &cov_data);
+    len += cov_notify_multiple_encode_apdu_property(NULL,
+        cov_subscription->monitoredProperty,
+        cov_subscription->monitoredArrayIndex, &COV_Property_Buffer[0],
+        value_len, NULL);
+    if ((pdu_len + len) > max_pdu_len) {
+        /* too large to ever be notified */
+        cov_subscription->flag.send_requested = false;
+        return false;
+    }
+    if (confirmed) {
+        invoke_id = tsm_next_free_invokeID();
+        if (!invoke_id) {
+            return false;
+        }
+        cov_subscription->invokeID = invoke_id;
+    }
+    pdu_len += cov_notify_encode_apdu_init(
+        &Handler_Transmit_Buffer[pdu_len], confirmed, invoke_id, &cov_data);
+    pdu_len += cov_notify_multiple_encode_apdu_property(
+        &Handler_Transmit_Buffer[pdu_len], cov_subscription->monitoredProperty,
+        cov_subscription->monitoredArrayIndex, &COV_Property_Buffer[0],
+        value_len, NULL);
+    if (cov_subscription->monitoredProperty != PROP_STATUS_FLAGS) {
+        value_len =
+            cov_property_read(&cov_subscription->monitoredObjectIdentifier,
+                PROP_STATUS_FLAGS, BACNET_ARRAY_ALL, &rpdata);
+        if (value_len > 0) {
+            len = cov_notify_multiple_encode_apdu_property(NULL,
+                PROP_STATUS_FLAGS, BACNET_ARRAY_ALL, &COV_Property_Buffer[0],
+                value_len, NULL);
+            if ((pdu_len + len) <= max_pdu_len) {
+                pdu_len += cov_notify_multiple_encode_apdu_property(
+                    &Handler_Transmit_Buffer[pdu_len], PROP_STATUS_FLAGS,
+                    BACNET_ARRAY_ALL, &COV_Property_Buffer[0], value_len,
+                    NULL);
+            }
+        }
+    }
+    pdu_len += cov_notify_encode_apdu_end(&Handler_Transmit_Buffer[pdu_len]);
+    if (confirmed) {
+        tsm_set_confirmed_unsegmented_transaction(invoke_id, dest, &npdu_data,
+            &Handler_Transmit_Buffer[0], (uint16_t)pdu_len);
+    }
+    bytes_sent = datalink_send_pdu(
+        dest, &npdu_data, &Handler_Transmit_Buffer[0], pdu_len);
+    if (bytes_sent > 0) {
+        status = true;
+#if PRINT_ENABLED
+        fprintf(stderr, "COVnotification: Sent!\n");
+#endif
+    }
+
+    return status;
+}
+
+/**
+ * Determines if a subscription is notified in the same
+ * COV-Notification-Multiple as another subscription: the same
+ * recipient, process, and confirmation.
+ */
+static bool cov_multiple_same_recipient(
+    BACNET_COV_SUBSCRIPTION *lead, BACNET_COV_SUBSCRIPTION *cov_subscription)
+{
+    return cov_subscription->flag.valid && cov_subscription->flag.multiple &&
+        (cov_subscription->dest_index == lead->dest_index) &&
+        (cov_subscription->subscriberProcessIdentifier ==
+            lead->subscriberProcessIdentifier) &&
+        (cov_subscription->flag.issueConfirmedNotifications ==
+            lead->flag.issueConfirmedNotifications);
+}
+
+/**
+ * Sends one COV-Notification-Multiple with the changed properties of all
+ * the SubscribeCOVPropertyMultiple subscriptions of a recipient process.
+ * Properties that do not fit into the APDU are sent with the next one.
+ *
+ * @param  lead - a subscription with a notification due
+ *
+ * @return true if the notification was sent
+ */
+static bool cov_send_multiple_request(BACNET_COV_SUBSCRIPTION *lead)
+{
+    BACNET_READ_PROPERTY_DATA rpdata;
+    BACNET_COV_MULTIPLE_DATA cov_data;
+    BACNET_COV_SUBSCRIPTION *cov_subscription = NULL;
+    BACNET_OBJECT_ID *object_id = NULL;
+    BACNET_NPDU_DATA npdu_data;
+    BACNET_ADDRESS my_address;
+    BACNET_ADDRESS *dest = NULL;
+    BACNET_TIME *time_of_change = NULL;
+    bool confirmed = false;
+    bool status = false;
+    uint8_t invoke_id = 0;
+    unsigned index = 0;
+    unsigned count = 0;
+    int pdu_len = 0;
+    int max_pdu_len = 0;
+    int len = 0;
+    int value_len = 0;
+    int bytes_sent = 0;
+
+    if (!dcc_communication_enabled()) {
+        return false;
+    }
+    dest = cov_address_get(lead->dest_index);
+    if (!dest) {
+        return false;
+    }
+    confirmed = lead->flag.issueConfirmedNotifications;
+    if (confirmed) {
+        if (!tsm_transaction_available()) {
+            return false;
+        }
+        invoke_id = tsm_next_free_invokeID();
+        if (!invoke_id) {
+            return false;
+        }
+    }
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, confirmed, MESSAGE_PRIORITY_NORMAL);
+    pdu_len = npdu_encode_pdu(
+        &Handler_Transmit_Buffer[0], dest, &my_address, &npdu_data);
+    max_pdu_len = pdu_len + MAX_APDU;
+    if (max_pdu_len > (int)sizeof(Handler_Transmit_Buffer)) {
+        max_pdu_len = (int)sizeof(Handler_Transmit_Buffer);
+    }
+    /* room for closing the list of values and the list of notifications */
+    max_pdu_len -= cov_notify_multiple_encode_apdu_object_end(NULL);
+    max_pdu_len -= cov_notify_multiple_encode_apdu_end(NULL);
+    cov_data.subscriberProcessIdentifier = lead->subscriberProcessIdentifier;
+    cov_data.initiatingDeviceIdentifier = Device_Object_Instance_Number();
+    cov_data.timeRemaining = lead->lifetime;
+    cov_data.timestampPresent = false;
+    cov_data.listOfNotifications = NULL;
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        cov_subscription = &COV_Subscriptions[index];
+        if (cov_multiple_same_recipient(lead, cov_subscription) &&
+            cov_subscription->flag.send_requested &&
+            cov_subscription->flag.timestamped) {
+            cov_data.timestampPresent = true;
+            Device_getCurrentDateTime(&cov_data.timestamp);
+            break;
+        }
+    }
+    pdu_len += cov_notify_multiple_encode_apdu_init(
+        &Handler_Transmit_Buffer[pdu_len], confirmed, invoke_id, &cov_data);
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        cov_subscription = &COV_Subscriptions[index];
+        if (!cov_multiple_same_recipient(lead, cov_subscription) ||
+            !cov_subscription->flag.send_requested ||
+            (cov_subscription->invokeID != 0)) {
+            continue;
+        }
+        value_len =
+            cov_property_read(&cov_subscription->monitoredObjectIdentifier,
+                cov_subscription->monitoredProperty,
+                cov_subscription->monitoredArrayIndex, &rpdata);
+        if (value_len <= 0) {
+            /* the property can no longer be read - nothing to notify */
+            cov_subscription->flag.send_requested = false;
+            continue;
+        }
+        time_of_change = NULL;
+        if (cov_subscription->flag.timestamped) {
+            time_of_change = &cov_subscription->timeOfChange;
+        }
+        len = cov_notify_multiple_encode_apdu_property(NULL,
+            cov_subscription->monitoredProperty,
+            cov_subscription->monitoredArrayIndex, &COV_Property_Buffer[0],
+            value_len, time_of_change);
+        if (!object_id ||
+            (object_id->type !=
+                cov_subscription->monitoredObjectIdentifier.type) ||
+            (object_id->instance !=
+                cov_subscription->monitoredObjectIdentifier.instance)) {
+            if (object_id) {
+                len += cov_notify_multiple_encode_apdu_object_end(NULL);
+            }
+            len += cov_notify_multiple_encode_apdu_object_begin(
+                NULL, &cov_subscription->monitoredObjectIdentifier);
+            if ((pdu_len + len) > max_pdu_len) {
+                if (count == 0) {
+                    /* too large to ever be notified */
+                    cov_subscription->flag.send_requested = false;
+                    continue;
+                }
+                break;
+            }
+            if (object_id) {
+                pdu_len += cov_notify_multiple_encode_apdu_object_end(
+                    &Handler_Transmit_Buffer[pdu_len]);
+            }
+            object_id = &cov_subscription->monitoredObjectIdentifier;
+            pdu_len += cov_notify_multiple_encode_apdu_object_begin(
+                &Handler_Transmit_Buffer[pdu_len], object_id);
+        } else if ((pdu_len + len) > max_pdu_len) {
+            break;
+        }
+        pdu_len += cov_notify_multiple_encode_apdu_property(
+            &Handler_Transmit_Buffer[pdu_len],
+            cov_subscription->monitoredProperty,
+            cov_subscription->monitoredArrayIndex, &COV_Property_Buffer[0],
+            value_len, time_of_change);
+        cov_subscription->flag.sending = true;
+        count++;
+    }
+    if (count) {
+        pdu_len += cov_notify_multiple_encode_apdu_object_end(
+            &Handler_Transmit_Buffer[pdu_len]);
+        pdu_len += cov_notify_multiple_encode_apdu_end(
+            &Handler_Transmit_Buffer[pdu_len]);
+        if (confirmed) {
+            tsm_set_confirmed_unsegmented_transaction(invoke_id, dest,
+                &npdu_data, &Handler_Transmit_Buffer[0], (uint16_t)pdu_len);
+        }
+        bytes_sent = datalink_send_pdu(
+            dest, &npdu_data, &Handler_Transmit_Buffer[0], pdu_len);
+        if (bytes_sent > 0) {
+            status = true;
+#if PRINT_ENABLED
+            fprintf(stderr, "COVnotificationMultiple: Sent %u values!\n",
+                count);
+#endif
+        }
+    } else if (invoke_id) {
+        tsm_free_invoke_id(invoke_id);
+    }
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        cov_subscription = &COV_Subscriptions[index];
+        if (cov_subscription->flag.sending) {
+            cov_subscription->flag.sending = false;
+            if (status) {
+                cov_subscription->flag.send_requested = false;
+                cov_subscription->invokeID = invoke_id;
+            }
+        }
+    }
+
+    return status;
+}
+
 static void cov_lifetime_expiration_handler(
     unsigned index, uint32_t elapsed_seconds, uint32_t lifetime_seconds)
 {
@@ -589,6 +1156,17 @@ void handler_cov_timer_seconds(uint32_t elapsed_seconds)
                         index, elapsed_seconds, lifetime_seconds);
                 }
             }
+            if ((COV_Subscriptions[index].flag.valid) &&
+                (COV_Subscriptions[index].flag.send_requested)) {
+                /* close the window of collecting changes */
+                if (COV_Subscriptions[index].delayRemaining >=
+                    elapsed_seconds) {
+                    COV_Subscriptions[index].delayRemaining -=
+                        elapsed_seconds;
+                } else {
+                    COV_Subscriptions[index].delayRemaining = 0;
+                }
+            }
         }
     }
 }
@@ -618,13 +1196,9 @@ bool handler_cov_fsm(void)
         case COV_STATE_MARK:
             /* mark any subscriptions where the value has changed */
             if (COV_Subscriptions[index].flag.valid) {
-                object_type = (BACNET_OBJECT_TYPE)COV_Subscriptions[index]
-                                  .monitoredObjectIdentifier.type;
-                object_instance =
-                    COV_Subscriptions[index].monitoredObjectIdentifier.instance;
-                status = Device_COV(object_type, object_instance);
+                status = cov_property_changed(&COV_Subscriptions[index]);
                 if (status) {
-                    COV_Subscriptions[index].flag.send_requested = true;
+                    cov_subscription_send_request(&COV_Subscriptions[index]);
 #if PRINT_ENABLED
                     fprintf(stderr, "COVtask: Marking...\n");
 #endif
@@ -639,7 +1213,8 @@ bool handler_cov_fsm(void)
         case COV_STATE_CLEAR:
             /* clear the COV flag after checking all subscriptions */
             if ((COV_Subscriptions[index].flag.valid) &&
-                (COV_Subscriptions[index].flag.send_requested)) {
+                (COV_Subscriptions[index].flag.send_requested) &&
+                cov_subscription_object_cov(&COV_Subscriptions[index])) {
                 object_type = (BACNET_OBJECT_TYPE)COV_Subscriptions[index]
                                   .monitoredObjectIdentifier.type;
                 object_instance =
@@ -686,7 +1261,17 @@ bool handler_cov_fsm(void)
                         send = false;
                     }
                 }
-                if (send) {
+                if (COV_Subscriptions[index].flag.multiple &&
+                    COV_Subscriptions[index].delayRemaining) {
+                    /* still collecting changes for the recipient */
+                    send = false;
+                }
+                if (send && COV_Subscriptions[index].flag.multiple) {
+#if PRINT_ENABLED
+                    fprintf(stderr, "COVtask: Sending Multiple...\n");
+#endif
+                    (void)cov_send_multiple_request(&COV_Subscriptions[index]);
+                } else if (send) {
                     object_type = (BACNET_OBJECT_TYPE)COV_Subscriptions[index]
                                       .monitoredObjectIdentifier.type;
                     object_instance = COV_Subscriptions[index]
@@ -694,14 +1279,19 @@ bool handler_cov_fsm(void)
 #if PRINT_ENABLED
                     fprintf(stderr, "COVtask: Sending...\n");
 #endif
-                    /* configure the linked list for the two properties */
-                    bacapp_property_value_list_init(
-                        &value_list[0], MAX_COV_PROPERTIES);
-                    status = Device_Encode_Value_List(
-                        object_type, object_instance, &value_list[0]);
-                    if (status) {
-                        status = cov_send_request(
-                            &COV_Subscriptions[index], &value_list[0]);
+                    if (COV_Subscriptions[index].flag.covSubscribeToProperty) {
+                        status = cov_property_send_request(
+                            &COV_Subscriptions[index]);
+                    } else {
+                        /* configure the linked list for the two properties */
+                        bacapp_property_value_list_init(
+                            &value_list[0], MAX_COV_PROPERTIES);
+                        status = Device_Encode_Value_List(
+                            object_type, object_instance, &value_list[0]);
+                        if (status) {
+                            status = cov_send_request(
+                                &COV_Subscriptions[index], &value_list[0]);
+                        }
                     }
                     if (status) {
                         COV_Subscriptions[index].flag.send_requested = false;
@@ -727,67 +1317,96 @@ void handler_cov_task(void)
     handler_cov_fsm();
 }
 
-static bool cov_subscribe(BACNET_ADDRESS *src,
-    BACNET_SUBSCRIBE_COV_DATA *cov_data,
+/**
+ * Validates the object, and the monitored property, of a subscribe request
+ *
+ * @param  cov_data - subscribe request
+ * @param  error_class - error class when not valid
+ * @param  error_code - error code when not valid
+ *
+ * @return true if the subscription can be added
+ */
+static bool cov_subscribe_valid(BACNET_SUBSCRIBE_COV_DATA *cov_data,
     BACNET_ERROR_CLASS *error_class,
     BACNET_ERROR_CODE *error_code)
 {
-    bool status = false; /* return value */
+    BACNET_READ_PROPERTY_DATA rpdata;
     BACNET_OBJECT_TYPE object_type = MAX_BACNET_OBJECT_TYPE;
     uint32_t object_instance = 0;
+    float value = 0.0f;
+    int len = 0;
 
     object_type = (BACNET_OBJECT_TYPE)cov_data->monitoredObjectIdentifier.type;
     object_instance = cov_data->monitoredObjectIdentifier.instance;
-    status = Device_Valid_Object_Id(object_type, object_instance);
-    if (status) {
-        status = Device_Value_List_Supported(object_type);
-        if (status) {
-            status = cov_list_subscribe(src, cov_data, error_class, error_code);
-        } else if (cov_data->cancellationRequest) {
-            /* From BACnet Standard 135-2010-13.14.2
-               ...Cancellations that are issued for which no matching COV
-               context can be found shall succeed as if a context had
-               existed, returning 'Result(+)'. */
-            status = true;
-        } else {
+    if (!Device_Valid_Object_Id(object_type, object_instance)) {
+        *error_class = ERROR_CLASS_OBJECT;
+        *error_code = ERROR_CODE_UNKNOWN_OBJECT;
+        return false;
+    }
+    if (!cov_data->covSubscribeToProperty) {
+        if (!Device_Value_List_Supported(object_type)) {
             *error_class = ERROR_CLASS_OBJECT;
             *error_code = ERROR_CODE_OPTIONAL_FUNCTIONALITY_NOT_SUPPORTED;
+            return false;
         }
+        return true;
+    }
+    if (cov_data->cancellationRequest) {
+        return true;
+    }
+    len = cov_property_read(&cov_data->monitoredObjectIdentifier,
+        cov_data->monitoredProperty.propertyIdentifier,
+        cov_data->monitoredProperty.propertyArrayIndex, &rpdata);
+    if (len <= 0) {
+        *error_class = rpdata.error_class;
+        *error_code = rpdata.error_code;
+        return false;
+    }
+    if (cov_data->covIncrementPresent &&
+        (bacnet_real_application_decode(&COV_Property_Buffer[0], len,
+             &value) <= 0)) {
+        /* a COV increment is only used with REAL values */
+        *error_class = ERROR_CLASS_PROPERTY;
+        *error_code = ERROR_CODE_NOT_COV_PROPERTY;
+        return false;
+    }
+
+    return true;
+}
+
+static bool cov_subscribe(BACNET_ADDRESS *src,
+    BACNET_SUBSCRIBE_COV_DATA *cov_data,
+    bool multiple,
+    uint32_t max_notification_delay,
+    BACNET_ERROR_CLASS *error_class,
+    BACNET_ERROR_CODE *error_code)
+{
+    bool status = false; /* return value */
+
+    status = cov_subscribe_valid(cov_data, error_class, error_code);
+    if (status) {
+        status = cov_list_subscribe(src, cov_data, multiple,
+            max_notification_delay, error_class, error_code);
     } else if (cov_data->cancellationRequest) {
         /* From BACnet Standard 135-2010-13.14.2
             ...Cancellations that are issued for which no matching COV
             context can be found shall succeed as if a context had
             existed, returning 'Result(+)'. */
         status = true;
-    } else {
-        *error_class = ERROR_CLASS_OBJECT;
-        *error_code = ERROR_CODE_UNKNOWN_OBJECT;
     }
 
     return status;
 }
 
-/** Handler for a COV Subscribe Service request.
- * @ingroup DSCOV
- * This handler will be invoked by apdu_handler() if it has been enabled
- * by a call to apdu_set_confirmed_handler().
- * This handler builds a response packet, which is
- * - an Abort if
- *   - the message is segmented
- *   - if decoding fails
- * - an ACK, if cov_subscribe() succeeds
- * - an Error if cov_subscribe() fails
- *
- * @param service_request [in] The contents of the service request.
- * @param service_len [in] The length of the service_request.
- * @param src [in] BACNET_ADDRESS of the source of the message
- * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
- *                          decoded from the APDU header of this message.
+/**
+ * Handles SubscribeCOV and SubscribeCOVProperty requests, which have
+ * the same responses.
  */
-void handler_cov_subscribe(uint8_t *service_request,
+static void cov_subscribe_handler(uint8_t *service_request,
     uint16_t service_len,
     BACNET_ADDRESS *src,
-    BACNET_CONFIRMED_SERVICE_DATA *service_data)
+    BACNET_CONFIRMED_SERVICE_DATA *service_data,
+    BACNET_CONFIRMED_SERVICE service_choice)
 {
     BACNET_SUBSCRIBE_COV_DATA cov_data;
     int len = 0;
@@ -815,8 +1434,16 @@ void handler_cov_subscribe(uint8_t *service_request,
 #endif
         error = true;
     } else {
-        len = cov_subscribe_decode_service_request(
-            service_request, service_len, &cov_data);
+        if (service_choice == SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY) {
+            len = cov_subscribe_property_decode_service_request(
+                service_request, service_len, &cov_data);
+            cov_data.covSubscribeToProperty = true;
+        } else {
+            len = cov_subscribe_decode_service_request(
+                service_request, service_len, &cov_data);
+            cov_data.covSubscribeToProperty = false;
+            cov_data.covIncrementPresent = false;
+        }
 #if PRINT_ENABLED
         if (len <= 0)
             fprintf(stderr, "SubscribeCOV: Unable to decode Request!\n");
@@ -826,11 +1453,11 @@ void handler_cov_subscribe(uint8_t *service_request,
         } else {
             cov_data.error_class = ERROR_CLASS_OBJECT;
             cov_data.error_code = ERROR_CODE_UNKNOWN_OBJECT;
-            success = cov_subscribe(
-                src, &cov_data, &cov_data.error_class, &cov_data.error_code);
+            success = cov_subscribe(src, &cov_data, false, 0,
+                &cov_data.error_class, &cov_data.error_code);
             if (success) {
                 apdu_len = encode_simple_ack(&Handler_Transmit_Buffer[npdu_len],
-                    service_data->invoke_id, SERVICE_CONFIRMED_SUBSCRIBE_COV);
+                    service_data->invoke_id, service_choice);
 #if PRINT_ENABLED
                 fprintf(stderr, "SubscribeCOV: Sending Simple Ack!\n");
 #endif
@@ -855,7 +1482,7 @@ void handler_cov_subscribe(uint8_t *service_request,
 #endif
         } else if (len == BACNET_STATUS_ERROR) {
             apdu_len = bacerror_encode_apdu(&Handler_Transmit_Buffer[npdu_len],
-                service_data->invoke_id, SERVICE_CONFIRMED_SUBSCRIBE_COV,
+                service_data->invoke_id, service_choice,
                 cov_data.error_class, cov_data.error_code);
 #if PRINT_ENABLED
             fprintf(stderr, "SubscribeCOV: Sending Error!\n");
@@ -881,3 +1508,262 @@ void handler_cov_subscribe(uint8_t *service_request,
 
     return;
 }
+
+/** Handler for a COV Subscribe Service request.
+ * @ingroup DSCOV
+ * This handler will be invoked by apdu_handler() if it has been enabled
+ * by a call to apdu_set_confirmed_handler().
+ * This handler builds a response packet, which is
+ * - an Abort if
+ *   - the message is segmented
+ *   - if decoding fails
+ * - an ACK, if cov_subscribe() succeeds
+ * - an Error if cov_subscribe() fails
+ *
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ *                          decoded from the APDU header of this message.
+ */
+void handler_cov_subscribe(uint8_t *service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS *src,
+    BACNET_CONFIRMED_SERVICE_DATA *service_data)
+{
+    cov_subscribe_handler(service_request, service_len, src, service_data,
+        SERVICE_CONFIRMED_SUBSCRIBE_COV);
+}
+
+/** Handler for a COV Subscribe Property Service request.
+ * @ingroup DSCOV
+ * This handler will be invoked by apdu_handler() if it has been enabled
+ * by a call to apdu_set_confirmed_handler().
+ * This handler builds a response packet, which is
+ * - an Abort if the message is segmented
+ * - a Reject if decoding fails
+ * - an ACK, if the property can be monitored
+ * - an Error if the object or property can not be monitored
+ *
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ *                          decoded from the APDU header of this message.
+ */
+void handler_cov_subscribe_property(uint8_t *service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS *src,
+    BACNET_CONFIRMED_SERVICE_DATA *service_data)
+{
+    cov_subscribe_handler(service_request, service_len, src, service_data,
+        SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY);
+}
+
+/**
+ * Determines if a subscription of a subscribe request exists
+ */
+static bool cov_list_subscribed(BACNET_ADDRESS *src,
+    BACNET_SUBSCRIBE_COV_DATA *cov_data,
+    bool multiple)
+{
+    unsigned index;
+    BACNET_ADDRESS *dest = NULL;
+
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if (COV_Subscriptions[index].flag.valid &&
+            cov_subscription_match(
+                &COV_Subscriptions[index], cov_data, multiple)) {
+            dest = cov_address_get(COV_Subscriptions[index].dest_index);
+            if (!dest || bacnet_address_same(src, dest)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Walks the COV subscription specifications of a
+ * SubscribeCOVPropertyMultiple request, either to validate all of them,
+ * or to subscribe all of them.
+ *
+ * @param  apdu - the list of COV subscription specifications
+ * @param  apdu_size - number of bytes in the list, including closing tag
+ * @param  src - address of the subscriber
+ * @param  data - the request parameters
+ * @param  subscribe - false to validate, true to subscribe
+ * @param  failed - the first failed subscription
+ *
+ * @return BACNET_STATUS_OK, BACNET_STATUS_ERROR with the failed
+ *  subscription, or BACNET_STATUS_REJECT if the list can not be decoded
+ */
+static int cov_subscribe_multiple_list(uint8_t *apdu,
+    unsigned apdu_size,
+    BACNET_ADDRESS *src,
+    BACNET_SUBSCRIBE_COV_MULTIPLE_DATA *data,
+    bool subscribe,
+    BACNET_SUBSCRIBE_COV_DATA *failed)
+{
+    unsigned len = 0;
+    int value_len = 0;
+    unsigned index = 0;
+    int available = 0;
+    BACNET_OBJECT_ID object_id = { OBJECT_NONE, 0 };
+    bool status = false;
+
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if (!COV_Subscriptions[index].flag.valid) {
+            available++;
+        }
+    }
+    failed->subscriberProcessIdentifier = data->subscriberProcessIdentifier;
+    failed->cancellationRequest = data->cancellationRequest;
+    failed->issueConfirmedNotifications = data->issueConfirmedNotifications;
+    failed->lifetime = data->lifetime;
+    failed->next = NULL;
+    while (!bacnet_is_closing_tag_number(
+        &apdu[len], apdu_size - len, 4, &value_len)) {
+        value_len = cov_subscribe_multiple_decode_object_id(
+            &apdu[len], apdu_size - len, &object_id);
+        if (value_len <= 0) {
+            return BACNET_STATUS_REJECT;
+        }
+        len += value_len;
+        while (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_size - len, 1, &value_len)) {
+            value_len = cov_subscribe_multiple_decode_reference(
+                &apdu[len], apdu_size - len, failed);
+            if (value_len <= 0) {
+                return BACNET_STATUS_REJECT;
+            }
+            len += value_len;
+            failed->monitoredObjectIdentifier = object_id;
+            if (subscribe) {
+                (void)cov_subscribe(src, failed, true,
+                    data->maxNotificationDelay, &failed->error_class,
+                    &failed->error_code);
+                continue;
+            }
+            status = cov_subscribe_valid(
+                failed, &failed->error_class, &failed->error_code);
+            if (data->cancellationRequest) {
+                /* cancellations always succeed */
+                continue;
+            }
+            if (status && !cov_list_subscribed(src, failed, true)) {
+                available--;
+                if (available < 0) {
+                    failed->error_class = ERROR_CLASS_RESOURCES;
+                    failed->error_code =
+                        ERROR_CODE_NO_SPACE_TO_ADD_LIST_ELEMENT;
+                    status = false;
+                }
+            }
+            if (!status) {
+                return BACNET_STATUS_ERROR;
+            }
+        }
+        len += value_len;
+    }
+
+    return BACNET_STATUS_OK;
+}
+
+/** Handler for a COV Subscribe Property Multiple Service request.
+ * @ingroup DSCOV
+ * This handler will be invoked by apdu_handler() if it has been enabled
+ * by a call to apdu_set_confirmed_handler().
+ * All the subscriptions are validated before any is added, so that
+ * either all of them succeed, or none of them.
+ * This handler builds a response packet, which is
+ * - an Abort if the message is segmented
+ * - a Reject if decoding fails
+ * - an ACK, if all the subscriptions succeed
+ * - a SubscribeCOVPropertyMultiple-Error with the first failed subscription
+ *
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ *                          decoded from the APDU header of this message.
+ */
+void handler_cov_subscribe_property_multiple(uint8_t *service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS *src,
+    BACNET_CONFIRMED_SERVICE_DATA *service_data)
+{
+    BACNET_SUBSCRIBE_COV_MULTIPLE_DATA data;
+    BACNET_SUBSCRIBE_COV_DATA failed = { 0 };
+    int len = 0;
+    int status = BACNET_STATUS_OK;
+    int pdu_len = 0;
+    int npdu_len = 0;
+    int apdu_len = 0;
+    BACNET_NPDU_DATA npdu_data;
+    int bytes_sent = 0;
+    BACNET_ADDRESS my_address;
+
+    /* encode the NPDU portion of the packet */
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, false, MESSAGE_PRIORITY_NORMAL);
+    npdu_len = npdu_encode_pdu(
+        &Handler_Transmit_Buffer[0], src, &my_address, &npdu_data);
+    if (service_data->segmented_message) {
+        /* we don't support segmentation - send an abort */
+        apdu_len = abort_encode_apdu(&Handler_Transmit_Buffer[npdu_len],
+            service_data->invoke_id,
+            ABORT_REASON_SEGMENTATION_NOT_SUPPORTED, true);
+#if PRINT_ENABLED
+        fprintf(stderr,
+            "SubscribeCOVPropertyMultiple: "
+            "Segmented message.  Sending Abort!\n");
+#endif
+        goto COV_ABORT;
+    }
+    len = cov_subscribe_multiple_decode_service_request(
+        service_request, service_len, &data);
+    if (len <= 0) {
+        status = BACNET_STATUS_REJECT;
+    } else {
+        status = cov_subscribe_multiple_list(&service_request[len],
+            service_len - len, src, &data, false, &failed);
+    }
+    if (status == BACNET_STATUS_OK) {
+        (void)cov_subscribe_multiple_list(&service_request[len],
+            service_len - len, src, &data, true, &failed);
+        apdu_len = encode_simple_ack(&Handler_Transmit_Buffer[npdu_len],
+            service_data->invoke_id,
+            SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY_MULTIPLE);
+#if PRINT_ENABLED
+        fprintf(stderr, "SubscribeCOVPropertyMultiple: Sending Simple Ack!\n");
+#endif
+    } else if (status == BACNET_STATUS_ERROR) {
+        apdu_len = cov_subscribe_multiple_error_encode_apdu(
+            &Handler_Transmit_Buffer[npdu_len], service_data->invoke_id,
+            failed.error_class, failed.error_code, &failed);
+#if PRINT_ENABLED
+        fprintf(stderr, "SubscribeCOVPropertyMultiple: Sending Error!\n");
+#endif
+    } else {
+        apdu_len = reject_encode_apdu(&Handler_Transmit_Buffer[npdu_len],
+            service_data->invoke_id, REJECT_REASON_INVALID_TAG);
+#if PRINT_ENABLED
+        fprintf(stderr, "SubscribeCOVPropertyMultiple: Sending Reject!\n");
+#endif
+    }
+
+COV_ABORT:
+    pdu_len = npdu_len + apdu_len;
+    bytes_sent = datalink_send_pdu(
+        src, &npdu_data, &Handler_Transmit_Buffer[0], pdu_len);
+    if (bytes_sent <= 0) {
+#if PRINT_ENABLED
+        fprintf(stderr, "SubscribeCOVPropertyMultiple: "
+            "Failed to send PDU (%s)!\n", strerror(errno));
+#endif
+    }
+
+    return;
+}
@@ -62,6 +62,7 @@ void handler_get_alarm_summary(uint8_t *service_request,
     int alarm_value = 0;
     unsigned i = 0;
     unsigned j = 0;
+    int position = 0;
     bool error = false;
     BACNET_ADDRESS my_address;
     BACNET_NPDU_DATA npdu_data;
@@ -90,7 +91,29 @@ void handler_get_alarm_summary(uint8_t *service_request,
         &Handler_Transmit_Buffer[pdu_len], service_data->invoke_id);
 
     for (i = 0; i < MAX_BACNET_OBJECT_TYPE; i++) {
-        if (Get_Alarm_Summary[i]) {
+        if (!Get_Alarm_Summary[i]) {
+            continue;
+        }
+        position = handler_get_event_information_active_seek(i, 0);
+        if (position >= 0) {
+            /* only visit the objects in the active event index */
+            while (handler_get_event_information_active_object(
+                position, i, NULL, &j)) {
+                position++;
+                alarm_value = Get_Alarm_Summary[i](j, &getalarm_data);
+                if (alarm_value > 0) {
+                    len = get_alarm_summary_ack_encode_apdu_data(
+                        &Handler_Transmit_Buffer[pdu_len + apdu_len],
+                        service_data->max_resp - apdu_len, &getalarm_data);
+                    if (len <= 0) {
+                        error = true;
+                        goto GET_ALARM_SUMMARY_ERROR;
+                    } else {
+                        apdu_len += len;
+                    }
+                }
+            }
+        } else {
             for (j = 0; j < 0xffff; j++) {
                 alarm_value = Get_Alarm_Summary[i](j, &getalarm_data);
                 if (alarm_value > 0) {
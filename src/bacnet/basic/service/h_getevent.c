@@ -40,11 +40,16 @@
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/sys/keylist.h"
 #include "bacnet/datalink/datalink.h"
 
 /** @file h_getevent.c  Handles Get Event Information request. */
 
 static get_event_info_function Get_Event_Info[MAX_BACNET_OBJECT_TYPE];
+static get_event_index_function Get_Event_Index[MAX_BACNET_OBJECT_TYPE];
+/* objects not in NORMAL or with unacknowledged transitions,
+   sorted by object identifier, for the indexed object types */
+static OS_Keylist Active_Event_List;
 
 /** print eventState
  */
@@ -74,6 +79,146 @@ void handler_get_event_information_set(
     }
 }
 
+/**
+ * @brief Enable the active event index for an object type.
+ *  Objects of an indexed type must report their active event
+ *  changes using handler_get_event_information_active_set(),
+ *  and only those objects are visited by the handlers.
+ * @param object_type - object type to be indexed
+ * @param pFunction - converts an object instance into the index
+ *  used by the get_event_info_function of this object type,
+ *  or NULL to go back to scanning every object of this type
+ */
+void handler_get_event_information_index_set(
+    BACNET_OBJECT_TYPE object_type, get_event_index_function pFunction)
+{
+    if (object_type < MAX_BACNET_OBJECT_TYPE) {
+        Get_Event_Index[object_type] = pFunction;
+        if (!Active_Event_List) {
+            Active_Event_List = Keylist_Create();
+        }
+    }
+}
+
+/**
+ * @brief Add or remove an object from the active event index.
+ *  An object is active when its Event_State is not NORMAL or
+ *  when its Acked_Transitions has any of its bits set to FALSE.
+ * @param object_type - object type of the event object
+ * @param object_instance - object instance of the event object
+ * @param active - true if the object has an active event
+ */
+void handler_get_event_information_active_set(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance, bool active)
+{
+    KEY key;
+
+    if (!Active_Event_List) {
+        Active_Event_List = Keylist_Create();
+    }
+    key = KEY_ENCODE(object_type, object_instance);
+    if (active) {
+        if (Keylist_Index(Active_Event_List, key) < 0) {
+            (void)Keylist_Data_Add(Active_Event_List, key, NULL);
+        }
+    } else {
+        (void)Keylist_Data_Delete(Active_Event_List, key);
+    }
+}
+
+/**
+ * @brief Find the position in the active event index of the first
+ *  object of this type with an instance equal to or greater than
+ *  the given object instance.
+ * @param object_type - object type of the event object
+ * @param object_instance - object instance to seek
+ * @return position in the index, or -1 if the type is not indexed
+ */
+int handler_get_event_information_active_seek(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    if ((object_type >= MAX_BACNET_OBJECT_TYPE) ||
+        (!Get_Event_Index[object_type])) {
+        return -1;
+    }
+
+    return Keylist_Index_Nearest(
+        Active_Event_List, KEY_ENCODE(object_type, object_instance));
+}
+
+/**
+ * @brief Get the object at a position in the active event index
+ * @param position - position in the index, from the seek function
+ * @param object_type - object type being iterated
+ * @param object_instance [out] object instance of the event object
+ * @param index [out] index to use with the get_event_info_function
+ * @return true if the position holds an object of this type
+ */
+bool handler_get_event_information_active_object(int position,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t *object_instance,
+    unsigned *index)
+{
+    KEY key;
+
+    if ((position < 0) || (position >= Keylist_Count(Active_Event_List)) ||
+        (object_type >= MAX_BACNET_OBJECT_TYPE) ||
+        (!Get_Event_Index[object_type])) {
+        return false;
+    }
+    key = Keylist_Key(Active_Event_List, position);
+    if (KEY_DECODE_TYPE(key) != (int)object_type) {
+        return false;
+    }
+    if (object_instance) {
+        *object_instance = KEY_DECODE_ID(key);
+    }
+    if (index) {
+        *index = Get_Event_Index[object_type](KEY_DECODE_ID(key));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Encode one event summary into the transmit buffer
+ * @param pdu_len - current length of the PDU in the transmit buffer
+ * @param apdu_len - current length of the APDU in the transmit buffer
+ * @param max_resp - maximum APDU size accepted by the client
+ * @param getevent_data - the event summary to encode
+ * @return number of bytes encoded, 0 if the event summary does not
+ *  fit and more events must be indicated, or a negative error status
+ */
+static int get_event_information_data_encode(int pdu_len,
+    int apdu_len,
+    int max_resp,
+    BACNET_GET_EVENT_INFORMATION_DATA *getevent_data)
+{
+    int len;
+
+    getevent_data->next = NULL;
+    len = getevent_ack_encode_apdu_data(&Handler_Transmit_Buffer[pdu_len],
+        sizeof(Handler_Transmit_Buffer) - pdu_len, getevent_data);
+    if (len < 0) {
+        return len;
+    } else if (len == 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    if (((apdu_len + len) >= (max_resp - 2)) ||
+        ((apdu_len + len) >= (MAX_APDU - 2))) {
+        /* Device must be able to fit minimum
+           one event information.
+           Length of one event information needs
+           more than 50 octets. */
+        if ((max_resp < 128) || (MAX_APDU < 128)) {
+            return BACNET_STATUS_ABORT;
+        }
+        return 0;
+    }
+
+    return len;
+}
+
 void handler_get_event_information(uint8_t *service_request,
     uint16_t service_len,
     BACNET_ADDRESS *src,
@@ -93,6 +238,8 @@ void handler_get_event_information(uint8_t *service_request,
     BACNET_ADDRESS my_address;
     BACNET_OBJECT_ID object_id;
     unsigned i = 0, j = 0; /* counter */
+    int position = 0;
+    uint32_t instance = 0;
     BACNET_GET_EVENT_INFORMATION_DATA getevent_data;
     int valid_event = 0;
 
@@ -136,56 +283,77 @@ void handler_get_event_information(uint8_t *service_request,
     }
     pdu_len += len;
     apdu_len = len;
-    for (i = 0; i < MAX_BACNET_OBJECT_TYPE; i++) {
-        if (Get_Event_Info[i]) {
-            for (j = 0; j < 0xffff; j++) {
+    for (i = 0; (i < MAX_BACNET_OBJECT_TYPE) && !more_events; i++) {
+        if (!Get_Event_Info[i]) {
+            continue;
+        }
+        if (Get_Event_Index[i]) {
+            /* seek directly to the 'Last Received Object Identifier' */
+            if (object_id.type != MAX_BACNET_OBJECT_TYPE) {
+                if (object_id.type != i) {
+                    continue;
+                }
+                position = handler_get_event_information_active_seek(
+                    i, object_id.instance);
+                if (handler_get_event_information_active_object(
+                        position, i, &instance, NULL) &&
+                    (instance == object_id.instance)) {
+                    position++;
+                }
+                object_id.type = MAX_BACNET_OBJECT_TYPE;
+            } else {
+                position = handler_get_event_information_active_seek(i, 0);
+            }
+            while (handler_get_event_information_active_object(
+                position, i, NULL, &j)) {
+                position++;
                 valid_event = Get_Event_Info[i](j, &getevent_data);
-                if (valid_event > 0) {
-                    /* encode GetEvent_data only when type of object_id has max
-                     * value */
-                    if (object_id.type != MAX_BACNET_OBJECT_TYPE) {
-                        if ((object_id.type ==
-                                getevent_data.objectIdentifier.type) &&
-                            (object_id.instance ==
-                                getevent_data.objectIdentifier.instance)) {
-                            /* found 'Last Received Object Identifier'
-                               so should set type of object_id to max value */
-                            object_id.type = MAX_BACNET_OBJECT_TYPE;
-                        }
-                        continue;
-                    }
-
-                    getevent_data.next = NULL;
-                    len = getevent_ack_encode_apdu_data(
-                        &Handler_Transmit_Buffer[pdu_len],
-                        sizeof(Handler_Transmit_Buffer) - pdu_len,
-                        &getevent_data);
-                    if (len <= 0) {
-                        error = true;
-                        goto GET_EVENT_ERROR;
-                    }
-                    apdu_len += len;
-                    if ((apdu_len >= service_data->max_resp - 2) ||
-                        (apdu_len >= MAX_APDU - 2)) {
-                        /* Device must be able to fit minimum
-                           one event information.
-                           Length of one event information needs
-                           more than 50 octets. */
-                        if ((service_data->max_resp < 128) ||
-                            (MAX_APDU < 128)) {
-                            len = BACNET_STATUS_ABORT;
-                            error = true;
-                            goto GET_EVENT_ERROR;
-                        } else {
-                            more_events = true;
-                        }
-                        break;
-                    } else {
-                        pdu_len += len;
+                if (valid_event <= 0) {
+                    continue;
+                }
+                len = get_event_information_data_encode(pdu_len, apdu_len,
+                    service_data->max_resp, &getevent_data);
+                if (len < 0) {
+                    error = true;
+                    goto GET_EVENT_ERROR;
+                } else if (len == 0) {
+                    more_events = true;
+                    break;
+                }
+                pdu_len += len;
+                apdu_len += len;
+            }
+            continue;
+        }
+        for (j = 0; j < 0xffff; j++) {
+            valid_event = Get_Event_Info[i](j, &getevent_data);
+            if (valid_event > 0) {
+                /* encode GetEvent_data only when type of object_id has max
+                 * value */
+                if (object_id.type != MAX_BACNET_OBJECT_TYPE) {
+                    if ((object_id.type ==
+                            getevent_data.objectIdentifier.type) &&
+                        (object_id.instance ==
+                            getevent_data.objectIdentifier.instance)) {
+                        /* found 'Last Received Object Identifier'
+                           so should set type of object_id to max value */
+                        object_id.type = MAX_BACNET_OBJECT_TYPE;
                     }
-                } else if (valid_event < 0) {
+                    continue;
+                }
+                len = get_event_information_data_encode(pdu_len, apdu_len,
+                    service_data->max_resp, &getevent_data);
+                if (len < 0) {
+                    error = true;
+                    goto GET_EVENT_ERROR;
+                } else if (len == 0) {
+                    more_events = true;
                     break;
                 }
+                pdu_len += len;
+                apdu_len += len;
+            } else if (valid_event < 0) {
+                break;
             }
         }
     }
@@ -39,6 +39,15 @@
 #include "bacnet/event.h"
 #include "bacnet/getevent.h"
 
+/** Converts an object instance into the index used by the
+ * get_event_info_function of the same object type.
+ * @param object_instance - object instance of the event object
+ * @return index of the object
+ */
+typedef unsigned (
+    *get_event_index_function) (
+    uint32_t object_instance);
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -48,6 +57,29 @@ extern "C" {
         BACNET_OBJECT_TYPE object_type,
         get_event_info_function pFunction);
 
+    BACNET_STACK_EXPORT
+    void handler_get_event_information_index_set(
+        BACNET_OBJECT_TYPE object_type,
+        get_event_index_function pFunction);
+
+    BACNET_STACK_EXPORT
+    void handler_get_event_information_active_set(
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance,
+        bool active);
+
+    BACNET_STACK_EXPORT
+    int handler_get_event_information_active_seek(
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance);
+
+    BACNET_STACK_EXPORT
+    bool handler_get_event_information_active_object(
+        int position,
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t *object_instance,
+        unsigned *index);
+
     BACNET_STACK_EXPORT
     void handler_get_event_information(
         uint8_t * service_request,
@@ -25,6 +25,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include "bacnet/config.h"
@@ -38,11 +39,282 @@
 
 /** @file h_whois.c  Handles Who-Is requests. */
 
+/* Device instance ranges waiting for a broadcast I-Am, sorted by the
+   network of the requester and without overlap, so that repeated Who-Is
+   are answered once, and each network gets its own batch of I-Am */
+typedef struct who_is_range {
+    uint32_t low_limit;
+    uint32_t high_limit;
+    /* network number of the requester, 0=local network */
+    uint16_t net;
+    /* true for this Device, false for the routed Devices */
+    bool device;
+} WHO_IS_RANGE;
+static WHO_IS_RANGE Who_Is_Pending[WHO_IS_PENDING_MAX];
+static unsigned Who_Is_Pending_Count;
+/* milliseconds to collect Who-Is before the first I-Am; 0=no scheduling */
+static uint16_t Who_Is_Window;
+/* milliseconds between batches of I-Am */
+static uint16_t Who_Is_Interval;
+/* number of I-Am in each batch for each network */
+static unsigned Who_Is_Batch_Size = 1;
+/* milliseconds until the next batch of I-Am */
+static uint32_t Who_Is_Countdown;
+
+/**
+ * @brief Delay with jitter, from one half to one and a half of the interval
+ * @param interval - number of milliseconds
+ * @return number of milliseconds
+ */
+static uint32_t who_is_jitter(uint16_t interval)
+{
+    return (interval / 2) + ((unsigned)rand() % ((unsigned)interval + 1));
+}
+
+/**
+ * @brief Compare the group of a pending range with a network and kind
+ * @param range - pending range
+ * @param net - network number of the requester
+ * @param device - true for this Device, false for the routed Devices
+ * @return negative if the range sorts before, 0 if same group, else positive
+ */
+static int who_is_range_group(WHO_IS_RANGE *range, uint16_t net, bool device)
+{
+    if (range->net != net) {
+        return (range->net < net) ? -1 : 1;
+    }
+    if (range->device != device) {
+        return range->device ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Add a Device instance range to the pending broadcast I-Am,
+ *  merging it with any overlapping or adjacent ranges of the same
+ *  network. Ranges are never widened to cover instances that no
+ *  requester asked about, so a full list rejects a new range.
+ * @param low_limit - lowest Device instance
+ * @param high_limit - highest Device instance
+ * @param net - network number of the requester
+ * @param device - true for this Device, false for the routed Devices
+ * @return true if the range is pending, false if the list is full
+ */
+static bool who_is_pending_add(
+    uint32_t low_limit, uint32_t high_limit, uint16_t net, bool device)
+{
+    unsigned i = 0, j = 0;
+    int group = 0;
+
+    /* skip the ranges that sort before this one and do not touch it */
+    while (i < Who_Is_Pending_Count) {
+        group = who_is_range_group(&Who_Is_Pending[i], net, device);
+        if ((group > 0) ||
+            ((group == 0) &&
+                ((Who_Is_Pending[i].high_limit >= low_limit) ||
+                    ((Who_Is_Pending[i].high_limit + 1) == low_limit)))) {
+            break;
+        }
+        i++;
+    }
+    /* absorb the ranges that overlap or touch this one */
+    j = i;
+    while ((j < Who_Is_Pending_Count) &&
+        (who_is_range_group(&Who_Is_Pending[j], net, device) == 0) &&
+        ((Who_Is_Pending[j].low_limit <= high_limit) ||
+            (Who_Is_Pending[j].low_limit == (high_limit + 1)))) {
+        if (Who_Is_Pending[j].low_limit < low_limit) {
+            low_limit = Who_Is_Pending[j].low_limit;
+        }
+        if (Who_Is_Pending[j].high_limit > high_limit) {
+            high_limit = Who_Is_Pending[j].high_limit;
+        }
+        j++;
+    }
+    if (j > i) {
+        /* replace the absorbed ranges with the merged range */
+        Who_Is_Pending[i].low_limit = low_limit;
+        Who_Is_Pending[i].high_limit = high_limit;
+        memmove(&Who_Is_Pending[i + 1], &Who_Is_Pending[j],
+            (Who_Is_Pending_Count - j) * sizeof(WHO_IS_RANGE));
+        Who_Is_Pending_Count -= (j - i - 1);
+    } else if (Who_Is_Pending_Count < WHO_IS_PENDING_MAX) {
+        if (Who_Is_Pending_Count == 0) {
+            Who_Is_Countdown = who_is_jitter(Who_Is_Window);
+        }
+        /* insert a new range */
+        memmove(&Who_Is_Pending[i + 1], &Who_Is_Pending[i],
+            (Who_Is_Pending_Count - i) * sizeof(WHO_IS_RANGE));
+        Who_Is_Pending[i].low_limit = low_limit;
+        Who_Is_Pending[i].high_limit = high_limit;
+        Who_Is_Pending[i].net = net;
+        Who_Is_Pending[i].device = device;
+        Who_Is_Pending_Count++;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Remove a pending range
+ * @param index - index of the pending range
+ */
+static void who_is_pending_remove(unsigned index)
+{
+    Who_Is_Pending_Count--;
+    memmove(&Who_Is_Pending[index], &Who_Is_Pending[index + 1],
+        (Who_Is_Pending_Count - index) * sizeof(WHO_IS_RANGE));
+}
+
+/**
+ * @brief Broadcast an I-Am for the current Device to a network
+ * @param net - network number of the requester, 0=local network
+ */
+static void who_is_i_am_send(uint16_t net)
+{
+    BACNET_ADDRESS dest = { 0 };
+
+    if (net == 0) {
+        Send_I_Am(&Handler_Transmit_Buffer[0]);
+    } else {
+        /* remote broadcast, so only the network of the requester
+           carries the I-Am */
+        dest.net = net;
+        dest.len = 0;
+        dest.mac_len = 0;
+        Send_I_Am_To_Network(&dest, Device_Object_Instance_Number(), MAX_APDU,
+            SEGMENTATION_NONE, Device_Vendor_Identifier());
+    }
+}
+
+/**
+ * @brief Send the next broadcast I-Am from the pending ranges of a network
+ * @param net - network number of the requester
+ * @return true if an I-Am was sent, false if nothing is pending
+ */
+static bool who_is_pending_send(uint16_t net)
+{
+    bool status = false;
+    unsigned i = 0;
+#ifdef BAC_ROUTING
+    uint32_t device_id = 0;
+    int cursor = 0;
+#endif
+
+    while (!status) {
+        for (i = 0; i < Who_Is_Pending_Count; i++) {
+            if (Who_Is_Pending[i].net == net) {
+                break;
+            }
+        }
+        if (i >= Who_Is_Pending_Count) {
+            break;
+        }
+        if (Who_Is_Pending[i].device) {
+            /* only this Device, so one I-Am answers the range */
+            who_is_pending_remove(i);
+            who_is_i_am_send(net);
+            status = true;
+            continue;
+        }
+#ifdef BAC_ROUTING
+        cursor = 0;
+        if (Routed_Device_GetNext_Instance(Who_Is_Pending[i].low_limit,
+                Who_Is_Pending[i].high_limit, &cursor)) {
+            device_id = Device_Object_Instance_Number();
+            who_is_i_am_send(net);
+            status = true;
+        } else {
+            device_id = Who_Is_Pending[i].high_limit;
+        }
+        if (device_id >= Who_Is_Pending[i].high_limit) {
+            /* this range is done */
+            who_is_pending_remove(i);
+        } else {
+            Who_Is_Pending[i].low_limit = device_id + 1;
+        }
+#else
+        who_is_pending_remove(i);
+#endif
+    }
+
+    return status;
+}
+
+/**
+ * @brief Configure the I-Am response scheduler for broadcast Who-Is.
+ *  Who-Is received within the window are coalesced, and the I-Am are
+ *  sent in batches with jitter so that a Who-Is storm, or a gateway with
+ *  many virtual Devices, does not flood the network with back-to-back I-Am.
+ * @param window - milliseconds to collect Who-Is before the first I-Am,
+ *  or 0 to send the I-Am immediately
+ * @param interval - milliseconds between batches of I-Am
+ * @param batch_size - number of I-Am in each batch for each network
+ */
+void handler_who_is_schedule_set(
+    uint16_t window, uint16_t interval, unsigned batch_size)
+{
+    Who_Is_Window = window;
+    Who_Is_Interval = interval;
+    if (batch_size == 0) {
+        batch_size = 1;
+    }
+    Who_Is_Batch_Size = batch_size;
+}
+
+/**
+ * @brief Get the number of Device instance ranges waiting for an I-Am
+ * @return number of pending ranges
+ */
+unsigned handler_who_is_pending(void)
+{
+    return Who_Is_Pending_Count;
+}
+
+/**
+ * @brief Send the scheduled I-Am responses. Call this periodically.
+ * @param milliseconds - number of milliseconds elapsed since last call
+ */
+void handler_who_is_timer(uint16_t milliseconds)
+{
+    uint16_t net_list[WHO_IS_PENDING_MAX];
+    unsigned net_count = 0;
+    unsigned count = 0;
+    unsigned i = 0;
+
+    if (Who_Is_Pending_Count == 0) {
+        return;
+    }
+    if (Who_Is_Countdown > milliseconds) {
+        Who_Is_Countdown -= milliseconds;
+        return;
+    }
+    /* the ranges are sorted by network, so each network is listed once */
+    for (i = 0; i < Who_Is_Pending_Count; i++) {
+        if ((net_count == 0) ||
+            (net_list[net_count - 1] != Who_Is_Pending[i].net)) {
+            net_list[net_count] = Who_Is_Pending[i].net;
+            net_count++;
+        }
+    }
+    for (i = 0; i < net_count; i++) {
+        count = 0;
+        while ((count < Who_Is_Batch_Size) && who_is_pending_send(net_list[i])) {
+            count++;
+        }
+    }
+    Who_Is_Countdown = who_is_jitter(Who_Is_Interval);
+}
+
 /** Handler for Who-Is requests, with broadcast I-Am response.
  * @ingroup DMDDB
  * @param service_request [in] The received message to be handled.
  * @param service_len [in] Length of the service_request message.
- * @param src [in] The BACNET_ADDRESS of the message's source (ignored).
+ * @param src [in] The BACNET_ADDRESS of the message's source, whose network
+ *                 gets the scheduled I-Am.
  */
 void handler_who_is(
     uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
@@ -51,15 +323,18 @@ void handler_who_is(
     int32_t low_limit = 0;
     int32_t high_limit = 0;
 
-    (void)src;
     len = whois_decode_service_request(
         service_request, service_len, &low_limit, &high_limit);
-    if (len == 0) {
-        Send_I_Am(&Handler_Transmit_Buffer[0]);
-    } else if (len != BACNET_STATUS_ERROR) {
-        /* is my device id within the limits? */
-        if ((Device_Object_Instance_Number() >= (uint32_t)low_limit) &&
-            (Device_Object_Instance_Number() <= (uint32_t)high_limit)) {
+    if (len == BACNET_STATUS_ERROR) {
+        return;
+    }
+    /* is my device id within the limits? If no limits, always respond */
+    if ((len == 0) ||
+        ((Device_Object_Instance_Number() >= (uint32_t)low_limit) &&
+            (Device_Object_Instance_Number() <= (uint32_t)high_limit))) {
+        if (!Who_Is_Window ||
+            !who_is_pending_add(Device_Object_Instance_Number(),
+                Device_Object_Instance_Number(), src ? src->net : 0, true)) {
             Send_I_Am(&Handler_Transmit_Buffer[0]);
         }
     }
@@ -124,10 +399,7 @@ static void check_who_is_for_routing(uint8_t *service_request,
     int len = 0;
     int32_t low_limit = 0;
     int32_t high_limit = 0;
-    int32_t dev_instance;
     int cursor = 0; /* Starting hint */
-    int my_list[2] = { 0, -1 }; /* Not really used, so dummy values */
-    BACNET_ADDRESS bcast_net;
 
     len = whois_decode_service_request(
         service_request, service_len, &low_limit, &high_limit);
@@ -135,20 +407,21 @@ static void check_who_is_for_routing(uint8_t *service_request,
         /* Invalid; just leave */
         return;
     }
-    /* Go through all devices, starting with the root gateway Device */
-    memset(&bcast_net, 0, sizeof(BACNET_ADDRESS));
-    bcast_net.net = BACNET_BROADCAST_NETWORK; /* That's all we have to set */
-
-    while (Routed_Device_GetNext(&bcast_net, my_list, &cursor)) {
-        dev_instance = Device_Object_Instance_Number();
-        /* If len == 0, no limits and always respond */
-        if ((len == 0) ||
-            ((dev_instance >= low_limit) && (dev_instance <= high_limit))) {
-            if (is_unicast)
-                Send_I_Am_Unicast(&Handler_Transmit_Buffer[0], src);
-            else
-                Send_I_Am(&Handler_Transmit_Buffer[0]);
-        }
+    /* If len == 0, no limits and always respond */
+    if (len == 0) {
+        low_limit = 0;
+        high_limit = BACNET_MAX_INSTANCE;
+    }
+    if ((low_limit < 0) || (high_limit < low_limit)) {
+        return;
+    }
+    /* Only visit the devices within the range, in instance order */
+    while (Routed_Device_GetNext_Instance(
+        (uint32_t)low_limit, (uint32_t)high_limit, &cursor)) {
+        if (is_unicast)
+            Send_I_Am_Unicast(&Handler_Transmit_Buffer[0], src);
+        else
+            Send_I_Am(&Handler_Transmit_Buffer[0]);
     }
 }
 
@@ -161,11 +434,33 @@ static void check_who_is_for_routing(uint8_t *service_request,
  * @ingroup DMDDB
  * @param service_request [in] The received message to be handled.
  * @param service_len [in] Length of the service_request message.
- * @param src [in] The BACNET_ADDRESS of the message's source (ignored).
+ * @param src [in] The BACNET_ADDRESS of the message's source, whose network
+ *                 gets the scheduled I-Am.
  */
 void handler_who_is_bcast_for_routing(
     uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
 {
+    int len = 0;
+    int32_t low_limit = 0;
+    int32_t high_limit = 0;
+
+    if (Who_Is_Window) {
+        len = whois_decode_service_request(
+            service_request, service_len, &low_limit, &high_limit);
+        if (len == 0) {
+            low_limit = 0;
+            high_limit = BACNET_MAX_INSTANCE;
+        }
+        if ((len == BACNET_STATUS_ERROR) || (low_limit < 0) ||
+            (high_limit < low_limit)) {
+            return;
+        }
+        if (who_is_pending_add((uint32_t)low_limit, (uint32_t)high_limit,
+                src ? src->net : 0, false)) {
+            return;
+        }
+    }
+    /* not scheduled, or the pending list is full: answer now */
     check_who_is_for_routing(service_request, service_len, src, false);
 }
 
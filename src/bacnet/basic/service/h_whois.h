@@ -37,6 +37,11 @@
 #include "bacnet/bacenum.h"
 #include "bacnet/apdu.h"
 
+/* number of Device instance ranges waiting for a scheduled I-Am */
+#ifndef WHO_IS_PENDING_MAX
+#define WHO_IS_PENDING_MAX 8
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -65,6 +70,20 @@ extern "C" {
         uint16_t service_len,
         BACNET_ADDRESS * src);
 
+    BACNET_STACK_EXPORT
+    void handler_who_is_schedule_set(
+        uint16_t window,
+        uint16_t interval,
+        unsigned batch_size);
+
+    BACNET_STACK_EXPORT
+    unsigned handler_who_is_pending(
+        void);
+
+    BACNET_STACK_EXPORT
+    void handler_who_is_timer(
+        uint16_t milliseconds);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -110,6 +110,85 @@ uint8_t Send_CEvent_Notify_Address(uint8_t *pdu,
     return invoke_id;
 }
 
+/** Sends an Confirmed Alarm/Event Notification using an event body
+ * that was encoded once for all of the recipients.
+ * @ingroup EVNOTFCN
+ *
+ * @param pdu [in] the PDU buffer used for sending the message
+ * @param pdu_size [in] Size of the PDU buffer
+ * @param process_id [in] The process identifier of the recipient.
+ * @param body [in] The event body from event_notify_encode_service_body().
+ * @param body_len [in] The number of bytes in the event body.
+ * @param dest [in] BACNET_ADDRESS of the destination device
+ * @param max_apdu [in] Maximum APDU accepted by the destination device
+ * @return invoke id of outgoing message, or 0 if communication is disabled,
+ *         or no tsm slot is available, or the notification does not fit.
+ */
+uint8_t Send_CEvent_Notify_Body(uint8_t *pdu,
+    uint16_t pdu_size,
+    uint32_t process_id,
+    uint8_t *body,
+    unsigned body_len,
+    BACNET_ADDRESS *dest,
+    unsigned max_apdu)
+{
+    int len = 0;
+    int pdu_len = 0;
+#if PRINT_ENABLED
+    int bytes_sent = 0;
+#endif
+    BACNET_NPDU_DATA npdu_data;
+    BACNET_ADDRESS my_address;
+    uint8_t invoke_id = 0;
+
+    if (!dcc_communication_enabled()) {
+        return 0;
+    }
+    if (!dest) {
+        return 0;
+    }
+    /* is there a tsm available? */
+    invoke_id = tsm_next_free_invokeID();
+    if (invoke_id) {
+        /* encode the NPDU portion of the packet */
+        datalink_get_my_address(&my_address);
+        npdu_encode_npdu_data(&npdu_data, true, MESSAGE_PRIORITY_NORMAL);
+        pdu_len = npdu_encode_pdu(pdu, dest, &my_address, &npdu_data);
+        /* will the APDU portion of the packet fit in the sender
+           and in the destination? */
+        len = cevent_notify_encode_apdu_body(
+            NULL, invoke_id, process_id, body, body_len);
+        if (((pdu_len + len) < pdu_size) && ((unsigned)len <= max_apdu)) {
+            len = cevent_notify_encode_apdu_body(
+                &pdu[pdu_len], invoke_id, process_id, body, body_len);
+            pdu_len += len;
+            tsm_set_confirmed_unsegmented_transaction(
+                invoke_id, dest, &npdu_data, pdu, (uint16_t)pdu_len);
+#if PRINT_ENABLED
+            bytes_sent =
+#endif
+                datalink_send_pdu(dest, &npdu_data, pdu, pdu_len);
+#if PRINT_ENABLED
+            if (bytes_sent <= 0) {
+                fprintf(stderr,
+                    "Failed to Send ConfirmedEventNotification Request (%s)!\n",
+                    strerror(errno));
+            }
+#endif
+        } else {
+            tsm_free_invoke_id(invoke_id);
+            invoke_id = 0;
+#if PRINT_ENABLED
+            fprintf(stderr,
+                "Failed to Send ConfirmedEventNotification Request "
+                "(exceeds destination maximum APDU)!\n");
+#endif
+        }
+    }
+
+    return invoke_id;
+}
+
 /** Sends an Confirmed Alarm/Event Notification.
  * @ingroup EVNOTFCN
  *
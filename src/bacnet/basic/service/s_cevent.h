@@ -49,6 +49,10 @@ uint8_t Send_CEvent_Notify(uint32_t device_id,
 BACNET_STACK_EXPORT
 uint8_t Send_CEvent_Notify_Address(uint8_t *pdu, uint16_t pdu_size,
     BACNET_EVENT_NOTIFICATION_DATA *data, BACNET_ADDRESS *dest);
+BACNET_STACK_EXPORT
+uint8_t Send_CEvent_Notify_Body(uint8_t *pdu, uint16_t pdu_size,
+    uint32_t process_id, uint8_t *body, unsigned body_len,
+    BACNET_ADDRESS *dest, unsigned max_apdu);
 
 #ifdef __cplusplus
 }
@@ -61,3 +61,44 @@ int Send_UEvent_Notify(
 
     return bytes_sent;
 }
+
+/** Sends an Unconfirmed Alarm/Event Notification using an event body
+ * that was encoded once for all of the recipients.
+ * @ingroup EVNOTFCN
+ *
+ * @param buffer [in,out] The buffer to build the message in for sending.
+ * @param process_id [in] The process identifier of the recipient.
+ * @param body [in] The event body from event_notify_encode_service_body().
+ * @param body_len [in] The number of bytes in the event body.
+ * @param dest [in] The destination address information (may be a broadcast).
+ * @return Size of the message sent (bytes), or a negative value on error.
+ */
+int Send_UEvent_Notify_Body(uint8_t *buffer,
+    uint32_t process_id,
+    uint8_t *body,
+    unsigned body_len,
+    BACNET_ADDRESS *dest)
+{
+    int len = 0;
+    int pdu_len = 0;
+    int bytes_sent = 0;
+    BACNET_NPDU_DATA npdu_data;
+    BACNET_ADDRESS my_address;
+
+    datalink_get_my_address(&my_address);
+    /* encode the NPDU portion of the packet */
+    npdu_encode_npdu_data(&npdu_data, false, MESSAGE_PRIORITY_NORMAL);
+    pdu_len = npdu_encode_pdu(buffer, dest, &my_address, &npdu_data);
+    /* will the APDU portion of the packet fit? */
+    len = uevent_notify_encode_apdu_body(NULL, process_id, body, body_len);
+    if ((pdu_len + len) > MAX_PDU) {
+        return -1;
+    }
+    len = uevent_notify_encode_apdu_body(
+        &buffer[pdu_len], process_id, body, body_len);
+    pdu_len += len;
+    /* send the data */
+    bytes_sent = datalink_send_pdu(dest, &npdu_data, &buffer[0], pdu_len);
+
+    return bytes_sent;
+}
@@ -48,6 +48,14 @@ extern "C" {
         BACNET_EVENT_NOTIFICATION_DATA * data,
         BACNET_ADDRESS * dest);
 
+    BACNET_STACK_EXPORT
+    int Send_UEvent_Notify_Body(
+        uint8_t * buffer,
+        uint32_t process_id,
+        uint8_t * body,
+        unsigned body_len,
+        BACNET_ADDRESS * dest);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
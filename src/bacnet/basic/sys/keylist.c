@@ -372,6 +372,26 @@ int Keylist_Index(OS_Keylist list, KEY key)
     return index;
 }
 
+/** Returns the index of the node with the key, or if the key is not
+ * in the list, the index of the first node with a greater key.
+ * Since the list is sorted, this allows seeking to a position.
+ *
+ * @param list  Pointer to the list
+ * @param key  Key to search for
+ *
+ * @return Index of the nearest node, or the count of nodes in the
+ *         list if all keys are less than the key.
+ */
+int Keylist_Index_Nearest(OS_Keylist list, KEY key)
+{
+    int index = 0; /* used to look up the index of node */
+
+    if (list) {
+        (void)FindIndex(list, key, &index);
+    }
+    return index;
+}
+
 /** Returns the data specified by index
  *
  * @param list  Pointer to the list
@@ -98,6 +98,12 @@ extern "C" {
         OS_Keylist list,
         KEY key);
 
+/* returns the index of the node with the key, or the next greater key */
+    BACNET_STACK_EXPORT
+    int Keylist_Index_Nearest(
+        OS_Keylist list,
+        KEY key);
+
 /* returns the data specified by key */
     BACNET_STACK_EXPORT
     void *Keylist_Data_Index(
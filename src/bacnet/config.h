@@ -38,7 +38,7 @@
 #if !(defined(BACDL_ETHERNET) || defined(BACDL_ARCNET) || \
     defined(BACDL_MSTP) || defined(BACDL_BIP) || defined(BACDL_BIP6) || \
     defined(BACDL_TEST) || defined(BACDL_ALL) || defined(BACDL_NONE) || \
-    defined(BACDL_CUSTOM))
+    defined(BACDL_LOOPBACK) || defined(BACDL_CUSTOM))
 #define BACDL_BIP
 #endif
 
@@ -62,7 +62,8 @@
 /* Enable the Gateway (Routing) functionality here, if desired. */
 #if !defined(MAX_NUM_DEVICES)
 #ifdef BAC_ROUTING
-#define MAX_NUM_DEVICES 32       /* Eg, Gateway + 31 remote devices */
+/* Gateway + remote devices, which are allocated as they are added */
+#define MAX_NUM_DEVICES 65535
 #else
 #define MAX_NUM_DEVICES 1       /* Just the one normal BACnet Device Object */
 #endif
@@ -90,6 +91,8 @@
    readrange so you get the More Follows flag set */
 #elif defined(BACDL_BIP6)
 #define MAX_APDU 1476
+#elif defined(BACDL_LOOPBACK)
+#define MAX_APDU 1476
 #elif defined (BACDL_ETHERNET)
 #if defined(BACNET_SECURITY)
 #define MAX_APDU 1420
@@ -32,6 +32,7 @@
  -------------------------------------------
 ####COPYRIGHTEND####*/
 #include <stdint.h>
+#include <string.h>
 #include "bacnet/bacenum.h"
 #include "bacnet/bacdcode.h"
 #include "bacnet/bacdef.h"
@@ -45,8 +46,10 @@
 /* Change-Of-Value Services
 COV Subscribe
 COV Subscribe Property
+COV Subscribe Property Multiple
 COV Notification
 Unconfirmed COV Notification
+COV Notification Multiple
 */
 
 /**
@@ -208,40 +211,116 @@ int ucov_notify_encode_apdu(
 }
 
 /**
- * @brief Decode the COV-service request only.
- *
- * ConfirmedCOVNotification-Request ::= SEQUENCE {
- *      subscriber-process-identifier [0] Unsigned32,
- *      initiating-device-identifier [1] BACnetObjectIdentifier,
- *      monitored-object-identifier [2] BACnetObjectIdentifier,
- *      time-remaining [3] Unsigned,
- *      list-of-values [4] SEQUENCE OF BACnetPropertyValue
- *  }
- *
- * @note: COV and Unconfirmed COV are the same.
+ * @brief Encode the COV-Notification PDU header and parameters, up to and
+ *  including the opening tag of the list of values.  The values are
+ *  encoded with cov_notify_multiple_encode_apdu_property(), without a
+ *  time of change, from the application data encoded by ReadProperty,
+ *  so that a value is notified whole.
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param confirmed  true for a ConfirmedCOVNotification
+ * @param invoke_id  Invoke Id, for a confirmed notification
+ * @param data  The parameters to encode; listOfValues is not used
+ * @return Bytes encoded
+ */
+int cov_notify_encode_apdu_init(
+    uint8_t *apdu, bool confirmed, uint8_t invoke_id, BACNET_COV_DATA *data)
+{
+    int len = 0;
+    int apdu_len = 0;
+
+    if (!data) {
+        return 0;
+    }
+    if (confirmed) {
+        if (apdu) {
+            apdu[0] = PDU_TYPE_CONFIRMED_SERVICE_REQUEST;
+            apdu[1] = encode_max_segs_max_apdu(0, MAX_APDU);
+            apdu[2] = invoke_id;
+            apdu[3] = SERVICE_CONFIRMED_COV_NOTIFICATION;
+            apdu += 4;
+        }
+        apdu_len += 4;
+    } else {
+        if (apdu) {
+            apdu[0] = PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST;
+            apdu[1] = SERVICE_UNCONFIRMED_COV_NOTIFICATION;
+            apdu += 2;
+        }
+        apdu_len += 2;
+    }
+    /* tag 0 - subscriberProcessIdentifier */
+    len = encode_context_unsigned(apdu, 0, data->subscriberProcessIdentifier);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* tag 1 - initiatingDeviceIdentifier */
+    len = encode_context_object_id(
+        apdu, 1, OBJECT_DEVICE, data->initiatingDeviceIdentifier);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* tag 2 - monitoredObjectIdentifier */
+    len = encode_context_object_id(apdu, 2,
+        data->monitoredObjectIdentifier.type,
+        data->monitoredObjectIdentifier.instance);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* tag 3 - timeRemaining */
+    len = encode_context_unsigned(apdu, 3, data->timeRemaining);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* tag 4 - listOfValues */
+    len = encode_opening_tag(apdu, 4);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+/**
+ * @brief Encode the closing tag of the list of values of a COV-Notification
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @return Bytes encoded
+ */
+int cov_notify_encode_apdu_end(uint8_t *apdu)
+{
+    return encode_closing_tag(apdu, 4);
+}
+
+/**
+ * @brief Decode the COV notification parameters before the list-of-values
  * @param apdu  Pointer to the buffer.
  * @param apdu_size  Number of valid bytes in the buffer.
- * @param data  Pointer to the data to store the decoded values, or NULL
- *
+ * @param subscriber_process_id  decoded value, or NULL
+ * @param initiating_device_id  decoded value, or NULL
+ * @param monitored_object_id  decoded value, or NULL
+ * @param time_remaining  decoded value, or NULL
  * @return Bytes decoded or BACNET_STATUS_ERROR on error.
  */
-int cov_notify_decode_service_request(
-    uint8_t *apdu, unsigned apdu_size, BACNET_COV_DATA *data)
+static int cov_notify_header_decode(uint8_t *apdu,
+    unsigned apdu_size,
+    uint32_t *subscriber_process_id,
+    uint32_t *initiating_device_id,
+    BACNET_OBJECT_ID *monitored_object_id,
+    uint32_t *time_remaining)
 {
     int len = 0; /* return value */
-    int value_len = 0, tag_len = 0;
+    int value_len = 0;
     BACNET_UNSIGNED_INTEGER decoded_value = 0;
     BACNET_OBJECT_TYPE decoded_type = OBJECT_NONE;
     uint32_t decoded_instance = 0;
-    BACNET_PROPERTY_ID property_identifier = PROP_ALL;
-    BACNET_PROPERTY_VALUE *value = NULL;
 
     /* subscriber-process-identifier [0] Unsigned32 */
     value_len = bacnet_unsigned_context_decode(
         &apdu[len], apdu_size - len, 0, &decoded_value);
     if (value_len > 0) {
-        if (data) {
-            data->subscriberProcessIdentifier = decoded_value;
+        if (subscriber_process_id) {
+            *subscriber_process_id = decoded_value;
         }
         len += value_len;
     } else {
@@ -254,8 +333,8 @@ int cov_notify_decode_service_request(
         if (decoded_type != OBJECT_DEVICE) {
             return BACNET_STATUS_ERROR;
         }
-        if (data) {
-            data->initiatingDeviceIdentifier = decoded_instance;
+        if (initiating_device_id) {
+            *initiating_device_id = decoded_instance;
         }
         len += value_len;
     } else {
@@ -265,9 +344,9 @@ int cov_notify_decode_service_request(
     value_len = bacnet_object_id_context_decode(
         &apdu[len], apdu_size - len, 2, &decoded_type, &decoded_instance);
     if (value_len > 0) {
-        if (data) {
-            data->monitoredObjectIdentifier.type = decoded_type;
-            data->monitoredObjectIdentifier.instance = decoded_instance;
+        if (monitored_object_id) {
+            monitored_object_id->type = decoded_type;
+            monitored_object_id->instance = decoded_instance;
         }
         len += value_len;
     } else {
@@ -277,13 +356,56 @@ int cov_notify_decode_service_request(
     value_len = bacnet_unsigned_context_decode(
         &apdu[len], apdu_size - len, 3, &decoded_value);
     if (value_len > 0) {
-        if (data) {
-            data->timeRemaining = decoded_value;
+        if (time_remaining) {
+            *time_remaining = decoded_value;
         }
         len += value_len;
     } else {
         return BACNET_STATUS_ERROR;
     }
+
+    return len;
+}
+
+/**
+ * @brief Decode the COV-service request only.
+ *
+ * ConfirmedCOVNotification-Request ::= SEQUENCE {
+ *      subscriber-process-identifier [0] Unsigned32,
+ *      initiating-device-identifier [1] BACnetObjectIdentifier,
+ *      monitored-object-identifier [2] BACnetObjectIdentifier,
+ *      time-remaining [3] Unsigned,
+ *      list-of-values [4] SEQUENCE OF BACnetPropertyValue
+ *  }
+ *
+ * @note: COV and Unconfirmed COV are the same.
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param data  Pointer to the data to store the decoded values, or NULL
+ *
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error.
+ */
+int cov_notify_decode_service_request(
+    uint8_t *apdu, unsigned apdu_size, BACNET_COV_DATA *data)
+{
+    int len = 0; /* return value */
+    int value_len = 0, tag_len = 0;
+    BACNET_PROPERTY_ID property_identifier = PROP_ALL;
+    BACNET_PROPERTY_VALUE *value = NULL;
+
+    if (data) {
+        value_len = cov_notify_header_decode(apdu, apdu_size,
+            &data->subscriberProcessIdentifier,
+            &data->initiatingDeviceIdentifier,
+            &data->monitoredObjectIdentifier, &data->timeRemaining);
+    } else {
+        value_len =
+            cov_notify_header_decode(apdu, apdu_size, NULL, NULL, NULL, NULL);
+    }
+    if (value_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
     /* list-of-values [4] SEQUENCE OF BACnetPropertyValue */
     if (bacnet_is_opening_tag_number(
             &apdu[len], apdu_size - len, 4, &tag_len)) {
@@ -328,6 +450,123 @@ int cov_notify_decode_service_request(
     return len;
 }
 
+/**
+ * @brief Decode the COV-Notification service request into compact values.
+ *  Values that are not primitive point into the APDU buffer, so the
+ *  buffer must outlive the decoded data.
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param data  Pointer to the data to store the decoded values
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error.
+ */
+int cov_notify_decode_compact_service_request(
+    uint8_t *apdu, unsigned apdu_size, BACNET_COV_COMPACT_DATA *data)
+{
+    int len = 0; /* return value */
+    int value_len = 0, tag_len = 0;
+    BACNET_PROPERTY_COMPACT_VALUE *value = NULL;
+
+    if (!apdu || !data) {
+        return BACNET_STATUS_ERROR;
+    }
+    value_len = cov_notify_header_decode(apdu, apdu_size,
+        &data->subscriberProcessIdentifier, &data->initiatingDeviceIdentifier,
+        &data->monitoredObjectIdentifier, &data->timeRemaining);
+    if (value_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    /* list-of-values [4] SEQUENCE OF BACnetPropertyValue */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 4, &tag_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += tag_len;
+    value = data->listOfValues;
+    while (value != NULL) {
+        value_len = bacapp_property_compact_value_decode(
+            &apdu[len], apdu_size - len, value);
+        if (value_len < 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        len += value_len;
+        if (bacnet_is_closing_tag_number(
+                &apdu[len], apdu_size - len, 4, &tag_len)) {
+            len += tag_len;
+            value->next = NULL;
+            return len;
+        }
+        value = value->next;
+    }
+
+    /* out of room to store next value */
+    return BACNET_STATUS_ERROR;
+}
+
+/**
+ * @brief Decode the COV-Notification service request, and pass each
+ *  value to a callback as it is decoded, without storing the values.
+ *  Values that are not primitive point into the APDU buffer.
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param subscriber_process_id  [out] subscriber process identifier,
+ *  set before the first callback, or NULL
+ * @param time_remaining  [out] time remaining, set before the first
+ *  callback, or NULL
+ * @param callback  function called for each value, or NULL to only
+ *  validate the APDU
+ * @param context  passed to the callback
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error.  If the callback
+ *  returns false, the bytes decoded up to and including that value.
+ */
+int cov_notify_decode_values(uint8_t *apdu,
+    unsigned apdu_size,
+    uint32_t *subscriber_process_id,
+    uint32_t *time_remaining,
+    cov_notify_value_callback_t callback,
+    void *context)
+{
+    int len = 0; /* return value */
+    int value_len = 0, tag_len = 0;
+    uint32_t device_id = 0;
+    BACNET_OBJECT_ID object_id = { OBJECT_NONE, 0 };
+    BACNET_PROPERTY_COMPACT_VALUE value = { 0 };
+
+    if (!apdu) {
+        return BACNET_STATUS_ERROR;
+    }
+    value_len = cov_notify_header_decode(apdu, apdu_size,
+        subscriber_process_id, &device_id, &object_id, time_remaining);
+    if (value_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    /* list-of-values [4] SEQUENCE OF BACnetPropertyValue */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 4, &tag_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += tag_len;
+    while (!bacnet_is_closing_tag_number(
+        &apdu[len], apdu_size - len, 4, &tag_len)) {
+        value_len = bacapp_property_compact_value_decode(
+            &apdu[len], apdu_size - len, callback ? &value : NULL);
+        if (value_len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        len += value_len;
+        if (callback &&
+            !callback(context, device_id, &object_id,
+                value.propertyIdentifier, value.propertyArrayIndex,
+                &value.value, value.priority)) {
+            return len;
+        }
+    }
+    len += tag_len;
+
+    return len;
+}
+
 /*
 12.11.38Active_COV_Subscriptions
 The Active_COV_Subscriptions property is a List of BACnetCOVSubscription,
@@ -731,6 +970,1078 @@ int cov_subscribe_property_decode_service_request(
     return len;
 }
 
+/*
+SubscribeCOVPropertyMultiple-Request ::= SEQUENCE {
+    subscriberProcessIdentifier [0] Unsigned32,
+    issueConfirmedNotifications [1] BOOLEAN OPTIONAL,
+    lifetime [2] Unsigned OPTIONAL,
+    maxNotificationDelay [3] Unsigned OPTIONAL,
+    listOfCOVSubscriptionSpecifications [4] SEQUENCE OF SEQUENCE {
+        monitoredObjectIdentifier [0] BACnetObjectIdentifier,
+        listOfCOVReferences [1] SEQUENCE OF SEQUENCE {
+            monitoredProperty [0] BACnetPropertyReference,
+            covIncrement [1] REAL OPTIONAL,
+            timestamped [2] BOOLEAN
+            }
+        }
+    }
+*/
+
+/**
+ * @brief Encode a BACnetPropertyReference in context tags
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param tag_number  Context tag number of the reference
+ * @param reference  Property reference to encode
+ * @return bytes encoded
+ */
+static int cov_property_reference_encode(
+    uint8_t *apdu, uint8_t tag_number, BACNET_PROPERTY_REFERENCE *reference)
+{
+    int len = 0;
+    int apdu_len = 0;
+
+    len = encode_opening_tag(apdu, tag_number);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_context_enumerated(apdu, 0, reference->propertyIdentifier);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    if (reference->propertyArrayIndex != BACNET_ARRAY_ALL) {
+        len = encode_context_unsigned(apdu, 1, reference->propertyArrayIndex);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+    }
+    len = encode_closing_tag(apdu, tag_number);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+/**
+ * @brief Decode a BACnetPropertyReference in context tags
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param tag_number  Context tag number of the reference
+ * @param reference  Property reference decoded, or NULL
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error.
+ */
+static int cov_property_reference_decode(uint8_t *apdu,
+    unsigned apdu_size,
+    uint8_t tag_number,
+    BACNET_PROPERTY_REFERENCE *reference)
+{
+    int len = 0;
+    int value_len = 0;
+    uint32_t decoded_enum = 0;
+    BACNET_UNSIGNED_INTEGER decoded_value = 0;
+
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, tag_number, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    /* propertyIdentifier [0] BACnetPropertyIdentifier */
+    value_len = bacnet_enumerated_context_decode(
+        &apdu[len], apdu_size - len, 0, &decoded_enum);
+    if (value_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    if (reference) {
+        reference->propertyIdentifier = (BACNET_PROPERTY_ID)decoded_enum;
+        reference->propertyArrayIndex = BACNET_ARRAY_ALL;
+    }
+    /* propertyArrayIndex [1] Unsigned OPTIONAL */
+    if (bacnet_is_context_tag_number(
+            &apdu[len], apdu_size - len, 1, NULL)) {
+        value_len = bacnet_unsigned_context_decode(
+            &apdu[len], apdu_size - len, 1, &decoded_value);
+        if (value_len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        if (reference) {
+            reference->propertyArrayIndex = decoded_value;
+        }
+        len += value_len;
+    }
+    if (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_size - len, tag_number, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+
+    return len;
+}
+
+/**
+ * @brief Encode the SubscribeCOVPropertyMultiple service request APDU.
+ *  Consecutive subscriptions of the same object are encoded as one
+ *  COV subscription specification.
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param max_apdu_len  Buffer size.
+ * @param invoke_id  Invoke Id.
+ * @param data  Pointer to the data to encode.
+ * @return Bytes encoded, or zero if the request does not fit
+ */
+int cov_subscribe_multiple_encode_apdu(uint8_t *apdu,
+    unsigned max_apdu_len,
+    uint8_t invoke_id,
+    BACNET_SUBSCRIBE_COV_MULTIPLE_DATA *data)
+{
+    int len = 0; /* length of each encoding */
+    int apdu_len = 0; /* total length of the apdu, return value */
+    BACNET_SUBSCRIBE_COV_DATA *subscription = NULL;
+    BACNET_SUBSCRIBE_COV_DATA *previous = NULL;
+    if (!data) {
+        return 0;
+    }
+    if (apdu) {
+        /* find the length first, so nothing is written if it won't fit */
+        apdu_len =
+            cov_subscribe_multiple_encode_apdu(NULL, 0, invoke_id, data);
+        if ((unsigned)apdu_len > max_apdu_len) {
+            return 0;
+        }
+        apdu_len = 0;
+        apdu[0] = PDU_TYPE_CONFIRMED_SERVICE_REQUEST;
+        apdu[1] = encode_max_segs_max_apdu(0, MAX_APDU);
+        apdu[2] = invoke_id;
+        apdu[3] = SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY_MULTIPLE;
+        apdu += 4;
+    }
+    apdu_len += 4;
+    /* subscriberProcessIdentifier [0] Unsigned32 */
+    len = encode_context_unsigned(apdu, 0, data->subscriberProcessIdentifier);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    if (!data->cancellationRequest) {
+        /* issueConfirmedNotifications [1] BOOLEAN OPTIONAL */
+        len = encode_context_boolean(apdu, 1, data->issueConfirmedNotifications);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+        /* lifetime [2] Unsigned OPTIONAL */
+        len = encode_context_unsigned(apdu, 2, data->lifetime);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+    }
+    if (data->maxNotificationDelay) {
+        /* maxNotificationDelay [3] Unsigned OPTIONAL */
+        len = encode_context_unsigned(apdu, 3, data->maxNotificationDelay);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+    }
+    /* listOfCOVSubscriptionSpecifications [4] */
+    len = encode_opening_tag(apdu, 4);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    subscription = data->listOfSubscriptions;
+    while (subscription) {
+        if (!previous ||
+            (previous->monitoredObjectIdentifier.type !=
+                subscription->monitoredObjectIdentifier.type) ||
+            (previous->monitoredObjectIdentifier.instance !=
+                subscription->monitoredObjectIdentifier.instance)) {
+            if (previous) {
+                /* listOfCOVReferences [1] - closing */
+                len = encode_closing_tag(apdu, 1);
+                apdu_len += len;
+                if (apdu) {
+                    apdu += len;
+                }
+            }
+            /* monitoredObjectIdentifier [0] BACnetObjectIdentifier */
+            len = encode_context_object_id(apdu, 0,
+                subscription->monitoredObjectIdentifier.type,
+                subscription->monitoredObjectIdentifier.instance);
+            apdu_len += len;
+            if (apdu) {
+                apdu += len;
+            }
+            /* listOfCOVReferences [1] - opening */
+            len = encode_opening_tag(apdu, 1);
+            apdu_len += len;
+            if (apdu) {
+                apdu += len;
+            }
+        }
+        /* monitoredProperty [0] BACnetPropertyReference */
+        len = cov_property_reference_encode(
+            apdu, 0, &subscription->monitoredProperty);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+        if (subscription->covIncrementPresent) {
+            /* covIncrement [1] REAL OPTIONAL */
+            len = encode_context_real(apdu, 1, subscription->covIncrement);
+            apdu_len += len;
+            if (apdu) {
+                apdu += len;
+            }
+        }
+        /* timestamped [2] BOOLEAN */
+        len = encode_context_boolean(apdu, 2, subscription->timestamped);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+        previous = subscription;
+        subscription = subscription->next;
+    }
+    if (previous) {
+        /* listOfCOVReferences [1] - closing */
+        len = encode_closing_tag(apdu, 1);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+    }
+    len = encode_closing_tag(apdu, 4);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+/**
+ * @brief Decode the SubscribeCOVPropertyMultiple service request
+ *  parameters up to and including the opening tag of the list of COV
+ *  subscription specifications.  The specifications are then decoded with
+ *  cov_subscribe_multiple_decode_object_id() and
+ *  cov_subscribe_multiple_decode_reference() until the closing tag [4].
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param data  Pointer to the data to store the decoded values, or NULL
+ * @return Bytes decoded or BACNET_STATUS_REJECT on error.
+ */
+int cov_subscribe_multiple_decode_service_request(uint8_t *apdu,
+    unsigned apdu_size,
+    BACNET_SUBSCRIBE_COV_MULTIPLE_DATA *data)
+{
+    int len = 0; /* return value */
+    int value_len = 0;
+    BACNET_UNSIGNED_INTEGER decoded_value = 0;
+    bool decoded_boolean = false;
+    bool confirmed_present = false;
+    bool lifetime_present = false;
+
+    if (!apdu) {
+        return BACNET_STATUS_REJECT;
+    }
+    /* subscriberProcessIdentifier [0] Unsigned32 */
+    value_len = bacnet_unsigned_context_decode(
+        &apdu[len], apdu_size - len, 0, &decoded_value);
+    if (value_len <= 0) {
+        return BACNET_STATUS_REJECT;
+    }
+    len += value_len;
+    if (data) {
+        data->subscriberProcessIdentifier = decoded_value;
+        data->issueConfirmedNotifications = false;
+        data->lifetime = 0;
+        data->maxNotificationDelay = 0;
+        data->listOfSubscriptions = NULL;
+    }
+    /* issueConfirmedNotifications [1] BOOLEAN OPTIONAL */
+    if (bacnet_is_context_tag_number(
+            &apdu[len], apdu_size - len, 1, NULL)) {
+        value_len = bacnet_boolean_context_decode(
+            &apdu[len], apdu_size - len, 1, &decoded_boolean);
+        if (value_len <= 0) {
+            return BACNET_STATUS_REJECT;
+        }
+        confirmed_present = true;
+        len += value_len;
+        if (data) {
+            data->issueConfirmedNotifications = decoded_boolean;
+        }
+    }
+    /* lifetime [2] Unsigned OPTIONAL */
+    if (bacnet_is_context_tag_number(
+            &apdu[len], apdu_size - len, 2, NULL)) {
+        value_len = bacnet_unsigned_context_decode(
+            &apdu[len], apdu_size - len, 2, &decoded_value);
+        if (value_len <= 0) {
+            return BACNET_STATUS_REJECT;
+        }
+        lifetime_present = true;
+        len += value_len;
+        if (data) {
+            data->lifetime = decoded_value;
+        }
+    }
+    /* maxNotificationDelay [3] Unsigned OPTIONAL */
+    if (bacnet_is_context_tag_number(
+            &apdu[len], apdu_size - len, 3, NULL)) {
+        value_len = bacnet_unsigned_context_decode(
+            &apdu[len], apdu_size - len, 3, &decoded_value);
+        if (value_len <= 0) {
+            return BACNET_STATUS_REJECT;
+        }
+        len += value_len;
+        if (data) {
+            data->maxNotificationDelay = decoded_value;
+        }
+    }
+    /* If both the 'Issue Confirmed Notifications' and
+       'Lifetime' parameters are absent, then this shall
+       indicate a cancellation request. */
+    if (data) {
+        data->cancellationRequest = !confirmed_present && !lifetime_present;
+    }
+    /* listOfCOVSubscriptionSpecifications [4] */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 4, &value_len)) {
+        return BACNET_STATUS_REJECT;
+    }
+    len += value_len;
+
+    return len;
+}
+
+/**
+ * @brief Decode the monitored object of a COV subscription specification,
+ *  and the opening tag of its list of COV references.
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param object_id  Decoded object identifier, or NULL
+ * @return Bytes decoded or BACNET_STATUS_REJECT on error.
+ */
+int cov_subscribe_multiple_decode_object_id(
+    uint8_t *apdu, unsigned apdu_size, BACNET_OBJECT_ID *object_id)
+{
+    int len = 0;
+    int value_len = 0;
+    BACNET_OBJECT_TYPE decoded_type = OBJECT_NONE;
+    uint32_t decoded_instance = 0;
+
+    if (!apdu) {
+        return BACNET_STATUS_REJECT;
+    }
+    /* monitoredObjectIdentifier [0] BACnetObjectIdentifier */
+    value_len = bacnet_object_id_context_decode(
+        &apdu[len], apdu_size - len, 0, &decoded_type, &decoded_instance);
+    if (value_len <= 0) {
+        return BACNET_STATUS_REJECT;
+    }
+    len += value_len;
+    if (object_id) {
+        object_id->type = decoded_type;
+        object_id->instance = decoded_instance;
+    }
+    /* listOfCOVReferences [1] */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 1, &value_len)) {
+        return BACNET_STATUS_REJECT;
+    }
+    len += value_len;
+
+    return len;
+}
+
+/**
+ * @brief Decode one COV reference of a COV subscription specification.
+ *  The closing tag [1] follows the last reference of the specification.
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param data  Decoded property, increment and timestamped, or NULL
+ * @return Bytes decoded or BACNET_STATUS_REJECT on error.
+ */
+int cov_subscribe_multiple_decode_reference(
+    uint8_t *apdu, unsigned apdu_size, BACNET_SUBSCRIBE_COV_DATA *data)
+{
+    int len = 0;
+    int value_len = 0;
+    float decoded_real = 0.0f;
+    bool decoded_boolean = false;
+    BACNET_PROPERTY_REFERENCE reference = { 0 };
+
+    if (!apdu) {
+        return BACNET_STATUS_REJECT;
+    }
+    /* monitoredProperty [0] BACnetPropertyReference */
+    value_len = cov_property_reference_decode(
+        &apdu[len], apdu_size - len, 0, &reference);
+    if (value_len <= 0) {
+        return BACNET_STATUS_REJECT;
+    }
+    len += value_len;
+    if (data) {
+        data->covSubscribeToProperty = true;
+        data->monitoredProperty = reference;
+        data->covIncrementPresent = false;
+    }
+    /* covIncrement [1] REAL OPTIONAL */
+    if (bacnet_is_context_tag_number(
+            &apdu[len], apdu_size - len, 1, NULL)) {
+        value_len = bacnet_real_context_decode(
+            &apdu[len], apdu_size - len, 1, &decoded_real);
+        if (value_len <= 0) {
+            return BACNET_STATUS_REJECT;
+        }
+        len += value_len;
+        if (data) {
+            data->covIncrementPresent = true;
+            data->covIncrement = decoded_real;
+        }
+    }
+    /* timestamped [2] BOOLEAN */
+    value_len = bacnet_boolean_context_decode(
+        &apdu[len], apdu_size - len, 2, &decoded_boolean);
+    if (value_len <= 0) {
+        return BACNET_STATUS_REJECT;
+    }
+    len += value_len;
+    if (data) {
+        data->timestamped = decoded_boolean;
+    }
+
+    return len;
+}
+
+/*
+SubscribeCOVPropertyMultiple-Error ::= SEQUENCE {
+    error-type [0] Error,
+    first-failed-subscription [1] SEQUENCE {
+        monitoredObjectIdentifier [0] BACnetObjectIdentifier,
+        monitoredPropertyReference [1] BACnetPropertyReference,
+        errorType [2] Error
+        }
+    }
+*/
+
+/**
+ * @brief Encode the SubscribeCOVPropertyMultiple Error APDU
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param invoke_id  Invoke Id of the request
+ * @param error_class  Error class of the request
+ * @param error_code  Error code of the request
+ * @param failed  The first failed subscription, with its error class
+ *  and code
+ * @return Bytes encoded
+ */
+int cov_subscribe_multiple_error_encode_apdu(uint8_t *apdu,
+    uint8_t invoke_id,
+    BACNET_ERROR_CLASS error_class,
+    BACNET_ERROR_CODE error_code,
+    BACNET_SUBSCRIBE_COV_DATA *failed)
+{
+    int len = 0;
+    int apdu_len = 0;
+
+    if (!failed) {
+        return 0;
+    }
+    if (apdu) {
+        apdu[0] = PDU_TYPE_ERROR;
+        apdu[1] = invoke_id;
+        apdu[2] = SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY_MULTIPLE;
+        apdu += 3;
+    }
+    apdu_len += 3;
+    /* error-type [0] Error */
+    len = encode_opening_tag(apdu, 0);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_application_enumerated(apdu, error_class);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_application_enumerated(apdu, error_code);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_closing_tag(apdu, 0);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* first-failed-subscription [1] */
+    len = encode_opening_tag(apdu, 1);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_context_object_id(apdu, 0,
+        failed->monitoredObjectIdentifier.type,
+        failed->monitoredObjectIdentifier.instance);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = cov_property_reference_encode(apdu, 1, &failed->monitoredProperty);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_opening_tag(apdu, 2);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_application_enumerated(apdu, failed->error_class);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_application_enumerated(apdu, failed->error_code);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_closing_tag(apdu, 2);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    len = encode_closing_tag(apdu, 1);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+/**
+ * @brief Decode an Error wrapped in a context tag
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error.
+ */
+static int cov_error_context_decode(uint8_t *apdu,
+    unsigned apdu_size,
+    uint8_t tag_number,
+    BACNET_ERROR_CLASS *error_class,
+    BACNET_ERROR_CODE *error_code)
+{
+    int len = 0;
+    int value_len = 0;
+    uint32_t decoded_enum = 0;
+
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, tag_number, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    /* error-class ENUMERATED */
+    value_len = bacnet_enumerated_application_decode(
+        &apdu[len], apdu_size - len, &decoded_enum);
+    if (value_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    *error_class = (BACNET_ERROR_CLASS)decoded_enum;
+    /* error-code ENUMERATED */
+    value_len = bacnet_enumerated_application_decode(
+        &apdu[len], apdu_size - len, &decoded_enum);
+    if (value_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    *error_code = (BACNET_ERROR_CODE)decoded_enum;
+    if (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_size - len, tag_number, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+
+    return len;
+}
+
+/**
+ * @brief Decode the SubscribeCOVPropertyMultiple Error, after the
+ *  error PDU header
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param error_class  Error class of the request, or NULL
+ * @param error_code  Error code of the request, or NULL
+ * @param failed  The first failed subscription, with its error class
+ *  and code, or NULL
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error.
+ */
+int cov_subscribe_multiple_error_decode_service_request(uint8_t *apdu,
+    unsigned apdu_size,
+    BACNET_ERROR_CLASS *error_class,
+    BACNET_ERROR_CODE *error_code,
+    BACNET_SUBSCRIBE_COV_DATA *failed)
+{
+    int len = 0;
+    int value_len = 0;
+    BACNET_ERROR_CLASS decoded_class = ERROR_CLASS_SERVICES;
+    BACNET_ERROR_CODE decoded_code = ERROR_CODE_OTHER;
+    BACNET_OBJECT_TYPE decoded_type = OBJECT_NONE;
+    uint32_t decoded_instance = 0;
+    BACNET_PROPERTY_REFERENCE reference = { 0 };
+
+    if (!apdu) {
+        return BACNET_STATUS_ERROR;
+    }
+    /* error-type [0] Error */
+    value_len = cov_error_context_decode(
+        &apdu[len], apdu_size - len, 0, &decoded_class, &decoded_code);
+    if (value_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    if (error_class) {
+        *error_class = decoded_class;
+    }
+    if (error_code) {
+        *error_code = decoded_code;
+    }
+    /* first-failed-subscription [1] */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 1, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    value_len = bacnet_object_id_context_decode(
+        &apdu[len], apdu_size - len, 0, &decoded_type, &decoded_instance);
+    if (value_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    value_len =
+        cov_property_reference_decode(&apdu[len], apdu_size - len, 1, &reference);
+    if (value_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    value_len = cov_error_context_decode(
+        &apdu[len], apdu_size - len, 2, &decoded_class, &decoded_code);
+    if (value_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    if (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_size - len, 1, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    if (failed) {
+        failed->monitoredObjectIdentifier.type = decoded_type;
+        failed->monitoredObjectIdentifier.instance = decoded_instance;
+        failed->monitoredProperty = reference;
+        failed->error_class = decoded_class;
+        failed->error_code = decoded_code;
+    }
+
+    return len;
+}
+
+/*
+ConfirmedCOVNotificationMultiple-Request ::= SEQUENCE {
+    subscriberProcessIdentifier [0] Unsigned32,
+    initiatingDeviceIdentifier [1] BACnetObjectIdentifier,
+    timeRemaining [2] Unsigned,
+    timestamp [3] BACnetDateTime OPTIONAL,
+    listOfCOVNotifications [4] SEQUENCE OF SEQUENCE {
+        monitoredObjectIdentifier [0] BACnetObjectIdentifier,
+        listOfValues [1] SEQUENCE OF SEQUENCE {
+            propertyIdentifier [0] BACnetPropertyIdentifier,
+            propertyArrayIndex [1] Unsigned OPTIONAL,
+            value [2] ABSTRACT-SYNTAX.&Type,
+            timeOfChange [3] Time OPTIONAL
+            }
+        }
+    }
+UnconfirmedCOVNotificationMultiple-Request is the same sequence.
+
+The notification is encoded in parts, like the ReadPropertyMultiple-ACK,
+so that a server can add the values of each object until the APDU is full:
+init, then object_begin, property..., object_end for each object, then end.
+*/
+
+/**
+ * @brief Encode the COV-Notification-Multiple PDU header and parameters,
+ *  up to and including the opening tag of the list of notifications.
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param confirmed  true for a ConfirmedCOVNotificationMultiple
+ * @param invoke_id  Invoke Id, for a confirmed notification
+ * @param data  The parameters to encode; listOfNotifications is not used
+ * @return Bytes encoded
+ */
+int cov_notify_multiple_encode_apdu_init(uint8_t *apdu,
+    bool confirmed,
+    uint8_t invoke_id,
+    BACNET_COV_MULTIPLE_DATA *data)
+{
+    int len = 0;
+    int apdu_len = 0;
+
+    if (!data) {
+        return 0;
+    }
+    if (confirmed) {
+        if (apdu) {
+            apdu[0] = PDU_TYPE_CONFIRMED_SERVICE_REQUEST;
+            apdu[1] = encode_max_segs_max_apdu(0, MAX_APDU);
+            apdu[2] = invoke_id;
+            apdu[3] = SERVICE_CONFIRMED_COV_NOTIFICATION_MULTIPLE;
+            apdu += 4;
+        }
+        apdu_len += 4;
+    } else {
+        if (apdu) {
+            apdu[0] = PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST;
+            apdu[1] = SERVICE_UNCONFIRMED_COV_NOTIFICATION_MULTIPLE;
+            apdu += 2;
+        }
+        apdu_len += 2;
+    }
+    /* subscriberProcessIdentifier [0] Unsigned32 */
+    len = encode_context_unsigned(apdu, 0, data->subscriberProcessIdentifier);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* initiatingDeviceIdentifier [1] BACnetObjectIdentifier */
+    len = encode_context_object_id(
+        apdu, 1, OBJECT_DEVICE, data->initiatingDeviceIdentifier);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* timeRemaining [2] Unsigned */
+    len = encode_context_unsigned(apdu, 2, data->timeRemaining);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    if (data->timestampPresent) {
+        /* timestamp [3] BACnetDateTime OPTIONAL */
+        len = bacapp_encode_context_datetime(apdu, 3, &data->timestamp);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+    }
+    /* listOfCOVNotifications [4] */
+    len = encode_opening_tag(apdu, 4);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+/**
+ * @brief Encode the monitored object of a COV notification, and the
+ *  opening tag of its list of values.
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param object_id  The monitored object
+ * @return Bytes encoded
+ */
+int cov_notify_multiple_encode_apdu_object_begin(
+    uint8_t *apdu, BACNET_OBJECT_ID *object_id)
+{
+    int len = 0;
+    int apdu_len = 0;
+
+    if (!object_id) {
+        return 0;
+    }
+    /* monitoredObjectIdentifier [0] BACnetObjectIdentifier */
+    len = encode_context_object_id(
+        apdu, 0, object_id->type, object_id->instance);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    /* listOfValues [1] */
+    len = encode_opening_tag(apdu, 1);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+/**
+ * @brief Encode one value of a COV notification, from the application
+ *  data encoded by ReadProperty.
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param object_property  Property identifier of the value
+ * @param array_index  Array index of the value, or BACNET_ARRAY_ALL
+ * @param application_data  The encoded property value
+ * @param application_data_len  Number of bytes of the encoded value
+ * @param time_of_change  Time of the change, or NULL if not timestamped
+ * @return Bytes encoded
+ */
+int cov_notify_multiple_encode_apdu_property(uint8_t *apdu,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_ARRAY_INDEX array_index,
+    uint8_t *application_data,
+    unsigned application_data_len,
+    BACNET_TIME *time_of_change)
+{
+    int len = 0;
+    int apdu_len = 0;
+
+    /* propertyIdentifier [0] BACnetPropertyIdentifier */
+    len = encode_context_enumerated(apdu, 0, object_property);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    if (array_index != BACNET_ARRAY_ALL) {
+        /* propertyArrayIndex [1] Unsigned OPTIONAL */
+        len = encode_context_unsigned(apdu, 1, array_index);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+    }
+    /* value [2] ABSTRACT-SYNTAX.&Type */
+    len = encode_opening_tag(apdu, 2);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+        if (application_data_len) {
+            memcpy(apdu, application_data, application_data_len);
+        }
+        apdu += application_data_len;
+    }
+    apdu_len += application_data_len;
+    len = encode_closing_tag(apdu, 2);
+    apdu_len += len;
+    if (apdu) {
+        apdu += len;
+    }
+    if (time_of_change) {
+        /* timeOfChange [3] Time OPTIONAL */
+        len = encode_context_time(apdu, 3, time_of_change);
+        apdu_len += len;
+    }
+
+    return apdu_len;
+}
+
+/**
+ * @brief Encode the closing tag of the list of values of an object
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @return Bytes encoded
+ */
+int cov_notify_multiple_encode_apdu_object_end(uint8_t *apdu)
+{
+    return encode_closing_tag(apdu, 1);
+}
+
+/**
+ * @brief Encode the closing tag of the list of notifications
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @return Bytes encoded
+ */
+int cov_notify_multiple_encode_apdu_end(uint8_t *apdu)
+{
+    return encode_closing_tag(apdu, 4);
+}
+
+/**
+ * @brief Decode one value of a COV notification
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error.
+ */
+static int cov_notify_multiple_value_decode(
+    uint8_t *apdu, unsigned apdu_size, BACNET_COV_MULTIPLE_VALUE *value)
+{
+    int len = 0;
+    int value_len = 0;
+    uint32_t decoded_enum = 0;
+    BACNET_UNSIGNED_INTEGER decoded_value = 0;
+
+    /* propertyIdentifier [0] BACnetPropertyIdentifier */
+    value_len = bacnet_enumerated_context_decode(
+        &apdu[len], apdu_size - len, 0, &decoded_enum);
+    if (value_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    value->propertyIdentifier = (BACNET_PROPERTY_ID)decoded_enum;
+    /* propertyArrayIndex [1] Unsigned OPTIONAL */
+    value->propertyArrayIndex = BACNET_ARRAY_ALL;
+    if (bacnet_is_context_tag_number(
+            &apdu[len], apdu_size - len, 1, NULL)) {
+        value_len = bacnet_unsigned_context_decode(
+            &apdu[len], apdu_size - len, 1, &decoded_value);
+        if (value_len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        len += value_len;
+        value->propertyArrayIndex = decoded_value;
+    }
+    /* value [2] ABSTRACT-SYNTAX.&Type */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 2, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    value_len = bacapp_decode_application_data(
+        &apdu[len], apdu_size - len, &value->value);
+    if (value_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    if (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_size - len, 2, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    /* timeOfChange [3] Time OPTIONAL */
+    value->timeOfChangePresent = false;
+    if (bacnet_is_context_tag_number(
+            &apdu[len], apdu_size - len, 3, NULL)) {
+        value_len = bacnet_time_context_decode(
+            &apdu[len], apdu_size - len, 3, &value->timeOfChange);
+        if (value_len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        len += value_len;
+        value->timeOfChangePresent = true;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Decode the COV-Notification-Multiple service request.
+ *  The caller links the notifications, and the values of each
+ *  notification, that the request is decoded into; unused links are
+ *  set to NULL.  Only a single application tagged value is decoded for
+ *  each property.
+ * @note Confirmed and Unconfirmed COV-Notification-Multiple are the same.
+ * @param apdu  Pointer to the buffer.
+ * @param apdu_size  Number of valid bytes in the buffer.
+ * @param data  Pointer to the data to store the decoded values
+ * @return Bytes decoded or BACNET_STATUS_ERROR on error, or if there
+ *  is no room to store the notifications or values
+ */
+int cov_notify_multiple_decode_service_request(
+    uint8_t *apdu, unsigned apdu_size, BACNET_COV_MULTIPLE_DATA *data)
+{
+    int len = 0;
+    int value_len = 0;
+    BACNET_UNSIGNED_INTEGER decoded_value = 0;
+    BACNET_OBJECT_TYPE decoded_type = OBJECT_NONE;
+    uint32_t decoded_instance = 0;
+    BACNET_COV_MULTIPLE_NOTIFICATION *notification = NULL;
+    BACNET_COV_MULTIPLE_NOTIFICATION *last_notification = NULL;
+    BACNET_COV_MULTIPLE_VALUE *value = NULL;
+    BACNET_COV_MULTIPLE_VALUE *last_value = NULL;
+
+    if (!apdu || !data) {
+        return BACNET_STATUS_ERROR;
+    }
+    /* subscriberProcessIdentifier [0] Unsigned32 */
+    value_len = bacnet_unsigned_context_decode(
+        &apdu[len], apdu_size - len, 0, &decoded_value);
+    if (value_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    data->subscriberProcessIdentifier = decoded_value;
+    /* initiatingDeviceIdentifier [1] BACnetObjectIdentifier */
+    value_len = bacnet_object_id_context_decode(
+        &apdu[len], apdu_size - len, 1, &decoded_type, &decoded_instance);
+    if ((value_len <= 0) || (decoded_type != OBJECT_DEVICE)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    data->initiatingDeviceIdentifier = decoded_instance;
+    /* timeRemaining [2] Unsigned */
+    value_len = bacnet_unsigned_context_decode(
+        &apdu[len], apdu_size - len, 2, &decoded_value);
+    if (value_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    data->timeRemaining = decoded_value;
+    /* timestamp [3] BACnetDateTime OPTIONAL */
+    data->timestampPresent = false;
+    if (bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 3, NULL)) {
+        value_len = bacnet_datetime_context_decode(
+            &apdu[len], apdu_size - len, 3, &data->timestamp);
+        if (value_len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        len += value_len;
+        data->timestampPresent = true;
+    }
+    /* listOfCOVNotifications [4] */
+    if (!bacnet_is_opening_tag_number(
+            &apdu[len], apdu_size - len, 4, &value_len)) {
+        return BACNET_STATUS_ERROR;
+    }
+    len += value_len;
+    notification = data->listOfNotifications;
+    while (!bacnet_is_closing_tag_number(
+        &apdu[len], apdu_size - len, 4, &value_len)) {
+        if (!notification) {
+            /* out of room to store the next notification */
+            return BACNET_STATUS_ERROR;
+        }
+        /* monitoredObjectIdentifier [0] BACnetObjectIdentifier */
+        value_len = bacnet_object_id_context_decode(&apdu[len],
+            apdu_size - len, 0, &decoded_type, &decoded_instance);
+        if (value_len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        len += value_len;
+        notification->monitoredObjectIdentifier.type = decoded_type;
+        notification->monitoredObjectIdentifier.instance = decoded_instance;
+        /* listOfValues [1] */
+        if (!bacnet_is_opening_tag_number(
+                &apdu[len], apdu_size - len, 1, &value_len)) {
+            return BACNET_STATUS_ERROR;
+        }
+        len += value_len;
+        value = notification->listOfValues;
+        last_value = NULL;
+        while (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_size - len, 1, &value_len)) {
+            if (!value) {
+                /* out of room to store the next value */
+                return BACNET_STATUS_ERROR;
+            }
+            value_len =
+                cov_notify_multiple_value_decode(&apdu[len], apdu_size - len, value);
+            if (value_len <= 0) {
+                return BACNET_STATUS_ERROR;
+            }
+            len += value_len;
+            last_value = value;
+            value = value->next;
+        }
+        len += value_len;
+        if (last_value) {
+            last_value->next = NULL;
+        } else {
+            notification->listOfValues = NULL;
+        }
+        last_notification = notification;
+        notification = notification->next;
+    }
+    len += value_len;
+    if (last_notification) {
+        last_notification->next = NULL;
+    } else {
+        data->listOfNotifications = NULL;
+    }
+
+    return len;
+}
+
 /** Link an array or buffer of BACNET_PROPERTY_VALUE elements and add them
  * to the BACNET_COV_DATA structure.  It is used prior to encoding or
  * decoding the APDU data into the structure.
@@ -38,6 +38,26 @@ typedef struct BACnet_COV_Data {
     BACNET_PROPERTY_VALUE *listOfValues;
 } BACNET_COV_DATA;
 
+/* COV notification data decoded into compact values */
+typedef struct BACnet_COV_Compact_Data {
+    uint32_t subscriberProcessIdentifier;
+    uint32_t initiatingDeviceIdentifier;
+    BACNET_OBJECT_ID monitoredObjectIdentifier;
+    uint32_t timeRemaining;     /* seconds */
+    /* simple linked list of values */
+    BACNET_PROPERTY_COMPACT_VALUE *listOfValues;
+} BACNET_COV_COMPACT_DATA;
+
+/* called for each value of a COV notification, as it is decoded.
+   The value may point into the APDU.  Return false to stop decoding. */
+typedef bool (*cov_notify_value_callback_t)(void *context,
+    uint32_t device_id,
+    BACNET_OBJECT_ID *object_id,
+    BACNET_PROPERTY_ID property,
+    BACNET_ARRAY_INDEX array_index,
+    BACNET_COMPACT_VALUE *value,
+    uint8_t priority);
+
 struct BACnet_Subscribe_COV_Data;
 typedef struct BACnet_Subscribe_COV_Data {
     uint32_t subscriberProcessIdentifier;
@@ -49,11 +69,52 @@ typedef struct BACnet_Subscribe_COV_Data {
     BACNET_PROPERTY_REFERENCE monitoredProperty;
     bool covIncrementPresent;   /* true if present */
     float covIncrement; /* optional */
+    bool timestamped;   /* SubscribeCOVPropertyMultiple only */
     BACNET_ERROR_CLASS error_class;
     BACNET_ERROR_CODE error_code;
     struct BACnet_Subscribe_COV_Data *next;
 } BACNET_SUBSCRIBE_COV_DATA;
 
+/* SubscribeCOVPropertyMultiple: the subscriptions are a list of
+   BACNET_SUBSCRIBE_COV_DATA, using the object, property, increment
+   and timestamped members; consecutive subscriptions of one object
+   are encoded as one COV subscription specification */
+typedef struct BACnet_Subscribe_COV_Multiple_Data {
+    uint32_t subscriberProcessIdentifier;
+    bool cancellationRequest;   /* true if this is a cancellation request */
+    bool issueConfirmedNotifications;   /* optional */
+    uint32_t lifetime;  /* seconds, optional */
+    uint32_t maxNotificationDelay;      /* seconds, optional */
+    BACNET_SUBSCRIBE_COV_DATA *listOfSubscriptions;
+} BACNET_SUBSCRIBE_COV_MULTIPLE_DATA;
+
+/* COV-Notification-Multiple value, with its optional time of change */
+struct BACnet_COV_Multiple_Value;
+typedef struct BACnet_COV_Multiple_Value {
+    BACNET_PROPERTY_ID propertyIdentifier;
+    BACNET_ARRAY_INDEX propertyArrayIndex;
+    BACNET_APPLICATION_DATA_VALUE value;
+    bool timeOfChangePresent;
+    BACNET_TIME timeOfChange;
+    struct BACnet_COV_Multiple_Value *next;
+} BACNET_COV_MULTIPLE_VALUE;
+
+struct BACnet_COV_Multiple_Notification;
+typedef struct BACnet_COV_Multiple_Notification {
+    BACNET_OBJECT_ID monitoredObjectIdentifier;
+    BACNET_COV_MULTIPLE_VALUE *listOfValues;
+    struct BACnet_COV_Multiple_Notification *next;
+} BACNET_COV_MULTIPLE_NOTIFICATION;
+
+typedef struct BACnet_COV_Multiple_Data {
+    uint32_t subscriberProcessIdentifier;
+    uint32_t initiatingDeviceIdentifier;
+    uint32_t timeRemaining;     /* seconds */
+    bool timestampPresent;
+    BACNET_DATE_TIME timestamp; /* optional */
+    BACNET_COV_MULTIPLE_NOTIFICATION *listOfNotifications;
+} BACNET_COV_MULTIPLE_DATA;
+
 /* generic callback for COV notifications */
 typedef void (*BACnet_COV_Notification_Callback)
     (BACNET_COV_DATA *cov_data);
@@ -109,6 +170,19 @@ extern "C" {
         uint8_t * apdu,
         unsigned apdu_len,
         BACNET_COV_DATA * data);
+    BACNET_STACK_EXPORT
+    int cov_notify_decode_compact_service_request(
+        uint8_t * apdu,
+        unsigned apdu_len,
+        BACNET_COV_COMPACT_DATA * data);
+    BACNET_STACK_EXPORT
+    int cov_notify_decode_values(
+        uint8_t * apdu,
+        unsigned apdu_len,
+        uint32_t * subscriber_process_id,
+        uint32_t * time_remaining,
+        cov_notify_value_callback_t callback,
+        void *context);
 
     BACNET_STACK_EXPORT
     int cov_subscribe_property_decode_service_request(
@@ -136,6 +210,82 @@ extern "C" {
         uint8_t invoke_id,
         BACNET_SUBSCRIBE_COV_DATA * data);
 
+    BACNET_STACK_EXPORT
+    int cov_subscribe_multiple_encode_apdu(
+        uint8_t * apdu,
+        unsigned max_apdu_len,
+        uint8_t invoke_id,
+        BACNET_SUBSCRIBE_COV_MULTIPLE_DATA * data);
+    BACNET_STACK_EXPORT
+    int cov_subscribe_multiple_decode_service_request(
+        uint8_t * apdu,
+        unsigned apdu_size,
+        BACNET_SUBSCRIBE_COV_MULTIPLE_DATA * data);
+    BACNET_STACK_EXPORT
+    int cov_subscribe_multiple_decode_object_id(
+        uint8_t * apdu,
+        unsigned apdu_size,
+        BACNET_OBJECT_ID * object_id);
+    BACNET_STACK_EXPORT
+    int cov_subscribe_multiple_decode_reference(
+        uint8_t * apdu,
+        unsigned apdu_size,
+        BACNET_SUBSCRIBE_COV_DATA * data);
+    BACNET_STACK_EXPORT
+    int cov_subscribe_multiple_error_encode_apdu(
+        uint8_t * apdu,
+        uint8_t invoke_id,
+        BACNET_ERROR_CLASS error_class,
+        BACNET_ERROR_CODE error_code,
+        BACNET_SUBSCRIBE_COV_DATA * failed);
+    BACNET_STACK_EXPORT
+    int cov_subscribe_multiple_error_decode_service_request(
+        uint8_t * apdu,
+        unsigned apdu_size,
+        BACNET_ERROR_CLASS * error_class,
+        BACNET_ERROR_CODE * error_code,
+        BACNET_SUBSCRIBE_COV_DATA * failed);
+
+    BACNET_STACK_EXPORT
+    int cov_notify_encode_apdu_init(
+        uint8_t * apdu,
+        bool confirmed,
+        uint8_t invoke_id,
+        BACNET_COV_DATA * data);
+    BACNET_STACK_EXPORT
+    int cov_notify_encode_apdu_end(
+        uint8_t * apdu);
+
+    BACNET_STACK_EXPORT
+    int cov_notify_multiple_encode_apdu_init(
+        uint8_t * apdu,
+        bool confirmed,
+        uint8_t invoke_id,
+        BACNET_COV_MULTIPLE_DATA * data);
+    BACNET_STACK_EXPORT
+    int cov_notify_multiple_encode_apdu_object_begin(
+        uint8_t * apdu,
+        BACNET_OBJECT_ID * object_id);
+    BACNET_STACK_EXPORT
+    int cov_notify_multiple_encode_apdu_property(
+        uint8_t * apdu,
+        BACNET_PROPERTY_ID object_property,
+        BACNET_ARRAY_INDEX array_index,
+        uint8_t * application_data,
+        unsigned application_data_len,
+        BACNET_TIME * time_of_change);
+    BACNET_STACK_EXPORT
+    int cov_notify_multiple_encode_apdu_object_end(
+        uint8_t * apdu);
+    BACNET_STACK_EXPORT
+    int cov_notify_multiple_encode_apdu_end(
+        uint8_t * apdu);
+    BACNET_STACK_EXPORT
+    int cov_notify_multiple_decode_service_request(
+        uint8_t * apdu,
+        unsigned apdu_size,
+        BACNET_COV_MULTIPLE_DATA * data);
+
     BACNET_STACK_EXPORT
     void cov_data_value_list_link(
         BACNET_COV_DATA *data,
@@ -94,6 +94,19 @@ extern "C" {
         uint8_t * mtu,
         uint16_t mtu_len);
     BACNET_STACK_EXPORT
+    int bip6_send_mpdu_list(
+        BACNET_IP6_ADDRESS *addr_list,
+        unsigned addr_count,
+        uint8_t * mtu,
+        uint16_t mtu_len);
+    /* ports that batch the receive system calls */
+    BACNET_STACK_EXPORT
+    void bip6_set_receive_batch(
+        unsigned count);
+    BACNET_STACK_EXPORT
+    int bip6_get_socket(
+        void);
+    BACNET_STACK_EXPORT
     bool bip6_send_pdu_queue_empty(
         void);
     BACNET_STACK_EXPORT
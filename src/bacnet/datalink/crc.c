@@ -140,3 +140,49 @@ uint16_t CRC_Calc_Data(uint8_t dataValue, uint16_t crcValue)
         (crcLow >> 4) ^ (crcLow & 0x0f) ^ ((crcLow & 0x0f) << 7);
 }
 #endif
+
+/**
+ * @brief Accumulate a block of octets into the MS/TP header CRC
+ * @param buffer - octets to accumulate
+ * @param length - number of octets
+ * @param crcValue - CRC accumulated so far
+ * @return updated CRC
+ */
+uint8_t CRC_Calc_Header_Block(
+    const uint8_t *buffer, size_t length, uint8_t crcValue)
+{
+    while (length) {
+#if defined(CRC_USE_TABLE)
+        crcValue = HeaderCRC[crcValue ^ *buffer];
+#else
+        crcValue = CRC_Calc_Header(*buffer, crcValue);
+#endif
+        buffer++;
+        length--;
+    }
+
+    return crcValue;
+}
+
+/**
+ * @brief Accumulate a block of octets into the MS/TP data CRC
+ * @param buffer - octets to accumulate
+ * @param length - number of octets
+ * @param crcValue - CRC accumulated so far
+ * @return updated CRC
+ */
+uint16_t CRC_Calc_Data_Block(
+    const uint8_t *buffer, size_t length, uint16_t crcValue)
+{
+    while (length) {
+#if defined(CRC_USE_TABLE)
+        crcValue = (crcValue >> 8) ^ DataCRC[(crcValue & 0x00FF) ^ *buffer];
+#else
+        crcValue = CRC_Calc_Data(*buffer, crcValue);
+#endif
+        buffer++;
+        length--;
+    }
+
+    return crcValue;
+}
@@ -44,39 +44,90 @@
 #include "bacnet/basic/bbmd6/h_bbmd6.h"
 #include "bacnet/datalink/arcnet.h"
 #include "bacnet/datalink/dlmstp.h"
+#include "bacnet/bacint.h"
+#include "bacnet/npdu.h"
+#include <string.h>
 #include <strings.h> /* for strcasecmp() */
+#if defined(__unix__) || defined(__APPLE__)
+/* wait on the sockets of every datalink port at once */
+#define DATALINK_PORT_SELECT
+#include <sys/select.h>
+#endif
 
-static enum {
+typedef enum {
     DATALINK_NONE = 0,
     DATALINK_ARCNET,
     DATALINK_ETHERNET,
     DATALINK_BIP,
     DATALINK_BIP6,
     DATALINK_MSTP
-} Datalink_Transport;
+} DATALINK_TRANSPORT;
 
-void datalink_set(char *datalink_string)
+static DATALINK_TRANSPORT Datalink_Transport;
+
+/* runtime registry of datalinks that are active at the same time */
+typedef struct datalink_port {
+    DATALINK_TRANSPORT transport;
+    uint16_t network_number;
+    /* descriptors that become readable when a PDU arrives, or -1 */
+    int fd[2];
+} DATALINK_PORT;
+static DATALINK_PORT Datalink_Port[DATALINK_PORTS_MAX];
+static unsigned Datalink_Port_Count;
+/* port where the most recent PDU was received */
+static unsigned Datalink_Port_Active;
+/* port that is polled first, to be fair to a busy port neighbor */
+static unsigned Datalink_Port_Next;
+/* remote networks learned from the SNET of received PDUs */
+typedef struct datalink_route {
+    uint16_t network_number;
+    unsigned port;
+    /* datalink address of the next router to the network */
+    BACNET_ADDRESS router;
+} DATALINK_ROUTE;
+static DATALINK_ROUTE Datalink_Route[DATALINK_ROUTES_MAX];
+static unsigned Datalink_Route_Count;
+/* route that is replaced when the table is full */
+static unsigned Datalink_Route_Next;
+/* PDU that is forwarded or re-encoded between the ports */
+static uint8_t Datalink_Port_PDU[MAX_PDU];
+
+static bool datalink_transport_from_string(
+    char *datalink_string, DATALINK_TRANSPORT *transport)
 {
-    if (strcasecmp("bip", datalink_string) == 0) {
-        Datalink_Transport = DATALINK_BIP;
+    bool status = true;
+
+    if (!datalink_string) {
+        status = false;
+    } else if (strcasecmp("bip", datalink_string) == 0) {
+        *transport = DATALINK_BIP;
     } else if (strcasecmp("bip6", datalink_string) == 0) {
-        Datalink_Transport = DATALINK_BIP6;
+        *transport = DATALINK_BIP6;
     } else if (strcasecmp("ethernet", datalink_string) == 0) {
-        Datalink_Transport = DATALINK_ETHERNET;
+        *transport = DATALINK_ETHERNET;
     } else if (strcasecmp("arcnet", datalink_string) == 0) {
-        Datalink_Transport = DATALINK_ARCNET;
+        *transport = DATALINK_ARCNET;
     } else if (strcasecmp("mstp", datalink_string) == 0) {
-        Datalink_Transport = DATALINK_MSTP;
+        *transport = DATALINK_MSTP;
     } else if (strcasecmp("none", datalink_string) == 0) {
-        Datalink_Transport = DATALINK_NONE;
+        *transport = DATALINK_NONE;
+    } else {
+        status = false;
     }
+
+    return status;
 }
 
-bool datalink_init(char *ifname)
+void datalink_set(char *datalink_string)
+{
+    (void)datalink_transport_from_string(datalink_string, &Datalink_Transport);
+}
+
+static bool datalink_transport_init(DATALINK_TRANSPORT transport, char *ifname)
 {
     bool status = false;
 
-    switch (Datalink_Transport) {
+    switch (transport) {
         case DATALINK_NONE:
             status = true;
             break;
@@ -102,14 +153,15 @@ bool datalink_init(char *ifname)
     return status;
 }
 
-int datalink_send_pdu(BACNET_ADDRESS *dest,
+static int datalink_transport_send_pdu(DATALINK_TRANSPORT transport,
+    BACNET_ADDRESS *dest,
     BACNET_NPDU_DATA *npdu_data,
     uint8_t *pdu,
     unsigned pdu_len)
 {
     int bytes = 0;
 
-    switch (Datalink_Transport) {
+    switch (transport) {
         case DATALINK_NONE:
             bytes = pdu_len;
             break;
@@ -135,12 +187,15 @@ int datalink_send_pdu(BACNET_ADDRESS *dest,
     return bytes;
 }
 
-uint16_t datalink_receive(
-    BACNET_ADDRESS *src, uint8_t *pdu, uint16_t max_pdu, unsigned timeout)
+static uint16_t datalink_transport_receive(DATALINK_TRANSPORT transport,
+    BACNET_ADDRESS *src,
+    uint8_t *pdu,
+    uint16_t max_pdu,
+    unsigned timeout)
 {
     uint16_t bytes = 0;
 
-    switch (Datalink_Transport) {
+    switch (transport) {
         case DATALINK_NONE:
             break;
         case DATALINK_ARCNET:
@@ -165,9 +220,9 @@ uint16_t datalink_receive(
     return bytes;
 }
 
-void datalink_cleanup(void)
+static void datalink_transport_cleanup(DATALINK_TRANSPORT transport)
 {
-    switch (Datalink_Transport) {
+    switch (transport) {
         case DATALINK_NONE:
             break;
         case DATALINK_ARCNET:
@@ -190,9 +245,10 @@ void datalink_cleanup(void)
     }
 }
 
-void datalink_get_broadcast_address(BACNET_ADDRESS *dest)
+static void datalink_transport_get_broadcast_address(
+    DATALINK_TRANSPORT transport, BACNET_ADDRESS *dest)
 {
-    switch (Datalink_Transport) {
+    switch (transport) {
         case DATALINK_NONE:
             break;
         case DATALINK_ARCNET:
@@ -215,9 +271,10 @@ void datalink_get_broadcast_address(BACNET_ADDRESS *dest)
     }
 }
 
-void datalink_get_my_address(BACNET_ADDRESS *my_address)
+static void datalink_transport_get_my_address(
+    DATALINK_TRANSPORT transport, BACNET_ADDRESS *my_address)
 {
-    switch (Datalink_Transport) {
+    switch (transport) {
         case DATALINK_NONE:
             break;
         case DATALINK_ARCNET:
@@ -240,53 +297,858 @@ void datalink_get_my_address(BACNET_ADDRESS *my_address)
     }
 }
 
-void datalink_set_interface(char *ifname)
+static void datalink_transport_maintenance_timer(
+    DATALINK_TRANSPORT transport, uint16_t seconds)
 {
-    switch (Datalink_Transport) {
+    switch (transport) {
         case DATALINK_NONE:
-            (void)ifname;
             break;
         case DATALINK_ARCNET:
-            (void)ifname;
             break;
         case DATALINK_ETHERNET:
-            (void)ifname;
             break;
         case DATALINK_BIP:
-            (void)ifname;
+            bvlc_maintenance_timer(seconds);
             break;
         case DATALINK_BIP6:
-            (void)ifname;
+            bvlc6_maintenance_timer(seconds);
             break;
         case DATALINK_MSTP:
-            (void)ifname;
             break;
         default:
             break;
     }
 }
 
-void datalink_maintenance_timer(uint16_t seconds)
+static void datalink_transport_descriptors(
+    DATALINK_TRANSPORT transport, int fd[2])
 {
-    switch (Datalink_Transport) {
-        case DATALINK_NONE:
+    fd[0] = -1;
+    fd[1] = -1;
+    switch (transport) {
+        case DATALINK_BIP:
+            fd[0] = bip_get_socket();
+            fd[1] = bip_get_broadcast_socket();
             break;
-        case DATALINK_ARCNET:
+        case DATALINK_BIP6:
+            fd[0] = bip6_get_socket();
             break;
-        case DATALINK_ETHERNET:
+        default:
             break;
-        case DATALINK_BIP:
-            bvlc_maintenance_timer(seconds);
+    }
+    if (fd[1] == fd[0]) {
+        fd[1] = -1;
+    }
+}
+
+/**
+ * @brief Initialize a datalink and add it to the set of active datalinks.
+ *  Each datalink driver is a single instance, so a datalink type
+ *  can only be added once.  The first port added is the home network
+ *  of this device.
+ * @param datalink_string - "bip", "bip6", "mstp", "ethernet", or "arcnet"
+ * @param ifname - interface name passed to the datalink init function
+ * @param network_number - BACnet network number of this port, 1..65534
+ * @return true if the datalink was initialized and added
+ */
+bool datalink_port_add(
+    char *datalink_string, char *ifname, uint16_t network_number)
+{
+    DATALINK_TRANSPORT transport = DATALINK_NONE;
+    DATALINK_PORT *port;
+    unsigned i;
+
+    if (Datalink_Port_Count >= DATALINK_PORTS_MAX) {
+        return false;
+    }
+    if ((network_number == 0) || (network_number == BACNET_BROADCAST_NETWORK)) {
+        return false;
+    }
+    if (!datalink_transport_from_string(datalink_string, &transport) ||
+        (transport == DATALINK_NONE)) {
+        return false;
+    }
+    for (i = 0; i < Datalink_Port_Count; i++) {
+        if ((Datalink_Port[i].transport == transport) ||
+            (Datalink_Port[i].network_number == network_number)) {
+            return false;
+        }
+    }
+    if (!datalink_transport_init(transport, ifname)) {
+        return false;
+    }
+    port = &Datalink_Port[Datalink_Port_Count];
+    port->transport = transport;
+    port->network_number = network_number;
+    datalink_transport_descriptors(transport, port->fd);
+    Datalink_Port_Count++;
+
+    return true;
+}
+
+/**
+ * @brief Number of datalinks that were added with datalink_port_add()
+ * @return number of active datalink ports
+ */
+unsigned datalink_port_count(void)
+{
+    return Datalink_Port_Count;
+}
+
+/**
+ * @brief Get the network number of a datalink port
+ * @param port - port index, 0..datalink_port_count()-1
+ * @return network number, or 0 if the port is not valid
+ */
+uint16_t datalink_port_network(unsigned port)
+{
+    uint16_t network_number = 0;
+
+    if (port < Datalink_Port_Count) {
+        network_number = Datalink_Port[port].network_number;
+    }
+
+    return network_number;
+}
+
+/**
+ * @brief Get the port where the most recent PDU was received
+ * @return port index, 0..datalink_port_count()-1
+ */
+unsigned datalink_port_active(void)
+{
+    return Datalink_Port_Active;
+}
+
+/**
+ * @brief Find the port that is directly connected to a network
+ * @param network_number - BACnet network number
+ * @return port index, or -1 if no port is on that network
+ */
+static int datalink_port_find(uint16_t network_number)
+{
+    unsigned i;
+
+    if (network_number == 0) {
+        return -1;
+    }
+    for (i = 0; i < Datalink_Port_Count; i++) {
+        if (Datalink_Port[i].network_number == network_number) {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+static DATALINK_ROUTE *datalink_route_find(uint16_t network_number)
+{
+    unsigned i;
+
+    for (i = 0; i < Datalink_Route_Count; i++) {
+        if (Datalink_Route[i].network_number == network_number) {
+            return &Datalink_Route[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Remember the port and next router for a remote network,
+ *  replacing the oldest route when the table is full.
+ * @return true if the network was not known before
+ */
+static bool datalink_route_learn(
+    uint16_t network_number, unsigned port, BACNET_ADDRESS *router)
+{
+    DATALINK_ROUTE *route;
+    bool added = false;
+
+    if ((network_number == 0) || (network_number == BACNET_BROADCAST_NETWORK) ||
+        (datalink_port_find(network_number) >= 0)) {
+        return false;
+    }
+    route = datalink_route_find(network_number);
+    if (!route) {
+        if (Datalink_Route_Count < DATALINK_ROUTES_MAX) {
+            route = &Datalink_Route[Datalink_Route_Count];
+            Datalink_Route_Count++;
+        } else {
+            route = &Datalink_Route[Datalink_Route_Next];
+            Datalink_Route_Next =
+                (Datalink_Route_Next + 1) % DATALINK_ROUTES_MAX;
+        }
+        route->network_number = network_number;
+        added = true;
+    }
+    route->port = port;
+    route->router = *router;
+
+    return added;
+}
+
+/**
+ * @brief Forget the route to a remote network
+ */
+static void datalink_route_forget(DATALINK_ROUTE *route)
+{
+    Datalink_Route_Count--;
+    *route = Datalink_Route[Datalink_Route_Count];
+    if (Datalink_Route_Next >= Datalink_Route_Count) {
+        Datalink_Route_Next = 0;
+    }
+}
+
+/**
+ * @brief Get the datalink address on a port for a DADR,
+ *  where an empty DADR is the broadcast address of the port.
+ */
+static void datalink_port_local_address(
+    unsigned port, BACNET_ADDRESS *dest, uint8_t len, uint8_t *adr)
+{
+    memset(dest, 0, sizeof(BACNET_ADDRESS));
+    if (len == 0) {
+        datalink_transport_get_broadcast_address(
+            Datalink_Port[port].transport, dest);
+    } else {
+        if (len > MAX_MAC_LEN) {
+            len = MAX_MAC_LEN;
+        }
+        dest->mac_len = len;
+        memcpy(dest->mac, adr, len);
+    }
+}
+
+/**
+ * @brief Encode a new NPCI in front of an APDU and send it on a port
+ * @param port - port index
+ * @param mac - datalink destination on the port
+ * @param dnet - remote destination, or NULL for a local message
+ * @param snet - original source, or NULL for a message from this device
+ * @param npdu_data - network information of the message
+ * @param apdu - the APDU or network layer message that follows the NPCI
+ * @param apdu_len - number of bytes in the APDU
+ * @return number of bytes sent, or <= 0 on error
+ */
+static int datalink_port_forward(unsigned port,
+    BACNET_ADDRESS *mac,
+    BACNET_ADDRESS *dnet,
+    BACNET_ADDRESS *snet,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *apdu,
+    uint16_t apdu_len)
+{
+    int len;
+
+    len = npdu_encode_pdu(&Datalink_Port_PDU[0], dnet, snet, npdu_data);
+    if ((len <= 0) ||
+        ((unsigned)(len + apdu_len) > sizeof(Datalink_Port_PDU))) {
+        return -1;
+    }
+    memmove(&Datalink_Port_PDU[len], apdu, apdu_len);
+
+    return datalink_port_send_pdu(
+        port, mac, npdu_data, &Datalink_Port_PDU[0], len + apdu_len);
+}
+
+/**
+ * @brief Broadcast a network layer message on every port but one
+ * @param port - port index where the message is not sent
+ * @param snet - original source, or NULL for a message from this device
+ * @param npdu_data - network information of the message
+ * @param msg - the message that follows the NPCI
+ * @param msg_len - number of bytes in the message
+ */
+static void datalink_port_broadcast_others(unsigned port,
+    BACNET_ADDRESS *snet,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *msg,
+    uint16_t msg_len)
+{
+    BACNET_ADDRESS mac = { 0 };
+    unsigned i;
+
+    for (i = 0; i < Datalink_Port_Count; i++) {
+        if (i != port) {
+            datalink_port_local_address(i, &mac, 0, NULL);
+            datalink_port_forward(i, &mac, NULL, snet, npdu_data, msg, msg_len);
+        }
+    }
+}
+
+/**
+ * @brief Broadcast an I-Am-Router-To-Network on a port with the networks
+ *  that are reached through the other ports
+ * @param port - port index where the networks are announced
+ * @param network_number - the one network to announce, or 0 for all
+ */
+static void datalink_port_i_am_router(unsigned port, uint16_t network_number)
+{
+    uint8_t msg[2 * (DATALINK_PORTS_MAX + DATALINK_ROUTES_MAX)];
+    BACNET_ADDRESS mac = { 0 };
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    uint16_t msg_len = 0;
+    uint16_t net;
+    unsigned i;
+
+    for (i = 0; i < Datalink_Port_Count; i++) {
+        net = Datalink_Port[i].network_number;
+        if ((i != port) && ((network_number == 0) || (net == network_number))) {
+            msg_len += (uint16_t)encode_unsigned16(&msg[msg_len], net);
+        }
+    }
+    for (i = 0; i < Datalink_Route_Count; i++) {
+        net = Datalink_Route[i].network_number;
+        if ((Datalink_Route[i].port != port) &&
+            ((network_number == 0) || (net == network_number))) {
+            msg_len += (uint16_t)encode_unsigned16(&msg[msg_len], net);
+        }
+    }
+    if (msg_len == 0) {
+        return;
+    }
+    npdu_encode_npdu_network(&npdu_data,
+        NETWORK_MESSAGE_I_AM_ROUTER_TO_NETWORK, false,
+        MESSAGE_PRIORITY_NORMAL);
+    datalink_port_local_address(port, &mac, 0, NULL);
+    datalink_port_forward(port, &mac, NULL, NULL, &npdu_data, msg, msg_len);
+}
+
+/**
+ * @brief Handle a local network layer message as the router between the
+ *  ports: answer Who-Is-Router-To-Network, or ask the other ports for an
+ *  unknown network; learn the networks of I-Am-Router-To-Network and
+ *  announce the new ones on the other ports; and forget a route that the
+ *  next router rejects with Reject-Message-To-Network.
+ * @param port - port index where the message was received
+ * @param src - datalink source address of the message
+ * @param dest - destination of the message, with no DNET or a global DNET
+ * @param snet - source of the message, as it is forwarded
+ * @param npdu_data - network information of the message
+ * @param msg - the message that follows the NPCI
+ * @param msg_len - number of bytes in the message
+ */
+static void datalink_port_network_message(unsigned port,
+    BACNET_ADDRESS *src,
+    BACNET_ADDRESS *dest,
+    BACNET_ADDRESS *snet,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *msg,
+    uint16_t msg_len)
+{
+    uint8_t learned[2 * DATALINK_ROUTES_MAX];
+    uint16_t learned_len = 0;
+    uint16_t network_number = 0;
+    uint16_t offset;
+    DATALINK_ROUTE *route;
+    int q;
+
+    switch (npdu_data->network_message_type) {
+        case NETWORK_MESSAGE_WHO_IS_ROUTER_TO_NETWORK:
+            if (msg_len < 2) {
+                datalink_port_i_am_router(port, 0);
+                break;
+            }
+            (void)decode_unsigned16(&msg[0], &network_number);
+            q = datalink_port_find(network_number);
+            route = datalink_route_find(network_number);
+            if (((q >= 0) && ((unsigned)q != port)) ||
+                (route && (route->port != port))) {
+                datalink_port_i_am_router(port, network_number);
+            } else if ((q < 0) && !route && (dest->net == 0)) {
+                /* a global broadcast already went out the other ports */
+                datalink_port_broadcast_others(
+                    port, snet, npdu_data, msg, msg_len);
+            }
             break;
-        case DATALINK_BIP6:
-            bvlc6_maintenance_timer(seconds);
+        case NETWORK_MESSAGE_I_AM_ROUTER_TO_NETWORK:
+            for (offset = 0; (offset + 2) <= msg_len; offset += 2) {
+                (void)decode_unsigned16(&msg[offset], &network_number);
+                if (datalink_route_learn(network_number, port, src) &&
+                    (learned_len < sizeof(learned))) {
+                    learned_len += (uint16_t)encode_unsigned16(
+                        &learned[learned_len], network_number);
+                }
+            }
+            /* only new networks, so that routers do not echo forever */
+            if ((learned_len > 0) && (dest->net == 0)) {
+                datalink_port_broadcast_others(
+                    port, NULL, npdu_data, learned, learned_len);
+            }
             break;
-        case DATALINK_MSTP:
+        case NETWORK_MESSAGE_REJECT_MESSAGE_TO_NETWORK:
+            if ((msg_len < 3) || (msg[0] != NETWORK_REJECT_NO_ROUTE)) {
+                break;
+            }
+            (void)decode_unsigned16(&msg[1], &network_number);
+            route = datalink_route_find(network_number);
+            if (route && (route->port == port) &&
+                (route->router.mac_len == src->mac_len) &&
+                (memcmp(route->router.mac, src->mac, src->mac_len) == 0)) {
+                datalink_route_forget(route);
+            }
             break;
         default:
             break;
     }
 }
+
+/**
+ * @brief Route a PDU received on a port, as a router between the
+ *  networks of the ports.  PDUs and network layer messages for other
+ *  networks are forwarded, the router network layer messages are
+ *  handled, and PDUs for this device from the other ports gain an SNET
+ *  so that the reply is routed back to the network of the requester.
+ * @param port - port index where the PDU was received
+ * @param src - datalink source address of the PDU
+ * @param pdu - the received PDU, which may be re-encoded
+ * @param pdu_len - number of bytes in the PDU
+ * @param max_pdu - size of the PDU buffer
+ * @return number of bytes in the PDU for this device, or 0 if the
+ *  PDU was forwarded or discarded
+ */
+static uint16_t datalink_port_route(unsigned port,
+    BACNET_ADDRESS *src,
+    uint8_t *pdu,
+    uint16_t pdu_len,
+    uint16_t max_pdu)
+{
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_ADDRESS snet = { 0 };
+    BACNET_ADDRESS mac = { 0 };
+    BACNET_ADDRESS my_address = { 0 };
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    BACNET_NPDU_DATA forward_data = { 0 };
+    DATALINK_ROUTE *route;
+    bool reencode = false;
+    bool deliver = true;
+    int apdu_offset, len, q;
+    uint16_t apdu_len;
+    unsigned i;
+
+    if ((pdu_len < 2) || (pdu[0] != BACNET_PROTOCOL_VERSION)) {
+        return pdu_len;
+    }
+    apdu_offset = bacnet_npdu_decode(pdu, pdu_len, &dest, &snet, &npdu_data);
+    if ((apdu_offset <= 0) || (apdu_offset > pdu_len)) {
+        return pdu_len;
+    }
+    apdu_len = pdu_len - apdu_offset;
+    if (snet.net) {
+        datalink_route_learn(snet.net, port, src);
+    } else {
+        snet.net = Datalink_Port[port].network_number;
+        snet.len = src->mac_len;
+        memcpy(snet.adr, src->mac, sizeof(snet.adr));
+        /* the home network is the local network of this device */
+        reencode = (port != 0);
+    }
+    if (npdu_data.network_layer_message &&
+        ((dest.net == 0) || (dest.net == BACNET_BROADCAST_NETWORK))) {
+        datalink_port_network_message(port, src, &dest, &snet, &npdu_data,
+            &pdu[apdu_offset], apdu_len);
+    }
+    npdu_copy_data(&forward_data, &npdu_data);
+    if (dest.net && (npdu_data.hop_count > 1)) {
+        forward_data.hop_count--;
+        q = datalink_port_find(dest.net);
+        route = datalink_route_find(dest.net);
+        if (dest.net == BACNET_BROADCAST_NETWORK) {
+            for (i = 0; i < Datalink_Port_Count; i++) {
+                if (i != port) {
+                    datalink_port_local_address(i, &mac, 0, NULL);
+                    datalink_port_forward(i, &mac, &dest, &snet,
+                        &forward_data, &pdu[apdu_offset], apdu_len);
+                }
+            }
+        } else if ((q >= 0) && ((unsigned)q != port)) {
+            /* deliver on a directly connected network */
+            deliver = false;
+            if (q == 0) {
+                datalink_transport_get_my_address(
+                    Datalink_Port[0].transport, &my_address);
+                if ((dest.len == 0) ||
+                    ((dest.len == my_address.mac_len) &&
+                        (memcmp(dest.adr, my_address.mac, dest.len) == 0))) {
+                    deliver = true;
+                    reencode = true;
+                }
+            }
+            if (!deliver || (dest.len == 0)) {
+                datalink_port_local_address(
+                    (unsigned)q, &mac, dest.len, dest.adr);
+                datalink_port_forward((unsigned)q, &mac, NULL, &snet,
+                    &forward_data, &pdu[apdu_offset], apdu_len);
+            }
+            dest.net = 0;
+            dest.len = 0;
+        } else if (route && (route->port != port)) {
+            /* pass along to the next router */
+            datalink_port_forward(route->port, &route->router, &dest, &snet,
+                &forward_data, &pdu[apdu_offset], apdu_len);
+            deliver = false;
+        }
+    }
+    if (!deliver) {
+        return 0;
+    }
+    if (reencode) {
+        len = npdu_encode_pdu(&Datalink_Port_PDU[0], &dest, &snet, &npdu_data);
+        if ((len <= 0) || ((len + apdu_len) > max_pdu)) {
+            return 0;
+        }
+        memmove(&pdu[len], &pdu[apdu_offset], apdu_len);
+        memcpy(&pdu[0], &Datalink_Port_PDU[0], len);
+        pdu_len = len + apdu_len;
+    }
+
+    return pdu_len;
+}
+
+/**
+ * @brief Receive from one port without waiting, and route the PDU
+ * @return number of bytes in the PDU for this device, or 0
+ */
+static uint16_t datalink_port_poll(unsigned index,
+    BACNET_ADDRESS *src,
+    uint8_t *pdu,
+    uint16_t max_pdu,
+    unsigned timeout,
+    unsigned *port)
+{
+    uint16_t bytes;
+
+    bytes = datalink_transport_receive(
+        Datalink_Port[index].transport, src, pdu, max_pdu, timeout);
+    if (bytes > 0) {
+        Datalink_Port_Active = index;
+        Datalink_Port_Next = (index + 1) % Datalink_Port_Count;
+        bytes = datalink_port_route(index, src, pdu, bytes, max_pdu);
+        if ((bytes > 0) && port) {
+            *port = index;
+        }
+    }
+
+    return bytes;
+}
+
+#if defined(DATALINK_PORT_SELECT)
+static bool datalink_port_fd_valid(int fd)
+{
+    return (fd >= 0) && (fd < FD_SETSIZE);
+}
+
+/**
+ * @brief Determine if a port has to be polled after a wait
+ * @return true if the port has no descriptor to wait on, or is readable
+ */
+static bool datalink_port_ready(DATALINK_PORT *port, fd_set *ready)
+{
+    unsigned i;
+
+    if (!datalink_port_fd_valid(port->fd[0])) {
+        return true;
+    }
+    for (i = 0; i < 2; i++) {
+        if (datalink_port_fd_valid(port->fd[i]) &&
+            FD_ISSET(port->fd[i], ready)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif
+
+/**
+ * @brief Wait for a PDU from any of the datalink ports.
+ *  Every port is checked once without waiting, starting after the port
+ *  that last received, so that a busy port does not starve the others.
+ *  When no port has data, a single select() waits on the sockets of
+ *  all the ports; ports without a socket are polled every
+ *  DATALINK_PORT_POLL_MS during the wait.
+ *  PDUs for the networks of the other ports are forwarded here, so
+ *  only PDUs for this device are returned.
+ * @param src - source address of the received PDU
+ * @param pdu - buffer for the received PDU
+ * @param max_pdu - size of the PDU buffer
+ * @param timeout - number of milliseconds to wait for a PDU
+ * @param port - port index where the PDU was received, or NULL
+ * @return number of bytes in the PDU, or 0 on timeout
+ */
+uint16_t datalink_port_receive(BACNET_ADDRESS *src,
+    uint8_t *pdu,
+    uint16_t max_pdu,
+    unsigned timeout,
+    unsigned *port)
+{
+    uint16_t bytes = 0;
+    unsigned i, index, first;
+#if defined(DATALINK_PORT_SELECT)
+    unsigned remaining = timeout;
+    unsigned wait, f;
+    bool poll_all = true;
+    bool polled;
+    int max_fd, status;
+    fd_set ready;
+    struct timeval tv;
+#else
+    unsigned slice;
+#endif
+
+    if (Datalink_Port_Count == 0) {
+        return 0;
+    }
+#if defined(DATALINK_PORT_SELECT)
+    FD_ZERO(&ready);
+    for (;;) {
+        first = Datalink_Port_Next;
+        for (i = 0; i < Datalink_Port_Count; i++) {
+            index = (first + i) % Datalink_Port_Count;
+            if (poll_all ||
+                datalink_port_ready(&Datalink_Port[index], &ready)) {
+                bytes = datalink_port_poll(index, src, pdu, max_pdu, 0, port);
+                if (bytes > 0) {
+                    return bytes;
+                }
+            }
+        }
+        if (remaining == 0) {
+            break;
+        }
+        FD_ZERO(&ready);
+        max_fd = -1;
+        polled = false;
+        for (i = 0; i < Datalink_Port_Count; i++) {
+            if (!datalink_port_fd_valid(Datalink_Port[i].fd[0])) {
+                polled = true;
+            }
+            for (f = 0; f < 2; f++) {
+                if (datalink_port_fd_valid(Datalink_Port[i].fd[f])) {
+                    FD_SET(Datalink_Port[i].fd[f], &ready);
+                    if (Datalink_Port[i].fd[f] > max_fd) {
+                        max_fd = Datalink_Port[i].fd[f];
+                    }
+                }
+            }
+        }
+        wait = remaining;
+        if (polled && (wait > DATALINK_PORT_POLL_MS)) {
+            wait = DATALINK_PORT_POLL_MS;
+        }
+        tv.tv_sec = wait / 1000;
+        tv.tv_usec = 1000 * (wait % 1000);
+        status = select(max_fd + 1, &ready, NULL, NULL, &tv);
+        if (status < 0) {
+            break;
+        }
+        poll_all = false;
+        if (status == 0) {
+            FD_ZERO(&ready);
+            remaining -= wait;
+        } else {
+            /* one pass over the readable ports */
+            remaining = 0;
+        }
+    }
+#else
+    first = Datalink_Port_Next;
+    for (i = 0; i < Datalink_Port_Count; i++) {
+        index = (first + i) % Datalink_Port_Count;
+        bytes = datalink_port_poll(index, src, pdu, max_pdu, 0, port);
+        if (bytes > 0) {
+            return bytes;
+        }
+    }
+    if (timeout > 0) {
+        slice = timeout / Datalink_Port_Count;
+        if (slice == 0) {
+            slice = 1;
+        }
+        first = Datalink_Port_Next;
+        for (i = 0; i < Datalink_Port_Count; i++) {
+            index = (first + i) % Datalink_Port_Count;
+            bytes =
+                datalink_port_poll(index, src, pdu, max_pdu, slice, port);
+            if (bytes > 0) {
+                return bytes;
+            }
+        }
+    }
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Send a PDU on one of the datalink ports
+ * @param port - port index, 0..datalink_port_count()-1
+ * @param dest - destination address on the port network
+ * @param npdu_data - network information
+ * @param pdu - PDU to send
+ * @param pdu_len - number of bytes in the PDU
+ * @return number of bytes sent, or <= 0 on error
+ */
+int datalink_port_send_pdu(unsigned port,
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    int bytes = -1;
+
+    if (port < Datalink_Port_Count) {
+        bytes = datalink_transport_send_pdu(
+            Datalink_Port[port].transport, dest, npdu_data, pdu, pdu_len);
+    }
+
+    return bytes;
+}
+
+bool datalink_init(char *ifname)
+{
+    return datalink_transport_init(Datalink_Transport, ifname);
+}
+
+/**
+ * @brief Send a PDU. When datalink ports are registered, the port is
+ *  chosen by the destination network: global broadcasts go out every
+ *  port, a network of a port goes out that port as a local message,
+ *  a learned remote network goes out the port of its router, and
+ *  everything else goes out the home network port.
+ */
+int datalink_send_pdu(BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    BACNET_ADDRESS npdu_dest = { 0 };
+    BACNET_ADDRESS npdu_src = { 0 };
+    BACNET_ADDRESS mac = { 0 };
+    BACNET_NPDU_DATA decoded_data = { 0 };
+    DATALINK_ROUTE *route;
+    int bytes = 0;
+    int port_bytes = 0;
+    int apdu_offset = 0;
+    int q;
+    unsigned i;
+
+    if (Datalink_Port_Count == 0) {
+        return datalink_transport_send_pdu(
+            Datalink_Transport, dest, npdu_data, pdu, pdu_len);
+    }
+    if (!dest || (dest->net == 0)) {
+        return datalink_port_send_pdu(0, dest, npdu_data, pdu, pdu_len);
+    }
+    if (dest->net == BACNET_BROADCAST_NETWORK) {
+        for (i = 0; i < Datalink_Port_Count; i++) {
+            port_bytes =
+                datalink_port_send_pdu(i, dest, npdu_data, pdu, pdu_len);
+            if (port_bytes > bytes) {
+                bytes = port_bytes;
+            }
+        }
+        return bytes;
+    }
+    q = datalink_port_find(dest->net);
+    if (q >= 0) {
+        /* the network is directly connected: remove the DNET */
+        if ((pdu_len > 0) && (pdu[0] == BACNET_PROTOCOL_VERSION)) {
+            apdu_offset = bacnet_npdu_decode(
+                pdu, pdu_len, &npdu_dest, &npdu_src, &decoded_data);
+        }
+        if ((apdu_offset <= 0) || ((unsigned)apdu_offset > pdu_len)) {
+            return -1;
+        }
+        datalink_port_local_address(
+            (unsigned)q, &mac, dest->len, &dest->adr[0]);
+        return datalink_port_forward((unsigned)q, &mac, NULL, &npdu_src,
+            &decoded_data, &pdu[apdu_offset],
+            (uint16_t)(pdu_len - apdu_offset));
+    }
+    route = datalink_route_find(dest->net);
+    if (route) {
+        return datalink_port_send_pdu(
+            route->port, &route->router, npdu_data, pdu, pdu_len);
+    }
+
+    return datalink_port_send_pdu(0, dest, npdu_data, pdu, pdu_len);
+}
+
+uint16_t datalink_receive(
+    BACNET_ADDRESS *src, uint8_t *pdu, uint16_t max_pdu, unsigned timeout)
+{
+    if (Datalink_Port_Count > 0) {
+        return datalink_port_receive(src, pdu, max_pdu, timeout, NULL);
+    }
+
+    return datalink_transport_receive(
+        Datalink_Transport, src, pdu, max_pdu, timeout);
+}
+
+void datalink_cleanup(void)
+{
+    unsigned i;
+
+    if (Datalink_Port_Count == 0) {
+        datalink_transport_cleanup(Datalink_Transport);
+    }
+    for (i = 0; i < Datalink_Port_Count; i++) {
+        datalink_transport_cleanup(Datalink_Port[i].transport);
+    }
+    Datalink_Port_Count = 0;
+    Datalink_Port_Active = 0;
+    Datalink_Port_Next = 0;
+    Datalink_Route_Count = 0;
+    Datalink_Route_Next = 0;
+}
+
+/**
+ * @brief Get the broadcast address, which is on the home network port
+ *  when datalink ports are registered
+ */
+void datalink_get_broadcast_address(BACNET_ADDRESS *dest)
+{
+    if (Datalink_Port_Count > 0) {
+        datalink_transport_get_broadcast_address(
+            Datalink_Port[0].transport, dest);
+    } else {
+        datalink_transport_get_broadcast_address(Datalink_Transport, dest);
+    }
+}
+
+/**
+ * @brief Get the address of this device, which is on the home network
+ *  port when datalink ports are registered
+ */
+void datalink_get_my_address(BACNET_ADDRESS *my_address)
+{
+    if (Datalink_Port_Count > 0) {
+        datalink_transport_get_my_address(
+            Datalink_Port[0].transport, my_address);
+    } else {
+        datalink_transport_get_my_address(Datalink_Transport, my_address);
+    }
+}
+
+void datalink_set_interface(char *ifname)
+{
+    (void)ifname;
+}
+
+void datalink_maintenance_timer(uint16_t seconds)
+{
+    unsigned i;
+
+    if (Datalink_Port_Count == 0) {
+        datalink_transport_maintenance_timer(Datalink_Transport, seconds);
+    }
+    for (i = 0; i < Datalink_Port_Count; i++) {
+        datalink_transport_maintenance_timer(
+            Datalink_Port[i].transport, seconds);
+    }
+}
 #endif
 
 #if defined(BACDL_NONE)
@@ -105,6 +105,18 @@ void routed_get_my_address(
 #define datalink_get_my_address bip6_get_my_address
 #define datalink_maintenance_timer(s) bvlc6_maintenance_timer(s)
 
+#elif defined(BACDL_LOOPBACK)
+#include "bacnet/datalink/loopback.h"
+#define MAX_MPDU LOOPBACK_MPDU_MAX
+
+#define datalink_init loopback_init
+#define datalink_send_pdu loopback_send_pdu
+#define datalink_receive loopback_receive
+#define datalink_cleanup loopback_cleanup
+#define datalink_get_broadcast_address loopback_get_broadcast_address
+#define datalink_get_my_address loopback_get_my_address
+#define datalink_maintenance_timer(s)
+
 #elif defined(BACDL_ALL) || defined(BACDL_NONE) || defined(BACDL_CUSTOM)
 #include "bacnet/npdu.h"
 
@@ -155,6 +167,55 @@ extern "C" {
     BACNET_STACK_EXPORT
     void datalink_maintenance_timer(uint16_t seconds);
 
+#if defined(BACDL_ALL)
+/* number of datalinks that can be active at the same time */
+#ifndef DATALINK_PORTS_MAX
+#define DATALINK_PORTS_MAX 4
+#endif
+/* number of remote networks that are learned behind the ports */
+#ifndef DATALINK_ROUTES_MAX
+#define DATALINK_ROUTES_MAX 16
+#endif
+/* milliseconds between polls of ports that have no socket to wait on */
+#ifndef DATALINK_PORT_POLL_MS
+#define DATALINK_PORT_POLL_MS 5
+#endif
+
+    BACNET_STACK_EXPORT
+    bool datalink_port_add(
+        char *datalink_string,
+        char *ifname,
+        uint16_t network_number);
+
+    BACNET_STACK_EXPORT
+    unsigned datalink_port_count(
+        void);
+
+    BACNET_STACK_EXPORT
+    uint16_t datalink_port_network(
+        unsigned port);
+
+    BACNET_STACK_EXPORT
+    unsigned datalink_port_active(
+        void);
+
+    BACNET_STACK_EXPORT
+    uint16_t datalink_port_receive(
+        BACNET_ADDRESS * src,
+        uint8_t * pdu,
+        uint16_t max_pdu,
+        unsigned timeout,
+        unsigned *port);
+
+    BACNET_STACK_EXPORT
+    int datalink_port_send_pdu(
+        unsigned port,
+        BACNET_ADDRESS * dest,
+        BACNET_NPDU_DATA * npdu_data,
+        uint8_t * pdu,
+        unsigned pdu_len);
+#endif
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -180,6 +241,8 @@ extern "C" {
  * - BACDL_ALL      -- Unspecified for the build, so the transport can be
  *                     chosen at runtime from among these choices.
  * - BACDL_NONE      -- Unspecified for the build for unit testing
+ * - BACDL_LOOPBACK  -- In-process memory queues to a peer, for testing
+ *                     and load generation
  * - BACDL_CUSTOM    -- For externally linked datalink_xxx functions
  * - Clause 10 POINT-TO-POINT (PTP) and Clause 11 EIA/CEA-709.1 ("LonTalk") LAN
  *   are not currently supported by this project.
@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "bacnet/config.h"
 #include "bacnet/bacdef.h"
 #include "bacnet/apdu.h"
@@ -488,6 +489,55 @@ void dlenv_maintenance_timer(uint16_t elapsed_seconds)
 #endif
 }
 
+#if defined(BACDL_ALL)
+/**
+ * @brief Add each datalink from a list of "datalink:network:ifname"
+ *  entries separated by commas, e.g. "bip:1:eth0,mstp:2:/dev/ttyUSB0"
+ * @param ports - list of datalink ports
+ * @return number of datalinks that were added
+ */
+static unsigned dlenv_datalink_ports_init(const char *ports)
+{
+    char entry[80];
+    char *network = NULL;
+    char *ifname = NULL;
+    const char *next = ports;
+    size_t len = 0;
+    unsigned count = 0;
+
+    while (next && *next) {
+        len = strcspn(next, ",");
+        if (len < sizeof(entry)) {
+            memcpy(entry, next, len);
+            entry[len] = 0;
+            network = strchr(entry, ':');
+            if (network) {
+                *network = 0;
+                network++;
+                ifname = strchr(network, ':');
+                if (ifname) {
+                    *ifname = 0;
+                    ifname++;
+                }
+                if (datalink_port_add(entry, ifname,
+                        (uint16_t)strtol(network, NULL, 0))) {
+                    count++;
+                } else {
+                    fprintf(stderr, "Failed to add datalink %s:%s\n", entry,
+                        network);
+                }
+            }
+        }
+        next += len;
+        if (*next == ',') {
+            next++;
+        }
+    }
+
+    return count;
+}
+#endif
+
 /** Initialize the DataLink configuration from Environment variables,
  * or else to defaults.
  * @ingroup DataLink
@@ -501,6 +551,12 @@ void dlenv_maintenance_timer(uint16_t elapsed_seconds)
  * The Environment Variables, by BACDL_ type, are:
  * - BACDL_ALL: (the general-purpose solution)
  *   - BACNET_DATALINK to set which BACDL_ type we are using.
+ *   - BACNET_DATALINKS to use several datalinks at the same time,
+ *     each with its own network number, as a comma separated list of
+ *     datalink:network:ifname, e.g. "bip:1:eth0,mstp:2:/dev/ttyUSB0".
+ *     The first datalink is the network of this device, and PDUs are
+ *     routed between the networks of the datalinks.
+ *     BACNET_DATALINK and BACNET_IFACE are not used when this is set.
  * - (Any):
  *   - BACNET_APDU_TIMEOUT - set this value in milliseconds to change
  *     the APDU timeout.  APDU Timeout is how much time a client
@@ -651,9 +707,20 @@ void dlenv_init(void)
         apdu_retries_set((uint8_t)strtol(pEnv, NULL, 0));
     }
     /* === Initialize the Datalink Here === */
+#if defined(BACDL_ALL)
+    pEnv = getenv("BACNET_DATALINKS");
+    if (pEnv) {
+        if (dlenv_datalink_ports_init(pEnv) == 0) {
+            exit(1);
+        }
+    } else if (!datalink_init(getenv("BACNET_IFACE"))) {
+        exit(1);
+    }
+#else
     if (!datalink_init(getenv("BACNET_IFACE"))) {
         exit(1);
     }
+#endif
 #if (MAX_TSM_TRANSACTIONS)
     pEnv = getenv("BACNET_INVOKE_ID");
     if (pEnv) {
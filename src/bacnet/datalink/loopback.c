@@ -0,0 +1,266 @@
+/**
+ * @file
+ * @brief In-process loopback datalink backed by memory queues
+ *
+ * The loopback datalink connects this node to a single peer in the same
+ * process, such as a unit test or a load generator.  Packets sent by the
+ * node are queued until the peer takes them with loopback_peer_receive(),
+ * and packets put by the peer with loopback_peer_send() are returned by
+ * loopback_receive().  The queues are not locked, so the node and the
+ * peer must be run from the same thread.
+ *
+ * @date October 2026
+ * @section LICENSE
+ *
+ * Copyright (C) 2026 by the BACnet Stack contributors.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/bacaddr.h"
+#include "bacnet/npdu.h"
+#include "bacnet/basic/sys/ringbuf.h"
+#include "bacnet/datalink/loopback.h"
+
+struct loopback_packet {
+    BACNET_ADDRESS address;
+    uint16_t pdu_len;
+    uint8_t pdu[LOOPBACK_MPDU_MAX];
+};
+
+/* packets from the peer to this node */
+static struct loopback_packet Receive_Buffer[LOOPBACK_QUEUE_SIZE];
+static RING_BUFFER Receive_Queue;
+/* packets from this node to the peer */
+static struct loopback_packet Transmit_Buffer[LOOPBACK_QUEUE_SIZE];
+static RING_BUFFER Transmit_Queue;
+/* MAC address of this node */
+static uint8_t Loopback_MAC = LOOPBACK_MAC_DEFAULT;
+/* packets that did not fit in a queue */
+static unsigned long Loopback_Dropped;
+
+/**
+ * @brief Put a packet into one of the queues
+ * @param queue - queue to put the packet into
+ * @param address - destination or source address of the packet
+ * @param pdu - packet data
+ * @param pdu_len - number of bytes of packet data
+ * @return true if the packet was queued
+ */
+static bool loopback_queue_put(RING_BUFFER *queue,
+    BACNET_ADDRESS *address,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    struct loopback_packet *packet;
+
+    if (pdu_len > LOOPBACK_MPDU_MAX) {
+        return false;
+    }
+    packet = (struct loopback_packet *)Ringbuf_Data_Peek(queue);
+    if (!packet) {
+        Loopback_Dropped++;
+        return false;
+    }
+    if (address) {
+        bacnet_address_copy(&packet->address, address);
+    } else {
+        memset(&packet->address, 0, sizeof(packet->address));
+    }
+    if (pdu_len) {
+        memcpy(packet->pdu, pdu, pdu_len);
+    }
+    packet->pdu_len = (uint16_t)pdu_len;
+
+    return Ringbuf_Data_Put(queue, (volatile uint8_t *)packet);
+}
+
+/**
+ * @brief Take a packet from one of the queues
+ * @param queue - queue to take the packet from
+ * @param address - destination or source address of the packet
+ * @param pdu - buffer for the packet data
+ * @param max_pdu - size of the buffer
+ * @return number of bytes of packet data, or zero if none
+ */
+static uint16_t loopback_queue_get(
+    RING_BUFFER *queue, BACNET_ADDRESS *address, uint8_t *pdu, uint16_t max_pdu)
+{
+    struct loopback_packet *packet;
+    uint16_t pdu_len = 0;
+
+    packet = (struct loopback_packet *)Ringbuf_Peek(queue);
+    if (!packet) {
+        return 0;
+    }
+    if (packet->pdu_len <= max_pdu) {
+        if (address) {
+            bacnet_address_copy(address, &packet->address);
+        }
+        memcpy(pdu, packet->pdu, packet->pdu_len);
+        pdu_len = packet->pdu_len;
+    } else {
+        Loopback_Dropped++;
+    }
+    (void)Ringbuf_Pop(queue, NULL);
+
+    return pdu_len;
+}
+
+/**
+ * @brief Initialize the loopback datalink
+ * @param ifname - optional MAC address of this node, 1..254
+ * @return true if initialized
+ */
+bool loopback_init(char *ifname)
+{
+    long mac = LOOPBACK_MAC_DEFAULT;
+
+    if (ifname) {
+        mac = strtol(ifname, NULL, 0);
+        if ((mac <= 0) || (mac >= LOOPBACK_BROADCAST_ADDRESS)) {
+            return false;
+        }
+    }
+    Loopback_MAC = (uint8_t)mac;
+    Loopback_Dropped = 0;
+    Ringbuf_Init(&Receive_Queue, (volatile uint8_t *)Receive_Buffer,
+        sizeof(struct loopback_packet), LOOPBACK_QUEUE_SIZE);
+    Ringbuf_Init(&Transmit_Queue, (volatile uint8_t *)Transmit_Buffer,
+        sizeof(struct loopback_packet), LOOPBACK_QUEUE_SIZE);
+
+    return true;
+}
+
+/**
+ * @brief Discard the packets in both queues
+ */
+void loopback_cleanup(void)
+{
+    Ringbuf_Init(&Receive_Queue, (volatile uint8_t *)Receive_Buffer,
+        sizeof(struct loopback_packet), LOOPBACK_QUEUE_SIZE);
+    Ringbuf_Init(&Transmit_Queue, (volatile uint8_t *)Transmit_Buffer,
+        sizeof(struct loopback_packet), LOOPBACK_QUEUE_SIZE);
+}
+
+/**
+ * @brief Queue a packet from this node for the peer
+ * @param dest - destination address
+ * @param npdu_data - network information
+ * @param pdu - any data to be sent - may be null
+ * @param pdu_len - number of bytes of data
+ * @return number of bytes sent, or -1 if the queue is full
+ */
+int loopback_send_pdu(BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    (void)npdu_data;
+    if (!loopback_queue_put(&Transmit_Queue, dest, pdu, pdu_len)) {
+        return -1;
+    }
+
+    return (int)pdu_len;
+}
+
+/**
+ * @brief Receive a packet from the peer.  The queue is in memory,
+ *  so there is nothing to wait for.
+ * @param src - source address
+ * @param pdu - PDU data
+ * @param max_pdu - amount of space available in the PDU
+ * @param timeout - not used
+ * @return number of bytes in the PDU, or zero if none
+ */
+uint16_t loopback_receive(
+    BACNET_ADDRESS *src, uint8_t *pdu, uint16_t max_pdu, unsigned timeout)
+{
+    (void)timeout;
+
+    return loopback_queue_get(&Receive_Queue, src, pdu, max_pdu);
+}
+
+/**
+ * @brief Get the address of this node
+ * @param my_address - address of this node
+ */
+void loopback_get_my_address(BACNET_ADDRESS *my_address)
+{
+    if (my_address) {
+        memset(my_address, 0, sizeof(BACNET_ADDRESS));
+        my_address->mac_len = 1;
+        my_address->mac[0] = Loopback_MAC;
+    }
+}
+
+/**
+ * @brief Get the broadcast address of the loopback network
+ * @param dest - broadcast address
+ */
+void loopback_get_broadcast_address(BACNET_ADDRESS *dest)
+{
+    if (dest) {
+        memset(dest, 0, sizeof(BACNET_ADDRESS));
+        dest->mac_len = 1;
+        dest->mac[0] = LOOPBACK_BROADCAST_ADDRESS;
+        dest->net = BACNET_BROADCAST_NETWORK;
+    }
+}
+
+/**
+ * @brief Queue a packet from the peer for this node
+ * @param src - address of the peer
+ * @param pdu - NPDU and APDU of the packet
+ * @param pdu_len - number of bytes in the packet
+ * @return true if the packet was queued
+ */
+bool loopback_peer_send(BACNET_ADDRESS *src, uint8_t *pdu, uint16_t pdu_len)
+{
+    return loopback_queue_put(&Receive_Queue, src, pdu, pdu_len);
+}
+
+/**
+ * @brief Take a packet sent by this node, for the peer
+ * @param dest - destination address given by this node
+ * @param pdu - buffer for the NPDU and APDU of the packet
+ * @param max_pdu - size of the buffer
+ * @return number of bytes in the packet, or zero if none
+ */
+uint16_t loopback_peer_receive(
+    BACNET_ADDRESS *dest, uint8_t *pdu, uint16_t max_pdu)
+{
+    return loopback_queue_get(&Transmit_Queue, dest, pdu, max_pdu);
+}
+
+/**
+ * @brief Number of packets waiting for this node
+ * @return number of packets
+ */
+unsigned loopback_receive_pending(void)
+{
+    return Ringbuf_Count(&Receive_Queue);
+}
+
+/**
+ * @brief Number of packets waiting for the peer
+ * @return number of packets
+ */
+unsigned loopback_peer_receive_pending(void)
+{
+    return Ringbuf_Count(&Transmit_Queue);
+}
+
+/**
+ * @brief Number of packets dropped because a queue was full,
+ *  or a packet did not fit in the receive buffer
+ * @return number of packets dropped since initialized
+ */
+unsigned long loopback_dropped(void)
+{
+    return Loopback_Dropped;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @brief API for an in-process loopback datalink backed by memory queues
+ * @date October 2026
+ * @section LICENSE
+ *
+ * Copyright (C) 2026 by the BACnet Stack contributors.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_LOOPBACK_H
+#define BACNET_LOOPBACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "bacnet/bacnet_stack_exports.h"
+#include "bacnet/bacdef.h"
+#include "bacnet/npdu.h"
+
+/* specific defines for the loopback datalink */
+#define LOOPBACK_MPDU_MAX (MAX_PDU)
+/* default MAC address of this node */
+#define LOOPBACK_MAC_DEFAULT 1
+#define LOOPBACK_BROADCAST_ADDRESS 0xFF
+/* number of packets in each direction; must be a power of two */
+#ifndef LOOPBACK_QUEUE_SIZE
+#define LOOPBACK_QUEUE_SIZE 64
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    BACNET_STACK_EXPORT
+    bool loopback_init(
+        char *ifname);
+    BACNET_STACK_EXPORT
+    void loopback_cleanup(
+        void);
+
+    /* packets sent by this node are queued for the peer */
+    BACNET_STACK_EXPORT
+    int loopback_send_pdu(
+        BACNET_ADDRESS * dest,
+        BACNET_NPDU_DATA * npdu_data,
+        uint8_t * pdu,
+        unsigned pdu_len);
+    /* packets sent by the peer are received by this node */
+    BACNET_STACK_EXPORT
+    uint16_t loopback_receive(
+        BACNET_ADDRESS * src,
+        uint8_t * pdu,
+        uint16_t max_pdu,
+        unsigned timeout);
+
+    BACNET_STACK_EXPORT
+    void loopback_get_my_address(
+        BACNET_ADDRESS * my_address);
+    BACNET_STACK_EXPORT
+    void loopback_get_broadcast_address(
+        BACNET_ADDRESS * dest);
+
+    /* the other end of the loopback, usually a test or load generator */
+    BACNET_STACK_EXPORT
+    bool loopback_peer_send(
+        BACNET_ADDRESS * src,
+        uint8_t * pdu,
+        uint16_t pdu_len);
+    BACNET_STACK_EXPORT
+    uint16_t loopback_peer_receive(
+        BACNET_ADDRESS * dest,
+        uint8_t * pdu,
+        uint16_t max_pdu);
+
+    BACNET_STACK_EXPORT
+    unsigned loopback_receive_pending(
+        void);
+    BACNET_STACK_EXPORT
+    unsigned loopback_peer_receive_pending(
+        void);
+    BACNET_STACK_EXPORT
+    unsigned long loopback_dropped(
+        void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
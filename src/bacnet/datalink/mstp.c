@@ -48,6 +48,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #if PRINT_ENABLED
 #include <stdio.h>
 #endif
@@ -337,6 +338,101 @@ void MSTP_Create_And_Send_Frame(
     /* FIXME: be sure to reset SilenceTimer() after each octet is sent! */
 }
 
+/**
+ * @brief Finish the header of a frame after the header CRC octet:
+ *  check the header CRC, and either indicate a frame without data
+ *  or get ready to receive the data of the frame.
+ * @param mstp_port - port that received the header
+ */
+static void MSTP_Receive_Frame_Header_Done(
+    volatile struct mstp_port_struct_t *mstp_port)
+{
+    if (mstp_port->HeaderCRC != 0x55) {
+        /* BadCRC */
+        /* indicate that an error has occurred during
+           the reception of a frame */
+        mstp_port->ReceivedInvalidFrame = true;
+        printf_receive_error(
+            "MSTP: Rx Header: BadCRC [%02X]\n", mstp_port->DataRegister);
+        /* wait for the start of the next frame. */
+        mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+    } else if (mstp_port->DataLength == 0) {
+        /* NoData */
+        printf_receive_data(
+            "%s", mstptext_frame_type((unsigned)mstp_port->FrameType));
+        if ((mstp_port->DestinationAddress == mstp_port->This_Station) ||
+            (mstp_port->DestinationAddress == MSTP_BROADCAST_ADDRESS)) {
+            /* ForUs */
+            /* indicate that a frame with no data has been received */
+            mstp_port->ReceivedValidFrame = true;
+        } else {
+            /* NotForUs */
+            mstp_port->ReceivedValidFrameNotForUs = true;
+        }
+        /* wait for the start of the next frame. */
+        mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+    } else {
+        /* receive the data portion of the frame. */
+        if ((mstp_port->DestinationAddress == mstp_port->This_Station) ||
+            (mstp_port->DestinationAddress == MSTP_BROADCAST_ADDRESS)) {
+            if (mstp_port->DataLength <= mstp_port->InputBufferSize) {
+                /* Data */
+                mstp_port->receive_state = MSTP_RECEIVE_STATE_DATA;
+            } else {
+                /* FrameTooLong */
+                printf_receive_error("MSTP: Rx Header: FrameTooLong %u\n",
+                    (unsigned)mstp_port->DataLength);
+                mstp_port->receive_state = MSTP_RECEIVE_STATE_SKIP_DATA;
+            }
+        } else {
+            /* NotForUs */
+            mstp_port->receive_state = MSTP_RECEIVE_STATE_SKIP_DATA;
+        }
+        mstp_port->Index = 0;
+        mstp_port->DataCRC = 0xFFFF;
+    }
+}
+
+/**
+ * @brief Finish the data of a frame after the last data CRC octet:
+ *  check the data CRC, or decode a COBS frame, and indicate the frame.
+ * @param mstp_port - port that received the data
+ */
+static void MSTP_Receive_Frame_Data_Done(
+    volatile struct mstp_port_struct_t *mstp_port)
+{
+    bool valid_frame = false;
+
+    printf_receive_data(
+        "%s", mstptext_frame_type((unsigned)mstp_port->FrameType));
+    if (((mstp_port->Index + 1) < mstp_port->InputBufferSize) &&
+        (mstp_port->FrameType >= Nmin_COBS_type) &&
+        (mstp_port->FrameType <= Nmax_COBS_type)) {
+        if (cobs_frame_decode(&mstp_port->InputBuffer[mstp_port->Index + 1],
+                mstp_port->InputBufferSize, mstp_port->InputBuffer,
+                mstp_port->Index + 1)) {
+            valid_frame = true;
+        }
+    } else if (mstp_port->DataCRC == 0xF0B8) {
+        /* STATE DATA CRC - no need for new state */
+        valid_frame = true;
+    } else {
+        printf_receive_error(
+            "MSTP: Rx Data: BadCRC [%02X]\n", mstp_port->DataRegister);
+    }
+    if (!valid_frame) {
+        mstp_port->ReceivedInvalidFrame = true;
+    } else if (mstp_port->receive_state == MSTP_RECEIVE_STATE_DATA) {
+        /* ForUs */
+        /* indicate the complete reception of a valid frame */
+        mstp_port->ReceivedValidFrame = true;
+    } else {
+        /* NotForUs */
+        mstp_port->ReceivedValidFrameNotForUs = true;
+    }
+    mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+}
+
 void MSTP_Receive_Frame_FSM(volatile struct mstp_port_struct_t *mstp_port)
 {
     MSTP_RECEIVE_STATE receive_state = mstp_port->receive_state;
@@ -481,63 +577,7 @@ void MSTP_Receive_Frame_FSM(volatile struct mstp_port_struct_t *mstp_port)
                         mstp_port->DataRegister, mstp_port->HeaderCRC);
                     mstp_port->HeaderCRCActual = mstp_port->DataRegister;
                     /* don't wait for next state - do it here */
-                    if (mstp_port->HeaderCRC != 0x55) {
-                        /* BadCRC */
-                        /* indicate that an error has occurred during
-                           the reception of a frame */
-                        mstp_port->ReceivedInvalidFrame = true;
-                        printf_receive_error("MSTP: Rx Header: BadCRC [%02X]\n",
-                            mstp_port->DataRegister);
-                        /* wait for the start of the next frame. */
-                        mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
-                    } else {
-                        if (mstp_port->DataLength == 0) {
-                            /* NoData */
-                            printf_receive_data("%s",
-                                mstptext_frame_type(
-                                    (unsigned)mstp_port->FrameType));
-                            if ((mstp_port->DestinationAddress ==
-                                    mstp_port->This_Station) ||
-                                (mstp_port->DestinationAddress ==
-                                    MSTP_BROADCAST_ADDRESS)) {
-                                /* ForUs */
-                                /* indicate that a frame with no data has been
-                                 * received */
-                                mstp_port->ReceivedValidFrame = true;
-                            } else {
-                                /* NotForUs */
-                                mstp_port->ReceivedValidFrameNotForUs = true;
-                            }
-                            /* wait for the start of the next frame. */
-                            mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
-                        } else {
-                            /* receive the data portion of the frame. */
-                            if ((mstp_port->DestinationAddress ==
-                                    mstp_port->This_Station) ||
-                                (mstp_port->DestinationAddress ==
-                                    MSTP_BROADCAST_ADDRESS)) {
-                                if (mstp_port->DataLength <=
-                                    mstp_port->InputBufferSize) {
-                                    /* Data */
-                                    mstp_port->receive_state =
-                                        MSTP_RECEIVE_STATE_DATA;
-                                } else {
-                                    /* FrameTooLong */
-                                    printf_receive_error(
-                                        "MSTP: Rx Header: FrameTooLong %u\n",
-                                        (unsigned)mstp_port->DataLength);
-                                    mstp_port->receive_state =
-                                        MSTP_RECEIVE_STATE_SKIP_DATA;
-                                }
-                            } else {
-                                /* NotForUs */
-                                mstp_port->receive_state =
-                                    MSTP_RECEIVE_STATE_SKIP_DATA;
-                            }
-                            mstp_port->Index = 0;
-                            mstp_port->DataCRC = 0xFFFF;
-                        }
-                    }
+                    MSTP_Receive_Frame_Header_Done(mstp_port);
                 }
                 /* not per MS/TP standard, but it is a case not covered */
                 else {
@@ -613,46 +653,7 @@ void MSTP_Receive_Frame_FSM(volatile struct mstp_port_struct_t *mstp_port)
                     mstp_port->DataCRC = CRC_Calc_Data(
                         mstp_port->DataRegister, mstp_port->DataCRC);
                     mstp_port->DataCRCActualLSB = mstp_port->DataRegister;
-                    printf_receive_data("%s",
-                        mstptext_frame_type((unsigned)mstp_port->FrameType));
-                    if (((mstp_port->Index+1) < mstp_port->InputBufferSize) &&
-                        (mstp_port->FrameType >= Nmin_COBS_type) &&
-                        (mstp_port->FrameType <= Nmax_COBS_type)) {
-                        if (cobs_frame_decode(
-                                &mstp_port->InputBuffer[mstp_port->Index + 1],
-                                mstp_port->InputBufferSize,
-                                mstp_port->InputBuffer, mstp_port->Index + 1)) {
-                            if (mstp_port->receive_state ==
-                                MSTP_RECEIVE_STATE_DATA) {
-                                /* ForUs */
-                                mstp_port->ReceivedValidFrame = true;
-                            } else {
-                                /* NotForUs */
-                                mstp_port->ReceivedValidFrameNotForUs = true;
-                            }
-                        } else {
-                            mstp_port->ReceivedInvalidFrame = true;
-                        }
-                    } else {
-                        /* STATE DATA CRC - no need for new state */
-                        /* indicate the complete reception of a valid frame */
-                        if (mstp_port->DataCRC == 0xF0B8) {
-                            if (mstp_port->receive_state ==
-                                MSTP_RECEIVE_STATE_DATA) {
-                                /* ForUs */
-                                mstp_port->ReceivedValidFrame = true;
-                            } else {
-                                /* NotForUs */
-                                mstp_port->ReceivedValidFrameNotForUs = true;
-                            }
-                        } else {
-                            mstp_port->ReceivedInvalidFrame = true;
-                            printf_receive_error(
-                                "MSTP: Rx Data: BadCRC [%02X]\n",
-                                mstp_port->DataRegister);
-                        }
-                    }
-                    mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+                    MSTP_Receive_Frame_Data_Done(mstp_port);
                 } else {
                     mstp_port->ReceivedInvalidFrame = true;
                     mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
@@ -674,10 +675,189 @@ void MSTP_Receive_Frame_FSM(volatile struct mstp_port_struct_t *mstp_port)
     return;
 }
 
+/**
+ * @brief Run a block of received octets, such as those returned by one
+ *  read of the UART, through the receive state machine.  The octets are
+ *  taken to have arrived back to back, so the SilenceTimer is checked
+ *  before the block and reset after it.  Preambles are found with a scan,
+ *  and the data and data CRC are accumulated over the block.  Processing
+ *  stops at the end of each frame, valid or not, so that the node state
+ *  machine sees every frame; call again with the rest of the block.
+ * @param mstp_port - port that received the octets
+ * @param buffer - received octets
+ * @param length - number of received octets
+ * @return number of octets taken from the buffer
+ */
+uint16_t MSTP_Receive_Frame_Block(volatile struct mstp_port_struct_t *mstp_port,
+    const uint8_t *buffer,
+    uint16_t length)
+{
+    const uint8_t *preamble = NULL;
+    uint16_t offset = 0;
+    uint16_t count = 0;
+    unsigned events = 0;
+    uint32_t index = 0;
+    uint32_t frame_length = 0;
+    uint8_t octet = 0;
+    bool frame_done = false;
+
+    if (!mstp_port || !buffer) {
+        return 0;
+    }
+    if (mstp_port->ReceivedValidFrame || mstp_port->ReceivedInvalidFrame) {
+        /* wait for the node state machine to take the frame */
+        return 0;
+    }
+    if ((mstp_port->ReceiveError == true) ||
+        ((mstp_port->receive_state != MSTP_RECEIVE_STATE_IDLE) &&
+            (mstp_port->SilenceTimer((void *)mstp_port) > Tframe_abort))) {
+        /* EatAnError or Timeout */
+        mstp_port->DataAvailable = false;
+        MSTP_Receive_Frame_FSM(mstp_port);
+        if (mstp_port->ReceivedInvalidFrame) {
+            return 0;
+        }
+    }
+    while ((offset < length) && !frame_done) {
+        switch (mstp_port->receive_state) {
+            case MSTP_RECEIVE_STATE_IDLE:
+                preamble = memchr(&buffer[offset], 0x55, length - offset);
+                if (preamble) {
+                    /* Preamble1 */
+                    count = (uint16_t)(preamble - &buffer[offset]) + 1;
+                    mstp_port->receive_state = MSTP_RECEIVE_STATE_PREAMBLE;
+                } else {
+                    /* EatAnOctet */
+                    count = length - offset;
+                }
+                offset += count;
+                events += count;
+                break;
+            case MSTP_RECEIVE_STATE_PREAMBLE:
+                octet = buffer[offset];
+                offset++;
+                events++;
+                if (octet == 0xFF) {
+                    /* Preamble2 */
+                    mstp_port->Index = 0;
+                    mstp_port->HeaderCRC = 0xFF;
+                    mstp_port->receive_state = MSTP_RECEIVE_STATE_HEADER;
+                } else if (octet != 0x55) {
+                    /* NotPreamble */
+                    mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+                }
+                break;
+            case MSTP_RECEIVE_STATE_HEADER:
+                octet = buffer[offset];
+                offset++;
+                events++;
+                mstp_port->HeaderCRC =
+                    CRC_Calc_Header(octet, mstp_port->HeaderCRC);
+                switch (mstp_port->Index) {
+                    case 0:
+                        mstp_port->FrameType = octet;
+                        break;
+                    case 1:
+                        mstp_port->DestinationAddress = octet;
+                        break;
+                    case 2:
+                        mstp_port->SourceAddress = octet;
+                        break;
+                    case 3:
+                        mstp_port->DataLength = octet * 256;
+                        break;
+                    case 4:
+                        mstp_port->DataLength += octet;
+                        break;
+                    default:
+                        mstp_port->HeaderCRCActual = octet;
+                        mstp_port->DataRegister = octet;
+                        MSTP_Receive_Frame_Header_Done(mstp_port);
+                        frame_done = (mstp_port->receive_state ==
+                            MSTP_RECEIVE_STATE_IDLE);
+                        break;
+                }
+                if (mstp_port->receive_state == MSTP_RECEIVE_STATE_HEADER) {
+                    mstp_port->Index++;
+                }
+                break;
+            case MSTP_RECEIVE_STATE_DATA:
+            case MSTP_RECEIVE_STATE_SKIP_DATA:
+                /* the data and the two data CRC octets */
+                frame_length = (uint32_t)mstp_port->DataLength + 2;
+                index = mstp_port->Index;
+                count = length - offset;
+                if (count > (frame_length - index)) {
+                    count = (uint16_t)(frame_length - index);
+                }
+                if (index < mstp_port->InputBufferSize) {
+                    if ((index + count) <= mstp_port->InputBufferSize) {
+                        memcpy(&mstp_port->InputBuffer[index],
+                            &buffer[offset], count);
+                    } else {
+                        memcpy(&mstp_port->InputBuffer[index],
+                            &buffer[offset],
+                            mstp_port->InputBufferSize - index);
+                    }
+                }
+                mstp_port->DataCRC = CRC_Calc_Data_Block(
+                    &buffer[offset], count, mstp_port->DataCRC);
+                if ((index <= mstp_port->DataLength) &&
+                    ((index + count) > mstp_port->DataLength)) {
+                    mstp_port->DataCRCActualMSB =
+                        buffer[offset + mstp_port->DataLength - index];
+                }
+                offset += count;
+                index += count;
+                if (index == frame_length) {
+                    /* CRC2 - the index stays on the last octet,
+                       as it does when receiving one octet at a time */
+                    mstp_port->DataCRCActualLSB = buffer[offset - 1];
+                    mstp_port->DataRegister = buffer[offset - 1];
+                    mstp_port->Index = index - 1;
+                    MSTP_Receive_Frame_Data_Done(mstp_port);
+                    frame_done = true;
+                } else {
+                    mstp_port->Index = index;
+                }
+                break;
+            default:
+                /* shouldn't get here - but if we do... */
+                mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+                break;
+        }
+    }
+    if (offset > 0) {
+        mstp_port->DataRegister = buffer[offset - 1];
+        mstp_port->SilenceTimerReset((void *)mstp_port);
+        events += mstp_port->EventCount;
+        mstp_port->EventCount = (events < 0xFF) ? events : 0xFF;
+    }
+
+    return offset;
+}
+
+/**
+ * @brief Get the number of tokens between maintenance Poll For Master
+ *  frames, which is Npoll unless the poll back-off is enabled.
+ * @param mstp_port - port specific data
+ * @return number of tokens
+ */
+static unsigned MSTP_Npoll(volatile struct mstp_port_struct_t *mstp_port)
+{
+    if ((mstp_port->Npoll_max > Npoll) &&
+        (mstp_port->Npoll_interval > Npoll)) {
+        return mstp_port->Npoll_interval;
+    }
+
+    return Npoll;
+}
+
 /* returns true if we need to transition immediately */
 bool MSTP_Master_Node_FSM(volatile struct mstp_port_struct_t *mstp_port)
 {
     unsigned length = 0;
+    unsigned npoll = MSTP_Npoll(mstp_port);
     uint8_t next_poll_station = 0;
     uint8_t next_this_station = 0;
     uint8_t next_next_station = 0;
@@ -702,6 +882,7 @@ bool MSTP_Master_Node_FSM(volatile struct mstp_port_struct_t *mstp_port)
             /* cause a Poll For Master to be sent when this node first */
             /* receives the token */
             mstp_port->TokenCount = Npoll;
+            mstp_port->Npoll_interval = Npoll;
             mstp_port->SoleMaster = false;
             mstp_port->master_state = MSTP_MASTER_STATE_IDLE;
             transition_now = true;
@@ -939,7 +1120,7 @@ bool MSTP_Master_Node_FSM(volatile struct mstp_port_struct_t *mstp_port)
                     mstp_port->This_Station, NULL, 0);
                 mstp_port->RetryCount = 0;
                 mstp_port->master_state = MSTP_MASTER_STATE_POLL_FOR_MASTER;
-            } else if (mstp_port->TokenCount < (Npoll - 1)) {
+            } else if (mstp_port->TokenCount < (npoll - 1)) {
                 /* Npoll changed in Errata SSPC-135-2004 */
                 if ((mstp_port->SoleMaster == true) &&
                     (mstp_port->Next_Station != next_this_station)) {
@@ -988,6 +1169,16 @@ bool MSTP_Master_Node_FSM(volatile struct mstp_port_struct_t *mstp_port)
                 } else {
                     /* ResetMaintenancePFM */
                     mstp_port->Poll_Station = mstp_port->This_Station;
+                    if (mstp_port->Npoll_max > Npoll) {
+                        /* the addresses between TS and NS were polled
+                           without finding a new master, so poll them
+                           less often, up to Npoll_max tokens apart */
+                        npoll = 2 * npoll;
+                        if (npoll > mstp_port->Npoll_max) {
+                            npoll = mstp_port->Npoll_max;
+                        }
+                        mstp_port->Npoll_interval = npoll;
+                    }
                     /* transmit a Token frame to NS */
                     MSTP_Create_And_Send_Frame(mstp_port, FRAME_TYPE_TOKEN,
                         mstp_port->Next_Station, mstp_port->This_Station, NULL,
@@ -1044,6 +1235,7 @@ bool MSTP_Master_Node_FSM(volatile struct mstp_port_struct_t *mstp_port)
                     mstp_port->Next_Station = mstp_port->This_Station;
                     mstp_port->RetryCount = 0;
                     mstp_port->TokenCount = 0;
+                    mstp_port->Npoll_interval = Npoll;
                     /* mstp_port->EventCount = 0; removed in Addendum
                      * 135-2004d-8 */
                     /* find a new successor to TS */
@@ -1086,6 +1278,7 @@ bool MSTP_Master_Node_FSM(volatile struct mstp_port_struct_t *mstp_port)
                     mstp_port->Next_Station = mstp_port->This_Station;
                     mstp_port->RetryCount = 0;
                     mstp_port->TokenCount = 0;
+                    mstp_port->Npoll_interval = Npoll;
                     /* mstp_port->EventCount = 0;
                        removed Addendum 135-2004d-8 */
                     /* enter the POLL_FOR_MASTER state
@@ -1125,6 +1318,7 @@ bool MSTP_Master_Node_FSM(volatile struct mstp_port_struct_t *mstp_port)
                         0);
                     mstp_port->Poll_Station = mstp_port->This_Station;
                     mstp_port->TokenCount = 0;
+                    mstp_port->Npoll_interval = Npoll;
                     mstp_port->RetryCount = 0;
                     mstp_port->master_state = MSTP_MASTER_STATE_PASS_TOKEN;
                 } else {
@@ -1357,5 +1551,6 @@ void MSTP_Init(volatile struct mstp_port_struct_t *mstp_port)
         mstp_port->SoleMaster = false;
         mstp_port->SourceAddress = 0;
         mstp_port->TokenCount = 0;
+        mstp_port->Npoll_interval = Npoll;
     }
 }
@@ -165,6 +165,17 @@ struct mstp_port_struct_t {
     uint8_t *OutputBuffer;
     uint16_t OutputBufferSize;
 
+    /* Optional: the largest number of tokens between maintenance Poll For */
+    /* Master frames. Each time the addresses between This_Station and */
+    /* Next_Station are polled without finding a new master, the number of */
+    /* tokens between polls doubles, from Npoll up to this value. It returns */
+    /* to Npoll when the successor changes. Zero, or a value not greater */
+    /* than Npoll, polls every Npoll tokens as the standard specifies. */
+    unsigned Npoll_max;
+    /* The number of tokens between maintenance Poll For Master frames */
+    /* while backing off. Set by the master node state machine. */
+    unsigned Npoll_interval;
+
     /*Platform-specific port data */
     void *UserData;
 
@@ -182,6 +193,11 @@ extern "C" {
         volatile struct mstp_port_struct_t
         *mstp_port);
     BACNET_STACK_EXPORT
+    uint16_t MSTP_Receive_Frame_Block(
+        volatile struct mstp_port_struct_t *mstp_port,
+        const uint8_t * buffer,
+        uint16_t length);
+    BACNET_STACK_EXPORT
     bool MSTP_Master_Node_FSM(
         volatile struct mstp_port_struct_t
         *mstp_port);
@@ -32,6 +32,7 @@
  -------------------------------------------
 ####COPYRIGHTEND####*/
 #include <assert.h>
+#include <string.h>
 #include "bacnet/event.h"
 #include "bacnet/bacdcode.h"
 #include "bacnet/npdu.h"
@@ -139,6 +140,79 @@ int cevent_notify_encode_apdu(
     return apdu_len;
 }
 
+/**
+ * @brief Encode a Confirmed Event Notification APDU using a service body
+ *  that was already encoded by event_notify_encode_service_body(), so that
+ *  the same event can be sent to many recipients without re-encoding it.
+ * @param apdu - buffer to encode into, or NULL for length
+ * @param invoke_id - invoke ID of this confirmed request
+ * @param process_id - process identifier of the recipient
+ * @param body - encoded event notification body
+ * @param body_len - number of bytes in the encoded body
+ * @return number of bytes encoded
+ */
+int cevent_notify_encode_apdu_body(uint8_t *apdu,
+    uint8_t invoke_id,
+    uint32_t process_id,
+    uint8_t *body,
+    unsigned body_len)
+{
+    int len = 0; /* length of each encoding */
+    int apdu_len = 0; /* total length of the apdu, return value */
+
+    if (apdu) {
+        apdu[0] = PDU_TYPE_CONFIRMED_SERVICE_REQUEST;
+        apdu[1] = encode_max_segs_max_apdu(0, MAX_APDU);
+        apdu[2] = invoke_id;
+        apdu[3] = SERVICE_CONFIRMED_EVENT_NOTIFICATION; /* service choice */
+    }
+    apdu_len = 4;
+    len = encode_context_unsigned(NULL, 0, process_id);
+    if (apdu) {
+        (void)encode_context_unsigned(&apdu[apdu_len], 0, process_id);
+        if (body && body_len) {
+            memmove(&apdu[apdu_len + len], body, body_len);
+        }
+    }
+    apdu_len += len;
+    apdu_len += body_len;
+
+    return apdu_len;
+}
+
+/**
+ * @brief Encode an Unconfirmed Event Notification APDU using a service body
+ *  that was already encoded by event_notify_encode_service_body().
+ * @param apdu - buffer to encode into, or NULL for length
+ * @param process_id - process identifier of the recipient
+ * @param body - encoded event notification body
+ * @param body_len - number of bytes in the encoded body
+ * @return number of bytes encoded
+ */
+int uevent_notify_encode_apdu_body(
+    uint8_t *apdu, uint32_t process_id, uint8_t *body, unsigned body_len)
+{
+    int len = 0; /* length of each encoding */
+    int apdu_len = 0; /* total length of the apdu, return value */
+
+    if (apdu) {
+        apdu[0] = PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST;
+        apdu[1] = SERVICE_UNCONFIRMED_EVENT_NOTIFICATION; /* service choice */
+    }
+    apdu_len = 2;
+    len = encode_context_unsigned(NULL, 0, process_id);
+    if (apdu) {
+        (void)encode_context_unsigned(&apdu[apdu_len], 0, process_id);
+        if (body && body_len) {
+            memmove(&apdu[apdu_len + len], body, body_len);
+        }
+    }
+    apdu_len += len;
+    apdu_len += body_len;
+
+    return apdu_len;
+}
+
 int event_notify_encode_service_request(
     uint8_t *apdu, BACNET_EVENT_NOTIFICATION_DATA *data)
 {
@@ -150,6 +224,27 @@ int event_notify_encode_service_request(
         len = encode_context_unsigned(
             &apdu[apdu_len], 0, data->processIdentifier);
         apdu_len += len;
+        len = event_notify_encode_service_body(&apdu[apdu_len], data);
+        apdu_len += len;
+    }
+
+    return apdu_len;
+}
+
+/**
+ * @brief Encode the part of the Event Notification service request that
+ *  follows the processIdentifier, which is the same for every recipient.
+ * @param apdu - buffer to encode into
+ * @param data - event notification data
+ * @return number of bytes encoded
+ */
+int event_notify_encode_service_body(
+    uint8_t *apdu, BACNET_EVENT_NOTIFICATION_DATA *data)
+{
+    int len = 0; /* length of each encoding */
+    int apdu_len = 0; /* total length of the apdu, return value */
+
+    if (apdu) {
         /* tag 1 - initiatingObjectIdentifier */
         len = encode_context_object_id(&apdu[apdu_len], 1,
             data->initiatingObjectIdentifier.type,
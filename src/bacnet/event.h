@@ -227,6 +227,38 @@ extern "C" {
         uint8_t * apdu,
         BACNET_EVENT_NOTIFICATION_DATA * data);
 
+/***************************************************
+**
+** Encodes the service data part of Event Notification
+** that follows the processIdentifier
+**
+****************************************************/
+    BACNET_STACK_EXPORT
+    int event_notify_encode_service_body(
+        uint8_t * apdu,
+        BACNET_EVENT_NOTIFICATION_DATA * data);
+
+/***************************************************
+**
+** Creates Event Notification APDUs from a service body
+** encoded once for many recipients
+**
+****************************************************/
+    BACNET_STACK_EXPORT
+    int cevent_notify_encode_apdu_body(
+        uint8_t * apdu,
+        uint8_t invoke_id,
+        uint32_t process_id,
+        uint8_t * body,
+        unsigned body_len);
+
+    BACNET_STACK_EXPORT
+    int uevent_notify_encode_apdu_body(
+        uint8_t * apdu,
+        uint32_t process_id,
+        uint8_t * body,
+        unsigned body_len);
+
 /***************************************************
 **
 ** Decodes the service data part of Event Notification
@@ -32,13 +32,15 @@
  -------------------------------------------
 ####COPYRIGHTEND####*/
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include "bacnet/indtext.h"
 
 /** @file indtext.c  Maps text strings and indices of type INDTEXT_DATA */
 
 #if !defined(__BORLANDC__) && !defined(_MSC_VER)
-#include <ctype.h>
 int stricmp(const char *s1, const char *s2)
 {
     unsigned char c1, c2;
@@ -59,6 +61,278 @@ int stricmp(const char *s1, const char *s2)
 #define stricmp _stricmp
 #endif
 
+#if INDTEXT_CACHE_SIZE
+/* The tables of a list are built by the thread that claims its cache
+   entry, and published by setting data_list after a fence, so that the
+   other threads search the list until the tables are complete. */
+#if defined(__GNUC__)
+#define INDTEXT_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define INDTEXT_CLAIM(claim, data_list) \
+    __sync_bool_compare_and_swap((claim), NULL, (data_list))
+#elif defined(_MSC_VER)
+#include <windows.h>
+#define INDTEXT_BARRIER() MemoryBarrier()
+#define INDTEXT_CLAIM(claim, data_list)                                      \
+    (InterlockedCompareExchangePointer((PVOID volatile *)(claim),            \
+         (PVOID)(data_list), NULL) == NULL)
+#else
+/* no atomics: the first lookup in a list must not race another thread */
+#define INDTEXT_BARRIER()
+#define INDTEXT_CLAIM(claim, data_list) \
+    ((*(claim) == NULL) ? ((*(claim) = (data_list)), true) : false)
+#endif
+
+/* lookup tables of a data list, built on the first lookup in the list */
+struct indtext_cache {
+    /* the data list of the tables, set once the tables are built */
+    INDTEXT_DATA *volatile data_list;
+    /* the data list of the thread that builds the tables */
+    INDTEXT_DATA *volatile claim;
+    unsigned count;
+    /* list position + 1 of each text, by hash of the lower case text,
+       or NULL if the lookup tables could not be built */
+    uint16_t *names;
+    unsigned names_mask;
+    /* list position + 1 of the first text of each index from index_min */
+    uint16_t *indexes;
+    unsigned index_min;
+    unsigned index_span;
+    /* list position + 1 of each text with an index past the dense array,
+       such as the proprietary ranges, by hash of the index */
+    uint16_t *outliers;
+    unsigned outliers_mask;
+};
+static struct indtext_cache Indtext_Cache[INDTEXT_CACHE_SIZE];
+
+/**
+ * @brief Hash of a text, ignoring case, so that the case sensitive and the
+ *  case insensitive lookups share the same table (FNV-1a)
+ * @param pString - text to hash
+ * @return hash of the text
+ */
+static uint32_t indtext_hash(const char *pString)
+{
+    uint32_t hash = 2166136261UL;
+
+    while (*pString) {
+        hash ^= (uint32_t)tolower((unsigned char)*pString);
+        hash *= 16777619UL;
+        pString++;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Hash of an index (Fibonacci hashing)
+ * @param index - index to hash
+ * @return hash of the index
+ */
+static uint32_t indtext_index_hash(unsigned index)
+{
+    return ((uint32_t)index * 2654435761UL) >> 8;
+}
+
+/**
+ * @brief Build the lookup tables of a data list
+ * @param cache - cache entry of the data list
+ * @param data_list - list of index and text pairs
+ */
+static void indtext_cache_build(
+    struct indtext_cache *cache, INDTEXT_DATA *data_list)
+{
+    unsigned count, size, i, slot, outliers;
+    unsigned index_min = 0, index_max = 0;
+
+    count = indtext_count(data_list);
+    cache->count = count;
+    if ((count == 0) || (count >= UINT16_MAX)) {
+        return;
+    }
+    /* open addressing, at most half full */
+    size = 8;
+    while (size < (count * 2)) {
+        size *= 2;
+    }
+    cache->names = calloc(size, sizeof(uint16_t));
+    if (!cache->names) {
+        return;
+    }
+    cache->names_mask = size - 1;
+    for (i = 0; i < count; i++) {
+        slot = indtext_hash(data_list[i].pString) & cache->names_mask;
+        while (cache->names[slot]) {
+            slot = (slot + 1) & cache->names_mask;
+        }
+        cache->names[slot] = (uint16_t)(i + 1);
+        if ((i == 0) || (data_list[i].index < index_min)) {
+            index_min = data_list[i].index;
+        }
+        if ((i == 0) || (data_list[i].index > index_max)) {
+            index_max = data_list[i].index;
+        }
+    }
+    /* enumerations are mostly contiguous from the lowest, so a dense
+       array covers them, and the few beyond it are hashed */
+    cache->index_span = (count * 4) + 64;
+    if ((index_max - index_min) < cache->index_span) {
+        cache->index_span = index_max - index_min + 1;
+    }
+    cache->index_min = index_min;
+    cache->indexes = calloc(cache->index_span, sizeof(uint16_t));
+    if (!cache->indexes) {
+        return;
+    }
+    outliers = 0;
+    for (i = count; i > 0; i--) {
+        /* the first text of an index wins, as in the list search */
+        if ((data_list[i - 1].index - index_min) < cache->index_span) {
+            cache->indexes[data_list[i - 1].index - index_min] = (uint16_t)i;
+        } else {
+            outliers++;
+        }
+    }
+    if (outliers) {
+        size = 8;
+        while (size < (outliers * 2)) {
+            size *= 2;
+        }
+        cache->outliers = calloc(size, sizeof(uint16_t));
+        if (!cache->outliers) {
+            free(cache->indexes);
+            cache->indexes = NULL;
+            return;
+        }
+        cache->outliers_mask = size - 1;
+        for (i = 0; i < count; i++) {
+            if ((data_list[i].index - index_min) >= cache->index_span) {
+                slot = indtext_index_hash(data_list[i].index) &
+                    cache->outliers_mask;
+                while (cache->outliers[slot]) {
+                    slot = (slot + 1) & cache->outliers_mask;
+                }
+                cache->outliers[slot] = (uint16_t)(i + 1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Find, or build, the lookup tables of a data list
+ * @param data_list - list of index and text pairs, with static storage
+ *  that is never modified, since the tables are keyed by its address
+ * @return the lookup tables, or NULL to search the list
+ */
+static struct indtext_cache *indtext_cache(INDTEXT_DATA *data_list)
+{
+    struct indtext_cache *cache;
+    INDTEXT_DATA *claim;
+    unsigned slot, i;
+
+    slot = (unsigned)(((uintptr_t)data_list / sizeof(INDTEXT_DATA)) %
+        INDTEXT_CACHE_SIZE);
+    for (i = 0; i < INDTEXT_CACHE_SIZE; i++) {
+        cache = &Indtext_Cache[slot];
+        if (cache->data_list == data_list) {
+            INDTEXT_BARRIER();
+            return cache->names ? cache : NULL;
+        }
+        claim = cache->claim;
+        if ((claim == NULL) && INDTEXT_CLAIM(&cache->claim, data_list)) {
+            indtext_cache_build(cache, data_list);
+            INDTEXT_BARRIER();
+            cache->data_list = data_list;
+            return cache->names ? cache : NULL;
+        }
+        if (cache->claim == data_list) {
+            /* another thread builds the tables */
+            return NULL;
+        }
+        slot = (slot + 1) % INDTEXT_CACHE_SIZE;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Find a text in the lookup tables of a data list
+ * @param cache - lookup tables of the data list
+ * @param search_name - text to find
+ * @param ignore_case - true to ignore the case of the text
+ * @return list position + 1 of the first matching text, or 0 if not found
+ */
+static unsigned indtext_cache_name(
+    struct indtext_cache *cache, const char *search_name, bool ignore_case)
+{
+    unsigned slot, entry, found = 0;
+    const char *pString;
+
+    slot = indtext_hash(search_name) & cache->names_mask;
+    while ((entry = cache->names[slot]) != 0) {
+        if ((found == 0) || (entry < found)) {
+            pString = cache->data_list[entry - 1].pString;
+            if (ignore_case ? (stricmp(pString, search_name) == 0)
+                            : (strcmp(pString, search_name) == 0)) {
+                found = entry;
+            }
+        }
+        slot = (slot + 1) & cache->names_mask;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Find an index in the lookup tables of a data list
+ * @param cache - lookup tables of the data list
+ * @param index - index to find
+ * @return list position + 1 of the first text of the index, or 0
+ */
+static unsigned indtext_cache_index(struct indtext_cache *cache, unsigned index)
+{
+    unsigned slot, entry, found = 0;
+
+    if (index < cache->index_min) {
+        return 0;
+    }
+    if ((index - cache->index_min) < cache->index_span) {
+        return cache->indexes[index - cache->index_min];
+    }
+    if (!cache->outliers) {
+        return 0;
+    }
+    slot = indtext_index_hash(index) & cache->outliers_mask;
+    while ((entry = cache->outliers[slot]) != 0) {
+        if (((found == 0) || (entry < found)) &&
+            (cache->data_list[entry - 1].index == index)) {
+            found = entry;
+        }
+        slot = (slot + 1) & cache->outliers_mask;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Free the lookup tables of the data lists
+ */
+void indtext_cache_cleanup(void)
+{
+    unsigned i;
+
+    for (i = 0; i < INDTEXT_CACHE_SIZE; i++) {
+        free(Indtext_Cache[i].names);
+        free(Indtext_Cache[i].indexes);
+        free(Indtext_Cache[i].outliers);
+    }
+    memset((void *)Indtext_Cache, 0, sizeof(Indtext_Cache));
+}
+#else
+void indtext_cache_cleanup(void)
+{
+}
+#endif
+
 bool indtext_by_string(
     INDTEXT_DATA *data_list, const char *search_name, unsigned *found_index)
 {
@@ -169,6 +443,89 @@ const char *indtext_by_index(INDTEXT_DATA *data_list, unsigned index)
     return indtext_by_index_default(data_list, index, NULL);
 }
 
+bool indtext_by_string_cached(
+    INDTEXT_DATA *data_list, const char *search_name, unsigned *found_index)
+{
+#if INDTEXT_CACHE_SIZE
+    struct indtext_cache *cache;
+    unsigned entry;
+
+    cache = (data_list && search_name) ? indtext_cache(data_list) : NULL;
+    if (cache) {
+        entry = indtext_cache_name(cache, search_name, false);
+        if (entry && found_index) {
+            *found_index = data_list[entry - 1].index;
+        }
+        return entry != 0;
+    }
+#endif
+
+    return indtext_by_string(data_list, search_name, found_index);
+}
+
+bool indtext_by_istring_cached(
+    INDTEXT_DATA *data_list, const char *search_name, unsigned *found_index)
+{
+#if INDTEXT_CACHE_SIZE
+    struct indtext_cache *cache;
+    unsigned entry;
+
+    cache = (data_list && search_name) ? indtext_cache(data_list) : NULL;
+    if (cache) {
+        entry = indtext_cache_name(cache, search_name, true);
+        if (entry && found_index) {
+            *found_index = data_list[entry - 1].index;
+        }
+        return entry != 0;
+    }
+#endif
+
+    return indtext_by_istring(data_list, search_name, found_index);
+}
+
+unsigned indtext_by_istring_default_cached(
+    INDTEXT_DATA *data_list, const char *search_name, unsigned default_index)
+{
+    unsigned index = 0;
+
+    if (!indtext_by_istring_cached(data_list, search_name, &index)) {
+        index = default_index;
+    }
+
+    return index;
+}
+
+const char *indtext_by_index_default_cached(
+    INDTEXT_DATA *data_list, unsigned index, const char *default_string)
+{
+#if INDTEXT_CACHE_SIZE
+    struct indtext_cache *cache;
+    unsigned entry;
+
+    cache = data_list ? indtext_cache(data_list) : NULL;
+    if (cache && cache->indexes) {
+        entry = indtext_cache_index(cache, index);
+        return entry ? data_list[entry - 1].pString : default_string;
+    }
+#endif
+
+    return indtext_by_index_default(data_list, index, default_string);
+}
+
+const char *indtext_by_index_split_default_cached(INDTEXT_DATA *data_list,
+    unsigned index,
+    unsigned split_index,
+    const char *before_split_default_name,
+    const char *default_name)
+{
+    if (index < split_index) {
+        return indtext_by_index_default_cached(
+            data_list, index, before_split_default_name);
+    } else {
+        return indtext_by_index_default_cached(data_list, index, default_name);
+    }
+}
+
 unsigned indtext_count(INDTEXT_DATA *data_list)
 {
     unsigned count = 0; /* return value */
@@ -29,6 +29,15 @@
 #include <string.h>
 #include "bacnet/bacnet_stack_exports.h"
 
+/* number of data lists with lookup tables for the indtext_*_cached
+   functions, built on their first lookup, so that the text and index
+   lookups do not search the list.  The tables need a heap, so the
+   default of 0 always searches the lists; the hosted CMake and Make
+   builds define it. */
+#ifndef INDTEXT_CACHE_SIZE
+#define INDTEXT_CACHE_SIZE 0
+#endif
+
 /* index and text pairs */
 typedef const struct {
     const unsigned index;     /* index number that matches the text */
@@ -93,10 +102,47 @@ extern "C" {
         const char *before_split_default_name,
         const char *default_name);
 
+/* Versions of the lookups above that build lookup tables of the list
+   on its first use, and then use them instead of searching the list.
+   The tables are keyed by the address of the list, so use them only with
+   lists that have static storage and are never modified, such as the
+   constant lists of bactext.c; other lists must use the functions above. */
+    BACNET_STACK_EXPORT
+    bool indtext_by_string_cached(
+        INDTEXT_DATA * data_list,
+        const char *search_name,
+        unsigned *found_index);
+    BACNET_STACK_EXPORT
+    bool indtext_by_istring_cached(
+        INDTEXT_DATA * data_list,
+        const char *search_name,
+        unsigned *found_index);
+    BACNET_STACK_EXPORT
+    unsigned indtext_by_istring_default_cached(
+        INDTEXT_DATA * data_list,
+        const char *search_name,
+        unsigned default_index);
+    BACNET_STACK_EXPORT
+    const char *indtext_by_index_default_cached(
+        INDTEXT_DATA * data_list,
+        unsigned index,
+        const char *default_name);
+    BACNET_STACK_EXPORT
+    const char *indtext_by_index_split_default_cached(
+        INDTEXT_DATA * data_list,
+        unsigned index,
+        unsigned split_index,
+        const char *before_split_default_name,
+        const char *default_name);
+
 /* returns the number of elements in the list */
     BACNET_STACK_EXPORT
     unsigned indtext_count(
         INDTEXT_DATA * data_list);
+/* frees the lookup tables of the data lists */
+    BACNET_STACK_EXPORT
+    void indtext_cache_cleanup(
+        void);
 
 
 #if !defined(__BORLANDC__) && !defined(_MSC_VER)
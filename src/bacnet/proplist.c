@@ -99,20 +99,47 @@ int property_list_encode(BACNET_READ_PROPERTY_DATA *rpdata,
     const int *pListRequired,
     const int *pListOptional,
     const int *pListProprietary)
+{
+    struct special_property_list_t property_list;
+
+    property_list.Required.pList = pListRequired;
+    property_list.Required.count = property_list_count(pListRequired);
+    property_list.Optional.pList = pListOptional;
+    property_list.Optional.count = property_list_count(pListOptional);
+    property_list.Proprietary.pList = pListProprietary;
+    property_list.Proprietary.count = property_list_count(pListProprietary);
+
+    return property_list_special_encode(rpdata, &property_list);
+}
+
+/**
+ * ReadProperty handler for the Property_List property, using the lists
+ * and their counts, for callers that already know the counts.
+ *
+ * @param  rpdata - ReadProperty data, including requested data and
+ * data for the reply, or error response.
+ * @param  pPropertyList - Required, Optional, and Proprietary property
+ * lists of the object, with their counts
+ *
+ * @return number of APDU bytes in the response, or
+ * BACNET_STATUS_ERROR on error.
+ */
+int property_list_special_encode(BACNET_READ_PROPERTY_DATA *rpdata,
+    const struct special_property_list_t *pPropertyList)
 {
     int apdu_len = 0; /* return value */
     uint8_t *apdu = NULL;
     int max_apdu_len = 0;
     uint32_t count = 0;
-    unsigned required_count = 0;
-    unsigned optional_count = 0;
-    unsigned proprietary_count = 0;
+    const int *pListRequired = pPropertyList->Required.pList;
+    const int *pListOptional = pPropertyList->Optional.pList;
+    const int *pListProprietary = pPropertyList->Proprietary.pList;
+    unsigned required_count = pPropertyList->Required.count;
+    unsigned optional_count = pPropertyList->Optional.count;
+    unsigned proprietary_count = pPropertyList->Proprietary.count;
     int len = 0;
     unsigned i = 0; /* loop index */
 
-    required_count = property_list_count(pListRequired);
-    optional_count = property_list_count(pListOptional);
-    proprietary_count = property_list_count(pListProprietary);
     /* total of all counts */
     count = required_count + optional_count + proprietary_count;
     if (required_count >= 3) {
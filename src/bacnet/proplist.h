@@ -61,6 +61,10 @@ extern "C" {
         const int *pListOptional,
         const int *pListProprietary);
     BACNET_STACK_EXPORT
+    int property_list_special_encode(
+        BACNET_READ_PROPERTY_DATA *rpdata,
+        const struct special_property_list_t *pPropertyList);
+    BACNET_STACK_EXPORT
     int property_list_common_encode(
         BACNET_READ_PROPERTY_DATA *rpdata,
         uint32_t device_instance_number);
@@ -32,6 +32,7 @@
  -------------------------------------------
 ####COPYRIGHTEND####*/
 #include <stdint.h>
+#include <string.h>
 #include "bacnet/bacenum.h"
 #include "bacnet/bacerror.h"
 #include "bacnet/bacdcode.h"
@@ -503,27 +504,27 @@ int rpm_ack_decode_object_id(uint8_t *apdu,
     BACNET_OBJECT_TYPE *object_type,
     uint32_t *object_instance)
 {
-    unsigned len = 0;
-    BACNET_OBJECT_TYPE type = OBJECT_NONE; /* for decoding */
+    BACNET_TAG_CURSOR cursor = { 0 };
 
     /* check for value pointers */
     if (apdu && apdu_len && object_type && object_instance) {
+        bacnet_tag_cursor_init(&cursor, apdu, apdu_len);
         /* Tag 0: objectIdentifier */
-        if (!decode_is_context_tag(&apdu[len++], 0)) {
+        if (!bacnet_tag_cursor_is_context(&cursor, 0)) {
             return -1;
         }
-        len += decode_object_id(&apdu[len], &type, object_instance);
-        if (object_type) {
-            *object_type = type;
+        if (bacnet_tag_cursor_object_id_decode(
+                &cursor, object_type, object_instance) <= 0) {
+            return -1;
         }
         /* Tag 1: listOfResults */
-        if (!decode_is_opening_tag_number(&apdu[len], 1)) {
+        if (!bacnet_tag_cursor_is_opening(&cursor, 1)) {
             return -1;
         }
-        len++; /* opening tag is only one octet */
+        bacnet_tag_cursor_next(&cursor);
     }
 
-    return (int)len;
+    return (int)cursor.offset;
 }
 
 /* is this the end of the list of this objects properties values? */
@@ -545,46 +546,145 @@ int rpm_ack_decode_object_property(uint8_t *apdu,
     BACNET_PROPERTY_ID *object_property,
     BACNET_ARRAY_INDEX *array_index)
 {
-    unsigned len = 0;
-    unsigned tag_len = 0;
-    uint8_t tag_number = 0;
-    uint32_t len_value_type = 0;
+    BACNET_TAG_CURSOR cursor = { 0 };
     uint32_t property = 0; /* for decoding */
     BACNET_UNSIGNED_INTEGER unsigned_value = 0; /* for decoding */
 
     /* check for valid pointers */
     if (apdu && apdu_len && object_property && array_index) {
+        bacnet_tag_cursor_init(&cursor, apdu, apdu_len);
         /* Tag 2: propertyIdentifier */
-        if (!IS_CONTEXT_SPECIFIC(apdu[len])) {
+        if (!bacnet_tag_cursor_is_context(&cursor, 2)) {
             return -1;
         }
-        len += decode_tag_number_and_value(
-            &apdu[len], &tag_number, &len_value_type);
-        if (tag_number != 2) {
+        if (bacnet_tag_cursor_enumerated_decode(&cursor, &property) <= 0) {
             return -1;
         }
-        len += decode_enumerated(&apdu[len], len_value_type, &property);
-        if (object_property) {
-            *object_property = (BACNET_PROPERTY_ID)property;
-        }
+        *object_property = (BACNET_PROPERTY_ID)property;
         /* Tag 3: Optional propertyArrayIndex */
-        if ((len < apdu_len) && IS_CONTEXT_SPECIFIC(apdu[len]) &&
-            (!IS_CLOSING_TAG(apdu[len]))) {
-            tag_len = (unsigned)decode_tag_number_and_value(
-                &apdu[len], &tag_number, &len_value_type);
-            if (tag_number == 3) {
-                len += tag_len;
-                len += decode_unsigned(
-                    &apdu[len], len_value_type, &unsigned_value);
-                *array_index = unsigned_value;
-            } else {
-                *array_index = BACNET_ARRAY_ALL;
+        if (bacnet_tag_cursor_is_context(&cursor, 3)) {
+            if (bacnet_tag_cursor_unsigned_decode(&cursor, &unsigned_value) <=
+                0) {
+                return -1;
             }
+            *array_index = unsigned_value;
         } else {
             *array_index = BACNET_ARRAY_ALL;
         }
     }
 
-    return (int)len;
+    return (int)cursor.offset;
+}
+
+/**
+ * @brief Decode a ReadPropertyMultiple-ACK into a flat array of results
+ *  holding compact values.  Values that are not primitive point into
+ *  the APDU buffer, so the buffer must outlive the results.
+ * @param apdu - ReadPropertyMultiple-ACK service data
+ * @param apdu_len - number of bytes of service data
+ * @param results - array of results
+ * @param results_max - number of results in the array
+ * @param results_count - number of results decoded
+ * @return number of bytes decoded, or BACNET_STATUS_ERROR
+ */
+int rpm_ack_decode_compact(uint8_t *apdu,
+    unsigned apdu_len,
+    BACNET_RPM_COMPACT_RESULT *results,
+    unsigned results_max,
+    unsigned *results_count)
+{
+    int len = 0;
+    int tag_len = 0;
+    unsigned decoded_len = 0;
+    unsigned count = 0;
+    BACNET_OBJECT_TYPE object_type = OBJECT_NONE;
+    uint32_t object_instance = 0;
+    uint32_t error_value = 0;
+    BACNET_RPM_COMPACT_RESULT *result;
+
+    if (!apdu || !results || !results_count) {
+        return BACNET_STATUS_ERROR;
+    }
+    while (decoded_len < apdu_len) {
+        len = rpm_ack_decode_object_id(&apdu[decoded_len],
+            apdu_len - decoded_len, &object_type, &object_instance);
+        if (len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        decoded_len += len;
+        while (decoded_len < apdu_len) {
+            if (rpm_ack_decode_object_end(
+                    &apdu[decoded_len], apdu_len - decoded_len)) {
+                decoded_len++;
+                break;
+            }
+            if (count >= results_max) {
+                return BACNET_STATUS_ERROR;
+            }
+            result = &results[count];
+            result->object_type = object_type;
+            result->object_instance = object_instance;
+            len = rpm_ack_decode_object_property(&apdu[decoded_len],
+                apdu_len - decoded_len, &result->object_property,
+                &result->array_index);
+            if (len <= 0) {
+                return BACNET_STATUS_ERROR;
+            }
+            decoded_len += len;
+            if (bacnet_is_opening_tag_number(&apdu[decoded_len],
+                    apdu_len - decoded_len, 4, &tag_len)) {
+                /* propertyValue */
+                len = bacapp_data_len(&apdu[decoded_len],
+                    apdu_len - decoded_len, result->object_property);
+                if (len < 0) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += tag_len;
+                if (bacapp_compact_value_decode(&apdu[decoded_len],
+                        (uint32_t)len, &result->value) < 0) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += len;
+                if (!bacnet_is_closing_tag_number(&apdu[decoded_len],
+                        apdu_len - decoded_len, 4, &tag_len)) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += tag_len;
+                result->error_class = ERROR_CLASS_PROPERTY;
+                result->error_code = ERROR_CODE_SUCCESS;
+            } else if (bacnet_is_opening_tag_number(&apdu[decoded_len],
+                           apdu_len - decoded_len, 5, &tag_len)) {
+                /* propertyAccessError */
+                decoded_len += tag_len;
+                len = bacnet_enumerated_application_decode(
+                    &apdu[decoded_len], apdu_len - decoded_len, &error_value);
+                if (len <= 0) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += len;
+                result->error_class = (BACNET_ERROR_CLASS)error_value;
+                len = bacnet_enumerated_application_decode(
+                    &apdu[decoded_len], apdu_len - decoded_len, &error_value);
+                if (len <= 0) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += len;
+                result->error_code = (BACNET_ERROR_CODE)error_value;
+                if (!bacnet_is_closing_tag_number(&apdu[decoded_len],
+                        apdu_len - decoded_len, 5, &tag_len)) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += tag_len;
+                memset(&result->value, 0, sizeof(result->value));
+                result->value.tag = MAX_BACNET_APPLICATION_TAG;
+            } else {
+                return BACNET_STATUS_ERROR;
+            }
+            count++;
+        }
+    }
+    *results_count = count;
+
+    return (int)decoded_len;
 }
 #endif
@@ -54,6 +54,18 @@ typedef struct BACnet_Read_Access_Data {
     struct BACnet_Read_Access_Data *next;
 } BACNET_READ_ACCESS_DATA;
 
+/* one result of a ReadPropertyMultiple-ACK holding a compact value;
+   error_code is ERROR_CODE_SUCCESS when the value is valid */
+typedef struct BACnet_RPM_Compact_Result {
+    BACNET_OBJECT_TYPE object_type;
+    uint32_t object_instance;
+    BACNET_PROPERTY_ID object_property;
+    BACNET_ARRAY_INDEX array_index;
+    BACNET_COMPACT_VALUE value;
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
+} BACNET_RPM_COMPACT_RESULT;
+
 /** Fetches the lists of properties (array of BACNET_PROPERTY_ID's) for this
  *  object type, grouped by Required, Optional, and Proprietary.
  * A function template; @see device.c for assignment to object types.
@@ -184,6 +196,13 @@ extern "C" {
         unsigned apdu_len,
         BACNET_PROPERTY_ID * object_property,
         BACNET_ARRAY_INDEX * array_index);
+    BACNET_STACK_EXPORT
+    int rpm_ack_decode_compact(
+        uint8_t * apdu,
+        unsigned apdu_len,
+        BACNET_RPM_COMPACT_RESULT * results,
+        unsigned results_max,
+        unsigned *results_count);
 
 #ifdef __cplusplus
 }
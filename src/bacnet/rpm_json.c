@@ -0,0 +1,417 @@
+/**
+ * @file
+ * @date 2026
+ * @brief Stream the results of a ReadPropertyMultiple-ACK as JSON
+ *
+ * The results are decoded one value at a time from the APDU and written
+ * through a callback as they are decoded, so no value lists are allocated
+ * and no document is held in memory.  Each property becomes one member of
+ * a JSON object, named object-type_instance_property[array-index], whose
+ * value is formatted by the rules of bacapp_snprintf_value():
+ *
+ *  - NULL, BOOLEAN, and the numbers are JSON literals and numbers,
+ *    where a REAL or DOUBLE that is not finite becomes null
+ *  - a CHARACTER STRING is a JSON string
+ *  - anything else is a JSON string of its bacapp_snprintf_value() text
+ *  - a property with more than one value, or none, is a JSON array
+ *  - a property access error is an object of its error class and code
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "bacnet/bacdcode.h"
+#include "bacnet/bacapp.h"
+#include "bacnet/bacstr.h"
+#include "bacnet/bactext.h"
+#include "bacnet/rpm.h"
+#include "bacnet/rpm_json.h"
+
+/**
+ * @brief Write a piece of JSON text, unless an earlier write has failed
+ * @param writer [in] JSON writer
+ * @param text [in] text to write
+ * @param text_len [in] number of bytes of text
+ * @return true if the text was written
+ */
+static bool json_write(
+    BACNET_RPM_JSON_WRITER *writer, const char *text, size_t text_len)
+{
+    if (writer->ok && (text_len > 0)) {
+        writer->ok = writer->write(writer->context, text, text_len);
+    }
+
+    return writer->ok;
+}
+
+/**
+ * @brief Write a nul terminated piece of JSON text
+ * @param writer [in] JSON writer
+ * @param text [in] text to write
+ * @return true if the text was written
+ */
+static bool json_puts(BACNET_RPM_JSON_WRITER *writer, const char *text)
+{
+    return json_write(writer, text, strlen(text));
+}
+
+/**
+ * @brief Write text as a JSON string, escaping as needed
+ * @param writer [in] JSON writer
+ * @param text [in] text to write
+ * @param text_len [in] number of bytes of text
+ * @param latin1 [in] true if the bytes above 0x7F are ISO 8859-1
+ *  characters, false if they are UTF-8 and are written as is
+ * @return true if the text was written
+ */
+static bool json_write_string(BACNET_RPM_JSON_WRITER *writer,
+    const char *text,
+    size_t text_len,
+    bool latin1)
+{
+    char escape[8];
+    size_t start = 0, i;
+    unsigned char c;
+
+    json_write(writer, "\"", 1);
+    for (i = 0; i < text_len; i++) {
+        c = (unsigned char)text[i];
+        if (c == '"') {
+            strcpy(escape, "\\\"");
+        } else if (c == '\\') {
+            strcpy(escape, "\\\\");
+        } else if (c == '\n') {
+            strcpy(escape, "\\n");
+        } else if (c == '\r') {
+            strcpy(escape, "\\r");
+        } else if (c == '\t') {
+            strcpy(escape, "\\t");
+        } else if ((c < 0x20) || (latin1 && (c > 0x7F))) {
+            snprintf(escape, sizeof(escape), "\\u%04X", (unsigned)c);
+        } else {
+            continue;
+        }
+        /* the run of text that needs no escape, then the escape */
+        json_write(writer, &text[start], i - start);
+        json_puts(writer, escape);
+        start = i + 1;
+    }
+    json_write(writer, &text[start], text_len - start);
+
+    return json_write(writer, "\"", 1);
+}
+
+/**
+ * @brief Determine if the text of a REAL or DOUBLE is a JSON number
+ * @param text [in] text from bacapp_snprintf_value(), such as 1.000000
+ *  or nan or -inf
+ * @return true if the text is a JSON number
+ */
+static bool json_number_text(const char *text)
+{
+    if (*text == '-') {
+        text++;
+    }
+
+    return (*text >= '0') && (*text <= '9');
+}
+
+/**
+ * @brief Write one decoded value of a property as JSON
+ * @param writer [in] JSON writer
+ * @param object_value [in] the property and its decoded value
+ * @return true if the value was written
+ */
+static bool json_write_value(BACNET_RPM_JSON_WRITER *writer,
+    BACNET_OBJECT_PROPERTY_VALUE *object_value)
+{
+    BACNET_APPLICATION_DATA_VALUE *value = object_value->value;
+    char text[RPM_JSON_VALUE_TEXT_SIZE] = "";
+    int text_len = 0;
+
+    switch (value->tag) {
+#if defined(BACAPP_NULL)
+        case BACNET_APPLICATION_TAG_NULL:
+            return json_puts(writer, "null");
+#endif
+#if defined(BACAPP_BOOLEAN)
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            return json_puts(writer, value->type.Boolean ? "true" : "false");
+#endif
+#if defined(BACAPP_CHARACTER_STRING)
+        case BACNET_APPLICATION_TAG_CHARACTER_STRING:
+            return json_write_string(writer,
+                characterstring_value(&value->type.Character_String),
+                characterstring_length(&value->type.Character_String),
+                characterstring_encoding(&value->type.Character_String) !=
+                    CHARACTER_UTF8);
+#endif
+        default:
+            break;
+    }
+    text_len = bacapp_snprintf_value(text, sizeof(text), object_value);
+    if (text_len < 0) {
+        text_len = 0;
+    } else if ((size_t)text_len >= sizeof(text)) {
+        /* truncated */
+        text_len = (int)strlen(text);
+    }
+    switch (value->tag) {
+#if defined(BACAPP_UNSIGNED)
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+#endif
+#if defined(BACAPP_SIGNED)
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+#endif
+#if defined(BACAPP_REAL)
+        case BACNET_APPLICATION_TAG_REAL:
+#endif
+#if defined(BACAPP_DOUBLE)
+        case BACNET_APPLICATION_TAG_DOUBLE:
+#endif
+            if (json_number_text(text)) {
+                return json_write(writer, text, (size_t)text_len);
+            }
+            return json_puts(writer, "null");
+        default:
+            break;
+    }
+
+    return json_write_string(writer, text, (size_t)text_len, false);
+}
+
+/**
+ * @brief Write the name of the member for a property, and its separator
+ * @param writer [in] JSON writer
+ * @param object_type [in] object type of the property
+ * @param object_instance [in] object instance of the property
+ * @param object_property [in] property identifier
+ * @param array_index [in] array index, or BACNET_ARRAY_ALL
+ * @return true if the name was written
+ */
+static bool json_write_member_name(BACNET_RPM_JSON_WRITER *writer,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_ARRAY_INDEX array_index)
+{
+    char name[160];
+    int len;
+
+    if (object_property < 512) {
+        len = snprintf(name, sizeof(name), "%s_%lu_%s",
+            bactext_object_type_name(object_type),
+            (unsigned long)object_instance,
+            bactext_property_name(object_property));
+    } else {
+        len = snprintf(name, sizeof(name), "%s_%lu_%u",
+            bactext_object_type_name(object_type),
+            (unsigned long)object_instance, (unsigned)object_property);
+    }
+    if ((len > 0) && ((size_t)len < sizeof(name)) &&
+        (array_index != BACNET_ARRAY_ALL)) {
+        snprintf(&name[len], sizeof(name) - (size_t)len, "[%lu]",
+            (unsigned long)array_index);
+    }
+    json_puts(writer, (writer->members > 0) ? ",\n\t" : "\n\t");
+    writer->members++;
+    json_write_string(writer, name, strlen(name), false);
+
+    return json_write(writer, ":\t", 2);
+}
+
+/**
+ * @brief Initialize a JSON writer
+ * @param writer [out] JSON writer
+ * @param write [in] function that writes each piece of the JSON text
+ * @param context [in] passed to the write function
+ */
+void rpm_ack_json_init(BACNET_RPM_JSON_WRITER *writer,
+    rpm_json_write_function write,
+    void *context)
+{
+    if (writer) {
+        writer->write = write;
+        writer->context = context;
+        writer->members = 0;
+        writer->ok = (write != NULL);
+    }
+}
+
+/**
+ * @brief Write the beginning of the JSON object
+ * @param writer [in] JSON writer
+ * @return true if the text was written
+ */
+bool rpm_ack_json_begin(BACNET_RPM_JSON_WRITER *writer)
+{
+    if (!writer) {
+        return false;
+    }
+    writer->members = 0;
+
+    return json_write(writer, "{", 1);
+}
+
+/**
+ * @brief Write the end of the JSON object
+ * @param writer [in] JSON writer
+ * @return true if the JSON text was written without failure
+ */
+bool rpm_ack_json_end(BACNET_RPM_JSON_WRITER *writer)
+{
+    if (!writer) {
+        return false;
+    }
+
+    return json_puts(writer, (writer->members > 0) ? "\n}\n" : "}\n");
+}
+
+/**
+ * @brief Decode the service data of a ReadPropertyMultiple-ACK and write
+ *  each of its results as a member of the JSON object
+ *
+ * The members are written as they are decoded, so after an error the
+ * members before it have already been written.  An ACK that was split over
+ * more than one APDU is written by calling this for each of them between
+ * rpm_ack_json_begin() and rpm_ack_json_end().
+ *
+ * @param writer [in] JSON writer
+ * @param apdu [in] service data of the ReadPropertyMultiple-ACK
+ * @param apdu_len [in] number of bytes of service data
+ * @return number of bytes decoded, or BACNET_STATUS_ERROR if the service
+ *  data is malformed or a write failed
+ */
+int rpm_ack_json_encode(
+    BACNET_RPM_JSON_WRITER *writer, uint8_t *apdu, unsigned apdu_len)
+{
+    int len = 0;
+    int tag_len = 0;
+    unsigned decoded_len = 0;
+    unsigned value_end = 0;
+    bool array_value = false;
+    bool object_end = false;
+    uint32_t error_value = 0;
+    BACNET_OBJECT_TYPE object_type = OBJECT_NONE;
+    uint32_t object_instance = 0;
+    BACNET_PROPERTY_ID object_property = PROP_ALL;
+    BACNET_ARRAY_INDEX array_index = BACNET_ARRAY_ALL;
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_OBJECT_PROPERTY_VALUE object_value = { 0 };
+
+    if (!writer || !apdu) {
+        return BACNET_STATUS_ERROR;
+    }
+    while (decoded_len < apdu_len) {
+        len = rpm_ack_decode_object_id(&apdu[decoded_len],
+            apdu_len - decoded_len, &object_type, &object_instance);
+        if (len <= 0) {
+            return BACNET_STATUS_ERROR;
+        }
+        decoded_len += len;
+        object_end = false;
+        while (decoded_len < apdu_len) {
+            if (rpm_ack_decode_object_end(
+                    &apdu[decoded_len], apdu_len - decoded_len)) {
+                decoded_len++;
+                object_end = true;
+                break;
+            }
+            len = rpm_ack_decode_object_property(&apdu[decoded_len],
+                apdu_len - decoded_len, &object_property, &array_index);
+            if (len <= 0) {
+                return BACNET_STATUS_ERROR;
+            }
+            decoded_len += len;
+            if (bacnet_is_opening_tag_number(&apdu[decoded_len],
+                    apdu_len - decoded_len, 4, &tag_len)) {
+                /* propertyValue */
+                len = bacapp_data_len(&apdu[decoded_len],
+                    apdu_len - decoded_len, object_property);
+                if (len < 0) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += tag_len;
+                value_end = decoded_len + (unsigned)len;
+                json_write_member_name(writer, object_type, object_instance,
+                    object_property, array_index);
+                object_value.object_type = object_type;
+                object_value.object_instance = object_instance;
+                object_value.object_property = object_property;
+                object_value.array_index = array_index;
+                object_value.value = &value;
+                /* an empty list is an array */
+                array_value = (decoded_len == value_end);
+                if (array_value) {
+                    json_write(writer, "[", 1);
+                }
+                while (decoded_len < value_end) {
+                    len = bacapp_decode_known_property(&apdu[decoded_len],
+                        (int)(value_end - decoded_len), &value, object_type,
+                        object_property);
+                    if (len <= 0) {
+                        return BACNET_STATUS_ERROR;
+                    }
+                    decoded_len += len;
+                    if (array_value) {
+                        json_write(writer, ", ", 2);
+                    } else if (decoded_len < value_end) {
+                        /* more than one value */
+                        array_value = true;
+                        json_write(writer, "[", 1);
+                    }
+                    json_write_value(writer, &object_value);
+                }
+                if (array_value) {
+                    json_write(writer, "]", 1);
+                }
+                if (!bacnet_is_closing_tag_number(&apdu[decoded_len],
+                        apdu_len - decoded_len, 4, &tag_len)) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += tag_len;
+            } else if (bacnet_is_opening_tag_number(&apdu[decoded_len],
+                           apdu_len - decoded_len, 5, &tag_len)) {
+                /* propertyAccessError */
+                decoded_len += tag_len;
+                len = bacnet_enumerated_application_decode(
+                    &apdu[decoded_len], apdu_len - decoded_len, &error_value);
+                if (len <= 0) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += len;
+                json_write_member_name(writer, object_type, object_instance,
+                    object_property, array_index);
+                json_puts(writer, "{\"error-class\": \"");
+                json_puts(writer, bactext_error_class_name(error_value));
+                len = bacnet_enumerated_application_decode(
+                    &apdu[decoded_len], apdu_len - decoded_len, &error_value);
+                if (len <= 0) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += len;
+                json_puts(writer, "\", \"error-code\": \"");
+                json_puts(writer, bactext_error_code_name(error_value));
+                json_puts(writer, "\"}");
+                if (!bacnet_is_closing_tag_number(&apdu[decoded_len],
+                        apdu_len - decoded_len, 5, &tag_len)) {
+                    return BACNET_STATUS_ERROR;
+                }
+                decoded_len += tag_len;
+            } else {
+                return BACNET_STATUS_ERROR;
+            }
+            if (!writer->ok) {
+                return BACNET_STATUS_ERROR;
+            }
+        }
+        if (!object_end) {
+            return BACNET_STATUS_ERROR;
+        }
+    }
+
+    return (int)decoded_len;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file
+ * @date 2026
+ * @brief Stream the results of a ReadPropertyMultiple-ACK as JSON
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef RPM_JSON_H
+#define RPM_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "bacnet/bacnet_stack_exports.h"
+#include "bacnet/bacdef.h"
+
+/* size of the text buffer for one value formatted by bacapp_snprintf_value */
+#ifndef RPM_JSON_VALUE_TEXT_SIZE
+#define RPM_JSON_VALUE_TEXT_SIZE 1024
+#endif
+
+/* writes the next piece of the JSON text; returns false on failure */
+typedef bool (*rpm_json_write_function)(
+    void *context, const char *text, size_t text_len);
+
+typedef struct BACnet_RPM_JSON_Writer {
+    rpm_json_write_function write;
+    void *context;
+    /* number of members written into the JSON object */
+    unsigned long members;
+    /* false once a write has failed */
+    bool ok;
+} BACNET_RPM_JSON_WRITER;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void rpm_ack_json_init(BACNET_RPM_JSON_WRITER *writer,
+    rpm_json_write_function write,
+    void *context);
+BACNET_STACK_EXPORT
+bool rpm_ack_json_begin(BACNET_RPM_JSON_WRITER *writer);
+BACNET_STACK_EXPORT
+int rpm_ack_json_encode(
+    BACNET_RPM_JSON_WRITER *writer, uint8_t *apdu, unsigned apdu_len);
+BACNET_STACK_EXPORT
+bool rpm_ack_json_end(BACNET_RPM_JSON_WRITER *writer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -1194,6 +1194,195 @@ static void test_bacapp_sprintf_data(void)
     }
 }
 
+/**
+ * @brief Test
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacapp_tests, test_bacapp_decode_array_packed)
+#else
+static void test_bacapp_decode_array_packed(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    BACNET_OBJECT_ID object_list[40] = { 0 };
+    float priority_array[BACNET_MAX_PRIORITY] = { 0 };
+    bool priority_null[BACNET_MAX_PRIORITY] = { 0 };
+    uint32_t enum_list[4] = { 0 };
+    uint32_t count = 0;
+    int apdu_len = 0, len = 0;
+    unsigned i;
+
+    /* Object_List: a run of fixed size elements */
+    for (i = 0; i < 40; i++) {
+        apdu_len += encode_application_object_id(
+            &apdu[apdu_len], OBJECT_ANALOG_INPUT + (i % 3), i * 1000);
+    }
+    len = bacapp_decode_array_packed(apdu, apdu_len,
+        BACNET_APPLICATION_TAG_OBJECT_ID, object_list, NULL, 40, &count);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(count, 40, NULL);
+    for (i = 0; i < 40; i++) {
+        zassert_equal(object_list[i].type, OBJECT_ANALOG_INPUT + (i % 3), NULL);
+        zassert_equal(object_list[i].instance, i * 1000, NULL);
+    }
+    /* array full */
+    len = bacapp_decode_array_packed(apdu, apdu_len,
+        BACNET_APPLICATION_TAG_OBJECT_ID, object_list, NULL, 10, &count);
+    zassert_equal(len, 50, NULL);
+    zassert_equal(count, 10, NULL);
+    /* length only */
+    len = bacapp_decode_array_packed(apdu, apdu_len,
+        BACNET_APPLICATION_TAG_OBJECT_ID, NULL, NULL, 40, &count);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(count, 40, NULL);
+    /* truncated element */
+    len = bacapp_decode_array_packed(apdu, apdu_len - 1,
+        BACNET_APPLICATION_TAG_OBJECT_ID, object_list, NULL, 40, &count);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    /* wrong element type */
+    len = bacapp_decode_array_packed(apdu, apdu_len,
+        BACNET_APPLICATION_TAG_REAL, priority_array, NULL, 16, &count);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    /* Priority_Array: NULL and REAL, ending at a closing tag */
+    apdu_len = 0;
+    for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
+        if (i % 4) {
+            apdu_len += encode_application_null(&apdu[apdu_len]);
+        } else {
+            apdu_len += encode_application_real(&apdu[apdu_len], i + 0.5f);
+        }
+    }
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 3);
+    len = bacapp_decode_array_packed(apdu, apdu_len,
+        BACNET_APPLICATION_TAG_REAL, priority_array, priority_null,
+        BACNET_MAX_PRIORITY, &count);
+    zassert_equal(len, apdu_len - 1, NULL);
+    zassert_equal(count, BACNET_MAX_PRIORITY, NULL);
+    for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
+        if (i % 4) {
+            zassert_true(priority_null[i], NULL);
+            zassert_true(priority_array[i] == 0.0f, NULL);
+        } else {
+            zassert_false(priority_null[i], NULL);
+            zassert_true(priority_array[i] == (i + 0.5f), NULL);
+        }
+    }
+    /* NULL elements without NULL flags */
+    len = bacapp_decode_array_packed(apdu, apdu_len,
+        BACNET_APPLICATION_TAG_REAL, priority_array, NULL,
+        BACNET_MAX_PRIORITY, &count);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    /* variable length elements */
+    apdu_len = 0;
+    apdu_len += encode_application_enumerated(&apdu[apdu_len], 1);
+    apdu_len += encode_application_enumerated(&apdu[apdu_len], 300);
+    apdu_len += encode_application_enumerated(&apdu[apdu_len], 70000);
+    apdu_len += encode_application_enumerated(&apdu[apdu_len], 0x12345678);
+    len = bacapp_decode_array_packed(apdu, apdu_len,
+        BACNET_APPLICATION_TAG_ENUMERATED, enum_list, NULL, 4, &count);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(count, 4, NULL);
+    zassert_equal(enum_list[0], 1, NULL);
+    zassert_equal(enum_list[1], 300, NULL);
+    zassert_equal(enum_list[2], 70000, NULL);
+    zassert_equal(enum_list[3], 0x12345678, NULL);
+}
+
+/**
+ * @brief Test
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacapp_tests, test_bacapp_compact_value)
+#else
+static void test_bacapp_compact_value(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    uint8_t test_apdu[MAX_APDU] = { 0 };
+    uint8_t buffer[64] = { 0 };
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_APPLICATION_DATA_VALUE test_value = { 0 };
+    BACNET_COMPACT_VALUE compact = { 0 };
+    BACNET_PROPERTY_VALUE property_value = { 0 };
+    BACNET_PROPERTY_COMPACT_VALUE property_compact = { 0 };
+    int apdu_len = 0, len = 0;
+
+    /* primitive values are held inline */
+    zassert_true(sizeof(compact) < sizeof(value), NULL);
+    value.tag = BACNET_APPLICATION_TAG_REAL;
+    value.type.Real = 3.5f;
+    apdu_len = bacapp_encode_application_data(apdu, &value);
+    len = bacapp_compact_value_decode(apdu, apdu_len, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_false(compact.encoded, NULL);
+    zassert_equal(compact.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    zassert_true(compact.type.Real == 3.5f, NULL);
+    len = bacapp_compact_value_encode(test_apdu, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(memcmp(apdu, test_apdu, apdu_len), 0, NULL);
+    zassert_true(bacapp_compact_value_to_value(
+                     &compact, OBJECT_ANALOG_INPUT, PROP_PRESENT_VALUE,
+                     &test_value),
+        NULL);
+    zassert_true(bacapp_same_value(&value, &test_value), NULL);
+    /* strings are held as their encoding */
+    value.tag = BACNET_APPLICATION_TAG_CHARACTER_STRING;
+    characterstring_init_ansi(&value.type.Character_String, "compact");
+    len = bacapp_compact_value_from_value(
+        &compact, &value, buffer, sizeof(buffer));
+    zassert_true(len > 0, NULL);
+    zassert_true(compact.encoded, NULL);
+    zassert_equal(compact.tag, BACNET_APPLICATION_TAG_CHARACTER_STRING, NULL);
+    zassert_true(compact.type.Encoding.data == buffer, NULL);
+    zassert_equal(compact.type.Encoding.length, len, NULL);
+    zassert_true(bacapp_compact_value_to_value(
+                     &compact, OBJECT_ANALOG_INPUT, PROP_OBJECT_NAME,
+                     &test_value),
+        NULL);
+    zassert_true(bacapp_same_value(&value, &test_value), NULL);
+    zassert_equal(bacapp_compact_value_from_value(
+                      &compact, &value, buffer, 4),
+        BACNET_STATUS_ERROR, NULL);
+    /* a list of values is held as its encoding */
+    apdu_len = encode_application_unsigned(&apdu[0], 1);
+    apdu_len += encode_application_unsigned(&apdu[apdu_len], 2);
+    len = bacapp_compact_value_decode(apdu, apdu_len, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_true(compact.encoded, NULL);
+    zassert_equal(compact.tag, MAX_BACNET_APPLICATION_TAG, NULL);
+    len = bacapp_compact_value_encode(test_apdu, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(memcmp(apdu, test_apdu, apdu_len), 0, NULL);
+    /* truncated primitive */
+    value.tag = BACNET_APPLICATION_TAG_UNSIGNED_INT;
+    value.type.Unsigned_Int = 0x12345678;
+    apdu_len = bacapp_encode_application_data(apdu, &value);
+    len = bacapp_compact_value_decode(apdu, apdu_len - 1, &compact);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    /* property value */
+    property_value.propertyIdentifier = PROP_PRESENT_VALUE;
+    property_value.propertyArrayIndex = BACNET_ARRAY_ALL;
+    property_value.value.tag = BACNET_APPLICATION_TAG_ENUMERATED;
+    property_value.value.type.Enumerated = 1;
+    property_value.priority = 8;
+    apdu_len = bacapp_property_value_encode(apdu, &property_value);
+    len = bacapp_property_compact_value_decode(
+        apdu, apdu_len, &property_compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(
+        property_compact.propertyIdentifier, PROP_PRESENT_VALUE, NULL);
+    zassert_equal(property_compact.propertyArrayIndex, BACNET_ARRAY_ALL, NULL);
+    zassert_equal(property_compact.priority, 8, NULL);
+    zassert_equal(
+        property_compact.value.tag, BACNET_APPLICATION_TAG_ENUMERATED, NULL);
+    zassert_equal(property_compact.value.type.Enumerated, 1, NULL);
+    len = bacapp_property_compact_value_decode(apdu, apdu_len, NULL);
+    zassert_equal(len, apdu_len, NULL);
+    len = bacapp_property_compact_value_decode(
+        apdu, apdu_len - 1, &property_compact);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+}
+
 /**
  * @}
  */
@@ -1214,7 +1403,9 @@ void test_main(void)
         ztest_unit_test(testBACnetApplicationDataLength),
         ztest_unit_test(testBACnetApplicationData_Safe),
         ztest_unit_test(test_bacapp_context_data),
-        ztest_unit_test(test_bacapp_sprintf_data));
+        ztest_unit_test(test_bacapp_sprintf_data),
+        ztest_unit_test(test_bacapp_decode_array_packed),
+        ztest_unit_test(test_bacapp_compact_value));
 
     ztest_run_test_suite(bacapp_tests);
 }
@@ -1613,6 +1613,141 @@ static void test_bacnet_array_encode(void)
     zassert_true(apdu_len == BACNET_STATUS_ABORT, NULL);
 }
 
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacdcode_tests, testBACnetUnsignedWidths)
+#else
+static void testBACnetUnsignedWidths(void)
+#endif
+{
+    uint8_t apdu[16] = { 0 };
+    BACNET_UNSIGNED_INTEGER value = 0, test_value = 0;
+    int32_t signed_value = 0;
+    uint32_t width, i;
+    int len;
+
+    for (i = 0; i < sizeof(apdu); i++) {
+        apdu[i] = (uint8_t)(0x81 + i);
+    }
+    for (width = 1; width <= sizeof(BACNET_UNSIGNED_INTEGER); width++) {
+        test_value = 0;
+        for (i = 0; i < width; i++) {
+            test_value = (test_value << 8) | apdu[i];
+        }
+        /* octets after the value are not part of it */
+        len = bacnet_unsigned_decode(apdu, sizeof(apdu), width, &value);
+        zassert_equal(len, width, NULL);
+        zassert_equal(value, test_value, NULL);
+        /* value at the end of the buffer */
+        len = bacnet_unsigned_decode(
+            &apdu[sizeof(apdu) - width], width, width, &value);
+        zassert_equal(len, width, NULL);
+        test_value = 0;
+        for (i = sizeof(apdu) - width; i < sizeof(apdu); i++) {
+            test_value = (test_value << 8) | apdu[i];
+        }
+        zassert_equal(value, test_value, NULL);
+        /* too short */
+        len = bacnet_unsigned_decode(apdu, width - 1, width, &value);
+        zassert_equal(len, 0, NULL);
+    }
+    len = bacnet_unsigned_decode(
+        apdu, sizeof(apdu), sizeof(BACNET_UNSIGNED_INTEGER) + 1, &value);
+    zassert_equal(len, 0, NULL);
+    len = bacnet_unsigned_decode(apdu, sizeof(apdu), 0, &value);
+    zassert_equal(len, 0, NULL);
+    /* signed values are sign extended from their width */
+    len = bacnet_signed_decode(apdu, sizeof(apdu), 1, &signed_value);
+    zassert_equal(len, 1, NULL);
+    zassert_equal(signed_value, (int8_t)0x81, NULL);
+    len = bacnet_signed_decode(apdu, sizeof(apdu), 2, &signed_value);
+    zassert_equal(len, 2, NULL);
+    zassert_equal(signed_value, (int16_t)0x8182, NULL);
+    len = bacnet_signed_decode(apdu, sizeof(apdu), 3, &signed_value);
+    zassert_equal(len, 3, NULL);
+    zassert_equal(signed_value, -0x7E7D7D, NULL);
+    len = bacnet_signed_decode(&apdu[sizeof(apdu) - 4], 4, 4, &signed_value);
+    zassert_equal(len, 4, NULL);
+    zassert_equal(signed_value, (int32_t)0x8D8E8F90, NULL);
+    len = bacnet_signed_decode(apdu, sizeof(apdu), 5, &signed_value);
+    zassert_equal(len, 0, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacdcode_tests, testBACnetTagCursor)
+#else
+static void testBACnetTagCursor(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    BACNET_TAG_CURSOR cursor = { 0 };
+    const BACNET_TAG *tag;
+    BACNET_OBJECT_TYPE object_type = OBJECT_NONE;
+    uint32_t object_instance = 0;
+    uint32_t enum_value = 0;
+    BACNET_UNSIGNED_INTEGER unsigned_value = 0;
+    int apdu_len = 0, len;
+
+    apdu_len += encode_context_object_id(
+        &apdu[apdu_len], 0, OBJECT_ANALOG_INPUT, 1234);
+    apdu_len += encode_opening_tag(&apdu[apdu_len], 1);
+    apdu_len += encode_context_enumerated(&apdu[apdu_len], 2, 85);
+    apdu_len += encode_context_unsigned(&apdu[apdu_len], 3, 70000);
+    apdu_len += encode_opening_tag(&apdu[apdu_len], 20);
+    apdu_len += encode_application_boolean(&apdu[apdu_len], true);
+    apdu_len += encode_application_unsigned(&apdu[apdu_len], 1);
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 20);
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 1);
+
+    bacnet_tag_cursor_init(&cursor, apdu, apdu_len);
+    /* peek does not move the cursor */
+    zassert_false(bacnet_tag_cursor_is_opening(&cursor, 0), NULL);
+    zassert_false(bacnet_tag_cursor_is_context(&cursor, 1), NULL);
+    zassert_true(bacnet_tag_cursor_is_context(&cursor, 0), NULL);
+    zassert_equal(cursor.offset, 0, NULL);
+    len = bacnet_tag_cursor_object_id_decode(
+        &cursor, &object_type, &object_instance);
+    zassert_equal(len, 5, NULL);
+    zassert_equal(object_type, OBJECT_ANALOG_INPUT, NULL);
+    zassert_equal(object_instance, 1234, NULL);
+    zassert_true(bacnet_tag_cursor_is_opening(&cursor, 1), NULL);
+    /* opening tags have no value to decode */
+    zassert_equal(bacnet_tag_cursor_unsigned_decode(&cursor, &unsigned_value),
+        BACNET_STATUS_ERROR, NULL);
+    zassert_true(bacnet_tag_cursor_next(&cursor), NULL);
+    zassert_true(bacnet_tag_cursor_is_context(&cursor, 2), NULL);
+    len = bacnet_tag_cursor_enumerated_decode(&cursor, &enum_value);
+    zassert_true(len > 0, NULL);
+    zassert_equal(enum_value, 85, NULL);
+    zassert_true(bacnet_tag_cursor_is_context(&cursor, 3), NULL);
+    len = bacnet_tag_cursor_unsigned_decode(&cursor, &unsigned_value);
+    zassert_equal(len, 4, NULL);
+    zassert_equal(unsigned_value, 70000, NULL);
+    /* extended tag number */
+    zassert_true(bacnet_tag_cursor_is_opening(&cursor, 20), NULL);
+    zassert_false(bacnet_tag_cursor_is_closing(&cursor, 20), NULL);
+    zassert_true(bacnet_tag_cursor_next(&cursor), NULL);
+    /* application boolean holds its value in the tag */
+    tag = bacnet_tag_cursor_peek(&cursor);
+    zassert_not_null(tag, NULL);
+    zassert_true(tag->application, NULL);
+    zassert_equal(tag->number, BACNET_APPLICATION_TAG_BOOLEAN, NULL);
+    zassert_equal(tag->len_value_type, 1, NULL);
+    zassert_true(bacnet_tag_cursor_next(&cursor), NULL);
+    zassert_true(bacnet_tag_cursor_next(&cursor), NULL);
+    zassert_true(bacnet_tag_cursor_is_closing(&cursor, 20), NULL);
+    zassert_true(bacnet_tag_cursor_next(&cursor), NULL);
+    zassert_true(bacnet_tag_cursor_is_closing(&cursor, 1), NULL);
+    zassert_true(bacnet_tag_cursor_next(&cursor), NULL);
+    zassert_equal(cursor.offset, apdu_len, NULL);
+    zassert_is_null(bacnet_tag_cursor_peek(&cursor), NULL);
+    zassert_false(bacnet_tag_cursor_next(&cursor), NULL);
+    /* value longer than the buffer */
+    bacnet_tag_cursor_init(&cursor, apdu, 3);
+    zassert_true(bacnet_tag_cursor_is_context(&cursor, 0), NULL);
+    zassert_false(bacnet_tag_cursor_next(&cursor), NULL);
+    zassert_is_null(bacnet_tag_cursor_peek(&cursor), NULL);
+}
+
 /**
  * @}
  */
@@ -1645,7 +1780,9 @@ void test_main(void)
         ztest_unit_test(testDateContextDecodes),
         ztest_unit_test(testOctetStringContextDecodes),
         ztest_unit_test(testBACDCodeDouble),
-        ztest_unit_test(test_bacnet_array_encode));
+        ztest_unit_test(test_bacnet_array_encode),
+        ztest_unit_test(testBACnetUnsignedWidths),
+        ztest_unit_test(testBACnetTagCursor));
 
     ztest_run_test_suite(bacdcode_tests);
 }
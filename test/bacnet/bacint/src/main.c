@@ -307,6 +307,29 @@ static void testBACnetUnsignedLength(void)
     zassert_equal(len, 1, NULL);
 }
 
+/**
+ * @brief Test decode of unsigned integers of every length
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacint_tests, testBACnetUnsignedOctets)
+#else
+static void testBACnetUnsignedOctets(void)
+#endif
+{
+    /* the octets after the value must not change it */
+    uint8_t buffer[16] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    BACNET_UNSIGNED_INTEGER value = 0;
+    BACNET_UNSIGNED_INTEGER test_value = 0;
+    uint32_t len = 0;
+
+    for (len = 1; len <= sizeof(BACNET_UNSIGNED_INTEGER); len++) {
+        test_value = (test_value << 8) | buffer[len - 1];
+        value = decode_unsigned_octets(buffer, len);
+        zassert_equal(value, test_value, NULL);
+    }
+}
+
 /**
  * @brief Test encode/decode API for signed 8b integers
  */
@@ -476,6 +499,7 @@ void test_main(void)
      ztest_unit_test(testBACnetUnsigned56),
      ztest_unit_test(testBACnetUnsigned64),
      ztest_unit_test(testBACnetUnsignedLength),
+     ztest_unit_test(testBACnetUnsignedOctets),
      ztest_unit_test(testBACnetSigned8),
      ztest_unit_test(testBACnetSigned16),
      ztest_unit_test(testBACnetSigned24),
@@ -303,8 +303,105 @@ static void test_BBMD_Result(void)
     }
 }
 
+/**
+ * @brief Test the VMAC list indexes, pool and lifetime
+ */
+static void test_VMAC(void)
+{
+    struct vmac_data vmac = { 0 };
+    struct vmac_data new_vmac = { 0 };
+    struct vmac_data *test_vmac = NULL;
+    uint32_t device_id = 0;
+    uint32_t i = 0;
+    bool status = false;
+
+    /* the list is usable before VMAC_Init() */
+    vmac.mac_len = VMAC_MAC_MAX;
+    assert(VMAC_Find_By_Key(1234) == NULL);
+    assert(!VMAC_Find_By_Data(&vmac, &device_id));
+    assert(!VMAC_Delete(1234));
+    VMAC_Init();
+    assert(VMAC_Count() == 0);
+    for (i = 0; i < VMAC_MAC_MAX; i++) {
+        vmac.mac[i] = i;
+    }
+    status = VMAC_Add(1234, &vmac);
+    assert(status);
+    status = VMAC_Add(1234, &vmac);
+    assert(!status);
+    assert(VMAC_Count() == 1);
+    test_vmac = VMAC_Find_By_Key(1234);
+    assert(test_vmac != NULL);
+    assert(VMAC_Match(&vmac, test_vmac));
+    status = VMAC_Find_By_Data(&vmac, &device_id);
+    assert(status);
+    assert(device_id == 1234);
+    /* a new MAC is found by its data, and the old one is not */
+    new_vmac = vmac;
+    new_vmac.mac[15] = 0xFF;
+    status = VMAC_Update(1234, &new_vmac);
+    assert(status);
+    status = VMAC_Find_By_Data(&vmac, &device_id);
+    assert(!status);
+    status = VMAC_Find_By_Data(&new_vmac, &device_id);
+    assert(status);
+    assert(device_id == 1234);
+    status = VMAC_Update(4321, &new_vmac);
+    assert(!status);
+    status = VMAC_Delete(1234);
+    assert(status);
+    status = VMAC_Delete(1234);
+    assert(!status);
+    assert(VMAC_Find_By_Key(1234) == NULL);
+    status = VMAC_Find_By_Data(&new_vmac, &device_id);
+    assert(!status);
+    /* fill the pool */
+    for (i = 0; i < MAX_VMAC_ENTRIES; i++) {
+        vmac.mac[0] = i & 0xFF;
+        vmac.mac[1] = i >> 8;
+        status = VMAC_Add(i, &vmac);
+        assert(status);
+    }
+    assert(VMAC_Count() == MAX_VMAC_ENTRIES);
+    /* the pool grows by a block */
+    vmac.mac[0] = MAX_VMAC_ENTRIES & 0xFF;
+    vmac.mac[1] = MAX_VMAC_ENTRIES >> 8;
+    status = VMAC_Add(MAX_VMAC_ENTRIES, &vmac);
+    assert(status);
+    assert(VMAC_Count() == (MAX_VMAC_ENTRIES + 1));
+    for (i = 0; i <= MAX_VMAC_ENTRIES; i++) {
+        vmac.mac[0] = i & 0xFF;
+        vmac.mac[1] = i >> 8;
+        status = VMAC_Find_By_Data(&vmac, &device_id);
+        assert(status);
+        assert(device_id == i);
+    }
+    VMAC_Cleanup();
+    assert(VMAC_Count() == 0);
+    /* lifetime */
+    VMAC_Lifetime_Set(10);
+    status = VMAC_Add(1, &vmac);
+    assert(status);
+    VMAC_Timer(6);
+    assert(VMAC_Find_By_Key(1) != NULL);
+    status = VMAC_Update(1, &vmac);
+    assert(status);
+    VMAC_Timer(6);
+    assert(VMAC_Find_By_Key(1) != NULL);
+    VMAC_Timer(6);
+    assert(VMAC_Find_By_Key(1) == NULL);
+    assert(VMAC_Count() == 0);
+    VMAC_Lifetime_Set(0);
+    status = VMAC_Add(1, &vmac);
+    assert(status);
+    VMAC_Timer(60);
+    assert(VMAC_Find_By_Key(1) != NULL);
+    VMAC_Cleanup();
+}
+
 int main(void)
 {
+    test_VMAC();
     test_BBMD_Result();
     test_Execute_Virtual_Address_Resolution();
     test_Initiate_Original_Broadcast_NPDU();
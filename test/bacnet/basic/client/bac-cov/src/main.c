@@ -0,0 +1,231 @@
+/**
+ * @file
+ * @brief Unit test for the COV client
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <zephyr/ztest.h>
+#include <bacnet/bacstr.h>
+#include <bacnet/cov.h>
+#include <bacnet/rp.h>
+#include <bacnet/basic/client/bac-rw.h>
+#include <bacnet/basic/client/bac-cov.h>
+
+/* from the stubs */
+extern uint8_t Stub_Invoke_ID;
+extern BACNET_SUBSCRIBE_COV_DATA Stub_Subscribe_Data;
+extern unsigned Stub_Subscribe_Count;
+extern bool Stub_TSM_Free;
+extern uint8_t Stub_TSM_Freed_Invoke_ID;
+extern BACNET_COV_NOTIFICATION *Stub_COV_Notification;
+extern BACNET_READ_WRITE_VALUE_NOTIFICATION *Stub_Value_Notification;
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+/**
+ * @brief Test that the handles of removed subscriptions are not valid
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_cov_tests, test_cov_client_handle)
+#else
+static void test_cov_client_handle(void)
+#endif
+{
+    BACNET_COV_CLIENT_VALUE value = { 0 };
+    int handle, handle2;
+
+    bacnet_cov_client_init();
+    handle = bacnet_cov_client_add(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE);
+    zassert_true(handle >= 0, NULL);
+    zassert_equal(bacnet_cov_client_find(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE), handle, NULL);
+    zassert_equal(bacnet_cov_client_add(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE), handle, NULL);
+    zassert_equal(bacnet_cov_client_mode(handle),
+        BACNET_COV_CLIENT_MODE_SUBSCRIBING, NULL);
+    zassert_true(bacnet_cov_client_value(handle, &value), NULL);
+    /* not sent yet, so it is freed at once */
+    zassert_true(bacnet_cov_client_remove(handle), NULL);
+    zassert_equal(bacnet_cov_client_count(), 0, NULL);
+    zassert_equal(bacnet_cov_client_mode(handle),
+        BACNET_COV_CLIENT_MODE_NONE, NULL);
+    zassert_false(bacnet_cov_client_value(handle, &value), NULL);
+    zassert_false(bacnet_cov_client_remove(handle), NULL);
+    /* the entry is reused with another handle */
+    handle2 = bacnet_cov_client_add(
+        1234, OBJECT_ANALOG_INPUT, 2, PROP_PRESENT_VALUE);
+    zassert_true(handle2 >= 0, NULL);
+    zassert_not_equal(handle2, handle, NULL);
+    zassert_equal(bacnet_cov_client_mode(handle),
+        BACNET_COV_CLIENT_MODE_NONE, NULL);
+    zassert_false(bacnet_cov_client_remove(handle), NULL);
+    zassert_equal(bacnet_cov_client_count(), 1, NULL);
+    zassert_false(bacnet_cov_client_value(-1, &value), NULL);
+    zassert_equal(bacnet_cov_client_mode(-1),
+        BACNET_COV_CLIENT_MODE_NONE, NULL);
+}
+
+/**
+ * @brief Test the removal of a subscription that waits for its answer
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_cov_tests, test_cov_client_remove_waiting)
+#else
+static void test_cov_client_remove_waiting(void)
+#endif
+{
+    unsigned count;
+    int handle, handle2;
+
+    bacnet_cov_client_init();
+    Stub_TSM_Free = false;
+    Stub_Invoke_ID = 7;
+    handle = bacnet_cov_client_add(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE);
+    count = Stub_Subscribe_Count;
+    bacnet_cov_client_task();
+    zassert_equal(Stub_Subscribe_Count, count + 1, NULL);
+    zassert_false(Stub_Subscribe_Data.cancellationRequest, NULL);
+    /* the subscription is answered after it is removed */
+    Stub_Invoke_ID = 8;
+    Stub_TSM_Freed_Invoke_ID = 0;
+    zassert_true(bacnet_cov_client_remove(handle), NULL);
+    zassert_equal(Stub_TSM_Freed_Invoke_ID, 7, NULL);
+    zassert_true(Stub_Subscribe_Data.cancellationRequest, NULL);
+    zassert_equal(bacnet_cov_client_find(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE),
+        BACNET_STATUS_ERROR, NULL);
+    /* a new subscription waits until the cancellation is answered */
+    Stub_Invoke_ID = 9;
+    handle2 = bacnet_cov_client_add(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE);
+    zassert_true(handle2 >= 0, NULL);
+    zassert_not_equal(handle2, handle, NULL);
+    zassert_equal(bacnet_cov_client_count(), 2, NULL);
+    count = Stub_Subscribe_Count;
+    bacnet_cov_client_task();
+    zassert_equal(Stub_Subscribe_Count, count, NULL);
+    Stub_TSM_Free = true;
+    bacnet_cov_client_task();
+    bacnet_cov_client_task();
+    zassert_equal(bacnet_cov_client_count(), 1, NULL);
+    zassert_equal(Stub_Subscribe_Count, count + 1, NULL);
+    zassert_false(Stub_Subscribe_Data.cancellationRequest, NULL);
+}
+
+/**
+ * @brief Test the values and the status flags of COV notifications
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_cov_tests, test_cov_client_notification)
+#else
+static void test_cov_client_notification(void)
+#endif
+{
+    BACNET_COV_CLIENT_VALUE value = { 0 };
+    BACNET_PROPERTY_VALUE value_list[2] = { 0 };
+    BACNET_COV_DATA cov_data = { 0 };
+    int handle, handle2;
+
+    bacnet_cov_client_init();
+    bacnet_cov_client_process_id_set(5);
+    handle = bacnet_cov_client_add(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE);
+    handle2 = bacnet_cov_client_add(
+        1234, OBJECT_ANALOG_INPUT, 1, PROP_OUT_OF_SERVICE);
+    zassert_not_null(Stub_COV_Notification, NULL);
+    cov_data.initiatingDeviceIdentifier = 1234;
+    cov_data.subscriberProcessIdentifier = 5;
+    cov_data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    cov_data.monitoredObjectIdentifier.instance = 1;
+    cov_data.listOfValues = &value_list[0];
+    value_list[0].propertyIdentifier = PROP_PRESENT_VALUE;
+    value_list[0].value.tag = BACNET_APPLICATION_TAG_REAL;
+    value_list[0].value.type.Real = 42.0f;
+    value_list[0].next = &value_list[1];
+    value_list[1].propertyIdentifier = PROP_STATUS_FLAGS;
+    value_list[1].value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
+    bitstring_init(&value_list[1].value.type.Bit_String);
+    bitstring_set_bit(
+        &value_list[1].value.type.Bit_String, STATUS_FLAG_IN_ALARM, true);
+    Stub_COV_Notification->callback(&cov_data);
+    zassert_true(bacnet_cov_client_value(handle, &value), NULL);
+    zassert_equal(value.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    zassert_true(value.type.Real == 42.0f, NULL);
+    zassert_true(value.cov, NULL);
+    zassert_equal(value.status_flags, 1, NULL);
+    /* the status flags are stored into every property of the object */
+    zassert_true(bacnet_cov_client_value(handle2, &value), NULL);
+    zassert_equal(value.tag, BACNET_APPLICATION_TAG_NULL, NULL);
+    zassert_equal(value.status_flags, 1, NULL);
+    /* notifications of another subscriber are ignored */
+    cov_data.subscriberProcessIdentifier = 6;
+    value_list[0].value.type.Real = 1.0f;
+    bitstring_set_bit(
+        &value_list[1].value.type.Bit_String, STATUS_FLAG_IN_ALARM, false);
+    Stub_COV_Notification->callback(&cov_data);
+    zassert_true(bacnet_cov_client_value(handle, &value), NULL);
+    zassert_true(value.type.Real == 42.0f, NULL);
+    zassert_equal(value.status_flags, 1, NULL);
+}
+
+/**
+ * @brief Test the values that are read by bac-rw
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_cov_tests, test_cov_client_value_save)
+#else
+static void test_cov_client_value_save(void)
+#endif
+{
+    BACNET_COV_CLIENT_VALUE value = { 0 };
+    BACNET_READ_PROPERTY_DATA rp_data = { 0 };
+    BACNET_APPLICATION_DATA_VALUE data_value = { 0 };
+    int handle;
+
+    bacnet_cov_client_init();
+    handle = bacnet_cov_client_add(
+        1234, OBJECT_BINARY_INPUT, 3, PROP_PRESENT_VALUE);
+    zassert_not_null(Stub_Value_Notification, NULL);
+    zassert_equal(Stub_Value_Notification->callback,
+        bacnet_cov_client_value_save, NULL);
+    rp_data.object_type = OBJECT_BINARY_INPUT;
+    rp_data.object_instance = 3;
+    rp_data.object_property = PROP_PRESENT_VALUE;
+    data_value.tag = BACNET_APPLICATION_TAG_ENUMERATED;
+    data_value.type.Enumerated = 1;
+    Stub_Value_Notification->callback(1234, &rp_data, &data_value);
+    zassert_true(bacnet_cov_client_value(handle, &value), NULL);
+    zassert_equal(value.tag, BACNET_APPLICATION_TAG_ENUMERATED, NULL);
+    zassert_equal(value.type.Enumerated, 1, NULL);
+    zassert_false(value.cov, NULL);
+    /* values of other devices are ignored */
+    data_value.type.Enumerated = 0;
+    Stub_Value_Notification->callback(4321, &rp_data, &data_value);
+    zassert_true(bacnet_cov_client_value(handle, &value), NULL);
+    zassert_equal(value.type.Enumerated, 1, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(bac_cov_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(bac_cov_tests,
+     ztest_unit_test(test_cov_client_handle),
+     ztest_unit_test(test_cov_client_remove_waiting),
+     ztest_unit_test(test_cov_client_notification),
+     ztest_unit_test(test_cov_client_value_save)
+     );
+
+    ztest_run_test_suite(bac_cov_tests);
+}
+#endif
@@ -0,0 +1,156 @@
+/**
+ * @file
+ * @brief Stub functions for unit test of the COV client
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/cov.h"
+#include "bacnet/basic/services.h"
+#include "bacnet/basic/tsm/tsm.h"
+#include "bacnet/basic/client/bac-rw.h"
+
+/* milliseconds returned by mstimer_now() */
+unsigned long Stub_Milliseconds;
+/* invoke ID returned by the next Send_COV_Subscribe(), or 0 */
+uint8_t Stub_Invoke_ID = 1;
+/* the last SubscribeCOV request */
+BACNET_SUBSCRIBE_COV_DATA Stub_Subscribe_Data;
+unsigned Stub_Subscribe_Count;
+/* the transaction of the invoke ID is done */
+bool Stub_TSM_Free;
+/* the invoke ID freed by tsm_free_invoke_id() */
+uint8_t Stub_TSM_Freed_Invoke_ID;
+/* callbacks registered by the COV client */
+BACNET_COV_NOTIFICATION *Stub_COV_Notification;
+BACNET_READ_WRITE_VALUE_NOTIFICATION *Stub_Value_Notification;
+
+unsigned long mstimer_now(void)
+{
+    return Stub_Milliseconds;
+}
+
+uint8_t Send_COV_Subscribe(
+    uint32_t device_id, BACNET_SUBSCRIBE_COV_DATA *cov_data)
+{
+    (void)device_id;
+    Stub_Subscribe_Data = *cov_data;
+    Stub_Subscribe_Count++;
+
+    return Stub_Invoke_ID;
+}
+
+void Send_WhoIs(int32_t low_limit, int32_t high_limit)
+{
+    (void)low_limit;
+    (void)high_limit;
+}
+
+bool address_bind_request(
+    uint32_t device_id, unsigned *max_apdu, BACNET_ADDRESS *src)
+{
+    (void)device_id;
+    (void)src;
+    *max_apdu = MAX_APDU;
+
+    return true;
+}
+
+bool tsm_invoke_id_free(uint8_t invokeID)
+{
+    (void)invokeID;
+
+    return Stub_TSM_Free;
+}
+
+bool tsm_invoke_id_failed(uint8_t invokeID)
+{
+    (void)invokeID;
+
+    return false;
+}
+
+void tsm_free_invoke_id(uint8_t invokeID)
+{
+    Stub_TSM_Freed_Invoke_ID = invokeID;
+}
+
+void apdu_set_confirmed_simple_ack_handler(
+    BACNET_CONFIRMED_SERVICE service_choice,
+    confirmed_simple_ack_function pFunction)
+{
+    (void)service_choice;
+    (void)pFunction;
+}
+
+void apdu_set_confirmed_handler(
+    BACNET_CONFIRMED_SERVICE service_choice, confirmed_function pFunction)
+{
+    (void)service_choice;
+    (void)pFunction;
+}
+
+void apdu_set_unconfirmed_handler(
+    BACNET_UNCONFIRMED_SERVICE service_choice, unconfirmed_function pFunction)
+{
+    (void)service_choice;
+    (void)pFunction;
+}
+
+void handler_ccov_notification(uint8_t *service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS *src,
+    BACNET_CONFIRMED_SERVICE_DATA *service_data)
+{
+    (void)service_request;
+    (void)service_len;
+    (void)src;
+    (void)service_data;
+}
+
+void handler_ucov_notification(
+    uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
+{
+    (void)service_request;
+    (void)service_len;
+    (void)src;
+}
+
+void handler_ccov_notification_add(BACNET_COV_NOTIFICATION *callback)
+{
+    Stub_COV_Notification = callback;
+}
+
+void handler_ucov_notification_add(BACNET_COV_NOTIFICATION *callback)
+{
+    Stub_COV_Notification = callback;
+}
+
+bool bacnet_read_write_busy(void)
+{
+    return false;
+}
+
+bool bacnet_read_property_queue(uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    uint32_t array_index)
+{
+    (void)device_id;
+    (void)object_type;
+    (void)object_instance;
+    (void)object_property;
+    (void)array_index;
+
+    return true;
+}
+
+void bacnet_read_write_value_notification_add(
+    BACNET_READ_WRITE_VALUE_NOTIFICATION *notification)
+{
+    Stub_Value_Notification = notification;
+}
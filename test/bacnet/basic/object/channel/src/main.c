@@ -129,13 +129,142 @@ static void test_Channel_ReadProperty(void)
     status = Channel_Delete(instance);
     zassert_true(status, NULL);
 }
+
+static unsigned Write_Lookup_Count;
+static unsigned Write_Internal_Count;
+static uint8_t Write_Tag;
+
+static bool Write_Property_Lookup_Mock(BACNET_WRITE_PROPERTY_DATA *wp_data)
+{
+    Write_Lookup_Count++;
+    Write_Tag = wp_data->application_data[0] >> 4;
+
+    return true;
+}
+
+static bool Write_Property_Internal_Mock(BACNET_WRITE_PROPERTY_DATA *wp_data)
+{
+    Write_Internal_Count++;
+    Write_Tag = wp_data->application_data[0] >> 4;
+
+    return true;
+}
+
+static write_property_function Write_Property_Lookup(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    /* the Analog Output objects below 100 exist */
+    if ((object_type == OBJECT_ANALOG_OUTPUT) && (object_instance < 100)) {
+        return Write_Property_Lookup_Mock;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Test writing the present-value to the members
+ */
+static void test_Channel_Write_Members(void)
+{
+    BACNET_WRITE_PROPERTY_DATA wpdata = { 0 };
+    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE member = { 0 };
+    const uint32_t instance = 1;
+    unsigned count = 0;
+    unsigned index = 0;
+    unsigned m = 0;
+    bool status = false;
+
+    Channel_Init();
+    Channel_Create(instance);
+    Channel_Write_Property_Internal_Callback_Set(Write_Property_Internal_Mock);
+    Channel_Write_Property_Lookup_Callback_Set(Write_Property_Lookup);
+    count = Channel_Reference_List_Member_Count(instance);
+    zassert_true(count > 0, NULL);
+    /* more members than the initial size */
+    member.deviceIdentifier.type = OBJECT_DEVICE;
+    member.deviceIdentifier.instance = 1234;
+    member.propertyIdentifier = PROP_PRESENT_VALUE;
+    member.arrayIndex = BACNET_ARRAY_ALL;
+    for (m = 0; m < (count * 2); m++) {
+        if (m % 2) {
+            member.objectIdentifier.type = OBJECT_BINARY_OUTPUT;
+        } else {
+            member.objectIdentifier.type = OBJECT_ANALOG_OUTPUT;
+        }
+        member.objectIdentifier.instance = m;
+        index = Channel_Reference_List_Member_Element_Add(instance, &member);
+        zassert_equal(index, m + 1, NULL);
+    }
+    zassert_true(Channel_Reference_List_Member_Count(instance) >= m, NULL);
+    /* write the present-value, which is written to each member */
+    wpdata.object_type = OBJECT_CHANNEL;
+    wpdata.object_instance = instance;
+    wpdata.object_property = PROP_PRESENT_VALUE;
+    wpdata.array_index = BACNET_ARRAY_ALL;
+    wpdata.priority = 8;
+    wpdata.application_data_len =
+        encode_application_real(wpdata.application_data, 50.0f);
+    status = Channel_Write_Property(&wpdata);
+    zassert_true(status, NULL);
+    zassert_equal(Write_Lookup_Count, count, NULL);
+    zassert_equal(Write_Internal_Count, count, NULL);
+    zassert_equal(Write_Tag, BACNET_APPLICATION_TAG_ENUMERATED, NULL);
+    zassert_equal(Channel_Write_Status(instance),
+        BACNET_WRITE_STATUS_SUCCESSFUL, NULL);
+    /* a member that can't be written with a REAL */
+    member.objectIdentifier.type = OBJECT_COLOR;
+    member.objectIdentifier.instance = 1;
+    index = Channel_Reference_List_Member_Element_Add(instance, &member);
+    zassert_not_equal(index, 0, NULL);
+    Write_Lookup_Count = 0;
+    Write_Internal_Count = 0;
+    status = Channel_Write_Property(&wpdata);
+    zassert_true(status, NULL);
+    zassert_equal(Write_Lookup_Count, count, NULL);
+    zassert_equal(Write_Internal_Count, count, NULL);
+    zassert_equal(
+        Channel_Write_Status(instance), BACNET_WRITE_STATUS_FAILED, NULL);
+    /* fewer members */
+    status = Channel_Reference_List_Member_Count_Set(instance, 2);
+    zassert_true(status, NULL);
+    zassert_equal(Channel_Reference_List_Member_Count(instance), 2, NULL);
+    Write_Lookup_Count = 0;
+    Write_Internal_Count = 0;
+    status = Channel_Write_Property(&wpdata);
+    zassert_true(status, NULL);
+    zassert_equal(Write_Lookup_Count, 1, NULL);
+    zassert_equal(Write_Internal_Count, 1, NULL);
+    /* a member object that doesn't exist uses the internal callback */
+    member.objectIdentifier.type = OBJECT_ANALOG_OUTPUT;
+    member.objectIdentifier.instance = 100;
+    index = Channel_Reference_List_Member_Element_Add(instance, &member);
+    zassert_not_equal(index, 0, NULL);
+    Write_Lookup_Count = 0;
+    Write_Internal_Count = 0;
+    status = Channel_Write_Property(&wpdata);
+    zassert_true(status, NULL);
+    zassert_equal(Write_Lookup_Count, 1, NULL);
+    zassert_equal(Write_Internal_Count, 2, NULL);
+    /* another internal callback clears the lookup */
+    Channel_Write_Property_Internal_Callback_Set(Write_Property_Internal_Mock);
+    Write_Lookup_Count = 0;
+    Write_Internal_Count = 0;
+    status = Channel_Write_Property(&wpdata);
+    zassert_true(status, NULL);
+    zassert_equal(Write_Lookup_Count, 0, NULL);
+    zassert_equal(Write_Internal_Count, 3, NULL);
+    Channel_Write_Property_Lookup_Callback_Set(NULL);
+    Channel_Write_Property_Internal_Callback_Set(NULL);
+    Channel_Cleanup();
+}
 /**
  * @}
  */
 
 void test_main(void)
 {
-    ztest_test_suite(channel_tests, ztest_unit_test(test_Channel_ReadProperty));
+    ztest_test_suite(channel_tests, ztest_unit_test(test_Channel_ReadProperty),
+        ztest_unit_test(test_Channel_Write_Members));
 
     ztest_run_test_suite(channel_tests);
 }
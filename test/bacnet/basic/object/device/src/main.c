@@ -11,6 +11,7 @@
 #include <zephyr/ztest.h>
 #include <bacnet/basic/object/device.h>
 #include <bacnet/bactext.h>
+#include <bacnet/basic/object/netport.h>
 
 /**
  * @addtogroup bacnet_tests
@@ -117,6 +118,71 @@ static void test_Device_Data_Sharing(void)
     }
 }
 
+/**
+ * @brief Test the cached property lists of the object types
+ */
+static void test_Device_Objects_Property_List(void)
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    int len = 0;
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    BACNET_UNSIGNED_INTEGER unsigned_value = 0;
+    struct special_property_list_t property_list = { 0 };
+    const int *pRequired = NULL;
+    const int *pOptional = NULL;
+    const int *pProprietary = NULL;
+    uint32_t instance = 0;
+
+    Device_Init(NULL);
+    Device_Property_Lists(&pRequired, &pOptional, &pProprietary);
+    Device_Objects_Property_List(
+        OBJECT_DEVICE, Device_Object_Instance_Number(), &property_list);
+    zassert_equal(property_list.Required.pList, pRequired, NULL);
+    zassert_equal(property_list.Optional.pList, pOptional, NULL);
+    zassert_equal(property_list.Required.count,
+        property_list_count(pRequired), NULL);
+    zassert_equal(property_list.Optional.count,
+        property_list_count(pOptional), NULL);
+    zassert_equal(property_list.Proprietary.count,
+        property_list_count(pProprietary), NULL);
+    /* the Property_List property uses the same counts */
+    rpdata.application_data = &apdu[0];
+    rpdata.application_data_len = sizeof(apdu);
+    rpdata.object_type = OBJECT_DEVICE;
+    rpdata.object_instance = Device_Object_Instance_Number();
+    rpdata.object_property = PROP_PROPERTY_LIST;
+    rpdata.array_index = 0;
+    len = Device_Read_Property(&rpdata);
+    zassert_true(len > 0, NULL);
+    len = bacnet_unsigned_application_decode(
+        apdu, (uint32_t)len, &unsigned_value);
+    zassert_true(len > 0, NULL);
+    zassert_equal(unsigned_value,
+        property_list.Required.count + property_list.Optional.count +
+            property_list.Proprietary.count - 3,
+        NULL);
+    /* the Network Port optional properties follow its Network_Type,
+       which the datalink sets after Device_Init() */
+    instance = Network_Port_Index_To_Instance(0);
+    zassert_true(Network_Port_Type_Set(instance, PORT_TYPE_BIP), NULL);
+    Network_Port_Property_List(instance, NULL, &pOptional, NULL);
+    Device_Objects_Property_List(OBJECT_NETWORK_PORT, instance,
+        &property_list);
+    zassert_equal(property_list.Optional.pList, pOptional, NULL);
+    zassert_true(Network_Port_Type_Set(instance, PORT_TYPE_MSTP), NULL);
+    Network_Port_Property_List(instance, NULL, &pOptional, NULL);
+    Device_Objects_Property_List(OBJECT_NETWORK_PORT, instance,
+        &property_list);
+    zassert_equal(property_list.Optional.pList, pOptional, NULL);
+    zassert_equal(property_list.Optional.count,
+        property_list_count(pOptional), NULL);
+    /* unknown object types have no properties */
+    Device_Objects_Property_List(OBJECT_PROPRIETARY_MIN, 0, &property_list);
+    zassert_equal(property_list.Required.count, 0, NULL);
+    zassert_equal(property_list.Optional.count, 0, NULL);
+    zassert_equal(property_list.Proprietary.count, 0, NULL);
+}
+
 /**
  * @brief Test basic API
  */
@@ -220,7 +286,8 @@ ZTEST_SUITE(device_tests, NULL, NULL, NULL, NULL, NULL);
 void test_main(void)
 {
     ztest_test_suite(device_tests, ztest_unit_test(testDevice),
-        ztest_unit_test(test_Device_Data_Sharing));
+        ztest_unit_test(test_Device_Data_Sharing),
+        ztest_unit_test(test_Device_Objects_Property_List));
 
     ztest_run_test_suite(device_tests);
 }
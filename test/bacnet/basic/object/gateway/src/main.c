@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief Unit test for the gateway routed Device table
+ * @date October 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+#include <bacnet/bacaddr.h>
+#include <bacnet/basic/object/device.h>
+
+/* stubs for the Device object that the routed Devices extend */
+int Device_Read_Property_Local(BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    (void)rpdata;
+    return BACNET_STATUS_ERROR;
+}
+
+bool Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data)
+{
+    (void)wp_data;
+    return false;
+}
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+/**
+ * @brief Test
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(gateway_tests, testRoutedDevices)
+#else
+static void testRoutedDevices(void)
+#endif
+{
+    const uint32_t first_instance = 1000;
+    const uint16_t dnet = 2709;
+    int DNET_list[2] = { dnet, -1 };
+    BACNET_ADDRESS address = { 0 };
+    BACNET_ADDRESS dest = { 0 };
+    DEVICE_OBJECT_DATA *pDev = NULL;
+    uint32_t instance = 0;
+    uint16_t idx = 0;
+    int cursor = 0;
+    int count = 0;
+    int i = 0;
+
+    /* the gateway, then the routed Devices in reverse instance order */
+    idx = Add_Routed_Device(first_instance, NULL, NULL);
+    zassert_equal(idx, 0, NULL);
+    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+        instance = first_instance + MAX_NUM_DEVICES - i;
+        idx = Add_Routed_Device(instance, NULL, NULL);
+        zassert_equal(idx, i, NULL);
+    }
+    /* table is full */
+    idx = Add_Routed_Device(first_instance + MAX_NUM_DEVICES, NULL, NULL);
+    zassert_equal(idx, UINT16_MAX, NULL);
+    zassert_is_null(Get_Routed_Device_Object(MAX_NUM_DEVICES), NULL);
+    /* lookup by instance */
+    zassert_true(Routed_Device_Valid_Object_Instance_Number(
+        first_instance + 1), NULL);
+    zassert_equal(Routed_Device_Object_Instance_Number(),
+        first_instance + 1, NULL);
+    zassert_false(Routed_Device_Valid_Object_Instance_Number(
+        first_instance + MAX_NUM_DEVICES), NULL);
+    /* virtual MAC addresses, set directly and through the pointer */
+    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+        address.net = dnet;
+        address.len = 3;
+        address.adr[0] = 0;
+        address.adr[1] = 0;
+        address.adr[2] = i;
+        if (i & 1) {
+            zassert_true(Routed_Device_Address_Set(i, &address), NULL);
+        } else {
+            pDev = Get_Routed_Device_Object(i);
+            zassert_not_null(pDev, NULL);
+            bacnet_address_copy(&pDev->bacDevAddr, &address);
+        }
+    }
+    zassert_false(Routed_Device_Address_Set(MAX_NUM_DEVICES, &address), NULL);
+    /* lookup by virtual MAC */
+    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+        dest.net = dnet;
+        dest.len = 3;
+        dest.adr[0] = 0;
+        dest.adr[1] = 0;
+        dest.adr[2] = i;
+        cursor = 0;
+        zassert_true(Routed_Device_GetNext(&dest, DNET_list, &cursor), NULL);
+        zassert_equal(cursor, -1, NULL);
+        zassert_equal(Routed_Device_Object_Instance_Number(),
+            first_instance + MAX_NUM_DEVICES - i, NULL);
+    }
+    dest.adr[2] = MAX_NUM_DEVICES;
+    cursor = 0;
+    zassert_false(Routed_Device_GetNext(&dest, DNET_list, &cursor), NULL);
+    /* change a virtual MAC */
+    address.adr[2] = 0xFF;
+    zassert_true(Routed_Device_Address_Set(1, &address), NULL);
+    dest.adr[2] = 1;
+    cursor = 0;
+    zassert_false(Routed_Device_GetNext(&dest, DNET_list, &cursor), NULL);
+    dest.adr[2] = 0xFF;
+    cursor = 0;
+    zassert_true(Routed_Device_GetNext(&dest, DNET_list, &cursor), NULL);
+    zassert_equal(Routed_Device_Object_Instance_Number(),
+        first_instance + MAX_NUM_DEVICES - 1, NULL);
+    /* change a virtual MAC through the pointer */
+    pDev = Get_Routed_Device_Object(2);
+    zassert_not_null(pDev, NULL);
+    pDev->bacDevAddr.adr[2] = 0xFE;
+    dest.adr[2] = 0xFE;
+    cursor = 0;
+    zassert_true(Routed_Device_GetNext(&dest, DNET_list, &cursor), NULL);
+    zassert_equal(Routed_Device_Object_Instance_Number(),
+        first_instance + MAX_NUM_DEVICES - 2, NULL);
+    dest.adr[2] = 2;
+    cursor = 0;
+    zassert_false(Routed_Device_GetNext(&dest, DNET_list, &cursor), NULL);
+    /* broadcast on the virtual network visits every routed Device */
+    dest.len = 0;
+    cursor = 0;
+    count = 0;
+    while (Routed_Device_GetNext(&dest, DNET_list, &cursor)) {
+        count++;
+    }
+    zassert_equal(count, MAX_NUM_DEVICES - 1, NULL);
+    /* Who-Is range, in instance order */
+    cursor = 0;
+    count = 0;
+    instance = first_instance + 2;
+    while (Routed_Device_GetNext_Instance(
+        first_instance + 2, first_instance + 5, &cursor)) {
+        zassert_equal(Routed_Device_Object_Instance_Number(), instance, NULL);
+        instance++;
+        count++;
+    }
+    zassert_equal(count, 4, NULL);
+    cursor = 0;
+    count = 0;
+    while (Routed_Device_GetNext_Instance(0, BACNET_MAX_INSTANCE, &cursor)) {
+        count++;
+    }
+    zassert_equal(count, MAX_NUM_DEVICES, NULL);
+    cursor = 0;
+    zassert_false(Routed_Device_GetNext_Instance(
+        first_instance + MAX_NUM_DEVICES, BACNET_MAX_INSTANCE, &cursor), NULL);
+    /* change an instance */
+    zassert_not_null(Get_Routed_Device_Object(1), NULL);
+    instance = Routed_Device_Object_Instance_Number();
+    zassert_false(Routed_Device_Set_Object_Instance_Number(first_instance),
+        NULL);
+    zassert_true(Routed_Device_Set_Object_Instance_Number(
+        first_instance + 100), NULL);
+    zassert_false(Routed_Device_Valid_Object_Instance_Number(instance), NULL);
+    zassert_true(Routed_Device_Valid_Object_Instance_Number(
+        first_instance + 100), NULL);
+    idx = Add_Routed_Device(first_instance + 100, NULL, NULL);
+    zassert_equal(idx, UINT16_MAX, NULL);
+}
+
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(gateway_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(gateway_tests, ztest_unit_test(testRoutedDevices));
+
+    ztest_run_test_suite(gateway_tests);
+}
+#endif
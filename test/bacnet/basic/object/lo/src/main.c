@@ -8,6 +8,7 @@
  * @brief test BACnet integer encode/decode APIs
  */
 
+#include <math.h>
 #include <zephyr/ztest.h>
 #include <bacnet/bactext.h>
 #include <bacnet/basic/object/lo.h>
@@ -131,6 +132,332 @@ static void testLightingOutput(void)
 
     return;
 }
+
+/**
+ * @brief Test the fade and ramp transitions of the timer wheel
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(lo_tests, testLightingOutputTransition)
+#else
+static void testLightingOutputTransition(void)
+#endif
+{
+    const uint32_t instance = 123;
+    BACNET_LIGHTING_COMMAND command = { 0 };
+    float value;
+    unsigned i;
+    bool status;
+
+    Lighting_Output_Init();
+    Lighting_Output_Create(instance);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    /* fade from 0% to 100% in one second */
+    status = Lighting_Output_Present_Value_Set(instance, 100.0f, 16);
+    zassert_true(status, NULL);
+    command.operation = BACNET_LIGHTS_FADE_TO;
+    command.use_target_level = true;
+    command.target_level = 100.0f;
+    command.use_fade_time = true;
+    command.fade_time = 1000;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_true(Lighting_Output_Change_Of_Value(instance), NULL);
+    Lighting_Output_Change_Of_Value_Clear(instance);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 1, NULL);
+    zassert_equal(Lighting_Output_In_Progress(instance),
+        BACNET_LIGHTING_FADE_ACTIVE, NULL);
+    for (i = 0; i < 50; i++) {
+        Lighting_Output_Transition_Timer(10);
+    }
+    value = Lighting_Output_Tracking_Value(instance);
+    zassert_true((value > 49.0f) && (value <= 50.0f), "value=%f", value);
+    for (i = 0; i < 50; i++) {
+        Lighting_Output_Transition_Timer(10);
+    }
+    value = Lighting_Output_Tracking_Value(instance);
+    zassert_false(islessgreater(value, 100.0f), "value=%f", value);
+    zassert_equal(
+        Lighting_Output_In_Progress(instance), BACNET_LIGHTING_IDLE, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    zassert_false(Lighting_Output_Change_Of_Value(instance), NULL);
+    /* ramp from 100% down to 0% at 50% per second */
+    status = Lighting_Output_Present_Value_Set(instance, 0.0f, 16);
+    zassert_true(status, NULL);
+    command.operation = BACNET_LIGHTS_RAMP_TO;
+    command.target_level = 0.0f;
+    command.use_fade_time = false;
+    command.use_ramp_rate = true;
+    command.ramp_rate = 50.0f;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_true(Lighting_Output_Change_Of_Value(instance), NULL);
+    zassert_equal(Lighting_Output_In_Progress(instance),
+        BACNET_LIGHTING_RAMP_ACTIVE, NULL);
+    Lighting_Output_Transition_Timer(1000);
+    value = Lighting_Output_Tracking_Value(instance);
+    zassert_true((value >= 50.0f) && (value < 51.0f), "value=%f", value);
+    Lighting_Output_Transition_Timer(1000);
+    Lighting_Output_Transition_Timer(10);
+    value = Lighting_Output_Tracking_Value(instance);
+    zassert_false(islessgreater(value, 0.0f), "value=%f", value);
+    zassert_equal(
+        Lighting_Output_In_Progress(instance), BACNET_LIGHTING_IDLE, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    /* deleting an object removes its transition */
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    command.target_level = 100.0f;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 1, NULL);
+    status = Lighting_Output_Delete(instance);
+    zassert_true(status, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    Lighting_Output_Transition_Timer(10);
+    Lighting_Output_Cleanup();
+}
+
+static uint32_t Restart_Instance;
+static unsigned Restart_Count;
+
+/**
+ * @brief Start a new fade from the present value callback, once
+ */
+static void test_restart_callback(
+    uint32_t object_instance, float old_value, float value)
+{
+    BACNET_LIGHTING_COMMAND command = { 0 };
+
+    (void)old_value;
+    (void)value;
+    if ((object_instance == Restart_Instance) && (Restart_Count == 0)) {
+        Restart_Count++;
+        command.operation = BACNET_LIGHTS_FADE_TO;
+        command.target_level = 50.0f;
+        command.fade_time = 100;
+        Lighting_Output_Lighting_Command_Set(object_instance, &command);
+    }
+}
+
+/**
+ * @brief Test the warn and step commands, and a transition restarted
+ *  from the present value callback
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(lo_tests, testLightingOutputWarn)
+#else
+static void testLightingOutputWarn(void)
+#endif
+{
+    const uint32_t instance = 123;
+    BACNET_LIGHTING_COMMAND command = { 0 };
+    BACNET_WRITE_PROPERTY_DATA wpdata = { 0 };
+    float value;
+    unsigned i;
+    bool status;
+
+    Lighting_Output_Init();
+    Lighting_Output_Create(instance);
+    Lighting_Output_Blink_Warn_Enable_Set(instance, true);
+    Lighting_Output_Egress_Time_Set(instance, 2);
+    status = Lighting_Output_Present_Value_Set(instance, 80.0f, 8);
+    zassert_true(status, NULL);
+    /* WARN_OFF written as the special value -3.0 at priority 8 */
+    wpdata.object_type = OBJECT_LIGHTING_OUTPUT;
+    wpdata.object_instance = instance;
+    wpdata.object_property = PROP_PRESENT_VALUE;
+    wpdata.array_index = BACNET_ARRAY_ALL;
+    wpdata.priority = 8;
+    wpdata.application_data_len =
+        encode_application_real(wpdata.application_data, -3.0f);
+    status = Lighting_Output_Write_Property(&wpdata);
+    zassert_true(status, NULL);
+    zassert_true(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(
+        Lighting_Output_In_Progress(instance), BACNET_LIGHTING_OTHER, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 1, NULL);
+    Lighting_Output_Transition_Timer(1000);
+    Lighting_Output_Transition_Timer(990);
+    zassert_true(Lighting_Output_Egress_Active(instance), NULL);
+    value = Lighting_Output_Present_Value(instance);
+    zassert_false(islessgreater(value, 80.0f), "value=%f", value);
+    Lighting_Output_Transition_Timer(20);
+    zassert_false(Lighting_Output_Egress_Active(instance), NULL);
+    value = Lighting_Output_Present_Value(instance);
+    zassert_false(islessgreater(value, 0.0f), "value=%f", value);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 8, NULL);
+    zassert_equal(Lighting_Output_In_Progress(instance),
+        BACNET_LIGHTING_FADE_ACTIVE, NULL);
+    for (i = 0; i < 20; i++) {
+        Lighting_Output_Transition_Timer(10);
+    }
+    zassert_equal(
+        Lighting_Output_In_Progress(instance), BACNET_LIGHTING_IDLE, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    /* WARN_RELINQUISH without blink-warn relinquishes at the next tick */
+    Lighting_Output_Blink_Warn_Enable_Set(instance, false);
+    command.operation = BACNET_LIGHTS_WARN_RELINQUISH;
+    command.use_priority = true;
+    command.priority = 8;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_true(Lighting_Output_Egress_Active(instance), NULL);
+    Lighting_Output_Transition_Timer(10);
+    zassert_false(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 0, NULL);
+    /* WARN leaves the level as it is */
+    command.operation = BACNET_LIGHTS_WARN;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_equal(
+        Lighting_Output_In_Progress(instance), BACNET_LIGHTING_IDLE, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    /* a step is applied at the next tick */
+    command.operation = BACNET_LIGHTS_STEP_UP;
+    command.use_priority = false;
+    command.step_increment = 1.0f;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_equal(
+        Lighting_Output_In_Progress(instance), BACNET_LIGHTING_OTHER, NULL);
+    Lighting_Output_Transition_Timer(10);
+    zassert_equal(
+        Lighting_Output_In_Progress(instance), BACNET_LIGHTING_IDLE, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    /* a callback that starts a new fade does not queue the object twice */
+    Restart_Instance = instance;
+    Restart_Count = 0;
+    Lighting_Output_Write_Present_Value_Callback_Set(test_restart_callback);
+    command.operation = BACNET_LIGHTS_FADE_TO;
+    command.target_level = 100.0f;
+    command.fade_time = 10;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    Lighting_Output_Transition_Timer(10);
+    zassert_equal(Restart_Count, 1, NULL);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 1, NULL);
+    zassert_equal(Lighting_Output_In_Progress(instance),
+        BACNET_LIGHTING_FADE_ACTIVE, NULL);
+    for (i = 0; i < 20; i++) {
+        Lighting_Output_Transition_Timer(10);
+    }
+    value = Lighting_Output_Tracking_Value(instance);
+    zassert_false(islessgreater(value, 50.0f), "value=%f", value);
+    zassert_equal(Lighting_Output_Transition_Active_Count(), 0, NULL);
+    Lighting_Output_Write_Present_Value_Callback_Set(NULL);
+    Lighting_Output_Cleanup();
+}
+
+/**
+ * @brief Write a Present_Value special value at a priority
+ * @param instance - object instance
+ * @param value - special value: -1.0 WARN, -2.0 WARN_RELINQUISH,
+ *  or -3.0 WARN_OFF
+ * @param priority - BACnet priority 1..16
+ */
+static void test_special_value_write(
+    uint32_t instance, float value, uint8_t priority)
+{
+    BACNET_WRITE_PROPERTY_DATA wpdata = { 0 };
+    bool status;
+
+    wpdata.object_type = OBJECT_LIGHTING_OUTPUT;
+    wpdata.object_instance = instance;
+    wpdata.object_property = PROP_PRESENT_VALUE;
+    wpdata.array_index = BACNET_ARRAY_ALL;
+    wpdata.priority = priority;
+    wpdata.application_data_len =
+        encode_application_real(wpdata.application_data, value);
+    status = Lighting_Output_Write_Property(&wpdata);
+    zassert_true(status, NULL);
+}
+
+/**
+ * @brief Test when the Present_Value special values blink-warn, and when
+ *  they act at once
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(lo_tests, testLightingOutputWarnSpecialValues)
+#else
+static void testLightingOutputWarnSpecialValues(void)
+#endif
+{
+    const uint32_t instance = 123;
+    BACNET_LIGHTING_COMMAND command = { 0 };
+    float value;
+    bool status;
+
+    Lighting_Output_Init();
+    Lighting_Output_Create(instance);
+    Lighting_Output_Blink_Warn_Enable_Set(instance, true);
+    Lighting_Output_Egress_Time_Set(instance, 2);
+    /* WARN: blink-warn at the highest active priority */
+    status = Lighting_Output_Present_Value_Set(instance, 80.0f, 8);
+    zassert_true(status, NULL);
+    test_special_value_write(instance, -1.0f, 8);
+    status = Lighting_Output_Lighting_Command(instance, &command);
+    zassert_true(status, NULL);
+    zassert_equal(command.operation, BACNET_LIGHTS_WARN, NULL);
+    zassert_equal(command.priority, 8, NULL);
+    /* WARN: no blink-warn when Blink_Warn_Enable is FALSE */
+    command.operation = BACNET_LIGHTS_STOP;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    Lighting_Output_Blink_Warn_Enable_Set(instance, false);
+    test_special_value_write(instance, -1.0f, 8);
+    status = Lighting_Output_Lighting_Command(instance, &command);
+    zassert_true(status, NULL);
+    zassert_equal(command.operation, BACNET_LIGHTS_STOP, NULL);
+    /* WARN_RELINQUISH: relinquished at once when Blink_Warn_Enable
+       is FALSE */
+    test_special_value_write(instance, -2.0f, 8);
+    zassert_false(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 0, NULL);
+    /* WARN_RELINQUISH: relinquished at once when the next lower
+       priority would keep the light on */
+    Lighting_Output_Blink_Warn_Enable_Set(instance, true);
+    status = Lighting_Output_Present_Value_Set(instance, 50.0f, 10);
+    zassert_true(status, NULL);
+    status = Lighting_Output_Present_Value_Set(instance, 80.0f, 8);
+    zassert_true(status, NULL);
+    test_special_value_write(instance, -2.0f, 8);
+    zassert_false(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 10, NULL);
+    /* WARN_RELINQUISH: blink-warn when the light would go off */
+    status = Lighting_Output_Present_Value_Relinquish(instance, 10);
+    zassert_true(status, NULL);
+    status = Lighting_Output_Present_Value_Set(instance, 80.0f, 8);
+    zassert_true(status, NULL);
+    test_special_value_write(instance, -2.0f, 8);
+    zassert_true(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 8, NULL);
+    Lighting_Output_Transition_Timer(1000);
+    Lighting_Output_Transition_Timer(1010);
+    zassert_false(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 0, NULL);
+    /* WARN_OFF: 0.0% at once when the priority is not the highest */
+    status = Lighting_Output_Present_Value_Set(instance, 60.0f, 4);
+    zassert_true(status, NULL);
+    status = Lighting_Output_Present_Value_Set(instance, 80.0f, 8);
+    zassert_true(status, NULL);
+    test_special_value_write(instance, -3.0f, 8);
+    zassert_false(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 4, NULL);
+    status = Lighting_Output_Present_Value_Relinquish(instance, 4);
+    zassert_true(status, NULL);
+    value = Lighting_Output_Present_Value(instance);
+    zassert_false(islessgreater(value, 0.0f), "value=%f", value);
+    /* WARN_OFF: 0.0% at once when Blink_Warn_Enable is FALSE */
+    Lighting_Output_Blink_Warn_Enable_Set(instance, false);
+    status = Lighting_Output_Present_Value_Set(instance, 80.0f, 8);
+    zassert_true(status, NULL);
+    test_special_value_write(instance, -3.0f, 8);
+    zassert_false(Lighting_Output_Egress_Active(instance), NULL);
+    zassert_equal(Lighting_Output_Present_Value_Priority(instance), 8, NULL);
+    value = Lighting_Output_Present_Value(instance);
+    zassert_false(islessgreater(value, 0.0f), "value=%f", value);
+    Lighting_Output_Cleanup();
+}
 /**
  * @}
  */
@@ -142,7 +469,10 @@ ZTEST_SUITE(lo_tests, NULL, NULL, NULL, NULL, NULL);
 void test_main(void)
 {
     ztest_test_suite(lo_tests,
-     ztest_unit_test(testLightingOutput)
+     ztest_unit_test(testLightingOutput),
+     ztest_unit_test(testLightingOutputTransition),
+     ztest_unit_test(testLightingOutputWarn),
+     ztest_unit_test(testLightingOutputWarnSpecialValues)
      );
 
     ztest_run_test_suite(lo_tests);
@@ -126,6 +126,93 @@ static void test_Notification_Class(void)
 
     return;
 }
+
+extern bool Stub_TSM_Transaction_Available;
+extern unsigned Stub_CEvent_Notify_Count;
+extern uint8_t Stub_CEvent_Notify_Invoke_ID;
+extern bool Stub_DCC_Communication_Enabled;
+
+/**
+ * @brief Test the confirmed event notification queue
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(notification_class_tests, test_Notification_Class_Event_Queue)
+#else
+static void test_Notification_Class_Event_Queue(void)
+#endif
+{
+    BACNET_ADDRESS dest = { 0 };
+    uint8_t body[16] = { 0 };
+    unsigned i;
+    bool status;
+
+    Notification_Class_Init();
+    Stub_CEvent_Notify_Count = 0;
+    /* free transaction - sent immediately */
+    Stub_TSM_Transaction_Available = true;
+    status = Notification_Class_Event_Queue_Send(
+        &dest, MAX_APDU, 1, body, sizeof(body));
+    zassert_true(status, NULL);
+    zassert_equal(Stub_CEvent_Notify_Count, 1, NULL);
+    zassert_equal(Notification_Class_Event_Queue_Count(), 0, NULL);
+    /* no free transaction - queued until the queue is full */
+    Stub_TSM_Transaction_Available = false;
+    for (i = 0; i < NC_EVENT_QUEUE_SIZE; i++) {
+        status = Notification_Class_Event_Queue_Send(
+            &dest, MAX_APDU, i, body, sizeof(body));
+        zassert_true(status, NULL);
+    }
+    zassert_equal(Notification_Class_Event_Queue_Count(),
+        NC_EVENT_QUEUE_SIZE, NULL);
+    status = Notification_Class_Event_Queue_Send(
+        &dest, MAX_APDU, 1, body, sizeof(body));
+    zassert_false(status, NULL);
+    zassert_equal(Notification_Class_Event_Queue_Dropped(), 1, NULL);
+    zassert_equal(Stub_CEvent_Notify_Count, 1, NULL);
+    /* failed sends stay in the queue */
+    Stub_TSM_Transaction_Available = true;
+    Stub_CEvent_Notify_Invoke_ID = 0;
+    Notification_Class_Event_Queue_Task();
+    zassert_equal(Notification_Class_Event_Queue_Count(),
+        NC_EVENT_QUEUE_SIZE, NULL);
+    /* free transactions - the queue drains */
+    Stub_CEvent_Notify_Invoke_ID = 1;
+    Notification_Class_Event_Queue_Task();
+    zassert_equal(Notification_Class_Event_Queue_Count(), 0, NULL);
+    zassert_equal(Stub_CEvent_Notify_Count, 1 + NC_EVENT_QUEUE_SIZE, NULL);
+    /* a notification that fails to be sent at once is queued */
+    Stub_CEvent_Notify_Invoke_ID = 0;
+    status = Notification_Class_Event_Queue_Send(
+        &dest, MAX_APDU, 1, body, sizeof(body));
+    zassert_true(status, NULL);
+    zassert_equal(Notification_Class_Event_Queue_Count(), 1, NULL);
+    Stub_CEvent_Notify_Invoke_ID = 1;
+    Notification_Class_Event_Queue_Task();
+    zassert_equal(Notification_Class_Event_Queue_Count(), 0, NULL);
+    zassert_equal(Stub_CEvent_Notify_Count, 2 + NC_EVENT_QUEUE_SIZE, NULL);
+    /* a notification larger than the recipient accepts is dropped */
+    status =
+        Notification_Class_Event_Queue_Send(&dest, 4, 1, body, sizeof(body));
+    zassert_false(status, NULL);
+    zassert_equal(Notification_Class_Event_Queue_Count(), 0, NULL);
+    zassert_equal(Stub_CEvent_Notify_Count, 2 + NC_EVENT_QUEUE_SIZE, NULL);
+    /* communication disabled - dropped, not deferred */
+    Stub_TSM_Transaction_Available = false;
+    status = Notification_Class_Event_Queue_Send(
+        &dest, MAX_APDU, 1, body, sizeof(body));
+    zassert_true(status, NULL);
+    zassert_equal(Notification_Class_Event_Queue_Count(), 1, NULL);
+    Stub_DCC_Communication_Enabled = false;
+    status = Notification_Class_Event_Queue_Send(
+        &dest, MAX_APDU, 1, body, sizeof(body));
+    zassert_false(status, NULL);
+    Notification_Class_Event_Queue_Task();
+    zassert_equal(Notification_Class_Event_Queue_Count(), 0, NULL);
+    Stub_DCC_Communication_Enabled = true;
+    Stub_TSM_Transaction_Available = true;
+    Notification_Class_Event_Queue_Task();
+    zassert_equal(Stub_CEvent_Notify_Count, 2 + NC_EVENT_QUEUE_SIZE, NULL);
+}
 /**
  * @}
  */
@@ -137,7 +224,8 @@ ZTEST_SUITE(notification_class_tests, NULL, NULL, NULL, NULL, NULL);
 void test_main(void)
 {
     ztest_test_suite(notification_class_tests,
-     ztest_unit_test(test_Notification_Class)
+     ztest_unit_test(test_Notification_Class),
+     ztest_unit_test(test_Notification_Class_Event_Queue)
      );
 
     ztest_run_test_suite(notification_class_tests);
@@ -18,21 +18,60 @@ uint32_t Device_Object_Instance_Number(void)
     return 0;
 }
 
-int Send_UEvent_Notify(
-    uint8_t *buffer, BACNET_EVENT_NOTIFICATION_DATA *data, BACNET_ADDRESS *dest)
+/* transaction state machine availability used by the test */
+bool Stub_TSM_Transaction_Available = true;
+/* number of confirmed event notifications sent */
+unsigned Stub_CEvent_Notify_Count;
+/* invoke ID returned when sending, or 0 when the send fails */
+uint8_t Stub_CEvent_Notify_Invoke_ID = 1;
+/* number of unconfirmed event notifications sent */
+unsigned Stub_UEvent_Notify_Count;
+/* communication state set by DeviceCommunicationControl */
+bool Stub_DCC_Communication_Enabled = true;
+
+bool dcc_communication_enabled(void)
+{
+    return Stub_DCC_Communication_Enabled;
+}
+
+bool tsm_transaction_available(void)
+{
+    return Stub_TSM_Transaction_Available;
+}
+
+int Send_UEvent_Notify_Body(uint8_t *buffer,
+    uint32_t process_id,
+    uint8_t *body,
+    unsigned body_len,
+    BACNET_ADDRESS *dest)
 {
     (void)buffer;
-    (void)data;
+    (void)process_id;
+    (void)body;
     (void)dest;
-    return 0;
+    Stub_UEvent_Notify_Count++;
+    return (int)body_len;
 }
 
-uint8_t Send_CEvent_Notify(
-    uint32_t device_id, BACNET_EVENT_NOTIFICATION_DATA *data)
+uint8_t Send_CEvent_Notify_Body(uint8_t *pdu,
+    uint16_t pdu_size,
+    uint32_t process_id,
+    uint8_t *body,
+    unsigned body_len,
+    BACNET_ADDRESS *dest,
+    unsigned max_apdu)
 {
-    (void)device_id;
-    (void)data;
-    return 0;
+    (void)pdu;
+    (void)pdu_size;
+    (void)process_id;
+    (void)body;
+    (void)body_len;
+    (void)dest;
+    (void)max_apdu;
+    if (Stub_CEvent_Notify_Invoke_ID) {
+        Stub_CEvent_Notify_Count++;
+    }
+    return Stub_CEvent_Notify_Invoke_ID;
 }
 
 void Send_WhoIs(int32_t low_limit, int32_t high_limit)
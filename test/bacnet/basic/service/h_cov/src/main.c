@@ -0,0 +1,267 @@
+/**
+ * @file
+ * @brief Unit test for the SubscribeCOVProperty and
+ *  SubscribeCOVPropertyMultiple handlers and their notifications
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/bacapp.h>
+#include <bacnet/cov.h>
+#include <bacnet/npdu.h>
+#include <bacnet/rp.h>
+#include <bacnet/basic/object/device.h>
+#include <bacnet/basic/service/h_cov.h>
+
+extern uint8_t Stub_PDU[MAX_PDU];
+extern int Stub_PDU_Len;
+extern float Stub_Relinquish_Value;
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+/* the monitored object of the stubs */
+static BACNET_OBJECT_ID Test_Object_Id = { OBJECT_ANALOG_OUTPUT, 1 };
+static BACNET_ADDRESS Test_Src = { 1, { 1 }, 0, 0, { 0 } };
+
+/**
+ * @brief Get the APDU of the last PDU sent
+ * @return APDU length
+ */
+static int test_sent_apdu(uint8_t **apdu)
+{
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    int len = 0;
+
+    zassert_true(Stub_PDU_Len > 0, NULL);
+    len = npdu_decode(&Stub_PDU[0], NULL, NULL, &npdu_data);
+    zassert_true(len > 0, NULL);
+    *apdu = &Stub_PDU[len];
+
+    return Stub_PDU_Len - len;
+}
+
+/**
+ * @brief Check that the last PDU sent is a Simple-ACK of a service
+ */
+static void test_simple_ack(BACNET_CONFIRMED_SERVICE service)
+{
+    uint8_t *apdu = NULL;
+    int apdu_len = 0;
+
+    apdu_len = test_sent_apdu(&apdu);
+    zassert_equal(apdu_len, 3, NULL);
+    zassert_equal(apdu[0], PDU_TYPE_SIMPLE_ACK, NULL);
+    zassert_equal(apdu[2], service, NULL);
+}
+
+/**
+ * @brief Run the COV task until a notification is sent
+ */
+static void test_cov_notification_wait(void)
+{
+    unsigned i;
+
+    Stub_PDU_Len = 0;
+    for (i = 0; (i < 1000) && (Stub_PDU_Len == 0); i++) {
+        handler_cov_fsm();
+    }
+    zassert_true(Stub_PDU_Len > 0, NULL);
+}
+
+/**
+ * @brief Read the whole Priority_Array encoded by the stubs
+ * @return number of bytes encoded
+ */
+static int test_priority_array(uint8_t *apdu, unsigned apdu_size)
+{
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+
+    rpdata.object_type = Test_Object_Id.type;
+    rpdata.object_instance = Test_Object_Id.instance;
+    rpdata.object_property = PROP_PRIORITY_ARRAY;
+    rpdata.array_index = BACNET_ARRAY_ALL;
+    rpdata.application_data = apdu;
+    rpdata.application_data_len = apdu_size;
+
+    return Device_Read_Property(&rpdata);
+}
+
+/* values seen by the notification decoder callback */
+struct cov_notify_test {
+    unsigned count;
+    BACNET_PROPERTY_ID property[2];
+    BACNET_COMPACT_VALUE value[2];
+};
+
+static bool test_cov_notify_callback(void *context,
+    uint32_t device_id,
+    BACNET_OBJECT_ID *object_id,
+    BACNET_PROPERTY_ID property,
+    BACNET_ARRAY_INDEX array_index,
+    BACNET_COMPACT_VALUE *value,
+    uint8_t priority)
+{
+    struct cov_notify_test *test = context;
+
+    zassert_equal(device_id, Device_Object_Instance_Number(), NULL);
+    zassert_equal(object_id->type, Test_Object_Id.type, NULL);
+    zassert_equal(object_id->instance, Test_Object_Id.instance, NULL);
+    zassert_equal(array_index, BACNET_ARRAY_ALL, NULL);
+    zassert_equal(priority, BACNET_NO_PRIORITY, NULL);
+    if (test->count < 2) {
+        test->property[test->count] = property;
+        test->value[test->count] = *value;
+    }
+    test->count++;
+
+    return true;
+}
+
+/**
+ * @brief Check that the last PDU sent is a COV notification with the
+ *  whole Priority_Array and the Status_Flags
+ */
+static void test_cov_notify_priority_array(void)
+{
+    uint8_t value_apdu[MAX_APDU] = { 0 };
+    struct cov_notify_test test = { 0 };
+    uint32_t process_id = 0;
+    uint8_t *apdu = NULL;
+    int apdu_len = 0;
+    int value_len = 0;
+    int len = 0;
+
+    apdu_len = test_sent_apdu(&apdu);
+    zassert_equal(apdu[0], PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST, NULL);
+    zassert_equal(apdu[1], SERVICE_UNCONFIRMED_COV_NOTIFICATION, NULL);
+    len = cov_notify_decode_values(&apdu[2], apdu_len - 2, &process_id, NULL,
+        test_cov_notify_callback, &test);
+    zassert_equal(len, apdu_len - 2, NULL);
+    zassert_equal(process_id, 1, NULL);
+    zassert_equal(test.count, 2, NULL);
+    zassert_equal(test.property[0], PROP_PRIORITY_ARRAY, NULL);
+    /* all 16 elements, not only the first one */
+    value_len = test_priority_array(value_apdu, sizeof(value_apdu));
+    zassert_true(test.value[0].encoded, NULL);
+    zassert_equal(test.value[0].type.Encoding.length, value_len, NULL);
+    zassert_mem_equal(
+        test.value[0].type.Encoding.data, value_apdu, value_len, NULL);
+    zassert_equal(test.property[1], PROP_STATUS_FLAGS, NULL);
+    zassert_equal(test.value[1].tag, BACNET_APPLICATION_TAG_BIT_STRING, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_cov_tests, testSubscribeCOVProperty)
+#else
+static void testSubscribeCOVProperty(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    BACNET_SUBSCRIBE_COV_DATA data = { 0 };
+    BACNET_CONFIRMED_SERVICE_DATA service_data = { 0 };
+    uint8_t *sent_apdu = NULL;
+    int len = 0;
+
+    handler_cov_init();
+    Stub_Relinquish_Value = 21.0f;
+    data.subscriberProcessIdentifier = 1;
+    data.monitoredObjectIdentifier = Test_Object_Id;
+    data.issueConfirmedNotifications = false;
+    data.lifetime = 300;
+    data.monitoredProperty.propertyIdentifier = PROP_PRIORITY_ARRAY;
+    data.monitoredProperty.propertyArrayIndex = BACNET_ARRAY_ALL;
+    len = cov_subscribe_property_encode_apdu(apdu, sizeof(apdu), 1, &data);
+    zassert_true(len > 4, NULL);
+    service_data.invoke_id = 1;
+    handler_cov_subscribe_property(&apdu[4], len - 4, &Test_Src, &service_data);
+    test_simple_ack(SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY);
+    /* the initial notification */
+    test_cov_notification_wait();
+    test_cov_notify_priority_array();
+    /* a change of the last element is notified */
+    Stub_Relinquish_Value = 22.0f;
+    test_cov_notification_wait();
+    test_cov_notify_priority_array();
+    /* an unknown property is not subscribed */
+    data.monitoredProperty.propertyIdentifier = PROP_DESCRIPTION;
+    len = cov_subscribe_property_encode_apdu(apdu, sizeof(apdu), 2, &data);
+    service_data.invoke_id = 2;
+    handler_cov_subscribe_property(&apdu[4], len - 4, &Test_Src, &service_data);
+    len = test_sent_apdu(&sent_apdu);
+    zassert_true(len > 0, NULL);
+    zassert_equal(sent_apdu[0], PDU_TYPE_ERROR, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_cov_tests, testSubscribeCOVPropertyMultiple)
+#else
+static void testSubscribeCOVPropertyMultiple(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    uint8_t test_apdu[MAX_APDU] = { 0 };
+    uint8_t value_apdu[MAX_APDU] = { 0 };
+    BACNET_SUBSCRIBE_COV_MULTIPLE_DATA data = { 0 };
+    BACNET_SUBSCRIBE_COV_DATA subscription = { 0 };
+    BACNET_COV_MULTIPLE_DATA cov_data = { 0 };
+    BACNET_CONFIRMED_SERVICE_DATA service_data = { 0 };
+    uint8_t *sent_apdu = NULL;
+    int sent_len = 0;
+    int value_len = 0;
+    int len = 0;
+
+    handler_cov_init();
+    Stub_Relinquish_Value = 21.0f;
+    data.subscriberProcessIdentifier = 2;
+    data.issueConfirmedNotifications = false;
+    data.lifetime = 300;
+    data.maxNotificationDelay = 0;
+    data.listOfSubscriptions = &subscription;
+    subscription.monitoredObjectIdentifier = Test_Object_Id;
+    subscription.covSubscribeToProperty = true;
+    subscription.monitoredProperty.propertyIdentifier = PROP_PRIORITY_ARRAY;
+    subscription.monitoredProperty.propertyArrayIndex = BACNET_ARRAY_ALL;
+    len = cov_subscribe_multiple_encode_apdu(apdu, sizeof(apdu), 1, &data);
+    zassert_true(len > 4, NULL);
+    service_data.invoke_id = 1;
+    handler_cov_subscribe_property_multiple(
+        &apdu[4], len - 4, &Test_Src, &service_data);
+    test_simple_ack(SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY_MULTIPLE);
+    /* the initial notification has the whole Priority_Array */
+    test_cov_notification_wait();
+    sent_len = test_sent_apdu(&sent_apdu);
+    cov_data.subscriberProcessIdentifier = 2;
+    cov_data.initiatingDeviceIdentifier = Device_Object_Instance_Number();
+    cov_data.timeRemaining = 300;
+    value_len = test_priority_array(value_apdu, sizeof(value_apdu));
+    len = cov_notify_multiple_encode_apdu_init(
+        &test_apdu[0], false, 0, &cov_data);
+    len += cov_notify_multiple_encode_apdu_object_begin(
+        &test_apdu[len], &Test_Object_Id);
+    len += cov_notify_multiple_encode_apdu_property(&test_apdu[len],
+        PROP_PRIORITY_ARRAY, BACNET_ARRAY_ALL, value_apdu, value_len, NULL);
+    len += cov_notify_multiple_encode_apdu_object_end(&test_apdu[len]);
+    len += cov_notify_multiple_encode_apdu_end(&test_apdu[len]);
+    zassert_equal(sent_len, len, NULL);
+    zassert_mem_equal(sent_apdu, test_apdu, len, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(h_cov_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(h_cov_tests, ztest_unit_test(testSubscribeCOVProperty),
+        ztest_unit_test(testSubscribeCOVPropertyMultiple));
+
+    ztest_run_test_suite(h_cov_tests);
+}
+#endif
@@ -0,0 +1,190 @@
+/**
+ * @file
+ * @brief Stub functions for unit test of the COV handlers
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "bacnet/bacdcode.h"
+#include "bacnet/bacdef.h"
+#include "bacnet/bacapp.h"
+#include "bacnet/datetime.h"
+#include "bacnet/npdu.h"
+#include "bacnet/rp.h"
+
+uint8_t Handler_Transmit_Buffer[MAX_PDU];
+
+/* the last PDU sent by a handler */
+uint8_t Stub_PDU[MAX_PDU];
+int Stub_PDU_Len;
+/* the commanded value at priority 16 of the monitored object */
+float Stub_Relinquish_Value = 21.0f;
+BACNET_DATE_TIME Stub_Date_Time = { { 2026, 10, 19, 1 }, { 12, 0, 0, 0 } };
+
+int datalink_send_pdu(BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    (void)dest;
+    (void)npdu_data;
+    if (pdu_len > sizeof(Stub_PDU)) {
+        return -1;
+    }
+    memcpy(Stub_PDU, pdu, pdu_len);
+    Stub_PDU_Len = (int)pdu_len;
+
+    return (int)pdu_len;
+}
+
+void datalink_get_my_address(BACNET_ADDRESS *my_address)
+{
+    memset(my_address, 0, sizeof(BACNET_ADDRESS));
+}
+
+void Device_getCurrentDateTime(BACNET_DATE_TIME *DateTime)
+{
+    datetime_copy(DateTime, &Stub_Date_Time);
+}
+
+uint32_t Device_Object_Instance_Number(void)
+{
+    return 260001;
+}
+
+bool Device_Valid_Object_Id(BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    return (object_type == OBJECT_ANALOG_OUTPUT) && (object_instance == 1);
+}
+
+bool Device_Value_List_Supported(BACNET_OBJECT_TYPE object_type)
+{
+    (void)object_type;
+
+    return false;
+}
+
+bool Device_Encode_Value_List(BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_VALUE *value_list)
+{
+    (void)object_type;
+    (void)object_instance;
+    (void)value_list;
+
+    return false;
+}
+
+bool Device_COV(BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    (void)object_type;
+    (void)object_instance;
+
+    return false;
+}
+
+void Device_COV_Clear(BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    (void)object_type;
+    (void)object_instance;
+}
+
+/* an Analog Output with a Priority_Array relinquished but for priority 16 */
+int Device_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    BACNET_BIT_STRING bit_string;
+    uint8_t *apdu = rpdata->application_data;
+    int apdu_len = 0;
+    unsigned i;
+
+    switch (rpdata->object_property) {
+        case PROP_PRESENT_VALUE:
+            apdu_len = encode_application_real(apdu, Stub_Relinquish_Value);
+            break;
+        case PROP_STATUS_FLAGS:
+            bitstring_init(&bit_string);
+            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
+            bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
+            bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
+            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE, false);
+            apdu_len = encode_application_bitstring(apdu, &bit_string);
+            break;
+        case PROP_PRIORITY_ARRAY:
+            if (rpdata->array_index == 0) {
+                apdu_len =
+                    encode_application_unsigned(apdu, BACNET_MAX_PRIORITY);
+                break;
+            }
+            for (i = 1; i <= BACNET_MAX_PRIORITY; i++) {
+                if ((rpdata->array_index != BACNET_ARRAY_ALL) &&
+                    (rpdata->array_index != i)) {
+                    continue;
+                }
+                if (i == BACNET_MAX_PRIORITY) {
+                    apdu_len += encode_application_real(
+                        &apdu[apdu_len], Stub_Relinquish_Value);
+                } else {
+                    apdu_len += encode_application_null(&apdu[apdu_len]);
+                }
+            }
+            if (apdu_len == 0) {
+                rpdata->error_class = ERROR_CLASS_PROPERTY;
+                rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
+                apdu_len = BACNET_STATUS_ERROR;
+            }
+            break;
+        default:
+            rpdata->error_class = ERROR_CLASS_PROPERTY;
+            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+            apdu_len = BACNET_STATUS_ERROR;
+            break;
+    }
+
+    return apdu_len;
+}
+
+bool tsm_transaction_available(void)
+{
+    return true;
+}
+
+uint8_t tsm_next_free_invokeID(void)
+{
+    return 1;
+}
+
+void tsm_free_invoke_id(uint8_t invokeID)
+{
+    (void)invokeID;
+}
+
+void tsm_set_confirmed_unsegmented_transaction(uint8_t invokeID,
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *ndpu_data,
+    uint8_t *apdu,
+    uint16_t apdu_len)
+{
+    (void)invokeID;
+    (void)dest;
+    (void)ndpu_data;
+    (void)apdu;
+    (void)apdu_len;
+}
+
+bool tsm_invoke_id_free(uint8_t invokeID)
+{
+    (void)invokeID;
+
+    return true;
+}
+
+bool tsm_invoke_id_failed(uint8_t invokeID)
+{
+    (void)invokeID;
+
+    return false;
+}
@@ -0,0 +1,369 @@
+/**
+ * @file
+ * @brief Unit test for the GetEventInformation, GetAlarmSummary and
+ *  AcknowledgeAlarm handlers with the active event index
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/alarm_ack.h>
+#include <bacnet/bacapp.h>
+#include <bacnet/get_alarm_sum.h>
+#include <bacnet/getevent.h>
+#include <bacnet/npdu.h>
+#include <bacnet/wp.h>
+#include <bacnet/basic/object/ai.h>
+#include <bacnet/basic/service/h_alarm_ack.h>
+#include <bacnet/basic/service/h_get_alarm_sum.h>
+#include <bacnet/basic/service/h_getevent.h>
+
+extern uint8_t Stub_PDU[MAX_PDU];
+extern int Stub_PDU_Len;
+extern BACNET_DATE_TIME Stub_Date_Time;
+
+/* number of Analog Inputs in ai.c */
+#define MAX_ANALOG_INPUTS_TEST 4
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+/**
+ * @brief Write a property of an Analog Input
+ */
+static void test_ai_write(uint32_t instance,
+    BACNET_PROPERTY_ID property,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    BACNET_WRITE_PROPERTY_DATA wp_data = { 0 };
+
+    wp_data.object_type = OBJECT_ANALOG_INPUT;
+    wp_data.object_instance = instance;
+    wp_data.object_property = property;
+    wp_data.array_index = BACNET_ARRAY_ALL;
+    wp_data.priority = BACNET_NO_PRIORITY;
+    wp_data.application_data_len =
+        bacapp_encode_application_data(wp_data.application_data, value);
+    zassert_true(Analog_Input_Write_Property(&wp_data), NULL);
+}
+
+/**
+ * @brief Enable the high limit alarm of an Analog Input at 50.0
+ */
+static void test_ai_alarm_enable(uint32_t instance)
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+
+    value.tag = BACNET_APPLICATION_TAG_REAL;
+    value.type.Real = 50.0f;
+    test_ai_write(instance, PROP_HIGH_LIMIT, &value);
+    value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
+    bitstring_init(&value.type.Bit_String);
+    bitstring_set_bit(&value.type.Bit_String, 0, false);
+    bitstring_set_bit(&value.type.Bit_String, 1, true);
+    test_ai_write(instance, PROP_LIMIT_ENABLE, &value);
+    bitstring_init(&value.type.Bit_String);
+    bitstring_set_bit(&value.type.Bit_String, TRANSITION_TO_OFFNORMAL, true);
+    bitstring_set_bit(&value.type.Bit_String, TRANSITION_TO_FAULT, true);
+    bitstring_set_bit(&value.type.Bit_String, TRANSITION_TO_NORMAL, true);
+    test_ai_write(instance, PROP_EVENT_ENABLE, &value);
+}
+
+/**
+ * @brief Get the APDU of the last PDU sent by a handler
+ */
+static uint8_t *test_apdu(int *apdu_len)
+{
+    BACNET_ADDRESS dest = { 0 }, src = { 0 };
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    int len;
+
+    len = bacnet_npdu_decode(
+        Stub_PDU, (uint16_t)Stub_PDU_Len, &dest, &src, &npdu_data);
+    zassert_true(len > 0, NULL);
+    *apdu_len = Stub_PDU_Len - len;
+
+    return &Stub_PDU[len];
+}
+
+/**
+ * @brief Send a GetEventInformation request and count the events
+ * @param last - 'Last Received Object Identifier', or NULL
+ * @param instances - [out] instances of the events
+ * @return number of events
+ */
+static unsigned test_get_event_information(
+    BACNET_OBJECT_ID *last, uint32_t *instances)
+{
+    uint8_t request[MAX_APDU] = { 0 };
+    BACNET_CONFIRMED_SERVICE_DATA service_data = { 0 };
+    BACNET_ADDRESS src = { 0 };
+    BACNET_GET_EVENT_INFORMATION_DATA data[MAX_ANALOG_INPUTS_TEST];
+    bool more_events = true;
+    uint8_t *apdu;
+    unsigned i, count = 0;
+    int len, apdu_len = 0;
+
+    len = getevent_encode_apdu(request, 1, last);
+    zassert_true(len >= 4, NULL);
+    service_data.invoke_id = 1;
+    service_data.max_resp = MAX_APDU;
+    /* skip the confirmed request header */
+    handler_get_event_information(&request[4], len - 4, &src, &service_data);
+    apdu = test_apdu(&apdu_len);
+    zassert_equal(apdu[0], PDU_TYPE_COMPLEX_ACK, NULL);
+    zassert_equal(apdu[2], SERVICE_CONFIRMED_GET_EVENT_INFORMATION, NULL);
+    if ((apdu[3] == 0x0E) && (apdu[4] == 0x0F)) {
+        /* the opening tag 0 is followed by the closing tag 0
+           when the list is empty */
+        return 0;
+    }
+    for (i = 0; i < MAX_ANALOG_INPUTS_TEST; i++) {
+        data[i].next = (i + 1 < MAX_ANALOG_INPUTS_TEST) ? &data[i + 1] : NULL;
+    }
+    len = getevent_ack_decode_service_request(
+        &apdu[3], apdu_len - 3, &data[0], &more_events);
+    zassert_true(len > 0, NULL);
+    zassert_false(more_events, NULL);
+    for (i = 0; i < MAX_ANALOG_INPUTS_TEST; i++) {
+        if (data[i].objectIdentifier.type == OBJECT_ANALOG_INPUT) {
+            instances[count] = data[i].objectIdentifier.instance;
+            count++;
+        }
+        if (!data[i].next) {
+            break;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Send a GetAlarmSummary request and count the alarms
+ * @param instances - [out] instances of the alarms
+ * @return number of alarms
+ */
+static unsigned test_get_alarm_summary(uint32_t *instances)
+{
+    BACNET_CONFIRMED_SERVICE_DATA service_data = { 0 };
+    BACNET_ADDRESS src = { 0 };
+    BACNET_GET_ALARM_SUMMARY_DATA data = { 0 };
+    uint8_t *apdu;
+    unsigned count = 0;
+    int len, offset, apdu_len = 0;
+
+    service_data.invoke_id = 2;
+    service_data.max_resp = MAX_APDU;
+    handler_get_alarm_summary(NULL, 0, &src, &service_data);
+    apdu = test_apdu(&apdu_len);
+    zassert_equal(apdu[0], PDU_TYPE_COMPLEX_ACK, NULL);
+    zassert_equal(apdu[2], SERVICE_CONFIRMED_GET_ALARM_SUMMARY, NULL);
+    for (offset = 3; offset < apdu_len; offset += len) {
+        len = get_alarm_summary_ack_decode_apdu_data(
+            &apdu[offset], apdu_len - offset, &data);
+        zassert_true(len > 0, NULL);
+        zassert_equal(data.objectIdentifier.type, OBJECT_ANALOG_INPUT, NULL);
+        instances[count] = data.objectIdentifier.instance;
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Send an AcknowledgeAlarm request
+ * @param instance - Analog Input instance
+ * @param state - event state acknowledged
+ * @return true if the handler answered with a SimpleACK
+ */
+static bool test_alarm_ack(uint32_t instance, BACNET_EVENT_STATE state)
+{
+    uint8_t request[MAX_APDU] = { 0 };
+    BACNET_CONFIRMED_SERVICE_DATA service_data = { 0 };
+    BACNET_ADDRESS src = { 0 };
+    BACNET_ALARM_ACK_DATA data = { 0 };
+    uint8_t *apdu;
+    int len, apdu_len = 0;
+
+    data.ackProcessIdentifier = 1;
+    data.eventObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    data.eventObjectIdentifier.instance = instance;
+    data.eventStateAcked = state;
+    data.eventTimeStamp.tag = TIME_STAMP_DATETIME;
+    datetime_copy(&data.eventTimeStamp.value.dateTime, &Stub_Date_Time);
+    characterstring_init_ansi(&data.ackSource, "test");
+    data.ackTimeStamp.tag = TIME_STAMP_DATETIME;
+    datetime_copy(&data.ackTimeStamp.value.dateTime, &Stub_Date_Time);
+    len = alarm_ack_encode_service_request(request, &data);
+    zassert_true(len > 0, NULL);
+    service_data.invoke_id = 3;
+    service_data.max_resp = MAX_APDU;
+    handler_alarm_ack(request, len, &src, &service_data);
+    apdu = test_apdu(&apdu_len);
+
+    return (apdu[0] == PDU_TYPE_SIMPLE_ACK) &&
+        (apdu[2] == SERVICE_CONFIRMED_ACKNOWLEDGE_ALARM);
+}
+
+/**
+ * @brief Test the handlers follow the active event index through
+ *  the transitions and acknowledgments of Analog Input alarms
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_getevent_tests, testEventIndexHandlers)
+#else
+static void testEventIndexHandlers(void)
+#endif
+{
+    BACNET_OBJECT_ID last = { 0 };
+    uint32_t instances[MAX_ANALOG_INPUTS_TEST] = { 0 };
+    unsigned count;
+
+    Analog_Input_Init();
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 0, NULL);
+    count = test_get_alarm_summary(instances);
+    zassert_equal(count, 0, NULL);
+    /* two of the objects go to HIGH_LIMIT */
+    test_ai_alarm_enable(1);
+    test_ai_alarm_enable(3);
+    Analog_Input_Present_Value_Set(1, 60.0f);
+    Analog_Input_Present_Value_Set(3, 60.0f);
+    Analog_Input_Intrinsic_Reporting(1);
+    Analog_Input_Intrinsic_Reporting(3);
+    zassert_equal(
+        Analog_Input_Event_State(1), EVENT_STATE_HIGH_LIMIT, NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 2, NULL);
+    zassert_equal(instances[0], 1, NULL);
+    zassert_equal(instances[1], 3, NULL);
+    count = test_get_alarm_summary(instances);
+    zassert_equal(count, 2, NULL);
+    zassert_equal(instances[0], 1, NULL);
+    zassert_equal(instances[1], 3, NULL);
+    /* continue after the 'Last Received Object Identifier' */
+    last.type = OBJECT_ANALOG_INPUT;
+    last.instance = 1;
+    count = test_get_event_information(&last, instances);
+    zassert_equal(count, 1, NULL);
+    zassert_equal(instances[0], 3, NULL);
+    /* an acknowledged object stays in the index while in alarm */
+    zassert_true(test_alarm_ack(1, EVENT_STATE_HIGH_LIMIT), NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 2, NULL);
+    /* back to NORMAL, the TO-NORMAL transition is not acknowledged */
+    Analog_Input_Present_Value_Set(1, 40.0f);
+    /* the first call sends the acknowledgment notification */
+    Analog_Input_Intrinsic_Reporting(1);
+    Analog_Input_Intrinsic_Reporting(1);
+    zassert_equal(Analog_Input_Event_State(1), EVENT_STATE_NORMAL, NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 2, NULL);
+    count = test_get_alarm_summary(instances);
+    zassert_equal(count, 1, NULL);
+    zassert_equal(instances[0], 3, NULL);
+    /* acknowledging the TO-NORMAL transition leaves the index */
+    zassert_true(test_alarm_ack(1, EVENT_STATE_NORMAL), NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 1, NULL);
+    zassert_equal(instances[0], 3, NULL);
+    /* an acknowledgment without a transition is refused */
+    zassert_false(test_alarm_ack(2, EVENT_STATE_HIGH_LIMIT), NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 1, NULL);
+}
+/**
+ * @brief Count the Analog Inputs in the active event index
+ */
+static unsigned test_active_count(void)
+{
+    unsigned count = 0;
+    int position;
+
+    position =
+        handler_get_event_information_active_seek(OBJECT_ANALOG_INPUT, 0);
+    while (handler_get_event_information_active_object(
+        position, OBJECT_ANALOG_INPUT, NULL, NULL)) {
+        position++;
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Test the active event index follows an Analog Input whose
+ *  limits are disabled while it is in alarm
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_getevent_tests, testEventIndexLimitDisabled)
+#else
+static void testEventIndexLimitDisabled(void)
+#endif
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    uint32_t instances[MAX_ANALOG_INPUTS_TEST] = { 0 };
+    unsigned count, i;
+
+    /* the limits of the objects left in alarm by other tests
+       are disabled, and the index follows their Event_State */
+    Analog_Input_Init();
+    value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
+    bitstring_init(&value.type.Bit_String);
+    bitstring_set_bit(&value.type.Bit_String, 0, false);
+    bitstring_set_bit(&value.type.Bit_String, 1, false);
+    for (i = 0; i < MAX_ANALOG_INPUTS_TEST; i++) {
+        test_ai_write(i, PROP_LIMIT_ENABLE, &value);
+        Analog_Input_Intrinsic_Reporting(i);
+    }
+    zassert_equal(test_active_count(), 0, NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 0, NULL);
+    test_ai_alarm_enable(2);
+    Analog_Input_Present_Value_Set(2, 60.0f);
+    Analog_Input_Intrinsic_Reporting(2);
+    zassert_equal(
+        Analog_Input_Event_State(2), EVENT_STATE_HIGH_LIMIT, NULL);
+    /* disable the limits while in alarm */
+    test_ai_write(2, PROP_LIMIT_ENABLE, &value);
+    Analog_Input_Present_Value_Set(2, 40.0f);
+    Analog_Input_Intrinsic_Reporting(2);
+    zassert_equal(
+        Analog_Input_Event_State(2), EVENT_STATE_HIGH_LIMIT, NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 1, NULL);
+    zassert_equal(instances[0], 2, NULL);
+    zassert_equal(test_active_count(), 1, NULL);
+    zassert_true(test_alarm_ack(2, EVENT_STATE_HIGH_LIMIT), NULL);
+    Analog_Input_Intrinsic_Reporting(2);
+    count = test_get_alarm_summary(instances);
+    zassert_equal(count, 1, NULL);
+    /* the object is reset to NORMAL with its limits disabled,
+       and the index follows it */
+    Analog_Input_Init();
+    Analog_Input_Intrinsic_Reporting(2);
+    zassert_equal(test_active_count(), 0, NULL);
+    count = test_get_event_information(NULL, instances);
+    zassert_equal(count, 0, NULL);
+    count = test_get_alarm_summary(instances);
+    zassert_equal(count, 0, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(h_getevent_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(h_getevent_tests,
+        ztest_unit_test(testEventIndexHandlers),
+        ztest_unit_test(testEventIndexLimitDisabled));
+
+    ztest_run_test_suite(h_getevent_tests);
+}
+#endif
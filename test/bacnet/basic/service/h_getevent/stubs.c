@@ -0,0 +1,75 @@
+/**
+ * @file
+ * @brief Stub functions for unit test of the alarm and event handlers
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/datetime.h"
+#include "bacnet/event.h"
+#include "bacnet/npdu.h"
+
+uint8_t Handler_Transmit_Buffer[MAX_PDU];
+
+/* the last PDU sent by a handler */
+uint8_t Stub_PDU[MAX_PDU];
+int Stub_PDU_Len;
+/* the time of every event */
+BACNET_DATE_TIME Stub_Date_Time = { { 2026, 10, 19, 1 }, { 12, 0, 0, 0 } };
+
+int datalink_send_pdu(BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    (void)dest;
+    (void)npdu_data;
+    if (pdu_len > sizeof(Stub_PDU)) {
+        return -1;
+    }
+    memcpy(Stub_PDU, pdu, pdu_len);
+    Stub_PDU_Len = (int)pdu_len;
+
+    return (int)pdu_len;
+}
+
+void datalink_get_my_address(BACNET_ADDRESS *my_address)
+{
+    memset(my_address, 0, sizeof(BACNET_ADDRESS));
+}
+
+void Device_getCurrentDateTime(BACNET_DATE_TIME *DateTime)
+{
+    datetime_copy(DateTime, &Stub_Date_Time);
+}
+
+bool Device_Valid_Object_Id(BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    (void)object_type;
+    (void)object_instance;
+
+    return true;
+}
+
+void Notification_Class_common_reporting_function(
+    BACNET_EVENT_NOTIFICATION_DATA *event_data)
+{
+    /* every transition needs an acknowledgment */
+    event_data->ackRequired = true;
+}
+
+void Notification_Class_Get_Priorities(
+    uint32_t Object_Instance, uint32_t *pPriorityArray)
+{
+    unsigned i;
+
+    (void)Object_Instance;
+    for (i = 0; i < 3; i++) {
+        pPriorityArray[i] = 255;
+    }
+}
@@ -0,0 +1,308 @@
+/**
+ * @file
+ * @brief Unit test for the Who-Is handler and its I-Am scheduler
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <bacnet/whois.h>
+#include <bacnet/basic/service/h_whois.h>
+
+/* from the stubs */
+extern uint32_t Stub_Device_Instance;
+extern unsigned Stub_Device_Count;
+extern uint32_t Stub_I_Am_List[64];
+extern uint16_t Stub_I_Am_Net[64];
+extern unsigned Stub_I_Am_Count;
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+/**
+ * @brief Receive a broadcast Who-Is with the routing handler
+ * @param low_limit - lowest Device instance, or -1 for no limits
+ * @param high_limit - highest Device instance, or -1 for no limits
+ * @param net - network number of the requester, 0=local network
+ */
+static void who_is_receive_from(
+    int32_t low_limit, int32_t high_limit, uint16_t net)
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    BACNET_ADDRESS src = { 0 };
+    int len;
+
+    src.net = net;
+    len = whois_encode_apdu(apdu, low_limit, high_limit);
+    /* skip the PDU type and the service choice */
+    handler_who_is_bcast_for_routing(&apdu[2], (uint16_t)(len - 2), &src);
+}
+
+/**
+ * @brief Receive a broadcast Who-Is from the local network
+ * @param low_limit - lowest Device instance, or -1 for no limits
+ * @param high_limit - highest Device instance, or -1 for no limits
+ */
+static void who_is_receive(int32_t low_limit, int32_t high_limit)
+{
+    who_is_receive_from(low_limit, high_limit, 0);
+}
+
+/**
+ * @brief Run the scheduler until nothing is pending
+ * @param milliseconds - timer step
+ * @return number of timer calls
+ */
+static unsigned who_is_timer_run(uint16_t milliseconds)
+{
+    unsigned calls = 0;
+
+    while (handler_who_is_pending() && (calls < 1000)) {
+        handler_who_is_timer(milliseconds);
+        calls++;
+    }
+
+    return calls;
+}
+
+/**
+ * @brief Test that the Who-Is ranges are merged, and each Device answers
+ *  once, in instance order
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_whois_tests, test_who_is_range_merge)
+#else
+static void test_who_is_range_merge(void)
+#endif
+{
+    handler_who_is_schedule_set(100, 10, 1);
+    Stub_I_Am_Count = 0;
+    who_is_receive(30, 40);
+    zassert_equal(handler_who_is_pending(), 1, NULL);
+    /* overlapping */
+    who_is_receive(35, 45);
+    zassert_equal(handler_who_is_pending(), 1, NULL);
+    /* separate, before and after */
+    who_is_receive(10, 10);
+    who_is_receive(60, 70);
+    zassert_equal(handler_who_is_pending(), 3, NULL);
+    /* adjacent to the first range */
+    who_is_receive(11, 29);
+    zassert_equal(handler_who_is_pending(), 2, NULL);
+    /* repeated */
+    who_is_receive(10, 45);
+    zassert_equal(handler_who_is_pending(), 2, NULL);
+    zassert_equal(Stub_I_Am_Count, 0, NULL);
+    who_is_timer_run(10);
+    zassert_equal(Stub_I_Am_Count, 5, NULL);
+    zassert_equal(Stub_I_Am_List[0], 10, NULL);
+    zassert_equal(Stub_I_Am_List[1], 20, NULL);
+    zassert_equal(Stub_I_Am_List[2], 30, NULL);
+    zassert_equal(Stub_I_Am_List[3], 40, NULL);
+    zassert_equal(Stub_I_Am_List[4], 60, NULL);
+    /* no limits covers every Device */
+    Stub_I_Am_Count = 0;
+    who_is_receive(-1, -1);
+    who_is_receive(20, 20);
+    zassert_equal(handler_who_is_pending(), 1, NULL);
+    who_is_timer_run(10);
+    zassert_equal(Stub_I_Am_Count, 6, NULL);
+    /* more ranges than the pending list holds are answered at once,
+       and the pending ranges are not widened */
+    Stub_I_Am_Count = 0;
+    who_is_receive(10, 10);
+    who_is_receive(12, 12);
+    who_is_receive(14, 14);
+    who_is_receive(16, 16);
+    who_is_receive(18, 18);
+    who_is_receive(20, 20);
+    who_is_receive(22, 22);
+    who_is_receive(24, 24);
+    zassert_equal(handler_who_is_pending(), WHO_IS_PENDING_MAX, NULL);
+    who_is_receive(50, 50);
+    zassert_equal(handler_who_is_pending(), WHO_IS_PENDING_MAX, NULL);
+    zassert_equal(Stub_I_Am_Count, 1, NULL);
+    zassert_equal(Stub_I_Am_List[0], 50, NULL);
+    who_is_timer_run(10);
+    zassert_equal(Stub_I_Am_Count, 3, NULL);
+    zassert_equal(Stub_I_Am_List[1], 10, NULL);
+    zassert_equal(Stub_I_Am_List[2], 20, NULL);
+}
+
+/**
+ * @brief Test that the first I-Am waits for the window, with jitter
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_whois_tests, test_who_is_window_jitter)
+#else
+static void test_who_is_window_jitter(void)
+#endif
+{
+    unsigned calls, calls_min = 1000, calls_max = 0;
+    unsigned i;
+
+    srand(1);
+    handler_who_is_schedule_set(1000, 10, 8);
+    for (i = 0; i < 32; i++) {
+        Stub_I_Am_Count = 0;
+        who_is_receive(-1, -1);
+        calls = who_is_timer_run(10);
+        zassert_equal(Stub_I_Am_Count, 6, NULL);
+        /* from one half to one and a half of the window */
+        zassert_true(calls >= 50, "calls=%u", calls);
+        zassert_true(calls <= 151, "calls=%u", calls);
+        if (calls < calls_min) {
+            calls_min = calls;
+        }
+        if (calls > calls_max) {
+            calls_max = calls;
+        }
+    }
+    /* the delay varies */
+    zassert_true(calls_max > calls_min, NULL);
+}
+
+/**
+ * @brief Test that the I-Am are sent in batches
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_whois_tests, test_who_is_batch)
+#else
+static void test_who_is_batch(void)
+#endif
+{
+    srand(1);
+    handler_who_is_schedule_set(10, 1000, 4);
+    Stub_I_Am_Count = 0;
+    who_is_receive(-1, -1);
+    /* the window is at most 15 ms */
+    handler_who_is_timer(15);
+    zassert_equal(Stub_I_Am_Count, 4, NULL);
+    zassert_equal(handler_who_is_pending(), 1, NULL);
+    /* the next batch waits for at least one half of the interval */
+    handler_who_is_timer(499);
+    zassert_equal(Stub_I_Am_Count, 4, NULL);
+    handler_who_is_timer(1001);
+    zassert_equal(Stub_I_Am_Count, 6, NULL);
+    zassert_equal(handler_who_is_pending(), 0, NULL);
+    /* without a window, the I-Am are sent at once */
+    handler_who_is_schedule_set(0, 0, 1);
+    Stub_I_Am_Count = 0;
+    who_is_receive(-1, -1);
+    zassert_equal(Stub_I_Am_Count, 6, NULL);
+    zassert_equal(handler_who_is_pending(), 0, NULL);
+}
+
+/**
+ * @brief Test that each network of a requester gets its own batch of I-Am,
+ *  sent as a broadcast on that network
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_whois_tests, test_who_is_batch_network)
+#else
+static void test_who_is_batch_network(void)
+#endif
+{
+    unsigned i, net_count = 0;
+
+    srand(1);
+    handler_who_is_schedule_set(10, 1000, 2);
+    Stub_I_Am_Count = 0;
+    who_is_receive_from(-1, -1, 5);
+    who_is_receive(-1, -1);
+    /* same range from another network is not merged */
+    zassert_equal(handler_who_is_pending(), 2, NULL);
+    handler_who_is_timer(15);
+    zassert_equal(Stub_I_Am_Count, 4, NULL);
+    zassert_equal(Stub_I_Am_List[0], 10, NULL);
+    zassert_equal(Stub_I_Am_Net[0], 0, NULL);
+    zassert_equal(Stub_I_Am_List[1], 20, NULL);
+    zassert_equal(Stub_I_Am_Net[1], 0, NULL);
+    zassert_equal(Stub_I_Am_List[2], 10, NULL);
+    zassert_equal(Stub_I_Am_Net[2], 5, NULL);
+    zassert_equal(Stub_I_Am_List[3], 20, NULL);
+    zassert_equal(Stub_I_Am_Net[3], 5, NULL);
+    who_is_timer_run(1500);
+    zassert_equal(Stub_I_Am_Count, 12, NULL);
+    for (i = 0; i < Stub_I_Am_Count; i++) {
+        if (Stub_I_Am_Net[i] == 5) {
+            net_count++;
+        }
+    }
+    zassert_equal(net_count, 6, NULL);
+}
+
+/**
+ * @brief Test that a Device without routing answers once per window
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_whois_tests, test_who_is_device)
+#else
+static void test_who_is_device(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    BACNET_ADDRESS src = { 0 };
+    unsigned i;
+    int len;
+
+    handler_who_is_schedule_set(100, 10, 1);
+    Stub_Device_Instance = 30;
+    Stub_I_Am_Count = 0;
+    len = whois_encode_apdu(apdu, -1, -1);
+    for (i = 0; i < 10; i++) {
+        handler_who_is(&apdu[2], (uint16_t)(len - 2), &src);
+    }
+    /* not in the range */
+    len = whois_encode_apdu(apdu, 40, 50);
+    handler_who_is(&apdu[2], (uint16_t)(len - 2), &src);
+    zassert_equal(Stub_I_Am_Count, 0, NULL);
+    who_is_timer_run(10);
+    zassert_equal(Stub_I_Am_Count, 1, NULL);
+    zassert_equal(Stub_I_Am_List[0], 30, NULL);
+    /* without any routed Devices, this Device still answers */
+    Stub_Device_Count = 0;
+    Stub_I_Am_Count = 0;
+    len = whois_encode_apdu(apdu, -1, -1);
+    handler_who_is(&apdu[2], (uint16_t)(len - 2), &src);
+    who_is_timer_run(10);
+    zassert_equal(Stub_I_Am_Count, 1, NULL);
+    zassert_equal(Stub_I_Am_List[0], 30, NULL);
+    /* one I-Am for each network, and answered at once when full */
+    Stub_I_Am_Count = 0;
+    for (i = 0; i <= WHO_IS_PENDING_MAX; i++) {
+        src.net = (uint16_t)(i + 1);
+        handler_who_is(&apdu[2], (uint16_t)(len - 2), &src);
+    }
+    zassert_equal(handler_who_is_pending(), WHO_IS_PENDING_MAX, NULL);
+    zassert_equal(Stub_I_Am_Count, 1, NULL);
+    zassert_equal(Stub_I_Am_Net[0], 0, NULL);
+    who_is_timer_run(10);
+    zassert_equal(Stub_I_Am_Count, WHO_IS_PENDING_MAX + 1, NULL);
+    zassert_equal(Stub_I_Am_Net[1], 1, NULL);
+    zassert_equal(Stub_I_Am_Net[WHO_IS_PENDING_MAX], WHO_IS_PENDING_MAX, NULL);
+    Stub_Device_Count = 6;
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(h_whois_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(h_whois_tests,
+     ztest_unit_test(test_who_is_range_merge),
+     ztest_unit_test(test_who_is_window_jitter),
+     ztest_unit_test(test_who_is_batch),
+     ztest_unit_test(test_who_is_batch_network),
+     ztest_unit_test(test_who_is_device)
+     );
+
+    ztest_run_test_suite(h_whois_tests);
+}
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Stub functions for unit test of the Who-Is handler
+ * @date 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "bacnet/bacdef.h"
+#include "bacnet/basic/tsm/tsm.h"
+
+uint8_t Handler_Transmit_Buffer[MAX_PDU];
+
+/* Device instances of the routed Devices, in ascending order */
+uint32_t Stub_Device_List[] = { 10, 20, 30, 40, 50, 60 };
+/* number of routed Devices in the list */
+unsigned Stub_Device_Count = 6;
+/* the current Device, set by Routed_Device_GetNext_Instance() */
+uint32_t Stub_Device_Instance = 10;
+/* the Device instances of the I-Am sent, in order */
+uint32_t Stub_I_Am_List[64];
+/* the destination network of the I-Am sent, in order; 0=global */
+uint16_t Stub_I_Am_Net[64];
+unsigned Stub_I_Am_Count;
+
+uint32_t Device_Object_Instance_Number(void)
+{
+    return Stub_Device_Instance;
+}
+
+uint16_t Device_Vendor_Identifier(void)
+{
+    return 260;
+}
+
+bool Routed_Device_GetNext_Instance(
+    uint32_t low_limit, uint32_t high_limit, int *cursor)
+{
+    unsigned count = Stub_Device_Count;
+    unsigned index;
+
+    if (*cursor < 0) {
+        return false;
+    }
+    for (index = (unsigned)*cursor; index < count; index++) {
+        if (Stub_Device_List[index] > high_limit) {
+            break;
+        }
+        if (Stub_Device_List[index] >= low_limit) {
+            Stub_Device_Instance = Stub_Device_List[index];
+            *cursor = (int)index + 1;
+            return true;
+        }
+    }
+    *cursor = -1;
+
+    return false;
+}
+
+static void Stub_I_Am_Add(uint32_t device_id, uint16_t net)
+{
+    if (Stub_I_Am_Count <
+        (sizeof(Stub_I_Am_List) / sizeof(Stub_I_Am_List[0]))) {
+        Stub_I_Am_List[Stub_I_Am_Count] = device_id;
+        Stub_I_Am_Net[Stub_I_Am_Count] = net;
+    }
+    Stub_I_Am_Count++;
+}
+
+void Send_I_Am(uint8_t *buffer)
+{
+    (void)buffer;
+    Stub_I_Am_Add(Stub_Device_Instance, 0);
+}
+
+void Send_I_Am_To_Network(BACNET_ADDRESS *target_address,
+    uint32_t device_id,
+    unsigned int max_apdu,
+    int segmentation,
+    uint16_t vendor_id)
+{
+    (void)max_apdu;
+    (void)segmentation;
+    (void)vendor_id;
+    Stub_I_Am_Add(device_id, target_address->net);
+}
+
+void Send_I_Am_Unicast(uint8_t *buffer, BACNET_ADDRESS *src)
+{
+    (void)buffer;
+    (void)src;
+    Send_I_Am(buffer);
+}
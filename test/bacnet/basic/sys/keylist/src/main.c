@@ -271,6 +271,48 @@ static void testKeyListDataIndex(void)
     return;
 }
 
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(keylist_tests, testKeyListIndexNearest)
+#else
+static void testKeyListIndexNearest(void)
+#endif
+{
+    OS_Keylist list;
+    int index;
+    char *data1 = "Joshua";
+    char *data2 = "Anna";
+    char *data3 = "Mary";
+
+    list = Keylist_Create();
+    zassert_not_null(list, NULL);
+    index = Keylist_Index_Nearest(list, 5);
+    zassert_equal(index, 0, NULL);
+
+    (void)Keylist_Data_Add(list, 10, data1);
+    (void)Keylist_Data_Add(list, 20, data2);
+    (void)Keylist_Data_Add(list, 30, data3);
+
+    index = Keylist_Index_Nearest(list, 5);
+    zassert_equal(index, 0, NULL);
+    index = Keylist_Index_Nearest(list, 10);
+    zassert_equal(index, 0, NULL);
+    index = Keylist_Index_Nearest(list, 11);
+    zassert_equal(index, 1, NULL);
+    index = Keylist_Index_Nearest(list, 20);
+    zassert_equal(index, 1, NULL);
+    index = Keylist_Index_Nearest(list, 29);
+    zassert_equal(index, 2, NULL);
+    index = Keylist_Index_Nearest(list, 31);
+    zassert_equal(index, 3, NULL);
+
+    /* cleanup */
+    while (Keylist_Data_Pop(list)) {
+    }
+    Keylist_Delete(list);
+
+    return;
+}
+
 /* test access of a lot of entries */
 #if defined(CONFIG_ZTEST_NEW_API)
 ZTEST(keylist_tests, testKeyListLarge)
@@ -352,6 +394,7 @@ void test_main(void)
      ztest_unit_test(testKeyListFILO),
      ztest_unit_test(testKeyListDataKey),
      ztest_unit_test(testKeyListDataIndex),
+     ztest_unit_test(testKeyListIndexNearest),
      ztest_unit_test(testKeyListLarge),
      ztest_unit_test(testKeySample)
      );
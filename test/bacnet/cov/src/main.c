@@ -236,6 +236,222 @@ static void testCOVNotify(void)
     testCCOVNotifyData(invoke_id, &data);
 }
 
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cov_tests, testCOVNotifyCompact)
+#else
+static void testCOVNotifyCompact(void)
+#endif
+{
+    uint8_t apdu[480] = { 0 };
+    int len = 0;
+    BACNET_COV_DATA data = { 0 };
+    BACNET_PROPERTY_VALUE value_list[2] = { { 0 } };
+    BACNET_COV_COMPACT_DATA test_data = { 0 };
+    BACNET_PROPERTY_COMPACT_VALUE test_value_list[2] = { { 0 } };
+    BACNET_APPLICATION_DATA_VALUE test_value = { 0 };
+
+    data.subscriberProcessIdentifier = 1;
+    data.initiatingDeviceIdentifier = 123;
+    data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    data.monitoredObjectIdentifier.instance = 321;
+    data.timeRemaining = 456;
+    cov_data_value_list_link(&data, &value_list[0], 2);
+    value_list[0].propertyIdentifier = PROP_PRESENT_VALUE;
+    value_list[0].propertyArrayIndex = BACNET_ARRAY_ALL;
+    value_list[0].value.tag = BACNET_APPLICATION_TAG_REAL;
+    value_list[0].value.type.Real = 21.0f;
+    value_list[1].propertyIdentifier = PROP_STATUS_FLAGS;
+    value_list[1].propertyArrayIndex = BACNET_ARRAY_ALL;
+    value_list[1].value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
+    bitstring_init(&value_list[1].value.type.Bit_String);
+    bitstring_set_bit(&value_list[1].value.type.Bit_String,
+        STATUS_FLAG_IN_ALARM, false);
+    bitstring_set_bit(
+        &value_list[1].value.type.Bit_String, STATUS_FLAG_FAULT, true);
+    bitstring_set_bit(&value_list[1].value.type.Bit_String,
+        STATUS_FLAG_OVERRIDDEN, false);
+    bitstring_set_bit(&value_list[1].value.type.Bit_String,
+        STATUS_FLAG_OUT_OF_SERVICE, false);
+    len = cov_notify_encode_apdu(apdu, &data);
+    zassert_true(len > 0, NULL);
+
+    test_value_list[0].next = &test_value_list[1];
+    test_data.listOfValues = &test_value_list[0];
+    zassert_equal(
+        cov_notify_decode_compact_service_request(apdu, len, &test_data),
+        len, NULL);
+    zassert_equal(test_data.subscriberProcessIdentifier, 1, NULL);
+    zassert_equal(test_data.initiatingDeviceIdentifier, 123, NULL);
+    zassert_equal(test_data.monitoredObjectIdentifier.instance, 321, NULL);
+    zassert_equal(test_data.timeRemaining, 456, NULL);
+    /* the REAL is inline */
+    zassert_equal(
+        test_value_list[0].propertyIdentifier, PROP_PRESENT_VALUE, NULL);
+    zassert_false(test_value_list[0].value.encoded, NULL);
+    zassert_true(test_value_list[0].value.type.Real == 21.0f, NULL);
+    /* the BIT STRING points into the APDU */
+    zassert_true(test_value_list[1].value.encoded, NULL);
+    zassert_equal(test_value_list[1].value.tag,
+        BACNET_APPLICATION_TAG_BIT_STRING, NULL);
+    zassert_true(bacapp_compact_value_to_value(&test_value_list[1].value,
+                     OBJECT_ANALOG_INPUT, PROP_STATUS_FLAGS, &test_value),
+        NULL);
+    zassert_true(bacapp_same_value(&value_list[1].value, &test_value), NULL);
+    /* out of room for the values */
+    test_value_list[0].next = NULL;
+    zassert_equal(
+        cov_notify_decode_compact_service_request(apdu, len, &test_data),
+        BACNET_STATUS_ERROR, NULL);
+}
+
+/* values seen by the streaming decoder callback */
+struct cov_notify_values_test {
+    unsigned count;
+    unsigned stop;
+    uint32_t device_id;
+    BACNET_OBJECT_ID object_id;
+    BACNET_PROPERTY_ID property[2];
+    BACNET_COMPACT_VALUE value[2];
+};
+
+static bool testCOVNotifyValuesCallback(void *context,
+    uint32_t device_id,
+    BACNET_OBJECT_ID *object_id,
+    BACNET_PROPERTY_ID property,
+    BACNET_ARRAY_INDEX array_index,
+    BACNET_COMPACT_VALUE *value,
+    uint8_t priority)
+{
+    struct cov_notify_values_test *test = context;
+
+    zassert_equal(array_index, BACNET_ARRAY_ALL, NULL);
+    zassert_equal(priority, BACNET_NO_PRIORITY, NULL);
+    test->device_id = device_id;
+    test->object_id = *object_id;
+    if (test->count < 2) {
+        test->property[test->count] = property;
+        test->value[test->count] = *value;
+    }
+    test->count++;
+
+    return test->count != test->stop;
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cov_tests, testCOVNotifyValues)
+#else
+static void testCOVNotifyValues(void)
+#endif
+{
+    uint8_t apdu[480] = { 0 };
+    int len = 0;
+    int test_len = 0;
+    BACNET_COV_DATA data = { 0 };
+    BACNET_PROPERTY_VALUE value_list[2] = { { 0 } };
+    struct cov_notify_values_test test = { 0 };
+    uint32_t process_id = 0, time_remaining = 0;
+
+    data.subscriberProcessIdentifier = 1;
+    data.initiatingDeviceIdentifier = 123;
+    data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    data.monitoredObjectIdentifier.instance = 321;
+    data.timeRemaining = 456;
+    cov_data_value_list_link(&data, &value_list[0], 2);
+    cov_value_list_encode_real(&value_list[0], 21.0f, false, true, false,
+        false);
+    len = cov_notify_encode_apdu(apdu, &data);
+    zassert_true(len > 0, NULL);
+    test_len = cov_notify_decode_values(apdu, len, &process_id,
+        &time_remaining, testCOVNotifyValuesCallback, &test);
+    zassert_equal(test_len, len, NULL);
+    zassert_equal(process_id, 1, NULL);
+    zassert_equal(time_remaining, 456, NULL);
+    zassert_equal(test.count, 2, NULL);
+    zassert_equal(test.device_id, 123, NULL);
+    zassert_equal(test.object_id.type, OBJECT_ANALOG_INPUT, NULL);
+    zassert_equal(test.object_id.instance, 321, NULL);
+    zassert_equal(test.property[0], PROP_PRESENT_VALUE, NULL);
+    zassert_false(test.value[0].encoded, NULL);
+    zassert_true(test.value[0].type.Real == 21.0f, NULL);
+    zassert_equal(test.property[1], PROP_STATUS_FLAGS, NULL);
+    zassert_equal(test.value[1].tag, BACNET_APPLICATION_TAG_BIT_STRING, NULL);
+    /* validate only */
+    test_len = cov_notify_decode_values(apdu, len, NULL, NULL, NULL, NULL);
+    zassert_equal(test_len, len, NULL);
+    /* stop after the first value */
+    test.count = 0;
+    test.stop = 1;
+    test_len = cov_notify_decode_values(apdu, len, NULL, NULL,
+        testCOVNotifyValuesCallback, &test);
+    zassert_true(test_len > 0, NULL);
+    zassert_true(test_len < len, NULL);
+    zassert_equal(test.count, 1, NULL);
+    /* truncated */
+    test_len = cov_notify_decode_values(apdu, len - 1, NULL, NULL,
+        NULL, NULL);
+    zassert_equal(test_len, BACNET_STATUS_ERROR, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cov_tests, testCOVNotifyParts)
+#else
+static void testCOVNotifyParts(void)
+#endif
+{
+    uint8_t apdu[480] = { 0 };
+    uint8_t test_apdu[480] = { 0 };
+    uint8_t value_apdu[16] = { 0 };
+    int len = 0;
+    int test_len = 0;
+    int value_len = 0;
+    BACNET_COV_DATA data = { 0 };
+    BACNET_PROPERTY_VALUE value_list[2] = { { 0 } };
+    BACNET_BIT_STRING status_flags = { 0 };
+    bool confirmed = false;
+
+    data.subscriberProcessIdentifier = 1;
+    data.initiatingDeviceIdentifier = 123;
+    data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    data.monitoredObjectIdentifier.instance = 321;
+    data.timeRemaining = 456;
+    cov_data_value_list_link(&data, &value_list[0], 2);
+    cov_value_list_encode_real(&value_list[0], 21.0f, false, true, false,
+        false);
+    for (confirmed = false;; confirmed = true) {
+        if (confirmed) {
+            len = ccov_notify_encode_apdu(apdu, sizeof(apdu), 5, &data);
+        } else {
+            len = ucov_notify_encode_apdu(apdu, sizeof(apdu), &data);
+        }
+        zassert_true(len > 0, NULL);
+        test_len =
+            cov_notify_encode_apdu_init(&test_apdu[0], confirmed, 5, &data);
+        zassert_equal(test_len,
+            cov_notify_encode_apdu_init(NULL, confirmed, 5, &data), NULL);
+        value_len = encode_application_real(&value_apdu[0], 21.0f);
+        test_len += cov_notify_multiple_encode_apdu_property(
+            &test_apdu[test_len], PROP_PRESENT_VALUE, BACNET_ARRAY_ALL,
+            &value_apdu[0], value_len, NULL);
+        bitstring_init(&status_flags);
+        bitstring_set_bit(&status_flags, STATUS_FLAG_IN_ALARM, false);
+        bitstring_set_bit(&status_flags, STATUS_FLAG_FAULT, true);
+        bitstring_set_bit(&status_flags, STATUS_FLAG_OVERRIDDEN, false);
+        bitstring_set_bit(&status_flags, STATUS_FLAG_OUT_OF_SERVICE, false);
+        value_len = encode_application_bitstring(&value_apdu[0], &status_flags);
+        test_len += cov_notify_multiple_encode_apdu_property(
+            &test_apdu[test_len], PROP_STATUS_FLAGS, BACNET_ARRAY_ALL,
+            &value_apdu[0], value_len, NULL);
+        test_len += cov_notify_encode_apdu_end(&test_apdu[test_len]);
+        zassert_equal(test_len, len, NULL);
+        zassert_mem_equal(test_apdu, apdu, len, NULL);
+        if (confirmed) {
+            break;
+        }
+    }
+    zassert_equal(cov_notify_encode_apdu_init(NULL, false, 0, NULL), 0, NULL);
+    zassert_equal(cov_notify_encode_apdu_end(NULL), 1, NULL);
+}
+
 static void testCOVSubscribeData(
     BACNET_SUBSCRIBE_COV_DATA *data, BACNET_SUBSCRIBE_COV_DATA *test_data)
 {
@@ -363,6 +579,280 @@ static void testCOVSubscribeProperty(void)
     data.covIncrementPresent = false;
     testCOVSubscribePropertyEncoding(invoke_id, &data);
 }
+
+static void testCOVSubscribeMultipleEncoding(
+    uint8_t invoke_id, BACNET_SUBSCRIBE_COV_MULTIPLE_DATA *data)
+{
+    uint8_t apdu[480] = { 0 };
+    int len = 0;
+    int apdu_len = 0;
+    int null_len = 0;
+    BACNET_SUBSCRIBE_COV_MULTIPLE_DATA test_data = { 0 };
+    BACNET_SUBSCRIBE_COV_DATA test_subscription = { 0 };
+    BACNET_SUBSCRIBE_COV_DATA *subscription = NULL;
+    BACNET_OBJECT_ID object_id = { 0 };
+
+    null_len = cov_subscribe_multiple_encode_apdu(NULL, 0, invoke_id, data);
+    len = cov_subscribe_multiple_encode_apdu(
+        &apdu[0], sizeof(apdu), invoke_id, data);
+    zassert_true(len > 0, NULL);
+    zassert_equal(len, null_len, NULL);
+    zassert_equal(cov_subscribe_multiple_encode_apdu(
+                      &apdu[0], len - 1, invoke_id, data), 0, NULL);
+    apdu_len = len;
+    zassert_equal(apdu[0], PDU_TYPE_CONFIRMED_SERVICE_REQUEST, NULL);
+    zassert_equal(apdu[2], invoke_id, NULL);
+    zassert_equal(
+        apdu[3], SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY_MULTIPLE, NULL);
+    len = 4;
+    null_len = cov_subscribe_multiple_decode_service_request(
+        &apdu[len], apdu_len - len, &test_data);
+    zassert_true(null_len > 0, NULL);
+    len += null_len;
+    zassert_equal(test_data.subscriberProcessIdentifier,
+        data->subscriberProcessIdentifier, NULL);
+    zassert_equal(
+        test_data.cancellationRequest, data->cancellationRequest, NULL);
+    zassert_equal(
+        test_data.maxNotificationDelay, data->maxNotificationDelay, NULL);
+    if (!data->cancellationRequest) {
+        zassert_equal(test_data.issueConfirmedNotifications,
+            data->issueConfirmedNotifications, NULL);
+        zassert_equal(test_data.lifetime, data->lifetime, NULL);
+    }
+    subscription = data->listOfSubscriptions;
+    while (!bacnet_is_closing_tag_number(
+        &apdu[len], apdu_len - len, 4, &null_len)) {
+        null_len = cov_subscribe_multiple_decode_object_id(
+            &apdu[len], apdu_len - len, &object_id);
+        zassert_true(null_len > 0, NULL);
+        len += null_len;
+        while (!bacnet_is_closing_tag_number(
+            &apdu[len], apdu_len - len, 1, &null_len)) {
+            zassert_not_null(subscription, NULL);
+            null_len = cov_subscribe_multiple_decode_reference(
+                &apdu[len], apdu_len - len, &test_subscription);
+            zassert_true(null_len > 0, NULL);
+            len += null_len;
+            zassert_equal(object_id.type,
+                subscription->monitoredObjectIdentifier.type, NULL);
+            zassert_equal(object_id.instance,
+                subscription->monitoredObjectIdentifier.instance, NULL);
+            zassert_equal(test_subscription.monitoredProperty.propertyIdentifier,
+                subscription->monitoredProperty.propertyIdentifier, NULL);
+            zassert_equal(test_subscription.monitoredProperty.propertyArrayIndex,
+                subscription->monitoredProperty.propertyArrayIndex, NULL);
+            zassert_equal(test_subscription.covIncrementPresent,
+                subscription->covIncrementPresent, NULL);
+            if (subscription->covIncrementPresent) {
+                zassert_false(islessgreater(test_subscription.covIncrement,
+                                  subscription->covIncrement),
+                    NULL);
+            }
+            zassert_equal(
+                test_subscription.timestamped, subscription->timestamped, NULL);
+            subscription = subscription->next;
+        }
+        len += null_len;
+    }
+    len += null_len;
+    zassert_is_null(subscription, NULL);
+    zassert_equal(len, apdu_len, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cov_tests, testCOVSubscribePropertyMultiple)
+#else
+static void testCOVSubscribePropertyMultiple(void)
+#endif
+{
+    uint8_t invoke_id = 12;
+    uint8_t apdu[480] = { 0 };
+    int len = 0;
+    int null_len = 0;
+    BACNET_SUBSCRIBE_COV_MULTIPLE_DATA data = { 0 };
+    BACNET_SUBSCRIBE_COV_DATA subscription[3] = { 0 };
+    BACNET_SUBSCRIBE_COV_DATA test_subscription = { 0 };
+    BACNET_ERROR_CLASS error_class = ERROR_CLASS_DEVICE;
+    BACNET_ERROR_CODE error_code = ERROR_CODE_OTHER;
+
+    subscription[0].monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    subscription[0].monitoredObjectIdentifier.instance = 321;
+    subscription[0].monitoredProperty.propertyIdentifier = PROP_PRESENT_VALUE;
+    subscription[0].monitoredProperty.propertyArrayIndex = BACNET_ARRAY_ALL;
+    subscription[0].covIncrementPresent = true;
+    subscription[0].covIncrement = 0.5f;
+    subscription[0].timestamped = true;
+    subscription[0].next = &subscription[1];
+    subscription[1].monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    subscription[1].monitoredObjectIdentifier.instance = 321;
+    subscription[1].monitoredProperty.propertyIdentifier = PROP_STATUS_FLAGS;
+    subscription[1].monitoredProperty.propertyArrayIndex = BACNET_ARRAY_ALL;
+    subscription[1].next = &subscription[2];
+    subscription[2].monitoredObjectIdentifier.type = OBJECT_MULTI_STATE_VALUE;
+    subscription[2].monitoredObjectIdentifier.instance = 4;
+    subscription[2].monitoredProperty.propertyIdentifier = PROP_STATE_TEXT;
+    subscription[2].monitoredProperty.propertyArrayIndex = 2;
+    subscription[2].next = NULL;
+    data.subscriberProcessIdentifier = 1;
+    data.issueConfirmedNotifications = true;
+    data.lifetime = 456;
+    data.maxNotificationDelay = 5;
+    data.listOfSubscriptions = &subscription[0];
+    testCOVSubscribeMultipleEncoding(invoke_id, &data);
+    data.cancellationRequest = true;
+    data.maxNotificationDelay = 0;
+    testCOVSubscribeMultipleEncoding(invoke_id, &data);
+    /* error with the first failed subscription */
+    subscription[2].error_class = ERROR_CLASS_PROPERTY;
+    subscription[2].error_code = ERROR_CODE_NOT_COV_PROPERTY;
+    null_len = cov_subscribe_multiple_error_encode_apdu(NULL, invoke_id,
+        ERROR_CLASS_OBJECT, ERROR_CODE_UNKNOWN_OBJECT, &subscription[2]);
+    len = cov_subscribe_multiple_error_encode_apdu(&apdu[0], invoke_id,
+        ERROR_CLASS_OBJECT, ERROR_CODE_UNKNOWN_OBJECT, &subscription[2]);
+    zassert_true(len > 0, NULL);
+    zassert_equal(len, null_len, NULL);
+    zassert_equal(apdu[0], PDU_TYPE_ERROR, NULL);
+    zassert_equal(apdu[1], invoke_id, NULL);
+    null_len = cov_subscribe_multiple_error_decode_service_request(&apdu[3],
+        len - 3, &error_class, &error_code, &test_subscription);
+    zassert_equal(null_len, len - 3, NULL);
+    zassert_equal(error_class, ERROR_CLASS_OBJECT, NULL);
+    zassert_equal(error_code, ERROR_CODE_UNKNOWN_OBJECT, NULL);
+    zassert_equal(test_subscription.monitoredObjectIdentifier.type,
+        OBJECT_MULTI_STATE_VALUE, NULL);
+    zassert_equal(test_subscription.monitoredObjectIdentifier.instance, 4, NULL);
+    zassert_equal(test_subscription.monitoredProperty.propertyIdentifier,
+        PROP_STATE_TEXT, NULL);
+    zassert_equal(
+        test_subscription.monitoredProperty.propertyArrayIndex, 2, NULL);
+    zassert_equal(test_subscription.error_class, ERROR_CLASS_PROPERTY, NULL);
+    zassert_equal(
+        test_subscription.error_code, ERROR_CODE_NOT_COV_PROPERTY, NULL);
+    null_len = cov_subscribe_multiple_error_decode_service_request(
+        &apdu[3], len - 4, &error_class, &error_code, &test_subscription);
+    zassert_true(null_len < 0, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cov_tests, testCOVNotifyMultiple)
+#else
+static void testCOVNotifyMultiple(void)
+#endif
+{
+    uint8_t apdu[480] = { 0 };
+    uint8_t value_apdu[16] = { 0 };
+    int len = 0;
+    int apdu_len = 0;
+    int value_len = 0;
+    int test_len = 0;
+    BACNET_COV_MULTIPLE_DATA data = { 0 };
+    BACNET_COV_MULTIPLE_DATA test_data = { 0 };
+    BACNET_COV_MULTIPLE_NOTIFICATION notification[3] = { 0 };
+    BACNET_COV_MULTIPLE_VALUE value[4] = { 0 };
+    BACNET_OBJECT_ID object_id = { OBJECT_ANALOG_VALUE, 7 };
+    BACNET_TIME time_of_change = { 13, 14, 15, 16 };
+    bool confirmed = false;
+
+    data.subscriberProcessIdentifier = 1;
+    data.initiatingDeviceIdentifier = 123;
+    data.timeRemaining = 456;
+    data.timestampPresent = true;
+    datetime_set_values(&data.timestamp, 2024, 5, 6, 13, 14, 15, 16);
+    value_len = encode_application_real(&value_apdu[0], 42.5f);
+    for (confirmed = false;; confirmed = true) {
+        apdu_len = cov_notify_multiple_encode_apdu_init(
+            &apdu[0], confirmed, 5, &data);
+        zassert_equal(apdu_len,
+            cov_notify_multiple_encode_apdu_init(NULL, confirmed, 5, &data),
+            NULL);
+        apdu_len += cov_notify_multiple_encode_apdu_object_begin(
+            &apdu[apdu_len], &object_id);
+        apdu_len += cov_notify_multiple_encode_apdu_property(&apdu[apdu_len],
+            PROP_PRESENT_VALUE, BACNET_ARRAY_ALL, &value_apdu[0], value_len,
+            &time_of_change);
+        apdu_len += cov_notify_multiple_encode_apdu_property(&apdu[apdu_len],
+            PROP_PRIORITY_ARRAY, 16, &value_apdu[0], value_len, NULL);
+        apdu_len += cov_notify_multiple_encode_apdu_object_end(&apdu[apdu_len]);
+        object_id.instance++;
+        apdu_len += cov_notify_multiple_encode_apdu_object_begin(
+            &apdu[apdu_len], &object_id);
+        object_id.instance--;
+        apdu_len += cov_notify_multiple_encode_apdu_property(&apdu[apdu_len],
+            PROP_PRESENT_VALUE, BACNET_ARRAY_ALL, &value_apdu[0], value_len,
+            NULL);
+        apdu_len += cov_notify_multiple_encode_apdu_object_end(&apdu[apdu_len]);
+        apdu_len += cov_notify_multiple_encode_apdu_end(&apdu[apdu_len]);
+        if (confirmed) {
+            zassert_equal(apdu[0], PDU_TYPE_CONFIRMED_SERVICE_REQUEST, NULL);
+            zassert_equal(
+                apdu[3], SERVICE_CONFIRMED_COV_NOTIFICATION_MULTIPLE, NULL);
+            len = 4;
+        } else {
+            zassert_equal(apdu[0], PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST, NULL);
+            zassert_equal(
+                apdu[1], SERVICE_UNCONFIRMED_COV_NOTIFICATION_MULTIPLE, NULL);
+            len = 2;
+        }
+        notification[0].listOfValues = &value[0];
+        value[0].next = &value[1];
+        value[1].next = NULL;
+        notification[0].next = &notification[1];
+        notification[1].listOfValues = &value[2];
+        value[2].next = &value[3];
+        value[3].next = NULL;
+        notification[1].next = &notification[2];
+        notification[2].listOfValues = NULL;
+        notification[2].next = NULL;
+        test_data.listOfNotifications = &notification[0];
+        test_len = cov_notify_multiple_decode_service_request(
+            &apdu[len], apdu_len - len, &test_data);
+        zassert_equal(test_len, apdu_len - len, NULL);
+        zassert_equal(test_data.subscriberProcessIdentifier, 1, NULL);
+        zassert_equal(test_data.initiatingDeviceIdentifier, 123, NULL);
+        zassert_equal(test_data.timeRemaining, 456, NULL);
+        zassert_true(test_data.timestampPresent, NULL);
+        zassert_equal(
+            datetime_compare(&test_data.timestamp, &data.timestamp), 0, NULL);
+        zassert_equal(test_data.listOfNotifications, &notification[0], NULL);
+        zassert_equal(notification[0].monitoredObjectIdentifier.instance, 7,
+            NULL);
+        zassert_equal(value[0].propertyIdentifier, PROP_PRESENT_VALUE, NULL);
+        zassert_equal(value[0].propertyArrayIndex, BACNET_ARRAY_ALL, NULL);
+        zassert_equal(
+            value[0].value.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+        zassert_false(
+            islessgreater(value[0].value.type.Real, 42.5f), NULL);
+        zassert_true(value[0].timeOfChangePresent, NULL);
+        zassert_equal(
+            datetime_compare_time(&value[0].timeOfChange, &time_of_change), 0,
+            NULL);
+        zassert_equal(value[1].propertyIdentifier, PROP_PRIORITY_ARRAY, NULL);
+        zassert_equal(value[1].propertyArrayIndex, 16, NULL);
+        zassert_false(value[1].timeOfChangePresent, NULL);
+        zassert_equal(notification[1].monitoredObjectIdentifier.instance, 8,
+            NULL);
+        /* one value, so the unused value is unlinked */
+        zassert_is_null(value[2].next, NULL);
+        /* two notifications, so the unused one is unlinked */
+        zassert_is_null(notification[1].next, NULL);
+        /* no room for the second notification */
+        notification[0].next = NULL;
+        value[1].next = NULL;
+        test_len = cov_notify_multiple_decode_service_request(
+            &apdu[len], apdu_len - len, &test_data);
+        zassert_true(test_len < 0, NULL);
+        /* truncated */
+        notification[0].next = &notification[1];
+        notification[1].next = NULL;
+        test_len = cov_notify_multiple_decode_service_request(
+            &apdu[len], apdu_len - len - 1, &test_data);
+        zassert_true(test_len < 0, NULL);
+        if (confirmed) {
+            break;
+        }
+    }
+}
 /**
  * @}
  */
@@ -373,8 +863,13 @@ ZTEST_SUITE(cov_tests, NULL, NULL, NULL, NULL, NULL);
 void test_main(void)
 {
     ztest_test_suite(cov_tests, ztest_unit_test(testCOVNotify),
+        ztest_unit_test(testCOVNotifyCompact),
+        ztest_unit_test(testCOVNotifyValues),
+        ztest_unit_test(testCOVNotifyParts),
         ztest_unit_test(testCOVSubscribe),
-        ztest_unit_test(testCOVSubscribeProperty));
+        ztest_unit_test(testCOVSubscribeProperty),
+        ztest_unit_test(testCOVSubscribePropertyMultiple),
+        ztest_unit_test(testCOVNotifyMultiple));
 
     ztest_run_test_suite(cov_tests);
 }
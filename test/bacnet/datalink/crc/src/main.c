@@ -131,6 +131,48 @@ static void testCRC16CreateTable(void)
     }
     printf("};\n");
 }
+/**
+ * @brief Test the block CRC against the octet at a time CRC
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(crc_tests, testCRCBlock)
+#else
+static void testCRCBlock(void)
+#endif
+{
+    uint8_t buffer[512];
+    uint8_t crc8 = 0xFF;
+    uint16_t crc16 = 0xFFFF;
+    uint16_t data_crc;
+    unsigned i;
+
+    for (i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)(i * 7 + 3);
+        crc8 = CRC_Calc_Header(buffer[i], crc8);
+        crc16 = CRC_Calc_Data(buffer[i], crc16);
+    }
+    zassert_equal(CRC_Calc_Header_Block(buffer, sizeof(buffer), 0xFF), crc8,
+        NULL);
+    zassert_equal(CRC_Calc_Data_Block(buffer, sizeof(buffer), 0xFFFF), crc16,
+        NULL);
+    /* in pieces */
+    crc16 = CRC_Calc_Data_Block(buffer, 100, 0xFFFF);
+    crc16 = CRC_Calc_Data_Block(&buffer[100], sizeof(buffer) - 100, crc16);
+    zassert_equal(CRC_Calc_Data_Block(buffer, sizeof(buffer), 0xFFFF), crc16,
+        NULL);
+    zassert_equal(CRC_Calc_Data_Block(buffer, 0, 0x1234), 0x1234, NULL);
+    /* Annex G 2.0 of BACnet Standard, including the CRC octets */
+    buffer[0] = 0x01;
+    buffer[1] = 0x22;
+    buffer[2] = 0x30;
+    crc16 = CRC_Calc_Data_Block(buffer, 3, 0xFFFF);
+    zassert_equal(crc16, 0x42EF, NULL);
+    data_crc = ~crc16;
+    buffer[3] = LO_BYTE(data_crc);
+    buffer[4] = HI_BYTE(data_crc);
+    zassert_equal(CRC_Calc_Data_Block(buffer, 5, 0xFFFF), 0xF0B8, NULL);
+}
+
 /**
  * @}
  */
@@ -144,6 +186,7 @@ void test_main(void)
     ztest_test_suite(crc_tests,
      ztest_unit_test(testCRC8),
      ztest_unit_test(testCRC16),
+     ztest_unit_test(testCRCBlock),
      ztest_unit_test(testCRC8CreateTable),
      ztest_unit_test(testCRC16CreateTable)
      );
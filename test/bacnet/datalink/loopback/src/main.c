@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Unit test for the in-process loopback datalink
+ * @date October 2026
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/bacaddr.h>
+#include <bacnet/datalink/loopback.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+/**
+ * @brief Test the packets in both directions of the loopback
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(loopback_tests, testLoopback)
+#else
+static void testLoopback(void)
+#endif
+{
+    uint8_t pdu[16] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t rx_pdu[16] = { 0 };
+    BACNET_ADDRESS address = { 0 };
+    BACNET_ADDRESS rx_address = { 0 };
+    uint16_t pdu_len;
+    unsigned i;
+    int len;
+    bool status;
+
+    zassert_false(loopback_init("0"), NULL);
+    zassert_false(loopback_init("255"), NULL);
+    zassert_true(loopback_init("7"), NULL);
+    loopback_get_my_address(&address);
+    zassert_equal(address.mac_len, 1, NULL);
+    zassert_equal(address.mac[0], 7, NULL);
+    loopback_get_broadcast_address(&address);
+    zassert_equal(address.mac[0], LOOPBACK_BROADCAST_ADDRESS, NULL);
+    zassert_equal(address.net, BACNET_BROADCAST_NETWORK, NULL);
+    /* from this node to the peer */
+    address.mac[0] = 9;
+    address.net = 0;
+    len = loopback_send_pdu(&address, NULL, pdu, 8);
+    zassert_equal(len, 8, NULL);
+    zassert_equal(loopback_peer_receive_pending(), 1, NULL);
+    pdu_len = loopback_peer_receive(&rx_address, rx_pdu, sizeof(rx_pdu));
+    zassert_equal(pdu_len, 8, NULL);
+    zassert_equal(memcmp(rx_pdu, pdu, 8), 0, NULL);
+    zassert_true(bacnet_address_same(&rx_address, &address), NULL);
+    zassert_equal(loopback_peer_receive(NULL, rx_pdu, sizeof(rx_pdu)), 0, NULL);
+    /* from the peer to this node */
+    status = loopback_peer_send(&address, pdu, 4);
+    zassert_true(status, NULL);
+    zassert_equal(loopback_receive_pending(), 1, NULL);
+    pdu_len = loopback_receive(&rx_address, rx_pdu, sizeof(rx_pdu), 0);
+    zassert_equal(pdu_len, 4, NULL);
+    zassert_equal(memcmp(rx_pdu, pdu, 4), 0, NULL);
+    zassert_true(bacnet_address_same(&rx_address, &address), NULL);
+    zassert_equal(loopback_receive(NULL, rx_pdu, sizeof(rx_pdu), 0), 0, NULL);
+    /* a full queue drops the packet */
+    for (i = 0; i < LOOPBACK_QUEUE_SIZE; i++) {
+        zassert_true(loopback_peer_send(&address, pdu, 4), NULL);
+    }
+    zassert_false(loopback_peer_send(&address, pdu, 4), NULL);
+    zassert_equal(loopback_dropped(), 1, NULL);
+    /* a packet larger than the buffer is dropped */
+    pdu_len = loopback_receive(NULL, rx_pdu, 2, 0);
+    zassert_equal(pdu_len, 0, NULL);
+    zassert_equal(loopback_dropped(), 2, NULL);
+    zassert_equal(loopback_receive_pending(), LOOPBACK_QUEUE_SIZE - 1, NULL);
+    loopback_cleanup();
+    zassert_equal(loopback_receive_pending(), 0, NULL);
+    zassert_equal(loopback_peer_receive_pending(), 0, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(loopback_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(loopback_tests, ztest_unit_test(testLoopback));
+
+    ztest_run_test_suite(loopback_tests);
+}
+#endif
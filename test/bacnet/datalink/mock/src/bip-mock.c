@@ -13,6 +13,11 @@
 #include <stdio.h>
 #include "bacnet/datalink/bip.h"
 
+/* the datalink ports send re-encoded copies of the address and the
+   network information, so their content is checked instead of the
+   pointers of the caller */
+bool Mock_Send_PDU_Check_Data;
+
 bool bip_init(char *ifname)
 {
     ztest_check_expected_value(ifname);
@@ -49,8 +54,13 @@ int bip_send_pdu(BACNET_ADDRESS *dest,
     uint8_t *pdu,
     unsigned pdu_len)
 {
-    ztest_check_expected_value(dest);
-    ztest_check_expected_value(npdu_data);
+    if (Mock_Send_PDU_Check_Data) {
+        ztest_check_expected_data(dest, sizeof(BACNET_ADDRESS));
+        ztest_check_expected_data(npdu_data, sizeof(BACNET_NPDU_DATA));
+    } else {
+        ztest_check_expected_value(dest);
+        ztest_check_expected_value(npdu_data);
+    }
     ztest_check_expected_data(pdu, pdu_len);
     return ztest_get_return_value();
 }
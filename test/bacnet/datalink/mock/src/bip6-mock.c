@@ -114,3 +114,8 @@ void bip6_receive_callback(void)
 void bip6_debug_enable(void)
 {
 }
+
+int bip6_get_socket(void)
+{
+    return ztest_get_return_value();
+}
@@ -9,6 +9,8 @@
 #include <stdlib.h>
 #include "bacnet/datalink/dlmstp.h"
 
+extern bool Mock_Send_PDU_Check_Data;
+
 bool dlmstp_init(char *ifname)
 {
     ztest_check_expected_value(ifname);
@@ -26,8 +28,13 @@ void dlmstp_cleanup(void)
 int dlmstp_send_pdu(BACNET_ADDRESS *dest, BACNET_NPDU_DATA *npdu_data,
                     uint8_t * pdu, unsigned pdu_len)
 {
-    ztest_check_expected_value(dest);
-    ztest_check_expected_value(npdu_data);
+    if (Mock_Send_PDU_Check_Data) {
+        ztest_check_expected_data(dest, sizeof(BACNET_ADDRESS));
+        ztest_check_expected_data(npdu_data, sizeof(BACNET_NPDU_DATA));
+    } else {
+        ztest_check_expected_value(dest);
+        ztest_check_expected_value(npdu_data);
+    }
     ztest_check_expected_data(pdu, pdu_len);
     return ztest_get_return_value();
 }
@@ -9,9 +9,13 @@
  */
 
 #include <stdlib.h>  /* For calloc() */
+#include <unistd.h>  /* For pipe() */
 #include <zephyr/ztest.h>
 #include <bacnet/datalink/datalink.h>
 #include "bacnet/apdu.h"
+#include "bacnet/npdu.h"
+
+extern bool Mock_Send_PDU_Check_Data;
 
 void bvlc_maintenance_timer(uint16_t seconds)
 {
@@ -442,6 +446,401 @@ static void test_datalink_ethernet(void)
     datalink_maintenance_timer(42);
 }
 
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(datalink_tests, test_datalink_ports)
+#else
+static void test_datalink_ports(void)
+#endif
+{
+    char *iface = "bla-bla-bla";
+    char *iface2 = "bla-bla-bla2";
+    uint8_t empty[32] = { 0 };
+    uint8_t data[32] = { 0 };
+    uint8_t rx[32] = { 0 };
+    /* confirmed request from MS/TP station 0x12 on the local network */
+    uint8_t request[] = { 0x01, 0x04, 0x00, 0x05, 0x01, 0x0C };
+    /* the request with the SNET of the MS/TP port added */
+    uint8_t request_snet[] = { 0x01, 0x0C, 0x00, 0x02, 0x01, 0x12, 0x00,
+        0x05, 0x01, 0x0C };
+    /* reply routed back to network 2 */
+    uint8_t reply[] = { 0x01, 0x20, 0x00, 0x02, 0x01, 0x12, 0xFF, 0x20,
+        0x01, 0x0C };
+    uint8_t reply_local[] = { 0x01, 0x00, 0x20, 0x01, 0x0C };
+    /* Who-Is from network 7 behind the MS/TP router 0x22 */
+    uint8_t who_is[] = { 0x01, 0x08, 0x00, 0x07, 0x01, 0x05, 0x10, 0x08 };
+    /* unconfirmed request from IP to network 2 station 0x33 */
+    uint8_t forward[] = { 0x01, 0x20, 0x00, 0x02, 0x01, 0x33, 0xFF, 0x10,
+        0x08 };
+    uint8_t forward_local[] = { 0x01, 0x08, 0x00, 0x01, 0x06, 0xC0, 0xA8,
+        0x00, 0x01, 0xBA, 0xC0, 0x10, 0x08 };
+    BACNET_ADDRESS addr = { 0 };
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_ADDRESS mac = { 0 };
+    BACNET_ADDRESS router = { 0 };
+    BACNET_ADDRESS ip_addr = { 0 };
+    BACNET_ADDRESS broadcast = { 0 };
+    BACNET_ADDRESS npdu_addr = { 0 };
+    BACNET_NPDU_DATA npdu = { 0 };
+    BACNET_NPDU_DATA forward_npdu = { 0 };
+    unsigned port = 0;
+    int fd[2] = { -1, -1 };
+    uint8_t octet = 0;
+
+    Mock_Send_PDU_Check_Data = true;
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+    zassert_equal(datalink_port_count(), 0, NULL);
+    zassert_equal(pipe(fd), 0, NULL);
+
+    // add - the socket of the IP port is waited on for readiness
+    ztest_expect_value(bip_init, ifname, iface);
+    ztest_returns_value(bip_init, true);
+    ztest_returns_value(bip_get_socket, fd[0]);
+    ztest_returns_value(bip_get_broadcast_socket, fd[0]);
+    zassert_true(datalink_port_add("bip", iface, 1), NULL);
+    ztest_expect_value(dlmstp_init, ifname, iface2);
+    ztest_returns_value(dlmstp_init, true);
+    zassert_true(datalink_port_add("mstp", iface2, 2), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+    /* same datalink, same network, unknown datalink, invalid network */
+    zassert_false(datalink_port_add("bip", iface, 3), NULL);
+    zassert_false(datalink_port_add("bip6", iface, 2), NULL);
+    zassert_false(datalink_port_add("bla", iface, 3), NULL);
+    zassert_false(datalink_port_add("bip6", iface, 0), NULL);
+    zassert_equal(datalink_port_count(), 2, NULL);
+    zassert_equal(datalink_port_network(0), 1, NULL);
+    zassert_equal(datalink_port_network(1), 2, NULL);
+    zassert_equal(datalink_port_network(2), 0, NULL);
+
+    // receive - every port is checked before waiting, and a request
+    // from the MS/TP port gains the SNET of its network
+    addr.mac_len = 1;
+    addr.mac[0] = 0x12;
+    memcpy(rx, request, sizeof(request));
+    ztest_expect_value(bip_receive, src, &addr);
+    ztest_expect_value(bip_receive, timeout, 0);
+    ztest_expect_data(bip_receive, pdu, empty);
+    ztest_returns_value(bip_receive, 0);
+    ztest_expect_value(dlmstp_receive, src, &addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, rx);
+    ztest_returns_value(dlmstp_receive, sizeof(request));
+    zassert_equal(datalink_port_receive(&addr, data, sizeof(data), 10,
+        &port), sizeof(request_snet), NULL);
+    zassert_mem_equal(request_snet, data, sizeof(request_snet), NULL);
+    zassert_equal(port, 1, NULL);
+    zassert_equal(datalink_port_active(), 1, NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // my address and broadcast address are on the home network port
+    ip_addr.mac_len = 6;
+    ip_addr.mac[0] = 0xC0;
+    ip_addr.mac[1] = 0xA8;
+    ip_addr.mac[2] = 0x00;
+    ip_addr.mac[3] = 0x01;
+    ip_addr.mac[4] = 0xBA;
+    ip_addr.mac[5] = 0xC0;
+    ztest_expect_value(bip_get_my_address, my_address, &ip_addr);
+    datalink_get_my_address(&dest);
+    zassert_mem_equal(&ip_addr, &dest, sizeof(dest), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // send_pdu - reply to network 2 goes out the MS/TP port without DNET
+    dest = addr;
+    dest.net = 2;
+    dest.len = 1;
+    dest.adr[0] = 0x12;
+    mac.mac_len = 1;
+    mac.mac[0] = 0x12;
+    bacnet_npdu_decode(reply, sizeof(reply), &npdu_addr, NULL, &npdu);
+    ztest_expect_data(dlmstp_send_pdu, dest, &mac);
+    ztest_expect_data(dlmstp_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(dlmstp_send_pdu, pdu, reply_local);
+    ztest_returns_value(dlmstp_send_pdu, sizeof(reply_local));
+    zassert_equal(datalink_send_pdu(&dest, &npdu, reply, sizeof(reply)),
+        sizeof(reply_local), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // send_pdu - global broadcast goes out every port
+    broadcast.net = BACNET_BROADCAST_NETWORK;
+    ztest_expect_data(bip_send_pdu, dest, &broadcast);
+    ztest_expect_data(bip_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(bip_send_pdu, pdu, who_is);
+    ztest_returns_value(bip_send_pdu, sizeof(who_is));
+    ztest_expect_data(dlmstp_send_pdu, dest, &broadcast);
+    ztest_expect_data(dlmstp_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(dlmstp_send_pdu, pdu, who_is);
+    ztest_returns_value(dlmstp_send_pdu, sizeof(who_is));
+    zassert_equal(datalink_send_pdu(&broadcast, &npdu, who_is,
+        sizeof(who_is)), sizeof(who_is), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // receive - the route to the SNET of a PDU is learned
+    router.mac_len = 1;
+    router.mac[0] = 0x22;
+    addr = router;
+    memset(rx, 0, sizeof(rx));
+    memcpy(rx, who_is, sizeof(who_is));
+    ztest_expect_value(bip_receive, src, &addr);
+    ztest_expect_value(bip_receive, timeout, 0);
+    ztest_expect_data(bip_receive, pdu, empty);
+    ztest_returns_value(bip_receive, 0);
+    ztest_expect_value(dlmstp_receive, src, &addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, rx);
+    ztest_returns_value(dlmstp_receive, sizeof(who_is));
+    zassert_equal(datalink_receive(&addr, data, sizeof(data), 0),
+        sizeof(who_is), NULL);
+    zassert_mem_equal(who_is, data, sizeof(who_is), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+    dest.net = 7;
+    dest.len = 1;
+    dest.adr[0] = 0x05;
+    ztest_expect_data(dlmstp_send_pdu, dest, &router);
+    ztest_expect_data(dlmstp_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(dlmstp_send_pdu, pdu, reply);
+    ztest_returns_value(dlmstp_send_pdu, sizeof(reply));
+    zassert_equal(datalink_send_pdu(&dest, &npdu, reply, sizeof(reply)),
+        sizeof(reply), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // receive - a readable socket wakes the wait, and a PDU for the
+    // network of the MS/TP port is forwarded instead of returned
+    zassert_equal(write(fd[1], &octet, 1), 1, NULL);
+    addr = ip_addr;
+    memset(rx, 0, sizeof(rx));
+    memcpy(rx, forward, sizeof(forward));
+    mac.mac[0] = 0x33;
+    bacnet_npdu_decode(forward, sizeof(forward), &npdu_addr, NULL,
+        &forward_npdu);
+    forward_npdu.hop_count--;
+    ztest_expect_value(bip_receive, src, &addr);
+    ztest_expect_value(bip_receive, timeout, 0);
+    ztest_expect_data(bip_receive, pdu, empty);
+    ztest_returns_value(bip_receive, 0);
+    ztest_expect_value(dlmstp_receive, src, &addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, empty);
+    ztest_returns_value(dlmstp_receive, 0);
+    ztest_expect_value(bip_receive, src, &addr);
+    ztest_expect_value(bip_receive, timeout, 0);
+    ztest_expect_data(bip_receive, pdu, rx);
+    ztest_returns_value(bip_receive, sizeof(forward));
+    ztest_expect_data(dlmstp_send_pdu, dest, &mac);
+    ztest_expect_data(dlmstp_send_pdu, npdu_data, &forward_npdu);
+    ztest_expect_data(dlmstp_send_pdu, pdu, forward_local);
+    ztest_returns_value(dlmstp_send_pdu, sizeof(forward_local));
+    ztest_expect_value(dlmstp_receive, src, &addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, empty);
+    ztest_returns_value(dlmstp_receive, 0);
+    zassert_equal(datalink_port_receive(&addr, data, sizeof(data), 1000,
+        &port), 0, NULL);
+    zassert_equal(datalink_port_active(), 0, NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+    zassert_equal(read(fd[0], &octet, 1), 1, NULL);
+
+    // receive - while waiting, the MS/TP port without a socket is polled
+    ztest_expect_value(dlmstp_receive, src, &addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, empty);
+    ztest_returns_value(dlmstp_receive, 0);
+    ztest_expect_value(bip_receive, src, &addr);
+    ztest_expect_value(bip_receive, timeout, 0);
+    ztest_expect_data(bip_receive, pdu, empty);
+    ztest_returns_value(bip_receive, 0);
+    ztest_expect_value(dlmstp_receive, src, &addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, empty);
+    ztest_returns_value(dlmstp_receive, 0);
+    ztest_expect_value(dlmstp_receive, src, &addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, empty);
+    ztest_returns_value(dlmstp_receive, 0);
+    zassert_equal(datalink_receive(&addr, data, sizeof(data),
+        2 * DATALINK_PORT_POLL_MS), 0, NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // maintenance_timer - every port
+    ztest_expect_value(bvlc_maintenance_timer, seconds, 42);
+    datalink_maintenance_timer(42);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    datalink_cleanup();
+    zassert_equal(datalink_port_count(), 0, NULL);
+    close(fd[0]);
+    close(fd[1]);
+    Mock_Send_PDU_Check_Data = false;
+}
+
+/**
+ * @brief Receive a PDU on the one port that is polled first
+ */
+static void test_datalink_ports_receive_on(unsigned port,
+    BACNET_ADDRESS *src,
+    uint8_t *rx,
+    uint16_t rx_len,
+    uint8_t *pdu,
+    uint16_t pdu_len)
+{
+    uint8_t data[32] = { 0 };
+    unsigned rx_port = 0;
+
+    if (port == 0) {
+        ztest_expect_value(bip_receive, src, src);
+        ztest_expect_value(bip_receive, timeout, 0);
+        ztest_expect_data(bip_receive, pdu, rx);
+        ztest_returns_value(bip_receive, rx_len);
+    } else {
+        ztest_expect_value(dlmstp_receive, src, src);
+        ztest_expect_value(dlmstp_receive, timeout, 0);
+        ztest_expect_data(dlmstp_receive, pdu, rx);
+        ztest_returns_value(dlmstp_receive, rx_len);
+    }
+    zassert_equal(datalink_port_receive(src, data, sizeof(data), 0,
+        &rx_port), pdu_len, NULL);
+    zassert_mem_equal(pdu, data, pdu_len, NULL);
+    zassert_equal(rx_port, port, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(datalink_tests, test_datalink_ports_network_messages)
+#else
+static void test_datalink_ports_network_messages(void)
+#endif
+{
+    char *iface = "bla-bla-bla";
+    char *iface2 = "bla-bla-bla2";
+    uint8_t empty[32] = { 0 };
+    uint8_t data[32] = { 0 };
+    uint8_t rx[32] = { 0 };
+    /* Who-Is-Router-To-Network from MS/TP station 0x12 */
+    uint8_t who_is_router[] = { 0x01, 0x80, 0x00 };
+    uint8_t who_is_router_snet[] = { 0x01, 0x88, 0x00, 0x02, 0x01, 0x12,
+        0x00 };
+    /* I-Am-Router-To-Network for network 1 of the IP port */
+    uint8_t i_am_router_1[] = { 0x01, 0x80, 0x01, 0x00, 0x01 };
+    /* I-Am-Router-To-Network for network 9 from the IP router */
+    uint8_t i_am_router_9[] = { 0x01, 0x80, 0x01, 0x00, 0x09 };
+    /* Who-Is-Router-To-Network 9 from MS/TP station 0x12 */
+    uint8_t who_is_router_9[] = { 0x01, 0x80, 0x00, 0x00, 0x09 };
+    uint8_t who_is_router_9_snet[] = { 0x01, 0x88, 0x00, 0x02, 0x01, 0x12,
+        0x00, 0x00, 0x09 };
+    /* Reject-Message-To-Network 9, no route, from the IP router */
+    uint8_t reject_9[] = { 0x01, 0x80, 0x03, 0x01, 0x00, 0x09 };
+    BACNET_ADDRESS mstp_addr = { 0 };
+    BACNET_ADDRESS ip_router = { 0 };
+    BACNET_ADDRESS mstp_broadcast = { 0 };
+    BACNET_ADDRESS ip_broadcast = { 0 };
+    BACNET_ADDRESS npdu_addr = { 0 };
+    BACNET_NPDU_DATA npdu = { 0 };
+
+    Mock_Send_PDU_Check_Data = true;
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+    ztest_expect_value(bip_init, ifname, iface);
+    ztest_returns_value(bip_init, true);
+    ztest_returns_value(bip_get_socket, -1);
+    ztest_returns_value(bip_get_broadcast_socket, -1);
+    zassert_true(datalink_port_add("bip", iface, 1), NULL);
+    ztest_expect_value(dlmstp_init, ifname, iface2);
+    ztest_returns_value(dlmstp_init, true);
+    zassert_true(datalink_port_add("mstp", iface2, 2), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+    mstp_addr.mac_len = 1;
+    mstp_addr.mac[0] = 0x12;
+    mstp_broadcast.mac_len = 1;
+    mstp_broadcast.mac[0] = 0xFF;
+    ip_router.mac_len = 6;
+    ip_router.mac[0] = 0xC0;
+    ip_router.mac[1] = 0xA8;
+    ip_router.mac[3] = 0x02;
+    ip_router.mac[4] = 0xBA;
+    ip_router.mac[5] = 0xC0;
+    ip_broadcast.mac_len = 6;
+    memset(ip_broadcast.mac, 0xFF, 4);
+    ip_broadcast.mac[4] = 0xBA;
+    ip_broadcast.mac[5] = 0xC0;
+
+    // Who-Is-Router-To-Network is answered with the network of the
+    // other port, and is still passed up with the SNET of the port
+    ztest_expect_value(bip_receive, src, &mstp_addr);
+    ztest_expect_value(bip_receive, timeout, 0);
+    ztest_expect_data(bip_receive, pdu, empty);
+    ztest_returns_value(bip_receive, 0);
+    memcpy(rx, who_is_router, sizeof(who_is_router));
+    npdu_encode_npdu_network(&npdu, NETWORK_MESSAGE_I_AM_ROUTER_TO_NETWORK,
+        false, MESSAGE_PRIORITY_NORMAL);
+    ztest_expect_value(dlmstp_get_broadcast_address, dest, &mstp_broadcast);
+    ztest_expect_data(dlmstp_send_pdu, dest, &mstp_broadcast);
+    ztest_expect_data(dlmstp_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(dlmstp_send_pdu, pdu, i_am_router_1);
+    ztest_returns_value(dlmstp_send_pdu, sizeof(i_am_router_1));
+    test_datalink_ports_receive_on(1, &mstp_addr, rx, sizeof(who_is_router),
+        who_is_router_snet, sizeof(who_is_router_snet));
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // I-Am-Router-To-Network is learned and the new network is
+    // announced on the other port
+    memset(rx, 0, sizeof(rx));
+    memcpy(rx, i_am_router_9, sizeof(i_am_router_9));
+    memset(&npdu, 0, sizeof(npdu));
+    bacnet_npdu_decode(i_am_router_9, sizeof(i_am_router_9), &npdu_addr,
+        NULL, &npdu);
+    ztest_expect_value(dlmstp_get_broadcast_address, dest, &mstp_broadcast);
+    ztest_expect_data(dlmstp_send_pdu, dest, &mstp_broadcast);
+    ztest_expect_data(dlmstp_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(dlmstp_send_pdu, pdu, i_am_router_9);
+    ztest_returns_value(dlmstp_send_pdu, sizeof(i_am_router_9));
+    test_datalink_ports_receive_on(0, &ip_router, rx, sizeof(i_am_router_9),
+        i_am_router_9, sizeof(i_am_router_9));
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // Who-Is-Router-To-Network for the learned network is answered
+    memset(rx, 0, sizeof(rx));
+    memcpy(rx, who_is_router_9, sizeof(who_is_router_9));
+    memset(&npdu, 0, sizeof(npdu));
+    npdu_encode_npdu_network(&npdu, NETWORK_MESSAGE_I_AM_ROUTER_TO_NETWORK,
+        false, MESSAGE_PRIORITY_NORMAL);
+    ztest_expect_value(dlmstp_get_broadcast_address, dest, &mstp_broadcast);
+    ztest_expect_data(dlmstp_send_pdu, dest, &mstp_broadcast);
+    ztest_expect_data(dlmstp_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(dlmstp_send_pdu, pdu, i_am_router_9);
+    ztest_returns_value(dlmstp_send_pdu, sizeof(i_am_router_9));
+    test_datalink_ports_receive_on(1, &mstp_addr, rx, sizeof(who_is_router_9),
+        who_is_router_9_snet, sizeof(who_is_router_9_snet));
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // Reject-Message-To-Network from the router forgets the route
+    memset(rx, 0, sizeof(rx));
+    memcpy(rx, reject_9, sizeof(reject_9));
+    test_datalink_ports_receive_on(0, &ip_router, rx, sizeof(reject_9),
+        reject_9, sizeof(reject_9));
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    // Who-Is-Router-To-Network for an unknown network goes out the
+    // other port to ask its routers
+    memset(rx, 0, sizeof(rx));
+    memcpy(rx, who_is_router_9, sizeof(who_is_router_9));
+    memset(&npdu, 0, sizeof(npdu));
+    bacnet_npdu_decode(who_is_router_9, sizeof(who_is_router_9), &npdu_addr,
+        NULL, &npdu);
+    ztest_expect_value(dlmstp_receive, src, &mstp_addr);
+    ztest_expect_value(dlmstp_receive, timeout, 0);
+    ztest_expect_data(dlmstp_receive, pdu, rx);
+    ztest_returns_value(dlmstp_receive, sizeof(who_is_router_9));
+    ztest_expect_value(bip_get_broadcast_address, dest, &ip_broadcast);
+    ztest_expect_data(bip_send_pdu, dest, &ip_broadcast);
+    ztest_expect_data(bip_send_pdu, npdu_data, &npdu);
+    ztest_expect_data(bip_send_pdu, pdu, who_is_router_9_snet);
+    ztest_returns_value(bip_send_pdu, sizeof(who_is_router_9_snet));
+    zassert_equal(datalink_receive(&mstp_addr, data, sizeof(data), 0),
+        sizeof(who_is_router_9_snet), NULL);
+    zassert_mem_equal(who_is_router_9_snet, data,
+        sizeof(who_is_router_9_snet), NULL);
+    zassert_equal(z_cleanup_mock(), 0, NULL);
+
+    datalink_cleanup();
+    Mock_Send_PDU_Check_Data = false;
+}
 
 /**
  * @}
@@ -457,7 +856,9 @@ void test_main(void)
      ztest_unit_test(test_datalink_bip),
      ztest_unit_test(test_datalink_bip6),
      ztest_unit_test(test_datalink_dlmstp),
-     ztest_unit_test(test_datalink_ethernet)
+     ztest_unit_test(test_datalink_ethernet),
+     ztest_unit_test(test_datalink_ports),
+     ztest_unit_test(test_datalink_ports_network_messages)
      );
 
     ztest_run_test_suite(datalink_tests);
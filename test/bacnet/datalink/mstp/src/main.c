@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2026 by the BACnet Stack contributors.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* @file
+ * @brief test BACnet MS/TP receive frame state machine
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+#include <bacnet/datalink/crc.h>
+#include <bacnet/datalink/mstp.h>
+#include <bacnet/datalink/mstpdef.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define THIS_STATION 5
+
+/* a frame as seen by the node state machine */
+struct test_frame {
+    bool valid;
+    bool not_for_us;
+    bool invalid;
+    uint8_t frame_type;
+    uint8_t destination;
+    uint8_t source;
+    uint16_t data_length;
+    uint8_t data[MAX_PDU];
+};
+
+static uint32_t Silence_Timer;
+static uint8_t Input_Buffer[MAX_PDU];
+static uint8_t Output_Buffer[MAX_PDU];
+/* type of the last frame the node state machine sent */
+static uint8_t Send_Frame_Type;
+
+static uint32_t test_silence_timer(void *pArg)
+{
+    (void)pArg;
+    return Silence_Timer;
+}
+
+static void test_silence_timer_reset(void *pArg)
+{
+    (void)pArg;
+    Silence_Timer = 0;
+}
+
+/* functions the datalink layer provides to the MS/TP state machines */
+uint16_t MSTP_Put_Receive(volatile struct mstp_port_struct_t *mstp_port)
+{
+    (void)mstp_port;
+    return 0;
+}
+
+uint16_t MSTP_Get_Send(
+    volatile struct mstp_port_struct_t *mstp_port, unsigned timeout)
+{
+    (void)mstp_port;
+    (void)timeout;
+    return 0;
+}
+
+uint16_t MSTP_Get_Reply(
+    volatile struct mstp_port_struct_t *mstp_port, unsigned timeout)
+{
+    (void)mstp_port;
+    (void)timeout;
+    return 0;
+}
+
+void MSTP_Send_Frame(volatile struct mstp_port_struct_t *mstp_port,
+    uint8_t *buffer,
+    uint16_t nbytes)
+{
+    (void)mstp_port;
+    if (nbytes > 2) {
+        Send_Frame_Type = buffer[2];
+    }
+}
+
+static void test_port_init(struct mstp_port_struct_t *mstp_port)
+{
+    memset(mstp_port, 0, sizeof(*mstp_port));
+    mstp_port->InputBuffer = Input_Buffer;
+    mstp_port->InputBufferSize = sizeof(Input_Buffer);
+    mstp_port->OutputBuffer = Output_Buffer;
+    mstp_port->OutputBufferSize = sizeof(Output_Buffer);
+    mstp_port->SilenceTimer = test_silence_timer;
+    mstp_port->SilenceTimerReset = test_silence_timer_reset;
+    mstp_port->This_Station = THIS_STATION;
+    mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+    Silence_Timer = 0;
+    Send_Frame_Type = 0xFF;
+}
+
+/**
+ * @brief Take the frame from the port, as the node state machine does
+ * @return true if there was a frame
+ */
+static bool test_frame_take(
+    struct mstp_port_struct_t *mstp_port, struct test_frame *frame)
+{
+    if (!mstp_port->ReceivedValidFrame && !mstp_port->ReceivedInvalidFrame &&
+        !mstp_port->ReceivedValidFrameNotForUs) {
+        return false;
+    }
+    memset(frame, 0, sizeof(*frame));
+    frame->valid = mstp_port->ReceivedValidFrame;
+    frame->not_for_us = mstp_port->ReceivedValidFrameNotForUs;
+    frame->invalid = mstp_port->ReceivedInvalidFrame;
+    frame->frame_type = mstp_port->FrameType;
+    frame->destination = mstp_port->DestinationAddress;
+    frame->source = mstp_port->SourceAddress;
+    frame->data_length = mstp_port->DataLength;
+    if (frame->valid && (frame->data_length <= sizeof(frame->data))) {
+        memcpy(frame->data, mstp_port->InputBuffer, frame->data_length);
+    }
+    mstp_port->ReceivedValidFrame = false;
+    mstp_port->ReceivedValidFrameNotForUs = false;
+    mstp_port->ReceivedInvalidFrame = false;
+
+    return true;
+}
+
+/**
+ * @brief Receive octets one at a time
+ * @return number of frames received
+ */
+static unsigned test_receive_octets(struct mstp_port_struct_t *mstp_port,
+    const uint8_t *stream,
+    unsigned length,
+    struct test_frame *frames,
+    unsigned frames_max)
+{
+    unsigned count = 0;
+    unsigned i;
+
+    for (i = 0; i < length; i++) {
+        mstp_port->DataRegister = stream[i];
+        mstp_port->DataAvailable = true;
+        MSTP_Receive_Frame_FSM(mstp_port);
+        if ((count < frames_max) &&
+            test_frame_take(mstp_port, &frames[count])) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Receive octets in blocks of the given size
+ * @return number of frames received
+ */
+static unsigned test_receive_blocks(struct mstp_port_struct_t *mstp_port,
+    const uint8_t *stream,
+    unsigned length,
+    unsigned block_size,
+    struct test_frame *frames,
+    unsigned frames_max)
+{
+    unsigned count = 0;
+    unsigned offset = 0;
+    unsigned block_end = 0;
+
+    while (offset < length) {
+        block_end = offset + block_size;
+        if (block_end > length) {
+            block_end = length;
+        }
+        while (offset < block_end) {
+            offset += MSTP_Receive_Frame_Block(
+                mstp_port, &stream[offset], block_end - offset);
+            if ((count < frames_max) &&
+                test_frame_take(mstp_port, &frames[count])) {
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Build a stream of frames with noise and errors between them
+ * @return number of octets in the stream
+ */
+static unsigned test_stream_init(uint8_t *stream, unsigned stream_size)
+{
+    uint8_t data[MAX_PDU];
+    unsigned length = 0;
+    unsigned i;
+
+    for (i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i ^ 0x55);
+    }
+    /* noise, including a lone preamble octet */
+    stream[length++] = 0x00;
+    stream[length++] = 0x55;
+    stream[length++] = 0x12;
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_TOKEN, THIS_STATION, 3, NULL, 0);
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, THIS_STATION, 3, data,
+        120);
+    /* repeated preamble octets */
+    stream[length++] = 0x55;
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY, MSTP_BROADCAST_ADDRESS, 7,
+        data, 480);
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, 9, 3, data, 200);
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_POLL_FOR_MASTER, 9, THIS_STATION, NULL, 0);
+    /* bad header CRC */
+    i = length;
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_TOKEN, THIS_STATION, 3, NULL, 0);
+    stream[i + 7] ^= 0x01;
+    /* bad data CRC */
+    i = length;
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, THIS_STATION, 3, data,
+        33);
+    stream[i + 8 + 10] ^= 0x80;
+    length += MSTP_Create_Frame(&stream[length], stream_size - length,
+        FRAME_TYPE_REPLY_TO_POLL_FOR_MASTER, THIS_STATION, 9, NULL, 0);
+
+    return length;
+}
+
+/**
+ * @brief Test that the block receive finds the same frames as the
+ *  receive state machine given one octet at a time
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(mstp_tests, testReceiveFrameBlock)
+#else
+static void testReceiveFrameBlock(void)
+#endif
+{
+    static uint8_t stream[4096];
+    static struct test_frame frames[16];
+    static struct test_frame test_frames[16];
+    struct mstp_port_struct_t mstp_port;
+    unsigned block_size[] = { 1, 2, 7, 8, 64, 501, 4096 };
+    unsigned length, count, test_count;
+    unsigned i, f;
+    uint8_t event_count;
+
+    length = test_stream_init(stream, sizeof(stream));
+    test_port_init(&mstp_port);
+    count = test_receive_octets(&mstp_port, stream, length, frames, 16);
+    zassert_equal(count, 8, NULL);
+    event_count = mstp_port.EventCount;
+    zassert_true(frames[0].valid, NULL);
+    zassert_equal(frames[0].frame_type, FRAME_TYPE_TOKEN, NULL);
+    zassert_equal(frames[1].data_length, 120, NULL);
+    zassert_true(frames[2].valid, NULL);
+    zassert_equal(frames[2].destination, MSTP_BROADCAST_ADDRESS, NULL);
+    zassert_true(frames[3].not_for_us, NULL);
+    zassert_true(frames[4].not_for_us, NULL);
+    zassert_true(frames[5].invalid, NULL);
+    zassert_true(frames[6].invalid, NULL);
+    zassert_true(frames[7].valid, NULL);
+    for (i = 0; i < sizeof(block_size) / sizeof(block_size[0]); i++) {
+        test_port_init(&mstp_port);
+        test_count = test_receive_blocks(
+            &mstp_port, stream, length, block_size[i], test_frames, 16);
+        zassert_equal(test_count, count, "block size %u", block_size[i]);
+        for (f = 0; f < count; f++) {
+            zassert_equal(test_frames[f].valid, frames[f].valid, NULL);
+            zassert_equal(
+                test_frames[f].not_for_us, frames[f].not_for_us, NULL);
+            zassert_equal(test_frames[f].invalid, frames[f].invalid, NULL);
+            zassert_equal(
+                test_frames[f].frame_type, frames[f].frame_type, NULL);
+            zassert_equal(test_frames[f].source, frames[f].source, NULL);
+            zassert_equal(
+                test_frames[f].data_length, frames[f].data_length, NULL);
+            zassert_equal(memcmp(test_frames[f].data, frames[f].data,
+                              frames[f].data_length),
+                0, NULL);
+        }
+        zassert_equal(mstp_port.receive_state, MSTP_RECEIVE_STATE_IDLE, NULL);
+        zassert_equal(mstp_port.EventCount, event_count, NULL);
+    }
+}
+
+/**
+ * @brief Test that silence in the middle of a frame aborts the frame
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(mstp_tests, testReceiveFrameBlockSilence)
+#else
+static void testReceiveFrameBlockSilence(void)
+#endif
+{
+    uint8_t stream[64];
+    struct mstp_port_struct_t mstp_port;
+    struct test_frame frame;
+    unsigned length, offset;
+
+    length = MSTP_Create_Frame(stream, sizeof(stream),
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, THIS_STATION, 3,
+        (uint8_t *)"silence", 7);
+    test_port_init(&mstp_port);
+    offset = MSTP_Receive_Frame_Block(&mstp_port, stream, 10);
+    zassert_equal(offset, 10, NULL);
+    zassert_equal(mstp_port.receive_state, MSTP_RECEIVE_STATE_DATA, NULL);
+    zassert_equal(mstp_port.EventCount, 8, NULL);
+    /* silence longer than Tframe_abort */
+    Silence_Timer = 200;
+    offset = MSTP_Receive_Frame_Block(&mstp_port, &stream[10], length - 10);
+    zassert_equal(offset, 0, NULL);
+    zassert_true(test_frame_take(&mstp_port, &frame), NULL);
+    zassert_true(frame.invalid, NULL);
+    zassert_equal(mstp_port.receive_state, MSTP_RECEIVE_STATE_IDLE, NULL);
+    /* the rest of the frame is noise */
+    offset = MSTP_Receive_Frame_Block(&mstp_port, &stream[10], length - 10);
+    zassert_equal(offset, length - 10, NULL);
+    zassert_false(test_frame_take(&mstp_port, &frame), NULL);
+    zassert_equal(Silence_Timer, 0, NULL);
+    /* the whole frame */
+    offset = MSTP_Receive_Frame_Block(&mstp_port, stream, length);
+    zassert_equal(offset, length, NULL);
+    zassert_true(test_frame_take(&mstp_port, &frame), NULL);
+    zassert_true(frame.valid, NULL);
+    zassert_equal(memcmp(frame.data, "silence", 7), 0, NULL);
+}
+
+/**
+ * @brief Count the tokens this node passes between maintenance
+ *  Poll For Master frames, with no master at the address between
+ *  This_Station and Next_Station
+ * @param npoll_max - largest number of tokens between polls
+ * @param intervals - number of tokens before each poll
+ * @param count - number of polls
+ */
+static void test_poll_intervals(
+    unsigned npoll_max, unsigned *intervals, unsigned count)
+{
+    struct mstp_port_struct_t mstp_port;
+    unsigned tokens = 0;
+    unsigned polls = 0;
+
+    test_port_init(&mstp_port);
+    mstp_port.Nmax_master = 127;
+    mstp_port.Nmax_info_frames = 1;
+    mstp_port.Npoll_max = npoll_max;
+    mstp_port.Next_Station = THIS_STATION + 2;
+    mstp_port.Poll_Station = THIS_STATION;
+    while (polls < count) {
+        /* this node is done sending data frames */
+        mstp_port.FrameCount = mstp_port.Nmax_info_frames;
+        mstp_port.master_state = MSTP_MASTER_STATE_DONE_WITH_TOKEN;
+        Send_Frame_Type = 0xFF;
+        MSTP_Master_Node_FSM(&mstp_port);
+        if (Send_Frame_Type == FRAME_TYPE_POLL_FOR_MASTER) {
+            zassert_equal(mstp_port.Poll_Station, THIS_STATION + 1, NULL);
+            intervals[polls] = tokens;
+            polls++;
+            tokens = 0;
+            /* no reply to the poll */
+            Silence_Timer = 1000;
+            Send_Frame_Type = 0xFF;
+            MSTP_Master_Node_FSM(&mstp_port);
+            Silence_Timer = 0;
+        }
+        zassert_equal(Send_Frame_Type, FRAME_TYPE_TOKEN, NULL);
+        zassert_equal(
+            mstp_port.master_state, MSTP_MASTER_STATE_PASS_TOKEN, NULL);
+        tokens++;
+    }
+}
+
+/**
+ * @brief Test the back-off of the maintenance Poll For Master interval
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(mstp_tests, testPollForMasterBackoff)
+#else
+static void testPollForMasterBackoff(void)
+#endif
+{
+    unsigned intervals[6] = { 0 };
+    unsigned i;
+
+    /* standard: a poll every Npoll tokens */
+    test_poll_intervals(0, intervals, 6);
+    for (i = 1; i < 6; i++) {
+        zassert_equal(intervals[i], Npoll, NULL);
+    }
+    test_poll_intervals(Npoll, intervals, 6);
+    for (i = 1; i < 6; i++) {
+        zassert_equal(intervals[i], Npoll, NULL);
+    }
+    /* back-off: the interval doubles up to Npoll_max */
+    test_poll_intervals(8 * Npoll, intervals, 6);
+    zassert_equal(intervals[1], 2 * Npoll, NULL);
+    zassert_equal(intervals[2], 4 * Npoll, NULL);
+    zassert_equal(intervals[3], 8 * Npoll, NULL);
+    zassert_equal(intervals[4], 8 * Npoll, NULL);
+    zassert_equal(intervals[5], 8 * Npoll, NULL);
+    test_poll_intervals(3 * Npoll, intervals, 4);
+    zassert_equal(intervals[1], 2 * Npoll, NULL);
+    zassert_equal(intervals[2], 3 * Npoll, NULL);
+    zassert_equal(intervals[3], 3 * Npoll, NULL);
+}
+
+/**
+ * @brief Test that the Poll For Master interval returns to Npoll
+ *  when a new master replies
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(mstp_tests, testPollForMasterBackoffReset)
+#else
+static void testPollForMasterBackoffReset(void)
+#endif
+{
+    struct mstp_port_struct_t mstp_port;
+    unsigned tokens = 0;
+
+    test_port_init(&mstp_port);
+    mstp_port.Nmax_master = 127;
+    mstp_port.Nmax_info_frames = 1;
+    mstp_port.Npoll_max = 8 * Npoll;
+    mstp_port.Npoll_interval = 8 * Npoll;
+    mstp_port.Next_Station = THIS_STATION + 2;
+    mstp_port.Poll_Station = THIS_STATION;
+    mstp_port.TokenCount = 8 * Npoll;
+    mstp_port.FrameCount = mstp_port.Nmax_info_frames;
+    mstp_port.master_state = MSTP_MASTER_STATE_DONE_WITH_TOKEN;
+    MSTP_Master_Node_FSM(&mstp_port);
+    zassert_equal(Send_Frame_Type, FRAME_TYPE_POLL_FOR_MASTER, NULL);
+    /* a new master replies */
+    mstp_port.ReceivedValidFrame = true;
+    mstp_port.DestinationAddress = THIS_STATION;
+    mstp_port.SourceAddress = THIS_STATION + 1;
+    mstp_port.FrameType = FRAME_TYPE_REPLY_TO_POLL_FOR_MASTER;
+    MSTP_Master_Node_FSM(&mstp_port);
+    zassert_equal(Send_Frame_Type, FRAME_TYPE_TOKEN, NULL);
+    zassert_equal(mstp_port.Next_Station, THIS_STATION + 1, NULL);
+    zassert_equal(mstp_port.Npoll_interval, Npoll, NULL);
+    zassert_equal(mstp_port.TokenCount, 0, NULL);
+    /* no address between TS and NS: tokens only */
+    do {
+        mstp_port.FrameCount = mstp_port.Nmax_info_frames;
+        mstp_port.master_state = MSTP_MASTER_STATE_DONE_WITH_TOKEN;
+        Send_Frame_Type = 0xFF;
+        MSTP_Master_Node_FSM(&mstp_port);
+        zassert_equal(Send_Frame_Type, FRAME_TYPE_TOKEN, NULL);
+        tokens++;
+    } while (tokens < (4 * Npoll));
+}
+
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(mstp_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(mstp_tests,
+     ztest_unit_test(testReceiveFrameBlock),
+     ztest_unit_test(testReceiveFrameBlockSilence),
+     ztest_unit_test(testPollForMasterBackoff),
+     ztest_unit_test(testPollForMasterBackoffReset)
+     );
+
+    ztest_run_test_suite(mstp_tests);
+}
+#endif
@@ -59,6 +59,95 @@ static void testIndexText(void)
     zassert_equal(
         index, indtext_by_istring_default(data_list, "ANNA", index), NULL);
 }
+
+static INDTEXT_DATA duplicate_list[] = { { 7, "Joshua" }, { 9, "JOSHUA" },
+    { 8, "Mary" }, { 7, "Anna" }, { 10, "Mary" }, { 1000, "Sparse" },
+    { 0, NULL } };
+static INDTEXT_DATA sparse_list[] = { { 1, "One" }, { 100000, "Many" },
+    { 0, NULL } };
+
+/**
+ * @brief Test that the lookup tables find the first match of the list
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(indtext_tests, testIndexTextFirstMatch)
+#else
+static void testIndexTextFirstMatch(void)
+#endif
+{
+    unsigned index = 0;
+    unsigned i;
+
+    /* repeat, so that the lookups after the first use the tables */
+    for (i = 0; i < 2; i++) {
+        zassert_true(
+            indtext_by_string_cached(duplicate_list, "Mary", &index), NULL);
+        zassert_equal(index, 8, NULL);
+        zassert_true(
+            indtext_by_string_cached(duplicate_list, "JOSHUA", &index), NULL);
+        zassert_equal(index, 9, NULL);
+        zassert_true(
+            indtext_by_istring_cached(duplicate_list, "JOSHUA", &index), NULL);
+        zassert_equal(index, 7, NULL);
+        zassert_false(
+            indtext_by_string_cached(duplicate_list, "mary", NULL), NULL);
+        zassert_false(
+            indtext_by_istring_cached(duplicate_list, "Marie", NULL), NULL);
+        zassert_equal(indtext_by_istring_default_cached(
+                          duplicate_list, "Marie", 99), 99, NULL);
+        zassert_equal(strcmp(indtext_by_index_default_cached(
+                                 duplicate_list, 7, NULL), "Joshua"), 0, NULL);
+        zassert_equal(strcmp(indtext_by_index_default_cached(
+                                 duplicate_list, 1000, NULL), "Sparse"), 0,
+            NULL);
+        zassert_is_null(
+            indtext_by_index_default_cached(duplicate_list, 6, NULL), NULL);
+        zassert_is_null(
+            indtext_by_index_default_cached(duplicate_list, 11, NULL), NULL);
+        zassert_is_null(
+            indtext_by_index_default_cached(duplicate_list, 1001, NULL), NULL);
+        zassert_equal(strcmp(indtext_by_index_split_default_cached(
+                                 duplicate_list, 6, 7, "before", "after"),
+                          "before"), 0, NULL);
+        zassert_equal(strcmp(indtext_by_index_default_cached(
+                                 sparse_list, 100000, NULL), "Many"), 0, NULL);
+        zassert_is_null(
+            indtext_by_index_default_cached(sparse_list, 2, NULL), NULL);
+        zassert_true(
+            indtext_by_string_cached(sparse_list, "Many", &index), NULL);
+        zassert_equal(index, 100000, NULL);
+    }
+    indtext_cache_cleanup();
+}
+
+/**
+ * @brief Test that the lookups without tables see changes to the list
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(indtext_tests, testIndexTextModified)
+#else
+static void testIndexTextModified(void)
+#endif
+{
+    struct {
+        unsigned index;
+        const char *pString;
+    } list[3] = { { 1, "One" }, { 2, "Two" }, { 0, NULL } };
+    unsigned index = 0;
+
+    zassert_true(indtext_by_string((INDTEXT_DATA *)list, "Two", &index), NULL);
+    zassert_equal(index, 2, NULL);
+    zassert_equal(
+        strcmp(indtext_by_index((INDTEXT_DATA *)list, 1), "One"), 0, NULL);
+    list[1].pString = "Deux";
+    list[0].index = 3;
+    zassert_false(indtext_by_istring((INDTEXT_DATA *)list, "two", NULL), NULL);
+    zassert_true(indtext_by_istring((INDTEXT_DATA *)list, "DEUX", &index), NULL);
+    zassert_equal(index, 2, NULL);
+    zassert_is_null(indtext_by_index((INDTEXT_DATA *)list, 1), NULL);
+    zassert_equal(
+        strcmp(indtext_by_index((INDTEXT_DATA *)list, 3), "One"), 0, NULL);
+}
 /**
  * @}
  */
@@ -70,7 +159,9 @@ ZTEST_SUITE(indtext_tests, NULL, NULL, NULL, NULL, NULL);
 void test_main(void)
 {
     ztest_test_suite(indtext_tests,
-     ztest_unit_test(testIndexText)
+     ztest_unit_test(testIndexText),
+     ztest_unit_test(testIndexTextFirstMatch),
+     ztest_unit_test(testIndexTextModified)
      );
 
     ztest_run_test_suite(indtext_tests);
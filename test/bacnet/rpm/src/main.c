@@ -12,6 +12,7 @@
 #include <bacnet/bacerror.h>  /* For bacerror_decode_error_class_and_code() */
 #include <bacnet/bacdcode.h>
 #include <bacnet/rpm.h>
+#include <bacnet/rpm_json.h>
 
 /**
  * @addtogroup bacnet_tests
@@ -218,6 +219,8 @@ static void testReadPropertyMultipleAck(void)
     BACNET_ERROR_CLASS error_class;
     BACNET_ERROR_CODE error_code;
     BACNET_RPM_DATA rpmdata;
+    BACNET_RPM_COMPACT_RESULT results[4] = { 0 };
+    unsigned results_count = 0;
 
     /* build the RPM - try to make it easy for the
        Application Layer development */
@@ -401,6 +404,150 @@ static void testReadPropertyMultipleAck(void)
         service_request_len - len, &object_type, &object_instance);
     zassert_equal(test_len, 0, NULL);
     zassert_equal(len, service_request_len, NULL);
+    /* decode the whole packet into compact results */
+    test_len = rpm_ack_decode_compact(service_request, service_request_len,
+        results, ARRAY_SIZE(results), &results_count);
+    zassert_equal(test_len, service_request_len, NULL);
+    zassert_equal(results_count, 4, NULL);
+    zassert_equal(results[0].object_type, OBJECT_DEVICE, NULL);
+    zassert_equal(results[0].object_instance, 123, NULL);
+    zassert_equal(results[0].object_property, PROP_OBJECT_IDENTIFIER, NULL);
+    zassert_equal(results[0].error_code, ERROR_CODE_SUCCESS, NULL);
+    zassert_false(results[0].value.encoded, NULL);
+    zassert_equal(
+        results[0].value.tag, BACNET_APPLICATION_TAG_OBJECT_ID, NULL);
+    zassert_equal(results[0].value.type.Object_Id.instance, 123, NULL);
+    zassert_equal(results[1].value.type.Enumerated, OBJECT_DEVICE, NULL);
+    zassert_equal(results[2].object_type, OBJECT_ANALOG_INPUT, NULL);
+    zassert_equal(results[2].object_instance, 33, NULL);
+    zassert_equal(results[2].value.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    zassert_equal(results[3].object_property, PROP_DEADBAND, NULL);
+    zassert_equal(results[3].error_class, ERROR_CLASS_PROPERTY, NULL);
+    zassert_equal(results[3].error_code, ERROR_CODE_UNKNOWN_PROPERTY, NULL);
+    /* not enough results */
+    test_len = rpm_ack_decode_compact(service_request, service_request_len,
+        results, 3, &results_count);
+    zassert_equal(test_len, BACNET_STATUS_ERROR, NULL);
+}
+/* JSON text written by the writer under test */
+static char JSON_Text[512];
+static size_t JSON_Text_Len;
+
+static bool json_text_write(void *context, const char *text, size_t text_len)
+{
+    (void)context;
+    if ((JSON_Text_Len + text_len) >= sizeof(JSON_Text)) {
+        return false;
+    }
+    memcpy(&JSON_Text[JSON_Text_Len], text, text_len);
+    JSON_Text_Len += text_len;
+    JSON_Text[JSON_Text_Len] = 0;
+
+    return true;
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(rpm_tests, testReadPropertyMultipleAckJSON)
+#else
+static void testReadPropertyMultipleAckJSON(void)
+#endif
+{
+    uint8_t apdu[480] = { 0 };
+    int apdu_len = 0;
+    int test_len = 0;
+    uint8_t application_data_buffer[MAX_APDU] = { 0 };
+    int application_data_buffer_len = 0;
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_RPM_DATA rpmdata = { 0 };
+    BACNET_RPM_JSON_WRITER writer = { 0 };
+    const char *json_text = "{\n"
+        "\t\"device_123_object-name\":\t\"Say \\\"hi\\\"\",\n"
+        "\t\"device_123_object-list\":\t[\"(device, 123)\", "
+        "\"(analog-input, 33)\"],\n"
+        "\t\"analog-input_33_present-value\":\t1.500000,\n"
+        "\t\"analog-input_33_out-of-service\":\tfalse,\n"
+        "\t\"analog-input_33_priority-array[1]\":\tnull,\n"
+        "\t\"analog-input_33_deadband\":\t{\"error-class\": "
+        "\"property\", \"error-code\": \"unknown-property\"}\n"
+        "}\n";
+
+    rpmdata.object_type = OBJECT_DEVICE;
+    rpmdata.object_instance = 123;
+    apdu_len += rpm_ack_encode_apdu_object_begin(&apdu[apdu_len], &rpmdata);
+    apdu_len += rpm_ack_encode_apdu_object_property(
+        &apdu[apdu_len], PROP_OBJECT_NAME, BACNET_ARRAY_ALL);
+    value.tag = BACNET_APPLICATION_TAG_CHARACTER_STRING;
+    characterstring_init_ansi(&value.type.Character_String, "Say \"hi\"");
+    application_data_buffer_len = bacapp_encode_application_data(
+        &application_data_buffer[0], &value);
+    apdu_len += rpm_ack_encode_apdu_object_property_value(&apdu[apdu_len],
+        &application_data_buffer[0], application_data_buffer_len);
+    apdu_len += rpm_ack_encode_apdu_object_property(
+        &apdu[apdu_len], PROP_OBJECT_LIST, BACNET_ARRAY_ALL);
+    value.tag = BACNET_APPLICATION_TAG_OBJECT_ID;
+    value.type.Object_Id.type = OBJECT_DEVICE;
+    value.type.Object_Id.instance = 123;
+    application_data_buffer_len = bacapp_encode_application_data(
+        &application_data_buffer[0], &value);
+    value.type.Object_Id.type = OBJECT_ANALOG_INPUT;
+    value.type.Object_Id.instance = 33;
+    application_data_buffer_len += bacapp_encode_application_data(
+        &application_data_buffer[application_data_buffer_len], &value);
+    apdu_len += rpm_ack_encode_apdu_object_property_value(&apdu[apdu_len],
+        &application_data_buffer[0], application_data_buffer_len);
+    apdu_len += rpm_ack_encode_apdu_object_end(&apdu[apdu_len]);
+
+    rpmdata.object_type = OBJECT_ANALOG_INPUT;
+    rpmdata.object_instance = 33;
+    apdu_len += rpm_ack_encode_apdu_object_begin(&apdu[apdu_len], &rpmdata);
+    apdu_len += rpm_ack_encode_apdu_object_property(
+        &apdu[apdu_len], PROP_PRESENT_VALUE, BACNET_ARRAY_ALL);
+    value.tag = BACNET_APPLICATION_TAG_REAL;
+    value.type.Real = 1.5f;
+    application_data_buffer_len = bacapp_encode_application_data(
+        &application_data_buffer[0], &value);
+    apdu_len += rpm_ack_encode_apdu_object_property_value(&apdu[apdu_len],
+        &application_data_buffer[0], application_data_buffer_len);
+    apdu_len += rpm_ack_encode_apdu_object_property(
+        &apdu[apdu_len], PROP_OUT_OF_SERVICE, BACNET_ARRAY_ALL);
+    value.tag = BACNET_APPLICATION_TAG_BOOLEAN;
+    value.type.Boolean = false;
+    application_data_buffer_len = bacapp_encode_application_data(
+        &application_data_buffer[0], &value);
+    apdu_len += rpm_ack_encode_apdu_object_property_value(&apdu[apdu_len],
+        &application_data_buffer[0], application_data_buffer_len);
+    apdu_len += rpm_ack_encode_apdu_object_property(
+        &apdu[apdu_len], PROP_PRIORITY_ARRAY, 1);
+    value.tag = BACNET_APPLICATION_TAG_NULL;
+    application_data_buffer_len = bacapp_encode_application_data(
+        &application_data_buffer[0], &value);
+    apdu_len += rpm_ack_encode_apdu_object_property_value(&apdu[apdu_len],
+        &application_data_buffer[0], application_data_buffer_len);
+    apdu_len += rpm_ack_encode_apdu_object_property(
+        &apdu[apdu_len], PROP_DEADBAND, BACNET_ARRAY_ALL);
+    apdu_len += rpm_ack_encode_apdu_object_property_error(
+        &apdu[apdu_len], ERROR_CLASS_PROPERTY, ERROR_CODE_UNKNOWN_PROPERTY);
+    apdu_len += rpm_ack_encode_apdu_object_end(&apdu[apdu_len]);
+
+    JSON_Text_Len = 0;
+    rpm_ack_json_init(&writer, json_text_write, NULL);
+    zassert_true(rpm_ack_json_begin(&writer), NULL);
+    test_len = rpm_ack_json_encode(&writer, apdu, apdu_len);
+    zassert_equal(test_len, apdu_len, NULL);
+    zassert_true(rpm_ack_json_end(&writer), NULL);
+    zassert_equal(writer.members, 6, NULL);
+    zassert_equal(strcmp(JSON_Text, json_text), 0, "%s", JSON_Text);
+    /* malformed */
+    JSON_Text_Len = 0;
+    rpm_ack_json_init(&writer, json_text_write, NULL);
+    test_len = rpm_ack_json_encode(&writer, apdu, apdu_len - 1);
+    zassert_equal(test_len, BACNET_STATUS_ERROR, NULL);
+    /* the write fails when the text does not fit */
+    JSON_Text_Len = sizeof(JSON_Text) - 8;
+    rpm_ack_json_init(&writer, json_text_write, NULL);
+    test_len = rpm_ack_json_encode(&writer, apdu, apdu_len);
+    zassert_equal(test_len, BACNET_STATUS_ERROR, NULL);
+    zassert_false(writer.ok, NULL);
 }
 /**
  * @}
@@ -414,7 +561,8 @@ void test_main(void)
 {
     ztest_test_suite(rpm_tests,
      ztest_unit_test(testReadPropertyMultiple),
-     ztest_unit_test(testReadPropertyMultipleAck)
+     ztest_unit_test(testReadPropertyMultipleAck),
+     ztest_unit_test(testReadPropertyMultipleAckJSON)
      );
 
     ztest_run_test_suite(rpm_tests);